@@ -380,10 +380,10 @@ namespace osmscout {
         return desc;
     }
 
-    bool advanceToNextWaypoint(std::list<RouteDescription::Node>::const_iterator &waypoint,
-                               std::list<RouteDescription::Node>::const_iterator end) {
+    bool advanceToNextWaypoint(RouteDescription::NodeIterator &waypoint,
+                               RouteDescription::NodeIterator end) {
         if(waypoint == end) return false;
-        std::list<RouteDescription::Node>::const_iterator next = waypoint;
+        RouteDescription::NodeIterator next = waypoint;
         std::advance(next,1);
         if (next == end){
             return false;
@@ -68,8 +68,8 @@ namespace osmscout {
 
   NodeDescription DumpNameChangedDescription(const RouteDescription::NameChangedDescriptionRef& nameChangedDescription);
 
-  bool advanceToNextWaypoint(std::list<RouteDescription::Node>::const_iterator& waypoint,
-                             std::list<RouteDescription::Node>::const_iterator end);
+  bool advanceToNextWaypoint(RouteDescription::NodeIterator& waypoint,
+                             RouteDescription::NodeIterator end);
 
   template<class NodeDescription>
   class NavigationDescription : public OutputDescription<NodeDescription>
@@ -78,8 +78,8 @@ namespace osmscout {
     NavigationDescription() = default;
 
     void NextDescription(const Distance &distance,
-                         std::list<RouteDescription::Node>::const_iterator& waypoint,
-                         std::list<RouteDescription::Node>::const_iterator end)
+                         RouteDescription::NodeIterator& waypoint,
+                         RouteDescription::NodeIterator end)
     {
 
       if (waypoint==end || (distance.AsMeter()>=0 && previousDistance>distance)) {
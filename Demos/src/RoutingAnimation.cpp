@@ -162,6 +162,7 @@ public:
   virtual bool WalkToOtherDatabases(const osmscout::RoutingProfile& /*state*/,
                                     osmscout::RoutingService::RNodeRef &current,
                                     osmscout::RouteNodeRef &/*currentRouteNode*/,
+                                    osmscout::RoutingService::RNodePool &/*pool*/,
                                     osmscout::RoutingService::OpenList &openList,
                                     osmscout::RoutingService::OpenMap &/*openMap*/,
                                     const osmscout::RoutingService::ClosedSet &closedSet,
@@ -109,6 +109,9 @@ void DumpHelp(osmscout::ImportParameter& parameter)
   std::cout << " --wayDataCacheSize <number>          way data cache size (default: " << parameter.GetWayDataCacheSize() << ")" << std::endl;
 
   std::cout << " --routeNodeBlockSize <number>        number of route nodes resolved in block (default: " << parameter.GetRouteNodeBlockSize() << ")" << std::endl;
+  std::cout << " --routeContractionHierarchy true|false generate contraction hierarchies (default: " << osmscout::BoolToString(parameter.GetRouteContractionHierarchy()) << ")" << std::endl;
+  std::cout << " --routePartition true|false          generate multi-level route partitions (default: " << osmscout::BoolToString(parameter.GetRoutePartition()) << ")" << std::endl;
+  std::cout << " --routeSnapIndex true|false          generate snap indexes of routable segments (default: " << osmscout::BoolToString(parameter.GetRouteSnapIndex()) << ")" << std::endl;
   std::cout << std::endl;
   std::cout << " --langOrder <#|lang1[,#|lang2]..>    language order when parsing lang[:language] and place_name[:language] tags" << std::endl
             << "                                      # is the default language (no :language) (default: #)" << std::endl;
@@ -322,6 +325,12 @@ static void DumpParameter(const osmscout::ImportParameter& parameter,
 
   progress.Info(std::string("RouteNodeBlockSize: ")+
                 std::to_string(parameter.GetRouteNodeBlockSize()));
+  progress.Info(std::string("RouteContractionHierarchy: ")+
+                osmscout::BoolToString(parameter.GetRouteContractionHierarchy()));
+  progress.Info(std::string("RoutePartition: ")+
+                osmscout::BoolToString(parameter.GetRoutePartition()));
+  progress.Info(std::string("RouteSnapIndex: ")+
+                osmscout::BoolToString(parameter.GetRouteSnapIndex()));
 
 
   progress.Info(std::string("MaxAdminLevel: ")+
@@ -798,6 +807,45 @@ int main(int argc, char* argv[])
         parameterError=true;
       }
     }
+    else if (strcmp(argv[i],"--routeContractionHierarchy")==0) {
+      bool routeContractionHierarchy;
+
+      if (osmscout::ParseBoolArgument(argc,
+                                      argv,
+                                      i,
+                                      routeContractionHierarchy)) {
+        parameter.SetRouteContractionHierarchy(routeContractionHierarchy);
+      }
+      else {
+        parameterError=true;
+      }
+    }
+    else if (strcmp(argv[i],"--routePartition")==0) {
+      bool routePartition;
+
+      if (osmscout::ParseBoolArgument(argc,
+                                      argv,
+                                      i,
+                                      routePartition)) {
+        parameter.SetRoutePartition(routePartition);
+      }
+      else {
+        parameterError=true;
+      }
+    }
+    else if (strcmp(argv[i],"--routeSnapIndex")==0) {
+      bool routeSnapIndex;
+
+      if (osmscout::ParseBoolArgument(argc,
+                                      argv,
+                                      i,
+                                      routeSnapIndex)) {
+        parameter.SetRouteSnapIndex(routeSnapIndex);
+      }
+      else {
+        parameterError=true;
+      }
+    }
     else if (strcmp(argv[i],"--langOrder")==0) {
         std::vector<std::string> langOrder;
 
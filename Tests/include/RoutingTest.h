@@ -0,0 +1,129 @@
+/*
+  RoutingTest - shared code of the routing test programs for libosmscout
+  Copyright (C) 2026  Tim Teulings
+
+  This program is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 2 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+*/
+
+#ifndef ROUTING_TEST_H
+#define ROUTING_TEST_H
+
+#include <iostream>
+#include <map>
+#include <string>
+#include <vector>
+
+#include <osmscout/GeoCoord.h>
+
+#include <osmscout/util/CmdLineParsing.h>
+
+/**
+ * Arguments of a routing test program, see ParseRoutingTestArguments()
+ */
+struct RoutingTestArguments
+{
+  bool               help=false;
+  std::string        databaseDirectory;
+  osmscout::GeoCoord start;
+  osmscout::GeoCoord target;
+};
+
+/**
+ * Parse the arguments START TARGET DATABASE of a routing test.
+ *
+ * @return
+ *    false, if the test should return the given exit code, because the
+ *    arguments are invalid or help was requested
+ */
+inline bool ParseRoutingTestArguments(const std::string& appName,
+                                      int argc,
+                                      char* argv[],
+                                      RoutingTestArguments& args,
+                                      int& exitCode)
+{
+  osmscout::CmdLineParser   argParser(appName,
+                                      argc,argv);
+  std::vector<std::string>  helpArgs{"h","help"};
+
+  argParser.AddOption(osmscout::CmdLineFlag([&args](const bool& value) {
+                        args.help=value;
+                      }),
+                      helpArgs,
+                      "Return argument help",
+                      true);
+
+  argParser.AddPositional(osmscout::CmdLineGeoCoordOption([&args](const osmscout::GeoCoord& value) {
+                            args.start=value;
+                          }),
+                          "START",
+                          "start coordinate");
+
+  argParser.AddPositional(osmscout::CmdLineGeoCoordOption([&args](const osmscout::GeoCoord& value) {
+                            args.target=value;
+                          }),
+                          "TARGET",
+                          "target coordinate");
+
+  argParser.AddPositional(osmscout::CmdLineStringOption([&args](const std::string& value) {
+                            args.databaseDirectory=value;
+                          }),
+                          "DATABASE",
+                          "Directory of the database to use");
+
+  osmscout::CmdLineParseResult result=argParser.Parse();
+
+  if (result.HasError()) {
+    std::cerr << "ERROR: " << result.GetErrorDescription() << std::endl;
+    std::cout << argParser.GetHelp() << std::endl;
+    exitCode=1;
+    return false;
+  }
+
+  if (args.help) {
+    std::cout << argParser.GetHelp() << std::endl;
+    exitCode=0;
+    return false;
+  }
+
+  return true;
+}
+
+/**
+ * Speeds of the routable way types for car routing, the same as in the demos
+ */
+inline void GetCarSpeedTable(std::map<std::string,double>& map)
+{
+  map["highway_motorway"]=110.0;
+  map["highway_motorway_trunk"]=100.0;
+  map["highway_motorway_primary"]=70.0;
+  map["highway_motorway_link"]=60.0;
+  map["highway_motorway_junction"]=60.0;
+  map["highway_trunk"]=100.0;
+  map["highway_trunk_link"]=60.0;
+  map["highway_primary"]=70.0;
+  map["highway_primary_link"]=60.0;
+  map["highway_secondary"]=60.0;
+  map["highway_secondary_link"]=50.0;
+  map["highway_tertiary"]=55.0;
+  map["highway_tertiary_link"]=55.0;
+  map["highway_unclassified"]=50.0;
+  map["highway_road"]=50.0;
+  map["highway_residential"]=40.0;
+  map["highway_roundabout"]=40.0;
+  map["highway_living_street"]=10.0;
+  map["highway_service"]=30.0;
+}
+
+#endif
@@ -0,0 +1,188 @@
+/*
+  AlternativeRoutes - a test program for libosmscout
+  Copyright (C) 2026  Tim Teulings
+
+  This program is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 2 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+*/
+
+#include <algorithm>
+#include <iostream>
+
+#include <osmscout/Database.h>
+
+#include <osmscout/routing/SimpleRoutingService.h>
+
+#include <osmscout/util/Geometry.h>
+
+#include <RoutingTest.h>
+
+template<class Router>
+double GetRouteLength(Router& router,
+                      const osmscout::RoutingResult& result)
+{
+  auto   pointsResult=router.TransformRouteDataToPoints(result.GetRoute());
+  double length=0.0;
+
+  if (!pointsResult.Success()) {
+    return -1.0;
+  }
+
+  const auto& points=pointsResult.GetPoints()->points;
+
+  for (size_t i=1; i<points.size(); i++) {
+    length+=osmscout::GetSphericalDistance(points[i-1].GetCoord(),
+                                           points[i].GetCoord()).AsMeter();
+  }
+
+  return length;
+}
+
+/**
+ * Check, that the first route is the best route, that all alternatives stay
+ * within the maximum stretch and that all routes differ
+ */
+bool CheckAlternatives(osmscout::SimpleRoutingService& router,
+                       osmscout::RoutingProfile& profile,
+                       const osmscout::RoutePosition& start,
+                       const osmscout::RoutePosition& target)
+{
+  osmscout::RoutingParameter          parameter;
+  osmscout::AlternativeRouteParameter alternativeParameter;
+
+  parameter.SetBidirectional(true);
+
+  auto routeResult=router.CalculateRoute(profile,
+                                         start,
+                                         target,
+                                         parameter);
+  auto alternatives=router.CalculateAlternativeRoutes(profile,
+                                                      start,
+                                                      target,
+                                                      parameter,
+                                                      alternativeParameter);
+
+  if (!routeResult.Success() ||
+      !alternatives.Success()) {
+    std::cerr << "Routing failed" << std::endl;
+    return false;
+  }
+
+  const auto& routes=alternatives.GetRoutes();
+  const auto& costs=alternatives.GetCosts();
+
+  if (routes.size()>alternativeParameter.maxAlternatives+1 ||
+      costs.size()!=routes.size()) {
+    std::cerr << "Unexpected number of routes" << std::endl;
+    return false;
+  }
+
+  osmscout::RoutingResult bestResult;
+
+  bestResult.GetRoute()=routes.front();
+
+  double routeLength=GetRouteLength(router,routeResult);
+  double bestLength=GetRouteLength(router,bestResult);
+
+  if (routeLength!=bestLength) {
+    std::cerr << "Best route " << bestLength << " m differs from route " << routeLength << " m" << std::endl;
+    return false;
+  }
+
+  std::vector<double> lengths;
+
+  for (size_t i=0; i<routes.size(); i++) {
+    osmscout::RoutingResult result;
+
+    result.GetRoute()=routes[i];
+
+    double length=GetRouteLength(router,result);
+
+    std::cout << "Route " << i << ": " << length << " m, costs " << costs[i] << std::endl;
+
+    if (length<=0.0 ||
+        costs[i]<costs.front() ||
+        costs[i]>costs.front()*(1.0+alternativeParameter.maxStretch)) {
+      std::cerr << "Unexpected costs of route " << i << std::endl;
+      return false;
+    }
+
+    if (std::find(lengths.begin(),lengths.end(),length)!=lengths.end()) {
+      std::cerr << "Route " << i << " is a duplicate" << std::endl;
+      return false;
+    }
+
+    lengths.push_back(length);
+  }
+
+  return true;
+}
+
+int main(int argc, char* argv[])
+{
+  RoutingTestArguments args;
+  int                  exitCode;
+
+  if (!ParseRoutingTestArguments("AlternativeRoutes",argc,argv,args,exitCode)) {
+    return exitCode;
+  }
+
+  osmscout::DatabaseParameter dbParameter;
+  osmscout::DatabaseRef       database=std::make_shared<osmscout::Database>(dbParameter);
+
+  if (!database->Open(args.databaseDirectory)) {
+    std::cerr << "Cannot open database " << args.databaseDirectory << std::endl;
+    return 1;
+  }
+
+  osmscout::RouterParameter routerParameter;
+
+  osmscout::SimpleRoutingService router(database,
+                                        routerParameter,
+                                        osmscout::RoutingService::DEFAULT_FILENAME_BASE);
+
+  if (!router.Open()) {
+    std::cerr << "Cannot open router" << std::endl;
+    return 1;
+  }
+
+  std::map<std::string,double>        speedMap;
+  osmscout::FastestPathRoutingProfile profile(database->GetTypeConfig());
+
+  GetCarSpeedTable(speedMap);
+  profile.ParametrizeForCar(*database->GetTypeConfig(),speedMap,160.0);
+
+  std::vector<osmscout::RoutePosition> positions;
+
+  for (const auto& coord : {args.start,args.target}) {
+    auto position=router.GetClosestRoutableNode(coord,profile,osmscout::Kilometers(1));
+
+    if (!position.IsValid()) {
+      std::cerr << "Cannot find routable node for " << coord.GetDisplayText() << std::endl;
+      return 1;
+    }
+
+    positions.push_back(position.GetRoutePosition());
+  }
+
+  if (!CheckAlternatives(router,profile,positions[0],positions[1]) ||
+      !CheckAlternatives(router,profile,positions[1],positions[0])) {
+    return 1;
+  }
+
+  router.Close();
+  database->Close();
+
+  return 0;
+}
@@ -0,0 +1,285 @@
+/*
+  BidirectionalRouting - a test program for libosmscout
+  Copyright (C) 2026  Tim Teulings
+
+  This program is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 2 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+*/
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <iostream>
+
+#include <osmscout/Database.h>
+
+#include <osmscout/routing/MultiDBRoutingService.h>
+#include <osmscout/routing/RouteNodeDataFile.h>
+#include <osmscout/routing/SimpleRoutingService.h>
+
+#include <osmscout/util/Geometry.h>
+
+#include <RoutingTest.h>
+
+/**
+ * Check, that every path leads to a route node, that either has a path back
+ * or lists the start of the path as predecessor, with and without graph loaded
+ */
+bool CheckPredecessors(const osmscout::DatabaseRef& database)
+{
+  osmscout::RouteNodeDataFile pagedFile(osmscout::RoutingService::GetDataFilename(osmscout::RoutingService::DEFAULT_FILENAME_BASE),
+                                        1000);
+  osmscout::RouteNodeDataFile graphFile(osmscout::RoutingService::GetDataFilename(osmscout::RoutingService::DEFAULT_FILENAME_BASE),
+                                        1000);
+
+  if (!pagedFile.Open(database->GetTypeConfig(),database->GetPath(),false) ||
+      !graphFile.Open(database->GetTypeConfig(),database->GetPath(),false) ||
+      !graphFile.LoadGraph()) {
+    std::cerr << "Cannot load routing graph" << std::endl;
+    return false;
+  }
+
+  size_t predecessorCount=0;
+
+  for (const auto& id : graphFile.GetGraph()->GetNodeIds()) {
+    osmscout::RouteNodeRef                                       node;
+    std::vector<std::pair<osmscout::Id,osmscout::ObjectFileRef>> pagedPredecessors;
+    std::vector<std::pair<osmscout::Id,osmscout::ObjectFileRef>> graphPredecessors;
+
+    if (!graphFile.Get(id,node) ||
+        !pagedFile.GetPredecessors(id,pagedPredecessors) ||
+        !graphFile.GetPredecessors(id,graphPredecessors)) {
+      std::cerr << "Cannot load route node " << id << std::endl;
+      return false;
+    }
+
+    if (pagedPredecessors!=graphPredecessors) {
+      std::cerr << "Predecessors of route node " << id << " differ" << std::endl;
+      return false;
+    }
+
+    predecessorCount+=graphPredecessors.size();
+
+    for (const auto& path : node->paths) {
+      const osmscout::ObjectFileRef& object=node->objects[path.objectIndex].object;
+      osmscout::RouteNodeRef         target;
+
+      if (!graphFile.Get(path.id,target)) {
+        continue;
+      }
+
+      bool pathBack=false;
+
+      for (const auto& targetPath : target->paths) {
+        if (targetPath.id==id &&
+            target->objects[targetPath.objectIndex].object==object) {
+          pathBack=true;
+        }
+      }
+
+      std::vector<std::pair<osmscout::Id,osmscout::ObjectFileRef>> targetPredecessors;
+
+      graphFile.GetPredecessors(path.id,targetPredecessors);
+
+      bool isPredecessor=std::find(targetPredecessors.begin(),
+                                   targetPredecessors.end(),
+                                   std::make_pair(id,object))!=targetPredecessors.end();
+
+      if (pathBack==isPredecessor) {
+        std::cerr << "Route node " << id << " is not a predecessor of route node " << path.id << std::endl;
+        return false;
+      }
+    }
+  }
+
+  std::cout << "Predecessors without path back: " << predecessorCount << std::endl;
+
+  return true;
+}
+
+template<class Router>
+double GetRouteLength(Router& router,
+                      const osmscout::RoutingResult& result)
+{
+  auto   pointsResult=router.TransformRouteDataToPoints(result.GetRoute());
+  double length=0.0;
+
+  if (!pointsResult.Success()) {
+    return -1.0;
+  }
+
+  const auto& points=pointsResult.GetPoints()->points;
+
+  for (size_t i=1; i<points.size(); i++) {
+    length+=osmscout::GetSphericalDistance(points[i-1].GetCoord(),
+                                           points[i].GetCoord()).AsMeter();
+  }
+
+  return length;
+}
+
+/**
+ * Calculate the route unidirectional and bidirectional and compare the lengths
+ */
+template<class Router, class ... Profile>
+bool CompareRoutes(const std::string& name,
+                   Router& router,
+                   const osmscout::RoutePosition& start,
+                   const osmscout::RoutePosition& target,
+                   Profile& ... profile)
+{
+  osmscout::RoutingParameter unidirectionalParameter;
+  osmscout::RoutingParameter bidirectionalParameter;
+
+  bidirectionalParameter.SetBidirectional(true);
+
+  std::cout << name << " unidirectional:" << std::endl;
+  auto unidirectionalResult=router.CalculateRoute(profile...,
+                                                  start,
+                                                  target,
+                                                  unidirectionalParameter);
+
+  std::cout << name << " bidirectional:" << std::endl;
+  auto bidirectionalResult=router.CalculateRoute(profile...,
+                                                 start,
+                                                 target,
+                                                 bidirectionalParameter);
+
+  if (!unidirectionalResult.Success() ||
+      !bidirectionalResult.Success()) {
+    std::cerr << name << ": Route failed" << std::endl;
+    return false;
+  }
+
+  double unidirectionalLength=GetRouteLength(router,unidirectionalResult);
+  double bidirectionalLength=GetRouteLength(router,bidirectionalResult);
+
+  std::cout << name << " unidirectional route length: " << unidirectionalLength << " m, bidirectional route length: " << bidirectionalLength << " m" << std::endl;
+
+  if (unidirectionalLength<=0.0 ||
+      std::fabs(unidirectionalLength-bidirectionalLength)>0.01*unidirectionalLength) {
+    std::cerr << name << ": Routes differ" << std::endl;
+    return false;
+  }
+
+  if (!router.TransformRouteDataToRouteDescription(bidirectionalResult.GetRoute()).Success()) {
+    std::cerr << name << ": Cannot transform route to description" << std::endl;
+    return false;
+  }
+
+  return true;
+}
+
+int main(int argc, char* argv[])
+{
+  RoutingTestArguments args;
+  int                  exitCode;
+
+  if (!ParseRoutingTestArguments("BidirectionalRouting",argc,argv,args,exitCode)) {
+    return exitCode;
+  }
+
+  osmscout::DatabaseParameter dbParameter;
+  osmscout::DatabaseRef       database=std::make_shared<osmscout::Database>(dbParameter);
+
+  if (!database->Open(args.databaseDirectory)) {
+    std::cerr << "Cannot open database " << args.databaseDirectory << std::endl;
+    return 1;
+  }
+
+  if (!CheckPredecessors(database)) {
+    return 1;
+  }
+
+  osmscout::RouterParameter routerParameter;
+
+  routerParameter.SetDebugPerformance(true);
+
+  osmscout::SimpleRoutingService router(database,
+                                        routerParameter,
+                                        osmscout::RoutingService::DEFAULT_FILENAME_BASE);
+
+  if (!router.Open()) {
+    std::cerr << "Cannot open router" << std::endl;
+    return 1;
+  }
+
+  std::map<std::string,double>        speedMap;
+  osmscout::FastestPathRoutingProfile carProfile(database->GetTypeConfig());
+  osmscout::FastestPathRoutingProfile footProfile(database->GetTypeConfig());
+
+  GetCarSpeedTable(speedMap);
+  carProfile.ParametrizeForCar(*database->GetTypeConfig(),speedMap,160.0);
+  footProfile.ParametrizeForFoot(*database->GetTypeConfig(),5.0);
+
+  for (osmscout::RoutingProfile* profile : std::initializer_list<osmscout::RoutingProfile*>{&carProfile,&footProfile}) {
+    osmscout::Distance radius=osmscout::Kilometers(1);
+    auto               startResult=router.GetClosestRoutableNode(args.start,*profile,radius);
+    auto               targetResult=router.GetClosestRoutableNode(args.target,*profile,radius);
+
+    if (!startResult.IsValid() ||
+        !targetResult.IsValid()) {
+      std::cerr << "Cannot find start or target" << std::endl;
+      return 1;
+    }
+
+    if (!CompareRoutes(profile==&carProfile ? "Car" : "Foot",
+                       router,
+                       startResult.GetRoutePosition(),
+                       targetResult.GetRoutePosition(),
+                       *profile)) {
+      return 1;
+    }
+  }
+
+  router.Close();
+
+  // The same for the routing service for multiple databases
+  osmscout::MultiDBRoutingService multiDBRouter(routerParameter,{database});
+
+  osmscout::MultiDBRoutingService::RoutingProfileBuilder profileBuilder=
+      [&speedMap](const osmscout::DatabaseRef& database) {
+        auto profile=std::make_shared<osmscout::FastestPathRoutingProfile>(database->GetTypeConfig());
+
+        profile->ParametrizeForCar(*(database->GetTypeConfig()),speedMap,160.0);
+
+        return profile;
+      };
+
+  if (!multiDBRouter.Open(profileBuilder)) {
+    std::cerr << "Cannot open multi database router" << std::endl;
+    return 1;
+  }
+
+  auto startResult=multiDBRouter.GetClosestRoutableNode(args.start);
+  auto targetResult=multiDBRouter.GetClosestRoutableNode(args.target);
+
+  if (!startResult.IsValid() ||
+      !targetResult.IsValid()) {
+    std::cerr << "Cannot find start or target" << std::endl;
+    return 1;
+  }
+
+  if (!CompareRoutes("Multi database",
+                     multiDBRouter,
+                     startResult.GetRoutePosition(),
+                     targetResult.GetRoutePosition())) {
+    return 1;
+  }
+
+  multiDBRouter.Close();
+  database->Close();
+
+  return 0;
+}
@@ -0,0 +1,263 @@
+/*
+  CHRouting - a test program for libosmscout
+  Copyright (C) 2026  Tim Teulings
+
+  This program is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 2 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+*/
+
+#include <cmath>
+#include <cstdio>
+#include <iostream>
+
+#include <osmscout/Database.h>
+
+#include <osmscout/routing/CHRoutingService.h>
+#include <osmscout/routing/ContractionHierarchy.h>
+#include <osmscout/routing/SimpleRoutingService.h>
+
+#include <osmscout/util/Geometry.h>
+
+#include <RoutingTest.h>
+
+/**
+ * The hierarchy does not know about junction penalties, so compare against
+ * A* without them
+ */
+class NoPenaltyRoutingProfile : public osmscout::FastestPathRoutingProfile
+{
+public:
+  NoPenaltyRoutingProfile(const osmscout::TypeConfigRef& typeConfig,
+                          double maxSpeed)
+  : osmscout::FastestPathRoutingProfile(typeConfig)
+  {
+    std::map<std::string,double> speedMap;
+
+    GetCarSpeedTable(speedMap);
+    ParametrizeForCar(*typeConfig,speedMap,maxSpeed);
+    SetJunctionPenalty(false);
+  }
+};
+
+double GetRouteLength(osmscout::SimpleRoutingService& router,
+                      const osmscout::RoutingResult& result)
+{
+  auto   pointsResult=router.TransformRouteDataToPoints(result.GetRoute());
+  double length=0.0;
+
+  if (!pointsResult.Success()) {
+    return -1.0;
+  }
+
+  const auto& points=pointsResult.GetPoints()->points;
+
+  for (size_t i=1; i<points.size(); i++) {
+    length+=osmscout::GetSphericalDistance(points[i-1].GetCoord(),
+                                           points[i].GetCoord()).AsMeter();
+  }
+
+  return length;
+}
+
+int main(int argc, char* argv[])
+{
+  RoutingTestArguments args;
+  int                  exitCode;
+
+  if (!ParseRoutingTestArguments("CHRouting",argc,argv,args,exitCode)) {
+    return exitCode;
+  }
+
+  osmscout::DatabaseParameter dbParameter;
+  osmscout::DatabaseRef       database=std::make_shared<osmscout::Database>(dbParameter);
+
+  if (!database->Open(args.databaseDirectory)) {
+    std::cerr << "Cannot open database " << args.databaseDirectory << std::endl;
+    return 1;
+  }
+
+  osmscout::RouterParameter routerParameter;
+
+  routerParameter.SetDebugPerformance(true);
+
+  osmscout::SimpleRoutingService aStarRouter(database,
+                                             routerParameter,
+                                             osmscout::RoutingService::DEFAULT_FILENAME_BASE);
+  osmscout::CHRoutingService     chRouter(database,
+                                          routerParameter,
+                                          osmscout::RoutingService::DEFAULT_FILENAME_BASE);
+
+  if (!aStarRouter.Open() ||
+      !chRouter.Open()) {
+    std::cerr << "Cannot open routers" << std::endl;
+    return 1;
+  }
+
+  NoPenaltyRoutingProfile profile(database->GetTypeConfig(),160.0);
+
+  // Build the hierarchy and write it to and read it from disk
+  osmscout::ConsoleProgress             progress;
+  osmscout::ContractionHierarchyBuilder builder(profile);
+  osmscout::ContractionHierarchy        builtHierarchy;
+  osmscout::ContractionHierarchyRef     hierarchy=std::make_shared<osmscout::ContractionHierarchy>();
+  std::string                           filename="ch_test.dat";
+
+  if (!builder.Build(progress,
+                     *database->GetTypeConfig(),
+                     args.databaseDirectory,
+                     osmscout::RoutingService::DEFAULT_FILENAME_BASE,
+                     builtHierarchy) ||
+      !builtHierarchy.Store(filename) ||
+      !hierarchy->Load(filename)) {
+    std::cerr << "Cannot build contraction hierarchy" << std::endl;
+    return 1;
+  }
+
+  std::remove(filename.c_str());
+
+  if (hierarchy->GetNodeCount()!=builtHierarchy.GetNodeCount() ||
+      hierarchy->GetEdgeCount()!=builtHierarchy.GetEdgeCount() ||
+      hierarchy->GetVehicle()!=osmscout::vehicleCar ||
+      hierarchy->GetCostParameters()!=profile.GetCostParameters()) {
+    std::cerr << "Loaded contraction hierarchy differs" << std::endl;
+    return 1;
+  }
+
+  chRouter.SetContractionHierarchy(hierarchy);
+
+  osmscout::Distance radius=osmscout::Kilometers(1);
+  auto               startResult=aStarRouter.GetClosestRoutableNode(args.start,profile,radius);
+  auto               targetResult=aStarRouter.GetClosestRoutableNode(args.target,profile,radius);
+
+  if (!startResult.IsValid() ||
+      !targetResult.IsValid()) {
+    std::cerr << "Cannot find start or target" << std::endl;
+    return 1;
+  }
+
+  osmscout::RoutingParameter parameter;
+
+  std::cout << "A*:" << std::endl;
+  auto aStarResult=aStarRouter.CalculateRoute(profile,
+                                              startResult.GetRoutePosition(),
+                                              targetResult.GetRoutePosition(),
+                                              parameter);
+
+  std::cout << "Contraction hierarchy:" << std::endl;
+  auto chResult=chRouter.CalculateRoute(profile,
+                                        startResult.GetRoutePosition(),
+                                        targetResult.GetRoutePosition(),
+                                        parameter);
+
+  if (!aStarResult.Success() ||
+      !chResult.Success()) {
+    std::cerr << "Route failed" << std::endl;
+    return 1;
+  }
+
+  double aStarLength=GetRouteLength(aStarRouter,aStarResult);
+  double chLength=GetRouteLength(chRouter,chResult);
+
+  std::cout << "A* route length: " << aStarLength << " m, contraction hierarchy route length: " << chLength << " m" << std::endl;
+
+  if (aStarLength<=0.0 ||
+      std::fabs(aStarLength-chLength)>0.01*aStarLength) {
+    std::cerr << "Routes differ" << std::endl;
+    return 1;
+  }
+
+  auto descriptionResult=chRouter.TransformRouteDataToRouteDescription(chResult.GetRoute());
+
+  if (!descriptionResult.Success()) {
+    std::cerr << "Cannot transform route to description" << std::endl;
+    return 1;
+  }
+
+  // A profile with other costs must not use the hierarchy but get the A* route
+  NoPenaltyRoutingProfile slowProfile(database->GetTypeConfig(),30.0);
+
+  std::cout << "A* (slow):" << std::endl;
+  aStarResult=aStarRouter.CalculateRoute(slowProfile,
+                                         startResult.GetRoutePosition(),
+                                         targetResult.GetRoutePosition(),
+                                         parameter);
+
+  std::cout << "Contraction hierarchy (slow):" << std::endl;
+  chResult=chRouter.CalculateRoute(slowProfile,
+                                   startResult.GetRoutePosition(),
+                                   targetResult.GetRoutePosition(),
+                                   parameter);
+
+  if (!aStarResult.Success() ||
+      !chResult.Success()) {
+    std::cerr << "Route failed" << std::endl;
+    return 1;
+  }
+
+  aStarLength=GetRouteLength(aStarRouter,aStarResult);
+  chLength=GetRouteLength(chRouter,chResult);
+
+  std::cout << "A* route length: " << aStarLength << " m, route length with non matching profile: " << chLength << " m" << std::endl;
+
+  if (aStarLength!=chLength) {
+    std::cerr << "Route with non matching profile differs from A* route" << std::endl;
+    return 1;
+  }
+
+  // The default car profile applies junction penalties, the hierarchy does not
+  osmscout::FastestPathRoutingProfile penaltyProfile(database->GetTypeConfig());
+  std::map<std::string,double>        speedMap;
+
+  GetCarSpeedTable(speedMap);
+  penaltyProfile.ParametrizeForCar(*database->GetTypeConfig(),speedMap,160.0);
+
+  if (penaltyProfile.GetCostParameters()==hierarchy->GetCostParameters()) {
+    std::cerr << "Profile with junction penalties matches the contraction hierarchy" << std::endl;
+    return 1;
+  }
+
+  std::cout << "A* (junction penalties):" << std::endl;
+  aStarResult=aStarRouter.CalculateRoute(penaltyProfile,
+                                         startResult.GetRoutePosition(),
+                                         targetResult.GetRoutePosition(),
+                                         parameter);
+
+  std::cout << "Contraction hierarchy (junction penalties):" << std::endl;
+  chResult=chRouter.CalculateRoute(penaltyProfile,
+                                   startResult.GetRoutePosition(),
+                                   targetResult.GetRoutePosition(),
+                                   parameter);
+
+  if (!aStarResult.Success() ||
+      !chResult.Success()) {
+    std::cerr << "Route failed" << std::endl;
+    return 1;
+  }
+
+  aStarLength=GetRouteLength(aStarRouter,aStarResult);
+  chLength=GetRouteLength(chRouter,chResult);
+
+  std::cout << "A* route length: " << aStarLength << " m, route length with junction penalties: " << chLength << " m" << std::endl;
+
+  if (aStarLength!=chLength) {
+    std::cerr << "Route with junction penalties differs from A* route" << std::endl;
+    return 1;
+  }
+
+  chRouter.Close();
+  aStarRouter.Close();
+  database->Close();
+
+  return 0;
+}
@@ -0,0 +1,214 @@
+/*
+  CRPRouting - a test program for libosmscout
+  Copyright (C) 2026  Tim Teulings
+
+  This program is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 2 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+*/
+
+#include <cmath>
+#include <cstdio>
+#include <iostream>
+
+#include <osmscout/Database.h>
+
+#include <osmscout/routing/CRPRoutingService.h>
+#include <osmscout/routing/RoutePartition.h>
+#include <osmscout/routing/SimpleRoutingService.h>
+
+#include <osmscout/util/Geometry.h>
+
+#include <RoutingTest.h>
+
+/**
+ * The partition does not know about junction penalties, so compare against
+ * A* without them
+ */
+class NoPenaltyRoutingProfile : public osmscout::FastestPathRoutingProfile
+{
+public:
+  explicit NoPenaltyRoutingProfile(const osmscout::TypeConfigRef& typeConfig)
+  : osmscout::FastestPathRoutingProfile(typeConfig)
+  {
+    std::map<std::string,double> speedMap;
+
+    GetCarSpeedTable(speedMap);
+    ParametrizeForCar(*typeConfig,speedMap,160.0);
+    applyJunctionPenalty=false;
+  }
+};
+
+class CarShortestPathRoutingProfile : public osmscout::ShortestPathRoutingProfile
+{
+public:
+  explicit CarShortestPathRoutingProfile(const osmscout::TypeConfigRef& typeConfig)
+  : osmscout::ShortestPathRoutingProfile(typeConfig)
+  {
+    std::map<std::string,double> speedMap;
+
+    GetCarSpeedTable(speedMap);
+    ParametrizeForCar(*typeConfig,speedMap,160.0);
+  }
+};
+
+double GetRouteLength(osmscout::SimpleRoutingService& router,
+                      const osmscout::RoutingResult& result)
+{
+  auto   pointsResult=router.TransformRouteDataToPoints(result.GetRoute());
+  double length=0.0;
+
+  if (!pointsResult.Success()) {
+    return -1.0;
+  }
+
+  const auto& points=pointsResult.GetPoints()->points;
+
+  for (size_t i=1; i<points.size(); i++) {
+    length+=osmscout::GetSphericalDistance(points[i-1].GetCoord(),
+                                           points[i].GetCoord()).AsMeter();
+  }
+
+  return length;
+}
+
+int main(int argc, char* argv[])
+{
+  RoutingTestArguments args;
+  int                  exitCode;
+
+  if (!ParseRoutingTestArguments("CRPRouting",argc,argv,args,exitCode)) {
+    return exitCode;
+  }
+
+  osmscout::DatabaseParameter dbParameter;
+  osmscout::DatabaseRef       database=std::make_shared<osmscout::Database>(dbParameter);
+
+  if (!database->Open(args.databaseDirectory)) {
+    std::cerr << "Cannot open database " << args.databaseDirectory << std::endl;
+    return 1;
+  }
+
+  osmscout::RouterParameter routerParameter;
+
+  routerParameter.SetDebugPerformance(true);
+
+  osmscout::SimpleRoutingService aStarRouter(database,
+                                             routerParameter,
+                                             osmscout::RoutingService::DEFAULT_FILENAME_BASE);
+  osmscout::CRPRoutingService    crpRouter(database,
+                                           routerParameter,
+                                           osmscout::RoutingService::DEFAULT_FILENAME_BASE);
+
+  if (!aStarRouter.Open() ||
+      !crpRouter.Open()) {
+    std::cerr << "Cannot open routers" << std::endl;
+    return 1;
+  }
+
+  // Build the partition with small cells to get multiple levels and
+  // write it to and read it from disk
+  osmscout::ConsoleProgress    progress;
+  osmscout::RoutePartition     builtPartition;
+  osmscout::RoutePartitionRef  partition=std::make_shared<osmscout::RoutePartition>();
+  std::string                  filename="crp_test.dat";
+
+  if (!builtPartition.Build(progress,
+                            *database->GetTypeConfig(),
+                            args.databaseDirectory,
+                            osmscout::RoutingService::DEFAULT_FILENAME_BASE,
+                            16,
+                            2) ||
+      !builtPartition.Store(filename) ||
+      !partition->Load(*database->GetTypeConfig(),filename)) {
+    std::cerr << "Cannot build route partition" << std::endl;
+    return 1;
+  }
+
+  std::remove(filename.c_str());
+
+  if (partition->GetNodeCount()!=builtPartition.GetNodeCount() ||
+      partition->GetLevelCount()!=builtPartition.GetLevelCount() ||
+      partition->GetLevelCount()<2 ||
+      partition->GetBoundaryNodeCount(1)!=builtPartition.GetBoundaryNodeCount(1)) {
+    std::cerr << "Loaded route partition differs" << std::endl;
+    return 1;
+  }
+
+  crpRouter.SetRoutePartition(partition);
+
+  NoPenaltyRoutingProfile             fastestProfile(database->GetTypeConfig());
+  CarShortestPathRoutingProfile       shortestProfile(database->GetTypeConfig());
+
+  // Customize the same partition for two different profiles
+  for (osmscout::RoutingProfile* profile : std::initializer_list<osmscout::RoutingProfile*>{&fastestProfile,&shortestProfile}) {
+    if (!crpRouter.Customize(*profile,2)) {
+      std::cerr << "Cannot customize route partition" << std::endl;
+      return 1;
+    }
+
+    osmscout::Distance radius=osmscout::Kilometers(1);
+    auto               startResult=aStarRouter.GetClosestRoutableNode(args.start,*profile,radius);
+    auto               targetResult=aStarRouter.GetClosestRoutableNode(args.target,*profile,radius);
+
+    if (!startResult.IsValid() ||
+        !targetResult.IsValid()) {
+      std::cerr << "Cannot find start or target" << std::endl;
+      return 1;
+    }
+
+    osmscout::RoutingParameter parameter;
+
+    std::cout << "A*:" << std::endl;
+    auto aStarResult=aStarRouter.CalculateRoute(*profile,
+                                                startResult.GetRoutePosition(),
+                                                targetResult.GetRoutePosition(),
+                                                parameter);
+
+    std::cout << "Customizable route planning:" << std::endl;
+    auto crpResult=crpRouter.CalculateRoute(*profile,
+                                            startResult.GetRoutePosition(),
+                                            targetResult.GetRoutePosition(),
+                                            parameter);
+
+    if (!aStarResult.Success() ||
+        !crpResult.Success()) {
+      std::cerr << "Route failed" << std::endl;
+      return 1;
+    }
+
+    double aStarLength=GetRouteLength(aStarRouter,aStarResult);
+    double crpLength=GetRouteLength(crpRouter,crpResult);
+
+    std::cout << "A* route length: " << aStarLength << " m, customizable route planning route length: " << crpLength << " m" << std::endl;
+
+    if (aStarLength<=0.0 ||
+        std::fabs(aStarLength-crpLength)>0.01*aStarLength) {
+      std::cerr << "Routes differ" << std::endl;
+      return 1;
+    }
+
+    auto descriptionResult=crpRouter.TransformRouteDataToRouteDescription(crpResult.GetRoute());
+
+    if (!descriptionResult.Success()) {
+      std::cerr << "Cannot transform route to description" << std::endl;
+      return 1;
+    }
+  }
+
+  crpRouter.Close();
+  aStarRouter.Close();
+  database->Close();
+
+  return 0;
+}
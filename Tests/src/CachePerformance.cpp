@@ -19,10 +19,14 @@
 
 #include <cstdlib>
 #include <iostream>
+#include <memory>
+#include <thread>
 #include <vector>
 
 #include <osmscout/util/Cache.h>
+#include <osmscout/util/ConcurrentCache.h>
 #include <osmscout/util/FileScanner.h>
+#include <osmscout/util/MemoryGovernor.h>
 #include <osmscout/util/StopClock.h>
 #include <osmscout/util/CmdLineParsing.h>
 
@@ -31,6 +35,9 @@
   * cache insertion
   * cache hit
   * cache miss
+  * concurrent cache hit, miss and mixed workloads with multiple threads
+  * concurrent cache memory budget
+  * rebalancing of a memory budget between caches by MemoryGovernor
 */
 
 /**
@@ -49,6 +56,17 @@ struct Data
 
 typedef osmscout::Cache<osmscout::Id,Data>     DataCache;
 
+using DataRef             = std::shared_ptr<Data>;
+using ConcurrentDataCache = osmscout::ConcurrentCache<osmscout::Id,DataRef>;
+
+struct DataSizer : public ConcurrentDataCache::ValueSizer
+{
+  size_t GetSize(const DataRef& value) const override
+  {
+    return sizeof(value)+sizeof(Data)+value->value2.capacity()*sizeof(size_t);
+  }
+};
+
 bool TestData(size_t cacheSize)
 {
   std::cout << "*** Caching of struct ***" << std::endl;
@@ -159,10 +177,324 @@ bool TestData(size_t cacheSize)
   return true;
 }
 
+/**
+ * Run the given function in parallel in the given number of threads.
+ * Returns false, if the function returned false for at least one thread.
+ */
+template<typename Function>
+bool RunThreads(size_t threadCount,
+                Function function)
+{
+  std::vector<std::thread> threads(threadCount);
+  std::vector<char>        results(threadCount,0);
+
+  for (size_t t=0; t<threadCount; t++) {
+    threads[t]=std::thread([&results,&function,t]() {
+      results[t]=function(t) ? 1 : 0;
+    });
+  }
+
+  bool result=true;
+
+  for (size_t t=0; t<threadCount; t++) {
+    threads[t].join();
+
+    if (results[t]==0) {
+      result=false;
+    }
+  }
+
+  return result;
+}
+
+bool TestConcurrentData(size_t cacheSize,
+                        size_t threadCount)
+{
+  std::cout << "*** Concurrent caching of struct with " << threadCount << " thread(s) ***" << std::endl;
+
+  ConcurrentDataCache cache(cacheSize);
+
+  std::cout << "Inserting values into cache..." << std::endl;
+
+  osmscout::StopClock insertTimer;
+
+  RunThreads(threadCount,[&](size_t t) {
+    for (size_t i=cacheSize+t; i<2*cacheSize; i+=threadCount) {
+      DataRef data=std::make_shared<Data>();
+
+      data->value=i;
+      data->value2.resize(10,i);
+
+      cache.SetEntry(i,data);
+    }
+
+    return true;
+  });
+
+  insertTimer.Stop();
+
+  if (cache.GetSize()>cacheSize+ConcurrentDataCache::DefaultShardCount) {
+    std::cerr << "Cache holds " << cache.GetSize() << " entries, but is limited to " << cacheSize << std::endl;
+    return false;
+  }
+
+  // Entries are distributed over shards by hash, so not every entry may have
+  // found room in its shard. Lookups from now on must not change the content.
+  size_t expectedHits=0;
+
+  for (size_t i=cacheSize; i<2*cacheSize; i++) {
+    DataRef data;
+
+    if (cache.GetEntry(i,data)) {
+      if (data->value!=i) {
+        return false;
+      }
+
+      expectedHits++;
+    }
+  }
+
+  std::cout << "Searching for entries not in cache..." << std::endl;
+
+  osmscout::StopClock missTimer;
+
+  bool missResult=RunThreads(threadCount,[&](size_t) {
+    for (size_t i=0; i<cacheSize; i++) {
+      DataRef data;
+
+      if (cache.GetEntry(i,data)) {
+        return false;
+      }
+    }
+
+    return true;
+  });
+
+  missTimer.Stop();
+
+  if (!missResult) {
+    std::cerr << "Found entries not in cache" << std::endl;
+    return false;
+  }
+
+  std::cout << "Searching for entries in cache..." << std::endl;
+
+  osmscout::StopClock hitTimer;
+
+  bool hitResult=RunThreads(threadCount,[&](size_t) {
+    for (size_t t=1; t<=2; t++) {
+      size_t hits=0;
+
+      for (size_t i=cacheSize; i<2*cacheSize; i++) {
+        DataRef data;
+
+        if (cache.GetEntry(i,data)) {
+          if (data->value!=i) {
+            return false;
+          }
+
+          hits++;
+        }
+      }
+
+      if (hits!=expectedHits) {
+        return false;
+      }
+    }
+
+    return true;
+  });
+
+  hitTimer.Stop();
+
+  if (!hitResult) {
+    std::cerr << "Unexpected cache hits" << std::endl;
+    return false;
+  }
+
+  std::cout << "Mixed lookup and insertion..." << std::endl;
+
+  osmscout::StopClock mixedTimer;
+
+  bool mixedResult=RunThreads(threadCount,[&](size_t t) {
+    // Every thread works on a key range twice the size of the cache, overlapping with the others
+    for (size_t i=t*cacheSize/2; i<t*cacheSize/2+2*cacheSize; i++) {
+      DataRef data;
+
+      if (cache.GetEntry(i,data)) {
+        if (data->value!=i) {
+          return false;
+        }
+      }
+      else {
+        data=std::make_shared<Data>();
+        data->value=i;
+
+        cache.SetEntry(i,data);
+      }
+    }
+
+    return true;
+  });
+
+  mixedTimer.Stop();
+
+  if (!mixedResult) {
+    std::cerr << "Wrong value returned from cache" << std::endl;
+    return false;
+  }
+
+  if (cache.GetSize()>cacheSize+ConcurrentDataCache::DefaultShardCount) {
+    std::cerr << "Cache holds " << cache.GetSize() << " entries, but is limited to " << cacheSize << std::endl;
+    return false;
+  }
+
+  std::cout << "Insert time: "  << insertTimer << std::endl;
+  std::cout << "Miss time: "  << missTimer << std::endl;
+  std::cout << "Hit time: "  << hitTimer << std::endl;
+  std::cout << "Mixed time: "  << mixedTimer << std::endl;
+  std::cout << "Hits: " << cache.GetHits() << ", misses: " << cache.GetMisses() << std::endl;
+
+  return true;
+}
+
+bool TestConcurrentMemoryBudget(size_t cacheSize,
+                                size_t threadCount)
+{
+  std::cout << "*** Concurrent caching with memory budget with " << threadCount << " thread(s) ***" << std::endl;
+
+  ConcurrentDataCache cache(cacheSize);
+  DataSizer           sizer;
+  DataRef             sample=std::make_shared<Data>();
+
+  sample->value2.resize(10);
+
+  // Room for about half of the entries we insert
+  size_t maxMemory=cacheSize*sizer.GetSize(sample)/2;
+
+  cache.SetMaxMemory(maxMemory,
+                     std::make_shared<DataSizer>());
+
+  RunThreads(threadCount,[&](size_t t) {
+    for (size_t i=t; i<cacheSize; i+=threadCount) {
+      DataRef data=std::make_shared<Data>();
+
+      data->value=i;
+      data->value2.resize(10,i);
+
+      cache.SetEntry(i,data);
+    }
+
+    return true;
+  });
+
+  std::cout << "Memory: " << cache.GetMemory() << "/" << maxMemory << ", entries: " << cache.GetSize() << std::endl;
+
+  // Rounding of the per shard budget may add one byte per shard
+  if (cache.GetMemory()>maxMemory+ConcurrentDataCache::DefaultShardCount) {
+    std::cerr << "Memory budget exceeded" << std::endl;
+    return false;
+  }
+
+  if (cache.GetSize()==0 ||
+      cache.GetSize()>=cacheSize) {
+    std::cerr << "Unexpected number of entries in cache" << std::endl;
+    return false;
+  }
+
+  return true;
+}
+
+bool TestMemoryGovernor(size_t cacheSize)
+{
+  std::cout << "*** Memory governor ***" << std::endl;
+
+  DataSizer sizer;
+  DataRef   sample=std::make_shared<Data>();
+
+  sample->value2.resize(10);
+
+  // Room for about half of the entries of one cache
+  size_t                   budget=cacheSize*sizer.GetSize(sample)/2;
+  osmscout::MemoryGovernor governor(budget);
+  ConcurrentDataCache      hotCache(0);
+  ConcurrentDataCache      coldCache(0);
+
+  hotCache.SetMaxMemory(0,std::make_shared<DataSizer>());
+  coldCache.SetMaxMemory(0,std::make_shared<DataSizer>());
+
+  governor.Register(hotCache,"hot",1.0);
+  governor.Register(coldCache,"cold",1.0);
+
+  if (governor.GetCacheBudget(hotCache)!=governor.GetCacheBudget(coldCache)) {
+    std::cerr << "Initial budgets are not split by weight" << std::endl;
+    return false;
+  }
+
+  size_t coldEntries=cacheSize/100;
+
+  for (size_t round=1; round<=5; round++) {
+    // The hot cache misses a lot, the cold cache is small and always hits
+    for (size_t i=0; i<cacheSize; i++) {
+      DataRef data;
+
+      if (!hotCache.GetEntry(i,data)) {
+        data=std::make_shared<Data>();
+        data->value=i;
+        data->value2.resize(10,i);
+
+        hotCache.SetEntry(i,data);
+      }
+    }
+
+    for (size_t i=0; i<coldEntries; i++) {
+      DataRef data;
+
+      if (!coldCache.GetEntry(i,data)) {
+        data=std::make_shared<Data>();
+        data->value=i;
+        data->value2.resize(10,i);
+
+        coldCache.SetEntry(i,data);
+      }
+    }
+
+    governor.Rebalance();
+
+    std::cout << "Round " << round << ": hot " << hotCache.GetMemory() << "/" << governor.GetCacheBudget(hotCache)
+              << ", cold " << coldCache.GetMemory() << "/" << governor.GetCacheBudget(coldCache) << std::endl;
+
+    // Rounding of the per shard budget may add one byte per shard and cache
+    if (governor.GetUsedMemory()>budget+2*ConcurrentDataCache::DefaultShardCount) {
+      std::cerr << "Memory budget exceeded" << std::endl;
+      return false;
+    }
+  }
+
+  if (governor.GetCacheBudget(hotCache)<=governor.GetCacheBudget(coldCache) ||
+      governor.GetCacheBudget(coldCache)<coldCache.GetMemory()) {
+    std::cerr << "Budget was not moved to the hot cache" << std::endl;
+    return false;
+  }
+
+  governor.Unregister(coldCache);
+
+  if (governor.GetCacheCount()!=1 ||
+      governor.GetCacheBudget(hotCache)!=budget) {
+    std::cerr << "Budget of unregistered cache was not returned" << std::endl;
+    return false;
+  }
+
+  governor.Unregister(hotCache);
+
+  return true;
+}
+
 int main(int argc, char* argv[])
 {
   using namespace std::string_literals;
   size_t cacheSize=2000000;
+  size_t threadCount=std::max(2u,std::thread::hardware_concurrency());
   bool help=false;
   osmscout::CmdLineParser argParser("CachePerformance", argc, argv);
 
@@ -179,6 +511,12 @@ int main(int argc, char* argv[])
                 "size",
                 "Cache size used for the test, default: "s + std::to_string(cacheSize));
 
+  argParser.AddOption(osmscout::CmdLineSizeTOption([&](const size_t& value) {
+                  threadCount=std::max(size_t(1),value);
+                }),
+                "threads",
+                "Thread count for the concurrent tests, default: "s + std::to_string(threadCount));
+
   osmscout::CmdLineParseResult argResult=argParser.Parse();
   if (argResult.HasError()) {
     std::cerr << "ERROR: " << argResult.GetErrorDescription() << std::endl;
@@ -190,5 +528,18 @@ int main(int argc, char* argv[])
     return 0;
   }
 
-  return TestData(cacheSize) ? 0:1;
+  if (!TestData(cacheSize)) {
+    return 1;
+  }
+
+  if (!TestConcurrentData(cacheSize,1) ||
+      !TestConcurrentData(cacheSize,threadCount)) {
+    return 1;
+  }
+
+  if (!TestConcurrentMemoryBudget(cacheSize,threadCount)) {
+    return 1;
+  }
+
+  return TestMemoryGovernor(cacheSize) ? 0:1;
 }
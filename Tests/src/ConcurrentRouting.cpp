@@ -0,0 +1,183 @@
+/*
+  ConcurrentRouting - a test program for libosmscout
+  Copyright (C) 2026  Tim Teulings
+
+  This program is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 2 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+*/
+
+#include <atomic>
+#include <iostream>
+#include <thread>
+
+#include <osmscout/Database.h>
+
+#include <osmscout/routing/SimpleRoutingService.h>
+
+#include <osmscout/util/Geometry.h>
+
+#include <RoutingTest.h>
+
+struct RouteSummary
+{
+  bool   success=false;
+  size_t entries=0;
+  double length=0.0;
+
+  bool operator==(const RouteSummary& other) const
+  {
+    return success==other.success &&
+           entries==other.entries &&
+           length==other.length;
+  }
+};
+
+RouteSummary CalculateRoute(osmscout::SimpleRoutingService& router,
+                            osmscout::RoutingProfile& profile,
+                            const osmscout::RoutePosition& start,
+                            const osmscout::RoutePosition& target)
+{
+  osmscout::RoutingParameter parameter;
+  RouteSummary               summary;
+  auto                       result=router.CalculateRoute(profile,
+                                                          start,
+                                                          target,
+                                                          parameter);
+
+  if (!result.Success()) {
+    return summary;
+  }
+
+  auto pointsResult=router.TransformRouteDataToPoints(result.GetRoute());
+
+  if (!pointsResult.Success()) {
+    return summary;
+  }
+
+  const auto& points=pointsResult.GetPoints()->points;
+
+  for (size_t i=1; i<points.size(); i++) {
+    summary.length+=osmscout::GetSphericalDistance(points[i-1].GetCoord(),
+                                                   points[i].GetCoord()).AsMeter();
+  }
+
+  summary.success=true;
+  summary.entries=result.GetRoute().Entries().size();
+
+  return summary;
+}
+
+int main(int argc, char* argv[])
+{
+  RoutingTestArguments args;
+  int                  exitCode;
+
+  if (!ParseRoutingTestArguments("ConcurrentRouting",argc,argv,args,exitCode)) {
+    return exitCode;
+  }
+
+  osmscout::DatabaseParameter dbParameter;
+  osmscout::DatabaseRef       database=std::make_shared<osmscout::Database>(dbParameter);
+
+  if (!database->Open(args.databaseDirectory)) {
+    std::cerr << "Cannot open database " << args.databaseDirectory << std::endl;
+    return 1;
+  }
+
+  osmscout::RouterParameter routerParameter;
+
+  osmscout::SimpleRoutingService router(database,
+                                        routerParameter,
+                                        osmscout::RoutingService::DEFAULT_FILENAME_BASE);
+
+  if (!router.Open()) {
+    std::cerr << "Cannot open router" << std::endl;
+    return 1;
+  }
+
+  std::map<std::string,double>        speedMap;
+  osmscout::FastestPathRoutingProfile profile(database->GetTypeConfig());
+
+  GetCarSpeedTable(speedMap);
+  profile.ParametrizeForCar(*database->GetTypeConfig(),speedMap,160.0);
+
+  // Start, target and points on a grid between them
+  std::vector<osmscout::RoutePosition> positions;
+
+  for (size_t i=0; i<=2; i++) {
+    for (size_t j=0; j<=2; j++) {
+      osmscout::GeoCoord coord(args.start.GetLat()+(args.target.GetLat()-args.start.GetLat())*i/2,
+                               args.start.GetLon()+(args.target.GetLon()-args.start.GetLon())*j/2);
+      auto               position=router.GetClosestRoutableNode(coord,profile,osmscout::Kilometers(1));
+
+      if (position.IsValid()) {
+        positions.push_back(position.GetRoutePosition());
+      }
+    }
+  }
+
+  if (positions.size()<2) {
+    std::cerr << "Cannot find routable nodes" << std::endl;
+    return 1;
+  }
+
+  // Reference results, calculated sequentially
+  std::vector<std::pair<size_t,size_t>> pairs;
+  std::vector<RouteSummary>             expected;
+
+  for (size_t s=0; s<positions.size(); s++) {
+    for (size_t t=0; t<positions.size(); t++) {
+      if (s!=t) {
+        pairs.emplace_back(s,t);
+        expected.push_back(CalculateRoute(router,profile,positions[s],positions[t]));
+      }
+    }
+  }
+
+  const size_t             threadCount=8;
+  const size_t             queryCount=400;
+  std::atomic<size_t>      nextQuery(0);
+  std::atomic<size_t>      failures(0);
+  std::vector<std::thread> threads;
+
+  // All threads share the router and the profile
+  for (size_t i=0; i<threadCount; i++) {
+    threads.emplace_back([&]() {
+      size_t query;
+
+      while ((query=nextQuery++)<queryCount) {
+        size_t       pair=query%pairs.size();
+        RouteSummary summary=CalculateRoute(router,
+                                            profile,
+                                            positions[pairs[pair].first],
+                                            positions[pairs[pair].second]);
+
+        if (!(summary==expected[pair])) {
+          failures++;
+        }
+      }
+    });
+  }
+
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  std::cout << queryCount << " queries in " << threadCount << " threads on " << pairs.size() << " routes, " << failures << " failures" << std::endl;
+
+  router.Close();
+  database->Close();
+
+  return failures==0 ? 0 : 1;
+}
@@ -0,0 +1,273 @@
+/*
+  DataFilePerformance - a test program for libosmscout
+  Copyright (C) 2026  Tim Teulings
+
+  This program is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 2 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+*/
+
+#include <algorithm>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <thread>
+#include <vector>
+
+#include <osmscout/TypeConfig.h>
+#include <osmscout/WayDataFile.h>
+
+#include <osmscout/util/CmdLineParsing.h>
+#include <osmscout/util/File.h>
+#include <osmscout/util/StopClock.h>
+
+/**
+  Check throughput of concurrent reads from ways.dat with an
+  increasing number of threads.
+
+  The data file is created without cache, so every request
+  decodes its objects from the file.
+*/
+
+bool CollectWayOffsets(const osmscout::TypeConfig& typeConfig,
+                       const std::string& databasePath,
+                       bool memoryMapped,
+                       std::vector<osmscout::FileOffset>& offsets)
+{
+  osmscout::FileScanner scanner;
+
+  try {
+    uint32_t wayCount;
+
+    scanner.Open(osmscout::AppendFileToDir(databasePath,
+                                           osmscout::WayDataFile::WAYS_DAT),
+                 osmscout::FileScanner::Sequential,
+                 memoryMapped);
+
+    scanner.Read(wayCount);
+
+    offsets.reserve(wayCount);
+
+    for (uint32_t w=1; w<=wayCount; w++) {
+      osmscout::Way way;
+
+      way.Read(typeConfig,
+               scanner);
+
+      offsets.push_back(way.GetFileOffset());
+    }
+
+    scanner.Close();
+  }
+  catch (osmscout::IOException& e) {
+    std::cerr << e.GetDescription() << std::endl;
+    scanner.CloseFailsafe();
+    return false;
+  }
+
+  return true;
+}
+
+void ReadWays(const osmscout::WayDataFile& wayDataFile,
+              const std::vector<osmscout::FileOffset>& offsets,
+              size_t iterationCount,
+              size_t batchSize,
+              bool& result)
+{
+  result=true;
+
+  for (size_t i=1; i<=iterationCount; i++) {
+    for (size_t start=0; start<offsets.size(); start+=batchSize) {
+      auto                               begin=offsets.begin()+start;
+      auto                               end=offsets.begin()+std::min(start+batchSize,offsets.size());
+      std::vector<osmscout::WayRef>      ways;
+
+      if (!wayDataFile.GetByOffset(begin,
+                                   end,
+                                   end-begin,
+                                   ways)) {
+        result=false;
+        return;
+      }
+
+      for (const auto& way : ways) {
+        if (way->GetFileOffset()!=*begin) {
+          result=false;
+          return;
+        }
+
+        ++begin;
+      }
+    }
+  }
+}
+
+bool RunBenchmark(const osmscout::WayDataFile& wayDataFile,
+                  const std::vector<osmscout::FileOffset>& offsets,
+                  size_t threadCount,
+                  size_t iterationCount,
+                  size_t batchSize)
+{
+  std::vector<std::thread> threads(threadCount);
+  std::vector<char>        results(threadCount);
+  std::vector<std::vector<osmscout::FileOffset>> threadOffsets(threadCount,offsets);
+  bool                     result=true;
+
+  // Every thread reads the same objects, but in a different order
+  for (size_t t=0; t<threadCount; t++) {
+    std::shuffle(threadOffsets[t].begin(),
+                 threadOffsets[t].end(),
+                 std::mt19937(static_cast<unsigned int>(t)));
+  }
+
+  osmscout::StopClock timer;
+
+  for (size_t t=0; t<threadCount; t++) {
+    threads[t]=std::thread([&,t]() {
+      bool threadResult;
+
+      ReadWays(wayDataFile,
+               threadOffsets[t],
+               iterationCount,
+               batchSize,
+               threadResult);
+
+      results[t]=threadResult ? 1 : 0;
+    });
+  }
+
+  for (size_t t=0; t<threadCount; t++) {
+    threads[t].join();
+
+    if (results[t]==0) {
+      result=false;
+    }
+  }
+
+  timer.Stop();
+
+  double waysRead=double(offsets.size()*iterationCount*threadCount);
+  double seconds=timer.GetMilliseconds()/1000.0;
+
+  std::cout << threadCount << " thread(s): " << timer.ResultString() << ", ";
+  if (seconds>0) {
+    std::cout << size_t(waysRead/seconds) << " ways/s";
+  }
+  std::cout << (result ? "" : " ERROR") << std::endl;
+
+  return result;
+}
+
+int main(int argc, char* argv[])
+{
+  using namespace std::string_literals;
+  bool        help=false;
+  std::string databasePath;
+  size_t      maxThreadCount=std::max(1u,std::thread::hardware_concurrency());
+  size_t      iterationCount=10;
+  size_t      batchSize=1000;
+  bool        memoryMapped=true;
+
+  osmscout::CmdLineParser argParser("DataFilePerformance", argc, argv);
+
+  argParser.AddOption(osmscout::CmdLineFlag([&](const bool& value) {
+                        help=value;
+                      }),
+                      std::vector<std::string>{"h","help"},
+                      "Display help",
+                      true);
+
+  argParser.AddOption(osmscout::CmdLineSizeTOption([&](const size_t& value) {
+                        maxThreadCount=std::max(size_t(1),value);
+                      }),
+                      "threads",
+                      "Maximum thread count for test, default: "s + std::to_string(maxThreadCount));
+
+  argParser.AddOption(osmscout::CmdLineSizeTOption([&](const size_t& value) {
+                        iterationCount=value;
+                      }),
+                      "iterations",
+                      "Iterations per thread, default: "s + std::to_string(iterationCount));
+
+  argParser.AddOption(osmscout::CmdLineSizeTOption([&](const size_t& value) {
+                        batchSize=std::max(size_t(1),value);
+                      }),
+                      "batch",
+                      "Number of offsets per request, default: "s + std::to_string(batchSize));
+
+  argParser.AddOption(osmscout::CmdLineBoolOption([&](const bool& value) {
+                        memoryMapped=value;
+                      }),
+                      "mmap",
+                      "Memory map ways.dat, default: "s + (memoryMapped ? "true" : "false"));
+
+  argParser.AddPositional(osmscout::CmdLineStringOption([&](const std::string& value) {
+                            databasePath=value;
+                          }),
+                          "database directory",
+                          "Database directory");
+
+  osmscout::CmdLineParseResult argResult=argParser.Parse();
+  if (argResult.HasError()) {
+    std::cerr << "ERROR: " << argResult.GetErrorDescription() << std::endl;
+    std::cout << argParser.GetHelp() << std::endl;
+    return 1;
+  }
+  if (help){
+    std::cout << argParser.GetHelp() << std::endl;
+    return 0;
+  }
+
+  osmscout::TypeConfigRef typeConfig=std::make_shared<osmscout::TypeConfig>();
+
+  if (!typeConfig->LoadFromDataFile(databasePath)) {
+    std::cerr << "Cannot load type configuration from '" << databasePath << "'" << std::endl;
+    return 1;
+  }
+
+  std::vector<osmscout::FileOffset> offsets;
+
+  if (!CollectWayOffsets(*typeConfig,
+                         databasePath,
+                         memoryMapped,
+                         offsets)) {
+    return 1;
+  }
+
+  std::cout << "Reading " << offsets.size() << " way(s) per thread and iteration" << std::endl;
+
+  osmscout::WayDataFile wayDataFile(0);
+
+  if (!wayDataFile.Open(typeConfig,
+                        databasePath,
+                        memoryMapped)) {
+    std::cerr << "Cannot open '" << osmscout::WayDataFile::WAYS_DAT << "'" << std::endl;
+    return 1;
+  }
+
+  bool result=true;
+
+  for (size_t threadCount=1; threadCount<=maxThreadCount; threadCount*=2) {
+    if (!RunBenchmark(wayDataFile,
+                      offsets,
+                      threadCount,
+                      iterationCount,
+                      batchSize)) {
+      result=false;
+    }
+  }
+
+  wayDataFile.Close();
+
+  return result ? 0 : 1;
+}
@@ -341,3 +341,180 @@ TEST_CASE("FileScannerWriter")
         scanner.Close();
     }
 }
+
+TEST_CASE("PointSequenceView")
+{
+    osmscout::FileWriter  writer;
+    osmscout::FileScanner scanner;
+
+    std::vector<std::vector<osmscout::Point>> outCoords(4);
+
+    // 16, 32 and 48 bit deltas
+    outCoords[0].emplace_back(0, osmscout::GeoCoord(51.57231, 7.46418));
+    outCoords[0].emplace_back(0, osmscout::GeoCoord(51.57233, 7.46430));
+    outCoords[0].emplace_back(0, osmscout::GeoCoord(51.57261, 7.46563));
+
+    outCoords[1].emplace_back(0, osmscout::GeoCoord(51.57231, 7.46418));
+    outCoords[1].emplace_back(0, osmscout::GeoCoord(51.58231, 7.45418));
+    outCoords[1].emplace_back(0, osmscout::GeoCoord(51.57231, 7.46418));
+
+    outCoords[2].emplace_back(0, osmscout::GeoCoord(5.0, -5.0));
+    outCoords[2].emplace_back(0, osmscout::GeoCoord(5.0, 5.0));
+    outCoords[2].emplace_back(0, osmscout::GeoCoord(-5.0, 5.0));
+
+    for (size_t i = 0; i < 20; i++) {
+        outCoords[3].emplace_back(i % 3 == 0 ? 1 : 0, osmscout::GeoCoord(51.58549 + i * 0.0001, 7.55493 - i * 0.0002));
+    }
+
+    writer.Open("test.dat");
+
+    for (const auto& coords : outCoords) {
+        writer.Write(coords, false);
+        writer.Write(coords, true);
+    }
+
+    writer.Close();
+
+    scanner.Open("test.dat", osmscout::FileScanner::Normal, true);
+
+    if (!scanner.IsMemoryMapped()) {
+        scanner.Close();
+        WARN("File cannot be memory mapped, skipping PointSequenceView test");
+        return;
+    }
+
+    for (const auto& coords : outCoords) {
+        for (int readIds = 0; readIds <= 1; readIds++) {
+            osmscout::PointSequenceView view;
+
+            scanner.Read(view, readIds == 1);
+
+            REQUIRE(view.size() == coords.size());
+            bool hasNodeWithId = readIds == 1 &&
+                                 std::any_of(coords.begin(), coords.end(), [](const osmscout::Point& point) {
+                                     return point.IsRelevant();
+                                 });
+
+            REQUIRE(view.HasNodeWithId() == hasNodeWithId);
+
+            size_t index = 0;
+            for (const auto& coord : view) {
+                REQUIRE(coord.GetDisplayText() == coords[index].GetCoord().GetDisplayText());
+                index++;
+            }
+
+            REQUIRE(index == coords.size());
+        }
+    }
+
+    scanner.Close();
+}
+
+TEST_CASE("FileScannerPrefetch")
+{
+    osmscout::FileWriter  writer;
+    osmscout::FileScanner scanner;
+
+    writer.Open("test.dat");
+
+    for (uint32_t i = 0; i < 1000; i++) {
+        writer.Write(i);
+    }
+
+    writer.Close();
+
+    scanner.Open("test.dat", osmscout::FileScanner::LowMemRandom, false);
+
+    uint32_t value;
+
+    // Range in the middle of the file
+    if (scanner.Prefetch(400, 40) == 0) {
+        scanner.Close();
+        WARN("Prefetching is not supported, skipping FileScannerPrefetch test");
+        return;
+    }
+
+    REQUIRE(scanner.IsPrefetched());
+    REQUIRE(!scanner.IsMemoryMapped());
+    REQUIRE(scanner.GetPos() == 400);
+
+    for (uint32_t i = 100; i < 110; i++) {
+        scanner.Read(value);
+        REQUIRE(value == i);
+    }
+
+    // Reading beyond the range fails, the next prefetch recovers
+    REQUIRE_THROWS_AS(scanner.Read(value), osmscout::IOException);
+    REQUIRE(scanner.HasError());
+
+    // Range is clamped at the end of the file
+    REQUIRE(scanner.Prefetch(3960, 100) == 40);
+    REQUIRE(!scanner.HasError());
+
+    scanner.SetPos(3996);
+    scanner.Read(value);
+    REQUIRE(value == 999);
+
+    // Setting the position outside of the range continues on the file
+    scanner.SetPos(8);
+    REQUIRE(!scanner.IsPrefetched());
+    scanner.Read(value);
+    REQUIRE(value == 2);
+
+    scanner.Prefetch(40, 40);
+    scanner.Read(value);
+    REQUIRE(value == 10);
+
+    // After clearing the range, reading continues at the current position
+    scanner.ClearPrefetch();
+    REQUIRE(!scanner.IsPrefetched());
+    REQUIRE(scanner.GetPos() == 44);
+    scanner.Read(value);
+    REQUIRE(value == 11);
+
+    scanner.Close();
+}
+
+TEST_CASE("FileScannerPrefetchSignedNumberAtRangeEnd")
+{
+    osmscout::FileWriter  writer;
+    osmscout::FileScanner scanner;
+
+    writer.Open("test.dat");
+    writer.WriteNumber(int32_t(-1000000));
+    osmscout::FileOffset secondOffset=writer.GetPos();
+    writer.WriteNumber(int64_t(-1000000000000));
+    writer.WriteNumber(int16_t(-10000));
+    writer.Close();
+
+    scanner.Open("test.dat", osmscout::FileScanner::LowMemRandom, false);
+
+    int32_t value32;
+    int64_t value64;
+
+    // Range ends in the middle of the second number
+    if (scanner.Prefetch(0, secondOffset+2) == 0) {
+        scanner.Close();
+        WARN("Prefetching is not supported, skipping FileScannerPrefetchSignedNumberAtRangeEnd test");
+        return;
+    }
+
+    scanner.ReadNumber(value32);
+    REQUIRE(value32 == -1000000);
+    REQUIRE(scanner.GetPos() == secondOffset);
+
+    REQUIRE_THROWS_AS(scanner.ReadNumber(value64), osmscout::IOException);
+    REQUIRE(scanner.HasError());
+
+    // A larger range recovers
+    scanner.Prefetch(secondOffset, 100);
+
+    int16_t value16;
+
+    scanner.ReadNumber(value64);
+    REQUIRE(value64 == -1000000000000);
+    scanner.ReadNumber(value16);
+    REQUIRE(value16 == -10000);
+
+    scanner.Close();
+}
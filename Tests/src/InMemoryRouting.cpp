@@ -0,0 +1,277 @@
+/*
+  InMemoryRouting - a test program for libosmscout
+  Copyright (C) 2026  Tim Teulings
+
+  This program is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 2 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+*/
+
+#include <cmath>
+#include <iostream>
+
+#include <osmscout/Database.h>
+
+#include <osmscout/routing/MultiDBRoutingService.h>
+#include <osmscout/routing/RouteNodeDataFile.h>
+#include <osmscout/routing/SimpleRoutingService.h>
+
+#include <osmscout/util/Geometry.h>
+
+#include <RoutingTest.h>
+
+template<class Router>
+double GetRouteLength(Router& router,
+                      const osmscout::RoutingResult& result)
+{
+  auto   pointsResult=router.TransformRouteDataToPoints(result.GetRoute());
+  double length=0.0;
+
+  if (!pointsResult.Success()) {
+    return -1.0;
+  }
+
+  const auto& points=pointsResult.GetPoints()->points;
+
+  for (size_t i=1; i<points.size(); i++) {
+    length+=osmscout::GetSphericalDistance(points[i-1].GetCoord(),
+                                           points[i].GetCoord()).AsMeter();
+  }
+
+  return length;
+}
+
+/**
+ * Check, that the in memory graph holds the same route nodes as the data file
+ * and that the path targets of the graph are the nodes referenced by the paths
+ */
+bool CheckGraph(const osmscout::DatabaseRef& database)
+{
+  osmscout::RouteNodeDataFile pagedFile(osmscout::RoutingService::GetDataFilename(osmscout::RoutingService::DEFAULT_FILENAME_BASE),
+                                        1000);
+  osmscout::RouteNodeDataFile graphFile(osmscout::RoutingService::GetDataFilename(osmscout::RoutingService::DEFAULT_FILENAME_BASE),
+                                        1000);
+
+  if (!pagedFile.Open(database->GetTypeConfig(),database->GetPath(),false) ||
+      !graphFile.Open(database->GetTypeConfig(),database->GetPath(),false) ||
+      !graphFile.LoadGraph()) {
+    std::cerr << "Cannot load routing graph" << std::endl;
+    return false;
+  }
+
+  const osmscout::RoutingGraph* graph=graphFile.GetGraph();
+
+  std::cout << "Graph: " << graph->GetNodeCount() << " nodes, " << graph->GetPathCount() << " paths, " << graph->GetMemoryUsage() << " bytes" << std::endl;
+
+  for (uint32_t n=0; n<graph->GetNodeCount(); n++) {
+    osmscout::RouteNodeRef pagedNode;
+    osmscout::RouteNodeRef graphNode;
+
+    if (graph->GetNodeIndex(graph->GetNodeId(n))!=n ||
+        !pagedFile.Get(graph->GetNodeId(n),pagedNode) ||
+        !graphFile.Get(graph->GetNodeId(n),graphNode)) {
+      std::cerr << "Cannot resolve route node " << graph->GetNodeId(n) << std::endl;
+      return false;
+    }
+
+    if (graphNode->GetId()!=pagedNode->GetId() ||
+        graphNode->GetCoord()!=pagedNode->GetCoord() ||
+        graphNode->objects.size()!=pagedNode->objects.size() ||
+        graphNode->paths.size()!=pagedNode->paths.size() ||
+        graphNode->excludes.size()!=pagedNode->excludes.size()) {
+      std::cerr << "Route node " << graph->GetNodeId(n) << " differs" << std::endl;
+      return false;
+    }
+
+    for (uint32_t p=graph->GetPathBegin(n); p<graph->GetPathEnd(n); p++) {
+      const osmscout::RouteNode::Path& path=pagedNode->paths[p-graph->GetPathBegin(n)];
+
+      if (graph->GetNodeId(graph->GetPathTarget(p))!=path.id ||
+          graph->GetPathFlags(p)!=path.flags ||
+          graph->GetPathObject(p,n)!=pagedNode->objects[path.objectIndex].object) {
+        std::cerr << "Path of route node " << graph->GetNodeId(n) << " differs" << std::endl;
+        return false;
+      }
+    }
+  }
+
+  if (graph->GetNodeIndex(0)!=osmscout::RoutingGraph::noNode) {
+    std::cerr << "Unknown id resolved" << std::endl;
+    return false;
+  }
+
+  pagedFile.Close();
+  graphFile.Close();
+
+  return true;
+}
+
+/**
+ * Check, that a router with the complete graph in memory calculates the
+ * same routes as the router using the page cache
+ */
+template<class Router, class ... Profile>
+bool CheckRoutes(const std::string& name,
+                 Router& pagedRouter,
+                 Router& inMemoryRouter,
+                 const std::vector<osmscout::RoutePosition>& positions,
+                 Profile& ... profile)
+{
+  for (size_t s=0; s<positions.size(); s++) {
+    for (size_t t=0; t<positions.size(); t++) {
+      if (s==t) {
+        continue;
+      }
+
+      osmscout::RoutingParameter parameter;
+      auto                       pagedResult=pagedRouter.CalculateRoute(profile...,
+                                                                        positions[s],
+                                                                        positions[t],
+                                                                        parameter);
+      auto                       inMemoryResult=inMemoryRouter.CalculateRoute(profile...,
+                                                                              positions[s],
+                                                                              positions[t],
+                                                                              parameter);
+
+      if (!pagedResult.Success() ||
+          !inMemoryResult.Success()) {
+        std::cerr << name << ": Routing failed for " << s << " => " << t << std::endl;
+        return false;
+      }
+
+      double pagedLength=GetRouteLength(pagedRouter,pagedResult);
+      double inMemoryLength=GetRouteLength(inMemoryRouter,inMemoryResult);
+
+      std::cout << name << " " << s << " => " << t << ": " << pagedResult.GetRoute().Entries().size() << " entries, " << pagedLength << " m / " << inMemoryResult.GetRoute().Entries().size() << " entries, " << inMemoryLength << " m" << std::endl;
+
+      if (pagedResult.GetRoute().Entries().size()!=inMemoryResult.GetRoute().Entries().size() ||
+          pagedLength!=inMemoryLength) {
+        std::cerr << name << ": In memory graph results in a different route" << std::endl;
+        return false;
+      }
+    }
+  }
+
+  return true;
+}
+
+int main(int argc, char* argv[])
+{
+  RoutingTestArguments args;
+  int                  exitCode;
+
+  if (!ParseRoutingTestArguments("InMemoryRouting",argc,argv,args,exitCode)) {
+    return exitCode;
+  }
+
+  osmscout::DatabaseParameter dbParameter;
+  osmscout::DatabaseRef       database=std::make_shared<osmscout::Database>(dbParameter);
+
+  if (!database->Open(args.databaseDirectory)) {
+    std::cerr << "Cannot open database " << args.databaseDirectory << std::endl;
+    return 1;
+  }
+
+  if (!CheckGraph(database)) {
+    return 1;
+  }
+
+  osmscout::RouterParameter routerParameter;
+  osmscout::RouterParameter inMemoryRouterParameter;
+
+  inMemoryRouterParameter.SetInMemoryGraph(true);
+
+  osmscout::SimpleRoutingService router(database,
+                                        routerParameter,
+                                        osmscout::RoutingService::DEFAULT_FILENAME_BASE);
+  osmscout::SimpleRoutingService inMemoryRouter(database,
+                                                inMemoryRouterParameter,
+                                                osmscout::RoutingService::DEFAULT_FILENAME_BASE);
+
+  if (!router.Open() ||
+      !inMemoryRouter.Open()) {
+    std::cerr << "Cannot open router" << std::endl;
+    return 1;
+  }
+
+  std::map<std::string,double>        speedMap;
+  osmscout::FastestPathRoutingProfile profile(database->GetTypeConfig());
+
+  GetCarSpeedTable(speedMap);
+  profile.ParametrizeForCar(*database->GetTypeConfig(),speedMap,160.0);
+
+  std::vector<osmscout::GeoCoord> coords{args.start,
+                                         args.target,
+                                         osmscout::GeoCoord((args.start.GetLat()+args.target.GetLat())/2,
+                                                            (args.start.GetLon()+args.target.GetLon())/2)};
+  std::vector<osmscout::RoutePosition> positions;
+
+  for (const auto& coord : coords) {
+    auto position=router.GetClosestRoutableNode(coord,profile,osmscout::Kilometers(1));
+
+    if (!position.IsValid()) {
+      std::cerr << "Cannot find routable node for " << coord.GetDisplayText() << std::endl;
+      return 1;
+    }
+
+    positions.push_back(position.GetRoutePosition());
+  }
+
+  if (!CheckRoutes("Car",router,inMemoryRouter,positions,profile)) {
+    return 1;
+  }
+
+  router.Close();
+  inMemoryRouter.Close();
+
+  osmscout::MultiDBRoutingService multiDBRouter(routerParameter,{database});
+  osmscout::MultiDBRoutingService inMemoryMultiDBRouter(inMemoryRouterParameter,{database});
+
+  osmscout::MultiDBRoutingService::RoutingProfileBuilder profileBuilder=
+      [&speedMap](const osmscout::DatabaseRef& database) {
+        auto profile=std::make_shared<osmscout::FastestPathRoutingProfile>(database->GetTypeConfig());
+
+        profile->ParametrizeForCar(*(database->GetTypeConfig()),speedMap,160.0);
+
+        return profile;
+      };
+
+  if (!multiDBRouter.Open(profileBuilder) ||
+      !inMemoryMultiDBRouter.Open(profileBuilder)) {
+    std::cerr << "Cannot open multi database router" << std::endl;
+    return 1;
+  }
+
+  positions.clear();
+
+  for (const auto& coord : coords) {
+    auto position=multiDBRouter.GetClosestRoutableNode(coord);
+
+    if (!position.IsValid()) {
+      std::cerr << "Cannot find routable node for " << coord.GetDisplayText() << std::endl;
+      return 1;
+    }
+
+    positions.push_back(position.GetRoutePosition());
+  }
+
+  if (!CheckRoutes("Multi database",multiDBRouter,inMemoryMultiDBRouter,positions)) {
+    return 1;
+  }
+
+  multiDBRouter.Close();
+  inMemoryMultiDBRouter.Close();
+  database->Close();
+
+  return 0;
+}
@@ -0,0 +1,234 @@
+/*
+  Isochrone - a test program for libosmscout
+  Copyright (C) 2026  Tim Teulings
+
+  This program is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 2 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+*/
+
+#include <iostream>
+
+#include <osmscout/Database.h>
+
+#include <osmscout/routing/MultiDBRoutingService.h>
+#include <osmscout/routing/SimpleRoutingService.h>
+
+#include <osmscout/util/Geometry.h>
+
+#include <RoutingTest.h>
+
+bool IsInArea(const osmscout::GeoCoord& coord,
+              const std::vector<std::vector<osmscout::GeoCoord>>& rings)
+{
+  bool inside=false;
+
+  // Holes are rings inside outer rings
+  for (const auto& ring : rings) {
+    if (osmscout::IsCoordInArea(coord,ring)) {
+      inside=!inside;
+    }
+  }
+
+  return inside;
+}
+
+/**
+ * Check, that the nodes of the isochrone are ordered by costs, stay within
+ * the cost limit, match the costs of the routing matrix and are covered by
+ * the outline of their bands
+ */
+template<class Router, class ... Profile>
+bool CheckIsochrone(const std::string& name,
+                    Router& router,
+                    const osmscout::RoutePosition& start,
+                    const osmscout::RoutePosition& target,
+                    Profile& ... profile)
+{
+  osmscout::RoutingParameter parameter;
+
+  auto matrix=router.CalculateMatrix(profile...,
+                                     {start},
+                                     {target},
+                                     parameter);
+
+  if (!matrix.Success() ||
+      !matrix.GetEntry(0,0).valid) {
+    std::cerr << name << ": Cannot calculate costs to target" << std::endl;
+    return false;
+  }
+
+  double              targetCost=matrix.GetEntry(0,0).cost;
+  std::vector<double> costLimits{targetCost/2,targetCost*1.5};
+  osmscout::Distance  cellSize=osmscout::Meters(100);
+
+  auto isochrone=router.CalculateIsochrone(profile...,
+                                           start,
+                                           costLimits,
+                                           cellSize,
+                                           parameter);
+
+  if (!isochrone.Success() ||
+      isochrone.GetBands().size()!=costLimits.size() ||
+      isochrone.GetNodes().empty()) {
+    std::cerr << name << ": Isochrone failed" << std::endl;
+    return false;
+  }
+
+  const auto& nodes=isochrone.GetNodes();
+
+  std::cout << name << ": " << nodes.size() << " nodes reached within " << costLimits.back() << std::endl;
+
+  for (size_t i=0; i<nodes.size(); i++) {
+    const osmscout::IsochroneNode& node=nodes[i];
+
+    if (node.cost>costLimits.back() ||
+        (i>0 && node.cost<nodes[i-1].cost)) {
+      std::cerr << name << ": Unexpected costs " << node.cost << " of node " << i << std::endl;
+      return false;
+    }
+
+    if (node.previous!=osmscout::IsochroneNode::NoPrevious &&
+        (node.previous>=i ||
+         nodes[node.previous].cost>node.cost)) {
+      std::cerr << name << ": Unexpected previous node of node " << i << std::endl;
+      return false;
+    }
+  }
+
+  size_t previousCount=0;
+
+  for (const auto& band : isochrone.GetBands()) {
+    size_t count=0;
+
+    for (const auto& node : nodes) {
+      if (node.cost>band.costLimit) {
+        continue;
+      }
+
+      count++;
+
+      if (!IsInArea(node.coord,band.rings)) {
+        std::cerr << name << ": Node " << node.id.id << " is outside of band " << band.costLimit << std::endl;
+        return false;
+      }
+    }
+
+    std::cout << name << ": Band " << band.costLimit << ": " << count << " nodes, " << band.rings.size() << " rings" << std::endl;
+
+    // The target is only reachable within the outer band
+    if (band.rings.empty() ||
+        count<=previousCount) {
+      std::cerr << name << ": Unexpected band " << band.costLimit << std::endl;
+      return false;
+    }
+
+    previousCount=count;
+  }
+
+  return true;
+}
+
+int main(int argc, char* argv[])
+{
+  RoutingTestArguments args;
+  int                  exitCode;
+
+  if (!ParseRoutingTestArguments("Isochrone",argc,argv,args,exitCode)) {
+    return exitCode;
+  }
+
+  osmscout::DatabaseParameter dbParameter;
+  osmscout::DatabaseRef       database=std::make_shared<osmscout::Database>(dbParameter);
+
+  if (!database->Open(args.databaseDirectory)) {
+    std::cerr << "Cannot open database " << args.databaseDirectory << std::endl;
+    return 1;
+  }
+
+  osmscout::RouterParameter routerParameter;
+
+  osmscout::SimpleRoutingService router(database,
+                                        routerParameter,
+                                        osmscout::RoutingService::DEFAULT_FILENAME_BASE);
+
+  if (!router.Open()) {
+    std::cerr << "Cannot open router" << std::endl;
+    return 1;
+  }
+
+  std::map<std::string,double>        speedMap;
+  osmscout::FastestPathRoutingProfile profile(database->GetTypeConfig());
+
+  GetCarSpeedTable(speedMap);
+  profile.ParametrizeForCar(*database->GetTypeConfig(),speedMap,160.0);
+
+  std::vector<osmscout::GeoCoord> coords{args.start,
+                                         args.target};
+  std::vector<osmscout::RoutePosition> positions;
+
+  for (const auto& coord : coords) {
+    auto position=router.GetClosestRoutableNode(coord,profile,osmscout::Kilometers(1));
+
+    if (!position.IsValid()) {
+      std::cerr << "Cannot find routable node for " << coord.GetDisplayText() << std::endl;
+      return 1;
+    }
+
+    positions.push_back(position.GetRoutePosition());
+  }
+
+  if (!CheckIsochrone("Car",router,positions[0],positions[1],profile)) {
+    return 1;
+  }
+
+  router.Close();
+
+  osmscout::MultiDBRoutingService multiDBRouter(routerParameter,{database});
+
+  osmscout::MultiDBRoutingService::RoutingProfileBuilder profileBuilder=
+      [&speedMap](const osmscout::DatabaseRef& database) {
+        auto profile=std::make_shared<osmscout::FastestPathRoutingProfile>(database->GetTypeConfig());
+
+        profile->ParametrizeForCar(*(database->GetTypeConfig()),speedMap,160.0);
+
+        return profile;
+      };
+
+  if (!multiDBRouter.Open(profileBuilder)) {
+    std::cerr << "Cannot open multi database router" << std::endl;
+    return 1;
+  }
+
+  positions.clear();
+
+  for (const auto& coord : coords) {
+    auto position=multiDBRouter.GetClosestRoutableNode(coord);
+
+    if (!position.IsValid()) {
+      std::cerr << "Cannot find routable node for " << coord.GetDisplayText() << std::endl;
+      return 1;
+    }
+
+    positions.push_back(position.GetRoutePosition());
+  }
+
+  if (!CheckIsochrone("Multi database",multiDBRouter,positions[0],positions[1])) {
+    return 1;
+  }
+
+  multiDBRouter.Close();
+  database->Close();
+
+  return 0;
+}
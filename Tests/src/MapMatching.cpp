@@ -0,0 +1,324 @@
+/*
+  MapMatching - a test program for libosmscout
+  Copyright (C) 2026  Tim Teulings
+
+  This program is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 2 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+*/
+
+#include <cmath>
+#include <cstdio>
+#include <iostream>
+#include <set>
+
+#include <osmscout/Database.h>
+
+#include <osmscout/gpx/MapMatching.h>
+
+#include <osmscout/routing/RouteSnapIndex.h>
+#include <osmscout/routing/SimpleRoutingService.h>
+
+#include <osmscout/util/Geometry.h>
+#include <osmscout/util/StopClock.h>
+
+#include <RoutingTest.h>
+
+std::set<osmscout::FileOffset> GetWays(const osmscout::RouteData& route)
+{
+  std::set<osmscout::FileOffset> ways;
+
+  for (const auto& entry : route.Entries()) {
+    if (entry.GetPathObject().GetType()==osmscout::refWay) {
+      ways.insert(entry.GetPathObject().GetFileOffset());
+    }
+  }
+
+  return ways;
+}
+
+/**
+ * Sample a point every 25m along the route and move it by up to 6m in a
+ * deterministic pattern, to simulate the noise of a GPS receiver
+ */
+osmscout::gpx::Track GetNoisyTrack(const std::vector<osmscout::Point>& points)
+{
+  osmscout::gpx::Track        track;
+  osmscout::gpx::TrackSegment segment;
+  const double                step=25.0;
+  double                      remaining=0.0;
+  size_t                      count=0;
+
+  for (auto point=points.begin(); point!=points.end(); ++point) {
+    auto next=std::next(point);
+
+    if (next==points.end()) {
+      break;
+    }
+
+    double length=osmscout::GetSphericalDistance(point->GetCoord(),next->GetCoord()).AsMeter();
+
+    while (remaining<=length) {
+      double fraction=length>0.0 ? remaining/length : 0.0;
+      double lat=point->GetLat()+(next->GetLat()-point->GetLat())*fraction;
+      double lon=point->GetLon()+(next->GetLon()-point->GetLon())*fraction;
+      double latOffset=((count*7)%5-2.0)*3.0;
+      double lonOffset=((count*3)%5-2.0)*3.0;
+
+      segment.points.emplace_back(osmscout::GeoCoord(lat+latOffset/111320.0,
+                                                     lon+lonOffset/(111320.0*std::cos(lat*M_PI/180.0))));
+      count++;
+
+      // Split the track into two segments
+      if (count==50) {
+        track.segments.push_back(segment);
+        segment.points.clear();
+      }
+
+      remaining+=step;
+    }
+
+    remaining-=length;
+  }
+
+  track.segments.push_back(segment);
+
+  return track;
+}
+
+bool IsSameResult(const osmscout::MapMatchResult& a,
+                  const osmscout::MapMatchResult& b)
+{
+  if (a.Success()!=b.Success() ||
+      a.GetPoints().size()!=b.GetPoints().size() ||
+      a.GetRoutes().size()!=b.GetRoutes().size()) {
+    return false;
+  }
+
+  for (size_t i=0; i<a.GetPoints().size(); i++) {
+    const osmscout::MatchedPoint& pointA=a.GetPoints()[i];
+    const osmscout::MatchedPoint& pointB=b.GetPoints()[i];
+
+    if (pointA.matched!=pointB.matched ||
+        pointA.route!=pointB.route ||
+        pointA.position.GetObjectFileRef()!=pointB.position.GetObjectFileRef() ||
+        pointA.position.GetNodeIndex()!=pointB.position.GetNodeIndex()) {
+      return false;
+    }
+  }
+
+  for (size_t i=0; i<a.GetRoutes().size(); i++) {
+    if (a.GetRoutes()[i].Entries().size()!=b.GetRoutes()[i].Entries().size()) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+int main(int argc, char* argv[])
+{
+  RoutingTestArguments args;
+  int                  exitCode;
+
+  if (!ParseRoutingTestArguments("MapMatching",argc,argv,args,exitCode)) {
+    return exitCode;
+  }
+
+  osmscout::DatabaseParameter dbParameter;
+  osmscout::DatabaseRef       database=std::make_shared<osmscout::Database>(dbParameter);
+
+  if (!database->Open(args.databaseDirectory)) {
+    std::cerr << "Cannot open database " << args.databaseDirectory << std::endl;
+    return 1;
+  }
+
+  osmscout::ConsoleProgress progress;
+  std::string               filename="MapMatching_snap.dat";
+
+  if (!osmscout::RouteSnapIndex::Build(progress,
+                                       *database->GetTypeConfig(),
+                                       args.databaseDirectory,
+                                       osmscout::vehicleCar,
+                                       filename)) {
+    std::cerr << "Cannot build snap index" << std::endl;
+    return 1;
+  }
+
+  // The file must exist while matching, because the index opens further
+  // file scanners for concurrent queries
+  auto snapIndex=std::make_shared<osmscout::RouteSnapIndex>();
+
+  if (!snapIndex->Open(filename,true)) {
+    std::cerr << "Cannot open snap index" << std::endl;
+    return 1;
+  }
+
+  osmscout::RouterParameter      routerParameter;
+  osmscout::SimpleRoutingService router(database,
+                                        routerParameter,
+                                        osmscout::RoutingService::DEFAULT_FILENAME_BASE);
+
+  if (!router.Open()) {
+    std::cerr << "Cannot open router" << std::endl;
+    return 1;
+  }
+
+  router.SetSnapIndex(snapIndex);
+
+  std::map<std::string,double>        speedMap;
+  osmscout::FastestPathRoutingProfile profile(database->GetTypeConfig());
+
+  GetCarSpeedTable(speedMap);
+  profile.ParametrizeForCar(*database->GetTypeConfig(),speedMap,160.0);
+
+  osmscout::RoutePositionResult start=router.GetClosestRoutableNode(args.start,profile,osmscout::Kilometers(1));
+  osmscout::RoutePositionResult target=router.GetClosestRoutableNode(args.target,profile,osmscout::Kilometers(1));
+
+  if (!start.IsValid() ||
+      !target.IsValid()) {
+    std::cerr << "Cannot find start or target" << std::endl;
+    return 1;
+  }
+
+  osmscout::RoutingParameter parameter;
+  osmscout::RoutingResult    route=router.CalculateRoute(profile,
+                                                         start.GetRoutePosition(),
+                                                         target.GetRoutePosition(),
+                                                         parameter);
+
+  if (!route.Success()) {
+    std::cerr << "Cannot calculate route" << std::endl;
+    return 1;
+  }
+
+  osmscout::RoutePointsResult routePoints=router.TransformRouteDataToPoints(route.GetRoute());
+
+  if (!routePoints.Success()) {
+    std::cerr << "Cannot transform route to points" << std::endl;
+    return 1;
+  }
+
+  osmscout::gpx::Track        track=GetNoisyTrack(routePoints.GetPoints()->points);
+  osmscout::MapMatchParameter matchParameter;
+  osmscout::StopClock         clock;
+
+  osmscout::MapMatchResult matchResult=osmscout::gpx::MatchTrack(router,
+                                                                 profile,
+                                                                 track,
+                                                                 matchParameter,
+                                                                 parameter);
+
+  clock.Stop();
+
+  if (!matchResult.Success() ||
+      matchResult.GetPoints().size()!=track.GetPointCount() ||
+      matchResult.GetRoutes().empty()) {
+    std::cerr << "Cannot match track" << std::endl;
+    return 1;
+  }
+
+  std::set<osmscout::FileOffset> routeWays=GetWays(route.GetRoute());
+  std::set<osmscout::FileOffset> matchedWays;
+  size_t                         matchedCount=0;
+  size_t                         onRouteCount=0;
+
+  for (const auto& matchedRoute : matchResult.GetRoutes()) {
+    std::set<osmscout::FileOffset> ways=GetWays(matchedRoute);
+
+    matchedWays.insert(ways.begin(),ways.end());
+  }
+
+  for (const auto& point : matchResult.GetPoints()) {
+    if (point.matched) {
+      matchedCount++;
+
+      if (routeWays.find(point.position.GetObjectFileRef().GetFileOffset())!=routeWays.end()) {
+        onRouteCount++;
+      }
+    }
+  }
+
+  size_t coveredCount=0;
+
+  for (const auto& way : routeWays) {
+    if (matchedWays.find(way)!=matchedWays.end()) {
+      coveredCount++;
+    }
+  }
+
+  std::cout << "Track: " << track.GetPointCount() << " points, " << matchedCount << " matched, "
+            << onRouteCount << " on route, " << coveredCount << "/" << routeWays.size() << " ways covered, "
+            << matchResult.GetRoutes().size() << " route(s), " << clock.ResultString() << std::endl;
+
+  if (matchedCount!=track.GetPointCount() ||
+      onRouteCount<matchedCount*9/10 ||
+      coveredCount<routeWays.size()*9/10) {
+    std::cerr << "Matched route differs from the original route" << std::endl;
+    return 1;
+  }
+
+  // Batch matching in parallel returns the same results
+  std::vector<osmscout::gpx::Track> tracks{track,track,track};
+
+  parameter.SetThreadCount(2);
+
+  std::vector<osmscout::MapMatchResult> batchResults=osmscout::gpx::MatchTracks(router,
+                                                                                profile,
+                                                                                tracks,
+                                                                                matchParameter,
+                                                                                parameter);
+
+  if (batchResults.size()!=tracks.size()) {
+    std::cerr << "Batch matching returned " << batchResults.size() << " results" << std::endl;
+    return 1;
+  }
+
+  for (const auto& batchResult : batchResults) {
+    if (!IsSameResult(matchResult,batchResult)) {
+      std::cerr << "Batch matching result differs" << std::endl;
+      return 1;
+    }
+  }
+
+  // Nothing is matched far away from the database
+  osmscout::gpx::Track        farTrack;
+  osmscout::gpx::TrackSegment farSegment;
+
+  farSegment.points.emplace_back(osmscout::GeoCoord(0.0,0.0));
+  farSegment.points.emplace_back(osmscout::GeoCoord(0.0,0.001));
+  farTrack.segments.push_back(farSegment);
+
+  osmscout::MapMatchResult farResult=osmscout::gpx::MatchTrack(router,
+                                                               profile,
+                                                               farTrack,
+                                                               matchParameter,
+                                                               parameter);
+
+  if (!farResult.Success() ||
+      farResult.GetPoints().size()!=2 ||
+      farResult.GetPoints()[0].matched ||
+      farResult.GetPoints()[1].matched ||
+      !farResult.GetRoutes().empty()) {
+    std::cerr << "Unexpected match far away from the database" << std::endl;
+    return 1;
+  }
+
+  router.Close();
+  snapIndex->Close();
+  database->Close();
+
+  std::remove(filename.c_str());
+
+  return 0;
+}
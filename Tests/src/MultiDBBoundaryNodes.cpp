@@ -0,0 +1,194 @@
+/*
+  MultiDBBoundaryNodes - a test program for libosmscout
+  Copyright (C) 2026  Tim Teulings
+
+  This program is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 2 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+*/
+
+#include <cmath>
+#include <iostream>
+#include <vector>
+
+#include <osmscout/Database.h>
+#include <osmscout/routing/MultiDBRoutingService.h>
+
+#include <osmscout/util/Geometry.h>
+
+#include <RoutingTest.h>
+
+/**
+ * Length of the route in meter
+ */
+double GetRouteLength(osmscout::MultiDBRoutingService& router,
+                      const osmscout::RoutingResult& result)
+{
+  osmscout::RoutePointsResult pointsResult=router.TransformRouteDataToPoints(result.GetRoute());
+
+  if (!pointsResult.Success()) {
+    return -1.0;
+  }
+
+  const std::vector<osmscout::Point>& points=pointsResult.GetPoints()->points;
+  double                              length=0.0;
+
+  for (size_t i=1; i<points.size(); i++) {
+    length+=osmscout::GetSphericalDistance(points[i-1].GetCoord(),
+                                           points[i].GetCoord()).AsMeter();
+  }
+
+  return length;
+}
+
+/**
+ * Both databases contain the same region, so each route node of one database
+ * must be a boundary node with exactly one twin, the same node in the other
+ * database
+ */
+bool CheckTwins(const osmscout::MultiDBRoutingService& router,
+                const osmscout::RouteData& route)
+{
+  bool success=true;
+
+  for (const auto& entry : route.Entries()) {
+    if (entry.GetCurrentNodeId()==0) {
+      continue;
+    }
+
+    osmscout::DatabaseId        other=entry.GetDatabaseId()==0 ? 1 : 0;
+    std::vector<osmscout::DBId> twins=router.GetBoundaryNodeTwins(entry.GetDatabaseId(),
+                                                                  entry.GetCurrentNodeId());
+
+    if (twins.size()!=1 ||
+        twins.front().database!=other ||
+        twins.front().id!=entry.GetCurrentNodeId()) {
+      std::cerr << "Route node " << entry.GetCurrentNodeId() << " of database " << entry.GetDatabaseId() << " has " << twins.size() << " twins, expected its copy in database " << other << std::endl;
+      success=false;
+    }
+  }
+
+  return success;
+}
+
+int main(int argc, char* argv[])
+{
+  RoutingTestArguments args;
+  int                  exitCode;
+
+  if (!ParseRoutingTestArguments("MultiDBBoundaryNodes",argc,argv,args,exitCode)) {
+    return exitCode;
+  }
+
+  osmscout::DatabaseParameter        dbParameter;
+  std::vector<osmscout::DatabaseRef> databases;
+
+  // The same database opened twice gives two databases overlapping completely
+  for (size_t i=0; i<2; i++) {
+    osmscout::DatabaseRef database=std::make_shared<osmscout::Database>(dbParameter);
+
+    if (!database->Open(args.databaseDirectory)) {
+      std::cerr << "Cannot open database " << args.databaseDirectory << std::endl;
+      return 1;
+    }
+
+    databases.push_back(database);
+  }
+
+  osmscout::RouterParameter       routerParameter;
+  osmscout::MultiDBRoutingService router(routerParameter,databases);
+  osmscout::MultiDBRoutingService::RoutingProfileBuilder profileBuilder=
+      [](const osmscout::DatabaseRef &database) {
+        auto                         profile=std::make_shared<osmscout::FastestPathRoutingProfile>(database->GetTypeConfig());
+        std::map<std::string,double> speedMap;
+
+        GetCarSpeedTable(speedMap);
+        profile->ParametrizeForCar(*(database->GetTypeConfig()),speedMap,160.0);
+
+        return profile;
+      };
+
+  if (!router.Open(profileBuilder)) {
+    std::cerr << "Cannot open router" << std::endl;
+    return 1;
+  }
+
+  int result=0;
+
+  size_t boundaryNodeCount=router.GetBoundaryNodeCount(0);
+
+  std::cout << "Boundary nodes: " << boundaryNodeCount << std::endl;
+
+  if (boundaryNodeCount==0 ||
+      router.GetBoundaryNodeCount(1)!=boundaryNodeCount) {
+    std::cerr << "Boundary nodes of the databases differ: " << boundaryNodeCount << " <=> " << router.GetBoundaryNodeCount(1) << std::endl;
+    result=1;
+  }
+
+  osmscout::RoutePositionResult startResult=router.GetClosestRoutableNode(args.start);
+  osmscout::RoutePositionResult targetResult=router.GetClosestRoutableNode(args.target);
+
+  if (!startResult.IsValid() ||
+      !targetResult.IsValid()) {
+    std::cerr << "Cannot find route nodes near start and target" << std::endl;
+    return 1;
+  }
+
+  osmscout::RoutePosition start=startResult.GetRoutePosition();
+  osmscout::RoutePosition target=targetResult.GetRoutePosition();
+
+  // Start in the first and end in the second database, the route has to cross at a boundary node
+  osmscout::RoutePosition startInFirst(start.GetObjectFileRef(),start.GetNodeIndex(),0);
+  osmscout::RoutePosition targetInFirst(target.GetObjectFileRef(),target.GetNodeIndex(),0);
+  osmscout::RoutePosition targetInSecond(target.GetObjectFileRef(),target.GetNodeIndex(),1);
+
+  osmscout::RoutingParameter parameter;
+  osmscout::RoutingResult    singleResult=router.CalculateRoute(startInFirst,targetInFirst,parameter);
+  osmscout::RoutingResult    crossResult=router.CalculateRoute(startInFirst,targetInSecond,parameter);
+
+  if (!singleResult.Success() ||
+      !crossResult.Success()) {
+    std::cerr << "Route failed" << std::endl;
+    return 1;
+  }
+
+  // Every node is a boundary node, so the search may already switch at the start node
+  if (crossResult.GetRoute().Entries().back().GetDatabaseId()!=1) {
+    std::cerr << "Route does not cross into the second database" << std::endl;
+    result=1;
+  }
+
+  if (!CheckTwins(router,crossResult.GetRoute())) {
+    result=1;
+  }
+
+  double singleLength=GetRouteLength(router,singleResult);
+  double crossLength=GetRouteLength(router,crossResult);
+
+  std::cout << "Route length: " << singleLength << "m, crossing databases: " << crossLength << "m" << std::endl;
+
+  // Crossing between identical databases must not make the route longer or shorter
+  if (singleLength<=0.0 ||
+      std::abs(singleLength-crossLength)>singleLength*0.01) {
+    std::cerr << "Route crossing the databases differs from the route in one database" << std::endl;
+    result=1;
+  }
+
+  router.Close();
+
+  for (auto& database : databases) {
+    database->Close();
+  }
+
+  return result;
+}
@@ -30,6 +30,8 @@
 #include <osmscout/util/CmdLineParsing.h>
 #include <osmscout/util/FileScanner.h>
 
+#include <RoutingTest.h>
+
 struct Arguments
 {
   bool                     help=false;
@@ -38,29 +40,6 @@ struct Arguments
   osmscout::GeoCoord       target;
 };
 
-void GetCarSpeedTable(std::map<std::string,double>& map)
-{
-  map["highway_motorway"]=110.0;
-  map["highway_motorway_trunk"]=100.0;
-  map["highway_motorway_primary"]=70.0;
-  map["highway_motorway_link"]=60.0;
-  map["highway_motorway_junction"]=60.0;
-  map["highway_trunk"]=100.0;
-  map["highway_trunk_link"]=60.0;
-  map["highway_primary"]=70.0;
-  map["highway_primary_link"]=60.0;
-  map["highway_secondary"]=60.0;
-  map["highway_secondary_link"]=50.0;
-  map["highway_tertiary"]=55.0;
-  map["highway_tertiary_link"]=55.0;
-  map["highway_unclassified"]=50.0;
-  map["highway_road"]=50.0;
-  map["highway_residential"]=40.0;
-  map["highway_roundabout"]=40.0;
-  map["highway_living_street"]=10.0;
-  map["highway_service"]=30.0;
-}
-
 int main(int argc, char* argv[])
 {
   osmscout::CmdLineParser   argParser("MutiDBRouting",
@@ -17,22 +17,147 @@
   Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
 */
 
+#include <algorithm>
 #include <iostream>
+#include <random>
 
+#include <osmscout/PointSequenceView.h>
 #include <osmscout/Way.h>
 
+#include <osmscout/util/File.h>
 #include <osmscout/util/FileScanner.h>
+#include <osmscout/util/FileWriter.h>
+#include <osmscout/util/Geometry.h>
 #include <osmscout/util/StopClock.h>
 
 /**
   Sequentially read the ways.dat file in the current directory first using
   FileReader and then using FileScanner and compare execution time.
 
+  Before that, measure decoding of coordinate vectors for each of the
+  delta encodings (8, 16 and 24 bit deltas) using a generated file.
+
   Call this program repeately to avoid different timing because of OS file caching.
 */
 
+static bool MeasureCoordinateDecoding(const std::string& filename,
+                                      double maxDelta)
+{
+  const size_t sequenceCount=1000;
+  const size_t nodeCount=2000; // more than one segment
+  const size_t iterationCount=10;
+
+  std::mt19937                     generator(42);
+  std::uniform_real_distribution<> delta(-maxDelta,maxDelta);
+
+  try {
+    osmscout::FileWriter writer;
+
+    writer.Open(filename);
+
+    for (size_t s=0; s<sequenceCount; s++) {
+      std::vector<osmscout::Point> nodes(nodeCount);
+      double                       lat=50.0;
+      double                       lon=10.0;
+
+      for (auto& node : nodes) {
+        lat=std::max(-89.0,std::min(89.0,lat+delta(generator)));
+        lon=std::max(-179.0,std::min(179.0,lon+delta(generator)));
+
+        node.SetCoord(osmscout::GeoCoord(lat,lon));
+      }
+
+      writer.Write(nodes,false);
+    }
+
+    writer.Close();
+
+    osmscout::FileScanner scanner;
+
+    scanner.Open(filename,osmscout::FileScanner::Sequential,true);
+
+    // Check decoded coordinates against the (independent) decoding of the view
+    for (size_t s=0; s<sequenceCount; s++) {
+      std::vector<osmscout::Point>         nodes;
+      std::vector<osmscout::SegmentGeoBox> segments;
+      osmscout::GeoBox                     bbox;
+      osmscout::GeoBox                     expectedBBox;
+      osmscout::FileOffset                 offset=scanner.GetPos();
+      osmscout::PointSequenceView          view;
+
+      scanner.Read(nodes,segments,bbox,false);
+      scanner.SetPos(offset);
+      scanner.Read(view,false);
+
+      if (nodes.size()!=view.size() ||
+          segments.size()!=(nodeCount-1)/1024+1) {
+        std::cerr << "Wrong number of decoded nodes or segments" << std::endl;
+        return false;
+      }
+
+      if (!std::equal(view.begin(),view.end(),nodes.begin(),
+                      [](const osmscout::GeoCoord& coord, const osmscout::Point& point) {
+                        return coord==point.GetCoord();
+                      })) {
+        std::cerr << "Decoded coordinates differ" << std::endl;
+        return false;
+      }
+
+      osmscout::GetBoundingBox(nodes.begin(),nodes.end(),expectedBBox);
+
+      if (bbox.GetMinCoord()!=expectedBBox.GetMinCoord() ||
+          bbox.GetMaxCoord()!=expectedBBox.GetMaxCoord()) {
+        std::cerr << "Wrong bounding box " << bbox.GetDisplayText() << " instead of " << expectedBBox.GetDisplayText() << std::endl;
+        return false;
+      }
+    }
+
+    std::vector<osmscout::Point>         nodes;
+    std::vector<osmscout::SegmentGeoBox> segments;
+    osmscout::GeoBox                     bbox;
+    osmscout::StopClock                  decodeTimer;
+
+    for (size_t i=0; i<iterationCount; i++) {
+      scanner.GotoBegin();
+
+      for (size_t s=0; s<sequenceCount; s++) {
+        segments.clear();
+        scanner.Read(nodes,segments,bbox,false);
+      }
+    }
+
+    decodeTimer.Stop();
+
+    scanner.Close();
+
+    double nodesDecoded=double(sequenceCount*nodeCount*iterationCount);
+    double seconds=decodeTimer.GetMilliseconds()/1000.0;
+
+    std::cout << "Decoding " << size_t(nodesDecoded) << " coordinates with deltas up to " << maxDelta << " took " << decodeTimer;
+    if (seconds>0) {
+      std::cout << " (" << size_t(nodesDecoded/seconds) << " coordinates/s)";
+    }
+    std::cout << std::endl;
+  }
+  catch (osmscout::IOException& e) {
+    std::cerr << e.GetDescription() << std::endl;
+    osmscout::RemoveFile(filename);
+    return false;
+  }
+
+  osmscout::RemoveFile(filename);
+
+  return true;
+}
+
 int main(int /*argc*/, char* /*argv*/[])
 {
+  for (double maxDelta : {0.00001, 0.001, 0.1}) {
+    if (!MeasureCoordinateDecoding("coords.dat",maxDelta)) {
+      return 1;
+    }
+  }
+
   std::string           wayFilename="ways.dat";
 
   osmscout::StopClock   scannerTimer;
@@ -0,0 +1,301 @@
+/*
+  RoutePostprocessing - a test program for libosmscout
+  Copyright (C) 2026  Tim Teulings
+
+  This program is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 2 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+*/
+
+#include <cmath>
+#include <iostream>
+
+#include <osmscout/Database.h>
+
+#include <osmscout/routing/RoutePostprocessor.h>
+#include <osmscout/routing/SimpleRoutingService.h>
+
+#include <osmscout/util/StopClock.h>
+
+#include <RoutingTest.h>
+
+std::list<osmscout::RoutePostprocessor::PostprocessorRef> GetPostprocessors()
+{
+  return {
+    std::make_shared<osmscout::RoutePostprocessor::DistanceAndTimePostprocessor>(),
+    std::make_shared<osmscout::RoutePostprocessor::StartPostprocessor>("Start"),
+    std::make_shared<osmscout::RoutePostprocessor::TargetPostprocessor>("Target"),
+    std::make_shared<osmscout::RoutePostprocessor::WayNamePostprocessor>(),
+    std::make_shared<osmscout::RoutePostprocessor::WayTypePostprocessor>(),
+    std::make_shared<osmscout::RoutePostprocessor::CrossingWaysPostprocessor>(),
+    std::make_shared<osmscout::RoutePostprocessor::DirectionPostprocessor>(),
+    std::make_shared<osmscout::RoutePostprocessor::LanesPostprocessor>(),
+    std::make_shared<osmscout::RoutePostprocessor::SuggestedLanesPostprocessor>(),
+    std::make_shared<osmscout::RoutePostprocessor::MotorwayJunctionPostprocessor>(),
+    std::make_shared<osmscout::RoutePostprocessor::DestinationPostprocessor>(),
+    std::make_shared<osmscout::RoutePostprocessor::MaxSpeedPostprocessor>(),
+    std::make_shared<osmscout::RoutePostprocessor::InstructionPostprocessor>(),
+    std::make_shared<osmscout::RoutePostprocessor::POIsPostprocessor>()
+  };
+}
+
+bool Postprocess(osmscout::RoutePostprocessor& postprocessor,
+                 osmscout::RouteDescription& description,
+                 size_t firstNode,
+                 const osmscout::RoutingProfileRef& profile,
+                 const osmscout::DatabaseRef& database)
+{
+  std::set<std::string> motorwayTypeNames{"highway_motorway",
+                                          "highway_motorway_trunk",
+                                          "highway_trunk",
+                                          "highway_motorway_primary"};
+  std::set<std::string> motorwayLinkTypeNames{"highway_motorway_link",
+                                              "highway_trunk_link"};
+  std::set<std::string> junctionTypeNames{"highway_motorway_junction"};
+
+  return postprocessor.PostprocessRouteDescriptionSuffix(description,
+                                                         firstNode,
+                                                         {profile},
+                                                         {database},
+                                                         GetPostprocessors(),
+                                                         motorwayTypeNames,
+                                                         motorwayLinkTypeNames,
+                                                         junctionTypeNames);
+}
+
+/**
+ * Descriptions may be in a different order, they are compared as sorted list
+ * of their debug strings
+ */
+std::vector<std::string> GetDescriptions(const osmscout::RouteDescription::Node& node)
+{
+  std::vector<std::string> descriptions;
+
+  for (const auto& description : node.GetDescriptions()) {
+    descriptions.push_back(description->GetDebugString());
+  }
+
+  std::sort(descriptions.begin(),descriptions.end());
+
+  return descriptions;
+}
+
+bool IsSameNode(const osmscout::RouteDescription::Node& a,
+                const osmscout::RouteDescription::Node& b)
+{
+  return std::abs(a.GetDistance().AsMeter()-b.GetDistance().AsMeter())<0.01 &&
+         std::abs(std::chrono::duration<double>(a.GetTime()-b.GetTime()).count())<0.01 &&
+         GetDescriptions(a)==GetDescriptions(b);
+}
+
+bool CompareNodes(const std::string& name,
+                  const osmscout::RouteDescription& expected,
+                  const osmscout::RouteDescription& actual,
+                  size_t firstNode)
+{
+  if (expected.Nodes().size()!=actual.Nodes().size()) {
+    std::cerr << name << ": Node count differs: " << expected.Nodes().size() << " vs. " << actual.Nodes().size() << std::endl;
+    return false;
+  }
+
+  auto   expectedNode=expected.Nodes().begin();
+  auto   actualNode=actual.Nodes().begin();
+  size_t index=0;
+
+  while (expectedNode!=expected.Nodes().end()) {
+    if (index>=firstNode &&
+        !IsSameNode(*expectedNode,*actualNode)) {
+      std::cerr << name << ": Node " << index << " differs" << std::endl;
+      return false;
+    }
+
+    ++expectedNode;
+    ++actualNode;
+    ++index;
+  }
+
+  return true;
+}
+
+/**
+ * Descriptions in typed slots must be found by their name and every node must be
+ * found by its distance
+ */
+bool CheckLookup(const osmscout::RouteDescription& description)
+{
+  for (auto node=description.Nodes().begin(); node!=description.Nodes().end(); ++node) {
+    for (size_t i=0; i<osmscout::RouteDescription::descriptionSlotCount; i++) {
+      auto        slot=static_cast<osmscout::RouteDescription::DescriptionSlot>(i);
+      std::string name=osmscout::RouteDescription::GetDescriptionName(slot);
+
+      if (osmscout::RouteDescription::GetDescriptionSlot(name.c_str())!=slot) {
+        std::cerr << "Slot of description '" << name << "' differs" << std::endl;
+        return false;
+      }
+
+      if (node->GetDescription(slot)!=node->GetDescription(name.c_str()) ||
+          node->HasDescription(slot)!=node->HasDescription(name.c_str())) {
+        std::cerr << "Description '" << name << "' differs by slot and by name" << std::endl;
+        return false;
+      }
+    }
+
+    auto found=description.FindNodeByDistance(node->GetDistance());
+
+    if (found==description.Nodes().end() ||
+        found->GetDistance()!=node->GetDistance() ||
+        found<node) {
+      std::cerr << "Node at " << node->GetDistance().AsString() << " not found by distance" << std::endl;
+      return false;
+    }
+  }
+
+  if (description.FindNodeByDistance(osmscout::Meters(-1))!=description.Nodes().begin() ||
+      description.FindNodeByDistance(description.Nodes().back().GetDistance()+osmscout::Meters(1))!=std::prev(description.Nodes().end())) {
+    std::cerr << "Distances outside of the route not found" << std::endl;
+    return false;
+  }
+
+  return true;
+}
+
+int main(int argc, char* argv[])
+{
+  RoutingTestArguments args;
+  int                  exitCode;
+
+  if (!ParseRoutingTestArguments("RoutePostprocessing",argc,argv,args,exitCode)) {
+    return exitCode;
+  }
+
+  osmscout::DatabaseParameter dbParameter;
+  osmscout::DatabaseRef       database=std::make_shared<osmscout::Database>(dbParameter);
+
+  if (!database->Open(args.databaseDirectory)) {
+    std::cerr << "Cannot open database " << args.databaseDirectory << std::endl;
+    return 1;
+  }
+
+  osmscout::RouterParameter      routerParameter;
+  osmscout::SimpleRoutingService router(database,
+                                        routerParameter,
+                                        osmscout::RoutingService::DEFAULT_FILENAME_BASE);
+
+  if (!router.Open()) {
+    std::cerr << "Cannot open router" << std::endl;
+    return 1;
+  }
+
+  std::map<std::string,double> speedMap;
+  auto                         profile=std::make_shared<osmscout::FastestPathRoutingProfile>(database->GetTypeConfig());
+
+  GetCarSpeedTable(speedMap);
+  profile->ParametrizeForCar(*database->GetTypeConfig(),speedMap,160.0);
+
+  auto start=router.GetClosestRoutableNode(args.start,*profile,osmscout::Kilometers(1));
+  auto target=router.GetClosestRoutableNode(args.target,*profile,osmscout::Kilometers(1));
+
+  if (!start.IsValid() ||
+      !target.IsValid()) {
+    std::cerr << "Cannot find start or target" << std::endl;
+    return 1;
+  }
+
+  osmscout::RoutingParameter parameter;
+  auto                       routeResult=router.CalculateRoute(*profile,
+                                                               start.GetRoutePosition(),
+                                                               target.GetRoutePosition(),
+                                                               parameter);
+
+  if (!routeResult.Success()) {
+    std::cerr << "Cannot calculate route" << std::endl;
+    return 1;
+  }
+
+  auto serialResult=router.TransformRouteDataToRouteDescription(routeResult.GetRoute());
+  auto concurrentResult=router.TransformRouteDataToRouteDescription(routeResult.GetRoute());
+
+  if (!serialResult.Success() ||
+      !concurrentResult.Success()) {
+    std::cerr << "Cannot transform route" << std::endl;
+    return 1;
+  }
+
+  osmscout::RouteDescription raw=*serialResult.GetDescription();
+  osmscout::RouteDescription& serial=*serialResult.GetDescription();
+  osmscout::RouteDescription& concurrent=*concurrentResult.GetDescription();
+  osmscout::RoutePostprocessor postprocessor;
+  osmscout::StopClock          serialClock;
+
+  if (!Postprocess(postprocessor,serial,0,profile,database)) {
+    std::cerr << "Serial postprocessing failed" << std::endl;
+    return 1;
+  }
+
+  serialClock.Stop();
+
+  postprocessor.SetThreadCount(4);
+
+  osmscout::StopClock concurrentClock;
+
+  if (!Postprocess(postprocessor,concurrent,0,profile,database)) {
+    std::cerr << "Concurrent postprocessing failed" << std::endl;
+    return 1;
+  }
+
+  concurrentClock.Stop();
+
+  std::cout << serial.Nodes().size() << " nodes, serial " << serialClock.ResultString()
+            << ", concurrent " << concurrentClock.ResultString() << std::endl;
+
+  if (!CompareNodes("concurrent",serial,concurrent,0) ||
+      !CheckLookup(serial)) {
+    return 1;
+  }
+
+  // Replace the end of the processed route with unprocessed nodes and process them again
+  for (size_t firstNode : {serial.Nodes().size()/3,serial.Nodes().size()*2/3}) {
+    osmscout::RouteDescription suffix;
+
+    suffix.SetDatabaseMapping(serial.GetDatabaseMapping());
+
+    auto processedNode=serial.Nodes().begin();
+    auto rawNode=raw.Nodes().begin();
+
+    for (size_t i=0; i<serial.Nodes().size(); i++) {
+      suffix.Nodes().push_back(i<firstNode ? *processedNode : *rawNode);
+      ++processedNode;
+      ++rawNode;
+    }
+
+    osmscout::StopClock suffixClock;
+
+    if (!Postprocess(postprocessor,suffix,firstNode,profile,database)) {
+      std::cerr << "Suffix postprocessing failed" << std::endl;
+      return 1;
+    }
+
+    suffixClock.Stop();
+
+    std::cout << "Suffix from node " << firstNode << ": " << suffixClock.ResultString() << std::endl;
+
+    if (!CompareNodes("suffix",serial,suffix,firstNode)) {
+      return 1;
+    }
+  }
+
+  router.Close();
+  database->Close();
+
+  return 0;
+}
@@ -0,0 +1,235 @@
+/*
+  RouteSnapping - a test program for libosmscout
+  Copyright (C) 2026  Tim Teulings
+
+  This program is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 2 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+*/
+
+#include <cmath>
+#include <cstdio>
+#include <iostream>
+
+#include <osmscout/Database.h>
+
+#include <osmscout/routing/RouteSnapIndex.h>
+#include <osmscout/routing/SimpleRoutingService.h>
+
+#include <osmscout/util/StopClock.h>
+
+#include <RoutingTest.h>
+
+/**
+ * Positions are equal, if they have the same distance. At junctions
+ * multiple ways have the same distance, the way chosen may differ then.
+ */
+bool IsSamePosition(const osmscout::RoutePositionResult& a,
+                    const osmscout::RoutePositionResult& b)
+{
+  if (a.IsValid()!=b.IsValid()) {
+    return false;
+  }
+
+  if (!a.IsValid()) {
+    return true;
+  }
+
+  if (std::abs(a.GetDistance().AsMeter()-b.GetDistance().AsMeter())>=0.01) {
+    return false;
+  }
+
+  return a.GetRoutePosition().GetObjectFileRef()!=b.GetRoutePosition().GetObjectFileRef() ||
+         a.GetRoutePosition().GetNodeIndex()==b.GetRoutePosition().GetNodeIndex();
+}
+
+/**
+ * Compare the positions found by the router using the area indexes with the
+ * positions found using the snap index
+ */
+bool CheckProfile(const std::string& name,
+                  osmscout::SimpleRoutingService& router,
+                  osmscout::SimpleRoutingService& snapRouter,
+                  const osmscout::RoutingProfile& profile,
+                  const std::vector<osmscout::GeoCoord>& coords)
+{
+  std::vector<osmscout::RoutePositionResult> expected;
+  osmscout::StopClock                        areaIndexClock;
+
+  for (const auto& coord : coords) {
+    expected.push_back(router.GetClosestRoutableNode(coord,profile,osmscout::Kilometers(1)));
+  }
+
+  areaIndexClock.Stop();
+
+  std::vector<osmscout::RoutePositionResult> actual;
+  osmscout::StopClock                        snapIndexClock;
+
+  for (const auto& coord : coords) {
+    actual.push_back(snapRouter.GetClosestRoutableNode(coord,profile,osmscout::Kilometers(1)));
+  }
+
+  snapIndexClock.Stop();
+
+  std::vector<osmscout::RoutePositionResult> batched=snapRouter.GetClosestRoutableNodes(coords,profile,osmscout::Kilometers(1));
+
+  std::cout << name << ": " << coords.size() << " coordinates, area indexes " << areaIndexClock.ResultString()
+            << ", snap index " << snapIndexClock.ResultString() << std::endl;
+
+  if (batched.size()!=coords.size()) {
+    std::cerr << name << ": Batched snapping returned " << batched.size() << " results" << std::endl;
+    return false;
+  }
+
+  size_t validCount=0;
+
+  for (size_t i=0; i<coords.size(); i++) {
+    if (!IsSamePosition(expected[i],actual[i])) {
+      std::cerr << name << ": Snapping " << coords[i].GetDisplayText() << " differs: "
+                << expected[i].GetRoutePosition().GetObjectFileRef().GetName() << " " << expected[i].GetDistance().AsString()
+                << " vs. "
+                << actual[i].GetRoutePosition().GetObjectFileRef().GetName() << " " << actual[i].GetDistance().AsString() << std::endl;
+      return false;
+    }
+
+    if (!IsSamePosition(actual[i],batched[i])) {
+      std::cerr << name << ": Batched snapping of " << coords[i].GetDisplayText() << " differs" << std::endl;
+      return false;
+    }
+
+    if (actual[i].IsValid()) {
+      validCount++;
+    }
+  }
+
+  if (validCount==0) {
+    std::cerr << name << ": No coordinate could be snapped" << std::endl;
+    return false;
+  }
+
+  return true;
+}
+
+int main(int argc, char* argv[])
+{
+  RoutingTestArguments args;
+  int                  exitCode;
+
+  if (!ParseRoutingTestArguments("RouteSnapping",argc,argv,args,exitCode)) {
+    return exitCode;
+  }
+
+  osmscout::DatabaseParameter dbParameter;
+  osmscout::DatabaseRef       database=std::make_shared<osmscout::Database>(dbParameter);
+
+  if (!database->Open(args.databaseDirectory)) {
+    std::cerr << "Cannot open database " << args.databaseDirectory << std::endl;
+    return 1;
+  }
+
+  osmscout::ConsoleProgress progress;
+  std::string               filename="RouteSnapping_snap.dat";
+
+  if (!osmscout::RouteSnapIndex::Build(progress,
+                                       *database->GetTypeConfig(),
+                                       args.databaseDirectory,
+                                       osmscout::vehicleFoot|osmscout::vehicleBicycle|osmscout::vehicleCar,
+                                       filename)) {
+    std::cerr << "Cannot build snap index" << std::endl;
+    return 1;
+  }
+
+  auto snapIndex=std::make_shared<osmscout::RouteSnapIndex>();
+  bool openSuccess=snapIndex->Open(filename,true);
+
+  // The open file is not affected on posix systems
+  std::remove(filename.c_str());
+
+  if (!openSuccess ||
+      snapIndex->GetSegmentCount()==0) {
+    std::cerr << "Cannot open snap index" << std::endl;
+    return 1;
+  }
+
+  osmscout::RouterParameter      routerParameter;
+  osmscout::SimpleRoutingService router(database,
+                                        routerParameter,
+                                        osmscout::RoutingService::DEFAULT_FILENAME_BASE);
+  osmscout::SimpleRoutingService snapRouter(database,
+                                            routerParameter,
+                                            osmscout::RoutingService::DEFAULT_FILENAME_BASE);
+
+  if (!router.Open() ||
+      !snapRouter.Open()) {
+    std::cerr << "Cannot open router" << std::endl;
+    return 1;
+  }
+
+  router.SetSnapIndex(nullptr);
+  snapRouter.SetSnapIndex(snapIndex);
+
+  // A grid of coordinates around start and target
+  std::vector<osmscout::GeoCoord> coords;
+
+  for (int i=-1; i<=11; i++) {
+    for (int j=-1; j<=11; j++) {
+      coords.emplace_back(args.start.GetLat()+(args.target.GetLat()-args.start.GetLat())*i/10.0,
+                          args.start.GetLon()+(args.target.GetLon()-args.start.GetLon())*j/10.0);
+    }
+  }
+
+  std::map<std::string,double>        speedMap;
+  osmscout::FastestPathRoutingProfile carProfile(database->GetTypeConfig());
+  osmscout::FastestPathRoutingProfile footProfile(database->GetTypeConfig());
+
+  GetCarSpeedTable(speedMap);
+  carProfile.ParametrizeForCar(*database->GetTypeConfig(),speedMap,160.0);
+  footProfile.ParametrizeForFoot(*database->GetTypeConfig(),5.0);
+
+  if (!CheckProfile("car",router,snapRouter,carProfile,coords) ||
+      !CheckProfile("foot",router,snapRouter,footProfile,coords)) {
+    return 1;
+  }
+
+  // Nothing is in range far away from the database
+  osmscout::RouteSnapIndex::Match match;
+
+  if (snapIndex->GetClosest(osmscout::GeoCoord(0.0,0.0),
+                            osmscout::vehicleCar,
+                            osmscout::Kilometers(1),
+                            nullptr,
+                            match)) {
+    std::cerr << "Unexpected match far away from the database" << std::endl;
+    return 1;
+  }
+
+  auto object=snapRouter.GetClosestRoutableObject(args.start,
+                                                  osmscout::vehicleCar,
+                                                  osmscout::Kilometers(1));
+
+  if (!object.GetObject().Valid() ||
+      (!object.GetWay() && !object.GetArea()) ||
+      object.GetDistance()>osmscout::Kilometers(1)) {
+    std::cerr << "Cannot find closest routable object" << std::endl;
+    return 1;
+  }
+
+  std::cout << "Closest routable object: " << object.GetObject().GetName() << " '" << object.GetName() << "' "
+            << object.GetDistance().AsString() << std::endl;
+
+  router.Close();
+  snapRouter.Close();
+  database->Close();
+
+  return 0;
+}
@@ -0,0 +1,225 @@
+/*
+  RoutingMatrix - a test program for libosmscout
+  Copyright (C) 2026  Tim Teulings
+
+  This program is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 2 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+*/
+
+#include <cmath>
+#include <iostream>
+
+#include <osmscout/Database.h>
+
+#include <osmscout/routing/MultiDBRoutingService.h>
+#include <osmscout/routing/SimpleRoutingService.h>
+
+#include <osmscout/util/Geometry.h>
+
+#include <RoutingTest.h>
+
+template<class Router>
+double GetRouteLength(Router& router,
+                      const osmscout::RoutingResult& result)
+{
+  auto   pointsResult=router.TransformRouteDataToPoints(result.GetRoute());
+  double length=0.0;
+
+  if (!pointsResult.Success()) {
+    return -1.0;
+  }
+
+  const auto& points=pointsResult.GetPoints()->points;
+
+  for (size_t i=1; i<points.size(); i++) {
+    length+=osmscout::GetSphericalDistance(points[i-1].GetCoord(),
+                                           points[i].GetCoord()).AsMeter();
+  }
+
+  return length;
+}
+
+/**
+ * Check, that the matrix does not depend on the number of threads and that
+ * the distances match the routes calculated by CalculateRoute()
+ */
+template<class Router, class ... Profile>
+bool CheckMatrix(const std::string& name,
+                 Router& router,
+                 const std::vector<osmscout::RoutePosition>& positions,
+                 Profile& ... profile)
+{
+  osmscout::RoutingParameter singleThreadParameter;
+  osmscout::RoutingParameter parameter;
+
+  singleThreadParameter.SetThreadCount(1);
+  parameter.SetThreadCount(4);
+
+  auto singleThreadMatrix=router.CalculateMatrix(profile...,
+                                                 positions,
+                                                 positions,
+                                                 singleThreadParameter);
+  auto matrix=router.CalculateMatrix(profile...,
+                                     positions,
+                                     positions,
+                                     parameter);
+
+  if (!singleThreadMatrix.Success() ||
+      !matrix.Success() ||
+      matrix.GetSourceCount()!=positions.size() ||
+      matrix.GetTargetCount()!=positions.size()) {
+    std::cerr << name << ": Matrix failed" << std::endl;
+    return false;
+  }
+
+  for (size_t s=0; s<positions.size(); s++) {
+    for (size_t t=0; t<positions.size(); t++) {
+      const osmscout::RoutingMatrixEntry& entry=matrix.GetEntry(s,t);
+      const osmscout::RoutingMatrixEntry& singleThreadEntry=singleThreadMatrix.GetEntry(s,t);
+
+      if (entry.valid!=singleThreadEntry.valid ||
+          entry.cost!=singleThreadEntry.cost ||
+          entry.distance!=singleThreadEntry.distance) {
+        std::cerr << name << ": Matrix depends on thread count for " << s << " => " << t << std::endl;
+        return false;
+      }
+
+      if (s==t) {
+        continue;
+      }
+
+      osmscout::RoutingParameter routeParameter;
+      auto                       routeResult=router.CalculateRoute(profile...,
+                                                                   positions[s],
+                                                                   positions[t],
+                                                                   routeParameter);
+
+      if (routeResult.Success()!=entry.valid) {
+        std::cerr << name << ": Route and matrix disagree about route existence for " << s << " => " << t << std::endl;
+        return false;
+      }
+
+      if (!entry.valid) {
+        continue;
+      }
+
+      double routeLength=GetRouteLength(router,routeResult);
+
+      std::cout << name << " " << s << " => " << t << ": route length " << routeLength << " m, matrix distance " << entry.distance.AsMeter() << " m, duration " << osmscout::DurationString(entry.duration) << std::endl;
+
+      if (std::fabs(routeLength-entry.distance.AsMeter())>0.05*routeLength) {
+        std::cerr << name << ": Matrix distance differs from route length" << std::endl;
+        return false;
+      }
+    }
+  }
+
+  return true;
+}
+
+int main(int argc, char* argv[])
+{
+  RoutingTestArguments args;
+  int                  exitCode;
+
+  if (!ParseRoutingTestArguments("RoutingMatrix",argc,argv,args,exitCode)) {
+    return exitCode;
+  }
+
+  osmscout::DatabaseParameter dbParameter;
+  osmscout::DatabaseRef       database=std::make_shared<osmscout::Database>(dbParameter);
+
+  if (!database->Open(args.databaseDirectory)) {
+    std::cerr << "Cannot open database " << args.databaseDirectory << std::endl;
+    return 1;
+  }
+
+  osmscout::RouterParameter routerParameter;
+
+  osmscout::SimpleRoutingService router(database,
+                                        routerParameter,
+                                        osmscout::RoutingService::DEFAULT_FILENAME_BASE);
+
+  if (!router.Open()) {
+    std::cerr << "Cannot open router" << std::endl;
+    return 1;
+  }
+
+  std::map<std::string,double>        speedMap;
+  osmscout::FastestPathRoutingProfile profile(database->GetTypeConfig());
+
+  GetCarSpeedTable(speedMap);
+  profile.ParametrizeForCar(*database->GetTypeConfig(),speedMap,160.0);
+
+  std::vector<osmscout::GeoCoord> coords{args.start,
+                                         args.target,
+                                         osmscout::GeoCoord((args.start.GetLat()+args.target.GetLat())/2,
+                                                            (args.start.GetLon()+args.target.GetLon())/2)};
+  std::vector<osmscout::RoutePosition> positions;
+
+  for (const auto& coord : coords) {
+    auto position=router.GetClosestRoutableNode(coord,profile,osmscout::Kilometers(1));
+
+    if (!position.IsValid()) {
+      std::cerr << "Cannot find routable node for " << coord.GetDisplayText() << std::endl;
+      return 1;
+    }
+
+    positions.push_back(position.GetRoutePosition());
+  }
+
+  if (!CheckMatrix("Car",router,positions,profile)) {
+    return 1;
+  }
+
+  router.Close();
+
+  osmscout::MultiDBRoutingService multiDBRouter(routerParameter,{database});
+
+  osmscout::MultiDBRoutingService::RoutingProfileBuilder profileBuilder=
+      [&speedMap](const osmscout::DatabaseRef& database) {
+        auto profile=std::make_shared<osmscout::FastestPathRoutingProfile>(database->GetTypeConfig());
+
+        profile->ParametrizeForCar(*(database->GetTypeConfig()),speedMap,160.0);
+
+        return profile;
+      };
+
+  if (!multiDBRouter.Open(profileBuilder)) {
+    std::cerr << "Cannot open multi database router" << std::endl;
+    return 1;
+  }
+
+  positions.clear();
+
+  for (const auto& coord : coords) {
+    auto position=multiDBRouter.GetClosestRoutableNode(coord);
+
+    if (!position.IsValid()) {
+      std::cerr << "Cannot find routable node for " << coord.GetDisplayText() << std::endl;
+      return 1;
+    }
+
+    positions.push_back(position.GetRoutePosition());
+  }
+
+  if (!CheckMatrix("Multi database",multiDBRouter,positions)) {
+    return 1;
+  }
+
+  multiDBRouter.Close();
+  database->Close();
+
+  return 0;
+}
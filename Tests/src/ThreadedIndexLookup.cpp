@@ -0,0 +1,383 @@
+/*
+  ThreadedIndexLookup - a test program for libosmscout
+  Copyright (C) 2026  Tim Teulings
+
+  This program is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 2 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+*/
+
+#include <algorithm>
+#include <cstdlib>
+#include <future>
+#include <iostream>
+#include <limits>
+#include <random>
+#include <thread>
+#include <vector>
+
+#include <osmscout/Database.h>
+
+#include <osmscout/util/CmdLineParsing.h>
+#include <osmscout/util/StopClock.h>
+
+/**
+  Check the lookup rate of the area indexes (areanode.idx, areaway.idx and
+  areaarea.idx) with an increasing number of threads.
+
+  Each thread queries the same set of random bounding boxes and compares
+  the result with the result of a single threaded lookup. If the area area
+  index is preloaded, the reference result is taken from a second database
+  instance reading the index from file. The same is true if the hot indexes are
+  memory mapped with hugepage advice or are prefaulted, or if the database is
+  opened asynchronously with warmup. Since lookups do
+  not block each other, the lookup rate should grow with the number of
+  threads (as long as there are enough cores).
+*/
+
+struct LookupResult
+{
+  size_t nodeOffsetCount=0;
+  size_t wayOffsetCount=0;
+  size_t areaSpanCount=0;
+
+  bool operator==(const LookupResult& other) const
+  {
+    return nodeOffsetCount==other.nodeOffsetCount &&
+           wayOffsetCount==other.wayOffsetCount &&
+           areaSpanCount==other.areaSpanCount;
+  }
+
+  bool operator!=(const LookupResult& other) const
+  {
+    return !(*this==other);
+  }
+};
+
+bool Lookup(const osmscout::Database& database,
+            const osmscout::TypeInfoSet& nodeTypes,
+            const osmscout::TypeInfoSet& wayTypes,
+            const osmscout::TypeInfoSet& areaTypes,
+            const osmscout::GeoBox& boundingBox,
+            LookupResult& result)
+{
+  osmscout::AreaNodeIndexRef           areaNodeIndex=database.GetAreaNodeIndex();
+  osmscout::AreaWayIndexRef            areaWayIndex=database.GetAreaWayIndex();
+  osmscout::AreaAreaIndexRef           areaAreaIndex=database.GetAreaAreaIndex();
+  std::vector<osmscout::FileOffset>    nodeOffsets;
+  std::vector<osmscout::FileOffset>    wayOffsets;
+  std::vector<osmscout::DataBlockSpan> areaSpans;
+  osmscout::TypeInfoSet                loadedTypes;
+
+  if (!areaNodeIndex ||
+      !areaWayIndex ||
+      !areaAreaIndex) {
+    return false;
+  }
+
+  if (!areaNodeIndex->GetOffsets(boundingBox,
+                                 nodeTypes,
+                                 nodeOffsets,
+                                 loadedTypes)) {
+    return false;
+  }
+
+  if (!areaWayIndex->GetOffsets(boundingBox,
+                                wayTypes,
+                                wayOffsets,
+                                loadedTypes)) {
+    return false;
+  }
+
+  if (!areaAreaIndex->GetAreasInArea(*database.GetTypeConfig(),
+                                     boundingBox,
+                                     std::numeric_limits<size_t>::max(),
+                                     areaTypes,
+                                     areaSpans,
+                                     loadedTypes)) {
+    return false;
+  }
+
+  result.nodeOffsetCount=nodeOffsets.size();
+  result.wayOffsetCount=wayOffsets.size();
+  result.areaSpanCount=areaSpans.size();
+
+  return true;
+}
+
+bool RunBenchmark(const osmscout::Database& database,
+                  const osmscout::TypeInfoSet& nodeTypes,
+                  const osmscout::TypeInfoSet& wayTypes,
+                  const osmscout::TypeInfoSet& areaTypes,
+                  const std::vector<osmscout::GeoBox>& boxes,
+                  const std::vector<LookupResult>& expected,
+                  size_t threadCount,
+                  size_t iterationCount)
+{
+  std::vector<std::thread> threads(threadCount);
+  std::vector<char>        results(threadCount,1);
+  bool                     result=true;
+
+  osmscout::StopClock timer;
+
+  for (size_t t=0; t<threadCount; t++) {
+    threads[t]=std::thread([&,t]() {
+      for (size_t i=1; i<=iterationCount; i++) {
+        for (size_t b=0; b<boxes.size(); b++) {
+          LookupResult lookupResult;
+
+          if (!Lookup(database,
+                      nodeTypes,
+                      wayTypes,
+                      areaTypes,
+                      boxes[b],
+                      lookupResult) ||
+              lookupResult!=expected[b]) {
+            results[t]=0;
+            return;
+          }
+        }
+      }
+    });
+  }
+
+  for (size_t t=0; t<threadCount; t++) {
+    threads[t].join();
+
+    if (results[t]==0) {
+      result=false;
+    }
+  }
+
+  timer.Stop();
+
+  double lookups=double(boxes.size()*iterationCount*threadCount);
+  double seconds=timer.GetMilliseconds()/1000.0;
+
+  std::cout << threadCount << " thread(s): " << timer.ResultString() << ", ";
+  if (seconds>0) {
+    std::cout << size_t(lookups/seconds) << " lookups/s";
+  }
+  std::cout << (result ? "" : " ERROR") << std::endl;
+
+  return result;
+}
+
+int main(int argc, char* argv[])
+{
+  using namespace std::string_literals;
+  bool        help=false;
+  std::string databasePath;
+  size_t      maxThreadCount=std::max(1u,std::thread::hardware_concurrency());
+  size_t      iterationCount=100;
+  size_t      boxCount=100;
+  bool        preload=false;
+  bool        hugePages=false;
+  bool        prefault=false;
+  bool        interleave=false;
+  bool        warmup=false;
+
+  osmscout::CmdLineParser argParser("ThreadedIndexLookup", argc, argv);
+
+  argParser.AddOption(osmscout::CmdLineFlag([&](const bool& value) {
+                        help=value;
+                      }),
+                      std::vector<std::string>{"h","help"},
+                      "Display help",
+                      true);
+
+  argParser.AddOption(osmscout::CmdLineSizeTOption([&](const size_t& value) {
+                        maxThreadCount=std::max(size_t(1),value);
+                      }),
+                      "threads",
+                      "Maximum thread count for test, default: "s + std::to_string(maxThreadCount));
+
+  argParser.AddOption(osmscout::CmdLineSizeTOption([&](const size_t& value) {
+                        iterationCount=value;
+                      }),
+                      "iterations",
+                      "Iterations per thread, default: "s + std::to_string(iterationCount));
+
+  argParser.AddOption(osmscout::CmdLineSizeTOption([&](const size_t& value) {
+                        boxCount=std::max(size_t(1),value);
+                      }),
+                      "boxes",
+                      "Number of bounding boxes per iteration, default: "s + std::to_string(boxCount));
+
+  argParser.AddOption(osmscout::CmdLineFlag([&](const bool& value) {
+                        preload=value;
+                      }),
+                      "preload",
+                      "Preload the area area index, default: "s + (preload ? "true" : "false"));
+
+  argParser.AddOption(osmscout::CmdLineFlag([&](const bool& value) {
+                        hugePages=value;
+                      }),
+                      "hugepages",
+                      "Advise hugepages for the memory mapped indexes, default: "s + (hugePages ? "true" : "false"));
+
+  argParser.AddOption(osmscout::CmdLineFlag([&](const bool& value) {
+                        prefault=value;
+                      }),
+                      "prefault",
+                      "Prefault the memory mapped indexes on open, default: "s + (prefault ? "true" : "false"));
+
+  argParser.AddOption(osmscout::CmdLineFlag([&](const bool& value) {
+                        interleave=value;
+                      }),
+                      "interleave",
+                      "Interleave the memory mapped indexes across NUMA nodes, default: "s + (interleave ? "true" : "false"));
+
+  argParser.AddOption(osmscout::CmdLineFlag([&](const bool& value) {
+                        warmup=value;
+                      }),
+                      "warmup",
+                      "Open the database asynchronously, warming up and prefaulting all files, default: "s + (warmup ? "true" : "false"));
+
+  argParser.AddPositional(osmscout::CmdLineStringOption([&](const std::string& value) {
+                            databasePath=value;
+                          }),
+                          "database directory",
+                          "Database directory");
+
+  osmscout::CmdLineParseResult argResult=argParser.Parse();
+  if (argResult.HasError()) {
+    std::cerr << "ERROR: " << argResult.GetErrorDescription() << std::endl;
+    std::cout << argParser.GetHelp() << std::endl;
+    return 1;
+  }
+  if (help){
+    std::cout << argParser.GetHelp() << std::endl;
+    return 0;
+  }
+
+  osmscout::DatabaseParameter referenceDatabaseParameter;
+  osmscout::Database          referenceDatabase(referenceDatabaseParameter);
+  osmscout::DatabaseParameter databaseParameter;
+
+  databaseParameter.SetAreaAreaIndexPreload(preload);
+  databaseParameter.SetHugePageMMap(hugePages);
+  databaseParameter.SetPrefaultMMap(prefault);
+  databaseParameter.SetInterleaveMMap(interleave);
+
+  osmscout::Database          database(databaseParameter);
+
+  if (warmup) {
+    osmscout::DatabaseWarmupParameter warmupParameter;
+
+    warmupParameter.SetPrefault(true);
+
+    std::future<bool> opened=database.OpenAsync(databasePath,
+                                                warmupParameter);
+
+    if (!referenceDatabase.Open(databasePath) ||
+        !opened.get()) {
+      std::cerr << "Cannot open and warm up database" << std::endl;
+      return 1;
+    }
+  }
+  else if (!referenceDatabase.Open(databasePath) ||
+           !database.Open(databasePath)) {
+    std::cerr << "Cannot open database" << std::endl;
+    return 1;
+  }
+
+  if (preload &&
+      (!database.GetAreaAreaIndex() ||
+       !database.GetAreaAreaIndex()->IsPreloaded())) {
+    std::cerr << "Cannot preload area area index" << std::endl;
+    return 1;
+  }
+
+  osmscout::GeoBox databaseBox;
+
+  if (!database.GetBoundingBox(databaseBox)) {
+    std::cerr << "Cannot read bounding box of database" << std::endl;
+    return 1;
+  }
+
+  osmscout::TypeInfoSet nodeTypes;
+  osmscout::TypeInfoSet wayTypes;
+  osmscout::TypeInfoSet areaTypes;
+
+  for (const auto& type : database.GetTypeConfig()->GetTypes()) {
+    if (type->IsInternal() ||
+        type->GetIgnore()) {
+      continue;
+    }
+
+    if (type->CanBeNode()) {
+      nodeTypes.Set(type);
+    }
+
+    if (type->CanBeWay()) {
+      wayTypes.Set(type);
+    }
+
+    if (type->CanBeArea()) {
+      areaTypes.Set(type);
+    }
+  }
+
+  // Random boxes of up to a quarter of the database size
+  std::mt19937                     generator(42);
+  std::uniform_real_distribution<> position(0.0,1.0);
+  std::vector<osmscout::GeoBox>    boxes;
+  std::vector<LookupResult>        expected;
+
+  boxes.reserve(boxCount);
+  expected.reserve(boxCount);
+
+  for (size_t b=0; b<boxCount; b++) {
+    double lat=databaseBox.GetMinLat()+position(generator)*databaseBox.GetHeight();
+    double lon=databaseBox.GetMinLon()+position(generator)*databaseBox.GetWidth();
+
+    boxes.emplace_back(osmscout::GeoCoord(lat,lon),
+                       osmscout::GeoCoord(lat+position(generator)*databaseBox.GetHeight()/4,
+                                          lon+position(generator)*databaseBox.GetWidth()/4));
+
+    LookupResult lookupResult;
+
+    if (!Lookup(referenceDatabase,
+                nodeTypes,
+                wayTypes,
+                areaTypes,
+                boxes.back(),
+                lookupResult)) {
+      std::cerr << "Cannot lookup " << boxes.back().GetDisplayText() << std::endl;
+      return 1;
+    }
+
+    expected.push_back(lookupResult);
+  }
+
+  bool result=true;
+
+  for (size_t threadCount=1; threadCount<=maxThreadCount; threadCount*=2) {
+    if (!RunBenchmark(database,
+                      nodeTypes,
+                      wayTypes,
+                      areaTypes,
+                      boxes,
+                      expected,
+                      threadCount,
+                      iterationCount)) {
+      result=false;
+    }
+  }
+
+  database.Close();
+  referenceDatabase.Close();
+
+  return result ? 0 : 1;
+}
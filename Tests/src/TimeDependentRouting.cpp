@@ -0,0 +1,288 @@
+/*
+  TimeDependentRouting - a test program for libosmscout
+  Copyright (C) 2026  Tim Teulings
+
+  This program is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 2 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+*/
+
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <set>
+
+#include <osmscout/Database.h>
+
+#include <osmscout/routing/SimpleRoutingService.h>
+#include <osmscout/routing/SpeedProfiles.h>
+
+#include <RoutingTest.h>
+
+
+// Monday, 2026-10-12 00:00 UTC
+const osmscout::Timestamp monday=std::chrono::system_clock::from_time_t(1791763200);
+
+osmscout::Timestamp AtMonday(int hours,
+                             int minutes)
+{
+  return monday+std::chrono::hours(hours)+std::chrono::minutes(minutes);
+}
+
+/**
+ * Speed profile with 10% of the speed on monday from 07:00 to 10:00 and the
+ * full speed for the rest of the week
+ */
+std::vector<uint8_t> GetRushHourProfile()
+{
+  std::vector<uint8_t> factors(96*7,100);
+
+  for (size_t slot=7*4; slot<10*4; slot++) {
+    factors[slot]=10;
+  }
+
+  return factors;
+}
+
+bool CheckSpeedProfiles()
+{
+  osmscout::SpeedProfiles profiles;
+  uint32_t                rushHour=profiles.AddProfile(GetRushHourProfile());
+
+  profiles.AssignProfile(1000,rushHour);
+
+  for (osmscout::FileOffset offset=2000; offset<4000; offset+=20) {
+    profiles.AssignProfile(offset,rushHour);
+  }
+
+  std::vector<std::pair<osmscout::Timestamp,double>> expected{{AtMonday(6,0),1.0},
+                                                              {AtMonday(6,52)+std::chrono::seconds(30),0.55},
+                                                              {AtMonday(8,0),0.1},
+                                                              {AtMonday(12,0),1.0},
+                                                              {AtMonday(8,0)+std::chrono::hours(24*7),0.1}};
+
+  for (const auto& entry : expected) {
+    double factor=profiles.GetWaySpeedFactor(1000,entry.first);
+
+    if (std::abs(factor-entry.second)>0.0001) {
+      std::cerr << "Unexpected speed factor " << factor << ", expected " << entry.second << std::endl;
+      return false;
+    }
+  }
+
+  if (profiles.GetProfile(1001)!=osmscout::SpeedProfiles::noProfile ||
+      profiles.GetWaySpeedFactor(1001,AtMonday(8,0))!=1.0) {
+    std::cerr << "Way without profile has a speed factor" << std::endl;
+    return false;
+  }
+
+  std::string filename="TimeDependentRouting_speed.dat";
+
+  if (!profiles.Store(filename)) {
+    std::cerr << "Cannot store speed profiles" << std::endl;
+    return false;
+  }
+
+  osmscout::SpeedProfiles loaded;
+  bool                    loadSuccess=loaded.Load(filename);
+
+  if (!loadSuccess ||
+      loaded.GetProfileCount()!=1 ||
+      loaded.GetWayCount()!=profiles.GetWayCount() ||
+      loaded.GetProfile(3980)!=rushHour ||
+      loaded.GetWaySpeedFactor(1000,AtMonday(8,0))!=profiles.GetWaySpeedFactor(1000,AtMonday(8,0))) {
+    std::remove(filename.c_str());
+    std::cerr << "Loaded speed profiles differ" << std::endl;
+    return false;
+  }
+
+  // Factors of 0 in the file (behind slot count, utc offset and profile count) are treated as 1%
+  {
+    std::fstream      file(filename,std::ios::in | std::ios::out | std::ios::binary);
+    std::vector<char> zeros(profiles.GetSlotsPerWeek(),0);
+
+    file.seekp(sizeof(uint16_t)+sizeof(int32_t)+sizeof(uint32_t));
+    file.write(zeros.data(),zeros.size());
+  }
+
+  osmscout::SpeedProfiles zeroFactors;
+
+  loadSuccess=zeroFactors.Load(filename);
+
+  std::remove(filename.c_str());
+
+  if (!loadSuccess ||
+      std::abs(zeroFactors.GetWaySpeedFactor(1000,AtMonday(8,0))-0.01)>0.0001) {
+    std::cerr << "Speed factors of 0 are not clamped on load" << std::endl;
+    return false;
+  }
+
+  return true;
+}
+
+std::set<osmscout::FileOffset> GetWayOffsets(const osmscout::RoutingResult& result)
+{
+  std::set<osmscout::FileOffset> offsets;
+
+  for (const auto& entry : result.GetRoute().Entries()) {
+    if (entry.GetPathObject().GetType()==osmscout::refWay) {
+      offsets.insert(entry.GetPathObject().GetFileOffset());
+    }
+  }
+
+  return offsets;
+}
+
+osmscout::RoutingResult CalculateRoute(osmscout::SimpleRoutingService& router,
+                                       osmscout::RoutingProfile& profile,
+                                       const osmscout::RoutePosition& start,
+                                       const osmscout::RoutePosition& target,
+                                       const osmscout::Timestamp& departure)
+{
+  osmscout::RoutingParameter parameter;
+
+  parameter.SetDepartureTime(departure);
+
+  auto result=router.CalculateRoute(profile,
+                                    start,
+                                    target,
+                                    parameter);
+
+  if (result.Success()) {
+    std::cout << "Departure " << std::chrono::duration_cast<std::chrono::minutes>(departure-monday).count() << " min: "
+              << result.GetRoute().Entries().size() << " entries, "
+              << osmscout::DurationAsSeconds(*result.GetArrivalTime()-departure) << " s" << std::endl;
+  }
+
+  return result;
+}
+
+int main(int argc, char* argv[])
+{
+  RoutingTestArguments args;
+  int                  exitCode;
+
+  if (!ParseRoutingTestArguments("TimeDependentRouting",argc,argv,args,exitCode)) {
+    return exitCode;
+  }
+
+  if (!CheckSpeedProfiles()) {
+    return 1;
+  }
+
+  osmscout::DatabaseParameter dbParameter;
+  osmscout::DatabaseRef       database=std::make_shared<osmscout::Database>(dbParameter);
+
+  if (!database->Open(args.databaseDirectory)) {
+    std::cerr << "Cannot open database " << args.databaseDirectory << std::endl;
+    return 1;
+  }
+
+  osmscout::RouterParameter      routerParameter;
+  osmscout::SimpleRoutingService router(database,
+                                        routerParameter,
+                                        osmscout::RoutingService::DEFAULT_FILENAME_BASE);
+
+  if (!router.Open()) {
+    std::cerr << "Cannot open router" << std::endl;
+    return 1;
+  }
+
+  std::map<std::string,double>        speedMap;
+  osmscout::FastestPathRoutingProfile profile(database->GetTypeConfig());
+
+  GetCarSpeedTable(speedMap);
+  profile.ParametrizeForCar(*database->GetTypeConfig(),speedMap,160.0);
+
+  auto start=router.GetClosestRoutableNode(args.start,profile,osmscout::Kilometers(1));
+  auto target=router.GetClosestRoutableNode(args.target,profile,osmscout::Kilometers(1));
+
+  if (!start.IsValid() ||
+      !target.IsValid()) {
+    std::cerr << "Cannot find routable nodes" << std::endl;
+    return 1;
+  }
+
+  // Without speed profiles the route does not depend on the departure
+  auto freeFlow=CalculateRoute(router,profile,start.GetRoutePosition(),target.GetRoutePosition(),AtMonday(8,0));
+
+  if (!freeFlow.Success() ||
+      !freeFlow.GetArrivalTime() ||
+      *freeFlow.GetArrivalTime()<=AtMonday(8,0)) {
+    std::cerr << "Time-dependent routing without speed profiles failed" << std::endl;
+    return 1;
+  }
+
+  osmscout::Duration freeFlowDuration=*freeFlow.GetArrivalTime()-AtMonday(8,0);
+
+  // Slow down all ways of the route in the monday rush hour
+  auto     speedProfiles=std::make_shared<osmscout::SpeedProfiles>();
+  uint32_t rushHour=speedProfiles->AddProfile(GetRushHourProfile());
+
+  for (const auto& offset : GetWayOffsets(freeFlow)) {
+    speedProfiles->AssignProfile(offset,rushHour);
+  }
+
+  router.SetSpeedProfiles(speedProfiles);
+
+  auto noon=CalculateRoute(router,profile,start.GetRoutePosition(),target.GetRoutePosition(),AtMonday(12,0));
+
+  if (!noon.Success() ||
+      *noon.GetArrivalTime()-AtMonday(12,0)!=freeFlowDuration ||
+      GetWayOffsets(noon)!=GetWayOffsets(freeFlow)) {
+    std::cerr << "Route outside of the rush hour differs from the free flow route" << std::endl;
+    return 1;
+  }
+
+  auto rushHourRoute=CalculateRoute(router,profile,start.GetRoutePosition(),target.GetRoutePosition(),AtMonday(8,0));
+
+  if (!rushHourRoute.Success()) {
+    std::cerr << "Routing in the rush hour failed" << std::endl;
+    return 1;
+  }
+
+  osmscout::Duration rushHourDuration=*rushHourRoute.GetArrivalTime()-AtMonday(8,0);
+
+  if (rushHourDuration<=freeFlowDuration ||
+      rushHourDuration>=freeFlowDuration*10 ||
+      GetWayOffsets(rushHourRoute)==GetWayOffsets(freeFlow)) {
+    std::cerr << "Route in the rush hour does not avoid the slow ways" << std::endl;
+    return 1;
+  }
+
+  // Only profiles with time costs are routed time-dependent
+  osmscout::ShortestPathRoutingProfile shortestProfile(database->GetTypeConfig());
+
+  shortestProfile.ParametrizeForCar(*database->GetTypeConfig(),speedMap,160.0);
+
+  osmscout::RoutingParameter parameter;
+
+  parameter.SetDepartureTime(AtMonday(8,0));
+
+  auto shortest=router.CalculateRoute(shortestProfile,
+                                      start.GetRoutePosition(),
+                                      target.GetRoutePosition(),
+                                      parameter);
+
+  if (!shortest.Success() ||
+      shortest.GetArrivalTime()) {
+    std::cerr << "Departure time is not ignored for shortest path profile" << std::endl;
+    return 1;
+  }
+
+  router.Close();
+  database->Close();
+
+  return 0;
+}
@@ -65,6 +65,11 @@
 #cmakedefine HAVE_INTTYPES_H 1
 #endif
 
+/* Define to 1 if you have the <linux/mempolicy.h> header file. */
+#ifndef HAVE_LINUX_MEMPOLICY_H
+#cmakedefine HAVE_LINUX_MEMPOLICY_H 1
+#endif
+
 /* Define to 1 if the system has the type `long long'. */
 #ifndef HAVE_LONG_LONG
 #cmakedefine HAVE_LONG_LONG 1
@@ -90,6 +95,11 @@
 #cmakedefine HAVE_POSIX_FADVISE 1
 #endif
 
+/* Define to 1 if you have the `pread' function. */
+#ifndef HAVE_PREAD
+#cmakedefine HAVE_PREAD 1
+#endif
+
 /* Define to 1 if you have the `posix_madvise' function. */
 #ifndef HAVE_POSIX_MADVISE
 #cmakedefine HAVE_POSIX_MADVISE 1
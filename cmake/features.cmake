@@ -85,6 +85,7 @@ include(CheckIncludeFileCXX)
 check_include_file(dlfcn.h HAVE_DLFCN_H)
 check_include_file(fcntl.h HAVE_FCNTL_H)
 check_include_file(inttypes.h HAVE_INTTYPES_H)
+check_include_file(linux/mempolicy.h HAVE_LINUX_MEMPOLICY_H)
 check_include_file(memory.h HAVE_MEMORY_H)
 check_include_file(stdint.h HAVE_STDINT_H)
 check_include_file(stdlib.h HAVE_STDLIB_H)
@@ -121,6 +122,7 @@ set(CMAKE_EXTRA_INCLUDE_FILES)
 check_function_exists(fseeko HAVE_FSEEKO)
 check_function_exists(mmap HAVE_MMAP)
 check_function_exists(posix_fadvise HAVE_POSIX_FADVISE)
+check_function_exists(pread HAVE_PREAD)
 check_function_exists(posix_madvise HAVE_POSIX_MADVISE)
 check_function_exists(mallinfo HAVE_MALLINFO)
 
@@ -0,0 +1,68 @@
+#ifndef LIBOSMSCOUT_GPX_MAPMATCHING_H
+#define LIBOSMSCOUT_GPX_MAPMATCHING_H
+/*
+  This source is part of the libosmscout-gpx library
+  Copyright (C) 2026 Tim Teulings
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307  USA
+*/
+
+#include <osmscout/gpx/GPXImportExport.h>
+#include <osmscout/gpx/Track.h>
+
+#include <osmscout/routing/MapMatching.h>
+#include <osmscout/routing/SimpleRoutingService.h>
+
+#include <vector>
+
+namespace osmscout::gpx {
+
+/**
+ * Match the points of all segments of the track to the routing graph,
+ * see SimpleRoutingService::MatchTrack(). The matched points of the result
+ * are in the order of the points of the segments.
+ *
+ * @param router
+ * @param profile
+ * @param track
+ * @param matchParameter
+ * @param parameter
+ * @return matched positions and routes
+ */
+extern OSMSCOUT_GPX_API MapMatchResult MatchTrack(SimpleRoutingService &router,
+                                                  RoutingProfile &profile,
+                                                  const Track &track,
+                                                  const MapMatchParameter &matchParameter=MapMatchParameter(),
+                                                  const RoutingParameter &parameter=RoutingParameter());
+
+/**
+ * Match multiple tracks in parallel, see SimpleRoutingService::MatchTracks().
+ *
+ * @param router
+ * @param profile
+ * @param tracks
+ * @param matchParameter
+ * @param parameter
+ * @return one result for each track
+ */
+extern OSMSCOUT_GPX_API std::vector<MapMatchResult> MatchTracks(SimpleRoutingService &router,
+                                                                RoutingProfile &profile,
+                                                                const std::vector<Track> &tracks,
+                                                                const MapMatchParameter &matchParameter=MapMatchParameter(),
+                                                                const RoutingParameter &parameter=RoutingParameter());
+
+}
+
+#endif //LIBOSMSCOUT_GPX_MAPMATCHING_H
@@ -0,0 +1,68 @@
+/*
+  This source is part of the libosmscout-gpx library
+  Copyright (C) 2026 Tim Teulings
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307  USA
+*/
+
+#include <osmscout/gpx/MapMatching.h>
+
+using namespace osmscout;
+using namespace osmscout::gpx;
+
+namespace {
+
+std::vector<GeoCoord> GetTrackCoords(const Track &track)
+{
+  std::vector<GeoCoord> coords;
+  coords.reserve(track.GetPointCount());
+  for (const TrackSegment &segment:track.segments){
+    for (const TrackPoint &point:segment.points){
+      coords.push_back(point.coord);
+    }
+  }
+  return coords;
+}
+
+}
+
+MapMatchResult gpx::MatchTrack(SimpleRoutingService &router,
+                               RoutingProfile &profile,
+                               const Track &track,
+                               const MapMatchParameter &matchParameter,
+                               const RoutingParameter &parameter)
+{
+  return router.MatchTrack(profile,
+                           GetTrackCoords(track),
+                           matchParameter,
+                           parameter);
+}
+
+std::vector<MapMatchResult> gpx::MatchTracks(SimpleRoutingService &router,
+                                             RoutingProfile &profile,
+                                             const std::vector<Track> &tracks,
+                                             const MapMatchParameter &matchParameter,
+                                             const RoutingParameter &parameter)
+{
+  std::vector<std::vector<GeoCoord>> coords;
+  coords.reserve(tracks.size());
+  for (const Track &track:tracks){
+    coords.push_back(GetTrackCoords(track));
+  }
+  return router.MatchTracks(profile,
+                            coords,
+                            matchParameter,
+                            parameter);
+}
@@ -172,6 +172,9 @@ private:
 
   size_t                       routeNodeBlockSize;       //<! Number of route nodes loaded during import until ways get resolved
   uint32_t                     routeNodeTileMag;         //<! Size of a routing tile
+  bool                         routeContractionHierarchy;//<! Generate contraction hierarchies for the routers
+  bool                         routePartition;           //<! Generate multi-level partitions for the routers
+  bool                         routeSnapIndex;           //<! Generate snap indexes for the routers
 
   AssumeLandStrategy           assumeLand;               //<! During sea/land detection,we either trust coastlines only or make some
   //<! assumptions which tiles are sea and which are land.
@@ -263,6 +266,9 @@ private:
 
   size_t GetRouteNodeBlockSize() const;
   uint32_t GetRouteNodeTileMag() const;
+  bool GetRouteContractionHierarchy() const;
+  bool GetRoutePartition() const;
+  bool GetRouteSnapIndex() const;
 
   AssumeLandStrategy GetAssumeLand() const;
 
@@ -347,6 +353,9 @@ private:
 
   void SetRouteNodeBlockSize(size_t blockSize);
   void SetRouteNodeTileMag(uint32_t routeNodeTileMag);
+  void SetRouteContractionHierarchy(bool routeContractionHierarchy);
+  void SetRoutePartition(bool routePartition);
+  void SetRouteSnapIndex(bool routeSnapIndex);
 
   void SetAssumeLand(AssumeLandStrategy assumeLand);
 
@@ -0,0 +1,45 @@
+#ifndef OSMSCOUT_IMPORT_IMPORTROUTINGPROFILE_H
+#define OSMSCOUT_IMPORT_IMPORTROUTINGPROFILE_H
+
+/*
+  This source is part of the libosmscout library
+  Copyright (C) 2026  Tim Teulings
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307  USA
+*/
+
+#include <osmscout/TypeConfig.h>
+
+#include <osmscout/routing/RoutingProfile.h>
+
+#include <osmscout/import/ImportImportExport.h>
+
+namespace osmscout {
+
+  /**
+   * Parametrize the given profile for the given vehicle with the default
+   * speeds (as used by the demos), for routing data that is precalculated
+   * during import. Junction penalties are disabled, so only profiles without
+   * them match the precalculated data.
+   *
+   * @return
+   *    false, if not all routable types have a speed
+   */
+  extern OSMSCOUT_IMPORT_API bool ParametrizeImportRoutingProfile(FastestPathRoutingProfile& profile,
+                                                                  const TypeConfig& typeConfig,
+                                                                  Vehicle vehicle);
+}
+
+#endif
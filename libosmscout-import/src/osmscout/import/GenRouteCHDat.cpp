@@ -0,0 +1,116 @@
+/*
+  This source is part of the libosmscout library
+  Copyright (C) 2026  Tim Teulings
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307  USA
+*/
+
+#include <osmscout/import/GenRouteCHDat.h>
+
+#include <osmscout/routing/ContractionHierarchy.h>
+#include <osmscout/routing/RoutingProfile.h>
+#include <osmscout/routing/RoutingService.h>
+
+#include <osmscout/util/File.h>
+
+#include <osmscout/import/ImportRoutingProfile.h>
+
+namespace osmscout {
+
+  namespace {
+    const std::vector<Vehicle> vehicles={vehicleFoot, vehicleBicycle, vehicleCar};
+  }
+
+  void RouteCHDataGenerator::GetDescription(const ImportParameter& parameter,
+                                            ImportModuleDescription& description) const
+  {
+    description.SetName("RouteCHDataGenerator");
+    description.SetDescription("Generate contraction hierarchies of routing graph(s)");
+
+    if (!parameter.GetRouteContractionHierarchy()) {
+      return;
+    }
+
+    for (const auto& router : parameter.GetRouter()) {
+      description.AddRequiredFile(router.GetDataFilename());
+      description.AddRequiredFile(router.GetVariantFilename());
+
+      for (const auto vehicle : vehicles) {
+        if ((router.GetVehicleMask() & vehicle)!=0) {
+          description.AddProvidedFile(RoutingService::GetContractionHierarchyFilename(router.GetFilenamebase(),
+                                                                                      vehicle));
+        }
+      }
+    }
+  }
+
+  bool RouteCHDataGenerator::Import(const TypeConfigRef& typeConfig,
+                                    const ImportParameter& parameter,
+                                    Progress& progress)
+  {
+    if (!parameter.GetRouteContractionHierarchy()) {
+      progress.Info("Contraction hierarchies are not enabled");
+      return true;
+    }
+
+    for (const auto& router : parameter.GetRouter()) {
+      for (const auto vehicle : vehicles) {
+        if ((router.GetVehicleMask() & vehicle)==0) {
+          continue;
+        }
+
+        FastestPathRoutingProfile profile(typeConfig);
+
+        switch (vehicle) {
+        case vehicleFoot:
+          progress.SetStep("Building contraction hierarchy for foot");
+          break;
+        case vehicleBicycle:
+          progress.SetStep("Building contraction hierarchy for bicycle");
+          break;
+        case vehicleCar:
+          progress.SetStep("Building contraction hierarchy for car");
+          break;
+        }
+
+        if (!ParametrizeImportRoutingProfile(profile,
+                                             *typeConfig,
+                                             vehicle)) {
+          progress.Warning("Not all routable types have a speed, they are not part of the hierarchy");
+        }
+
+        ContractionHierarchyBuilder builder(profile);
+        ContractionHierarchy        hierarchy;
+
+        if (!builder.Build(progress,
+                           *typeConfig,
+                           parameter.GetDestinationDirectory(),
+                           router.GetFilenamebase(),
+                           hierarchy)) {
+          return false;
+        }
+
+        if (!hierarchy.Store(AppendFileToDir(parameter.GetDestinationDirectory(),
+                                             RoutingService::GetContractionHierarchyFilename(router.GetFilenamebase(),
+                                                                                             vehicle)))) {
+          progress.Error("Cannot write contraction hierarchy");
+          return false;
+        }
+      }
+    }
+
+    return true;
+  }
+}
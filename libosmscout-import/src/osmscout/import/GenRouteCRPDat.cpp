@@ -0,0 +1,84 @@
+/*
+  This source is part of the libosmscout library
+  Copyright (C) 2026  Tim Teulings
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307  USA
+*/
+
+#include <osmscout/import/GenRouteCRPDat.h>
+
+#include <osmscout/routing/RoutePartition.h>
+#include <osmscout/routing/RoutingService.h>
+
+#include <osmscout/util/File.h>
+
+namespace osmscout {
+
+  namespace {
+    const size_t  cellSize=256;    //!< Maximum number of route nodes in a cell of the lowest level
+    const uint8_t bitsPerLevel=4;  //!< Each cell contains 16 cells of the level below
+  }
+
+  void RouteCRPDataGenerator::GetDescription(const ImportParameter& parameter,
+                                             ImportModuleDescription& description) const
+  {
+    description.SetName("RouteCRPDataGenerator");
+    description.SetDescription("Generate multi-level partitions of routing graph(s)");
+
+    if (!parameter.GetRoutePartition()) {
+      return;
+    }
+
+    for (const auto& router : parameter.GetRouter()) {
+      description.AddRequiredFile(router.GetDataFilename());
+      description.AddRequiredFile(router.GetVariantFilename());
+
+      description.AddProvidedFile(RoutingService::GetPartitionFilename(router.GetFilenamebase()));
+    }
+  }
+
+  bool RouteCRPDataGenerator::Import(const TypeConfigRef& typeConfig,
+                                     const ImportParameter& parameter,
+                                     Progress& progress)
+  {
+    if (!parameter.GetRoutePartition()) {
+      progress.Info("Route partitions are not enabled");
+      return true;
+    }
+
+    for (const auto& router : parameter.GetRouter()) {
+      RoutePartition partition;
+
+      progress.SetStep("Building partition for router '"+router.GetFilenamebase()+"'");
+
+      if (!partition.Build(progress,
+                           *typeConfig,
+                           parameter.GetDestinationDirectory(),
+                           router.GetFilenamebase(),
+                           cellSize,
+                           bitsPerLevel)) {
+        return false;
+      }
+
+      if (!partition.Store(AppendFileToDir(parameter.GetDestinationDirectory(),
+                                           RoutingService::GetPartitionFilename(router.GetFilenamebase())))) {
+        progress.Error("Cannot write route partition");
+        return false;
+      }
+    }
+
+    return true;
+  }
+}
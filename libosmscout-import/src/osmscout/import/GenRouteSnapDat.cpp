@@ -0,0 +1,74 @@
+/*
+  This source is part of the libosmscout library
+  Copyright (C) 2026  Tim Teulings
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307  USA
+*/
+
+#include <osmscout/import/GenRouteSnapDat.h>
+
+#include <osmscout/AreaDataFile.h>
+#include <osmscout/WayDataFile.h>
+
+#include <osmscout/routing/RouteSnapIndex.h>
+#include <osmscout/routing/RoutingService.h>
+
+#include <osmscout/util/File.h>
+
+namespace osmscout {
+
+  void RouteSnapDataGenerator::GetDescription(const ImportParameter& parameter,
+                                              ImportModuleDescription& description) const
+  {
+    description.SetName("RouteSnapDataGenerator");
+    description.SetDescription("Generate spatial index of routable segments");
+
+    if (!parameter.GetRouteSnapIndex()) {
+      return;
+    }
+
+    description.AddRequiredFile(WayDataFile::WAYS_DAT);
+    description.AddRequiredFile(AreaDataFile::AREAS_DAT);
+
+    for (const auto& router : parameter.GetRouter()) {
+      description.AddProvidedFile(RoutingService::GetSnapIndexFilename(router.GetFilenamebase()));
+    }
+  }
+
+  bool RouteSnapDataGenerator::Import(const TypeConfigRef& typeConfig,
+                                      const ImportParameter& parameter,
+                                      Progress& progress)
+  {
+    if (!parameter.GetRouteSnapIndex()) {
+      progress.Info("Snap indexes are not enabled");
+      return true;
+    }
+
+    for (const auto& router : parameter.GetRouter()) {
+      progress.SetStep("Building snap index for router '"+router.GetFilenamebase()+"'");
+
+      if (!RouteSnapIndex::Build(progress,
+                                 *typeConfig,
+                                 parameter.GetDestinationDirectory(),
+                                 router.GetVehicleMask(),
+                                 AppendFileToDir(parameter.GetDestinationDirectory(),
+                                                 RoutingService::GetSnapIndexFilename(router.GetFilenamebase())))) {
+        return false;
+      }
+    }
+
+    return true;
+  }
+}
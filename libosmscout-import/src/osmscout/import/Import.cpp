@@ -65,6 +65,9 @@
 
 // Routing
 #include <osmscout/import/GenRouteDat.h>
+#include <osmscout/import/GenRouteCHDat.h>
+#include <osmscout/import/GenRouteCRPDat.h>
+#include <osmscout/import/GenRouteSnapDat.h>
 #include <osmscout/import/GenIntersectionIndex.h>
 
 // Public Transport
@@ -228,6 +231,18 @@ namespace osmscout {
     modules.push_back(std::make_shared<TextIndexGenerator>());
 #endif
 
+    // Optional routing data, only generated if enabled in the ImportParameter.
+    // Without text index the step numbers are one less.
+
+    /* 29 */
+    modules.push_back(std::make_shared<RouteCHDataGenerator>());
+
+    /* 30 */
+    modules.push_back(std::make_shared<RouteCRPDataGenerator>());
+
+    /* 31 */
+    modules.push_back(std::make_shared<RouteSnapDataGenerator>());
+
     assert(modules.size()==ImportParameter::GetDefaultEndStep());
   }
 
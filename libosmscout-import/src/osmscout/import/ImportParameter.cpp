@@ -28,9 +28,9 @@ namespace osmscout {
 
 static const size_t defaultStartStep=1;
 #if defined(OSMSCOUT_IMPORT_HAVE_LIB_MARISA)
-static const size_t defaultEndStep=28;
+static const size_t defaultEndStep=31;
 #else
-static const size_t defaultEndStep=27;
+static const size_t defaultEndStep=30;
 #endif
 
 size_t ImportParameter::GetDefaultStartStep()
@@ -99,6 +99,9 @@ ImportParameter::ImportParameter()
       optimizationWayMethod(TransPolygon::quality),
       routeNodeBlockSize(500000),
       routeNodeTileMag(13),
+      routeContractionHierarchy(false),
+      routePartition(false),
+      routeSnapIndex(false),
       assumeLand(AssumeLandStrategy::automatic),
       langOrder({"#"}),
       maxAdminLevel(10),
@@ -368,6 +371,21 @@ uint32_t ImportParameter::GetRouteNodeTileMag() const
   return routeNodeTileMag;
 }
 
+bool ImportParameter::GetRouteContractionHierarchy() const
+{
+  return routeContractionHierarchy;
+}
+
+bool ImportParameter::GetRoutePartition() const
+{
+  return routePartition;
+}
+
+bool ImportParameter::GetRouteSnapIndex() const
+{
+  return routeSnapIndex;
+}
+
 ImportParameter::AssumeLandStrategy ImportParameter::GetAssumeLand() const
 {
   return assumeLand;
@@ -662,6 +680,21 @@ void ImportParameter::SetRouteNodeTileMag(uint32_t routeNodeTileMag)
   this->routeNodeTileMag=routeNodeTileMag;
 }
 
+void ImportParameter::SetRouteContractionHierarchy(bool routeContractionHierarchy)
+{
+  this->routeContractionHierarchy=routeContractionHierarchy;
+}
+
+void ImportParameter::SetRoutePartition(bool routePartition)
+{
+  this->routePartition=routePartition;
+}
+
+void ImportParameter::SetRouteSnapIndex(bool routeSnapIndex)
+{
+  this->routeSnapIndex=routeSnapIndex;
+}
+
 void ImportParameter::SetAssumeLand(AssumeLandStrategy assumeLand)
 {
   this->assumeLand=assumeLand;
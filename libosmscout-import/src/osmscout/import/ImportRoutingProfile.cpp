@@ -0,0 +1,78 @@
+/*
+  This source is part of the libosmscout library
+  Copyright (C) 2026  Tim Teulings
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307  USA
+*/
+
+#include <osmscout/import/ImportRoutingProfile.h>
+
+#include <map>
+
+namespace osmscout {
+
+  bool ParametrizeImportRoutingProfile(FastestPathRoutingProfile& profile,
+                                       const TypeConfig& typeConfig,
+                                       Vehicle vehicle)
+  {
+    bool success=false;
+
+    switch (vehicle) {
+    case vehicleFoot:
+      profile.ParametrizeForFoot(typeConfig,
+                                 5.0);
+      success=true;
+      break;
+    case vehicleBicycle:
+      profile.ParametrizeForBicycle(typeConfig,
+                                    20.0);
+      success=true;
+      break;
+    case vehicleCar: {
+      std::map<std::string,double> carSpeedTable;
+
+      carSpeedTable["highway_motorway"]=110.0;
+      carSpeedTable["highway_motorway_trunk"]=100.0;
+      carSpeedTable["highway_motorway_primary"]=70.0;
+      carSpeedTable["highway_motorway_link"]=60.0;
+      carSpeedTable["highway_motorway_junction"]=60.0;
+      carSpeedTable["highway_trunk"]=100.0;
+      carSpeedTable["highway_trunk_link"]=60.0;
+      carSpeedTable["highway_primary"]=70.0;
+      carSpeedTable["highway_primary_link"]=60.0;
+      carSpeedTable["highway_secondary"]=60.0;
+      carSpeedTable["highway_secondary_link"]=50.0;
+      carSpeedTable["highway_tertiary"]=55.0;
+      carSpeedTable["highway_tertiary_link"]=55.0;
+      carSpeedTable["highway_unclassified"]=50.0;
+      carSpeedTable["highway_road"]=50.0;
+      carSpeedTable["highway_residential"]=40.0;
+      carSpeedTable["highway_roundabout"]=40.0;
+      carSpeedTable["highway_living_street"]=10.0;
+      carSpeedTable["highway_service"]=30.0;
+
+      success=profile.ParametrizeForCar(typeConfig,
+                                        carSpeedTable,
+                                        160.0);
+      break;
+    }
+    }
+
+    // Precalculated costs only contain the costs of the paths
+    profile.SetJunctionPenalty(false);
+
+    return success;
+  }
+}
@@ -21,16 +21,17 @@
 */
 
 #include <memory>
-#include <mutex>
 #include <vector>
 
 #include <osmscout/DataFile.h>
 
 #include <osmscout/TypeInfoSet.h>
 
-#include <osmscout/util/Cache.h>
+#include <osmscout/util/ConcurrentCache.h>
 #include <osmscout/util/Geometry.h>
+#include <osmscout/util/MemoryGovernor.h>
 #include <osmscout/util/FileScanner.h>
+#include <osmscout/util/FileScannerPool.h>
 
 namespace osmscout {
 
@@ -47,6 +48,14 @@ namespace osmscout {
 
     Internally the index is implemented as quadtree. As a result each index entry
     has 4 children (besides entries in the lowest level).
+
+    Lookups are thread-safe and do not block each other, each lookup reads
+    using its own scanner from a pool.
+
+    Optionally the complete index can be preloaded into memory (see Preload()).
+    The cells are then stored in breadth first order in a flat array,
+    referencing their children by array index instead of file offset, and
+    lookups do not touch the file at all.
     */
   class OSMSCOUT_API AreaAreaIndex
   {
@@ -63,7 +72,29 @@ namespace osmscout {
       FileOffset data;        //!< The file index at which the data payload starts
     };
 
-    using IndexCache = Cache<FileOffset, IndexCell>;
+    /**
+      Preloaded index cell, children are referenced by their index in
+      preloadedCells (the top level cell has index 0 and thus 0 can be used
+      to mark a missing child).
+      */
+    struct PreloadedCell
+    {
+      uint32_t children[4]; //!< Index of each of the four children, or 0 if there is no child
+      uint32_t dataStart;   //!< Index of the first data entry of the cell in preloadedData
+      uint32_t dataEnd;     //!< Index after the last data entry of the cell in preloadedData
+    };
+
+    /**
+      Preloaded data entry of an index cell
+      */
+    struct PreloadedData
+    {
+      TypeId     type;        //!< Type of the areas
+      uint32_t   count;       //!< Number of areas of this type
+      FileOffset offset;      //!< Offset of the first area in the data file
+    };
+
+    using IndexCache = ConcurrentCache<FileOffset, IndexCell>;
 
     struct IndexCacheValueSizer : public IndexCache::ValueSizer
     {
@@ -94,48 +125,98 @@ namespace osmscout {
       }
     };
 
+    struct PreloadedCellRef
+    {
+      uint32_t index;
+      size_t   x;
+      size_t   y;
+
+      PreloadedCellRef(uint32_t index,
+                       size_t x,
+                       size_t y)
+      : index(index),
+        x(x),
+        y(y)
+      {
+        // no code
+      }
+    };
+
   private:
-    std::string           datafilename;   //!< Full path and name of the data file
-    mutable FileScanner   scanner;        //!< Scanner instance for reading this file, guarded by lookupMutex
+    std::string                datafilename;   //!< Full path and name of the data file
+    FileScannerPool            scannerPool;    //!< Scanner instances for reading this file, one per concurrent lookup
 
-    uint32_t              maxLevel;       //!< Maximum level in index
-    FileOffset            topLevelOffset; //!< File offset of the top level index entry
+    uint32_t                   maxLevel;       //!< Maximum level in index
+    FileOffset                 topLevelOffset; //!< File offset of the top level index entry
 
-    mutable IndexCache    indexCache;     //!< Cached map of all index entries by file offset, guarded by lookupMutex
+    mutable IndexCache         indexCache;     //!< Cached map of all index entries by file offset
+    MemoryGovernorRef          memoryGovernor; //!< Governor controlling the memory budget of the cache, if any
 
-    mutable std::mutex    lookupMutex;
+    std::vector<PreloadedCell> preloadedCells; //!< All index cells in breadth first order, if preloaded
+    std::vector<PreloadedData> preloadedData;  //!< Data entries of all preloaded index cells
 
   private:
-    bool GetIndexCell(uint32_t level,
+    void DetachMemoryGovernor();
+
+    bool GetIndexCell(FileScanner& scanner,
+                      uint32_t level,
                       FileOffset offset,
                       IndexCell& indexCell,
                       FileOffset& dataOffset) const;
 
-    bool ReadCellData(const TypeConfig& typeConfig,
+    bool ReadCellData(FileScanner& scanner,
+                      const TypeConfig& typeConfig,
                       const TypeInfoSet& types,
                       FileOffset dataOffset,
                       std::vector<DataBlockSpan>& spans) const;
 
+    template<typename OnEntry>
+    void ReadCellEntries(FileScanner& scanner,
+                         const TypeConfig& typeConfig,
+                         FileOffset dataOffset,
+                         OnEntry onEntry) const;
+
+    template<typename Cell, typename Ref>
     void PushCellsForNextLevel(double minlon,
                                double minlat,
                                double maxlon,
                                double maxlat,
-                               const IndexCell & cellIndexData,
+                               const Cell& cellIndexData,
                                const CellDimension& cellDimension,
                                size_t cx,
                                size_t cy,
-                               std::vector<CellRef>& nextCellRefs) const;
+                               std::vector<Ref>& nextCellRefs) const;
+
+    bool GetAreasInAreaFromFile(const TypeConfig& typeConfig,
+                                double minlon,
+                                double minlat,
+                                double maxlon,
+                                double maxlat,
+                                size_t maxLevel,
+                                const TypeInfoSet& types,
+                                std::vector<DataBlockSpan>& spans) const;
+
+    void GetAreasInAreaFromMemory(const TypeConfig& typeConfig,
+                                  double minlon,
+                                  double minlat,
+                                  double maxlon,
+                                  double maxlat,
+                                  size_t maxLevel,
+                                  const TypeInfoSet& types,
+                                  std::vector<DataBlockSpan>& spans) const;
 
   public:
     explicit AreaAreaIndex(size_t cacheSize);
     virtual ~AreaAreaIndex();
 
     void Close();
-    bool Open(const std::string& path, bool memoryMappedData);
+    bool Open(const std::string& path,
+              bool memoryMappedData,
+              uint8_t mmapAdvice=FileScanner::NoAdvice);
 
     inline bool IsOpen() const
     {
-      return scanner.IsOpen();
+      return scannerPool.IsOpen();
     }
 
     inline std::string GetFilename() const
@@ -143,6 +224,20 @@ namespace osmscout {
       return datafilename;
     }
 
+    bool Prefault() const;
+
+    bool Preload(const TypeConfig& typeConfig);
+
+    /**
+     * Returns true, if the index was completely loaded into memory
+     */
+    inline bool IsPreloaded() const
+    {
+      return !preloadedCells.empty();
+    }
+
+    size_t GetPreloadedMemory() const;
+
     bool GetAreasInArea(const TypeConfig& typeConfig,
                         const GeoBox& boundingBox,
                         size_t maxLevel,
@@ -153,6 +248,9 @@ namespace osmscout {
     void DumpStatistics();
 
     void FlushCache();
+    void SetCacheMemory(size_t maxMemory);
+    void SetMemoryGovernor(const MemoryGovernorRef& governor,
+                           double weight);
   };
 
   using AreaAreaIndexRef = std::shared_ptr<AreaAreaIndex>;
@@ -46,6 +46,9 @@ namespace osmscout {
     AreaDataFile& operator=(AreaDataFile&&) = delete;
 
     ~AreaDataFile() override = default;
+
+  protected:
+    size_t GetValueMemory(const Area& area) const override;
   };
 
   using AreaDataFileRef = std::shared_ptr<AreaDataFile>;
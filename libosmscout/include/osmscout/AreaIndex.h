@@ -20,7 +20,6 @@
 */
 
 #include <memory>
-#include <mutex>
 #include <unordered_set>
 #include <vector>
 
@@ -28,6 +27,7 @@
 #include <osmscout/TypeInfoSet.h>
 
 #include <osmscout/util/FileScanner.h>
+#include <osmscout/util/FileScannerPool.h>
 #include <osmscout/util/TileId.h>
 
 namespace osmscout {
@@ -35,6 +35,9 @@ namespace osmscout {
   /**
     \ingroup Database
     Generic area index for lookup objects by area
+
+    Lookups are thread-safe and do not block each other, each lookup reads
+    using its own scanner from a pool.
     */
   class OSMSCOUT_API AreaIndex
   {
@@ -59,20 +62,20 @@ namespace osmscout {
 
     std::string           indexFileName;
     std::string           fullIndexFileName;  //!< Full path and name of the data file
-    mutable FileScanner   scanner;            //!< Scanner instance for reading this file
+    FileScannerPool       scannerPool;        //!< Scanner instances for reading this file, one per concurrent lookup
 
     std::vector<TypeData> typeData;
 
-    mutable std::mutex    lookupMutex;
-
   protected:
-    void GetOffsets(const TypeData& typeData,
+    void GetOffsets(FileScanner& scanner,
+                    const TypeData& typeData,
                     const GeoBox& boundingBox,
                     std::unordered_set<FileOffset>& offsets) const;
 
     AreaIndex(const std::string &indexFileName);
 
     virtual void ReadTypeData(const TypeConfigRef& typeConfig,
+                              FileScanner& scanner,
                               TypeData &data) = 0;
 
   public:
@@ -89,11 +92,12 @@ namespace osmscout {
     void Close();
     bool Open(const TypeConfigRef& typeConfig,
               const std::string& path,
-              bool memoryMappedData);
+              bool memoryMappedData,
+              uint8_t mmapAdvice=FileScanner::NoAdvice);
 
     inline bool IsOpen() const
     {
-      return scanner.IsOpen();
+      return scannerPool.IsOpen();
     }
 
     inline std::string GetFilename() const
@@ -101,6 +105,8 @@ namespace osmscout {
       return fullIndexFileName;
     }
 
+    bool Prefault() const;
+
     bool GetOffsets(const GeoBox& boundingBox,
                     const TypeInfoSet& types,
                     std::vector<FileOffset>& offsets,
@@ -22,13 +22,13 @@
 
 #include <map>
 #include <memory>
-#include <mutex>
 #include <vector>
 
 #include <osmscout/TypeConfig.h>
 #include <osmscout/TypeInfoSet.h>
 
 #include <osmscout/util/FileScanner.h>
+#include <osmscout/util/FileScannerPool.h>
 #include <osmscout/util/TileId.h>
 
 namespace osmscout {
@@ -40,6 +40,9 @@ namespace osmscout {
     a given area.
 
     Ways can be limited by type and result count.
+
+    Lookups are thread-safe and do not block each other, each lookup reads
+    using its own scanner from a pool.
     */
   class OSMSCOUT_API AreaNodeIndex
   {
@@ -73,24 +76,25 @@ namespace osmscout {
     };
 
   private:
-    mutable FileScanner   scanner;        //!< Scanner instance for reading this file,
-                                          //!< guarded by lookupMutex (Open and Close method are not guarded!)
+    FileScannerPool       scannerPool;    //!< Scanner instances for reading this file, one per concurrent lookup
+                                          //!< (Open and Close method are not thread-safe!)
 
     MagnificationLevel    gridMag;
     std::vector<TypeData> nodeTypeData;
 
-    mutable std::mutex    lookupMutex;
-
   private:
-    bool GetOffsetsList(const TypeData& typeData,
+    bool GetOffsetsList(FileScanner& scanner,
+                        const TypeData& typeData,
                         const GeoBox& boundingBox,
                         std::vector<FileOffset>& offsets) const;
 
-    bool GetOffsetsTileList(const TypeData& typeData,
+    bool GetOffsetsTileList(FileScanner& scanner,
+                            const TypeData& typeData,
                             const GeoBox& boundingBox,
                             std::vector<FileOffset>& offsets) const;
 
-    bool GetOffsetsBitmap(const TypeData& typeData,
+    bool GetOffsetsBitmap(FileScanner& scanner,
+                          const TypeData& typeData,
                           const GeoBox& boundingBox,
                           std::vector<FileOffset>& offsets) const;
 
@@ -99,18 +103,21 @@ namespace osmscout {
 
     void Close();
     bool Open(const std::string& path,
-              bool memoryMappedData);
+              bool memoryMappedData,
+              uint8_t mmapAdvice=FileScanner::NoAdvice);
 
     inline bool IsOpen() const
     {
-      return scanner.IsOpen();
+      return scannerPool.IsOpen();
     }
 
     inline std::string GetFilename() const
     {
-      return scanner.GetFilename();
+      return scannerPool.GetFilename();
     }
 
+    bool Prefault() const;
+
     bool GetOffsets(const GeoBox& boundingBox,
                     const TypeInfoSet& requestedTypes,
                     std::vector<FileOffset>& offsets,
@@ -49,6 +49,7 @@ namespace osmscout {
 
   private:
     void ReadTypeData(const TypeConfigRef& typeConfig,
+                      FileScanner& scanner,
                       TypeData &data) override;
 
   public:
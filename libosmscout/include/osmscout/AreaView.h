@@ -0,0 +1,131 @@
+#ifndef OSMSCOUT_AREAVIEW_H
+#define OSMSCOUT_AREAVIEW_H
+
+/*
+  This source is part of the libosmscout library
+  Copyright (C) 2026  Tim Teulings
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307  USA
+*/
+
+#include <vector>
+
+#include <osmscout/CoreImportExport.h>
+
+#include <osmscout/Area.h>
+#include <osmscout/ObjectRef.h>
+#include <osmscout/PointSequenceView.h>
+#include <osmscout/TypeConfig.h>
+
+#include <osmscout/util/FileScanner.h>
+
+#include <osmscout/system/Compiler.h>
+
+namespace osmscout {
+
+  /**
+   * \ingroup Geometry
+   *
+   * Read-only, non-owning variant of Area for hot read paths, see WayView.
+   *
+   * The coordinates of all rings reference the memory mapped data file, so
+   * the only allocation per area is the ring vector (and the feature
+   * values). An AreaView is only valid as long as the file stays open.
+   */
+  class OSMSCOUT_API AreaView CLASS_FINAL
+  {
+  public:
+    class OSMSCOUT_API Ring CLASS_FINAL
+    {
+    private:
+      FeatureValueBuffer featureValueBuffer; //!< List of features
+      uint8_t            ring=0;             //!< The ring hierarchy number (0...n)
+      PointSequenceView  nodes;              //!< View of the ring coordinates
+
+    public:
+      Ring() = default;
+
+      inline TypeInfoRef GetType() const
+      {
+        return featureValueBuffer.GetType();
+      }
+
+      inline const FeatureValueBuffer& GetFeatureValueBuffer() const
+      {
+        return featureValueBuffer;
+      }
+
+      inline uint8_t GetRing() const
+      {
+        return ring;
+      }
+
+      inline bool IsMaster() const
+      {
+        return ring==Area::masterRingId;
+      }
+
+      inline bool IsOuter() const
+      {
+        return ring==Area::outerRingId;
+      }
+
+      inline const PointSequenceView& GetNodes() const
+      {
+        return nodes;
+      }
+
+      friend class AreaView;
+    };
+
+  private:
+    FileOffset        fileOffset=0;     //!< Offset into the data file of this area
+    FileOffset        nextFileOffset=0; //!< Offset after this area
+    std::vector<Ring> rings;            //!< Rings of the area, the first ring is the master or the outer ring
+
+  public:
+    AreaView() = default;
+
+    inline FileOffset GetFileOffset() const
+    {
+      return fileOffset;
+    }
+
+    inline FileOffset GetNextFileOffset() const
+    {
+      return nextFileOffset;
+    }
+
+    inline ObjectFileRef GetObjectFileRef() const
+    {
+      return {fileOffset,refArea};
+    }
+
+    inline TypeInfoRef GetType() const
+    {
+      return rings.front().GetType();
+    }
+
+    inline const std::vector<Ring>& GetRings() const
+    {
+      return rings;
+    }
+
+    void Read(const TypeConfig& typeConfig,
+              FileScanner& scanner);
+  };
+}
+
+#endif
@@ -20,6 +20,7 @@
   Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307  USA
 */
 
+#include <algorithm>
 #include <memory>
 #include <mutex>
 #include <set>
@@ -29,9 +30,11 @@
 #include <osmscout/NumericIndex.h>
 #include <osmscout/TypeConfig.h>
 
-#include <osmscout/util/Cache.h>
+#include <osmscout/util/ConcurrentCache.h>
 #include <osmscout/util/FileScanner.h>
+#include <osmscout/util/FileScannerPool.h>
 #include <osmscout/util/Logger.h>
+#include <osmscout/util/MemoryGovernor.h>
 
 //#include <map>
 namespace osmscout {
@@ -68,34 +71,80 @@ namespace osmscout {
    * Access to standard format data files.
    *
    * Allows to load data objects by offset using various standard library data structures.
+   *
+   * Reading is done using a pool of FileScanner instances, so concurrent readers
+   * decode data in parallel, each with its own read cursor. The object cache
+   * is sharded, so concurrent readers seldom block each other.
+   *
+   * The cache is limited either by number of objects or by a memory budget
+   * (see SetCacheMemory()). Derived classes can improve the memory estimation
+   * of an object by overwriting GetValueMemory().
    */
   template <class N>
   class DataFile
   {
   public:
     using ValueType = std::shared_ptr<N>;
-    using ValueCache = Cache<FileOffset, std::shared_ptr<N> >;
+    using ValueCache = ConcurrentCache<FileOffset, ValueType>;
+
+  private:
+    /**
+      Calculates the memory of a cached value using DataFile::GetValueMemory()
+      */
+    class DataFileValueSizer : public ValueCache::ValueSizer
+    {
+    private:
+      const DataFile<N>& dataFile;
+
+    public:
+      explicit DataFileValueSizer(const DataFile<N>& dataFile)
+      : dataFile(dataFile)
+      {
+        // no code
+      }
 
-    using ValueCacheEntry = typename Cache<FileOffset, ValueType>::CacheEntry;
-    using ValueCacheRef = typename Cache<FileOffset, ValueType>::CacheRef;
+      size_t GetSize(const ValueType& value) const override
+      {
+        return sizeof(value)+dataFile.GetValueMemory(*value);
+      }
+    };
 
   private:
     std::string         datafile;        //!< Basename part of the data file name
     std::string         datafilename;    //!< complete filename for data file
 
-    mutable ValueCache  cache;
-
-    mutable FileScanner scanner;         //!< File stream to the data file
+    mutable ValueCache  cache;           //!< Cache of loaded objects by file offset
+    MemoryGovernorRef   memoryGovernor;  //!< Governor controlling the memory budget of the cache, if any
 
-    mutable std::mutex  accessMutex;     //!< Mutex to secure multi-thread access
+    FileScannerPool     scannerPool;     //!< File streams to the data file, one per concurrent reader
 
   protected:
     TypeConfigRef       typeConfig;
 
+  protected:
+    virtual size_t GetValueMemory(const N& value) const;
+
   private:
-    bool ReadData(N& data) const;
-    bool ReadData(FileOffset offset,
+    bool ReadData(FileScanner& scanner,
                   N& data) const;
+    bool ReadData(FileScanner& scanner,
+                  FileOffset offset,
+                  N& data) const;
+
+    void DetachMemoryGovernor();
+
+    bool GetFromCache(FileOffset offset,
+                      ValueType& value) const;
+    void AddToCache(FileOffset offset,
+                    const ValueType& value) const;
+
+    bool ReadSpan(FileScanner& scanner,
+                  const DataBlockSpan& span,
+                  std::vector<ValueType>& data) const;
+
+    bool ReadBatch(FileScanner& scanner,
+                   const std::vector<FileOffset>& offsets,
+                   std::vector<ValueType>& data) const;
 
   public:
     DataFile(const std::string& datafile, size_t cacheSize);
@@ -115,12 +164,19 @@ namespace osmscout {
     virtual bool Close();
 
     void FlushCache();
+    void SetCacheMemory(size_t maxMemory);
+    void SetMemoryGovernor(const MemoryGovernorRef& governor,
+                           double weight);
+    void DumpStatistics() const;
 
     inline std::string GetFilename() const
     {
       return datafilename;
     }
 
+    bool IsMemoryMapped() const;
+    bool Prefault() const;
+
     bool GetByOffset(FileOffset offset,
                      ValueType& entry) const;
 
@@ -143,6 +199,10 @@ namespace osmscout {
     template<typename IteratorIn>
     bool GetByBlockSpans(IteratorIn begin, IteratorIn end,
                          std::vector<ValueType>& data) const;
+
+    template<typename V, typename IteratorIn>
+    bool GetViewsByOffset(IteratorIn begin, IteratorIn end, size_t size,
+                          std::vector<V>& data) const;
   };
 
   template <class N>
@@ -158,15 +218,31 @@ namespace osmscout {
     if (IsOpen()) {
       Close();
     }
+
+    DetachMemoryGovernor();
+  }
+
+  /**
+   * Return the estimated memory of the given object, excluding the
+   * shared pointer holding it. The default implementation only
+   * returns the size of the object itself.
+   *
+   * Method must be thread-safe.
+   */
+  template <class N>
+  size_t DataFile<N>::GetValueMemory(const N& /*value*/) const
+  {
+    return sizeof(N);
   }
 
   /**
    * Read one data value from the given file offset.
    *
-   * Method is NOT thread-safe.
+   * Method is NOT thread-safe for the same scanner.
    */
   template <class N>
-  bool DataFile<N>::ReadData(FileOffset offset,
+  bool DataFile<N>::ReadData(FileScanner& scanner,
+                             FileOffset offset,
                              N& data) const
   {
     try {
@@ -186,10 +262,11 @@ namespace osmscout {
   /**
    * Read one data value from the current position of the stream
    *
-   * Method is NOT thread-safe.
+   * Method is NOT thread-safe for the same scanner.
    */
   template <class N>
-  bool DataFile<N>::ReadData(N& data) const
+  bool DataFile<N>::ReadData(FileScanner& scanner,
+                             N& data) const
   {
     try {
       data.Read(*typeConfig,
@@ -203,6 +280,203 @@ namespace osmscout {
     return true;
   }
 
+  /**
+   * Read the data values for the given file offsets. The result has the same
+   * order as the offsets.
+   *
+   * The offsets are read in ascending file order. If the file is not memory mapped,
+   * nearby offsets are coalesced into ranges that are read with one request each
+   * (see FileScanner::Prefetch()) and the objects are decoded from memory. Since
+   * the size of an object is not known in advance, the range is extended by some
+   * bytes after the last offset. If an object still exceeds the range, it is read
+   * again from a larger range starting at the object.
+   *
+   * The scanner keeps the prefetch buffer for the next batch, so the additional
+   * memory is bounded by the maximum range size.
+   *
+   * Method is NOT thread-safe for the same scanner.
+   */
+  template <class N>
+  bool DataFile<N>::ReadBatch(FileScanner& scanner,
+                              const std::vector<FileOffset>& offsets,
+                              std::vector<ValueType>& data) const
+  {
+    // Maximum gap between two offsets that is still read as part of the same range
+    static const FileOffset maxRangeGap=64*1024;
+    // Maximum size of a range, unless a single object is larger
+    static const FileOffset maxRangeSize=1024*1024;
+    // Bytes read after the last offset of a range, for the object at this offset
+    static const FileOffset rangeTail=16*1024;
+    // Objects are not expected to be larger, a failing read from a larger range is an error
+    static const FileOffset maxObjectSize=64*1024*1024;
+
+    std::vector<size_t> order(offsets.size());
+
+    for (size_t i=0; i<order.size(); i++) {
+      order[i]=i;
+    }
+
+    std::sort(order.begin(),
+              order.end(),
+              [&offsets](size_t a, size_t b) {
+                return offsets[a]<offsets[b];
+              });
+
+    data.assign(offsets.size(),
+                nullptr);
+
+    if (scanner.IsMemoryMapped()) {
+      for (size_t index : order) {
+        ValueType value=std::make_shared<N>();
+
+        if (!ReadData(scanner,
+                      offsets[index],
+                      *value)) {
+          log.Error() << "Error while reading data from offset " << offsets[index] << " of file " << datafilename << "!";
+          return false;
+        }
+
+        data[index]=value;
+      }
+
+      return true;
+    }
+
+    size_t pos=0;
+
+    try {
+      while (pos<order.size()) {
+        FileOffset rangeStart=offsets[order[pos]];
+        size_t     rangeEndPos=pos+1;
+
+        while (rangeEndPos<order.size() &&
+               offsets[order[rangeEndPos]]-offsets[order[rangeEndPos-1]]<=maxRangeGap &&
+               offsets[order[rangeEndPos]]-rangeStart<=maxRangeSize) {
+          rangeEndPos++;
+        }
+
+        FileOffset rangeSize=offsets[order[rangeEndPos-1]]-rangeStart+rangeTail;
+        FileOffset rangeEnd=rangeStart+scanner.Prefetch(rangeStart,
+                                                        (size_t)rangeSize);
+        bool       atFileEnd=rangeEnd<rangeStart+rangeSize;
+
+        for (; pos<rangeEndPos; pos++) {
+          FileOffset offset=offsets[order[pos]];
+
+          while (true) {
+            ValueType value=std::make_shared<N>();
+
+            try {
+              scanner.SetPos(offset);
+
+              value->Read(*typeConfig,
+                          scanner);
+
+              data[order[pos]]=value;
+              break;
+            }
+            catch (IOException& e) {
+              // Either a real error or the object exceeds the prefetched range
+              if (!scanner.IsPrefetched() ||
+                  atFileEnd ||
+                  rangeEnd-offset>=maxObjectSize) {
+                throw;
+              }
+
+              rangeSize=std::max(2*(rangeEnd-offset),
+                                 rangeTail);
+              rangeEnd=offset+scanner.Prefetch(offset,
+                                               (size_t)rangeSize);
+              atFileEnd=rangeEnd<offset+rangeSize;
+            }
+          }
+        }
+      }
+
+      scanner.ClearPrefetch();
+    }
+    catch (IOException& e) {
+      log.Error() << e.GetDescription();
+      return false;
+    }
+
+    return true;
+  }
+
+  /**
+   * Return the value for the given offset from the cache.
+   *
+   * Method is thread-safe.
+   */
+  template <class N>
+  bool DataFile<N>::GetFromCache(FileOffset offset,
+                                 ValueType& value) const
+  {
+    return cache.GetEntry(offset,value);
+  }
+
+  /**
+   * Store the value for the given offset in the cache.
+   *
+   * Method is thread-safe.
+   */
+  template <class N>
+  void DataFile<N>::AddToCache(FileOffset offset,
+                               const ValueType& value) const
+  {
+    cache.SetEntry(offset,value);
+  }
+
+  /**
+   * Read all data values of the given span, using the cache where possible.
+   *
+   * Method is NOT thread-safe for the same scanner.
+   */
+  template <class N>
+  bool DataFile<N>::ReadSpan(FileScanner& scanner,
+                             const DataBlockSpan& span,
+                             std::vector<ValueType>& data) const
+  {
+    try {
+      bool       offsetSetup=false;
+      FileOffset offset=span.startOffset;
+
+      for (uint32_t i=1; i<=span.count; i++) {
+        ValueType value;
+
+        if (GetFromCache(offset,value)) {
+          data.push_back(value);
+          offset=value->GetNextFileOffset();
+          offsetSetup=false;
+        }
+        else {
+          if (!offsetSetup) {
+            scanner.SetPos(offset);
+          }
+
+          value=std::make_shared<N>();
+
+          if (!ReadData(scanner,
+                        *value)) {
+            log.Error() << "Error while reading data #" << i << " starting from offset " << span.startOffset << " of file " << datafilename << "!";
+            return false;
+          }
+
+          AddToCache(offset,value);
+          offset=value->GetNextFileOffset();
+          offsetSetup=true;
+          data.push_back(value);
+        }
+      }
+    }
+    catch (IOException& e) {
+      log.Error() << e.GetDescription();
+      return false;
+    }
+
+    return true;
+  }
+
   /**
    * Open the index file.
    *
@@ -218,13 +492,13 @@ namespace osmscout {
     datafilename=AppendFileToDir(path,datafile);
 
     try {
-      scanner.Open(datafilename,
-                   FileScanner::LowMemRandom,
-                   memoryMappedData);
+      scannerPool.Open(datafilename,
+                       FileScanner::LowMemRandom,
+                       memoryMappedData);
     }
     catch (IOException& e) {
       log.Error() << e.GetDescription();
-      scanner.CloseFailsafe();
+      scannerPool.CloseFailsafe();
       return false;
     }
 
@@ -239,7 +513,7 @@ namespace osmscout {
   template <class N>
   bool DataFile<N>::IsOpen() const
   {
-    return scanner.IsOpen();
+    return scannerPool.IsOpen();
   }
 
   /**
@@ -251,34 +525,131 @@ namespace osmscout {
   bool DataFile<N>::Close()
   {
     typeConfig=nullptr;
-    cache.Flush();
+    DetachMemoryGovernor();
+    FlushCache();
 
     try  {
-      if (scanner.IsOpen()) {
-        scanner.Close();
+      if (scannerPool.IsOpen()) {
+        scannerPool.Close();
       }
     }
     catch (IOException& e) {
       log.Error() << e.GetDescription();
-      scanner.CloseFailsafe();
+      scannerPool.CloseFailsafe();
       return false;
     }
 
     return true;
   }
 
+  /**
+   * Remove all objects from the cache.
+   *
+   * Method is thread-safe.
+   */
   template <class N>
   void DataFile<N>::FlushCache()
   {
-    std::lock_guard<std::mutex> lock(accessMutex);
     cache.Flush();
   }
 
+  /**
+   * Limit the cache by the given memory budget (in bytes) instead of
+   * by the number of objects. The cache is flushed.
+   *
+   * Method is thread-safe.
+   */
+  template <class N>
+  void DataFile<N>::SetCacheMemory(size_t maxMemory)
+  {
+    cache.SetMaxMemory(maxMemory,
+                       std::make_shared<DataFileValueSizer>(*this));
+  }
+
+  /**
+   * Let the given governor control the memory budget of the cache. The
+   * cache is flushed. The weight defines the initial share of the overall
+   * budget (see MemoryGovernor::Register()). The cache is unregistered on
+   * Close().
+   *
+   * Method is NOT thread-safe.
+   */
+  template <class N>
+  void DataFile<N>::SetMemoryGovernor(const MemoryGovernorRef& governor,
+                                      double weight)
+  {
+    DetachMemoryGovernor();
+
+    cache.SetMaxMemory(0,
+                       std::make_shared<DataFileValueSizer>(*this));
+
+    memoryGovernor=governor;
+    memoryGovernor->Register(cache,
+                             datafile,
+                             weight);
+  }
+
+  template <class N>
+  void DataFile<N>::DetachMemoryGovernor()
+  {
+    if (memoryGovernor) {
+      memoryGovernor->Unregister(cache);
+      memoryGovernor=nullptr;
+    }
+  }
+
+  /**
+   * Return true, if the data file is memory mapped and thus objects
+   * can be read as views (see GetViewsByOffset()).
+   *
+   * Method is thread-safe.
+   */
+  template <class N>
+  bool DataFile<N>::IsMemoryMapped() const
+  {
+    try {
+      return scannerPool.IsMemoryMapped();
+    }
+    catch (IOException& e) {
+      log.Error() << e.GetDescription();
+      return false;
+    }
+  }
+
+  /**
+   * Fault in all pages of the data file, if it is memory mapped.
+   *
+   * Method is thread-safe.
+   */
+  template <class N>
+  bool DataFile<N>::Prefault() const
+  {
+    try {
+      scannerPool.Prefault();
+    }
+    catch (IOException& e) {
+      log.Error() << e.GetDescription();
+      return false;
+    }
+
+    return true;
+  }
+
+  template <class N>
+  void DataFile<N>::DumpStatistics() const
+  {
+    cache.DumpStatistics(datafile.c_str());
+  }
+
   /**
    * Reads data for the given file offsets. File offsets are passed by iterator over
    * some container. the size parameter hints as the number of entries returned by the iterators
    * and is used to preallocate enough room in the result vector.
    *
+   * Cache lookups are done for the whole batch first. Only the missing entries
+   * are then read from the file, without holding any lock, so concurrent
+   * calls do not block each other while decoding.
+   *
    * @tparam N
    *    Object type managed by the data file
    * @tparam IteratorIn
@@ -307,32 +678,58 @@ namespace osmscout {
       return true;
     }
 
+    size_t                  firstIndex=data.size();
+    std::vector<FileOffset> missingOffsets;
+    std::vector<size_t>     missingIndexes;
+
     data.reserve(data.size()+size);
-    std::lock_guard<std::mutex> lock(accessMutex);
 
-    if (cache.GetMaxSize()>0 &&
+    if (!cache.HasMemoryBudget() &&
+        cache.GetMaxSize()>0 &&
         size>cache.GetMaxSize()){
       log.Warn() << "Cache size (" << cache.GetMaxSize() << ") for file " << datafile << " is smaller than current request (" << size << ")";
     }
 
     for (IteratorIn offsetIter=begin; offsetIter!=end; ++offsetIter) {
-      ValueCacheRef entryRef;
+      ValueType value;
 
-      if (cache.GetEntry(*offsetIter,entryRef)) {
-        data.push_back(entryRef->value);
+      if (cache.GetEntry(*offsetIter,value)) {
+        data.push_back(value);
       }
       else {
-        ValueType value=std::make_shared<N>();
+        missingOffsets.push_back(*offsetIter);
+        missingIndexes.push_back(data.size());
+        data.push_back(nullptr);
+      }
+    }
 
-        if (!ReadData(*offsetIter,
-                      *value)) {
-          log.Error() << "Error while reading data from offset " << *offsetIter << " of file " << datafilename << "!";
-          return false;
-        }
+    if (missingOffsets.empty()) {
+      return true;
+    }
 
-        cache.SetEntry(ValueCacheEntry(*offsetIter,value));
-        data.push_back(value);
+    try {
+      FileScannerPool::Lease scanner=scannerPool.Acquire();
+      std::vector<ValueType> values;
+
+      if (!ReadBatch(*scanner,
+                     missingOffsets,
+                     values)) {
+        data.resize(firstIndex);
+        return false;
       }
+
+      for (size_t i=0; i<missingOffsets.size(); i++) {
+        data[missingIndexes[i]]=values[i];
+      }
+    }
+    catch (IOException& e) {
+      log.Error() << e.GetDescription();
+      data.resize(firstIndex);
+      return false;
+    }
+
+    for (size_t i=0; i<missingOffsets.size(); i++) {
+      cache.SetEntry(missingOffsets[i],data[missingIndexes[i]]);
     }
 
     return true;
@@ -354,33 +751,21 @@ namespace osmscout {
       return true;
     }
 
-    data.reserve(data.size()+size);
-    std::lock_guard<std::mutex> lock(accessMutex);
+    std::vector<ValueType> values;
 
-    if (cache.GetMaxSize()>0 &&
-        size>cache.GetMaxSize()){
-      log.Warn() << "Cache size (" << cache.GetMaxSize() << ") for file " << datafile << " is smaller than current request (" << size << ")";
+    if (!GetByOffset(begin,
+                     end,
+                     size,
+                     values)) {
+      return false;
     }
 
+    data.reserve(data.size()+values.size());
+
     //std::map<std::string,size_t> hitRateTypes;
     //std::map<std::string,size_t> missRateTypes;
     size_t inBoxCount=0;
-    for (IteratorIn offsetIter=begin; offsetIter!=end; ++offsetIter) {
-      ValueType value=std::make_shared<N>();
-
-      ValueCacheRef entryRef;
-      if (cache.GetEntry(*offsetIter,entryRef)){
-        value=entryRef->value;
-      }else{
-        if (!ReadData(*offsetIter,
-                      *value)) {
-          log.Error() << "Error while reading data from offset " << *offsetIter << " of file " << datafilename << "!";
-          return false;
-        }
-
-        cache.SetEntry(ValueCacheEntry(*offsetIter,value));
-      }
-
+    for (const auto& value : values) {
       if (!value->Intersects(boundingBox)) {
         //missRateTypes[value->GetType()->GetName()]++;
         continue;
@@ -449,24 +834,29 @@ namespace osmscout {
   bool DataFile<N>::GetByOffset(FileOffset offset,
                                 ValueType& entry) const
   {
-    std::lock_guard<std::mutex> lock(accessMutex);
+    if (GetFromCache(offset,entry)) {
+      return true;
+    }
 
-    ValueCacheRef entryRef;
-    if (cache.GetEntry(offset,entryRef)){
-      entry=entryRef->value;
-    }else{
-      ValueType value=std::make_shared<N>();
+    ValueType value=std::make_shared<N>();
 
-      if (!ReadData(offset,
+    try {
+      FileScannerPool::Lease scanner=scannerPool.Acquire();
+
+      if (!ReadData(*scanner,
+                    offset,
                     *value)) {
         log.Error() << "Error while reading data from offset " << offset << " of file " << datafilename << "!";
-        // TODO: Remove broken entry from cache
         return false;
       }
-
-      cache.SetEntry(ValueCacheEntry(offset,value));
-      entry=value;
     }
+    catch (IOException& e) {
+      log.Error() << e.GetDescription();
+      return false;
+    }
+
+    AddToCache(offset,value);
+    entry=value;
 
     return true;
   }
@@ -484,40 +874,14 @@ namespace osmscout {
       return true;
     }
 
-    std::lock_guard<std::mutex> lock(accessMutex);
+    data.reserve(data.size()+span.count);
 
     try {
-      bool offsetSetup=false;
-      FileOffset offset=span.startOffset;
-
-      data.reserve(data.size()+span.count);
-
-      for (uint32_t i=1; i<=span.count; i++) {
-        ValueCacheRef entryRef;
-        if (cache.GetEntry(offset,entryRef)){
-          data.push_back(entryRef->value);
-          offset=entryRef->value->GetNextFileOffset();
-          offsetSetup=false;
-        }else{
-          if (!offsetSetup){
-            scanner.SetPos(offset);
-          }
-
-          ValueType value=std::make_shared<N>();
-
-          if (!ReadData(*value)) {
-            log.Error() << "Error while reading data #" << i << " starting from offset " << span.startOffset << " of file " << datafilename << "!";
-            return false;
-          }
-
-          cache.SetEntry(ValueCacheEntry(offset,value));
-          offset=value->GetNextFileOffset();
-          offsetSetup=true;
-          data.push_back(value);
-        }
-      }
+      FileScannerPool::Lease scanner=scannerPool.Acquire();
 
-      return true;
+      return ReadSpan(*scanner,
+                      span,
+                      data);
     }
     catch (IOException& e) {
       log.Error() << e.GetDescription();
@@ -541,42 +905,24 @@ namespace osmscout {
       overallCount+=spanIter->count;
     }
 
+    if (overallCount==0) {
+      return true;
+    }
+
     data.reserve(data.size()+overallCount);
 
     try {
-      std::lock_guard<std::mutex> lock(accessMutex);
+      FileScannerPool::Lease scanner=scannerPool.Acquire();
+
       for (IteratorIn spanIter=begin; spanIter!=end; ++spanIter) {
         if (spanIter->count==0) {
           continue;
         }
 
-        bool offsetSetup=false;
-        FileOffset offset=spanIter->startOffset;
-
-        for (uint32_t i=1; i<=spanIter->count; i++) {
-          ValueCacheRef entryRef;
-          if (cache.GetEntry(offset,entryRef)){
-            data.push_back(entryRef->value);
-            offset=entryRef->value->GetNextFileOffset();
-            offsetSetup=false;
-          }else{
-            if (!offsetSetup){
-              scanner.SetPos(offset);
-            }
-
-            ValueType value=std::make_shared<N>();
-
-            if (!ReadData(*value)) {
-              log.Error() << "Error while reading data #" << i << " starting from offset " << spanIter->startOffset <<
-              " of file " << datafilename << "!";
-              return false;
-            }
-
-            cache.SetEntry(ValueCacheEntry(offset,value));
-            offset=value->GetNextFileOffset();
-            offsetSetup=true;
-            data.push_back(value);
-          }
+        if (!ReadSpan(*scanner,
+                      *spanIter,
+                      data)) {
+          return false;
         }
       }
     }
@@ -808,6 +1154,67 @@ namespace osmscout {
 
     return DataFile<N>::GetByOffset(offset,entry);
   }
+  /**
+   * Read the objects at the given file offsets as views (for example WayView)
+   * instead of as fully decoded objects. Views reference the memory mapped file
+   * directly, so the data file must be memory mapped (see IsMemoryMapped()).
+   * Views are valid as long as the data file is not closed.
+   *
+   * The cache is neither consulted nor filled, since decoding a view is cheap.
+   *
+   * @tparam V
+   *    View type, must offer Read(const TypeConfig&, FileScanner&)
+   * @param begin
+   *    Start iterator for the file offset
+   * @param end
+   *    End iterator for the file offset
+   * @param size
+   *    Number of entries returned by the begin, end iterator pair
+   * @param data
+   *    vector containing the views. Data is appended.
+   * @return
+   *    false if there was an error or the file is not memory mapped, else true
+   *
+   * Method is thread-safe.
+   */
+  template <class N>
+  template <typename V, typename IteratorIn>
+  bool DataFile<N>::GetViewsByOffset(IteratorIn begin, IteratorIn end,
+                                     size_t size,
+                                     std::vector<V>& data) const
+  {
+    if (size==0) {
+      return true;
+    }
+
+    size_t firstIndex=data.size();
+
+    try {
+      FileScannerPool::Lease scanner=scannerPool.Acquire();
+
+      if (!scanner->IsMemoryMapped()) {
+        log.Error() << "Cannot read views from file " << datafilename << ", file is not memory mapped";
+        return false;
+      }
+
+      data.reserve(firstIndex+size);
+
+      for (IteratorIn offsetIter=begin; offsetIter!=end; ++offsetIter) {
+        scanner->SetPos(*offsetIter);
+
+        data.emplace_back();
+        data.back().Read(*typeConfig,
+                         *scanner);
+      }
+    }
+    catch (IOException& e) {
+      log.Error() << e.GetDescription();
+      data.resize(firstIndex);
+      return false;
+    }
+
+    return true;
+  }
 }
 
 #endif
@@ -20,6 +20,7 @@
   Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307  USA
 */
 
+#include <future>
 #include <list>
 #include <memory>
 #include <mutex>
@@ -57,6 +58,7 @@
 #include <osmscout/routing/RouteDescription.h>
 
 #include <osmscout/util/GeoBox.h>
+#include <osmscout/util/MemoryGovernor.h>
 
 #include <osmscout/system/Compiler.h>
 
@@ -75,17 +77,26 @@ namespace osmscout {
 
     The following attributes are currently available:
     * cache sizes.
+    * an overall cache memory budget.
+    * memory mapping of data files.
+    * hugepage advice, prefaulting and NUMA interleaving of memory mapped hot files.
+    * preloading of the area area index.
+    * a memory governor, possibly shared between databases.
     */
   class OSMSCOUT_API DatabaseParameter CLASS_FINAL
   {
   private:
     unsigned long areaAreaIndexCacheSize=5000;
+    bool          areaAreaIndexPreload=false; //!< Load the complete area area index into memory
 
     unsigned long nodeDataCacheSize=5000;
     unsigned long wayDataCacheSize=40000;
     unsigned long areaDataCacheSize=5000;
     unsigned long routeDataCacheSize=1500;
 
+    size_t cacheMemory=0; //!< Overall memory budget of the caches in bytes, 0 means limit by cache sizes
+    MemoryGovernorRef memoryGovernor; //!< Governor controlling the cache memory, overrides cacheMemory
+
     bool routerDataMMap=true;
     bool nodesDataMMap=true;
     bool areasDataMMap=true;
@@ -93,14 +104,21 @@ namespace osmscout {
     bool routesDataMMap=true;
     bool optimizeLowZoomMMap=true;
     bool indexMMap=true;
+
+    bool hugePageMMap=false;   //!< Advise hugepages for memory mapped hot files
+    bool prefaultMMap=false;   //!< Prefault memory mapped hot files on Database::Open()
+    bool interleaveMMap=false; //!< Interleave prefaulted hot files across NUMA nodes
   public:
     DatabaseParameter() = default;
 
     void SetAreaAreaIndexCacheSize(unsigned long areaAreaIndexCacheSize);
+    void SetAreaAreaIndexPreload(bool preload);
     void SetNodeDataCacheSize(unsigned long  size);
     void SetWayDataCacheSize(unsigned long  size);
     void SetAreaDataCacheSize(unsigned long  size);
     void SetRouteDataCacheSize(unsigned long  size);
+    void SetCacheMemory(size_t bytes);
+    void SetMemoryGovernor(const MemoryGovernorRef& governor);
 
     void SetRouterDataMMap(bool mmap);
     void SetNodesDataMMap(bool mmap);
@@ -110,11 +128,19 @@ namespace osmscout {
     void SetOptimizeLowZoomMMap(bool mmap);
     void SetIndexMMap(bool mmap);
 
+    void SetHugePageMMap(bool hugePages);
+    void SetPrefaultMMap(bool prefault);
+    void SetInterleaveMMap(bool interleave);
+
     unsigned long GetAreaAreaIndexCacheSize() const;
+    bool GetAreaAreaIndexPreload() const;
     unsigned long GetNodeDataCacheSize() const;
     unsigned long GetWayDataCacheSize() const;
     unsigned long GetRouteDataCacheSize() const;
     unsigned long GetAreaDataCacheSize() const;
+    size_t GetCacheMemory() const;
+    size_t GetCacheMemoryShare(unsigned long cacheSize) const;
+    MemoryGovernorRef GetMemoryGovernor() const;
 
     bool GetRouterDataMMap() const;
     bool GetNodesDataMMap() const;
@@ -123,6 +149,41 @@ namespace osmscout {
     bool GetRoutesDataMMap() const;
     bool GetOptimizeLowZoomMMap() const;
     bool GetIndexMMap() const;
+
+    bool GetHugePageMMap() const;
+    bool GetPrefaultMMap() const;
+    bool GetInterleaveMMap() const;
+    uint8_t GetHotFileMMapAdvice() const;
+  };
+
+  /**
+    Parameter for Database::Warmup() and Database::OpenAsync().
+
+    The following attributes are currently available:
+    * the number of threads used for opening files in parallel.
+    * if data files and/or indexes are opened.
+    * prefaulting of memory mapped data files and indexes.
+    */
+  class OSMSCOUT_API DatabaseWarmupParameter CLASS_FINAL
+  {
+  private:
+    size_t threadCount;       //!< Number of threads opening files in parallel
+    bool   dataFiles=true;    //!< Open the data files
+    bool   indexes=true;      //!< Open the indexes
+    bool   prefault=false;    //!< Prefault memory mapped data files and area indexes
+
+  public:
+    DatabaseWarmupParameter();
+
+    void SetThreadCount(size_t threadCount);
+    void SetDataFiles(bool dataFiles);
+    void SetIndexes(bool indexes);
+    void SetPrefault(bool prefault);
+
+    size_t GetThreadCount() const;
+    bool GetDataFiles() const;
+    bool GetIndexes() const;
+    bool GetPrefault() const;
   };
 
   class Database;
@@ -284,6 +345,8 @@ namespace osmscout {
 
     TypeConfigRef                   typeConfig;               //!< Type config for the currently opened map
 
+    MemoryGovernorRef               memoryGovernor;           //!< Governor of the cache memory, if there is a memory budget
+
     mutable BoundingBoxDataFileRef  boundingBoxDataFile;      //!< Cached access to the bounding box data file
     mutable std::mutex              boundingBoxDataFileMutex; //!< Mutex to make lazy initialisation of node DataFile thread-safe
 
@@ -324,6 +387,8 @@ namespace osmscout {
     mutable std::mutex              optimizeWaysMutex;        //!< Mutex to make lazy initialisation of optimized ways index thread-safe
 
   private:
+    bool WarmupInternal(const DatabaseWarmupParameter& warmupParameter) const;
+
     template<typename DataFile, typename OffsetsCol, typename DataCol>
     bool GetObjectsByOffset(DataFile dataFile,
                             const OffsetsCol& offsets,
@@ -350,9 +415,13 @@ namespace osmscout {
     virtual ~Database();
 
     bool Open(const std::string& path);
+    std::future<bool> OpenAsync(const std::string& path,
+                                const DatabaseWarmupParameter& warmupParameter);
     bool IsOpen() const;
     void Close();
 
+    std::future<bool> Warmup(const DatabaseWarmupParameter& warmupParameter) const;
+
     std::string GetPath() const;
     TypeConfigRef GetTypeConfig() const;
 
@@ -361,6 +430,15 @@ namespace osmscout {
       return parameter;
     }
 
+    /**
+     * Returns the governor controlling the memory of the caches, or nullptr
+     * if the caches are limited by their cache sizes.
+     */
+    inline MemoryGovernorRef GetMemoryGovernor() const
+    {
+      return memoryGovernor;
+    }
+
     BoundingBoxDataFileRef GetBoundingBoxDataFile() const;
 
     NodeDataFileRef GetNodeDataFile() const;
@@ -23,7 +23,7 @@
 #include <mutex>
 #include <vector>
 
-#include <osmscout/util/Cache.h>
+#include <osmscout/util/ConcurrentCache.h>
 #include <osmscout/util/File.h>
 #include <osmscout/util/FileScanner.h>
 #include <osmscout/util/Logger.h>
@@ -61,7 +61,7 @@ namespace osmscout {
     };
 
     using PageRef         = std::shared_ptr<Page>;
-    using PageCache       = Cache<N, PageRef>;
+    using PageCache       = ConcurrentCache<N, PageRef>;
     using PageSimpleCache = std::unordered_map<N, PageRef>;
 
     /**
@@ -90,7 +90,7 @@ namespace osmscout {
     PageRef                              root;                //!< Reference to the root page
     size_t                               simpleCacheMaxLevel; //!< Maximum level for simple caching
     mutable std::vector<PageSimpleCache> simplePageCache;     //!< Simple map to cache all entries
-    mutable std::vector<PageCache>       pageCaches;          //!< Complex cache with LRU characteristics
+    std::vector<std::unique_ptr<PageCache>> pageCaches;       //!< Complex cache with CLOCK characteristics
 
     mutable std::mutex                   accessMutex;         //!< Mutex to secure multi-thread access
 
@@ -256,7 +256,8 @@ namespace osmscout {
         resultingCacheSize=currentCacheSize;
         currentCacheSize=0;
 
-        pageCaches.push_back(PageCache(resultingCacheSize));
+        // Access is already serialized by accessMutex, so sharding would only waste capacity
+        pageCaches.push_back(std::make_unique<PageCache>(resultingCacheSize,1));
       }
       else {
         resultingCacheSize=pageCounts[level];
@@ -264,7 +265,7 @@ namespace osmscout {
 
         simpleCacheMaxLevel=level;
 
-        pageCaches.push_back(PageCache(0));
+        pageCaches.push_back(std::make_unique<PageCache>(0,1));
       }
     }
   }
@@ -391,17 +392,13 @@ namespace osmscout {
           }
         }
         else {
-          typename PageCache::CacheRef cacheRef;
-
-          if (!pageCaches[level].GetEntry(startId,cacheRef)) {
-            typename PageCache::CacheEntry cacheEntry(startId);
+          if (!pageCaches[level]->GetEntry(startId,pageRef)) {
+            pageRef=nullptr; // Make sure, that we allocate a new page and not reuse an old one
 
-            cacheRef=pageCaches[level].SetEntry(cacheEntry);
+            ReadPage(offset,pageRef);
 
-            ReadPage(offset,cacheRef->value);
+            pageCaches[level]->SetEntry(startId,pageRef);
           }
-
-          pageRef=cacheRef->value;
         }
 
         Page& page=*pageRef;
@@ -470,9 +467,14 @@ namespace osmscout {
     memory+=root->entries.size()*sizeof(Entry);
 
 
-    for (size_t i=0; i<pageCaches.size(); i++) {
-      pages+=pageCaches[i].GetSize();
-      memory+=sizeof(pageCaches[i])+pageCaches[i].GetMemory(NumericIndexCacheValueSizer());
+    for (const auto& pageCache : pageCaches) {
+      size_t cachedPages=pageCache->GetSize();
+
+      pages+=cachedPages;
+      // The cache is limited by page count and thus only knows its own overhead,
+      // pages reserve room for pageSize/4 entries (see ReadPage())
+      memory+=sizeof(PageCache)+pageCache->GetMemory();
+      memory+=cachedPages*(sizeof(PageRef)+sizeof(Page)+sizeof(Entry)*(pageSize/4));
     }
 
     log.Info() << "Index " << filepart << ": " << pages << " pages, memory " << memory;
@@ -0,0 +1,227 @@
+#ifndef OSMSCOUT_POINTSEQUENCEVIEW_H
+#define OSMSCOUT_POINTSEQUENCEVIEW_H
+
+/*
+  This source is part of the libosmscout library
+  Copyright (C) 2026  Tim Teulings
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307  USA
+*/
+
+#include <cstdint>
+#include <iterator>
+
+#include <osmscout/CoreImportExport.h>
+
+#include <osmscout/GeoCoord.h>
+
+#include <osmscout/util/GeoBox.h>
+
+#include <osmscout/system/Compiler.h>
+
+namespace osmscout {
+
+  /**
+   * \ingroup Geometry
+   *
+   * Read-only view of a delta encoded coordinate sequence as stored in the
+   * data files (see FileWriter::Write(const std::vector<Point>&,bool)).
+   *
+   * The view does not copy or decode the coordinates in advance, it
+   * points into the memory mapped file and decodes the coordinates while
+   * iterating. As a result it is only valid as long as the file it was
+   * read from stays open.
+   *
+   * In contrast to std::vector<Point> node serials are not available, the
+   * view only knows if there is at least one node with an id.
+   */
+  class OSMSCOUT_API PointSequenceView CLASS_FINAL
+  {
+  public:
+    /**
+     * Forward iterator decoding one coordinate per step
+     */
+    class OSMSCOUT_API const_iterator CLASS_FINAL
+    {
+    public:
+      using iterator_category = std::forward_iterator_tag;
+      using value_type        = GeoCoord;
+      using difference_type   = std::ptrdiff_t;
+      using pointer           = const GeoCoord*;
+      using reference         = const GeoCoord&;
+
+    private:
+      const PointSequenceView *view=nullptr;
+      const uint8_t           *data=nullptr; //!< Position of the next delta
+      size_t                  index=0;       //!< Index of the current coordinate
+      uint32_t                lat=0;         //!< Current raw latitude
+      uint32_t                lon=0;         //!< Current raw longitude
+      GeoCoord                coord;         //!< Current coordinate
+
+    private:
+      inline void Decode()
+      {
+        coord.Set(lat/latConversionFactor-90.0,
+                  lon/lonConversionFactor-180.0);
+      }
+
+    public:
+      const_iterator() = default;
+
+      const_iterator(const PointSequenceView* view,
+                     size_t index)
+      : view(view),
+        data(view->deltaData),
+        index(index),
+        lat(view->firstLat),
+        lon(view->firstLon)
+      {
+        if (index<view->nodeCount) {
+          Decode();
+        }
+      }
+
+      inline reference operator*() const
+      {
+        return coord;
+      }
+
+      inline pointer operator->() const
+      {
+        return &coord;
+      }
+
+      inline const_iterator& operator++()
+      {
+        index++;
+
+        if (index>=view->nodeCount) {
+          return *this;
+        }
+
+        int32_t latDelta;
+        int32_t lonDelta;
+
+        if (view->deltaBytes==2) {
+          latDelta=(int8_t)data[0];
+          lonDelta=(int8_t)data[1];
+        }
+        else if (view->deltaBytes==4) {
+          latDelta=(int16_t)(uint16_t)(data[0] | (data[1] << 8));
+          lonDelta=(int16_t)(uint16_t)(data[2] | (data[3] << 8));
+        }
+        else {
+          uint32_t latUDelta=data[0] | (data[1] << 8) | (data[2] << 16);
+          uint32_t lonUDelta=data[3] | (data[4] << 8) | (data[5] << 16);
+
+          latDelta=(int32_t)((latUDelta & 0x800000) ? (latUDelta | 0xff000000) : latUDelta);
+          lonDelta=(int32_t)((lonUDelta & 0x800000) ? (lonUDelta | 0xff000000) : lonUDelta);
+        }
+
+        data+=view->deltaBytes;
+        lat+=latDelta;
+        lon+=lonDelta;
+
+        Decode();
+
+        return *this;
+      }
+
+      inline const_iterator operator++(int)
+      {
+        const_iterator result=*this;
+
+        ++(*this);
+
+        return result;
+      }
+
+      inline size_t GetIndex() const
+      {
+        return index;
+      }
+
+      inline bool operator==(const const_iterator& other) const
+      {
+        return index==other.index;
+      }
+
+      inline bool operator!=(const const_iterator& other) const
+      {
+        return index!=other.index;
+      }
+    };
+
+  private:
+    const uint8_t *deltaData=nullptr; //!< Start of the coordinate deltas in the mapped file
+    size_t        nodeCount=0;        //!< Number of coordinates
+    uint8_t       deltaBytes=0;       //!< Number of bytes of one lat/lon delta pair (2, 4 or 6)
+    uint32_t      firstLat=0;         //!< Raw latitude of the first coordinate
+    uint32_t      firstLon=0;         //!< Raw longitude of the first coordinate
+    bool          hasNodeWithId=false;//!< At least one node has an id
+
+  public:
+    PointSequenceView() = default;
+
+    PointSequenceView(const uint8_t* deltaData,
+                      size_t nodeCount,
+                      uint8_t deltaBytes,
+                      uint32_t firstLat,
+                      uint32_t firstLon,
+                      bool hasNodeWithId)
+    : deltaData(deltaData),
+      nodeCount(nodeCount),
+      deltaBytes(deltaBytes),
+      firstLat(firstLat),
+      firstLon(firstLon),
+      hasNodeWithId(hasNodeWithId)
+    {
+      // no code
+    }
+
+    inline size_t size() const
+    {
+      return nodeCount;
+    }
+
+    inline bool empty() const
+    {
+      return nodeCount==0;
+    }
+
+    inline const_iterator begin() const
+    {
+      return const_iterator(this,0);
+    }
+
+    inline const_iterator end() const
+    {
+      return const_iterator(this,nodeCount);
+    }
+
+    /**
+     * Returns true, if at least one node of the sequence has an id
+     * (see Point::IsRelevant())
+     */
+    inline bool HasNodeWithId() const
+    {
+      return hasNodeWithId;
+    }
+
+    GeoBox GetBoundingBox() const;
+  };
+}
+
+#endif
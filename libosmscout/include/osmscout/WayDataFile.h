@@ -46,6 +46,9 @@ namespace osmscout {
     WayDataFile& operator=(WayDataFile&&) = delete;
 
     ~WayDataFile() override = default;
+
+  protected:
+    size_t GetValueMemory(const Way& way) const override;
   };
 
   using WayDataFileRef = std::shared_ptr<WayDataFile>;
@@ -0,0 +1,94 @@
+#ifndef OSMSCOUT_WAYVIEW_H
+#define OSMSCOUT_WAYVIEW_H
+
+/*
+  This source is part of the libosmscout library
+  Copyright (C) 2026  Tim Teulings
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307  USA
+*/
+
+#include <osmscout/CoreImportExport.h>
+
+#include <osmscout/ObjectRef.h>
+#include <osmscout/PointSequenceView.h>
+#include <osmscout/TypeConfig.h>
+
+#include <osmscout/util/FileScanner.h>
+
+#include <osmscout/system/Compiler.h>
+
+namespace osmscout {
+
+  /**
+   * \ingroup Geometry
+   *
+   * Read-only, non-owning variant of Way for hot read paths.
+   *
+   * Features are decoded as for Way, but the nodes are not copied into a
+   * std::vector<Point>. Instead a PointSequenceView references the encoded
+   * coordinates in the memory mapped data file. A WayView can thus only be
+   * read from a memory mapped file and is only valid as long as the
+   * file stays open.
+   *
+   * Node serials and segment bounding boxes are not available.
+   */
+  class OSMSCOUT_API WayView CLASS_FINAL
+  {
+  private:
+    FeatureValueBuffer featureValueBuffer; //!< List of features
+    FileOffset         fileOffset=0;       //!< Offset into the data file of this way
+    FileOffset         nextFileOffset=0;   //!< Offset after this way
+    PointSequenceView  nodes;              //!< View of the way nodes
+
+  public:
+    WayView() = default;
+
+    inline FileOffset GetFileOffset() const
+    {
+      return fileOffset;
+    }
+
+    inline FileOffset GetNextFileOffset() const
+    {
+      return nextFileOffset;
+    }
+
+    inline ObjectFileRef GetObjectFileRef() const
+    {
+      return {fileOffset,refWay};
+    }
+
+    inline TypeInfoRef GetType() const
+    {
+      return featureValueBuffer.GetType();
+    }
+
+    inline const FeatureValueBuffer& GetFeatureValueBuffer() const
+    {
+      return featureValueBuffer;
+    }
+
+    inline const PointSequenceView& GetNodes() const
+    {
+      return nodes;
+    }
+
+    void Read(const TypeConfig& typeConfig,
+              FileScanner& scanner);
+  };
+}
+
+#endif
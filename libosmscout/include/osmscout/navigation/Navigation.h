@@ -38,8 +38,8 @@ namespace osmscout {
     virtual ~OutputDescription() = default;
 
     virtual void NextDescription(const Distance& /*distance*/,
-                                 std::list<RouteDescription::Node>::const_iterator& /*node*/,
-                                 std::list<RouteDescription::Node>::const_iterator /*end*/)
+                                 RouteDescription::NodeIterator& /*node*/,
+                                 RouteDescription::NodeIterator /*end*/)
     {};
 
     virtual NodeDescriptionTmpl GetDescription()
@@ -62,7 +62,7 @@ namespace osmscout {
      * The search start a the locationOnRoute node toward the end.
      */
     bool SearchClosestSegment(const GeoCoord& location,
-                              std::list<RouteDescription::Node>::const_iterator& foundNode,
+                              RouteDescription::NodeIterator& foundNode,
                               double& foundAbscissa,
                               double& minDistance)
     {
@@ -132,7 +132,7 @@ namespace osmscout {
       outputDescription->NextDescription(Distance::Of<Meter>(-1.0),
                                          nextWaypoint,
                                          route->Nodes().end());
-      std::list<RouteDescription::Node>::const_iterator lastWaypoint=--(route->Nodes().end());
+      RouteDescription::NodeIterator lastWaypoint=std::prev(route->Nodes().end());
       duration=lastWaypoint->GetTime();
       distance=lastWaypoint->GetDistance();
     }
@@ -223,7 +223,7 @@ namespace osmscout {
       if(route == nullptr){
         return false;
       }
-      std::list<RouteDescription::Node>::const_iterator nextNode = route->Nodes().begin();
+      RouteDescription::NodeIterator nextNode = route->Nodes().begin();
       GeoCoord intersection, foundIntersection;
       double abscissa;
       double minDistance=std::numeric_limits<double>::max();
@@ -249,8 +249,8 @@ namespace osmscout {
 
   private:
     RouteDescription* route;                 // current route description
-    std::list<RouteDescription::Node>::const_iterator locationOnRoute;       // last passed node on the route
-    std::list<RouteDescription::Node>::const_iterator nextWaypoint;          // next node with routing instructions
+    RouteDescription::NodeIterator locationOnRoute;       // last passed node on the route
+    RouteDescription::NodeIterator nextWaypoint;          // next node with routing instructions
     OutputDescription<NodeDescriptionTmpl>            * outputDescription;    // next routing instructions
     Distance                                          distanceFromStart;     // current length from the beginning of the route (in meters)
     Duration                                          durationFromStart;     // current (estimated) duration from the beginning of the route
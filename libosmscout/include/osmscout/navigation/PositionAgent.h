@@ -65,7 +65,7 @@ namespace osmscout {
     struct OSMSCOUT_API Position {
       PositionState state{PositionState::Uninitialised};
       GeoCoord coord;
-      std::list<RouteDescription::Node>::const_iterator routeNode; // last passed node on the route
+      RouteDescription::NodeIterator routeNode; // last passed node on the route
 
       // resolved object
       DatabaseId databaseId;
@@ -86,6 +86,19 @@ namespace osmscout {
 
       PositionMessage(const Timestamp& timestamp, const RouteDescriptionRef &route, const Position &position);
 
+      template<typename Description>
+      std::shared_ptr<Description> GetRouteDescription(RouteDescription::DescriptionSlot slot) const
+      {
+        if (route &&
+            position.routeNode != route->Nodes().cend() &&
+            position.state != PositionAgent::Uninitialised &&
+            position.state != PositionAgent::OffRoute) {
+
+          return position.routeNode->GetDescription<Description>(slot);
+        }
+        return nullptr;
+      }
+
       template<typename Description>
       std::shared_ptr<Description> GetRouteDescription(const char* name) const
       {
@@ -105,6 +118,7 @@ namespace osmscout {
   private:
     GpsPosition gps;
     Timestamp lastUpdate; // last update of agent state
+    Timestamp lastOnRoute; // last time the position was found on the route
     RoutableObjectsRef routableObjects; // routable objects around current position
     RouteDescriptionRef route; // current route description
     osmscout::Vehicle vehicle; // current vehicle
@@ -117,10 +131,13 @@ namespace osmscout {
     std::list<NavigationMessageRef> Process(const NavigationMessageRef& message) override;
 
   private:
+    RouteDescription::NodeIterator GetReachableRouteEnd(const Timestamp& now) const;
+
     bool SearchClosestSegment(const GeoCoord& location,
-                              const std::list<RouteDescription::Node>::const_iterator& locationOnRoute,
+                              const RouteDescription::NodeIterator& locationOnRoute,
+                              const RouteDescription::NodeIterator& searchEnd,
                               GeoCoord &closestPosition,
-                              std::list<RouteDescription::Node>::const_iterator& foundNode,
+                              RouteDescription::NodeIterator& foundNode,
                               double& foundAbscissa,
                               double& minDistance);
   };
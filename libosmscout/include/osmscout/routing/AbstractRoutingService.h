@@ -22,11 +22,14 @@
 */
 
 #include <functional>
+#include <limits>
 #include <list>
 #include <memory>
+#include <optional>
 #include <set>
 #include <unordered_map>
 #include <unordered_set>
+#include <vector>
 
 #include <osmscout/CoreFeatures.h>
 #include <osmscout/TypeConfig.h>
@@ -36,8 +39,11 @@
 #include <osmscout/routing/RouteDescription.h>
 #include <osmscout/routing/RouteData.h>
 #include <osmscout/routing/RouteNode.h>
+#include <osmscout/routing/Isochrone.h>
+#include <osmscout/routing/MapMatching.h>
 #include <osmscout/routing/RoutingService.h>
 #include <osmscout/routing/MultiDBRoutingState.h>
+#include <osmscout/routing/SpeedProfiles.h>
 
 namespace osmscout {
 
@@ -51,13 +57,28 @@ namespace osmscout {
   class OSMSCOUT_API RoutingResult CLASS_FINAL
   {
   private:
-    RouteData route;
-    Distance  currentMaxDistance;
-    Distance  overallDistance;
+    RouteData                route;
+    Distance                 currentMaxDistance;
+    Distance                 overallDistance;
+    std::optional<Timestamp> arrivalTime;
 
   public:
     RoutingResult();
 
+    inline void SetArrivalTime(const Timestamp& arrivalTime)
+    {
+      this->arrivalTime=arrivalTime;
+    }
+
+    /**
+     * Arrival at the target, only set for routes calculated with a departure
+     * time (see RoutingParameter::SetDepartureTime())
+     */
+    inline const std::optional<Timestamp>& GetArrivalTime() const
+    {
+      return arrivalTime;
+    }
+
     inline void SetOverallDistance(const Distance &overallDistance)
     {
       this->overallDistance=overallDistance;
@@ -166,6 +187,131 @@ namespace osmscout {
     }
   };
 
+  /**
+   * \ingroup Routing
+   *
+   * Costs, distance and duration of the route from one source to one target
+   * of a routing matrix
+   */
+  struct OSMSCOUT_API RoutingMatrixEntry
+  {
+    bool     valid=false;                                  //!< A route was found
+    double   cost=std::numeric_limits<double>::infinity(); //!< Costs of the route as defined by the profile
+    Distance distance;                                     //!< Length of the route
+    Duration duration=Duration::zero();                    //!< Travel time of the route, without junction penalties
+  };
+
+  /**
+   * \ingroup Routing
+   *
+   * Result of a routing matrix calculation, holding one RoutingMatrixEntry for
+   * each pair of source and target. Success() is false, if the calculation
+   * failed or was aborted. Pairs without a route have an invalid entry.
+   */
+  class OSMSCOUT_API RoutingMatrixResult CLASS_FINAL
+  {
+  private:
+    bool                            success;
+    size_t                          targetCount;
+    std::vector<RoutingMatrixEntry> entries;
+
+  public:
+    RoutingMatrixResult();
+    RoutingMatrixResult(size_t sourceCount,
+                        size_t targetCount);
+
+    inline bool Success() const
+    {
+      return success;
+    }
+
+    inline void SetSuccess(bool success)
+    {
+      this->success=success;
+    }
+
+    inline size_t GetSourceCount() const
+    {
+      return targetCount==0 ? 0 : entries.size()/targetCount;
+    }
+
+    inline size_t GetTargetCount() const
+    {
+      return targetCount;
+    }
+
+    inline const RoutingMatrixEntry& GetEntry(size_t source,
+                                              size_t target) const
+    {
+      return entries[source*targetCount+target];
+    }
+
+    inline RoutingMatrixEntry& GetEntry(size_t source,
+                                        size_t target)
+    {
+      return entries[source*targetCount+target];
+    }
+  };
+
+  /**
+   * \ingroup Routing
+   *
+   * Parameters for the calculation of alternative routes. All shares are
+   * relative to the costs of the best route.
+   */
+  struct OSMSCOUT_API AlternativeRouteParameter
+  {
+    size_t maxAlternatives=2; //!< Maximum number of alternatives in addition to the best route
+    double maxStretch=0.3;    //!< Maximum additional costs of an alternative
+    double maxOverlap=0.7;    //!< Maximum costs an alternative shares with the best route and better alternatives
+    double minPlateau=0.1;    //!< Minimum costs of the part of an alternative, that is part of both search trees
+  };
+
+  /**
+   * \ingroup Routing
+   *
+   * Result of the calculation of alternative routes. The first route is the
+   * best route, the alternatives follow ordered by their quality. Each route
+   * can be passed on to the RoutePostprocessor like the route of a RoutingResult.
+   */
+  class OSMSCOUT_API AlternativeRoutingResult CLASS_FINAL
+  {
+  private:
+    std::vector<RouteData> routes;
+    std::vector<double>    costs;
+
+  public:
+    inline bool Success() const
+    {
+      return !routes.empty();
+    }
+
+    inline const std::vector<RouteData>& GetRoutes() const
+    {
+      return routes;
+    }
+
+    inline std::vector<RouteData>& GetRoutes()
+    {
+      return routes;
+    }
+
+    /**
+     * Costs of each route as defined by the profile
+     */
+    inline const std::vector<double>& GetCosts() const
+    {
+      return costs;
+    }
+
+    inline void AddRoute(RouteData&& route,
+                         double cost)
+    {
+      routes.push_back(std::move(route));
+      costs.push_back(cost);
+    }
+  };
+
   /**
    * \ingroup Routing
    *
@@ -176,10 +322,13 @@ namespace osmscout {
   {
   protected:
     bool debugPerformance;
+    bool inMemoryGraph;    //!< Load the complete routing graph into memory on Open()
 
   protected:
     virtual Vehicle GetVehicle(const RoutingState& state) = 0;
 
+    virtual bool HasTimeCosts(const RoutingState& state) = 0;
+
     virtual bool CanUse(const RoutingState& state,
                         DatabaseId database,
                         const RouteNode& routeNode,
@@ -204,6 +353,21 @@ namespace osmscout {
                             const WayRef &way,
                             const Distance &wayLength) = 0;
 
+    virtual Duration GetTime(const RoutingState& state,
+                             DatabaseId database,
+                             const RouteNode& routeNode,
+                             size_t pathIndex) = 0;
+
+    virtual Duration GetTime(const RoutingState& state,
+                             DatabaseId database,
+                             const WayRef &way,
+                             const Distance &wayLength) = 0;
+
+    /**
+     * Return the speed profiles of the given database or nullptr, if there are none
+     */
+    virtual const SpeedProfiles* GetSpeedProfiles(DatabaseId database) = 0;
+
     virtual double GetEstimateCosts(const RoutingState& state,
                                     DatabaseId database,
                                     const Distance &targetDistance) = 0;
@@ -231,6 +395,15 @@ namespace osmscout {
     virtual bool GetRouteNode(const DBId &id,
                               RouteNodeRef &node) = 0;
 
+    /**
+     * Append the route nodes, that have a path to the given route node, for
+     * which the given route node has no path back using the same object
+     * (e.g. the previous route node on a oneway way), together with the
+     * object of the path
+     */
+    virtual bool GetRouteNodePredecessors(const DBId &id,
+                                          std::vector<std::pair<Id,ObjectFileRef>> &sources) = 0;
+
     virtual bool GetWayByOffset(const DBFileOffset &offset,
                                 WayRef &way) = 0;
 
@@ -283,6 +456,7 @@ namespace osmscout {
                        const GeoCoord& targetCoord,
                        RouteNodeRef& forwardRouteNode,
                        RouteNodeRef& backwardRouteNode,
+                       RNodePool& pool,
                        RNodeRef& forwardRNode,
                        RNodeRef& backwardRNode);
 
@@ -305,6 +479,7 @@ namespace osmscout {
                   const RouteNodeRef& routeNode,
                   const GeoCoord& startCoord,
                   const GeoCoord& targetCoord,
+                  RNodePool& pool,
                   RNodeRef& node);
 
     void AddNodes(RouteData& route,
@@ -322,6 +497,7 @@ namespace osmscout {
                           const GeoCoord& targetCoord,
                           RouteNodeRef& forwardRouteNode,
                           RouteNodeRef& backwardRouteNode,
+                          RNodePool& pool,
                           RNodeRef& forwardRNode,
                           RNodeRef& backwardRNode);
 
@@ -331,9 +507,12 @@ namespace osmscout {
                                   const RoutePosition& target,
                                   RouteData& route);
 
+    bool IsRouteAllowed(const std::list<VNode>& nodes);
+
     virtual bool WalkToOtherDatabases(const RoutingState& state,
                                       RNodeRef &current,
                                       RouteNodeRef &currentRouteNode,
+                                      RNodePool &pool,
                                       OpenList &openList,
                                       OpenMap &openMap,
                                       const ClosedSet &closedSet,
@@ -342,6 +521,7 @@ namespace osmscout {
     virtual bool WalkPaths(const RoutingState& state,
                            RNodeRef &current,
                            RouteNodeRef &currentRouteNode,
+                           RNodePool &pool,
                            OpenList &openList,
                            OpenMap &openMap,
                            ClosedSet &closedSet,
@@ -354,14 +534,151 @@ namespace osmscout {
                            Distance &currentMaxDistance,
                            const Distance &overallDistance,
                            const double &costLimit);
+
+    /**
+     * Label of the bidirectional search: the access state of the predecessor,
+     * which identifies the label of the predecessor
+     */
+    struct BidirectionalLabel
+    {
+      bool prevAccess=false;
+    };
+
+    void CalculateRoutesBidirectional(RoutingState& state,
+                                      const RoutePosition& start,
+                                      const RoutePosition& target,
+                                      const RoutingParameter& parameter,
+                                      const AlternativeRouteParameter& alternativeParameter,
+                                      RoutingResult& result,
+                                      AlternativeRoutingResult& routes);
+
+    RoutingResult CalculateRouteBidirectional(RoutingState& state,
+                                              const RoutePosition& start,
+                                              const RoutePosition& target,
+                                              const RoutingParameter& parameter);
+
+    /**
+     * Route node next to a target of a routing matrix and the rest of the
+     * way from the route node to the target
+     */
+    struct MatrixTargetNode
+    {
+      size_t   target;   //!< Index of the target
+      double   cost;     //!< Costs from the route node to the target
+      Distance distance; //!< Distance from the route node to the target
+      Duration duration; //!< Time from the route node to the target
+    };
+
+    using MatrixTargetNodeMap = std::unordered_map<DBId,std::vector<MatrixTargetNode>>;
+
+    void GetMatrixTargetNodes(const RoutingState& state,
+                              const std::vector<RoutePosition>& targets,
+                              std::vector<GeoCoord>& targetCoords,
+                              MatrixTargetNodeMap& targetNodes);
+
+    /**
+     * Distance and time up to an RNode of SearchOneToMany()
+     */
+    struct OneToManyLabel
+    {
+      Distance distance;
+      Duration time=Duration::zero();
+    };
+
+    using OneToManyLabels = RNodeLabels<OneToManyLabel>;
+
+    /**
+     * Called for each route node settled by SearchOneToMany(), the search
+     * stops if false is returned
+     */
+    using SettledNodeCallback = std::function<bool (const RNode& node)>;
+
+    /**
+     * Optionally replaces GetCosts() and GetTime() in SearchOneToMany(). Returns
+     * the costs of leaving the route node of the given label via the path
+     * outPathIndex and the time for the path in time.
+     */
+    using PathCostCallback = std::function<double (const RNode& current,
+                                                   const RouteNode& routeNode,
+                                                   size_t inPathIndex,
+                                                   size_t outPathIndex,
+                                                   Duration& time)>;
+
+    bool GetOneToManyStartNodes(const RoutingState& state,
+                                const RoutePosition& source,
+                                RNodePool& pool,
+                                OneToManyLabels& labels,
+                                GeoCoord& startCoord,
+                                std::vector<RNodeRef>& startNodes);
+
+    bool SearchOneToMany(const RoutingState& state,
+                         RNodePool& pool,
+                         OneToManyLabels& labels,
+                         const std::vector<RNodeRef>& startNodes,
+                         double costLimit,
+                         const RoutingParameter& parameter,
+                         const SettledNodeCallback& settled,
+                         const PathCostCallback& pathCosts=nullptr);
+
+    bool CalculateMatrixRow(const RoutingState& state,
+                            const RoutePosition& source,
+                            const std::vector<GeoCoord>& targetCoords,
+                            const MatrixTargetNodeMap& targetNodes,
+                            const RoutingParameter& parameter,
+                            RoutingMatrixResult& result,
+                            size_t row);
+
+    Duration GetTimeDependentTime(DatabaseId database,
+                                  const ObjectFileRef& object,
+                                  const Duration& time,
+                                  const Timestamp& entryTime);
+
+    RoutingResult CalculateRouteTimeDependent(RoutingState& state,
+                                              const RoutePosition& start,
+                                              const RoutePosition& target,
+                                              const RoutingParameter& parameter);
+
+    bool GetMapMatchTransitions(const RoutingState& state,
+                                const std::vector<MapMatchCandidate>& sources,
+                                const std::vector<MapMatchCandidate>& targets,
+                                const Distance& maxDistance,
+                                const RoutingParameter& parameter,
+                                std::vector<std::vector<Distance>>& distances);
+
+    bool GetMapMatchRoutes(RoutingState& state,
+                           const RoutingParameter& parameter,
+                           MapMatchResult& result);
+
+    MapMatchResult MatchTrack(RoutingState& state,
+                              const std::vector<GeoCoord>& points,
+                              const std::vector<std::vector<MapMatchCandidate>>& candidates,
+                              const MapMatchParameter& matchParameter,
+                              const RoutingParameter& parameter);
   public:
     explicit AbstractRoutingService(const RouterParameter& parameter);
     ~AbstractRoutingService() override;
 
-    RoutingResult CalculateRoute(RoutingState& state,
-                                 const RoutePosition& start,
-                                 const RoutePosition& target,
-                                 const RoutingParameter& parameter);
+    virtual RoutingResult CalculateRoute(RoutingState& state,
+                                         const RoutePosition& start,
+                                         const RoutePosition& target,
+                                         const RoutingParameter& parameter);
+
+    virtual AlternativeRoutingResult CalculateAlternativeRoutes(RoutingState& state,
+                                                                const RoutePosition& start,
+                                                                const RoutePosition& target,
+                                                                const RoutingParameter& parameter,
+                                                                const AlternativeRouteParameter& alternativeParameter);
+
+    virtual RoutingMatrixResult CalculateMatrix(RoutingState& state,
+                                                const std::vector<RoutePosition>& sources,
+                                                const std::vector<RoutePosition>& targets,
+                                                const RoutingParameter& parameter);
+
+    virtual IsochroneResult CalculateIsochrone(RoutingState& state,
+                                               const RoutePosition& start,
+                                               const std::vector<double>& costLimits,
+                                               const Distance& cellSize,
+                                               const RoutingParameter& parameter);
 
     RouteDescriptionResult TransformRouteDataToRouteDescription(const RouteData& data);
     RoutePointsResult TransformRouteDataToPoints(const RouteData& data);
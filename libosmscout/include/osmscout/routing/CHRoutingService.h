@@ -0,0 +1,86 @@
+#ifndef OSMSCOUT_CHROUTINGSERVICE_H
+#define OSMSCOUT_CHROUTINGSERVICE_H
+
+/*
+  This source is part of the libosmscout library
+  Copyright (C) 2026  Tim Teulings
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307  USA
+*/
+
+#include <map>
+#include <memory>
+#include <string>
+
+#include <osmscout/CoreImportExport.h>
+
+#include <osmscout/routing/ContractionHierarchy.h>
+#include <osmscout/routing/SimpleRoutingService.h>
+
+#include <osmscout/system/Compiler.h>
+
+namespace osmscout {
+
+  /**
+   * \ingroup Service
+   * \ingroup Routing
+   *
+   * Routing service, that calculates routes using a ContractionHierarchy
+   * of the vehicle of the given routing profile. The hierarchies are loaded
+   * on Open() from the files written by the importer or can be set
+   * explicitly.
+   *
+   * A hierarchy is only used, if the cost parameters of the profile passed
+   * to CalculateRoute() match the ones of the profile used for building the
+   * hierarchy. Junction penalties are not part of the hierarchy. If there is
+   * no matching hierarchy for the vehicle, the hierarchy does not contain
+   * a route (for example because the target is only reachable via access
+   * restricted ways) or the route violates a turn restriction, the A* search
+   * of SimpleRoutingService is used.
+   *
+   * The resulting RouteData can be postprocessed like the result of
+   * SimpleRoutingService.
+   */
+  class OSMSCOUT_API CHRoutingService CLASS_FINAL : public SimpleRoutingService
+  {
+  private:
+    DatabaseRef                                database;     //!< Database object, holding all index and data files
+    std::string                                filenamebase; //!< Common base name for all router files
+    std::map<Vehicle,ContractionHierarchyRef>  hierarchies;  //!< Hierarchy for each vehicle
+
+  public:
+    CHRoutingService(const DatabaseRef& database,
+                     const RouterParameter& parameter,
+                     const std::string& filenamebase);
+    ~CHRoutingService() override;
+
+    bool Open();
+    void Close();
+
+    void SetContractionHierarchy(const ContractionHierarchyRef& hierarchy);
+    ContractionHierarchyRef GetContractionHierarchy(Vehicle vehicle) const;
+
+    RoutingResult CalculateRoute(RoutingProfile& profile,
+                                 const RoutePosition& start,
+                                 const RoutePosition& target,
+                                 const RoutingParameter& parameter) override;
+  };
+
+  //! \ingroup Service
+  //! Reference counted reference to an CHRoutingService instance
+  using CHRoutingServiceRef = std::shared_ptr<CHRoutingService>;
+}
+
+#endif
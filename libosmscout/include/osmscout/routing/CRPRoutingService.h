@@ -0,0 +1,96 @@
+#ifndef OSMSCOUT_CRPROUTINGSERVICE_H
+#define OSMSCOUT_CRPROUTINGSERVICE_H
+
+/*
+  This source is part of the libosmscout library
+  Copyright (C) 2026  Tim Teulings
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307  USA
+*/
+
+#include <map>
+#include <memory>
+#include <string>
+#include <thread>
+
+#include <osmscout/CoreImportExport.h>
+
+#include <osmscout/routing/RoutePartition.h>
+#include <osmscout/routing/SimpleRoutingService.h>
+
+#include <osmscout/system/Compiler.h>
+
+namespace osmscout {
+
+  /**
+   * \ingroup Service
+   * \ingroup Routing
+   *
+   * Routing service, that calculates routes using the RoutePartition written
+   * by the importer (customizable route planning).
+   *
+   * Before routes for a vehicle can be calculated using the partition, the
+   * partition must be customized by calling Customize() with the profile to
+   * use. Customize() can be called again at any time to change the profile
+   * without reimporting the database.
+   *
+   * If there is no partition, no customization with the cost parameters
+   * of the profile, the partition does not contain a route (for example
+   * because the target is only reachable via access restricted ways) or the
+   * route violates a turn restriction, the A* search of SimpleRoutingService
+   * is used.
+   *
+   * The resulting RouteData can be postprocessed like the result of
+   * SimpleRoutingService.
+   */
+  class OSMSCOUT_API CRPRoutingService CLASS_FINAL : public SimpleRoutingService
+  {
+  private:
+    DatabaseRef                                   database;     //!< Database object, holding all index and data files
+    std::string                                   filenamebase; //!< Common base name for all router files
+    RoutePartitionRef                             partition;    //!< The partition, if available
+    std::map<Vehicle,RoutePartition::MetricRef>   metrics;      //!< Current customization for each vehicle
+
+  public:
+    CRPRoutingService(const DatabaseRef& database,
+                      const RouterParameter& parameter,
+                      const std::string& filenamebase);
+    ~CRPRoutingService() override;
+
+    bool Open();
+    void Close();
+
+    void SetRoutePartition(const RoutePartitionRef& partition);
+
+    inline RoutePartitionRef GetRoutePartition() const
+    {
+      return partition;
+    }
+
+    bool Customize(const RoutingProfile& profile,
+                   size_t threadCount=std::thread::hardware_concurrency());
+
+    RoutingResult CalculateRoute(RoutingProfile& profile,
+                                 const RoutePosition& start,
+                                 const RoutePosition& target,
+                                 const RoutingParameter& parameter) override;
+  };
+
+  //! \ingroup Service
+  //! Reference counted reference to an CRPRoutingService instance
+  using CRPRoutingServiceRef = std::shared_ptr<CRPRoutingService>;
+}
+
+#endif
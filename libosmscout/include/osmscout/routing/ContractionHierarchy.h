@@ -0,0 +1,240 @@
+#ifndef OSMSCOUT_CONTRACTIONHIERARCHY_H
+#define OSMSCOUT_CONTRACTIONHIERARCHY_H
+
+/*
+  This source is part of the libosmscout library
+  Copyright (C) 2026  Tim Teulings
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307  USA
+*/
+
+#include <limits>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <osmscout/CoreImportExport.h>
+
+#include <osmscout/ObjectRef.h>
+#include <osmscout/OSMScoutTypes.h>
+#include <osmscout/TypeConfig.h>
+
+#include <osmscout/routing/RouteNode.h>
+#include <osmscout/routing/RoutingProfile.h>
+
+#include <osmscout/util/Progress.h>
+
+#include <osmscout/system/Compiler.h>
+
+namespace osmscout {
+
+  /**
+   * \ingroup Routing
+   *
+   * A contraction hierarchy over the routing graph of one vehicle.
+   *
+   * All route nodes are ordered by importance ("rank"). For each node only the
+   * edges to nodes of higher rank are stored. Edges are either paths of the
+   * routing graph or shortcuts, that replace the two edges to a less
+   * important node, which was removed ("contracted") while building the
+   * hierarchy. A route is found by a bidirectional Dijkstra, that only walks
+   * upwards from the start and from the target.
+   *
+   * Edge costs are the costs of the RoutingProfile used for building the
+   * hierarchy, its cost parameters (see RoutingProfile::GetCostParameters())
+   * are stored with the hierarchy. Junction penalties and turn restrictions
+   * are not part of the hierarchy. Paths with access restrictions for the
+   * vehicle are skipped.
+   *
+   * The hierarchy is immutable after loading, all const methods are thread-safe.
+   */
+  class OSMSCOUT_API ContractionHierarchy CLASS_FINAL
+  {
+  public:
+    static const uint32_t noNode       = std::numeric_limits<uint32_t>::max();
+
+    static const uint8_t  forwardEdge  = 1u << 0u; //!< Edge can be used from the current node to the target
+    static const uint8_t  backwardEdge = 1u << 1u; //!< Edge can be used from the target to the current node
+
+    /**
+     * An edge from a node to a node of higher rank
+     */
+    struct OSMSCOUT_API Edge
+    {
+      uint32_t      target; //!< Index of the node at the other end of the edge
+      uint32_t      middle; //!< Index of the contracted node for shortcuts, else noNode
+      double        cost;   //!< Cost of the edge
+      ObjectFileRef object; //!< The object of the path, if the edge is not a shortcut
+      uint8_t       flags;  //!< Direction of the edge, either forwardEdge or backwardEdge
+    };
+
+    /**
+     * A route node, where the route may start or end, together
+     * with the initial costs of reaching it.
+     */
+    struct OSMSCOUT_API Endpoint
+    {
+      Id     id;   //!< Id of the route node
+      double cost; //!< Costs to reach the route node from the actual start or target
+    };
+
+    /**
+     * A single path of the resulting route
+     */
+    struct OSMSCOUT_API Step
+    {
+      Id            id;     //!< Id of the reached route node
+      ObjectFileRef object; //!< The object used to reach the route node
+    };
+
+    /**
+     * Result of a route calculation
+     */
+    struct OSMSCOUT_API Route
+    {
+      double            cost=0.0;   //!< Overall costs, including the costs of the endpoints
+      Id                source=0;   //!< Id of the route node the route starts at
+      Id                target=0;   //!< Id of the route node the route ends at
+      std::vector<Step> steps;      //!< All paths between source and target
+      size_t            settled=0;  //!< Number of nodes visited by the search
+    };
+
+  private:
+    Vehicle               vehicle;        //!< The vehicle the hierarchy was built for
+    std::string           costParameters; //!< Cost parameters of the profile the hierarchy was built with
+    std::vector<Id>       nodeIds;        //!< Ids of the route nodes, sorted
+    std::vector<uint32_t> edgeOffsets;    //!< Index of the first edge of each node, plus end marker
+    std::vector<Edge>     edges;          //!< Upward edges of all nodes
+
+  private:
+    const Edge* FindEdge(uint32_t node,
+                         uint32_t target,
+                         uint8_t direction) const;
+
+    bool Unpack(uint32_t from,
+                const Edge& edge,
+                std::vector<Step>& steps) const;
+
+  public:
+    ContractionHierarchy();
+
+    ContractionHierarchy(const ContractionHierarchy&) = delete;
+    ContractionHierarchy(ContractionHierarchy&&) = delete;
+    ContractionHierarchy& operator=(const ContractionHierarchy&) = delete;
+    ContractionHierarchy& operator=(ContractionHierarchy&&) = delete;
+
+    void Assign(Vehicle vehicle,
+                const std::string& costParameters,
+                std::vector<Id>&& nodeIds,
+                std::vector<uint32_t>&& edgeOffsets,
+                std::vector<Edge>&& edges);
+
+    bool Load(const std::string& filename);
+    bool Store(const std::string& filename) const;
+
+    inline Vehicle GetVehicle() const
+    {
+      return vehicle;
+    }
+
+    inline std::string GetCostParameters() const
+    {
+      return costParameters;
+    }
+
+    inline size_t GetNodeCount() const
+    {
+      return nodeIds.size();
+    }
+
+    inline size_t GetEdgeCount() const
+    {
+      return edges.size();
+    }
+
+    uint32_t GetNodeIndex(Id id) const;
+
+    bool CalculateRoute(const std::vector<Endpoint>& sources,
+                        const std::vector<Endpoint>& targets,
+                        Route& route) const;
+  };
+
+  using ContractionHierarchyRef = std::shared_ptr<ContractionHierarchy>;
+
+  /**
+   * \ingroup Routing
+   *
+   * Builds a ContractionHierarchy from the routing graph files written by the
+   * importer, using the costs of the given routing profile. The hierarchy only
+   * holds the costs of the paths, so the profile should not apply junction
+   * penalties (see FastestPathRoutingProfile::SetJunctionPenalty()).
+   */
+  class OSMSCOUT_API ContractionHierarchyBuilder CLASS_FINAL
+  {
+  private:
+    struct BuildEdge
+    {
+      uint32_t      node;
+      uint32_t      middle;
+      double        cost;
+      ObjectFileRef object;
+    };
+
+    struct BuildNode
+    {
+      std::vector<BuildEdge> out;        //!< Edges to not yet contracted nodes
+      std::vector<BuildEdge> in;         //!< Edges from not yet contracted nodes
+      uint32_t               contractedNeighbours=0;
+      bool                   contracted=false;
+    };
+
+    struct Shortcut
+    {
+      uint32_t from;
+      uint32_t to;
+      double   cost;
+    };
+
+  private:
+    const RoutingProfile& profile;            //!< Profile defining vehicle and costs
+    size_t                witnessSearchLimit; //!< Maximum number of nodes settled during a witness search
+
+  private:
+    static void AddEdge(std::vector<BuildEdge>& edges,
+                        const BuildEdge& edge);
+    static void RemoveEdge(std::vector<BuildEdge>& edges,
+                           uint32_t node);
+
+    void FindShortcuts(const std::vector<BuildNode>& nodes,
+                       uint32_t node,
+                       std::vector<Shortcut>& shortcuts) const;
+    int GetPriority(const std::vector<BuildNode>& nodes,
+                    uint32_t node,
+                    std::vector<Shortcut>& shortcuts) const;
+
+  public:
+    explicit ContractionHierarchyBuilder(const RoutingProfile& profile);
+
+    void SetWitnessSearchLimit(size_t limit);
+
+    bool Build(Progress& progress,
+               const TypeConfig& typeConfig,
+               const std::string& path,
+               const std::string& filenamebase,
+               ContractionHierarchy& hierarchy) const;
+  };
+}
+
+#endif
@@ -0,0 +1,245 @@
+#ifndef OSMSCOUT_DBIDHASHMAP_H
+#define OSMSCOUT_DBIDHASHMAP_H
+
+/*
+  This source is part of the libosmscout library
+  Copyright (C) 2026  Tim Teulings
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307  USA
+*/
+
+#include <cstdint>
+#include <iterator>
+#include <vector>
+
+#include <osmscout/routing/DBFileOffset.h>
+
+#include <osmscout/system/Compiler.h>
+
+namespace osmscout {
+
+  /**
+   * \ingroup Routing
+   *
+   * Hash map with DBId keys using open addressing (linear probing) in
+   * flat arrays. Compared to std::unordered_map there is no allocation per
+   * entry and lookups touch only one or two cache lines.
+   *
+   * Entries cannot be removed, the map is meant to hold the state of one
+   * routing run. Iterating the map visits the values of all entries in
+   * unspecified order.
+   */
+  template<class Value>
+  class DBIdHashMap CLASS_FINAL
+  {
+  private:
+    std::vector<DBId>    keys;
+    std::vector<Value>   values;
+    std::vector<uint8_t> used;
+    size_t               mask=0;
+    size_t               count=0;
+
+  private:
+    static size_t Hash(const DBId& id)
+    {
+      uint64_t hash=(id.id ^ (uint64_t(id.database) << 56))*0x9E3779B97F4A7C15ull;
+
+      return size_t(hash ^ (hash >> 32));
+    }
+
+    size_t FindSlot(const DBId& id) const
+    {
+      size_t slot=Hash(id) & mask;
+
+      while (used[slot]!=0 && keys[slot]!=id) {
+        slot=(slot+1) & mask;
+      }
+
+      return slot;
+    }
+
+    void Rehash(size_t capacity)
+    {
+      std::vector<DBId>    oldKeys(capacity);
+      std::vector<Value>   oldValues(capacity);
+      std::vector<uint8_t> oldUsed(capacity,0);
+
+      keys.swap(oldKeys);
+      values.swap(oldValues);
+      used.swap(oldUsed);
+      mask=capacity-1;
+
+      for (size_t i=0; i<oldUsed.size(); i++) {
+        if (oldUsed[i]!=0) {
+          size_t slot=FindSlot(oldKeys[i]);
+
+          keys[slot]=oldKeys[i];
+          values[slot]=std::move(oldValues[i]);
+          used[slot]=1;
+        }
+      }
+    }
+
+  public:
+    class const_iterator
+    {
+    private:
+      const DBIdHashMap* map;
+      size_t             slot;
+
+    public:
+      using iterator_category = std::forward_iterator_tag;
+      using value_type        = Value;
+      using difference_type   = std::ptrdiff_t;
+      using pointer           = const Value*;
+      using reference         = const Value&;
+
+      const_iterator(const DBIdHashMap* map,
+                     size_t slot)
+      : map(map),
+        slot(slot)
+      {
+        while (this->slot<map->used.size() &&
+               map->used[this->slot]==0) {
+          this->slot++;
+        }
+      }
+
+      const Value& operator*() const
+      {
+        return map->values[slot];
+      }
+
+      const Value* operator->() const
+      {
+        return &map->values[slot];
+      }
+
+      const_iterator& operator++()
+      {
+        slot++;
+
+        while (slot<map->used.size() &&
+               map->used[slot]==0) {
+          slot++;
+        }
+
+        return *this;
+      }
+
+      bool operator==(const const_iterator& other) const
+      {
+        return slot==other.slot;
+      }
+
+      bool operator!=(const const_iterator& other) const
+      {
+        return slot!=other.slot;
+      }
+    };
+
+  public:
+    DBIdHashMap()
+    {
+      Rehash(16);
+    }
+
+    /**
+     * Make sure, that the given number of entries can be stored without
+     * rehashing
+     */
+    void reserve(size_t size)
+    {
+      size_t capacity=keys.size();
+
+      while (size*4>capacity*3) {
+        capacity*=2;
+      }
+
+      if (capacity!=keys.size()) {
+        Rehash(capacity);
+      }
+    }
+
+    size_t size() const
+    {
+      return count;
+    }
+
+    bool empty() const
+    {
+      return count==0;
+    }
+
+    /**
+     * Return a pointer to the value stored for the given id or nullptr
+     */
+    Value* Find(const DBId& id)
+    {
+      size_t slot=FindSlot(id);
+
+      return used[slot]!=0 ? &values[slot] : nullptr;
+    }
+
+    const Value* Find(const DBId& id) const
+    {
+      size_t slot=FindSlot(id);
+
+      return used[slot]!=0 ? &values[slot] : nullptr;
+    }
+
+    bool Contains(const DBId& id) const
+    {
+      return used[FindSlot(id)]!=0;
+    }
+
+    /**
+     * Return the value stored for the given id. A default constructed value is
+     * inserted, if there is no entry for the id yet.
+     */
+    Value& operator[](const DBId& id)
+    {
+      size_t slot=FindSlot(id);
+
+      if (used[slot]!=0) {
+        return values[slot];
+      }
+
+      if ((count+1)*4>keys.size()*3) {
+        Rehash(keys.size()*2);
+        slot=FindSlot(id);
+      }
+
+      keys[slot]=id;
+      values[slot]=Value();
+      used[slot]=1;
+      count++;
+
+      return values[slot];
+    }
+
+    const_iterator begin() const
+    {
+      return const_iterator(this,0);
+    }
+
+    const_iterator end() const
+    {
+      return const_iterator(this,used.size());
+    }
+  };
+}
+
+#endif
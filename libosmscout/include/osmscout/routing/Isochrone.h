@@ -0,0 +1,136 @@
+#ifndef OSMSCOUT_ISOCHRONE_H
+#define OSMSCOUT_ISOCHRONE_H
+
+/*
+  This source is part of the libosmscout library
+  Copyright (C) 2026  Tim Teulings
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307  USA
+*/
+
+#include <limits>
+#include <vector>
+
+#include <osmscout/CoreImportExport.h>
+
+#include <osmscout/GeoCoord.h>
+
+#include <osmscout/routing/DBFileOffset.h>
+
+#include <osmscout/util/Distance.h>
+#include <osmscout/util/Time.h>
+
+#include <osmscout/system/Compiler.h>
+
+namespace osmscout {
+
+  /**
+   * \ingroup Routing
+   *
+   * Route node reached by an isochrone calculation
+   */
+  struct OSMSCOUT_API IsochroneNode
+  {
+    static constexpr size_t NoPrevious=std::numeric_limits<size_t>::max();
+
+    DBId     id;                         //!< Id of the route node
+    GeoCoord coord;                      //!< Coordinate of the route node
+    double   cost=0.0;                   //!< Costs from the start as defined by the profile
+    Distance distance;                   //!< Distance from the start
+    Duration duration=Duration::zero();  //!< Travel time from the start, without junction penalties
+    size_t   previous=NoPrevious;        //!< Index of the node this node was reached from
+  };
+
+  /**
+   * \ingroup Routing
+   *
+   * Area reachable within the cost limit of one band of an isochrone.
+   *
+   * The area is the union of grid cells touched by the reached route nodes
+   * and the paths between them. Outer rings are oriented counter clockwise,
+   * holes clockwise (with longitude as x and latitude as y axis).
+   */
+  struct OSMSCOUT_API IsochroneBand
+  {
+    double                             costLimit=0.0; //!< Cost limit of the band
+    std::vector<std::vector<GeoCoord>> rings;         //!< Outline of the reachable area
+  };
+
+  /**
+   * \ingroup Routing
+   *
+   * Result of an isochrone calculation. Success() is false, if the start
+   * could not be resolved or the calculation failed or was aborted.
+   */
+  class OSMSCOUT_API IsochroneResult CLASS_FINAL
+  {
+  private:
+    bool                       success=false;
+    std::vector<IsochroneNode> nodes;
+    std::vector<IsochroneBand> bands;
+
+  public:
+    inline bool Success() const
+    {
+      return success;
+    }
+
+    inline void SetSuccess(bool success)
+    {
+      this->success=success;
+    }
+
+    /**
+     * Reached route nodes in the order of increasing costs
+     */
+    inline const std::vector<IsochroneNode>& GetNodes() const
+    {
+      return nodes;
+    }
+
+    inline std::vector<IsochroneNode>& GetNodes()
+    {
+      return nodes;
+    }
+
+    /**
+     * One band for each requested cost limit, in the order of the request
+     */
+    inline const std::vector<IsochroneBand>& GetBands() const
+    {
+      return bands;
+    }
+
+    inline std::vector<IsochroneBand>& GetBands()
+    {
+      return bands;
+    }
+  };
+
+  /**
+   * \ingroup Routing
+   *
+   * Rasterise the given nodes with costs not exceeding costLimit and the paths
+   * to their previous nodes into a grid of cells of the given size (with one cell
+   * corner at origin) and return the outline of the touched cells.
+   */
+  extern OSMSCOUT_API void CalculateIsochroneRings(const GeoCoord& origin,
+                                                   const Distance& cellSize,
+                                                   const std::vector<IsochroneNode>& nodes,
+                                                   double costLimit,
+                                                   std::vector<std::vector<GeoCoord>>& rings);
+}
+
+#endif
@@ -0,0 +1,138 @@
+#ifndef OSMSCOUT_MAPMATCHING_H
+#define OSMSCOUT_MAPMATCHING_H
+
+/*
+  This source is part of the libosmscout library
+  Copyright (C) 2026  Tim Teulings
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307  USA
+*/
+
+#include <vector>
+
+#include <osmscout/CoreImportExport.h>
+
+#include <osmscout/GeoCoord.h>
+
+#include <osmscout/routing/RouteData.h>
+#include <osmscout/routing/RoutingService.h>
+
+#include <osmscout/util/Distance.h>
+
+#include <osmscout/system/Compiler.h>
+
+namespace osmscout {
+
+  /**
+   * \ingroup Routing
+   *
+   * Parameters of the hidden Markov model used for map matching, see
+   * Newson, Krumm: "Hidden Markov Map Matching Through Noise and Sparseness".
+   *
+   * The probability of a point being measured at a candidate is modelled
+   * by a normal distribution of the distance with standard deviation
+   * gpsSigma. The probability of moving from one candidate to the next is
+   * modelled by an exponential distribution of the difference between the
+   * route distance and the distance of the measured points with mean
+   * transitionBeta.
+   */
+  struct OSMSCOUT_API MapMatchParameter
+  {
+    Distance searchRadius=Meters(50);   //!< Maximum distance of a candidate from the measured point
+    size_t   maxCandidates=5;           //!< Maximum number of candidates (ways) for each point
+    Distance gpsSigma=Meters(5);        //!< Standard deviation of the measurement error
+    Distance transitionBeta=Meters(10); //!< Mean difference between route and point distance
+    double   maxDetourFactor=2.0;       //!< Routes longer than this factor times the point distance are ignored
+  };
+
+  /**
+   * \ingroup Routing
+   *
+   * Candidate position of a measured point on the routing graph
+   */
+  struct OSMSCOUT_API MapMatchCandidate
+  {
+    RoutePosition position; //!< Node of the way closest to the point
+    Distance      distance; //!< Distance of the point to the way
+  };
+
+  /**
+   * \ingroup Routing
+   *
+   * Result of the map matching of one point of a trace
+   */
+  struct OSMSCOUT_API MatchedPoint
+  {
+    bool          matched=false; //!< The point could be matched
+    RoutePosition position;      //!< Position on the routing graph the point was matched to
+    Distance      distance;      //!< Distance of the point to the way of the position
+    size_t        route=0;       //!< Index of the route the point belongs to
+  };
+
+  /**
+   * \ingroup Routing
+   *
+   * Result of the map matching of a trace. Success() is false, if the
+   * calculation failed or was aborted.
+   *
+   * If consecutive points cannot be connected on the routing graph, the
+   * trace is split and one route is returned for each part. Points without
+   * candidates are skipped. Each route can be passed on to the
+   * RoutePostprocessor like the route of a RoutingResult.
+   */
+  class OSMSCOUT_API MapMatchResult CLASS_FINAL
+  {
+  private:
+    bool                      success=false;
+    std::vector<MatchedPoint> points;
+    std::vector<RouteData>    routes;
+
+  public:
+    inline bool Success() const
+    {
+      return success;
+    }
+
+    inline void SetSuccess(bool success)
+    {
+      this->success=success;
+    }
+
+    /**
+     * One entry for each point of the trace
+     */
+    inline const std::vector<MatchedPoint>& GetPoints() const
+    {
+      return points;
+    }
+
+    inline std::vector<MatchedPoint>& GetPoints()
+    {
+      return points;
+    }
+
+    inline const std::vector<RouteData>& GetRoutes() const
+    {
+      return routes;
+    }
+
+    inline std::vector<RouteData>& GetRoutes()
+    {
+      return routes;
+    }
+  };
+}
+
+#endif
@@ -28,6 +28,8 @@
 #include <osmscout/routing/RoutePostprocessor.h>
 #include <osmscout/routing/RoutingDB.h>
 
+#include <osmscout/util/WorkQueue.h>
+
 namespace osmscout {
 
   /**
@@ -45,6 +47,7 @@ namespace osmscout {
       RoutingDatabaseRef      routingDatabase; //<! Routing database
       SimpleRoutingServiceRef router;          //<! Simple router for the given database
       RoutingProfileRef       profile;         //<! Profile for the given database
+      std::unordered_map<Id,std::vector<DBId>> boundaryNodes; //<! Route nodes also contained in other databases, with their twins
     };
 
   public:
@@ -52,11 +55,16 @@ namespace osmscout {
 
   private:
     std::vector<DatabaseHandle> handles;
+    std::unique_ptr<WorkerPool> workerPool;   //<! Threads accessing several databases concurrently
     bool                        isOpen;
 
   private:
+    bool LoadBoundaryNodes();
+
     Vehicle GetVehicle(const MultiDBRoutingState& state) override;
 
+    bool HasTimeCosts(const MultiDBRoutingState& state) override;
+
     bool CanUseForward(const MultiDBRoutingState& state,
                        const DatabaseId& database,
                        const WayRef& way) override;
@@ -76,6 +84,18 @@ namespace osmscout {
                     const WayRef &way,
                     const Distance &wayLength) override;
 
+    Duration GetTime(const MultiDBRoutingState& state,
+                     DatabaseId database,
+                     const RouteNode& routeNode,
+                     size_t pathIndex) override;
+
+    Duration GetTime(const MultiDBRoutingState& state,
+                     DatabaseId database,
+                     const WayRef &way,
+                     const Distance &wayLength) override;
+
+    const SpeedProfiles* GetSpeedProfiles(DatabaseId database) override;
+
     double GetEstimateCosts(const MultiDBRoutingState& state,
                             DatabaseId database,
                             const Distance &targetDistance) override;
@@ -94,6 +114,9 @@ namespace osmscout {
     bool GetRouteNode(const DBId &id,
                       RouteNodeRef &node) override;
 
+    bool GetRouteNodePredecessors(const DBId &id,
+                                  std::vector<std::pair<Id,ObjectFileRef>> &sources) override;
+
     bool GetWayByOffset(const DBFileOffset &offset,
                         WayRef &way) override;
 
@@ -129,14 +152,31 @@ namespace osmscout {
     RoutePositionResult GetClosestRoutableNode(const GeoCoord &coord,
                                                const Distance &radius=Kilometers(1)) const;
 
+    std::vector<RoutePositionResult> GetClosestRoutableNodes(const std::vector<GeoCoord> &coords,
+                                                             const Distance &radius=Kilometers(1)) const;
+
     RoutingResult CalculateRoute(const RoutePosition &start,
                                  const RoutePosition &target,
                                  const RoutingParameter &parameter);
 
+    AlternativeRoutingResult CalculateAlternativeRoutes(const RoutePosition& start,
+                                                        const RoutePosition& target,
+                                                        const RoutingParameter& parameter,
+                                                        const AlternativeRouteParameter& alternativeParameter);
+
     RoutingResult CalculateRoute(std::vector<osmscout::GeoCoord> via,
                                  const Distance &radius,
                                  const RoutingParameter& parameter);
 
+    RoutingMatrixResult CalculateMatrix(const std::vector<RoutePosition>& sources,
+                                        const std::vector<RoutePosition>& targets,
+                                        const RoutingParameter& parameter);
+
+    IsochroneResult CalculateIsochrone(const RoutePosition& start,
+                                       const std::vector<double>& costLimits,
+                                       const Distance& cellSize,
+                                       const RoutingParameter& parameter);
+
     RouteDescriptionResult TransformRouteDataToRouteDescription(const RouteData& data);
 
     RoutePointsResult TransformRouteDataToPoints(const RouteData& data);
@@ -147,6 +187,11 @@ namespace osmscout {
                                      const std::list<RoutePostprocessor::PostprocessorRef> &postprocessors);
 
     std::map<DatabaseId, std::string> GetDatabaseMapping() const override;
+
+    size_t GetBoundaryNodeCount(DatabaseId database) const;
+
+    std::vector<DBId> GetBoundaryNodeTwins(DatabaseId database,
+                                           Id id) const;
   };
 
   //! \ingroup Service
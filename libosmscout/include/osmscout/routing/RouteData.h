@@ -20,7 +20,7 @@
   Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307  USA
 */
 
-#include <list>
+#include <iterator>
 #include <vector>
 
 #include <osmscout/Path.h>
@@ -91,7 +91,7 @@ namespace osmscout {
     };
 
   private:
-    std::list<RouteEntry> entries;
+    std::vector<RouteEntry> entries;
 
   public:
     void Clear();
@@ -107,19 +107,21 @@ namespace osmscout {
                   const ObjectFileRef& pathObject,
                   size_t targetNodeIndex);
 
-    inline std::list<RouteEntry>& Entries()
+    inline std::vector<RouteEntry>& Entries()
     {
       return entries;
     }
 
-    inline const std::list<RouteEntry>& Entries() const
+    inline const std::vector<RouteEntry>& Entries() const
     {
       return entries;
     }
 
     inline void Append(RouteData routePart)
     {
-      entries.splice(entries.end(),routePart.Entries());
+      entries.insert(entries.end(),
+                     std::make_move_iterator(routePart.Entries().begin()),
+                     std::make_move_iterator(routePart.Entries().end()));
     }
 
     inline void PopEntry()
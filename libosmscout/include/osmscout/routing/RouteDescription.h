@@ -20,8 +20,10 @@
   Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307  USA
 */
 
+#include <array>
 #include <list>
 #include <memory>
+#include <optional>
 #include <string>
 #include <unordered_map>
 #include <vector>
@@ -48,7 +50,12 @@ namespace osmscout {
    * For each node you can pass a number of descriptions. For the way from the current node
    * to the next node also a number of descriptions can get retrieved.
    *
-   * Descriptions are typed and must derive from class Description..
+   * Descriptions are typed and must derive from class Description.. The standard descriptions
+   * are stored in typed slots of the node (see DescriptionSlot), the methods taking the name of
+   * a description map the name to its slot.
+   *
+   * Nodes are stored contiguously, so they can be accessed by index and searched by their
+   * distance from the start (see FindNodeByDistance()).
    */
   class OSMSCOUT_API RouteDescription
   {
@@ -92,6 +99,38 @@ namespace osmscout {
     /** Constant for a description of suggested route lanes (SuggestedLaneDescription) */
     static const char* const SUGGESTED_LANES_DESC;
 
+    /**
+     * Typed slot of a description of a node, one for each of the *_DESC constants above.
+     * Accessing a description by its slot is an array access, while accessing it by its
+     * name requires a lookup of the slot for the name first.
+     */
+    enum class DescriptionSlot : uint8_t {
+      NodeStart,
+      NodeTarget,
+      WayName,
+      WayNameChanged,
+      CrossingWays,
+      Direction,
+      Turn,
+      RoundaboutEnter,
+      RoundaboutLeave,
+      MotorwayEnter,
+      MotorwayChange,
+      MotorwayLeave,
+      MotorwayJunction,
+      CrossingDestination,
+      WayMaxSpeed,
+      WayTypeName,
+      POIAtRoute,
+      Lanes,
+      SuggestedLanes
+    };
+
+    static constexpr size_t descriptionSlotCount=static_cast<size_t>(DescriptionSlot::SuggestedLanes)+1;
+
+    static std::optional<DescriptionSlot> GetDescriptionSlot(const char* name);
+    static const char* GetDescriptionName(DescriptionSlot slot);
+
   public:
     /**
      * \ingroup Routing
@@ -675,8 +714,9 @@ namespace osmscout {
       Distance                                       distance; //!< distance from route start
       Duration                                       time; //!< time from route start
       GeoCoord                                       location; //!< geographic coordinate of node
-      std::unordered_map<std::string,DescriptionRef> descriptionMap;
-      std::list<DescriptionRef>                      descriptions;
+      std::array<DescriptionRef,descriptionSlotCount> slots; //!< descriptions with one of the standard names
+      std::unordered_map<std::string,DescriptionRef> descriptionMap; //!< descriptions with other names
+      std::vector<DescriptionRef>                    descriptions; //!< all descriptions in the order they were added
 
     public:
       Node(DatabaseId database,
@@ -701,7 +741,7 @@ namespace osmscout {
       /**
        * Return a list of descriptions attached to the current node
        */
-      inline const std::list<DescriptionRef>& GetDescriptions() const
+      inline const std::vector<DescriptionRef>& GetDescriptions() const
       {
         return descriptions;
       }
@@ -765,6 +805,25 @@ namespace osmscout {
         return location;
       }
 
+      inline bool HasDescription(DescriptionSlot slot) const
+      {
+        return slots[static_cast<size_t>(slot)]!=nullptr;
+      }
+
+      inline DescriptionRef GetDescription(DescriptionSlot slot) const
+      {
+        return slots[static_cast<size_t>(slot)];
+      }
+
+      /**
+       * Return the description in the given slot, if it is of the given type
+       */
+      template<typename D>
+      std::shared_ptr<D> GetDescription(DescriptionSlot slot) const
+      {
+        return std::dynamic_pointer_cast<D>(slots[static_cast<size_t>(slot)]);
+      }
+
       bool HasDescription(const char* name) const;
       DescriptionRef GetDescription(const char* name) const;
 
@@ -772,14 +831,18 @@ namespace osmscout {
       void SetTime(const Timestamp::duration &time);
       void SetLocation(const GeoCoord &coord);
 
+      void AddDescription(DescriptionSlot slot,
+                          const DescriptionRef& description);
       void AddDescription(const char* name,
                           const DescriptionRef& description);
+      void MergeDescriptions(const Node& other);
+      void ClearDescriptions();
     };
 
-    using NodeIterator = std::list<RouteDescription::Node>::const_iterator;
+    using NodeIterator = std::vector<RouteDescription::Node>::const_iterator;
 
   private:
-    std::list<Node> nodes;
+    std::vector<Node> nodes;
     std::map<DatabaseId, std::string> databaseMapping;
 
   public:
@@ -800,15 +863,17 @@ namespace osmscout {
                  const ObjectFileRef& pathObject,
                  size_t targetNodeIndex);
 
-    inline std::list<Node>& Nodes()
+    inline std::vector<Node>& Nodes()
     {
       return nodes;
     }
 
-    inline const std::list<Node>& Nodes() const
+    inline const std::vector<Node>& Nodes() const
     {
       return nodes;
     }
+
+    NodeIterator FindNodeByDistance(const Distance& distance) const;
   };
 
   using RouteDescriptionRef = std::shared_ptr<RouteDescription>;
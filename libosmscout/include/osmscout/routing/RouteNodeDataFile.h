@@ -20,15 +20,20 @@
   Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307  USA
 */
 
+#include <atomic>
 #include <map>
+#include <mutex>
 #include <vector>
 
 #include <osmscout/DataFile.h>
 #include <osmscout/Pixel.h>
 
+#include <osmscout/util/ConcurrentCache.h>
+#include <osmscout/util/MemoryGovernor.h>
 #include <osmscout/util/TileId.h>
 
 #include <osmscout/routing/RouteNode.h>
+#include <osmscout/routing/RoutingGraph.h>
 
 namespace osmscout {
   /**
@@ -36,6 +41,20 @@ namespace osmscout {
    */
   class OSMSCOUT_API RouteNodeDataFile CLASS_FINAL
   {
+  public:
+    /**
+     * A path leading to a route node, for which the route node has no path
+     * back using the same object (e.g. the path from the previous route node
+     * on a oneway way). Together with the targets of the paths of the route
+     * node these are all predecessors of the route node.
+     */
+    struct Predecessor
+    {
+      Id            target; //!< The route node the path leads to
+      Id            source; //!< The route node the path starts at
+      ObjectFileRef object; //!< The object of the path
+    };
+
   private:
     struct IndexEntry
     {
@@ -43,18 +62,34 @@ namespace osmscout {
       uint32_t   count;
     };
 
+    /**
+     * All route nodes of one tile. A page is completely loaded before it is
+     * put into the cache and never changed afterwards, so it can be shared
+     * between threads without locking.
+     */
     struct IndexPage
     {
-      FileOffset                          fileOffset;
-      uint32_t                            remaining;
       std::unordered_map<Id,RouteNodeRef> nodeMap;
-
-      RouteNodeRef find(FileScanner& scanner,
-                        Id id);
     };
 
+    using IndexPageRef = std::shared_ptr<IndexPage>;
+
   private:
-    using ValueCache = Cache<Id, IndexPage>;
+    using ValueCache = ConcurrentCache<Id, IndexPageRef>;
+
+    /**
+      Estimates the memory of a page
+      */
+    struct IndexPageValueSizer : public ValueCache::ValueSizer
+    {
+      size_t GetSize(const IndexPageRef& value) const override
+      {
+        size_t nodeCount=value->nodeMap.size();
+
+        return sizeof(value)+sizeof(IndexPage)+
+               nodeCount*(sizeof(RouteNode)+sizeof(RouteNodeRef)+sizeof(std::pair<Id,RouteNodeRef>));
+      }
+    };
 
   private:
     std::string                datafile;        //!< Basename part of the data file name
@@ -66,33 +101,70 @@ namespace osmscout {
 
     mutable FileScanner        scanner;         //!< File stream to the data file
     mutable ValueCache         cache;           //!< Cache of loaded route node pages
-    mutable std::mutex         accessMutex;     //!< Mutex to secure multi-thread access
+    MemoryGovernorRef          memoryGovernor;  //!< Governor controlling the memory budget of the cache, if any
+    mutable std::mutex         accessMutex;     //!< Mutex to secure multi-thread access to scanner
     mutable Magnification      magnification;   //!< Magnification of tiled index
 
+    bool                       graphLoaded;     //!< The complete graph is held in memory
+    RoutingGraph               graph;           //!< The complete graph, if loaded
+    std::vector<RouteNodeRef>  graphNodes;      //!< The route node of each node of the graph, if loaded
+
+    mutable std::vector<Predecessor> predecessors;       //!< Predecessors without path back, sorted by target
+    mutable std::atomic<bool>        predecessorsLoaded; //!< The predecessors have been derived
+    mutable std::mutex               predecessorMutex;   //!< Mutex to secure lazy derivation of the predecessors
+
   private:
+    void DetachMemoryGovernor();
+
     bool LoadIndexPage(const osmscout::Pixel& tile,
-                       ValueCache::CacheRef& cacheRef) const;
+                       IndexPageRef& page) const;
     bool GetIndexPage(const osmscout::Pixel& tile,
-                      ValueCache::CacheRef& cacheRef) const;
+                      IndexPageRef& page) const;
+    bool LoadPredecessors() const;
+    bool Contains(Id id) const;
 
   public:
     explicit RouteNodeDataFile(const std::string& datafile,
                          size_t cacheSize);
+    ~RouteNodeDataFile();
 
     bool Open(const TypeConfigRef& typeConfig,
               const std::string& path,
-              bool memoryMapedData);
+              bool memoryMapedData,
+              uint8_t mmapAdvice=FileScanner::NoAdvice);
     bool IsOpen() const;
     bool Close();
 
+    bool LoadGraph();
+
+    inline bool IsGraphLoaded() const
+    {
+      return graphLoaded;
+    }
+
+    /**
+     * Return the graph, if it has been loaded by LoadGraph(), else nullptr
+     */
+    inline const RoutingGraph* GetGraph() const
+    {
+      return graphLoaded ? &graph : nullptr;
+    }
+
     Pixel GetTile(const GeoCoord& coord) const;
     bool IsCovered(const Pixel& tile) const;
 
     bool IsCovered(const GeoCoord& coord) const;
+    bool IsCovered(const GeoBox& boundingBox) const;
 
     bool Get(Id id,
              RouteNodeRef& node) const;
 
+    bool GetSharedIds(const RouteNodeDataFile& other,
+                      std::vector<Id>& ids) const;
+
+    bool GetPredecessors(Id id,
+                         std::vector<std::pair<Id,ObjectFileRef>>& sources) const;
+
     template<typename IteratorIn>
     bool Get(IteratorIn begin, IteratorIn end, size_t size,
              std::vector<RouteNodeRef>& data) const
@@ -100,23 +172,10 @@ namespace osmscout {
       data.reserve(size);
 
       for (IteratorIn idIter=begin; idIter!=end; ++idIter) {
-        Id                   id=*idIter;
-        ValueCache::CacheRef cacheRef;
-
-        GeoCoord coord=Point::GetCoordFromId(id);
-        osmscout::Pixel tile=TileId::GetTile(magnification,coord).AsPixel();
-
-        //std::cout << "Tile " << tile.GetDisplayText() << " " << tile.GetId() << "..." << std::endl;
-
-        if (!GetIndexPage(tile,
-                          cacheRef)) {
-          return false;
-        }
-
-        auto node=cacheRef->value.find(scanner,
-                                       id);
+        RouteNodeRef node;
 
-        if (node==nullptr) {
+        if (!Get(*idIter,
+                 node)) {
           return false;
         }
 
@@ -131,31 +190,22 @@ namespace osmscout {
              std::unordered_map<Id,RouteNodeRef>& dataMap) const
     {
       for (IteratorIn idIter=begin; idIter!=end; ++idIter) {
-        Id                   id=*idIter;
-        ValueCache::CacheRef cacheRef;
-
-        GeoCoord coord=Point::GetCoordFromId(id);
-        osmscout::Pixel tile=TileId::GetTile(magnification,coord).AsPixel();
+        RouteNodeRef node;
 
-        //std::cout << "Tile " << tile.GetDisplayText() << " " << tile.GetId() << "..." << std::endl;
-
-        if (!GetIndexPage(tile,
-                          cacheRef)) {
+        if (!Get(*idIter,
+                 node)) {
           return false;
         }
 
-        auto node=cacheRef->value.find(scanner,
-                                       id);
-
-        if (node==nullptr) {
-          return false;
-        }
-
-        dataMap[id]=node;
+        dataMap[*idIter]=node;
       }
 
       return true;
     }
+
+    void SetCacheMemory(size_t maxMemory);
+    void SetMemoryGovernor(const MemoryGovernorRef& governor,
+                           double weight);
   };
 
 }
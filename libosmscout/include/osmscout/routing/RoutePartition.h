@@ -0,0 +1,230 @@
+#ifndef OSMSCOUT_ROUTEPARTITION_H
+#define OSMSCOUT_ROUTEPARTITION_H
+
+/*
+  This source is part of the libosmscout library
+  Copyright (C) 2026  Tim Teulings
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307  USA
+*/
+
+#include <limits>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <osmscout/CoreImportExport.h>
+
+#include <osmscout/ObjectRef.h>
+#include <osmscout/OSMScoutTypes.h>
+#include <osmscout/TypeConfig.h>
+
+#include <osmscout/routing/RouteNode.h>
+#include <osmscout/routing/RoutingProfile.h>
+
+#include <osmscout/util/Progress.h>
+
+#include <osmscout/system/Compiler.h>
+
+namespace osmscout {
+
+  /**
+   * \ingroup Routing
+   *
+   * Multi-level partition of the routing graph for customizable route
+   * planning (CRP).
+   *
+   * The partition does not depend on any costs. The route nodes are split
+   * into cells by recursive bisection of their coordinates. Each level
+   * groups 2^bitsPerLevel cells of the level below. For each cell the
+   * route nodes with paths to other cells of the same level ("boundary
+   * nodes") are known.
+   *
+   * Customize() calculates the costs of all paths for a RoutingProfile and
+   * the costs between all boundary nodes of each cell ("clique") bottom up.
+   * This is fast and can be done for each change of the profile. The cells
+   * of a level are customized in parallel.
+   *
+   * CalculateRoute() runs a Dijkstra, that uses the cliques of the highest
+   * level cell that contains neither start nor target. Cliques of the
+   * resulting route are unpacked to paths by local searches within the cell.
+   *
+   * Junction penalties and turn restrictions are not taken into account,
+   * paths with access restrictions are skipped. Users of the partition thus
+   * must check the resulting route against the turn restrictions of its route
+   * nodes.
+   *
+   * The partition is immutable after building or loading, all const methods
+   * are thread-safe.
+   */
+  class OSMSCOUT_API RoutePartition CLASS_FINAL
+  {
+  public:
+    static const uint32_t noNode = std::numeric_limits<uint32_t>::max();
+
+    /**
+     * Costs of a RoutingProfile for all paths and cliques
+     */
+    struct OSMSCOUT_API Metric
+    {
+      Vehicle                          vehicle;        //!< Vehicle of the profile
+      std::string                      costParameters; //!< Cost parameters of the profile
+      std::vector<double>              pathCosts;      //!< Costs of each path, infinite if not usable
+      std::vector<std::vector<double>> cliqueCosts;    //!< Per level the cost matrices of all cells
+    };
+
+    using MetricRef = std::shared_ptr<Metric>;
+
+    /**
+     * A route node, where the route may start or end, together
+     * with the initial costs of reaching it.
+     */
+    struct OSMSCOUT_API Endpoint
+    {
+      Id     id;   //!< Id of the route node
+      double cost; //!< Costs to reach the route node from the actual start or target
+    };
+
+    /**
+     * A single path of the resulting route
+     */
+    struct OSMSCOUT_API Step
+    {
+      Id            id;     //!< Id of the reached route node
+      ObjectFileRef object; //!< The object used to reach the route node
+    };
+
+    /**
+     * Result of a route calculation
+     */
+    struct OSMSCOUT_API Route
+    {
+      double            cost=0.0;   //!< Overall costs, including the costs of the endpoints
+      Id                source=0;   //!< Id of the route node the route starts at
+      Id                target=0;   //!< Id of the route node the route ends at
+      std::vector<Step> steps;      //!< All paths between source and target
+      size_t            settled=0;  //!< Number of nodes visited by the search
+    };
+
+  private:
+    /**
+     * Cells and boundary nodes of one level
+     */
+    struct Level
+    {
+      std::vector<uint32_t> cellOffsets;      //!< Index of the first boundary node of each cell, plus end marker
+      std::vector<uint32_t> boundaryNodes;    //!< Boundary nodes of all cells
+      std::vector<uint32_t> boundaryIndex;    //!< Index of each node within the boundary nodes of its cell, or noNode
+      std::vector<size_t>   matrixOffsets;    //!< Index of the first clique cost of each cell, plus end marker
+    };
+
+    struct Label
+    {
+      double   cost;   //!< Costs to reach the node
+      uint32_t parent; //!< Previous node or noNode for endpoints
+      uint32_t path;   //!< Index of the path used, or noNode if a clique was used
+      uint8_t  level;  //!< Level of the clique used
+    };
+
+    using Labels = std::unordered_map<uint32_t,Label>;
+
+  private:
+    uint8_t                             levelCount;        //!< Number of levels
+    uint8_t                             bitsPerLevel;      //!< Number of bisections per level
+    std::vector<Id>                     nodeIds;           //!< Ids of the route nodes, sorted
+    std::vector<uint32_t>               nodeCells;         //!< Cell of each node at the lowest level
+    std::vector<uint32_t>               objectOffsets;     //!< Index of the first object of each node, plus end marker
+    std::vector<RouteNode::ObjectData>  objects;           //!< Objects of all nodes
+    std::vector<uint32_t>               pathOffsets;       //!< Index of the first path of each node, plus end marker
+    std::vector<RouteNode::Path>        paths;             //!< Paths of all nodes
+    std::vector<uint32_t>               pathTargets;       //!< Index of the target node of each path or noNode
+    std::vector<ObjectVariantData>      objectVariantData; //!< Object variant data of the routing graph
+    std::vector<Level>                  levels;            //!< Levels, starting with the lowest
+
+  private:
+    inline uint32_t GetCell(uint32_t node,
+                            size_t level) const
+    {
+      return nodeCells[node] >> ((level-1)*bitsPerLevel);
+    }
+
+    void Partition(const std::vector<GeoCoord>& coords);
+    void SetupLevels();
+
+    void SearchCell(const Metric& metric,
+                    size_t level,
+                    uint32_t cell,
+                    uint32_t from,
+                    uint32_t to,
+                    Labels& labels) const;
+
+    void CustomizeCell(Metric& metric,
+                       size_t level,
+                       uint32_t cell) const;
+
+    bool UnpackClique(const Metric& metric,
+                      size_t level,
+                      uint32_t from,
+                      uint32_t to,
+                      std::vector<Step>& steps) const;
+
+  public:
+    RoutePartition();
+
+    RoutePartition(const RoutePartition&) = delete;
+    RoutePartition(RoutePartition&&) = delete;
+    RoutePartition& operator=(const RoutePartition&) = delete;
+    RoutePartition& operator=(RoutePartition&&) = delete;
+
+    bool Build(Progress& progress,
+               const TypeConfig& typeConfig,
+               const std::string& path,
+               const std::string& filenamebase,
+               size_t cellSize,
+               uint8_t bitsPerLevel);
+
+    bool Load(const TypeConfig& typeConfig,
+              const std::string& filename);
+    bool Store(const std::string& filename) const;
+
+    inline size_t GetNodeCount() const
+    {
+      return nodeIds.size();
+    }
+
+    inline size_t GetLevelCount() const
+    {
+      return levelCount;
+    }
+
+    size_t GetCellCount(size_t level) const;
+    size_t GetBoundaryNodeCount(size_t level) const;
+
+    uint32_t GetNodeIndex(Id id) const;
+
+    MetricRef Customize(const RoutingProfile& profile,
+                        size_t threadCount) const;
+
+    bool CalculateRoute(const Metric& metric,
+                        const std::vector<Endpoint>& sources,
+                        const std::vector<Endpoint>& targets,
+                        Route& route) const;
+  };
+
+  using RoutePartitionRef = std::shared_ptr<RoutePartition>;
+}
+
+#endif
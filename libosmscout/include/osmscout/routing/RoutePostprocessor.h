@@ -23,6 +23,8 @@
 #include <list>
 #include <map>
 #include <memory>
+#include <set>
+#include <string>
 #include <unordered_map>
 
 #include <osmscout/CoreFeatures.h>
@@ -67,6 +69,29 @@ namespace osmscout {
 
       virtual bool Process(const RoutePostprocessor& postprocessor,
                            RouteDescription& description) = 0;
+
+      /**
+       * Return true, if Process() only adds descriptions to the nodes and may run
+       * concurrently to other postprocessors, see RoutePostprocessor::SetThreadCount().
+       * Other postprocessors always run alone.
+       */
+      virtual bool CanRunConcurrently() const;
+
+      /**
+       * Names of the descriptions read by Process()
+       */
+      virtual std::set<std::string> GetRequiredDescriptions() const;
+
+      /**
+       * Names of the descriptions added by Process()
+       */
+      virtual std::set<std::string> GetProvidedDescriptions() const;
+
+      /**
+       * Return true, if Process() calls LoadJunction(), so that the junctions
+       * are loaded together with the ways and areas of the route
+       */
+      virtual bool NeedsJunctions() const;
     };
 
     using PostprocessorRef = std::shared_ptr<Postprocessor>;
@@ -85,6 +110,9 @@ namespace osmscout {
 
       bool Process(const RoutePostprocessor& postprocessor,
                    RouteDescription& description) override;
+
+      bool CanRunConcurrently() const override;
+      std::set<std::string> GetProvidedDescriptions() const override;
     };
 
     /**
@@ -101,6 +129,9 @@ namespace osmscout {
 
       bool Process(const RoutePostprocessor& postprocessor,
                    RouteDescription& description) override;
+
+      bool CanRunConcurrently() const override;
+      std::set<std::string> GetProvidedDescriptions() const override;
     };
 
     /**
@@ -127,6 +158,9 @@ namespace osmscout {
 
       bool Process(const RoutePostprocessor& postprocessor,
                    RouteDescription& description) override;
+
+      bool CanRunConcurrently() const override;
+      std::set<std::string> GetProvidedDescriptions() const override;
     };
 
     /**
@@ -140,6 +174,9 @@ namespace osmscout {
 
       bool Process(const RoutePostprocessor& postprocessor,
                    RouteDescription& description) override;
+
+      bool CanRunConcurrently() const override;
+      std::set<std::string> GetProvidedDescriptions() const override;
     };
 
     /**
@@ -160,6 +197,9 @@ namespace osmscout {
 
       bool Process(const RoutePostprocessor& postprocessor,
                    RouteDescription& description) override;
+
+      bool CanRunConcurrently() const override;
+      std::set<std::string> GetProvidedDescriptions() const override;
     };
 
     /**
@@ -180,6 +220,9 @@ namespace osmscout {
 
       bool Process(const RoutePostprocessor& postprocessor,
                    RouteDescription& description) override;
+
+      bool CanRunConcurrently() const override;
+      std::set<std::string> GetProvidedDescriptions() const override;
     };
 
     /**
@@ -193,6 +236,10 @@ namespace osmscout {
 
       bool Process(const RoutePostprocessor& postprocessor,
                    RouteDescription& description) override;
+
+      bool CanRunConcurrently() const override;
+      std::set<std::string> GetProvidedDescriptions() const override;
+      bool NeedsJunctions() const override;
     };
 
     /**
@@ -206,6 +253,9 @@ namespace osmscout {
 
       bool Process(const RoutePostprocessor& postprocessor,
                    RouteDescription& description) override;
+
+      bool CanRunConcurrently() const override;
+      std::set<std::string> GetProvidedDescriptions() const override;
     };
 
     /**
@@ -219,6 +269,9 @@ namespace osmscout {
 
       bool Process(const RoutePostprocessor& postprocessor,
                    RouteDescription& description) override;
+
+      bool CanRunConcurrently() const override;
+      std::set<std::string> GetProvidedDescriptions() const override;
     };
 
     /**
@@ -252,16 +305,20 @@ namespace osmscout {
                                      const RouteDescription::NameDescriptionRef& toName);
       void HandleDirectMotorwayLeave(RouteDescription::Node& node,
                                      const RouteDescription::NameDescriptionRef& fromName);
-      bool HandleNameChange(const std::list<RouteDescription::Node>& path,
-                            std::list<RouteDescription::Node>::const_iterator& lastNode,
-                            std::list<RouteDescription::Node>::iterator& node);
-      bool HandleDirectionChange(const std::list<RouteDescription::Node>& path,
-                                 std::list<RouteDescription::Node>::iterator& node);
+      bool HandleNameChange(const std::vector<RouteDescription::Node>& path,
+                            std::vector<RouteDescription::Node>::const_iterator& lastNode,
+                            std::vector<RouteDescription::Node>::iterator& node);
+      bool HandleDirectionChange(const std::vector<RouteDescription::Node>& path,
+                                 std::vector<RouteDescription::Node>::iterator& node);
 
     public:
       bool Process(const RoutePostprocessor& postprocessor,
                    RouteDescription& description) override;
 
+      bool CanRunConcurrently() const override;
+      std::set<std::string> GetRequiredDescriptions() const override;
+      std::set<std::string> GetProvidedDescriptions() const override;
+
     };
 
     using InstructionPostprocessorRef = std::shared_ptr<InstructionPostprocessor>;
@@ -278,22 +335,22 @@ namespace osmscout {
         ObjectFileRef                               object;
         RouteDescription::NameDescriptionRef        name;
         Distance                                    distance;
-        std::list<RouteDescription::Node>::iterator node;
+        std::vector<RouteDescription::Node>::iterator node;
       };
 
     private:
-      std::set<ObjectFileRef> CollectPaths(const std::list<RouteDescription::Node>& nodes) const;
+      std::set<ObjectFileRef> CollectPaths(const std::vector<RouteDescription::Node>& nodes) const;
       std::list<WayRef> CollectWays(const RoutePostprocessor& postprocessor,
-                                    const std::list<RouteDescription::Node>& nodes) const;
+                                    const std::vector<RouteDescription::Node>& nodes) const;
       std::list<AreaRef> CollectAreas(const RoutePostprocessor& postprocessor,
-                                      const std::list<RouteDescription::Node>& nodes) const;
+                                      const std::vector<RouteDescription::Node>& nodes) const;
       std::map<ObjectFileRef,std::set<ObjectFileRef>> CollectPOICandidates(const Database& database,
                                                                            const std::set<ObjectFileRef>& paths,
                                                                            const std::list<WayRef>& ways,
                                                                            const std::list<AreaRef>& areas);
       std::map<ObjectFileRef,POIAtRoute> AnalysePOICandidates(const RoutePostprocessor& postprocessor,
                                                               const DatabaseId& databaseId,
-                                                              std::list<RouteDescription::Node>& nodes,
+                                                              std::vector<RouteDescription::Node>& nodes,
                                                               const TypeInfoSet& nodeTypes,
                                                               const TypeInfoSet& areaTypes,
                                                               const std::unordered_map<FileOffset,NodeRef>& nodeMap,
@@ -307,6 +364,9 @@ namespace osmscout {
 
       bool Process(const RoutePostprocessor& postprocessor,
                    RouteDescription& description) override;
+
+      bool CanRunConcurrently() const override;
+      std::set<std::string> GetProvidedDescriptions() const override;
     };
 
     using POIsPostprocessorRef = std::shared_ptr<POIsPostprocessor>;
@@ -322,6 +382,9 @@ namespace osmscout {
 
       bool Process(const RoutePostprocessor& postprocessor,
                    RouteDescription& description) override;
+
+      bool CanRunConcurrently() const override;
+      std::set<std::string> GetProvidedDescriptions() const override;
     };
 
     using LanesPostprocessorRef = std::shared_ptr<LanesPostprocessor>;
@@ -339,6 +402,10 @@ namespace osmscout {
 
       bool Process(const RoutePostprocessor& postprocessor,
                    RouteDescription& description) override;
+
+      bool CanRunConcurrently() const override;
+      std::set<std::string> GetRequiredDescriptions() const override;
+      std::set<std::string> GetProvidedDescriptions() const override;
     private:
       Distance distanceBefore;
     };
@@ -365,10 +432,30 @@ namespace osmscout {
     std::unordered_map<DatabaseId,TypeInfoSet>                    motorwayLinkTypes;
     std::unordered_map<DatabaseId,TypeInfoSet>                    junctionTypes;
 
+    bool                                                          junctionsResolved=false;
+    std::unordered_map<DatabaseId,std::map<GeoCoord,NodeRef>>     junctionMap;  //!< Junction nodes at the coordinates of the route
+
+    size_t                                                        threadCount=1;
+    Distance                                                      contextDistance=Kilometers(1);
+
   private:
     bool ResolveAllAreasAndWays(const RouteDescription& description,
                                 DatabaseId dbId,
                                 Database& database);
+    bool ResolveAllJunctions(const RouteDescription& description,
+                             DatabaseId dbId,
+                             Database& database);
+    bool Initialize(const RouteDescription& description,
+                    const std::vector<RoutingProfileRef>& profiles,
+                    const std::vector<DatabaseRef>& databases,
+                    const std::list<PostprocessorRef>& processors,
+                    const std::set<std::string>& motorwayTypeNames,
+                    const std::set<std::string>& motorwayLinkTypeNames,
+                    const std::set<std::string>& junctionTypeNames);
+    bool ExecuteProcessors(RouteDescription& description,
+                           const std::list<PostprocessorRef>& processors) const;
+    bool ExecuteProcessorsConcurrently(RouteDescription& description,
+                                       const std::list<PostprocessorRef>& processors) const;
     void Cleanup();
 
   private:
@@ -389,9 +476,9 @@ namespace osmscout {
                                                             const Way& way) const;
 
     bool LoadJunction(DatabaseId database,
-                      GeoCoord coord,
-                      std::string junctionRef,
-                      std::string junctionName) const;
+                      const GeoCoord& coord,
+                      std::string& junctionRef,
+                      std::string& junctionName) const;
 
     bool IsMotorwayLink(const RouteDescription::Node& node) const;
     bool IsMotorway(const RouteDescription::Node& node) const;
@@ -442,6 +529,9 @@ namespace osmscout {
      */
     friend Postprocessor;
 
+    void SetThreadCount(size_t threadCount);
+    void SetContextDistance(const Distance& contextDistance);
+
     bool PostprocessRouteDescription(RouteDescription& description,
                                      const std::vector<RoutingProfileRef>& profiles,
                                      const std::vector<DatabaseRef>& databases,
@@ -449,6 +539,15 @@ namespace osmscout {
                                      const std::set<std::string>& motorwayTypeNames=std::set<std::string>(),
                                      const std::set<std::string>& motorwayLinkTypeNames=std::set<std::string>(),
                                      const std::set<std::string>& junctionTypeNames=std::set<std::string>());
+
+    bool PostprocessRouteDescriptionSuffix(RouteDescription& description,
+                                           size_t firstNode,
+                                           const std::vector<RoutingProfileRef>& profiles,
+                                           const std::vector<DatabaseRef>& databases,
+                                           const std::list<PostprocessorRef>& processors,
+                                           const std::set<std::string>& motorwayTypeNames=std::set<std::string>(),
+                                           const std::set<std::string>& motorwayLinkTypeNames=std::set<std::string>(),
+                                           const std::set<std::string>& junctionTypeNames=std::set<std::string>());
   };
 }
 
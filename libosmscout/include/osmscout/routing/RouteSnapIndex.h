@@ -0,0 +1,193 @@
+#ifndef OSMSCOUT_ROUTESNAPINDEX_H
+#define OSMSCOUT_ROUTESNAPINDEX_H
+
+/*
+  This source is part of the libosmscout library
+  Copyright (C) 2026  Tim Teulings
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307  USA
+*/
+
+#include <functional>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include <osmscout/CoreImportExport.h>
+
+#include <osmscout/GeoCoord.h>
+#include <osmscout/ObjectRef.h>
+#include <osmscout/TypeConfig.h>
+
+#include <osmscout/util/Distance.h>
+#include <osmscout/util/FileScannerPool.h>
+#include <osmscout/util/Progress.h>
+
+#include <osmscout/system/Compiler.h>
+
+namespace osmscout {
+
+  /**
+   * \ingroup Routing
+   *
+   * Spatial index of all routable segments (the line between two consecutive
+   * nodes of a routable way or area) for snapping coordinates to the
+   * routing graph.
+   *
+   * The index is a packed R-tree: the segments are sorted by
+   * sort-tile-recursive order and stored as the leaves, each upper level
+   * holds the bounding boxes of runs of 16 nodes of the level below.
+   * All records have a fixed size, so the tree is navigated by computing
+   * file positions only. Queries do a best-first search on the tree and
+   * only touch the few pages along the path to the closest segment, which
+   * makes the file well suited for memory mapping.
+   *
+   * Distances are compared on the plane of longitude and latitude, like
+   * in SimpleRoutingService::GetClosestRoutableNode().
+   *
+   * All const methods are thread-safe.
+   */
+  class OSMSCOUT_API RouteSnapIndex CLASS_FINAL
+  {
+  public:
+    /**
+     * A segment of a routable way or area
+     */
+    struct OSMSCOUT_API Segment
+    {
+      ObjectFileRef object;         //!< The way or area
+      uint32_t      nodeIndex=0;    //!< Index of the first node of the segment
+      VehicleMask   vehicles=0;     //!< Vehicles allowed to use the object
+      GeoCoord      from;
+      GeoCoord      to;
+    };
+
+    /**
+     * Result of a snapping query
+     */
+    struct OSMSCOUT_API Match
+    {
+      Segment  segment;             //!< The closest segment
+      double   fraction=0.0;        //!< Position of the closest point on the segment (0.0 is from, 1.0 is to)
+      GeoCoord point;               //!< The closest point on the segment
+      Distance distance;            //!< Distance of the closest point to the query coordinate
+
+      /**
+       * Index of the node of the segment closest to the query coordinate. For
+       * the closing segment of an area ring the index may be the number of
+       * nodes of the ring.
+       */
+      inline size_t GetNodeIndex() const
+      {
+        return fraction<0.5 ? segment.nodeIndex : segment.nodeIndex+1;
+      }
+    };
+
+    /**
+     * Further restricts the segments a coordinate may be snapped to, called
+     * for candidates in the order of increasing distance
+     */
+    using SegmentFilter = std::function<bool(const Segment&)>;
+
+  private:
+    struct QueueEntry
+    {
+      double distance;
+      size_t level;                 //!< Level of the tree node, 0 for segments
+      size_t index;                 //!< Tree node, index into the candidates for segments
+
+      inline bool operator<(const QueueEntry& other) const
+      {
+        return distance>other.distance;
+      }
+    };
+
+    struct Candidate
+    {
+      Segment  segment;
+      double   fraction;
+      GeoCoord point;
+    };
+
+    static constexpr size_t nodeSize=16; //!< Number of children of an inner node
+
+    FileScannerPool       scannerPool;
+    uint32_t              segmentCount=0;
+    uint8_t               fileOffsetBytes=0;
+    std::vector<uint32_t> levelEnds;     //!< End (exclusive) of the node indexes of each level, leaves first
+    FileOffset            boxesOffset=0;
+    FileOffset            segmentsOffset=0;
+
+  private:
+    size_t GetSegmentRecordSize() const;
+    size_t GetLevelStart(size_t level) const;
+    void ReadSegment(FileScanner& scanner,
+                     Segment& segment) const;
+    void Search(FileScanner& scanner,
+                const GeoCoord& coord,
+                VehicleMask vehicles,
+                const Distance& maxDistance,
+                const SegmentFilter& filter,
+                size_t maxCount,
+                std::vector<Match>& matches) const;
+
+  public:
+    RouteSnapIndex() = default;
+    ~RouteSnapIndex();
+
+    static bool Build(Progress& progress,
+                      const TypeConfig& typeConfig,
+                      const std::string& path,
+                      VehicleMask vehicles,
+                      const std::string& filename);
+
+    bool Open(const std::string& filename,
+              bool memoryMapped);
+    bool IsOpen() const;
+    void Close();
+
+    inline size_t GetSegmentCount() const
+    {
+      return segmentCount;
+    }
+
+    bool GetClosest(const GeoCoord& coord,
+                    VehicleMask vehicles,
+                    const Distance& maxDistance,
+                    const SegmentFilter& filter,
+                    Match& match) const;
+
+    bool GetClosest(const std::vector<GeoCoord>& coords,
+                    VehicleMask vehicles,
+                    const Distance& maxDistance,
+                    const SegmentFilter& filter,
+                    std::vector<std::optional<Match>>& matches) const;
+
+    bool GetCandidates(const GeoCoord& coord,
+                       VehicleMask vehicles,
+                       const Distance& maxDistance,
+                       const SegmentFilter& filter,
+                       size_t maxCount,
+                       std::vector<Match>& matches) const;
+  };
+
+  /**
+   * \ingroup Routing
+   */
+  using RouteSnapIndexRef = std::shared_ptr<RouteSnapIndex>;
+}
+
+#endif
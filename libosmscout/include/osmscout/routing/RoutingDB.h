@@ -21,6 +21,7 @@
 */
 
 #include <memory>
+#include <mutex>
 
 #include <osmscout/Database.h>
 #include <osmscout/DataFile.h>
@@ -29,6 +30,7 @@
 
 #include <osmscout/routing/RouteNode.h>
 #include <osmscout/routing/RouteNodeDataFile.h>
+#include <osmscout/routing/SpeedProfiles.h>
 
 namespace osmscout {
 
@@ -36,6 +38,9 @@ namespace osmscout {
    * \ingroup Routing
    *
    * Encapsulation of the routing relevant data files, similar to Database.
+   *
+   * After Open() (and LoadGraph()) all read access is thread-safe, so one
+   * instance can serve concurrent routing requests.
    */
   class RoutingDatabase CLASS_FINAL
   {
@@ -44,7 +49,9 @@ namespace osmscout {
     std::string                      path;
     RouteNodeDataFile                routeNodeDataFile;
     IndexedDataFile<Id,Intersection> junctionDataFile;      //!< Cached access to the 'junctions.dat' file
+    std::mutex                       junctionMutex;         //!< Mutex to secure lazy opening of the junction file
     ObjectVariantDataFile            objectVariantDataFile;
+    SpeedProfilesRef                 speedProfiles;         //!< Optional historical speed profiles
 
   public:
     RoutingDatabase();
@@ -52,6 +59,8 @@ namespace osmscout {
     bool Open(const DatabaseRef& database);
     void Close();
 
+    bool LoadGraph();
+
     inline bool GetRouteNode(const Id& id,
                              RouteNodeRef& node)
     {
@@ -79,6 +88,17 @@ namespace osmscout {
                                    routeNodes);
     }
 
+    /**
+     * Append the predecessors of the route node, that have no path back
+     * (see RouteNodeDataFile::GetPredecessors())
+     */
+    inline bool GetPredecessors(const Id& id,
+                                std::vector<std::pair<Id,ObjectFileRef>>& sources) const
+    {
+      return routeNodeDataFile.GetPredecessors(id,
+                                               sources);
+    }
+
     bool GetJunctions(const std::set<Id>& ids,
                       std::vector<JunctionRef>& junctions);
 
@@ -87,12 +107,40 @@ namespace osmscout {
       return objectVariantDataFile.GetData();
     }
 
+    /**
+     * Return the speed profiles of the ways or nullptr, if there are none
+     */
+    inline const SpeedProfiles* GetSpeedProfiles() const
+    {
+      return speedProfiles.get();
+    }
+
+    /**
+     * Replace the speed profiles loaded on Open(). Must not be called while
+     * routing.
+     */
+    inline void SetSpeedProfiles(const SpeedProfilesRef& speedProfiles)
+    {
+      this->speedProfiles=speedProfiles;
+    }
+
     inline bool ContainsNode(const Id id) const
     {
       RouteNodeRef node;
       routeNodeDataFile.Get(id, node);
       return (bool)node;
     }
+
+    /**
+     * Return the ids of all route nodes that are contained in this and in the other
+     * database, sorted
+     */
+    inline bool GetSharedNodeIds(const RoutingDatabase& other,
+                                 std::vector<Id>& ids) const
+    {
+      return routeNodeDataFile.GetSharedIds(other.routeNodeDataFile,
+                                            ids);
+    }
   };
 
   /**
@@ -0,0 +1,183 @@
+#ifndef OSMSCOUT_ROUTINGGRAPH_H
+#define OSMSCOUT_ROUTINGGRAPH_H
+
+/*
+  This source is part of the libosmscout library
+  Copyright (C) 2026  Tim Teulings
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307  USA
+*/
+
+#include <limits>
+#include <vector>
+
+#include <osmscout/CoreImportExport.h>
+
+#include <osmscout/GeoCoord.h>
+#include <osmscout/ObjectRef.h>
+#include <osmscout/OSMScoutTypes.h>
+
+#include <osmscout/routing/RouteNode.h>
+
+#include <osmscout/system/Compiler.h>
+
+namespace osmscout {
+
+  /**
+   * \ingroup Routing
+   *
+   * The complete routing graph of one routing database in compressed sparse
+   * row (CSR) layout.
+   *
+   * Nodes are addressed by their index (the order they were added in), all
+   * data is held in flat arrays without per node allocations. The objects,
+   * paths and excludes of a node are the ranges [offsets[node],offsets[node+1])
+   * of the corresponding arrays. Path targets are node indices, so following
+   * a path does not need a lookup. Ids are mapped to indices by an open
+   * addressing hash table of node indices.
+   *
+   * GetRouteNode() restores the RouteNode of an index for code working on
+   * RouteNode, like the routing profiles.
+   *
+   * The graph is immutable after building, all const methods are thread-safe.
+   */
+  class OSMSCOUT_API RoutingGraph CLASS_FINAL
+  {
+  public:
+    static const uint32_t noNode = std::numeric_limits<uint32_t>::max();
+
+  private:
+    std::vector<Id>                     nodeIds;          //!< Id of each node
+    std::vector<GeoCoord>               nodeCoords;       //!< Coordinate of each node
+    std::vector<FileOffset>             nodeFileOffsets;  //!< File offset of each node in the data file
+    std::vector<uint32_t>               objectOffsets;    //!< Index of the first object of each node, plus end marker
+    std::vector<RouteNode::ObjectData>  objects;          //!< Objects of all nodes
+    std::vector<uint32_t>               pathOffsets;      //!< Index of the first path of each node, plus end marker
+    std::vector<uint32_t>               pathTargets;      //!< Index of the target node of each path
+    std::vector<Distance>               pathDistances;    //!< Distance of each path
+    std::vector<uint8_t>                pathObjects;      //!< Object index (relative to the node) of each path
+    std::vector<uint8_t>                pathFlags;        //!< Usage and restriction flags of each path
+    std::vector<uint32_t>               excludeOffsets;   //!< Index of the first exclude of each node, plus end marker
+    std::vector<RouteNode::Exclude>     excludes;         //!< Turn restrictions of all nodes
+    std::vector<uint32_t>               idTable;          //!< Hash table of node indices, noNode for empty slots
+    size_t                              idMask;           //!< Size of the hash table minus one
+    std::vector<Id>                     pathTargetIds;    //!< Target ids of the paths until Finish() is called
+
+  private:
+    static size_t Hash(Id id)
+    {
+      uint64_t hash=id*0x9E3779B97F4A7C15ull;
+
+      return size_t(hash ^ (hash >> 32));
+    }
+
+  public:
+    RoutingGraph();
+
+    RoutingGraph(const RoutingGraph&) = delete;
+    RoutingGraph(RoutingGraph&&) = delete;
+    RoutingGraph& operator=(const RoutingGraph&) = delete;
+    RoutingGraph& operator=(RoutingGraph&&) = delete;
+
+    void Clear();
+    void Reserve(size_t nodeCount);
+    void AddNode(const RouteNode& routeNode);
+    size_t Finish();
+
+    inline size_t GetNodeCount() const
+    {
+      return nodeIds.size();
+    }
+
+    inline size_t GetPathCount() const
+    {
+      return pathTargets.size();
+    }
+
+    inline const std::vector<Id>& GetNodeIds() const
+    {
+      return nodeIds;
+    }
+
+    /**
+     * Return the index of the node with the given id or noNode, if the
+     * node is not part of the graph
+     */
+    inline uint32_t GetNodeIndex(Id id) const
+    {
+      if (idTable.empty()) {
+        return noNode;
+      }
+
+      for (size_t slot=Hash(id) & idMask;
+           idTable[slot]!=noNode;
+           slot=(slot+1) & idMask) {
+        if (nodeIds[idTable[slot]]==id) {
+          return idTable[slot];
+        }
+      }
+
+      return noNode;
+    }
+
+    inline Id GetNodeId(uint32_t node) const
+    {
+      return nodeIds[node];
+    }
+
+    inline const GeoCoord& GetNodeCoord(uint32_t node) const
+    {
+      return nodeCoords[node];
+    }
+
+    inline uint32_t GetPathBegin(uint32_t node) const
+    {
+      return pathOffsets[node];
+    }
+
+    inline uint32_t GetPathEnd(uint32_t node) const
+    {
+      return pathOffsets[node+1];
+    }
+
+    inline uint32_t GetPathTarget(uint32_t path) const
+    {
+      return pathTargets[path];
+    }
+
+    inline Distance GetPathDistance(uint32_t path) const
+    {
+      return pathDistances[path];
+    }
+
+    inline uint8_t GetPathFlags(uint32_t path) const
+    {
+      return pathFlags[path];
+    }
+
+    inline const ObjectFileRef& GetPathObject(uint32_t path,
+                                              uint32_t node) const
+    {
+      return objects[objectOffsets[node]+pathObjects[path]].object;
+    }
+
+    void GetRouteNode(uint32_t node,
+                      RouteNode& routeNode) const;
+
+    size_t GetMemoryUsage() const;
+  };
+}
+
+#endif
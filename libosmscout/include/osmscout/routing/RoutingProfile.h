@@ -31,6 +31,7 @@
 #include <osmscout/FeatureReader.h>
 
 #include <osmscout/Way.h>
+#include <osmscout/WayView.h>
 #include <osmscout/Area.h>
 
 #include <osmscout/util/Time.h>
@@ -61,6 +62,7 @@ namespace osmscout {
                         size_t pathIndex) const = 0;
     virtual bool CanUse(const Area& area) const = 0;
     virtual bool CanUse(const Way& way) const = 0;
+    virtual bool CanUse(const WayView& way) const = 0;
     virtual bool CanUseForward(const Way& way) const = 0;
     virtual bool CanUseBackward(const Way& way) const = 0;
 
@@ -99,6 +101,27 @@ namespace osmscout {
                              const Distance &distance) const = 0;
     virtual Duration GetTime(const Way& way,
                              const Distance &distance) const = 0;
+
+    /**
+     * Time for the outgoing path (pathIndex) from currentNode, without junction penalties
+     */
+    virtual Duration GetTime(const RouteNode& currentNode,
+                             const std::vector<ObjectVariantData>& objectVariantData,
+                             size_t pathIndex) const = 0;
+
+    /**
+     * Return true, if the costs of the profile are the travel time in hours plus
+     * penalties, like for FastestPathRoutingProfile
+     */
+    virtual bool HasTimeCosts() const;
+
+    /**
+     * Return a textual description of all parameters the costs of a single path
+     * (without junction penalties) depend on. Profiles returning the same description
+     * calculate the same path costs. An empty string is returned, if the parameters are
+     * not known and the costs thus cannot be compared.
+     */
+    virtual std::string GetCostParameters() const;
   };
 
   using RoutingProfileRef = std::shared_ptr<RoutingProfile>;
@@ -123,6 +146,12 @@ namespace osmscout {
     double                     maxSpeed;
     double                     vehicleMaxSpeed;
 
+  protected:
+    bool CanUse(const TypeInfoRef& type,
+                const FeatureValueBuffer& featureValueBuffer) const;
+
+    std::string GetCommonCostParameters() const;
+
   public:
     explicit AbstractRoutingProfile(const TypeConfigRef& typeConfig);
 
@@ -173,6 +202,7 @@ namespace osmscout {
                 size_t pathIndex) const override;
     bool CanUse(const Area& area) const override;
     bool CanUse(const Way& way) const override;
+    bool CanUse(const WayView& way) const override;
     bool CanUseForward(const Way& way) const override;
     bool CanUseBackward(const Way& way) const override;
 
@@ -205,6 +235,26 @@ namespace osmscout {
 
       return DurationOfHours(distance.As<Kilometer>()/speed);
     }
+
+    inline Duration GetTime(const RouteNode& currentNode,
+                            const std::vector<ObjectVariantData>& objectVariantData,
+                            size_t pathIndex) const override
+    {
+      const RouteNode::Path&   path=currentNode.paths[pathIndex];
+      const ObjectVariantData& variant=objectVariantData[currentNode.objects[path.objectIndex].objectVariantIndex];
+      double                   speed;
+
+      if (variant.maxSpeed>0) {
+        speed=variant.maxSpeed;
+      }
+      else {
+        speed=speeds[variant.type->GetIndex()];
+      }
+
+      speed=std::min(vehicleMaxSpeed,speed);
+
+      return DurationOfHours(path.distance.As<Kilometer>()/speed);
+    }
   };
 
   /**
@@ -245,6 +295,8 @@ namespace osmscout {
     {
       return Kilometers(cost).AsString();
     }
+
+    std::string GetCostParameters() const override;
   };
 
   using ShortestPathRoutingProfileRef = std::shared_ptr<ShortestPathRoutingProfile>;
@@ -265,6 +317,20 @@ namespace osmscout {
   public:
     explicit FastestPathRoutingProfile(const TypeConfigRef& typeConfig);
 
+    bool HasTimeCosts() const override
+    {
+      return true;
+    }
+
+    std::string GetCostParameters() const override;
+
+    void SetJunctionPenalty(bool applyJunctionPenalty);
+
+    inline bool GetJunctionPenalty() const
+    {
+      return applyJunctionPenalty;
+    }
+
     void ParametrizeForFoot(const TypeConfig& typeConfig,
                             double maxSpeed) override
     {
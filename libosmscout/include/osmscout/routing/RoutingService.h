@@ -20,13 +20,17 @@
   Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307  USA
 */
 
+#include <algorithm>
 #include <atomic>
 #include <functional>
+#include <limits>
 #include <list>
 #include <memory>
+#include <optional>
 #include <set>
 #include <unordered_map>
 #include <unordered_set>
+#include <vector>
 
 #include <osmscout/CoreFeatures.h>
 
@@ -48,9 +52,11 @@
 #include <osmscout/routing/RouteNodeDataFile.h>
 #include <osmscout/routing/RoutingProfile.h>
 #include <osmscout/routing/DBFileOffset.h>
+#include <osmscout/routing/DBIdHashMap.h>
 
 #include <osmscout/util/Breaker.h>
 #include <osmscout/util/Cache.h>
+#include <osmscout/util/Time.h>
 
 #include <osmscout/system/Compiler.h>
 
@@ -131,18 +137,24 @@ namespace osmscout {
    *
    * The following groups attributes are currently available:
    * - Switch for showing debug information
+   * - Switch for loading the complete routing graph into memory on Open().
+   *   Route nodes are then resolved without page cache and without locking.
+   *   This trades memory for speed and is meant for routing servers.
    */
   class OSMSCOUT_API RouterParameter CLASS_FINAL
   {
   private:
     bool          debugPerformance;
+    bool          inMemoryGraph;
 
   public:
     RouterParameter();
 
     void SetDebugPerformance(bool debug);
+    void SetInMemoryGraph(bool inMemoryGraph);
 
     bool IsDebugPerformance() const;
+    bool IsInMemoryGraph() const;
   };
 
   /**
@@ -181,16 +193,34 @@ namespace osmscout {
    *
    * Parameter object for routing calculations. Holds all optional
    * flags and callback objects that can be passed to the router
+   *
+   * If bidirectional is set, the route is searched from start and target
+   * at the same time. This visits roughly half of the route nodes of the
+   * unidirectional search.
+   *
+   * The thread count is the number of threads calculating the rows of a
+   * routing matrix in parallel. 0 (the default) means the number of hardware
+   * threads.
+   *
+   * If a departure time is set, CalculateRoute() searches the route with the
+   * earliest arrival, taking the historical speed profiles of the ways at the
+   * time they are passed into account (see SpeedProfiles).
    */
   class OSMSCOUT_API RoutingParameter CLASS_FINAL
   {
   private:
-    BreakerRef         breaker;
-    RoutingProgressRef progress;
+    BreakerRef               breaker;
+    RoutingProgressRef       progress;
+    bool                     bidirectional=false;
+    size_t                   threadCount=0;
+    std::optional<Timestamp> departureTime;
 
   public:
     void SetBreaker(const BreakerRef& breaker);
     void SetProgress(const RoutingProgressRef& progress);
+    void SetBidirectional(bool bidirectional);
+    void SetThreadCount(size_t threadCount);
+    void SetDepartureTime(const std::optional<Timestamp>& departureTime);
 
     inline BreakerRef GetBreaker() const
     {
@@ -201,6 +231,21 @@ namespace osmscout {
     {
       return progress;
     }
+
+    inline bool IsBidirectional() const
+    {
+      return bidirectional;
+    }
+
+    inline size_t GetThreadCount() const
+    {
+      return threadCount;
+    }
+
+    inline const std::optional<Timestamp>& GetDepartureTime() const
+    {
+      return departureTime;
+    }
   };
 
   /**
@@ -211,6 +256,8 @@ namespace osmscout {
   class OSMSCOUT_API RoutingService
   {
   protected:
+    static constexpr size_t OpenListNPos = std::numeric_limits<size_t>::max();
+
     /**
      * \ingroup Routing
      *
@@ -229,6 +276,9 @@ namespace osmscout {
       double        overallCost;   //!< The overall costs (currentCost+estimateCost)
 
       bool          access;        //!< Flags to signal, if we had access ("access restrictions") to this node
+      uint32_t      slot=0;        //!< Index of the RNode in its RNodePool, see RNodeLabels
+
+      size_t        heapIndex=OpenListNPos; //!< Position in the OpenList, OpenListNPos if not (longer) open
 
       RNode() = default;
 
@@ -273,7 +323,11 @@ namespace osmscout {
       }
     };
 
-    using RNodeRef = std::shared_ptr<RNode>;
+    /**
+     * RNodes are owned by the RNodePool of the routing run, so a reference
+     * is a plain pointer
+     */
+    using RNodeRef = RNode*;
 
     struct RNodeCostCompare
     {
@@ -288,6 +342,201 @@ namespace osmscout {
       }
     };
 
+    /**
+     * \ingroup Routing
+     *
+     * Arena for the RNodes of one routing run. RNodes are allocated in
+     * chunks and are freed all together when the pool gets destroyed,
+     * so the addresses of the RNodes are stable.
+     */
+    class RNodePool CLASS_FINAL
+    {
+    private:
+      static const size_t chunkSize=4096;
+
+      std::vector<std::unique_ptr<RNode[]>> chunks;
+      size_t                                chunkUsed=chunkSize;
+      uint32_t                              size=0;
+
+    public:
+      template<typename... Args>
+      RNodeRef Allocate(Args&&... args)
+      {
+        if (chunkUsed==chunkSize) {
+          chunks.push_back(std::make_unique<RNode[]>(chunkSize));
+          chunkUsed=0;
+        }
+
+        RNodeRef node=&chunks.back()[chunkUsed++];
+
+        *node=RNode(std::forward<Args>(args)...);
+        node->slot=size++;
+
+        return node;
+      }
+    };
+
+    /**
+     * \ingroup Routing
+     *
+     * Labels of the RNodes of one RNodePool, indexed by RNode::slot. Data
+     * only needed by one search algorithm is kept here instead of in RNode,
+     * so the RNodes of all other searches stay small.
+     */
+    template<typename T>
+    class RNodeLabels CLASS_FINAL
+    {
+    private:
+      std::vector<T> labels;
+
+    public:
+      inline T& operator[](const RNode& node)
+      {
+        if (node.slot>=labels.size()) {
+          labels.resize(node.slot+1);
+        }
+
+        return labels[node.slot];
+      }
+    };
+
+    /**
+     * \ingroup Routing
+     *
+     * Indexed 4-ary min heap of the RNodes to check, ordered by RNodeCostCompare.
+     * Each RNode knows its position in the heap (RNode::heapIndex), so the costs
+     * of an RNode in the list can be lowered in place using Update().
+     */
+    class OpenList CLASS_FINAL
+    {
+    private:
+      static const size_t arity=4;
+
+      std::vector<RNodeRef> heap;
+      RNodeCostCompare      less;
+
+    private:
+      void Place(size_t index,
+                 RNodeRef node)
+      {
+        heap[index]=node;
+        node->heapIndex=index;
+      }
+
+      void SiftUp(size_t index)
+      {
+        RNodeRef node=heap[index];
+
+        while (index>0) {
+          size_t parent=(index-1)/arity;
+
+          if (!less(node,heap[parent])) {
+            break;
+          }
+
+          Place(index,heap[parent]);
+          index=parent;
+        }
+
+        Place(index,node);
+      }
+
+      void SiftDown(size_t index)
+      {
+        RNodeRef node=heap[index];
+
+        while (true) {
+          size_t first=index*arity+1;
+
+          if (first>=heap.size()) {
+            break;
+          }
+
+          size_t last=std::min(first+arity,heap.size());
+          size_t smallest=first;
+
+          for (size_t child=first+1; child<last; child++) {
+            if (less(heap[child],heap[smallest])) {
+              smallest=child;
+            }
+          }
+
+          if (!less(heap[smallest],node)) {
+            break;
+          }
+
+          Place(index,heap[smallest]);
+          index=smallest;
+        }
+
+        Place(index,node);
+      }
+
+    public:
+      using const_iterator = std::vector<RNodeRef>::const_iterator;
+
+      void reserve(size_t size)
+      {
+        heap.reserve(size);
+      }
+
+      bool empty() const
+      {
+        return heap.empty();
+      }
+
+      size_t size() const
+      {
+        return heap.size();
+      }
+
+      RNodeRef Top() const
+      {
+        return heap.front();
+      }
+
+      void Push(RNodeRef node)
+      {
+        heap.push_back(node);
+        SiftUp(heap.size()-1);
+      }
+
+      RNodeRef Pop()
+      {
+        RNodeRef top=heap.front();
+        RNodeRef last=heap.back();
+
+        heap.pop_back();
+        top->heapIndex=OpenListNPos;
+
+        if (!heap.empty()) {
+          Place(0,last);
+          SiftDown(0);
+        }
+
+        return top;
+      }
+
+      /**
+       * Restore the heap order after the costs of an RNode in the list changed
+       */
+      void Update(RNodeRef node)
+      {
+        SiftUp(node->heapIndex);
+        SiftDown(node->heapIndex);
+      }
+
+      const_iterator begin() const
+      {
+        return heap.begin();
+      }
+
+      const_iterator end() const
+      {
+        return heap.end();
+      }
+    };
+
     /**
      * \ingroup Routing
      *
@@ -318,6 +567,8 @@ namespace osmscout {
         return currentNode==other.currentNode;
       }
 
+      VNode() = default;
+
       /**
        * Simple inline constructor for searching for VNodes in the
        * ClosedSet.
@@ -352,24 +603,11 @@ namespace osmscout {
       }
     };
 
-    /**
-     * Helper class for calculating hash codes for
-     * VNode instances to make it usable in std::unordered_set.
-     */
-    struct ClosedNodeHasher
-    {
-      inline size_t operator()(const VNode& node) const
-      {
-        return std::hash<Id>()(node.currentNode.id) ^
-               std::hash<DatabaseId>()(node.currentNode.database);
-      }
-    };
-
-    using OpenList    = std::set<RNodeRef, RNodeCostCompare>;
-    using OpenListRef = std::set<RNodeRef, RNodeCostCompare>::iterator;
-
-    using OpenMap     = std::unordered_map<DBId, OpenListRef>;
-    using ClosedSet   = std::unordered_set<VNode, ClosedNodeHasher>;
+    //! Map of the RNodes in the OpenList by route node id. Entries of RNodes
+    //! taken from the OpenList are overwritten, if the route node gets reopened.
+    using OpenMap     = DBIdHashMap<RNodeRef>;
+    //! Set of the route nodes already handled, mapped by their id
+    using ClosedSet   = DBIdHashMap<VNode>;
 
   public:
     //! Relative filename of the intersection data file
@@ -383,6 +621,11 @@ namespace osmscout {
     static std::string GetDataFilename(const std::string& filenamebase);
     static std::string GetData2Filename(const std::string& filenamebase);
     static std::string GetIndexFilename(const std::string& filenamebase);
+    static std::string GetContractionHierarchyFilename(const std::string& filenamebase,
+                                                       Vehicle vehicle);
+    static std::string GetPartitionFilename(const std::string& filenamebase);
+    static std::string GetSpeedProfileFilename(const std::string& filenamebase);
+    static std::string GetSnapIndexFilename(const std::string& filenamebase);
 
   public:
     RoutingService();
@@ -45,7 +45,9 @@
 #include <osmscout/Intersection.h>
 #include <osmscout/routing/RouteDescription.h>
 #include <osmscout/routing/RouteData.h>
+#include <osmscout/routing/MapMatching.h>
 #include <osmscout/routing/RoutingDB.h>
+#include <osmscout/routing/RouteSnapIndex.h>
 #include <osmscout/routing/RoutingProfile.h>
 #include <osmscout/routing/RoutingService.h>
 #include <osmscout/routing/AbstractRoutingService.h>
@@ -121,13 +123,24 @@ namespace osmscout {
     std::string                          path;                  //!< Path to the directory containing all files
 
     RoutingDatabase                      routingDatabase;       //!< Access to routing data and index files
+    RouteSnapIndexRef                    snapIndex;             //!< Optional index of routable segments
 
   private:
     bool HasNodeWithId(const std::vector<Point>& nodes) const;
 
+    RouteSnapIndex::SegmentFilter GetSnapFilter(const RoutingProfile& profile,
+                                                std::unordered_map<FileOffset,bool>& usableWays) const;
+
+    void GetMapMatchCandidates(const RoutingProfile& profile,
+                               const std::vector<GeoCoord>& points,
+                               const MapMatchParameter& matchParameter,
+                               std::vector<std::vector<MapMatchCandidate>>& candidates) const;
+
   protected:
     Vehicle GetVehicle(const RoutingProfile& profile) override;
 
+    bool HasTimeCosts(const RoutingProfile& profile) override;
+
     bool CanUse(const RoutingProfile& profile,
                 DatabaseId database,
                 const RouteNode& routeNode,
@@ -152,6 +165,18 @@ namespace osmscout {
                     const WayRef &way,
                     const Distance &wayLength) override;
 
+    Duration GetTime(const RoutingProfile& profile,
+                     DatabaseId database,
+                     const RouteNode& routeNode,
+                     size_t pathIndex) override;
+
+    Duration GetTime(const RoutingProfile& profile,
+                     DatabaseId database,
+                     const WayRef &way,
+                     const Distance &wayLength) override;
+
+    const SpeedProfiles* GetSpeedProfiles(DatabaseId database) override;
+
     double GetEstimateCosts(const RoutingProfile& profile,
                             DatabaseId database,
                             const Distance &targetDistance) override;
@@ -170,6 +195,9 @@ namespace osmscout {
     bool GetRouteNode(const DBId &id,
                       RouteNodeRef &node) override;
 
+    bool GetRouteNodePredecessors(const DBId &id,
+                                  std::vector<std::pair<Id,ObjectFileRef>> &sources) override;
+
     bool GetWayByOffset(const DBFileOffset &offset,
                         WayRef &way) override;
 
@@ -200,6 +228,9 @@ namespace osmscout {
 
     TypeConfigRef GetTypeConfig() const;
 
+    void SetSpeedProfiles(const SpeedProfilesRef& speedProfiles);
+    void SetSnapIndex(const RouteSnapIndexRef& snapIndex);
+
     RoutingResult CalculateRouteViaCoords(RoutingProfile& profile,
                                           const std::vector<GeoCoord>& via,
                                           const Distance &radius,
@@ -209,6 +240,20 @@ namespace osmscout {
                                                const RoutingProfile& profile,
                                                const Distance &radius) const;
 
+    std::vector<RoutePositionResult> GetClosestRoutableNodes(const std::vector<GeoCoord>& coords,
+                                                             const RoutingProfile& profile,
+                                                             const Distance &radius) const;
+
+    MapMatchResult MatchTrack(RoutingProfile& profile,
+                              const std::vector<GeoCoord>& points,
+                              const MapMatchParameter& matchParameter,
+                              const RoutingParameter& parameter);
+
+    std::vector<MapMatchResult> MatchTracks(RoutingProfile& profile,
+                                            const std::vector<std::vector<GeoCoord>>& tracks,
+                                            const MapMatchParameter& matchParameter,
+                                            const RoutingParameter& parameter);
+
     ClosestRoutableObjectResult GetClosestRoutableObject(const GeoCoord& location,
                                                          Vehicle vehicle,
                                                          const Distance &maxRadius);
@@ -0,0 +1,127 @@
+#ifndef OSMSCOUT_SPEEDPROFILES_H
+#define OSMSCOUT_SPEEDPROFILES_H
+
+/*
+  This source is part of the libosmscout library
+  Copyright (C) 2026  Tim Teulings
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307  USA
+*/
+
+#include <chrono>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <osmscout/CoreImportExport.h>
+
+#include <osmscout/OSMScoutTypes.h>
+
+#include <osmscout/util/Time.h>
+
+#include <osmscout/system/Compiler.h>
+
+namespace osmscout {
+
+  /**
+   * \ingroup Routing
+   *
+   * Historical speed profiles of ways for time-dependent routing.
+   *
+   * A profile holds one speed factor for each slot of a week (starting
+   * Monday 00:00 local time). The factor is stored in percent of the speed
+   * defined by the routing profile, so the same data can be used for all
+   * vehicles. Between the start of two slots the factor is interpolated
+   * linearly.
+   *
+   * The factors of all profiles are stored in one contiguous array, ways
+   * are mapped to their profile by an open addressing hash table of way
+   * file offsets. A lookup is O(1) and touches at most a few cache lines.
+   *
+   * The data is immutable after building or loading, all const methods
+   * are thread-safe.
+   */
+  class OSMSCOUT_API SpeedProfiles CLASS_FINAL
+  {
+  public:
+    static constexpr uint32_t noProfile = std::numeric_limits<uint32_t>::max();
+
+  private:
+    static constexpr FileOffset emptyKey = std::numeric_limits<FileOffset>::max();
+
+    uint16_t                slotsPerDay;
+    std::chrono::minutes    utcOffset;    //!< Offset of the local time of the profiles
+    std::vector<uint8_t>    factors;      //!< Speed factors in percent, slotsPerDay*7 per profile
+    std::vector<FileOffset> wayOffsets;   //!< Hash table keys, emptyKey for empty slots
+    std::vector<uint32_t>   wayProfiles;  //!< Hash table values
+    size_t                  mask=0;
+    size_t                  wayCount=0;
+
+  private:
+    size_t FindSlot(FileOffset wayOffset) const;
+    void Rehash(size_t capacity);
+
+  public:
+    explicit SpeedProfiles(uint16_t slotsPerDay=96,
+                           const std::chrono::minutes& utcOffset=std::chrono::minutes::zero());
+
+    inline uint16_t GetSlotsPerDay() const
+    {
+      return slotsPerDay;
+    }
+
+    inline size_t GetSlotsPerWeek() const
+    {
+      return size_t(slotsPerDay)*7;
+    }
+
+    inline std::chrono::minutes GetUTCOffset() const
+    {
+      return utcOffset;
+    }
+
+    inline size_t GetProfileCount() const
+    {
+      return factors.size()/GetSlotsPerWeek();
+    }
+
+    inline size_t GetWayCount() const
+    {
+      return wayCount;
+    }
+
+    uint32_t AddProfile(const std::vector<uint8_t>& slotFactors);
+    void AssignProfile(FileOffset wayOffset,
+                       uint32_t profile);
+
+    uint32_t GetProfile(FileOffset wayOffset) const;
+    double GetSpeedFactor(uint32_t profile,
+                          const Timestamp& time) const;
+    double GetWaySpeedFactor(FileOffset wayOffset,
+                             const Timestamp& time) const;
+
+    bool Load(const std::string& filename);
+    bool Store(const std::string& filename) const;
+  };
+
+  /**
+   * \ingroup Routing
+   */
+  using SpeedProfilesRef = std::shared_ptr<SpeedProfiles>;
+}
+
+#endif
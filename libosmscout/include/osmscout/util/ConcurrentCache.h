@@ -0,0 +1,480 @@
+#ifndef OSMSCOUT_UTIL_CONCURRENTCACHE_H
+#define OSMSCOUT_UTIL_CONCURRENTCACHE_H
+
+/*
+  This source is part of the libosmscout library
+  Copyright (C) 2026  Tim Teulings
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307  USA
+*/
+
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+#include <osmscout/system/Assert.h>
+#include <osmscout/system/Compiler.h>
+
+#include <osmscout/util/Cache.h>
+#include <osmscout/util/Logger.h>
+#include <osmscout/util/MemoryGovernor.h>
+
+namespace osmscout {
+
+  /**
+   * \ingroup Util
+   * Thread-safe cache with CLOCK eviction, split into a number of independently
+   * locked shards.
+   *
+   * Template parameter class K holds the key value (must be hashable),
+   * parameter class V holds the data class that is to be cached. V should be
+   * cheap to copy (typically a std::shared_ptr), since values are returned by copy.
+   *
+   * * Each key is assigned to one shard by its hash, each shard has its own mutex,
+   *   so concurrent access to different shards does not block.
+   * * Entries are stored in a slot vector per shard, slots of evicted entries are reused.
+   * * Eviction uses the CLOCK (second chance) algorithm. A hit only sets a reference
+   *   bit, it does not reorder any list.
+   * * The limit is either a number of entries or - if a ValueSizer is passed - a
+   *   memory budget in bytes. The limit is split evenly between the shards.
+   * * With a memory budget the cache can be controlled by a MemoryGovernor.
+   *
+   * All methods are thread-safe.
+   */
+  template <class K, class V>
+  class ConcurrentCache CLASS_FINAL : public GovernedCache
+  {
+  public:
+    using ValueSizer    = typename Cache<K,V>::ValueSizer;
+    using ValueSizerRef = std::shared_ptr<ValueSizer>;
+
+    static constexpr size_t DefaultShardCount = 16;
+
+  private:
+    /**
+      An individual entry in the cache
+      */
+    struct Slot
+    {
+      K      key;
+      V      value;
+      size_t cost=0;           //!< Cost of this entry against the shard limit
+      bool   used=false;       //!< Slot holds a valid entry
+      bool   referenced=false; //!< Entry was accessed since the clock hand passed the last time
+    };
+
+    struct Shard
+    {
+      std::mutex                    mutex;
+      std::unordered_map<K, size_t> index;     //!< Key => slot index
+      std::vector<Slot>             slots;     //!< Entry storage
+      std::vector<size_t>           freeSlots; //!< Indexes of unused slots
+      size_t                        hand=0;    //!< Current position of the clock hand
+      size_t                        cost=0;    //!< Current overall cost of all entries
+      size_t                        maxCost=0; //!< Maximum overall cost of the shard
+    };
+
+  private:
+    std::vector<std::unique_ptr<Shard>> shards;
+    mutable std::mutex                  configMutex; //!< Mutex to secure limit and sizer
+    size_t                              maxSize;     //!< Maximum number of entries or bytes, depending on sizer
+    ValueSizerRef                       sizer;       //!< Optional sizer, if set maxSize is a memory budget
+    std::atomic<size_t>                 hits;        //!< Number of successful lookups
+    std::atomic<size_t>                 misses;      //!< Number of failed lookups
+
+  private:
+    Shard& GetShard(const K& key) const
+    {
+      return *shards[std::hash<K>()(key) % shards.size()];
+    }
+
+    /**
+      Size of the management data of an individual entry
+      */
+    static size_t GetEntryOverhead()
+    {
+      return sizeof(Slot)+sizeof(typename std::unordered_map<K, size_t>::value_type)+2*sizeof(void*);
+    }
+
+    size_t GetCost(const ValueSizerRef& currentSizer,
+                   const V& value) const
+    {
+      if (currentSizer) {
+        return currentSizer->GetSize(value)+GetEntryOverhead();
+      }
+
+      return 1;
+    }
+
+    static void RemoveSlot(Shard& shard,
+                           size_t slotIndex)
+    {
+      Slot& slot=shard.slots[slotIndex];
+
+      shard.index.erase(slot.key);
+      shard.cost-=slot.cost;
+
+      slot.value=V();
+      slot.cost=0;
+      slot.used=false;
+      slot.referenced=false;
+
+      shard.freeSlots.push_back(slotIndex);
+    }
+
+    /**
+      Evict entries using the CLOCK algorithm until the shard
+      has room for the given additional cost.
+      */
+    static void StripShard(Shard& shard,
+                           size_t additionalCost)
+    {
+      while (shard.cost>0 &&
+             shard.cost+additionalCost>shard.maxCost) {
+        if (shard.hand>=shard.slots.size()) {
+          shard.hand=0;
+        }
+
+        Slot& slot=shard.slots[shard.hand];
+
+        if (slot.used) {
+          if (slot.referenced) {
+            slot.referenced=false;
+          }
+          else {
+            RemoveSlot(shard,
+                       shard.hand);
+          }
+        }
+
+        shard.hand++;
+      }
+    }
+
+    void DistributeMaxSize()
+    {
+      size_t shardMaxCost=(maxSize+shards.size()-1)/shards.size();
+
+      for (auto& shard : shards) {
+        std::lock_guard<std::mutex> lock(shard->mutex);
+
+        shard->maxCost=shardMaxCost;
+
+        StripShard(*shard,0);
+      }
+    }
+
+  public:
+    /**
+      Create a new cache object with the given maximum number of entries.
+      */
+    explicit ConcurrentCache(size_t maxSize,
+                             size_t shardCount=DefaultShardCount)
+    : maxSize(maxSize),
+      hits(0),
+      misses(0)
+    {
+      shards.reserve(std::max(shardCount,size_t(1)));
+
+      for (size_t s=0; s<std::max(shardCount,size_t(1)); s++) {
+        shards.push_back(std::make_unique<Shard>());
+      }
+
+      DistributeMaxSize();
+    }
+
+    ConcurrentCache(const ConcurrentCache&) = delete;
+    ConcurrentCache(ConcurrentCache&&) = delete;
+    ConcurrentCache& operator=(const ConcurrentCache&) = delete;
+    ConcurrentCache& operator=(ConcurrentCache&&) = delete;
+
+    /**
+     * Returns if the cache is active (maxSize > 0)
+     */
+    bool IsActive() const
+    {
+      std::lock_guard<std::mutex> lock(configMutex);
+
+      return maxSize>0;
+    }
+
+    /**
+      Getting the value with the given key from cache.
+
+      If there is no valued stored with the given key, false will be
+      returned and value will be untouched.
+      */
+    bool GetEntry(const K& key,
+                  V& value)
+    {
+      Shard&                      shard=GetShard(key);
+      std::lock_guard<std::mutex> lock(shard.mutex);
+
+      auto iter=shard.index.find(key);
+
+      if (iter==shard.index.end()) {
+        misses++;
+        return false;
+      }
+
+      Slot& slot=shard.slots[iter->second];
+
+      slot.referenced=true;
+      value=slot.value;
+      hits++;
+
+      return true;
+    }
+
+    /**
+      Set or update the cache with the given value for the given key.
+
+      Values which are larger than the limit of a shard are not cached.
+      */
+    void SetEntry(const K& key,
+                  const V& value)
+    {
+      ValueSizerRef currentSizer;
+
+      {
+        std::lock_guard<std::mutex> lock(configMutex);
+
+        if (maxSize==0) {
+          return;
+        }
+
+        currentSizer=sizer;
+      }
+
+      // Calculating the size may be expensive, so we do it outside of any shard lock
+      size_t                      cost=GetCost(currentSizer,value);
+      Shard&                      shard=GetShard(key);
+      std::lock_guard<std::mutex> lock(shard.mutex);
+
+      if (cost>shard.maxCost) {
+        return;
+      }
+
+      auto iter=shard.index.find(key);
+
+      if (iter!=shard.index.end()) {
+        Slot& slot=shard.slots[iter->second];
+
+        shard.cost-=slot.cost;
+        slot.cost=0;
+
+        StripShard(shard,cost);
+
+        // Stripping may have evicted the entry to update
+        iter=shard.index.find(key);
+        if (iter!=shard.index.end()) {
+          Slot& updatedSlot=shard.slots[iter->second];
+
+          updatedSlot.value=value;
+          updatedSlot.cost=cost;
+          updatedSlot.referenced=true;
+          shard.cost+=cost;
+
+          return;
+        }
+      }
+      else {
+        StripShard(shard,cost);
+      }
+
+      size_t slotIndex;
+
+      if (!shard.freeSlots.empty()) {
+        slotIndex=shard.freeSlots.back();
+        shard.freeSlots.pop_back();
+      }
+      else {
+        slotIndex=shard.slots.size();
+        shard.slots.emplace_back();
+      }
+
+      Slot& slot=shard.slots[slotIndex];
+
+      slot.key=key;
+      slot.value=value;
+      slot.cost=cost;
+      slot.used=true;
+      slot.referenced=false;
+
+      shard.cost+=cost;
+      shard.index[key]=slotIndex;
+    }
+
+    /**
+      Set a new maximum number of entries, possibly evicting entries.
+      A previously set sizer is removed.
+      */
+    void SetMaxSize(size_t maxSize)
+    {
+      std::lock_guard<std::mutex> lock(configMutex);
+
+      if (sizer) {
+        sizer=nullptr;
+        FlushInternal();
+      }
+
+      this->maxSize=maxSize;
+
+      DistributeMaxSize();
+    }
+
+    /**
+      Set a memory budget in bytes. The memory of each entry is calculated
+      using the given sizer. Since the costs of already cached entries
+      change, the cache is flushed.
+      */
+    void SetMaxMemory(size_t maxMemory,
+                      const ValueSizerRef& sizer)
+    {
+      assert(sizer);
+
+      std::lock_guard<std::mutex> lock(configMutex);
+
+      FlushInternal();
+
+      this->sizer=sizer;
+      this->maxSize=maxMemory;
+
+      DistributeMaxSize();
+    }
+
+    /**
+      Change the memory budget in bytes without flushing the cache, entries
+      are evicted if necessary. A sizer must have been set before
+      (see SetMaxMemory()).
+      */
+    void SetMemoryBudget(size_t maxMemory) override
+    {
+      std::lock_guard<std::mutex> lock(configMutex);
+
+      assert(sizer);
+
+      this->maxSize=maxMemory;
+
+      DistributeMaxSize();
+    }
+
+    /**
+     * Returns the maximum number of entries or the memory budget in bytes,
+     * if a sizer is set.
+     */
+    size_t GetMaxSize() const
+    {
+      std::lock_guard<std::mutex> lock(configMutex);
+
+      return maxSize;
+    }
+
+    /**
+     * Returns true, if the limit of the cache is a memory budget
+     */
+    bool HasMemoryBudget() const
+    {
+      std::lock_guard<std::mutex> lock(configMutex);
+
+      return sizer!=nullptr;
+    }
+
+  private:
+    void FlushInternal()
+    {
+      for (auto& shard : shards) {
+        std::lock_guard<std::mutex> lock(shard->mutex);
+
+        shard->index.clear();
+        shard->slots.clear();
+        shard->freeSlots.clear();
+        shard->hand=0;
+        shard->cost=0;
+      }
+    }
+
+  public:
+    /**
+      Completely flush the cache removing all entries from it.
+      */
+    void Flush()
+    {
+      FlushInternal();
+    }
+
+    /**
+      Returns the current number of entries in the cache.
+      */
+    size_t GetSize() const
+    {
+      size_t size=0;
+
+      for (const auto& shard : shards) {
+        std::lock_guard<std::mutex> lock(shard->mutex);
+
+        size+=shard->index.size();
+      }
+
+      return size;
+    }
+
+    /**
+      Returns the memory used by the cache. If no sizer was set, only
+      the memory of the management structures is counted.
+      */
+    size_t GetMemory() const override
+    {
+      bool   hasSizer=HasMemoryBudget();
+      size_t memory=0;
+
+      for (const auto& shard : shards) {
+        std::lock_guard<std::mutex> lock(shard->mutex);
+
+        if (hasSizer) {
+          memory+=shard->cost;
+        }
+        else {
+          memory+=shard->index.size()*GetEntryOverhead();
+        }
+      }
+
+      return memory;
+    }
+
+    size_t GetHits() const override
+    {
+      return hits;
+    }
+
+    size_t GetMisses() const override
+    {
+      return misses;
+    }
+
+    /**
+      Dump some cache statistics to the debug log.
+      */
+    void DumpStatistics(const char* cacheName) const
+    {
+      log.Debug() << cacheName << " entries: " << GetSize() << ", memory " << GetMemory() << ", hits " << GetHits() << ", misses " << GetMisses();
+    }
+  };
+}
+
+#endif
@@ -31,6 +31,7 @@
 #include <osmscout/GeoCoord.h>
 #include <osmscout/ObjectRef.h>
 #include <osmscout/Point.h>
+#include <osmscout/PointSequenceView.h>
 #include <osmscout/OSMScoutTypes.h>
 
 #include <osmscout/util/Color.h>
@@ -69,6 +70,19 @@ namespace osmscout {
       Normal
     };
 
+    /**
+     * Additional hints for memory mapped files, can be combined.
+     * They are ignored if the file is not memory mapped or the platform
+     * does not support them.
+     */
+    enum MMapAdvice : uint8_t
+    {
+      NoAdvice   = 0,      //!< Default behaviour
+      HugePages  = 1 << 0, //!< Advise the kernel to back the mapping with transparent hugepages
+      Prefault   = 1 << 1, //!< Fault in all pages of the mapping on open
+      Interleave = 1 << 2  //!< Interleave the prefaulted pages across all NUMA nodes, implies Prefault
+    };
+
   private:
     std::string          filename;       //!< Filename
     std::FILE            *file;          //!< Internal low level file handle
@@ -76,8 +90,15 @@ namespace osmscout {
 
     // For mmap usage
     char                 *buffer;        //!< Pointer to the file memory
+    bool                 ownsBuffer;     //!< The mapping was created by this scanner and is unmapped on close
     FileOffset           size;           //!< Size of the memory/file
     FileOffset           offset;         //!< Current offset into the file memory
+    FileOffset           bufferStart;    //!< File offset of the first byte of buffer
+    FileOffset           bufferEnd;      //!< File offset after the last byte of buffer
+
+    // For prefetching
+    std::vector<char>    prefetchBuffer; //!< Prefetched range of the file, buffer points to it while prefetched
+    bool                 prefetched;     //!< Reads are served from prefetchBuffer
 
     // For std::vector<GeoCoord> loading
     uint8_t              *byteBuffer;    //!< Temporary buffer for loading of std::vector<GeoCoord>
@@ -91,6 +112,17 @@ namespace osmscout {
   private:
     void AssureByteBufferSize(size_t size);
     void FreeBuffer();
+    void ApplyMMapAdvice(uint8_t mmapAdvice);
+    void PrefaultBuffer();
+
+    template<typename N>
+    void ReadBufferedNumberSigned(N& number,
+                                  const char* action);
+
+    bool ReadPointsHeader(bool readIds,
+                          size_t& nodeCount,
+                          size_t& coordBitSize,
+                          bool& hasNodes);
 
     /**
      * Reads bytes to internal temporary buffer
@@ -187,7 +219,10 @@ namespace osmscout {
 
     void Open(const std::string& filename,
               Mode mode,
-              bool useMmap);
+              bool useMmap,
+              uint8_t mmapAdvice=NoAdvice);
+    void Open(const FileScanner& mappedScanner,
+              Mode mode);
     void Close();
     void CloseFailsafe();
 
@@ -203,6 +238,28 @@ namespace osmscout {
       return file==nullptr || hasError;
     }
 
+    /**
+     * Returns true, if the file is memory mapped
+     */
+    inline bool IsMemoryMapped() const
+    {
+      return buffer!=nullptr && !prefetched;
+    }
+
+    /**
+     * Returns true, if reads are currently served from a prefetched range
+     */
+    inline bool IsPrefetched() const
+    {
+      return prefetched;
+    }
+
+    size_t Prefetch(FileOffset start,
+                    size_t bytes);
+    void ClearPrefetch();
+
+    void PrefaultPages();
+
     std::string GetFilename() const;
 
     void GotoBegin();
@@ -261,6 +318,9 @@ namespace osmscout {
               GeoBox &bbox,
               bool readIds);
 
+    void Read(PointSequenceView& nodes,
+              bool readIds);
+
     void ReadBox(GeoBox& box);
 
     void ReadTypeId(TypeId& id,
@@ -0,0 +1,140 @@
+#ifndef OSMSCOUT_UTIL_FILESCANNERPOOL_H
+#define OSMSCOUT_UTIL_FILESCANNERPOOL_H
+
+/*
+  This source is part of the libosmscout library
+  Copyright (C) 2026  Tim Teulings
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307  USA
+*/
+
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include <osmscout/CoreImportExport.h>
+
+#include <osmscout/util/FileScanner.h>
+
+#include <osmscout/system/Compiler.h>
+
+namespace osmscout {
+
+  /**
+    \ingroup File
+
+    Pool of FileScanner instances all reading the same file.
+
+    FileScanner holds a read cursor and thus cannot be shared between threads
+    without locking. The pool hands out one scanner per concurrent reader instead.
+    Scanners are opened on demand and returned to the pool after use, so the number
+    of open scanners is bounded by the maximum number of concurrent readers.
+
+    If the file is memory mapped, the pool maps it once and all scanners read
+    from this mapping, each with its own read cursor (see
+    FileScanner::Open(const FileScanner&,Mode)). Prefaulting and the other
+    FileScanner::MMapAdvice flags are thus applied once. Since objects read as
+    view (see WayView) point into the mapping, it is kept until the pool is
+    closed and the last lease is released.
+
+    All methods are thread-safe, with the exception of Open() and Close().
+    */
+  class OSMSCOUT_API FileScannerPool CLASS_FINAL
+  {
+  public:
+    /**
+      Exclusive access to one scanner of the pool. The scanner is returned
+      to the pool on destruction of the lease.
+      */
+    class OSMSCOUT_API Lease CLASS_FINAL
+    {
+    private:
+      const FileScannerPool              *pool;
+      std::shared_ptr<const FileScanner> mapping;
+      std::unique_ptr<FileScanner>       scanner;
+      size_t                             generation;
+
+    public:
+      Lease(const FileScannerPool* pool,
+            const std::shared_ptr<const FileScanner>& mapping,
+            std::unique_ptr<FileScanner>&& scanner,
+            size_t generation);
+
+      Lease(const Lease&) = delete;
+      Lease(Lease&& other) = default;
+      ~Lease();
+
+      Lease& operator=(const Lease&) = delete;
+      Lease& operator=(Lease&& other) = delete;
+
+      inline FileScanner& operator*() const
+      {
+        return *scanner;
+      }
+
+      inline FileScanner* operator->() const
+      {
+        return scanner.get();
+      }
+    };
+
+  private:
+    std::string                                       filename;   //!< Filename
+    FileScanner::Mode                                 mode;       //!< Access mode passed to each scanner
+    bool                                              isOpen;     //!< The pool is open
+    size_t                                            generation; //!< Incremented on each Close() to reject stale leases
+
+    std::shared_ptr<FileScanner>                      mapping;    //!< Scanner holding the memory mapping shared by all scanners, if mapped
+
+    mutable std::mutex                                mutex;      //!< Mutex to secure the idle list
+    mutable std::vector<std::unique_ptr<FileScanner>> idle;       //!< Opened scanners not currently in use
+
+  private:
+    static std::unique_ptr<FileScanner> OpenScanner(const std::string& filename,
+                                                    FileScanner::Mode mode,
+                                                    const FileScanner* mapping);
+    void Release(std::unique_ptr<FileScanner>&& scanner,
+                 size_t generation) const;
+
+  public:
+    FileScannerPool();
+    ~FileScannerPool();
+
+    FileScannerPool(const FileScannerPool&) = delete;
+    FileScannerPool(FileScannerPool&&) = delete;
+    FileScannerPool& operator=(const FileScannerPool&) = delete;
+    FileScannerPool& operator=(FileScannerPool&&) = delete;
+
+    void Open(const std::string& filename,
+              FileScanner::Mode mode,
+              bool useMmap,
+              uint8_t mmapAdvice=FileScanner::NoAdvice);
+    void Close();
+    void CloseFailsafe();
+
+    bool IsOpen() const;
+
+    std::string GetFilename() const;
+
+    bool IsMemoryMapped() const;
+
+    void Prefault() const;
+
+    Lease Acquire() const;
+  };
+}
+
+#endif
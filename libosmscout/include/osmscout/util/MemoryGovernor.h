@@ -0,0 +1,146 @@
+#ifndef OSMSCOUT_UTIL_MEMORYGOVERNOR_H
+#define OSMSCOUT_UTIL_MEMORYGOVERNOR_H
+
+/*
+  This source is part of the libosmscout library
+  Copyright (C) 2026  Tim Teulings
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307  USA
+*/
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include <osmscout/CoreImportExport.h>
+
+#include <osmscout/system/Compiler.h>
+
+namespace osmscout {
+
+  /**
+   * \ingroup Util
+   * Interface of a cache, whose memory budget can be controlled by a
+   * MemoryGovernor.
+   *
+   * All methods must be thread-safe.
+   */
+  class OSMSCOUT_API GovernedCache
+  {
+  public:
+    virtual ~GovernedCache() = default;
+
+    /**
+     * Returns the memory currently held by the cache in bytes
+     */
+    virtual size_t GetMemory() const = 0;
+
+    /**
+     * Returns the overall number of cache hits
+     */
+    virtual size_t GetHits() const = 0;
+
+    /**
+     * Returns the overall number of cache misses
+     */
+    virtual size_t GetMisses() const = 0;
+
+    /**
+     * Set a new memory budget in bytes, evicting entries if necessary.
+     * In contrast to changing the limit of the cache, existing entries
+     * are kept.
+     */
+    virtual void SetMemoryBudget(size_t maxMemory) = 0;
+  };
+
+  /**
+   * \ingroup Util
+   * Owns an overall memory budget (in bytes) and splits it between a number
+   * of caches, possibly of multiple Database instances.
+   *
+   * Initially each cache gets a part of the budget relative to the weight
+   * passed at registration. Rebalance() then moves budget to the caches
+   * that have the most accesses and misses since the last rebalancing.
+   * Caches that do not use their budget give the unused part to others.
+   * Each cache keeps a minimum share of the budget.
+   *
+   * Registered caches must be unregistered before they get destroyed.
+   *
+   * All methods are thread-safe.
+   */
+  class OSMSCOUT_API MemoryGovernor CLASS_FINAL
+  {
+  public:
+    static constexpr double MinimumShare = 0.1; //!< Part of the budget split evenly between all caches
+
+  private:
+    struct Entry
+    {
+      GovernedCache *cache;     //!< The governed cache
+      std::string   name;       //!< Name of the cache for statistics
+      double        weight;     //!< Weight given at registration
+      double        share;      //!< Current share of the budget (0.0-1.0)
+      size_t        lastHits;   //!< Hits at the last rebalancing
+      size_t        lastMisses; //!< Misses at the last rebalancing
+    };
+
+  private:
+    mutable std::mutex                mutex;             //!< Mutex to secure all internal state
+    size_t                            budget;            //!< Overall budget in bytes
+    std::chrono::milliseconds         rebalanceInterval; //!< Minimum time between automatic rebalancing
+    std::atomic<int64_t>              nextRebalance;     //!< Time of the next automatic rebalancing (steady clock ticks)
+    std::vector<Entry>                entries;           //!< Registered caches
+
+  private:
+    void NormalizeShares();
+    void ApplyBudgets();
+    void RebalanceInternal();
+
+  public:
+    explicit MemoryGovernor(size_t budget);
+
+    MemoryGovernor(const MemoryGovernor&) = delete;
+    MemoryGovernor(MemoryGovernor&&) = delete;
+    MemoryGovernor& operator=(const MemoryGovernor&) = delete;
+    MemoryGovernor& operator=(MemoryGovernor&&) = delete;
+
+    void SetBudget(size_t budget);
+    size_t GetBudget() const;
+
+    void SetRebalanceInterval(const std::chrono::milliseconds& interval);
+
+    void Register(GovernedCache& cache,
+                  const std::string& name,
+                  double weight);
+    void Unregister(GovernedCache& cache);
+
+    size_t GetCacheCount() const;
+    size_t GetCacheBudget(const GovernedCache& cache) const;
+    size_t GetUsedMemory() const;
+
+    void Rebalance();
+    void RebalanceIfDue();
+
+    void DumpStatistics() const;
+  };
+
+  using MemoryGovernorRef = std::shared_ptr<MemoryGovernor>;
+}
+
+#endif
@@ -20,15 +20,20 @@
   Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307  USA
 */
 
+#include <algorithm>
 #include <condition_variable>
 #include <deque>
+#include <functional>
 #include <future>
 #include <memory>
 #include <limits>
 #include <thread>
+#include <vector>
 
 #include <osmscout/CoreImportExport.h>
 
+#include <osmscout/system/Compiler.h>
+
 namespace osmscout {
 
   template<typename R>
@@ -53,6 +58,7 @@ namespace osmscout {
 
     void PushTask(Task& task);
     bool PopTask(Task& task);
+    bool TryPopTask(Task& task);
 
     void Stop();
   };
@@ -106,6 +112,29 @@ namespace osmscout {
     return true;
   }
 
+  /**
+   * Pop the next task without waiting
+   *
+   * @return
+   *    false, if the queue is currently empty
+   */
+  template<class R>
+  bool WorkQueue<R>::TryPopTask(Task& task)
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+
+    if (tasks.empty()) {
+      return false;
+    }
+
+    task=std::move(tasks.front());
+    tasks.pop_front();
+
+    pushCondition.notify_one();
+
+    return true;
+  }
+
   template<class R>
   void WorkQueue<R>::Stop()
   {
@@ -115,6 +144,133 @@ namespace osmscout {
 
     popCondition.notify_all();
   }
+
+  /**
+   * Worker threads executing batches of tasks. Code running many small
+   * batches owns a pool, so it does not start and join threads for each
+   * batch. The thread calling Run() helps executing the tasks until the
+   * queue is drained, so a pool without threads executes all tasks in the
+   * calling thread. Run() may be called by several threads concurrently.
+   */
+  class WorkerPool CLASS_FINAL
+  {
+  private:
+    WorkQueue<bool>          queue;
+    std::vector<std::thread> threads;
+
+  public:
+    explicit WorkerPool(size_t threadCount)
+    {
+      threads.reserve(threadCount);
+
+      for (size_t i=0; i<threadCount; i++) {
+        threads.emplace_back([this]() {
+          std::packaged_task<bool()> task;
+
+          while (queue.PopTask(task)) {
+            task();
+          }
+        });
+      }
+    }
+
+    WorkerPool(const WorkerPool&) = delete;
+    WorkerPool(WorkerPool&&) = delete;
+    WorkerPool& operator=(const WorkerPool&) = delete;
+    WorkerPool& operator=(WorkerPool&&) = delete;
+
+    ~WorkerPool()
+    {
+      // Worker threads finish, after the queue was drained
+      queue.Stop();
+
+      for (auto& thread : threads) {
+        thread.join();
+      }
+    }
+
+    inline size_t GetThreadCount() const
+    {
+      return threads.size();
+    }
+
+    /**
+     * Execute the given tasks and return after all of them were executed
+     *
+     * @return
+     *    false, if any of the tasks returned false
+     *
+     * An exception thrown by a task is rethrown by Run()
+     */
+    bool Run(const std::vector<std::function<bool()>>& tasks)
+    {
+      if (tasks.size()==1 ||
+          threads.empty()) {
+        bool success=true;
+
+        for (const auto& task : tasks) {
+          success=task() && success;
+        }
+
+        return success;
+      }
+
+      std::vector<std::future<bool>> results;
+
+      results.reserve(tasks.size());
+
+      for (const auto& function : tasks) {
+        std::packaged_task<bool()> task(function);
+
+        results.push_back(task.get_future());
+        queue.PushTask(task);
+      }
+
+      std::packaged_task<bool()> task;
+
+      while (queue.TryPopTask(task)) {
+        task();
+      }
+
+      // The tasks may refer to the caller, so no exception is passed on before all are done
+      for (auto& result : results) {
+        result.wait();
+      }
+
+      bool success=true;
+
+      for (auto& result : results) {
+        success=result.get() && success;
+      }
+
+      return success;
+    }
+  };
+
+  /**
+   * Execute the given tasks using up to threadCount threads, the calling
+   * thread being one of them. A threadCount of 0 uses one thread per
+   * hardware thread. Threads are started for this call only, see WorkerPool
+   * for repeated calls.
+   *
+   * @return
+   *    false, if any of the tasks returned false
+   *
+   * An exception thrown by a task is rethrown
+   */
+  inline bool RunConcurrently(const std::vector<std::function<bool()>>& tasks,
+                              size_t threadCount)
+  {
+    if (threadCount==0) {
+      threadCount=std::max(1u,std::thread::hardware_concurrency());
+    }
+
+    threadCount=std::min(threadCount,tasks.size());
+
+    WorkerPool pool(threadCount>0 ? threadCount-1 : 0);
+
+    return pool.Run(tasks);
+  }
 }
 
 #endif
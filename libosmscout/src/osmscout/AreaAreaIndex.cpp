@@ -48,43 +48,42 @@ namespace osmscout {
 
   void AreaAreaIndex::Close()
   {
+    DetachMemoryGovernor();
     indexCache.Flush();
+    preloadedCells.clear();
+    preloadedCells.shrink_to_fit();
+    preloadedData.clear();
+    preloadedData.shrink_to_fit();
     try {
-      if (scanner.IsOpen()) {
-        scanner.Close();
+      if (scannerPool.IsOpen()) {
+        scannerPool.Close();
       }
     }
     catch (IOException& e) {
       log.Error() << e.GetDescription();
-      scanner.CloseFailsafe();
+      scannerPool.CloseFailsafe();
     }
   }
 
-  bool AreaAreaIndex::GetIndexCell(uint32_t level,
+  bool AreaAreaIndex::GetIndexCell(FileScanner& scanner,
+                                   uint32_t level,
                                    FileOffset offset,
                                    IndexCell &indexCell,
                                    FileOffset &dataOffset) const
   {
     if (level<maxLevel) {
-      std::lock_guard<std::mutex> guard(lookupMutex);
-      IndexCache::CacheRef        cacheRef;
-
 #if defined(ANALYZE_CACHE)
       if (indexCache.GetSize()==indexCache.GetMaxSize()) {
         log.Warn() << "areaarea.index cache of " << indexCache.GetSize() << "/" << indexCache.GetMaxSize()
                    << " is too small";
-        indexCache.DumpStatistics("areaarea.idx",IndexCacheValueSizer());
+        indexCache.DumpStatistics(AREA_AREA_IDX);
       }
 #endif
 
-      if (!indexCache.GetEntry(offset,cacheRef)) {
-        IndexCache::CacheEntry cacheEntry(offset);
-
-        cacheRef=indexCache.SetEntry(cacheEntry);
-
+      if (!indexCache.GetEntry(offset,indexCell)) {
         scanner.SetPos(offset);
 
-        for (FileOffset& c : cacheRef->value.children) {
+        for (FileOffset& c : indexCell.children) {
           FileOffset childOffset;
 
           scanner.ReadNumber(childOffset);
@@ -97,12 +96,9 @@ namespace osmscout {
           }
         }
 
-        cacheRef->value.data=scanner.GetPos();
+        indexCell.data=scanner.GetPos();
 
-        indexCell=cacheRef->value;
-      }
-      else {
-        indexCell=cacheRef->value;
+        indexCache.SetEntry(offset,indexCell);
       }
     }
     else {
@@ -118,13 +114,16 @@ namespace osmscout {
     return true;
   }
 
-  bool AreaAreaIndex::ReadCellData(const TypeConfig& typeConfig,
-                                   const TypeInfoSet& types,
-                                   FileOffset dataOffset,
-                                   std::vector<DataBlockSpan>& spans) const
+  /**
+   * Reads the data entries of the index cell at the given offset and calls
+   * onEntry(typeId,dataCount,dataFileOffset) for each of them.
+   */
+  template<typename OnEntry>
+  void AreaAreaIndex::ReadCellEntries(FileScanner& scanner,
+                                      const TypeConfig& typeConfig,
+                                      FileOffset dataOffset,
+                                      OnEntry onEntry) const
   {
-    std::lock_guard<std::mutex> guard(lookupMutex);
-
     scanner.SetPos(dataOffset);
 
     uint32_t typeCount;
@@ -149,6 +148,22 @@ namespace osmscout {
         continue;
       }
 
+      onEntry(typeId,dataCount,dataFileOffset);
+    }
+  }
+
+  bool AreaAreaIndex::ReadCellData(FileScanner& scanner,
+                                   const TypeConfig& typeConfig,
+                                   const TypeInfoSet& types,
+                                   FileOffset dataOffset,
+                                   std::vector<DataBlockSpan>& spans) const
+  {
+    ReadCellEntries(scanner,
+                    typeConfig,
+                    dataOffset,
+                    [&typeConfig,&types,&spans](TypeId typeId,
+                                                uint32_t dataCount,
+                                                FileOffset dataFileOffset) {
       TypeInfoRef type=typeConfig.GetAreaTypeInfo(typeId);
 
       if (types.IsSet(type)) {
@@ -159,20 +174,21 @@ namespace osmscout {
 
         spans.push_back(span);
       }
-    }
+    });
 
     return true;
   }
 
+  template<typename Cell, typename Ref>
   void AreaAreaIndex::PushCellsForNextLevel(double minlon,
                                             double minlat,
                                             double maxlon,
                                             double maxlat,
-                                            const IndexCell& cellIndexData,
+                                            const Cell& cellIndexData,
                                             const CellDimension& cellDimension,
                                             size_t cx,
                                             size_t cy,
-                                            std::vector<CellRef>& nextCellRefs) const
+                                            std::vector<Ref>& nextCellRefs) const
   {
     if (cellIndexData.children[0]!=0) {
       // top left
@@ -227,23 +243,300 @@ namespace osmscout {
     }
   }
 
-  bool AreaAreaIndex::Open(const std::string& path, bool memoryMappedData)
+  bool AreaAreaIndex::Open(const std::string& path,
+                           bool memoryMappedData,
+                           uint8_t mmapAdvice)
   {
     datafilename=AppendFileToDir(path,AREA_AREA_IDX);
 
     try {
-      scanner.Open(datafilename,FileScanner::FastRandom,memoryMappedData);
+      scannerPool.Open(datafilename,FileScanner::FastRandom,memoryMappedData,mmapAdvice);
+
+      FileScannerPool::Lease scanner=scannerPool.Acquire();
 
-      scanner.ReadNumber(maxLevel);
-      scanner.ReadFileOffset(topLevelOffset);
+      scanner->ReadNumber(maxLevel);
+      scanner->ReadFileOffset(topLevelOffset);
 
-      return !scanner.HasError();
+      return !scanner->HasError();
     }
     catch (IOException& e) {
       log.Error() << e.GetDescription();
+      scannerPool.CloseFailsafe();
+
+      return false;
+    }
+  }
 
+  /**
+   * Fault in all pages of the index file, if it is memory mapped.
+   *
+   * Method is thread-safe.
+   */
+  bool AreaAreaIndex::Prefault() const
+  {
+    try {
+      scannerPool.Prefault();
+    }
+    catch (IOException& e) {
+      log.Error() << e.GetDescription();
       return false;
     }
+
+    return true;
+  }
+
+  /**
+   * Load the complete index into memory. The cells are stored in breadth
+   * first order in a flat array and reference their children by array
+   * index. Afterwards lookups do not access the file anymore.
+   *
+   * Preloading must happen before the index is used by other threads.
+   */
+  bool AreaAreaIndex::Preload(const TypeConfig& typeConfig)
+  {
+    StopClock time;
+
+    preloadedCells.clear();
+    preloadedData.clear();
+
+    try {
+      FileScannerPool::Lease  scanner=scannerPool.Acquire();
+      std::vector<FileOffset> cellOffsets;     // cells of the current level
+      std::vector<FileOffset> nextCellOffsets; // cells of the next level
+      size_t                  levelStart=0;    // index of the first cell of the current level
+
+      cellOffsets.push_back(topLevelOffset);
+
+      for (uint32_t level=0;
+           level<=maxLevel &&
+           !cellOffsets.empty();
+           level++) {
+        size_t nextLevelStart=levelStart+cellOffsets.size();
+
+        nextCellOffsets.clear();
+
+        for (const auto& offset : cellOffsets) {
+          IndexCell     indexCell;
+          FileOffset    dataOffset;
+          PreloadedCell cell;
+
+          if (!GetIndexCell(*scanner,
+                            level,
+                            offset,
+                            indexCell,
+                            dataOffset)) {
+            log.Error() << "Cannot find offset " << offset
+                        << " in level " << level
+                        << " in file '" << datafilename << "'";
+            preloadedCells.clear();
+            preloadedData.clear();
+
+            return false;
+          }
+
+          for (size_t c=0; c<4; c++) {
+            if (indexCell.children[c]==0) {
+              cell.children[c]=0;
+            }
+            else {
+              cell.children[c]=(uint32_t)(nextLevelStart+nextCellOffsets.size());
+              nextCellOffsets.push_back(indexCell.children[c]);
+            }
+          }
+
+          cell.dataStart=(uint32_t)preloadedData.size();
+
+          ReadCellEntries(*scanner,
+                          typeConfig,
+                          dataOffset,
+                          [this](TypeId typeId,
+                                 uint32_t dataCount,
+                                 FileOffset dataFileOffset) {
+            preloadedData.push_back(PreloadedData{typeId,dataCount,dataFileOffset});
+          });
+
+          cell.dataEnd=(uint32_t)preloadedData.size();
+
+          preloadedCells.push_back(cell);
+        }
+
+        levelStart=nextLevelStart;
+        std::swap(cellOffsets,nextCellOffsets);
+      }
+    }
+    catch (IOException& e) {
+      log.Error() << e.GetDescription();
+      preloadedCells.clear();
+      preloadedData.clear();
+
+      return false;
+    }
+
+    preloadedCells.shrink_to_fit();
+    preloadedData.shrink_to_fit();
+
+    // Cells are now only accessed from memory
+    indexCache.Flush();
+
+    time.Stop();
+
+    log.Debug() << "Preloading " << preloadedCells.size() << " cells with " << preloadedData.size()
+                << " entries (" << GetPreloadedMemory()/1024 << " KiB) of '" << datafilename << "' took " << time.ResultString();
+
+    return true;
+  }
+
+  /**
+   * Returns the memory used by the preloaded index in bytes.
+   */
+  size_t AreaAreaIndex::GetPreloadedMemory() const
+  {
+    return preloadedCells.capacity()*sizeof(PreloadedCell)+
+           preloadedData.capacity()*sizeof(PreloadedData);
+  }
+
+  bool AreaAreaIndex::GetAreasInAreaFromFile(const TypeConfig& typeConfig,
+                                             double minlon,
+                                             double minlat,
+                                             double maxlon,
+                                             double maxlat,
+                                             size_t maxLevel,
+                                             const TypeInfoSet& types,
+                                             std::vector<DataBlockSpan>& spans) const
+  {
+    std::vector<CellRef> cellRefs;     // cells to scan in this level
+    std::vector<CellRef> nextCellRefs; // cells to scan for the next level
+
+    cellRefs.reserve(2000);
+    nextCellRefs.reserve(2000);
+
+    cellRefs.emplace_back(topLevelOffset,0,0);
+
+    FileScannerPool::Lease scanner=scannerPool.Acquire();
+
+    // For all levels:
+    // * Take the tiles and offsets of the last level
+    // * Calculate the new tiles and offsets that still interfere with given area
+    // * Add the new offsets to the list of offsets and finish if we have
+    //   reached maxLevel or maxAreaCount.
+    // * copy no, ntx, nty to ctx, cty, co and go to next iteration
+    for (uint32_t level=0;
+         level<=this->maxLevel &&
+         level<=maxLevel &&
+         !cellRefs.empty();
+         level++) {
+      nextCellRefs.clear();
+
+      for (const auto& cellRef : cellRefs) {
+        IndexCell  cellIndexData;
+        FileOffset cellDataOffset;
+
+        if (!GetIndexCell(*scanner,
+                          level,
+                          cellRef.offset,
+                          cellIndexData,
+                          cellDataOffset)) {
+          log.Error() << "Cannot find offset " << cellRef.offset
+                      << " in level " << level
+                      << " in file '" << datafilename << "'";
+
+          return false;
+        }
+
+        // Now read the area offsets by type in this index entry
+
+        if (!ReadCellData(*scanner,
+                          typeConfig,
+                          types,
+                          cellDataOffset,
+                          spans)) {
+          log.Error() << "Cannot read index data for level " << level
+                      << " at offset " << cellDataOffset
+                      << " in file '" << datafilename << "'";
+
+          return false;
+        }
+
+        if (level<this->maxLevel) {
+          size_t cx=cellRef.x*2;
+          size_t cy=cellRef.y*2;
+
+          PushCellsForNextLevel(minlon,
+                                minlat,
+                                maxlon,
+                                maxlat,
+                                cellIndexData,
+                                cellDimension[level+1],
+                                cx,
+                                cy,
+                                nextCellRefs);
+        }
+      }
+
+      std::swap(cellRefs,nextCellRefs);
+    }
+
+    return true;
+  }
+
+  void AreaAreaIndex::GetAreasInAreaFromMemory(const TypeConfig& typeConfig,
+                                               double minlon,
+                                               double minlat,
+                                               double maxlon,
+                                               double maxlat,
+                                               size_t maxLevel,
+                                               const TypeInfoSet& types,
+                                               std::vector<DataBlockSpan>& spans) const
+  {
+    std::vector<PreloadedCellRef> cellRefs;     // cells to scan in this level
+    std::vector<PreloadedCellRef> nextCellRefs; // cells to scan for the next level
+
+    cellRefs.reserve(2000);
+    nextCellRefs.reserve(2000);
+
+    cellRefs.emplace_back(0,0,0);
+
+    for (uint32_t level=0;
+         level<=this->maxLevel &&
+         level<=maxLevel &&
+         !cellRefs.empty();
+         level++) {
+      nextCellRefs.clear();
+
+      for (const auto& cellRef : cellRefs) {
+        const PreloadedCell& cell=preloadedCells[cellRef.index];
+
+        for (uint32_t d=cell.dataStart; d<cell.dataEnd; d++) {
+          const PreloadedData& data=preloadedData[d];
+
+          if (types.IsSet(typeConfig.GetAreaTypeInfo(data.type))) {
+            DataBlockSpan span;
+
+            span.startOffset=data.offset;
+            span.count=data.count;
+
+            spans.push_back(span);
+          }
+        }
+
+        if (level<this->maxLevel) {
+          size_t cx=cellRef.x*2;
+          size_t cy=cellRef.y*2;
+
+          PushCellsForNextLevel(minlon,
+                                minlat,
+                                maxlon,
+                                maxlat,
+                                cell,
+                                cellDimension[level+1],
+                                cx,
+                                cy,
+                                nextCellRefs);
+        }
+      }
+
+      std::swap(cellRefs,nextCellRefs);
+    }
   }
 
   /**
@@ -268,14 +561,11 @@ namespace osmscout {
                                      std::vector<DataBlockSpan>& spans,
                                      TypeInfoSet& loadedTypes) const
   {
-    StopClock            time;
-
-    std::vector<CellRef> cellRefs;     // cells to scan in this level
-    std::vector<CellRef> nextCellRefs; // cells to scan for the next level
-    double               minlon=boundingBox.GetMinLon()+180.0;
-    double               maxlon=boundingBox.GetMaxLon()+180.0;
-    double               minlat=boundingBox.GetMinLat()+90.0;
-    double               maxlat=boundingBox.GetMaxLat()+90.0;
+    StopClock time;
+    double    minlon=boundingBox.GetMinLon()+180.0;
+    double    maxlon=boundingBox.GetMaxLon()+180.0;
+    double    minlat=boundingBox.GetMinLat()+90.0;
+    double    maxlat=boundingBox.GetMaxLat()+90.0;
 
     // Clear result data structures
     spans.clear();
@@ -285,76 +575,34 @@ namespace osmscout {
     // This should void reallocation
     spans.reserve(1000);
 
-    cellRefs.reserve(2000);
-    nextCellRefs.reserve(2000);
-
-    cellRefs.emplace_back(topLevelOffset,0,0);
-
-    try {
-      // For all levels:
-      // * Take the tiles and offsets of the last level
-      // * Calculate the new tiles and offsets that still interfere with given area
-      // * Add the new offsets to the list of offsets and finish if we have
-      //   reached maxLevel or maxAreaCount.
-      // * copy no, ntx, nty to ctx, cty, co and go to next iteration
-      for (uint32_t level=0;
-           level<=this->maxLevel &&
-           level<=maxLevel &&
-           !cellRefs.empty();
-           level++) {
-        nextCellRefs.clear();
-
-        for (const auto& cellRef : cellRefs) {
-          IndexCell  cellIndexData;
-          FileOffset cellDataOffset;
-
-          if (!GetIndexCell(level,
-                            cellRef.offset,
-                            cellIndexData,
-                            cellDataOffset)) {
-            log.Error() << "Cannot find offset " << cellRef.offset
-                        << " in level " << level
-                        << " in file '" << scanner.GetFilename() << "'";
-
-            return false;
-          }
-
-          // Now read the area offsets by type in this index entry
-
-          if (!ReadCellData(typeConfig,
-                            types,
-                            cellDataOffset,
-                            spans)) {
-            log.Error() << "Cannot read index data for level " << level
-                        << " at offset " << cellDataOffset
-                        << " in file '" << scanner.GetFilename() << "'";
-
-            return false;
-          }
-
-          if (level<this->maxLevel) {
-            size_t cx=cellRef.x*2;
-            size_t cy=cellRef.y*2;
-
-            PushCellsForNextLevel(minlon,
-                                  minlat,
-                                  maxlon,
-                                  maxlat,
-                                  cellIndexData,
-                                  cellDimension[level+1],
-                                  cx,
-                                  cy,
-                                  nextCellRefs);
-          }
+    if (IsPreloaded()) {
+      GetAreasInAreaFromMemory(typeConfig,
+                               minlon,
+                               minlat,
+                               maxlon,
+                               maxlat,
+                               maxLevel,
+                               types,
+                               spans);
+    }
+    else {
+      try {
+        if (!GetAreasInAreaFromFile(typeConfig,
+                                    minlon,
+                                    minlat,
+                                    maxlon,
+                                    maxlat,
+                                    maxLevel,
+                                    types,
+                                    spans)) {
+          return false;
         }
-
-        std::swap(cellRefs,nextCellRefs);
       }
-    }
-    catch (IOException& e) {
-      log.Error() << e.GetDescription();
+      catch (IOException& e) {
+        log.Error() << e.GetDescription();
 
-      return false;
+        return false;
+      }
     }
 
     time.Stop();
@@ -371,13 +619,49 @@ namespace osmscout {
 
   void AreaAreaIndex::DumpStatistics()
   {
-    std::lock_guard<std::mutex> guard(lookupMutex);
-    indexCache.DumpStatistics(AREA_AREA_IDX,IndexCacheValueSizer());
+    indexCache.DumpStatistics(AREA_AREA_IDX);
   }
 
   void AreaAreaIndex::FlushCache()
   {
-    std::lock_guard<std::mutex> guard(lookupMutex);
     indexCache.Flush();
   }
+
+  /**
+   * Limit the index cell cache by the given memory budget (in bytes)
+   * instead of by the number of cells. The cache is flushed.
+   */
+  void AreaAreaIndex::SetCacheMemory(size_t maxMemory)
+  {
+    indexCache.SetMaxMemory(maxMemory,
+                            std::make_shared<IndexCacheValueSizer>());
+  }
+
+  /**
+   * Let the given governor control the memory budget of the index cell
+   * cache. The cache is flushed. The weight defines the initial share of the
+   * overall budget (see MemoryGovernor::Register()). The cache is
+   * unregistered on Close().
+   */
+  void AreaAreaIndex::SetMemoryGovernor(const MemoryGovernorRef& governor,
+                                        double weight)
+  {
+    DetachMemoryGovernor();
+
+    indexCache.SetMaxMemory(0,
+                            std::make_shared<IndexCacheValueSizer>());
+
+    memoryGovernor=governor;
+    memoryGovernor->Register(indexCache,
+                             AREA_AREA_IDX,
+                             weight);
+  }
+
+  void AreaAreaIndex::DetachMemoryGovernor()
+  {
+    if (memoryGovernor) {
+      memoryGovernor->Unregister(indexCache);
+      memoryGovernor=nullptr;
+    }
+  }
 }
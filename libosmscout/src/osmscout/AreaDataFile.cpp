@@ -29,4 +29,18 @@ namespace osmscout {
   {
     // no code
   }
+
+  size_t AreaDataFile::GetValueMemory(const Area& area) const
+  {
+    size_t memory=sizeof(Area);
+
+    memory+=area.rings.capacity()*sizeof(Area::Ring);
+
+    for (const auto& ring : area.rings) {
+      memory+=ring.nodes.capacity()*sizeof(Point);
+      memory+=ring.segments.capacity()*sizeof(SegmentGeoBox);
+    }
+
+    return memory;
+  }
 }
@@ -61,42 +61,44 @@ namespace osmscout {
   {
     typeData.clear();
     try {
-      if (scanner.IsOpen()) {
-        scanner.Close();
+      if (scannerPool.IsOpen()) {
+        scannerPool.Close();
       }
     }
     catch (IOException& e) {
       log.Error() << e.GetDescription();
-      scanner.CloseFailsafe();
+      scannerPool.CloseFailsafe();
     }
   }
 
   bool AreaIndex::Open(const TypeConfigRef& typeConfig,
                        const std::string& path,
-                       bool memoryMappedData)
+                       bool memoryMappedData,
+                       uint8_t mmapAdvice)
   {
     fullIndexFileName=AppendFileToDir(path,indexFileName);
 
     try {
-      scanner.Open(fullIndexFileName,FileScanner::FastRandom,memoryMappedData);
+      scannerPool.Open(fullIndexFileName,FileScanner::FastRandom,memoryMappedData,mmapAdvice);
 
-      uint32_t indexEntries;
+      FileScannerPool::Lease scanner=scannerPool.Acquire();
+      uint32_t               indexEntries;
 
-      scanner.Read(indexEntries);
+      scanner->Read(indexEntries);
 
       typeData.reserve(indexEntries);
 
       for (size_t i=0; i<indexEntries; i++) {
         TypeData data;
-        ReadTypeData(typeConfig, data);
+        ReadTypeData(typeConfig, *scanner, data);
 
-        scanner.ReadFileOffset(data.bitmapOffset);
+        scanner->ReadFileOffset(data.bitmapOffset);
 
         if (data.bitmapOffset>0) {
-          scanner.Read(data.dataOffsetBytes);
+          scanner->Read(data.dataOffsetBytes);
 
           uint32_t indexLevel;
-          scanner.ReadNumber(indexLevel);
+          scanner->ReadNumber(indexLevel);
           data.indexLevel=MagnificationLevel(indexLevel);
 
           uint32_t minX;
@@ -104,10 +106,10 @@ namespace osmscout {
           uint32_t minY;
           uint32_t maxY;
 
-          scanner.ReadNumber(minX);
-          scanner.ReadNumber(maxX);
-          scanner.ReadNumber(minY);
-          scanner.ReadNumber(maxY);
+          scanner->ReadNumber(minX);
+          scanner->ReadNumber(maxX);
+          scanner->ReadNumber(minY);
+          scanner->ReadNumber(maxY);
 
           data.tileBox=TileIdBox(TileId(minX,minY),
                                  TileId(maxX,maxY));
@@ -118,16 +120,36 @@ namespace osmscout {
         typeData.push_back(data);
       }
 
-      return !scanner.HasError();
+      return !scanner->HasError();
     }
     catch (IOException& e) {
       log.Error() << e.GetDescription();
+      scannerPool.CloseFailsafe();
 
       return false;
     }
   }
 
-  void AreaIndex::GetOffsets(const TypeData& typeData,
+  /**
+   * Fault in all pages of the index file, if it is memory mapped.
+   *
+   * Method is thread-safe.
+   */
+  bool AreaIndex::Prefault() const
+  {
+    try {
+      scannerPool.Prefault();
+    }
+    catch (IOException& e) {
+      log.Error() << e.GetDescription();
+      return false;
+    }
+
+    return true;
+  }
+
+  void AreaIndex::GetOffsets(FileScanner& scanner,
+                             const TypeData& typeData,
                              const GeoBox& boundingBox,
                              std::unordered_set<FileOffset>& offsets) const
   {
@@ -157,10 +179,9 @@ namespace osmscout {
 
     // For each row
     for (size_t y=boundingTileBox.GetMinY(); y<=boundingTileBox.GetMaxY(); y++) {
-      std::lock_guard<std::mutex> guard(lookupMutex);
-      FileOffset                  initialCellDataOffset=0;
-      size_t                      cellDataOffsetCount=0;
-      FileOffset                  bitmapCellOffset=typeData.GetCellOffset(boundingTileBox.GetMinX(),y);
+      FileOffset initialCellDataOffset=0;
+      size_t     cellDataOffsetCount=0;
+      FileOffset bitmapCellOffset=typeData.GetCellOffset(boundingTileBox.GetMinX(),y);
 
       scanner.SetPos(bitmapCellOffset);
 
@@ -231,9 +252,12 @@ namespace osmscout {
     std::unordered_set<FileOffset> uniqueOffsets;
 
     try {
+      FileScannerPool::Lease scanner=scannerPool.Acquire();
+
       for (const auto& data : typeData) {
         if (types.IsSet(data.type)) {
-          GetOffsets(data,
+          GetOffsets(*scanner,
+                     data,
                      boundingBox,
                      uniqueOffsets);
 
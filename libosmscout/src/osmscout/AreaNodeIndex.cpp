@@ -37,70 +37,74 @@ namespace osmscout {
   void AreaNodeIndex::Close()
   {
     try {
-      if (scanner.IsOpen()) {
-        scanner.Close();
+      if (scannerPool.IsOpen()) {
+        scannerPool.Close();
       }
     }
     catch (IOException& e) {
       log.Error() << e.GetDescription();
-      scanner.CloseFailsafe();
+      scannerPool.CloseFailsafe();
     }
   }
 
   bool AreaNodeIndex::Open(const std::string& path,
-                           bool memoryMappedData)
+                           bool memoryMappedData,
+                           uint8_t mmapAdvice)
   {
     std::string datafilename=AppendFileToDir(path,AREA_NODE_IDX);
 
     try {
-      scanner.Open(datafilename,
-                   FileScanner::FastRandom,
-                   memoryMappedData);
+      scannerPool.Open(datafilename,
+                       FileScanner::FastRandom,
+                       memoryMappedData,
+                       mmapAdvice);
+
+      FileScannerPool::Lease scanner=scannerPool.Acquire();
 
       uint32_t gridMag;
 
-      scanner.Read(gridMag);
+      scanner->Read(gridMag);
 
       this->gridMag=MagnificationLevel(gridMag);
 
       uint16_t indexEntryCount;
 
-      scanner.Read(indexEntryCount);
+      scanner->Read(indexEntryCount);
 
       for (uint16_t i=1; i<=indexEntryCount; i++) {
         TypeId typeId;
 
-        scanner.ReadNumber(typeId);
+        scanner->ReadNumber(typeId);
 
         if (typeId>=nodeTypeData.size()) {
           nodeTypeData.resize(typeId+1);
         }
 
-        scanner.Read(nodeTypeData[typeId].isComplex);
+        scanner->Read(nodeTypeData[typeId].isComplex);
 
         GeoCoord minCoord,maxCoord;
 
-        scanner.ReadCoord(minCoord);
-        scanner.ReadCoord(maxCoord);
+        scanner->ReadCoord(minCoord);
+        scanner->ReadCoord(maxCoord);
 
         TypeData& entry=nodeTypeData[typeId];
 
         entry.boundingBox.Set(minCoord,maxCoord);
 
         if (!entry.isComplex) {
-          scanner.ReadFileOffset(entry.indexOffset);
-          scanner.Read(entry.entryCount);
+          scanner->ReadFileOffset(entry.indexOffset);
+          scanner->Read(entry.entryCount);
         }
       }
 
       uint32_t tileEntryCount;
 
-      scanner.Read(tileEntryCount);
+      scanner->Read(tileEntryCount);
 
       for (uint32_t i=1; i<=tileEntryCount; i++) {
         TypeId typeId;
 
-        scanner.ReadNumber(typeId);
+        scanner->ReadNumber(typeId);
 
         if (typeId>=nodeTypeData.size()) {
           nodeTypeData.resize(typeId+1);
@@ -108,24 +112,24 @@ namespace osmscout {
 
         uint32_t x,y;
 
-        scanner.Read(x);
-        scanner.Read(y);
+        scanner->Read(x);
+        scanner->Read(y);
 
         ListTile& entry=nodeTypeData[typeId].listTiles[TileId(x,y)];
 
-        scanner.ReadFileOffset(entry.fileOffset);
-        scanner.Read(entry.entryCount);
-        scanner.Read(entry.storeGeoCoord);
+        scanner->ReadFileOffset(entry.fileOffset);
+        scanner->Read(entry.entryCount);
+        scanner->Read(entry.storeGeoCoord);
       }
 
       uint32_t bitmapEntryCount;
 
-      scanner.Read(bitmapEntryCount);
+      scanner->Read(bitmapEntryCount);
 
       for (uint32_t i=1; i<=bitmapEntryCount; i++) {
         TypeId typeId;
 
-        scanner.ReadNumber(typeId);
+        scanner->ReadNumber(typeId);
 
         if (typeId>=nodeTypeData.size()) {
           nodeTypeData.resize(typeId+1);
@@ -134,34 +138,52 @@ namespace osmscout {
         uint32_t x,y;
         uint8_t  magnification;
 
-        scanner.Read(x);
-        scanner.Read(y);
+        scanner->Read(x);
+        scanner->Read(y);
 
         BitmapTile& entry=nodeTypeData[typeId].bitmapTiles[TileId(x,y)];
 
-        scanner.ReadFileOffset(entry.fileOffset);
-        scanner.Read(entry.dataOffsetBytes);
+        scanner->ReadFileOffset(entry.fileOffset);
+        scanner->Read(entry.dataOffsetBytes);
 
-        scanner.Read(magnification);
+        scanner->Read(magnification);
 
         entry.magnification=MagnificationLevel(magnification);
       }
 
-      return !scanner.HasError();
+      return !scanner->HasError();
     }
     catch (IOException& e) {
       log.Error() << e.GetDescription();
+      scannerPool.CloseFailsafe();
 
       return false;
     }
   }
 
-  bool AreaNodeIndex::GetOffsetsList(const TypeData& typeData,
+  /**
+   * Fault in all pages of the index file, if it is memory mapped.
+   *
+   * Method is thread-safe.
+   */
+  bool AreaNodeIndex::Prefault() const
+  {
+    try {
+      scannerPool.Prefault();
+    }
+    catch (IOException& e) {
+      log.Error() << e.GetDescription();
+      return false;
+    }
+
+    return true;
+  }
+
+  bool AreaNodeIndex::GetOffsetsList(FileScanner& scanner,
+                                     const TypeData& typeData,
                                      const GeoBox& boundingBox,
                                      std::vector<FileOffset>& offsets) const
   {
-    std::lock_guard<std::mutex> guard(lookupMutex);
-
     scanner.SetPos(typeData.indexOffset);
 
     FileOffset previousOffset=0;
@@ -185,12 +207,11 @@ namespace osmscout {
     return true;
   }
 
-  bool AreaNodeIndex::GetOffsetsTileList(const TypeData& typeData,
+  bool AreaNodeIndex::GetOffsetsTileList(FileScanner& scanner,
+                                         const TypeData& typeData,
                                          const GeoBox& boundingBox,
                                          std::vector<FileOffset>& offsets) const
   {
-    std::lock_guard<std::mutex> guard(lookupMutex);
-
     TileIdBox tileBox(TileId::GetTile(gridMag,boundingBox.GetMinCoord()),
                       TileId::GetTile(gridMag,boundingBox.GetMaxCoord()));
 
@@ -238,7 +259,8 @@ namespace osmscout {
     return true;
   }
 
-  bool AreaNodeIndex::GetOffsetsBitmap(const TypeData& typeData,
+  bool AreaNodeIndex::GetOffsetsBitmap(FileScanner& scanner,
+                                       const TypeData& typeData,
                                        const GeoBox& boundingBox,
                                        std::vector<FileOffset>& offsets) const
   {
@@ -273,12 +295,11 @@ namespace osmscout {
 
         // For each row
         for (auto y=minyc; y<=maxyc; y++) {
-          std::lock_guard<std::mutex> guard(lookupMutex);
-          FileOffset                  initialCellDataOffset=0;
-          size_t                      cellDataOffsetCount=0;
-          FileOffset                  cellIndexOffset=tileBitmap->second.fileOffset+
-                                                      ((y-bitmapTileBox.GetMinY())*bitmapTileBox.GetWidth()+
-                                                       minxc-bitmapTileBox.GetMinX())*tileBitmap->second.dataOffsetBytes;
+          FileOffset initialCellDataOffset=0;
+          size_t     cellDataOffsetCount=0;
+          FileOffset cellIndexOffset=tileBitmap->second.fileOffset+
+                                     ((y-bitmapTileBox.GetMinY())*bitmapTileBox.GetWidth()+
+                                      minxc-bitmapTileBox.GetMinX())*tileBitmap->second.dataOffsetBytes;
 
           scanner.SetPos(cellIndexOffset);
 
@@ -350,6 +371,8 @@ namespace osmscout {
     offsets.reserve(std::min((size_t)10000,offsets.capacity()));
 
     try {
+      FileScannerPool::Lease scanner=scannerPool.Acquire();
+
       for (const TypeInfoRef& type : requestedTypes) {
         if (type->IsInternal()) {
           continue;
@@ -365,15 +388,15 @@ namespace osmscout {
           if (!nodeTypeData[index].isComplex &&
               nodeTypeData[index].indexOffset!=0 &&
               nodeTypeData[index].entryCount!=0) {
-            if (!GetOffsetsList(nodeTypeData[index],boundingBox,offsets)) {
+            if (!GetOffsetsList(*scanner,nodeTypeData[index],boundingBox,offsets)) {
               return false;
             }
           }
           else if (nodeTypeData[index].isComplex) {
-            if (!GetOffsetsTileList(nodeTypeData[index],boundingBox,offsets)) {
+            if (!GetOffsetsTileList(*scanner,nodeTypeData[index],boundingBox,offsets)) {
               return false;
             }
-            if (!GetOffsetsBitmap(nodeTypeData[index],boundingBox,offsets)) {
+            if (!GetOffsetsBitmap(*scanner,nodeTypeData[index],boundingBox,offsets)) {
               return false;
             }
           }
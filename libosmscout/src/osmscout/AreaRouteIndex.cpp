@@ -30,6 +30,7 @@ namespace osmscout {
   {}
 
   void AreaRouteIndex::ReadTypeData(const TypeConfigRef& typeConfig,
+                                    FileScanner& scanner,
                                     TypeData &data)
   {
     TypeId typeId;
@@ -0,0 +1,87 @@
+/*
+  This source is part of the libosmscout library
+  Copyright (C) 2026  Tim Teulings
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307  USA
+*/
+
+#include <osmscout/AreaView.h>
+
+namespace osmscout {
+
+  /**
+   * Read the data from the given memory mapped FileScanner, see Area::Read().
+   *
+   * @throws IOException
+   */
+  void AreaView::Read(const TypeConfig& typeConfig,
+                      FileScanner& scanner)
+  {
+    TypeId   ringType;
+    bool     multipleRings;
+    bool     hasMaster;
+    uint32_t ringCount=1;
+
+    fileOffset=scanner.GetPos();
+
+    scanner.ReadTypeId(ringType,
+                       typeConfig.GetAreaTypeIdBytes());
+
+    TypeInfoRef type=typeConfig.GetAreaTypeInfo(ringType);
+
+    FeatureValueBuffer featureValueBuffer;
+
+    featureValueBuffer.SetType(type);
+    featureValueBuffer.Read(scanner,
+                            multipleRings,
+                            hasMaster);
+
+    if (multipleRings) {
+      scanner.ReadNumber(ringCount);
+
+      ringCount++;
+    }
+
+    rings.resize(ringCount);
+
+    rings[0].featureValueBuffer=std::move(featureValueBuffer);
+    rings[0].ring=hasMaster ? Area::masterRingId : Area::outerRingId;
+
+    scanner.Read(rings[0].nodes,
+                 type->CanRoute());
+
+    for (size_t i=1; i<ringCount; i++) {
+      Ring& ring=rings[i];
+
+      scanner.ReadTypeId(ringType,
+                         typeConfig.GetAreaTypeIdBytes());
+
+      type=typeConfig.GetAreaTypeInfo(ringType);
+
+      ring.featureValueBuffer.SetType(type);
+
+      if (type->GetAreaId()!=typeIgnore) {
+        ring.featureValueBuffer.Read(scanner);
+      }
+
+      scanner.Read(ring.ring);
+      scanner.Read(ring.nodes,
+                   type->GetAreaId()!=typeIgnore &&
+                   type->CanRoute());
+    }
+
+    nextFileOffset=scanner.GetPos();
+  }
+}
@@ -30,6 +30,7 @@ namespace osmscout {
   {}
 
   void AreaWayIndex::ReadTypeData(const TypeConfigRef& typeConfig,
+                                  FileScanner& scanner,
                                   TypeData &data)
   {
     TypeId typeId;
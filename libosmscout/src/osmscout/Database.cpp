@@ -20,6 +20,8 @@
 #include <osmscout/Database.h>
 
 #include <algorithm>
+#include <functional>
+#include <thread>
 
 #if _OPENMP
 #include <omp.h>
@@ -31,6 +33,7 @@
 #include <osmscout/util/Geometry.h>
 #include <osmscout/util/Logger.h>
 #include <osmscout/util/StopClock.h>
+#include <osmscout/util/WorkQueue.h>
 
 namespace osmscout {
 
@@ -39,6 +42,16 @@ namespace osmscout {
     this->areaAreaIndexCacheSize=areaAreaIndexCacheSize;
   }
 
+  /**
+   * Load the complete area area index into memory when it is opened.
+   * Lookups then do not access the index file anymore (see
+   * AreaAreaIndex::Preload()). The index cell cache is not used in this case.
+   */
+  void DatabaseParameter::SetAreaAreaIndexPreload(bool preload)
+  {
+    this->areaAreaIndexPreload=preload;
+  }
+
   void DatabaseParameter::SetNodeDataCacheSize(unsigned long size)
   {
     this->nodeDataCacheSize=size;
@@ -59,6 +72,31 @@ namespace osmscout {
     this->routeDataCacheSize=size;
   }
 
+  /**
+   * Limit the caches of the database by an overall memory budget (in bytes)
+   * instead of by the number of cached entries. The database creates a
+   * MemoryGovernor for the budget. It initially splits the budget between the
+   * individual caches relative to their configured cache sizes and later
+   * rebalances it based on the hit rates of the caches.
+   *
+   * Passing 0 (the default) limits the caches by their cache sizes.
+   */
+  void DatabaseParameter::SetCacheMemory(size_t bytes)
+  {
+    this->cacheMemory=bytes;
+  }
+
+  /**
+   * Let the given governor control the memory of the caches of the database.
+   * Passing the same governor to multiple databases lets them share one
+   * memory budget. If set, the cache memory budget (see SetCacheMemory())
+   * is ignored.
+   */
+  void DatabaseParameter::SetMemoryGovernor(const MemoryGovernorRef& governor)
+  {
+    this->memoryGovernor=governor;
+  }
+
   void DatabaseParameter::SetRouterDataMMap(bool mmap)
   {
     routerDataMMap=mmap;
@@ -94,11 +132,48 @@ namespace osmscout {
     indexMMap=mmap;
   }
 
+  /**
+   * Advise the kernel to back the memory mapping of hot files (the area
+   * indexes and router.dat) with transparent hugepages. This reduces TLB
+   * misses during lookups, if the kernel supports hugepages for file
+   * mappings.
+   */
+  void DatabaseParameter::SetHugePageMMap(bool hugePages)
+  {
+    hugePageMMap=hugePages;
+  }
+
+  /**
+   * Fault in all pages of the memory mapped hot files (the area indexes and
+   * router.dat) on Database::Open() (respectively RoutingDatabase::Open()),
+   * trading startup time for the latency of the first lookups.
+   */
+  void DatabaseParameter::SetPrefaultMMap(bool prefault)
+  {
+    prefaultMMap=prefault;
+  }
+
+  /**
+   * Interleave the pages of the memory mapped hot files across all NUMA nodes
+   * while prefaulting them, so that lookups from threads on different nodes
+   * see the same average memory latency. Implies prefaulting. Only
+   * supported on Linux.
+   */
+  void DatabaseParameter::SetInterleaveMMap(bool interleave)
+  {
+    interleaveMMap=interleave;
+  }
+
   unsigned long DatabaseParameter::GetAreaAreaIndexCacheSize() const
   {
     return areaAreaIndexCacheSize;
   }
 
+  bool DatabaseParameter::GetAreaAreaIndexPreload() const
+  {
+    return areaAreaIndexPreload;
+  }
+
   unsigned long DatabaseParameter::GetNodeDataCacheSize() const
   {
     return nodeDataCacheSize;
@@ -119,6 +194,35 @@ namespace osmscout {
     return areaDataCacheSize;
   }
 
+  size_t DatabaseParameter::GetCacheMemory() const
+  {
+    return cacheMemory;
+  }
+
+  /**
+   * Returns the part of the cache memory budget for a cache with the given
+   * configured cache size.
+   */
+  size_t DatabaseParameter::GetCacheMemoryShare(unsigned long cacheSize) const
+  {
+    double overallCacheSize=double(areaAreaIndexCacheSize)+
+                            double(nodeDataCacheSize)+
+                            double(wayDataCacheSize)+
+                            double(areaDataCacheSize)+
+                            double(routeDataCacheSize);
+
+    if (overallCacheSize==0.0) {
+      return 0;
+    }
+
+    return size_t(double(cacheMemory)*double(cacheSize)/overallCacheSize);
+  }
+
+  MemoryGovernorRef DatabaseParameter::GetMemoryGovernor() const
+  {
+    return memoryGovernor;
+  }
+
   bool DatabaseParameter::GetRouterDataMMap() const
   {
     return routerDataMMap;
@@ -154,6 +258,43 @@ namespace osmscout {
     return indexMMap;
   }
 
+  bool DatabaseParameter::GetHugePageMMap() const
+  {
+    return hugePageMMap;
+  }
+
+  bool DatabaseParameter::GetPrefaultMMap() const
+  {
+    return prefaultMMap;
+  }
+
+  bool DatabaseParameter::GetInterleaveMMap() const
+  {
+    return interleaveMMap;
+  }
+
+  /**
+   * Returns the FileScanner::MMapAdvice flags for memory mapped hot files.
+   */
+  uint8_t DatabaseParameter::GetHotFileMMapAdvice() const
+  {
+    uint8_t advice=FileScanner::NoAdvice;
+
+    if (hugePageMMap) {
+      advice|=FileScanner::HugePages;
+    }
+
+    if (prefaultMMap) {
+      advice|=FileScanner::Prefault;
+    }
+
+    if (interleaveMMap) {
+      advice|=FileScanner::Interleave;
+    }
+
+    return advice;
+  }
+
   NodeRegionSearchResultEntry::NodeRegionSearchResultEntry(const NodeRef &node,
                                                            const Distance &distance)
   : node(node),
@@ -181,11 +322,81 @@ namespace osmscout {
   {
   }
 
+  DatabaseWarmupParameter::DatabaseWarmupParameter()
+  : threadCount(std::max(1u,std::thread::hardware_concurrency()))
+  {
+    // no code
+  }
+
+  /**
+   * Number of threads opening the files in parallel, default is the number
+   * of hardware threads.
+   */
+  void DatabaseWarmupParameter::SetThreadCount(size_t threadCount)
+  {
+    this->threadCount=std::max(size_t(1),threadCount);
+  }
+
+  /**
+   * Open the data files (nodes, areas, ways, routes and bounding box),
+   * default is true.
+   */
+  void DatabaseWarmupParameter::SetDataFiles(bool dataFiles)
+  {
+    this->dataFiles=dataFiles;
+  }
+
+  /**
+   * Open the area, location and water indexes and the low zoom
+   * optimizations, default is true.
+   */
+  void DatabaseWarmupParameter::SetIndexes(bool indexes)
+  {
+    this->indexes=indexes;
+  }
+
+  /**
+   * Fault in all pages of the opened data files and area indexes, if they
+   * are memory mapped, default is false. Trades warmup time and resident
+   * memory for the latency of the first requests.
+   */
+  void DatabaseWarmupParameter::SetPrefault(bool prefault)
+  {
+    this->prefault=prefault;
+  }
+
+  size_t DatabaseWarmupParameter::GetThreadCount() const
+  {
+    return threadCount;
+  }
+
+  bool DatabaseWarmupParameter::GetDataFiles() const
+  {
+    return dataFiles;
+  }
+
+  bool DatabaseWarmupParameter::GetIndexes() const
+  {
+    return indexes;
+  }
+
+  bool DatabaseWarmupParameter::GetPrefault() const
+  {
+    return prefault;
+  }
+
   Database::Database(const DatabaseParameter& parameter)
    : parameter(parameter),
      isOpen(false)
   {
     log.Debug() << "Database::Database()";
+
+    if (parameter.GetMemoryGovernor()) {
+      memoryGovernor=parameter.GetMemoryGovernor();
+    }
+    else if (parameter.GetCacheMemory()>0) {
+      memoryGovernor=std::make_shared<MemoryGovernor>(parameter.GetCacheMemory());
+    }
   }
 
   Database::~Database()
@@ -212,14 +423,144 @@ namespace osmscout {
 
     isOpen=true;
 
+    // Hot indexes are otherwise opened on first use, we open them now to
+    // move the cost of prefaulting to startup
+    if (parameter.GetPrefaultMMap() ||
+        parameter.GetInterleaveMMap()) {
+      StopClock timer;
+
+      GetAreaNodeIndex();
+      GetAreaWayIndex();
+      GetAreaAreaIndex();
+      GetAreaRouteIndex();
+
+      timer.Stop();
+
+      log.Debug() << "Prefaulting hot indexes: " << timer.ResultString();
+    }
+
     return true;
   }
 
+  /**
+   * Open the database in a background thread and warm it up afterwards
+   * (see Warmup()). The future returns true, if opening and all warmup
+   * steps succeeded.
+   *
+   * The database must not be used, closed or destroyed before the future
+   * is ready.
+   */
+  std::future<bool> Database::OpenAsync(const std::string& path,
+                                        const DatabaseWarmupParameter& warmupParameter)
+  {
+    return std::async(std::launch::async,
+                      [this,path,warmupParameter]() {
+                        if (!Open(path)) {
+                          return false;
+                        }
+
+                        return WarmupInternal(warmupParameter);
+                      });
+  }
+
   bool Database::IsOpen() const
   {
     return isOpen;
   }
 
+  /**
+   * Open all data files and indexes, that are otherwise opened on first use,
+   * in parallel and optionally prefault their memory mapped pages, so that the
+   * first requests do not pay for it. The future returns true, if all files
+   * could be opened.
+   *
+   * The database must already be open and must not be closed or destroyed
+   * before the future is ready. Method is thread-safe.
+   */
+  std::future<bool> Database::Warmup(const DatabaseWarmupParameter& warmupParameter) const
+  {
+    return std::async(std::launch::async,
+                      [this,warmupParameter]() {
+                        return WarmupInternal(warmupParameter);
+                      });
+  }
+
+  bool Database::WarmupInternal(const DatabaseWarmupParameter& warmupParameter) const
+  {
+    if (!IsOpen()) {
+      log.Error() << "Cannot warm up database, it is not open";
+      return false;
+    }
+
+    StopClock                          timer;
+    bool                               prefault=warmupParameter.GetPrefault();
+    std::vector<std::function<bool()>> steps;
+
+    if (warmupParameter.GetDataFiles()) {
+      steps.emplace_back([this]() {
+        return GetBoundingBoxDataFile()!=nullptr;
+      });
+      steps.emplace_back([this,prefault]() {
+        NodeDataFileRef dataFile=GetNodeDataFile();
+        return dataFile && (!prefault || dataFile->Prefault());
+      });
+      steps.emplace_back([this,prefault]() {
+        AreaDataFileRef dataFile=GetAreaDataFile();
+        return dataFile && (!prefault || dataFile->Prefault());
+      });
+      steps.emplace_back([this,prefault]() {
+        WayDataFileRef dataFile=GetWayDataFile();
+        return dataFile && (!prefault || dataFile->Prefault());
+      });
+      steps.emplace_back([this,prefault]() {
+        RouteDataFileRef dataFile=GetRouteDataFile();
+        return dataFile && (!prefault || dataFile->Prefault());
+      });
+    }
+
+    if (warmupParameter.GetIndexes()) {
+      steps.emplace_back([this,prefault]() {
+        AreaNodeIndexRef index=GetAreaNodeIndex();
+        return index && (!prefault || index->Prefault());
+      });
+      steps.emplace_back([this,prefault]() {
+        AreaAreaIndexRef index=GetAreaAreaIndex();
+        // A preloaded index does not read the file anymore
+        return index && (!prefault || index->IsPreloaded() || index->Prefault());
+      });
+      steps.emplace_back([this,prefault]() {
+        AreaWayIndexRef index=GetAreaWayIndex();
+        return index && (!prefault || index->Prefault());
+      });
+      steps.emplace_back([this,prefault]() {
+        AreaRouteIndexRef index=GetAreaRouteIndex();
+        return index && (!prefault || index->Prefault());
+      });
+      steps.emplace_back([this]() {
+        return GetLocationIndex()!=nullptr;
+      });
+      steps.emplace_back([this]() {
+        return GetWaterIndex()!=nullptr;
+      });
+      steps.emplace_back([this]() {
+        return GetOptimizeAreasLowZoom()!=nullptr;
+      });
+      steps.emplace_back([this]() {
+        return GetOptimizeWaysLowZoom()!=nullptr;
+      });
+    }
+
+    size_t threadCount=std::min(warmupParameter.GetThreadCount(),steps.size());
+    bool   result=RunConcurrently(steps,
+                                  threadCount);
+
+    timer.Stop();
+
+    log.Debug() << "Warmup of database with " << threadCount << " threads: " << timer.ResultString();
+
+    return result;
+  }
+
   void Database::Close()
   {
     boundingBoxDataFile=nullptr;
@@ -319,6 +660,10 @@ namespace osmscout {
 
   NodeDataFileRef Database::GetNodeDataFile() const
   {
+    if (memoryGovernor) {
+      memoryGovernor->RebalanceIfDue();
+    }
+
     std::lock_guard<std::mutex> guard(nodeDataFileMutex);
 
     if (!IsOpen()) {
@@ -327,6 +672,11 @@ namespace osmscout {
 
     if (!nodeDataFile) {
       nodeDataFile=std::make_shared<NodeDataFile>(parameter.GetNodeDataCacheSize());
+
+      if (memoryGovernor) {
+        nodeDataFile->SetMemoryGovernor(memoryGovernor,
+                                        double(parameter.GetNodeDataCacheSize()));
+      }
     }
 
     if (!nodeDataFile->IsOpen()) {
@@ -349,6 +699,10 @@ namespace osmscout {
 
   AreaDataFileRef Database::GetAreaDataFile() const
   {
+    if (memoryGovernor) {
+      memoryGovernor->RebalanceIfDue();
+    }
+
     std::lock_guard<std::mutex> guard(areaDataFileMutex);
 
     if (!IsOpen()) {
@@ -357,6 +711,11 @@ namespace osmscout {
 
     if (!areaDataFile) {
       areaDataFile=std::make_shared<AreaDataFile>(parameter.GetAreaDataCacheSize());
+
+      if (memoryGovernor) {
+        areaDataFile->SetMemoryGovernor(memoryGovernor,
+                                        double(parameter.GetAreaDataCacheSize()));
+      }
     }
 
     if (!areaDataFile->IsOpen()) {
@@ -379,6 +738,10 @@ namespace osmscout {
 
   WayDataFileRef Database::GetWayDataFile() const
   {
+    if (memoryGovernor) {
+      memoryGovernor->RebalanceIfDue();
+    }
+
     std::lock_guard<std::mutex> guard(wayDataFileMutex);
 
     if (!IsOpen()) {
@@ -387,6 +750,11 @@ namespace osmscout {
 
     if (!wayDataFile) {
       wayDataFile=std::make_shared<WayDataFile>(parameter.GetWayDataCacheSize());
+
+      if (memoryGovernor) {
+        wayDataFile->SetMemoryGovernor(memoryGovernor,
+                                       double(parameter.GetWayDataCacheSize()));
+      }
     }
 
     if (!wayDataFile->IsOpen()) {
@@ -409,6 +777,10 @@ namespace osmscout {
 
   RouteDataFileRef Database::GetRouteDataFile() const
   {
+    if (memoryGovernor) {
+      memoryGovernor->RebalanceIfDue();
+    }
+
     std::lock_guard<std::mutex> guard(routeDataFileMutex);
 
     if (!IsOpen()) {
@@ -417,6 +789,11 @@ namespace osmscout {
 
     if (!routeDataFile) {
       routeDataFile=std::make_shared<RouteDataFile>(parameter.GetRouteDataCacheSize());
+
+      if (memoryGovernor) {
+        routeDataFile->SetMemoryGovernor(memoryGovernor,
+                                         double(parameter.GetRouteDataCacheSize()));
+      }
     }
 
     if (!routeDataFile->IsOpen()) {
@@ -450,7 +827,9 @@ namespace osmscout {
 
       StopClock timer;
 
-      if (!areaNodeIndex->Open(path, parameter.GetIndexMMap())) {
+      if (!areaNodeIndex->Open(path,
+                               parameter.GetIndexMMap(),
+                               parameter.GetHotFileMMapAdvice())) {
         log.Error() << "Cannot load area node index!";
         areaNodeIndex=nullptr;
 
@@ -478,13 +857,30 @@ namespace osmscout {
 
       StopClock timer;
 
-      if (!areaAreaIndex->Open(path, parameter.GetIndexMMap())) {
+      if (!areaAreaIndex->Open(path,
+                               parameter.GetIndexMMap(),
+                               parameter.GetHotFileMMapAdvice())) {
         log.Error() << "Cannot load area area index!";
         areaAreaIndex=nullptr;
 
         return nullptr;
       }
 
+      if (parameter.GetAreaAreaIndexPreload() &&
+          !areaAreaIndex->Preload(*typeConfig)) {
+        log.Error() << "Cannot preload area area index!";
+        areaAreaIndex=nullptr;
+
+        return nullptr;
+      }
+
+      // A preloaded index does not use its cache
+      if (memoryGovernor &&
+          !areaAreaIndex->IsPreloaded()) {
+        areaAreaIndex->SetMemoryGovernor(memoryGovernor,
+                                         double(parameter.GetAreaAreaIndexCacheSize()));
+      }
+
       timer.Stop();
 
       log.Debug() << "Opening AreaAreaIndex: " << timer.ResultString();
@@ -508,7 +904,8 @@ namespace osmscout {
 
       if (!areaWayIndex->Open(typeConfig,
                               path,
-                              parameter.GetIndexMMap())) {
+                              parameter.GetIndexMMap(),
+                              parameter.GetHotFileMMapAdvice())) {
         log.Error() << "Cannot load area way index!";
         areaWayIndex=nullptr;
 
@@ -538,7 +935,8 @@ namespace osmscout {
 
       if (!areaRouteIndex->Open(typeConfig,
                                 path,
-                                parameter.GetIndexMMap())) {
+                                parameter.GetIndexMMap(),
+                                parameter.GetHotFileMMapAdvice())) {
         log.Error() << "Cannot load area way index!";
         areaRouteIndex=nullptr;
 
@@ -889,6 +1287,22 @@ namespace osmscout {
 
   void Database::DumpStatistics()
   {
+    if (nodeDataFile) {
+      nodeDataFile->DumpStatistics();
+    }
+
+    if (areaDataFile) {
+      areaDataFile->DumpStatistics();
+    }
+
+    if (wayDataFile) {
+      wayDataFile->DumpStatistics();
+    }
+
+    if (routeDataFile) {
+      routeDataFile->DumpStatistics();
+    }
+
     if (areaAreaIndex) {
       areaAreaIndex->DumpStatistics();
     }
@@ -900,6 +1314,10 @@ namespace osmscout {
     if (waterIndex) {
       waterIndex->DumpStatistics();
     }
+
+    if (memoryGovernor) {
+      memoryGovernor->DumpStatistics();
+    }
   }
 
   void Database::FlushCache()
@@ -29,4 +29,14 @@ namespace osmscout {
   {
     // no code
   }
+
+  size_t WayDataFile::GetValueMemory(const Way& way) const
+  {
+    size_t memory=sizeof(Way);
+
+    memory+=way.nodes.capacity()*sizeof(Point);
+    memory+=way.segments.capacity()*sizeof(SegmentGeoBox);
+
+    return memory;
+  }
 }
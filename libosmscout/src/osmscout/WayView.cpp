@@ -0,0 +1,51 @@
+/*
+  This source is part of the libosmscout library
+  Copyright (C) 2026  Tim Teulings
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307  USA
+*/
+
+#include <osmscout/WayView.h>
+
+namespace osmscout {
+
+  /**
+   * Read the data from the given memory mapped FileScanner, see Way::Read().
+   *
+   * @throws IOException
+   */
+  void WayView::Read(const TypeConfig& typeConfig,
+                     FileScanner& scanner)
+  {
+    TypeId typeId;
+
+    fileOffset=scanner.GetPos();
+
+    scanner.ReadTypeId(typeId,
+                       typeConfig.GetWayTypeIdBytes());
+
+    TypeInfoRef type=typeConfig.GetWayTypeInfo(typeId);
+
+    featureValueBuffer.SetType(type);
+
+    featureValueBuffer.Read(scanner);
+
+    scanner.Read(nodes,
+                 type->CanRoute() ||
+                 type->GetOptimizeLowZoom());
+
+    nextFileOffset=scanner.GetPos();
+  }
+}
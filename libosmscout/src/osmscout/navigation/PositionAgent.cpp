@@ -167,9 +167,7 @@ namespace osmscout {
       return d.AsMeter()/(one_degree_at_equator*cos(M_PI*latitude/180));
     }
 
-    double GetVehicleSpeed(osmscout::Vehicle vehicle,
-                           const TypeConfig &/*typeConfig*/,
-                           const TypeInfo &/*typeInfo*/)
+    double GetMaxVehicleSpeed(osmscout::Vehicle vehicle)
     {
       switch (vehicle){
         case vehicleFoot:
@@ -182,6 +180,13 @@ namespace osmscout {
       assert(false);
       return 6;
     }
+
+    double GetVehicleSpeed(osmscout::Vehicle vehicle,
+                           const TypeConfig &/*typeConfig*/,
+                           const TypeInfo &/*typeInfo*/)
+    {
+      return GetMaxVehicleSpeed(vehicle);
+    }
   }
 
   PositionAgent::PositionAgent()
@@ -250,11 +255,17 @@ namespace osmscout {
 
     if (gps.GetState(now)==Good){
       auto foundNode = position.routeNode;
+      auto searchEnd = route->Nodes().cend();
       double foundAbscissa = 0.0;
       double minDistance = 0.0;
       GeoCoord coord{0,0};
+      if (position.routeNode != route->Nodes().cend() &&
+          (position.state == OnRoute || position.state == NoGpsSignal || position.state == EstimateInTunnel)) {
+        searchEnd=GetReachableRouteEnd(now);
+      }
       bool found=SearchClosestSegment(gps.position,
                                       position.routeNode,
+                                      searchEnd,
                                       coord,
                                       foundNode,
                                       foundAbscissa,
@@ -262,6 +273,7 @@ namespace osmscout {
       if (found && foundNode!=route->Nodes().end()) {
         position.state=OnRoute;
         position.routeNode=foundNode;
+        lastOnRoute=now;
         position.coord=coord;
         position.databaseId=foundNode->GetDatabaseId();
         position.typeConfig=routableObjects->GetTypeConfig(foundNode->GetDatabaseId());
@@ -372,16 +384,37 @@ namespace osmscout {
     return result;
   }
 
+  /**
+   * Return the end of the part of the route, that the vehicle may have reached
+   * since it was found on the route the last time, driving with its maximum speed.
+   * The node is found by a binary search on the distance of the route nodes.
+   */
+  RouteDescription::NodeIterator PositionAgent::GetReachableRouteEnd(const Timestamp& now) const
+  {
+    using namespace std::chrono;
+    double   hours=std::max(0.0,duration_cast<duration<double,std::ratio<3600>>>(now-lastOnRoute).count());
+    Distance reachable=Kilometers(GetMaxVehicleSpeed(vehicle)*hours)+gps.horizontalAccuracy+snapDistanceInMeters;
+    auto     node=route->FindNodeByDistance(position.routeNode->GetDistance()+reachable);
+
+    // the segment starting at the node is reachable, the node after it ends the search
+    if (std::distance(node,route->Nodes().cend())>2) {
+      return std::next(node,2);
+    }
+
+    return route->Nodes().cend();
+  }
+
   /**
      * return true and set foundNode with the start node of the closest route segment from the location and foundAbscissa with the abscissa
      * of the projected point on the line, return false if there is no such point that is closer than snapDistanceInMeters
      * from the route.
-     * The search start a the locationOnRoute node toward the end.
+     * The search start a the locationOnRoute node toward the searchEnd node.
      */
   bool PositionAgent::SearchClosestSegment(const GeoCoord& location,
-                                           const std::list<RouteDescription::Node>::const_iterator& locationOnRoute,
+                                           const RouteDescription::NodeIterator& locationOnRoute,
+                                           const RouteDescription::NodeIterator& searchEnd,
                                            GeoCoord &closestPosition,
-                                           std::list<RouteDescription::Node>::const_iterator& foundNode,
+                                           RouteDescription::NodeIterator& foundNode,
                                            double& foundAbscissa,
                                            double& minDistance)
   {
@@ -393,8 +426,8 @@ namespace osmscout {
                                                      location.GetLat());
 
     minDistance=std::numeric_limits<double>::max();
-    for (auto node=nextNode++; node!=route->Nodes().end(); node++) {
-      if (nextNode==route->Nodes().end()) {
+    for (auto node=nextNode++; node!=searchEnd; node++) {
+      if (nextNode==searchEnd) {
         break;
       }
       double d=DistanceToSegment(location.GetLon(),
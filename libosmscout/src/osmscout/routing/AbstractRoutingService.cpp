@@ -19,6 +19,10 @@
 */
 
 #include <algorithm>
+#include <array>
+#include <cmath>
+#include <iterator>
+#include <thread>
 
 #include <osmscout/routing/RoutingService.h>
 #include <osmscout/routing/RoutingProfile.h>
@@ -31,6 +35,7 @@
 #include <osmscout/util/Geometry.h>
 #include <osmscout/util/Logger.h>
 #include <osmscout/util/StopClock.h>
+#include <osmscout/util/WorkQueue.h>
 
 #include <iomanip>
 #include <iostream>
@@ -82,9 +87,24 @@ namespace osmscout {
   {
   }
 
+  RoutingMatrixResult::RoutingMatrixResult()
+    : success(false),
+      targetCount(0)
+  {
+  }
+
+  RoutingMatrixResult::RoutingMatrixResult(size_t sourceCount,
+                                           size_t targetCount)
+    : success(true),
+      targetCount(targetCount),
+      entries(sourceCount*targetCount)
+  {
+  }
+
   template <class RoutingState>
   AbstractRoutingService<RoutingState>::AbstractRoutingService(const RouterParameter& parameter):
-    debugPerformance(parameter.IsDebugPerformance())
+    debugPerformance(parameter.IsDebugPerformance()),
+    inMemoryGraph(parameter.IsInMemoryGraph())
   {
   }
 
@@ -99,12 +119,12 @@ namespace osmscout {
                                                                      const ClosedSet& closedRestrictedSet,
                                                                      std::list<VNode>& nodes)
   {
-    bool restricted=false;
-    auto current=closedSet.find(VNode(finalRouteNode));
+    bool         restricted=false;
+    const VNode* current=closedSet.Find(finalRouteNode);
 
-    if (current==closedSet.end()){
-      current=closedRestrictedSet.find(VNode(finalRouteNode));
-      assert(current!=closedSet.end());
+    if (current==nullptr){
+      current=closedRestrictedSet.Find(finalRouteNode);
+      assert(current!=nullptr);
       restricted=true;
     }
 
@@ -112,19 +132,19 @@ namespace osmscout {
 #if defined(DEBUG_ROUTING)
       std::cout << "Chain item " << current->currentNode << " -> " << current->previousNode << std::endl;
 #endif
-      ClosedSet::const_iterator prev;
+      const VNode* prev;
       if (!restricted){
-        prev=closedSet.find(VNode(current->previousNode));
-        if (prev==closedSet.end()){
-          prev=closedRestrictedSet.find(VNode(current->previousNode));
-          assert(prev!=closedRestrictedSet.end());
+        prev=closedSet.Find(current->previousNode);
+        if (prev==nullptr){
+          prev=closedRestrictedSet.Find(current->previousNode);
+          assert(prev!=nullptr);
           restricted=true;
         }
       }else{
-        prev=closedRestrictedSet.find(VNode(current->previousNode));
-        if (prev==closedRestrictedSet.end()){
-          prev=closedSet.find(VNode(current->previousNode));
-          assert(prev!=closedSet.end());
+        prev=closedRestrictedSet.Find(current->previousNode);
+        if (prev==nullptr){
+          prev=closedSet.Find(current->previousNode);
+          assert(prev!=nullptr);
           restricted=false;
         }
       }
@@ -271,11 +291,12 @@ namespace osmscout {
                                                       const RouteNodeRef& routeNode,
                                                       const GeoCoord& startCoord,
                                                       const GeoCoord& targetCoord,
+                                                      RNodePool& pool,
                                                       RNodeRef& node)
   {
-    node=std::make_shared<RNode>(DBId(position.GetDatabaseId(),routeNode->GetId()),
-                                 routeNode,
-                                 position.GetObjectFileRef());
+    node=pool.Allocate(DBId(position.GetDatabaseId(),routeNode->GetId()),
+                       routeNode,
+                       position.GetObjectFileRef());
 
     node->currentCost=GetCosts(state,
                                position.GetDatabaseId(),
@@ -309,6 +330,8 @@ namespace osmscout {
    *    Optional route node in the forward direction
    * @param backwardRouteNode
    *    Optional route node in the backward direction
+   * @param pool
+   *    Pool to allocate the routing nodes from
    * @param forwardRNode
    *    Optional prefilled routing node for the forward direction to be used as part of the routing process
    * @param backwardRNode
@@ -323,6 +346,7 @@ namespace osmscout {
                                                               const GeoCoord& targetCoord,
                                                               RouteNodeRef& forwardRouteNode,
                                                               RouteNodeRef& backwardRouteNode,
+                                                              RNodePool& pool,
                                                               RNodeRef& forwardRNode,
                                                               RNodeRef& backwardRNode)
   {
@@ -384,6 +408,7 @@ namespace osmscout {
                   forwardRouteNode,
                   startCoord,
                   targetCoord,
+                  pool,
                   forwardRNode)) {
       return false;
     }
@@ -396,6 +421,7 @@ namespace osmscout {
                   backwardRouteNode,
                   startCoord,
                   targetCoord,
+                  pool,
                   backwardRNode)) {
       return false;
     }
@@ -420,6 +446,8 @@ namespace osmscout {
    *    Optional route node in the forward direction
    * @param backwardRouteNode
    *    Optional route node in the backward direction
+   * @param pool
+   *    Pool to allocate the routing nodes from
    * @param forwardRNode
    *    Optional prefilled routing node for the forward direction to be used as part of the routing process
    * @param backwardRNode
@@ -434,6 +462,7 @@ namespace osmscout {
                                                            const GeoCoord& targetCoord,
                                                            RouteNodeRef& forwardRouteNode,
                                                            RouteNodeRef& backwardRouteNode,
+                                                           RNodePool& pool,
                                                            RNodeRef& forwardRNode,
                                                            RNodeRef& backwardRNode)
   {
@@ -444,6 +473,7 @@ namespace osmscout {
                               targetCoord,
                               forwardRouteNode,
                               backwardRouteNode,
+                              pool,
                               forwardRNode,
                               backwardRNode);
     }
@@ -566,6 +596,7 @@ namespace osmscout {
   bool AbstractRoutingService<RoutingState>::WalkToOtherDatabases(const RoutingState& state,
                                                                   RNodeRef &current,
                                                                   RouteNodeRef &currentRouteNode,
+                                                                  RNodePool &pool,
                                                                   OpenList &openList,
                                                                   OpenMap &openMap,
                                                                   const ClosedSet &closedSet,
@@ -577,19 +608,20 @@ namespace osmscout {
                                          currentRouteNode->GetId());
     for (const auto& twin : twins) {
       if ((current->access &&
-           closedSet.find(VNode(twin))!=closedSet.end()) ||
+           closedSet.Contains(twin)) ||
           (!current->access &&
-            closedRestrictedSet.find(VNode(twin))!=closedRestrictedSet.end())){
+           closedRestrictedSet.Contains(twin))){
 #if defined(DEBUG_ROUTING)
         std::cout << "Twin node " << twin << " is closed already, ignore it" << std::endl;
 #endif
         continue;
       }
 
-      auto twinIt=openMap.find(twin);
+      RNodeRef* twinEntry=openMap.Find(twin);
 
-      if (twinIt!=openMap.end()){
-        RNodeRef rn=(*twinIt->second);
+      if (twinEntry!=nullptr &&
+          (*twinEntry)->heapIndex!=OpenListNPos){
+        RNodeRef rn=*twinEntry;
         if (rn->currentCost > current->currentCost) {
           // this is cheaper path to twin
 
@@ -601,10 +633,7 @@ namespace osmscout {
           rn->overallCost=current->overallCost;
           rn->access=current->access;
 
-          openList.erase(twinIt->second);
-
-          std::pair<OpenListRef,bool> insertResult=openList.insert(rn);
-          twinIt->second=insertResult.first;
+          openList.Update(rn);
 
 #if defined(DEBUG_ROUTING)
           std::cout << "Better transition from " << rn->prev << " to " << rn->id << std::endl;
@@ -616,19 +645,19 @@ namespace osmscout {
         if (!GetRouteNode(twin,node)){
           return false;
         }
-        RNodeRef rn=std::make_shared<RNode>(twin,
-                                            node,
-                                            //node->objects.begin()->object, /*TODO: how to find correct way from other DB?*/
-                                            ObjectFileRef(), // TODO: have to be valid Object here?
-                                            /*prev*/current->id);
+        RNodeRef rn=pool.Allocate(twin,
+                                  node,
+                                  //node->objects.begin()->object, /*TODO: how to find correct way from other DB?*/
+                                  ObjectFileRef(), // TODO: have to be valid Object here?
+                                  /*prev*/current->id);
 
         rn->currentCost=current->currentCost;
         rn->estimateCost=current->estimateCost;
         rn->overallCost=current->overallCost;
         rn->access=current->access;
 
-        std::pair<OpenListRef,bool> insertResult=openList.insert(rn);
-        openMap[rn->id]=insertResult.first;
+        openList.Push(rn);
+        openMap[rn->id]=rn;
 
 #if defined(DEBUG_ROUTING)
         std::cout << "Transition from " << rn->prev << " to " << rn->id << std::endl;
@@ -642,6 +671,7 @@ namespace osmscout {
   bool AbstractRoutingService<RoutingState>::WalkPaths(const RoutingState &state,
                                                        RNodeRef &current,
                                                        RouteNodeRef &currentRouteNode,
+                                                       RNodePool &pool,
                                                        OpenList &openList,
                                                        OpenMap &openMap,
                                                        ClosedSet &closedSet,
@@ -719,9 +749,9 @@ namespace osmscout {
       }
 
       if ((current->access &&
-           closedSet.find(VNode(DBId(dbId,path.id)))!=closedSet.end()) ||
+           closedSet.Contains(DBId(dbId,path.id))) ||
           (!current->access &&
-           closedRestrictedSet.find(VNode(DBId(dbId,path.id)))!=closedRestrictedSet.end())) {
+           closedRestrictedSet.Contains(DBId(dbId,path.id)))) {
 #if defined(DEBUG_ROUTING)
         std::cout << "  Skipping route";
         std::cout << " to " << dbId << " / " << path.id;
@@ -764,37 +794,29 @@ namespace osmscout {
                                                        inPathValid ? inPathIndex : i,
                                                        i);
 
-      auto openEntry=openMap.find(DBId(current->id.database,
-                                       path.id));
+      RNodeRef* openMapEntry=openMap.Find(DBId(current->id.database,
+                                               path.id));
+      RNodeRef  openEntry=openMapEntry!=nullptr &&
+                          (*openMapEntry)->heapIndex!=OpenListNPos ? *openMapEntry : nullptr;
 
       // Check, if we already have a cheaper path to the new node. If yes, do not put the new path
       // into the open list
-      if (openEntry!=openMap.end() &&
-          (*openEntry->second)->currentCost<=currentCost) {
+      if (openEntry!=nullptr &&
+          openEntry->currentCost<=currentCost) {
 #if defined(DEBUG_ROUTING)
         std::cout << "  Skipping route";
         std::cout << " to " << dbId << " / " << path.id;
         std::cout << " (" << currentRouteNode->objects[path.objectIndex].object.GetName() << ")";
-        std::cout << " => cheaper route exists " << currentCost << "<=>" << (*openEntry->second)->object.GetName() << " " << (*openEntry->second)->node->GetId() << " " << (*openEntry->second)->currentCost << std::endl;
+        std::cout << " => cheaper route exists " << currentCost << "<=>" << openEntry->object.GetName() << " " << openEntry->id << " " << openEntry->currentCost << std::endl;
 #endif
         i++;
 
         continue;
       }
 
-      RouteNodeRef nextNode;
-
-      if (openEntry!=openMap.end()) {
-        nextNode=(*openEntry->second)->node;
-      }
-      else if (!GetRouteNode(DBId(current->id.database,
-                                  path.id),
-                             nextNode)) {
-        log.Error() << "Cannot load route node with id " << path.id;
-        return false;
-      }
-
-      Distance distanceToTarget=GetSphericalDistance(nextNode->GetCoord(),
+      // The id of a route node encodes its coordinate, the route node itself
+      // is only loaded, if it gets expanded
+      Distance distanceToTarget=GetSphericalDistance(Point::GetCoordFromId(path.id),
                                                    targetCoord);
 
       currentMaxDistance=Distance::Max(currentMaxDistance,overallDistance-distanceToTarget);
@@ -824,8 +846,8 @@ namespace osmscout {
 
       // If we already have the node in the open list, but the new path is cheaper (as tested above),
       // update the existing entry
-      if (openEntry!=openMap.end()) {
-        RNodeRef node=*openEntry->second;
+      if (openEntry!=nullptr) {
+        RNodeRef node=openEntry;
 
         node->prev=current->id;
         node->object=currentRouteNode->objects[path.objectIndex].object;
@@ -839,16 +861,13 @@ namespace osmscout {
         std::cout << "  Updating route " << current->id << " via " << node->object.GetTypeName() << " " << node->object.GetFileOffset() << " " << currentCost << " " << estimateCost << " " << overallCost << " " << currentRouteNode->GetId() << std::endl;
 #endif
 
-        openList.erase(openEntry->second);
-
-        std::pair<OpenListRef,bool> insertResult=openList.insert(node);
-        openEntry->second=insertResult.first;
+        openList.Update(node);
       }
       else {
-        RNodeRef node=std::make_shared<RNode>(DBId(dbId,path.id),
-                                              nextNode,
-                                              currentRouteNode->objects[path.objectIndex].object,
-                                              current->id);
+        RNodeRef node=pool.Allocate(DBId(dbId,path.id),
+                                    nullptr,
+                                    currentRouteNode->objects[path.objectIndex].object,
+                                    current->id);
 
         node->currentCost=currentCost;
         node->estimateCost=estimateCost;
@@ -861,8 +880,8 @@ namespace osmscout {
         std::cout << " " << currentCost << " " << estimateCost << " " << overallCost << " " << currentRouteNode->GetId() << std::endl;
 #endif
 
-        std::pair<OpenListRef,bool> insertResult=openList.insert(node);
-        openMap[node->id]=insertResult.first;
+        openList.Push(node);
+        openMap[node->id]=node;
       }
 
       i++;
@@ -893,12 +912,30 @@ namespace osmscout {
                                                                      const RoutePosition& target,
                                                                      const RoutingParameter& parameter)
   {
+    if (parameter.GetDepartureTime()) {
+      if (HasTimeCosts(state)) {
+        return CalculateRouteTimeDependent(state,
+                                           start,
+                                           target,
+                                           parameter);
+      }
+
+      log.Warn() << "Departure time ignored, time-dependent routing needs a profile with time costs";
+    }
+
+    if (parameter.IsBidirectional()) {
+      return CalculateRouteBidirectional(state,
+                                         start,
+                                         target,
+                                         parameter);
+    }
+
     RoutingResult            result;
     Vehicle                  vehicle=GetVehicle(state);
     RouteNodeRef             startForwardRouteNode;
     RouteNodeRef             startBackwardRouteNode;
-    RNodeRef                 startForwardNode;
-    RNodeRef                 startBackwardNode;
+    RNodeRef                 startForwardNode=nullptr;
+    RNodeRef                 startBackwardNode=nullptr;
 
     GeoCoord                 startCoord;
     GeoCoord                 targetCoord;
@@ -906,7 +943,9 @@ namespace osmscout {
     RouteNodeRef             targetForwardRouteNode;
     RouteNodeRef             targetBackwardRouteNode;
 
-    // Sorted list (smallest cost first) of ways to check (we are using a std::set)
+    // All routing nodes of this routing run
+    RNodePool                pool;
+    // Heap (smallest cost first) of ways to check
     OpenList                 openList;
     // Map routing nodes by id
     OpenMap                  openMap;
@@ -923,6 +962,7 @@ namespace osmscout {
     size_t                   maxOpenList=0;
     size_t                   maxClosedSet=0;
 
+    openList.reserve(10000);
     openMap.reserve(10000);
     closedSet.reserve(300000);
     closedRestrictedSet.reserve(10000);
@@ -941,6 +981,7 @@ namespace osmscout {
                        targetCoord,
                        startForwardRouteNode,
                        startBackwardRouteNode,
+                       pool,
                        startForwardNode,
                        startBackwardNode)) {
       return result;
@@ -971,15 +1012,13 @@ namespace osmscout {
     }
 
     if (startForwardNode) {
-      std::pair<OpenListRef,bool> insertResult=openList.insert(startForwardNode);
-
-      openMap[startForwardNode->id]=insertResult.first;
+      openList.Push(startForwardNode);
+      openMap[startForwardNode->id]=startForwardNode;
     }
 
     if (startBackwardNode) {
-      std::pair<OpenListRef,bool> insertResult=openList.insert(startBackwardNode);
-
-      openMap[startBackwardNode->id]=insertResult.first;
+      openList.Push(startBackwardNode);
+      openMap[startBackwardNode->id]=startBackwardNode;
     }
 
 
@@ -993,13 +1032,13 @@ namespace osmscout {
     result.SetCurrentMaxDistance(currentMaxDistance);
 
     StopClock    clock;
-    RNodeRef     current;
+    RNodeRef     current=nullptr;
     RouteNodeRef currentRouteNode;
     DatabaseId   dbId;
     bool         targetForwardFound=targetForwardRouteNode ? false : true;
     bool         targetBackwardFound=targetBackwardRouteNode ? false : true;
-    RNodeRef     targetForwardFinalNode;
-    RNodeRef     targetBackwardFinalNode;
+    RNodeRef     targetForwardFinalNode=nullptr;
+    RNodeRef     targetBackwardFinalNode=nullptr;
 
     do {
       //
@@ -1011,10 +1050,14 @@ namespace osmscout {
         return result;
       }
 
-      current=*openList.begin();
+      current=openList.Pop();
 
-      openMap.erase(current->id);
-      openList.erase(openList.begin());
+      if (!current->node &&
+          !GetRouteNode(current->id,
+                        current->node)) {
+        log.Error() << "Cannot load route node with id " << current->id.database << " / " << current->id.id;
+        return result;
+      }
 
       currentRouteNode=current->node;
       dbId=current->id.database;
@@ -1032,6 +1075,7 @@ namespace osmscout {
       if (!WalkPaths(state,
                      current,
                      currentRouteNode,
+                     pool,
                      openList,
                      openMap,
                      closedSet,
@@ -1057,6 +1101,7 @@ namespace osmscout {
       if (!WalkToOtherDatabases(state,
                                 current,
                                 currentRouteNode,
+                                pool,
                                 openList,
                                 openMap,
                                 closedSet,
@@ -1073,19 +1118,19 @@ namespace osmscout {
         std::cout << "Closing " << current->id << " (previous " << current->prev << ")" << std::endl;
 #endif
       if (current->access) {
-        closedSet.insert(VNode(current->id,
-                               current->object,
-                               current->prev));
+        closedSet[current->id]=VNode(current->id,
+                                     current->object,
+                                     current->prev);
       }
       else {
-        closedRestrictedSet.insert(VNode(current->id,
-                                         current->object,
-                                         current->prev));
+        closedRestrictedSet[current->id]=VNode(current->id,
+                                               current->object,
+                                               current->prev);
       }
 
       current->node=nullptr;
 
-      maxOpenList=std::max(maxOpenList,openMap.size());
+      maxOpenList=std::max(maxOpenList,openList.size());
       maxClosedSet=std::max(maxClosedSet,closedSet.size()+closedRestrictedSet.size());
 
 #if defined(DEBUG_ROUTING)
@@ -1126,12 +1171,12 @@ namespace osmscout {
 
     // If we have keep the last node open because of access violations, add it
     // after routing is done
-    if (closedSet.find(VNode(current->id))==closedSet.end()) {
-      closedSet.insert(VNode(current->id,
-                             current->object,
-                             current->prev));
+    if (!closedSet.Contains(current->id)) {
+      closedSet[current->id]=VNode(current->id,
+                                   current->object,
+                                   current->prev);
     }
-    RNodeRef  targetFinalNode;
+    RNodeRef  targetFinalNode=nullptr;
 
     if (targetBackwardFinalNode && targetForwardFinalNode) {
       if (targetForwardFinalNode->currentCost<=targetBackwardFinalNode->currentCost) {
@@ -1247,117 +1292,2149 @@ namespace osmscout {
     return result;
   }
 
+  namespace {
+    /**
+     * Return the index of the path of the route node leading to the given
+     * route node using the given object or the number of paths, if there is no
+     * such path.
+     */
+    size_t FindPathIndex(const RouteNode& routeNode,
+                         Id target,
+                         const ObjectFileRef& object)
+    {
+      for (size_t i=0; i<routeNode.paths.size(); i++) {
+        if (routeNode.paths[i].id==target &&
+            routeNode.objects[routeNode.paths[i].objectIndex].object==object) {
+          return i;
+        }
+      }
+
+      return routeNode.paths.size();
+    }
+
+    bool IsTurnExcluded(const RouteNode& routeNode,
+                        const ObjectFileRef& source,
+                        const ObjectFileRef& target)
+    {
+      for (const auto& exclude : routeNode.excludes) {
+        if (exclude.source==source &&
+            routeNode.objects[exclude.targetIndex].object==target) {
+          return true;
+        }
+      }
+
+      return false;
+    }
+  }
+
+  /**
+   * Calculate a route by searching from start and target at the same time.
+   *
+   * The forward search works like the search of CalculateRoute(). The backward
+   * search walks the paths in reverse direction, evaluating access,
+   * CanUse() and turn restrictions for the original direction. Junction
+   * penalties are accounted at the node, where the turn happens. Since route
+   * nodes only hold paths against the direction of a way if at least one
+   * vehicle may use the way in this direction, the predecessors without path
+   * back (e.g. on oneway ways) are taken from the routing database (see
+   * GetRouteNodePredecessors()).
+   *
+   * Each search labels a route node with an RNode per state (access for the
+   * forward search, "only restricted paths up to the target" for the
+   * backward search) and keeps the open RNodes in its own OpenList. RNode::prev
+   * is the previous (forward) or next (backward) route node.
+   *
+   * Both searches use the average of the estimated costs to the target and
+   * from the start as potential. The search stops as soon as the sum of
+   * the smallest keys of both open lists is not smaller than the costs of the
+   * best route found so far.
+   *
+   * If alternatives are requested, the search continues up to the costs of
+   * the best route multiplied by the maximum stretch. Plateaus are chains of
+   * paths, that are part of both the forward and the backward search tree.
+   * The route from the start through a plateau to the target is locally
+   * optimal along the plateau. Plateaus are evaluated by decreasing length,
+   * a route is accepted, if it does not exceed the maximum stretch and does
+   * not overlap too much with the routes accepted before.
+   */
   template <class RoutingState>
-  void AbstractRoutingService<RoutingState>::AddNodes(RouteData& route,
-                                                      DatabaseId database,
-                                                      Id startNodeId,
-                                                      size_t startNodeIndex,
-                                                      const ObjectFileRef& object,
-                                                      size_t idCount,
-                                                      bool oneway,
-                                                      size_t targetNodeIndex)
+  void AbstractRoutingService<RoutingState>::CalculateRoutesBidirectional(RoutingState& state,
+                                                                          const RoutePosition& start,
+                                                                          const RoutePosition& target,
+                                                                          const RoutingParameter& parameter,
+                                                                          const AlternativeRouteParameter& alternativeParameter,
+                                                                          RoutingResult& result,
+                                                                          AlternativeRoutingResult& routes)
   {
-    assert(startNodeIndex<idCount);
-    assert(targetNodeIndex<idCount);
+    Vehicle                                 vehicle=GetVehicle(state);
+    RouteNodeRef                            startForwardRouteNode;
+    RouteNodeRef                            startBackwardRouteNode;
+    RNodePool                               pool;
+    RNodeLabels<BidirectionalLabel>         bidirectionalLabels;
+    RNodeRef                                startForwardNode=nullptr;
+    RNodeRef                                startBackwardNode=nullptr;
+
+    GeoCoord                                startCoord;
+    GeoCoord                                targetCoord;
+
+    RouteNodeRef                            targetForwardRouteNode;
+    RouteNodeRef                            targetBackwardRouteNode;
+
+    // Labels of the forward search, indexed by access (see RNode::access)
+    std::array<OpenMap,2>                   forwardLabels;
+    // Labels of the backward search, indexed by "only restricted paths up to the target"
+    std::array<OpenMap,2>                   backwardLabels;
+    OpenList                                forwardOpenList;
+    OpenList                                backwardOpenList;
+
+    size_t                                  nodesLoadedCount=0;
+    size_t                                  nodesIgnoredCount=0;
 
-    if (std::max(startNodeIndex,targetNodeIndex)-std::min(startNodeIndex,targetNodeIndex)==1) {
-      // From one node to the neighbour node (+1 or -1)
-      route.AddEntry(database,
-                     startNodeId,
-                     startNodeIndex,
-                     object,
-                     targetNodeIndex);
+    if (!GetTargetNodes(state,
+                        target,
+                        targetCoord,
+                        targetForwardRouteNode,
+                        targetBackwardRouteNode)) {
+      return;
     }
-    else if (startNodeIndex<targetNodeIndex) {
-      // Following the way
-      route.AddEntry(database,
-                     startNodeId,
-                     startNodeIndex,
-                     object,
-                     startNodeIndex+1);
 
-      for (size_t i=startNodeIndex+1; i<targetNodeIndex-1; i++) {
-        route.AddEntry(database,
-                       0,
-                       i,
-                       object,
-                       i+1);
-      }
+    if (!GetStartNodes(state,
+                       start,
+                       startCoord,
+                       targetCoord,
+                       startForwardRouteNode,
+                       startBackwardRouteNode,
+                       pool,
+                       startForwardNode,
+                       startBackwardNode)) {
+      return;
+    }
 
-      route.AddEntry(database,
-                     0,
-                     targetNodeIndex-1,
-                     object,
-                     targetNodeIndex);
+    if (parameter.GetBreaker() &&
+        parameter.GetBreaker()->IsAborted()) {
+      return;
     }
-    else if (oneway) {
-      // startNodeIndex>tragetNodeIndex, but this is a oneway we assume
-      // that the way is either an area or is a roundabound
-      // TODO: proof this using the right assertions or checks
-      size_t pos=startNodeIndex+1;
-      size_t next;
 
-      if (pos>=idCount) {
-        pos=0;
+    Distance currentMaxDistance;
+    Distance overallDistance=GetSphericalDistance(startCoord,
+                                                  targetCoord);
+    double   overallCost=GetEstimateCosts(state,start.GetDatabaseId(),overallDistance);
+    double   costLimit=GetCostLimit(state,start.GetDatabaseId(),overallDistance);
+
+    result.SetOverallDistance(overallDistance);
+    result.SetCurrentMaxDistance(currentMaxDistance);
+
+    double   bestCost=std::numeric_limits<double>::infinity();
+    DBId     bestNode;
+    bool     bestForwardState=false;
+    bool     bestBackwardState=false;
+
+    /**
+     * Best combination of forward and backward label at a route node
+     */
+    struct Meeting
+    {
+      double cost;
+      bool   forwardState;
+      bool   backwardState;
+    };
+
+    bool                             withAlternatives=alternativeParameter.maxAlternatives>0;
+    double                           stretchFactor=withAlternatives ? 1.0+alternativeParameter.maxStretch : 1.0;
+    std::unordered_map<DBId,Meeting> meetings;
+
+    auto loadRouteNode=[this,&forwardLabels,&backwardLabels](const DBId& id,
+                                                             RouteNodeRef& routeNode) {
+      for (const auto& labels : {&forwardLabels[0],&forwardLabels[1],&backwardLabels[0],&backwardLabels[1]}) {
+        const RNodeRef* entry=labels->Find(id);
+
+        if (entry!=nullptr) {
+          routeNode=(*entry)->node;
+          return true;
+        }
       }
 
-      next=pos+1;
-      if (next>=idCount) {
-        next=0;
+      return GetRouteNode(id,routeNode);
+    };
+
+    // Penalty for turning at the route node from the incoming to the outgoing object
+    auto getJunctionPenalty=[this,&state](const DBId& id,
+                                          const RouteNode& routeNode,
+                                          const DBId& previous,
+                                          const ObjectFileRef& inObject,
+                                          const DBId& next,
+                                          const ObjectFileRef& outObject) {
+      if (!previous.IsValid() ||
+          !next.IsValid() ||
+          previous.database!=id.database ||
+          next.database!=id.database) {
+        return 0.0;
       }
 
-      route.AddEntry(database,
-                     startNodeId,
-                     startNodeIndex,
-                     object,
-                     pos);
+      size_t inPathIndex=FindPathIndex(routeNode,previous.id,inObject);
+      size_t outPathIndex=FindPathIndex(routeNode,next.id,outObject);
 
-      while (next!=targetNodeIndex) {
-        route.AddEntry(database,
-                       0,
-                       pos,
-                       object,
-                       next);
+      if (inPathIndex>=routeNode.paths.size() ||
+          outPathIndex>=routeNode.paths.size()) {
+        return 0.0;
+      }
 
-        pos++;
-        if (pos>=idCount) {
-          pos=0;
+      return std::max(0.0,
+                      GetCosts(state,id.database,routeNode,inPathIndex,outPathIndex)-
+                      GetCosts(state,id.database,routeNode,outPathIndex,outPathIndex));
+    };
+
+    auto checkMeeting=[&](const DBId& id) {
+      for (bool forwardState : {true,false}) {
+        const RNodeRef* forwardEntry=forwardLabels[forwardState].Find(id);
+
+        if (forwardEntry==nullptr) {
+          continue;
         }
 
-        next=pos+1;
-        if (next>=idCount) {
-          next=0;
+        for (bool backwardState : {true,false}) {
+          // A restricted path must not be followed by an accessible path
+          if (!forwardState &&
+              !backwardState) {
+            continue;
+          }
+
+          const RNodeRef* backwardEntry=backwardLabels[backwardState].Find(id);
+
+          if (backwardEntry==nullptr) {
+            continue;
+          }
+
+          const RNode& forwardLabel=**forwardEntry;
+          const RNode& backwardLabel=**backwardEntry;
+
+          if (forwardLabel.prev.IsValid() &&
+              forwardLabel.prev==backwardLabel.prev) {
+            continue;
+          }
+
+          if (forwardLabel.object.Valid() &&
+              backwardLabel.object.Valid() &&
+              IsTurnExcluded(*forwardLabel.node,forwardLabel.object,backwardLabel.object)) {
+            continue;
+          }
+
+          double cost=forwardLabel.currentCost+
+                      backwardLabel.currentCost+
+                      getJunctionPenalty(id,
+                                         *forwardLabel.node,
+                                         forwardLabel.prev,
+                                         forwardLabel.object,
+                                         backwardLabel.prev,
+                                         backwardLabel.object);
+
+          if (cost<bestCost) {
+            bestCost=cost;
+            bestNode=id;
+            bestForwardState=forwardState;
+            bestBackwardState=backwardState;
+          }
+
+          if (withAlternatives) {
+            auto meeting=meetings.find(id);
+
+            if (meeting==meetings.end()) {
+              meetings.emplace(id,Meeting{cost,forwardState,backwardState});
+            }
+            else if (cost<meeting->second.cost) {
+              meeting->second=Meeting{cost,forwardState,backwardState};
+            }
+          }
         }
       }
+    };
+
+    // Label the route node, if the costs are lower than the costs of the existing label
+    auto relax=[&](bool forward,
+                   const DBId& id,
+                   const RouteNodeRef& routeNode,
+                   double cost,
+                   bool nodeState,
+                   const DBId& other,
+                   bool otherState,
+                   const ObjectFileRef& object) {
+      OpenMap&  labels=forward ? forwardLabels[nodeState] : backwardLabels[nodeState];
+      RNodeRef* entry=labels.Find(id);
+
+      // RNodes taken from the OpenList are settled
+      if (entry!=nullptr &&
+          ((*entry)->heapIndex==OpenListNPos ||
+           (*entry)->currentCost<=cost)) {
+        return;
+      }
 
-      route.AddEntry(database,
-                     0,
-                     pos,
-                     object,
-                     targetNodeIndex);
-    }
-    else {
-      // We follow the way in the opposite direction
-      route.AddEntry(database,
-                     startNodeId,
-                     startNodeIndex,
-                     object,
-                     startNodeIndex-1);
+      Distance distanceToTarget=GetSphericalDistance(routeNode->GetCoord(),targetCoord);
+      Distance distanceFromStart=GetSphericalDistance(startCoord,routeNode->GetCoord());
+      double   estimateToTarget=GetEstimateCosts(state,id.database,distanceToTarget);
+      double   estimateFromStart=GetEstimateCosts(state,id.database,distanceFromStart);
 
-      for (long i=(long)startNodeIndex-1; i>(long)targetNodeIndex+1; i--) {
-        route.AddEntry(database,
-                       0,
-                       (size_t)i,
-                       object,
-                       (size_t)i-1);
+      if (cost+(forward ? estimateToTarget : estimateFromStart)>costLimit) {
+        nodesIgnoredCount++;
+        return;
       }
 
-      route.AddEntry(database,
-                     0,
-                     targetNodeIndex+1,
-                     object,
-                     targetNodeIndex);
+      double potential=(estimateToTarget-estimateFromStart)/2.0;
+
+      currentMaxDistance=Distance::Max(currentMaxDistance,
+                                       overallDistance-(forward ? distanceToTarget : distanceFromStart));
+      result.SetCurrentMaxDistance(currentMaxDistance);
+
+      if (parameter.GetProgress()) {
+        parameter.GetProgress()->Progress(currentMaxDistance,overallDistance);
+      }
+
+      OpenList& openList=forward ? forwardOpenList : backwardOpenList;
+
+      if (entry!=nullptr) {
+        RNodeRef label=*entry;
+
+        label->prev=other;
+        label->object=object;
+        bidirectionalLabels[*label].prevAccess=otherState;
+        label->currentCost=cost;
+        label->overallCost=cost+label->estimateCost;
+
+        openList.Update(label);
+      }
+      else {
+        RNodeRef label=pool.Allocate(id,
+                                     routeNode,
+                                     object,
+                                     other);
+
+        label->access=nodeState;
+        label->currentCost=cost;
+        bidirectionalLabels[*label].prevAccess=otherState;
+        label->estimateCost=forward ? potential : -potential;
+        label->overallCost=cost+label->estimateCost;
+
+        labels[id]=label;
+        openList.Push(label);
+      }
+
+      checkMeeting(id);
+    };
+
+    for (const auto& node : {startForwardNode,startBackwardNode}) {
+      if (node) {
+        relax(true,node->id,node->node,node->currentCost,node->access,DBId(),node->access,node->object);
+      }
+    }
+
+    for (const auto& routeNode : {targetForwardRouteNode,targetBackwardRouteNode}) {
+      if (routeNode) {
+        relax(false,DBId(target.GetDatabaseId(),routeNode->GetId()),routeNode,0.0,true,DBId(),true,ObjectFileRef());
+      }
     }
+
+    auto expandForward=[&](const RNode& label) {
+      const DBId&  id=label.id;
+      bool         access=label.access;
+      RouteNodeRef routeNode=label.node;
+      size_t       inPathIndex=routeNode->paths.size();
+
+      if (label.prev.IsValid() &&
+          label.prev.database==id.database) {
+        inPathIndex=FindPathIndex(*routeNode,label.prev.id,label.object);
+      }
+
+      // in case of roundabout, node don't contains path back
+      bool inPathValid=inPathIndex<routeNode->paths.size();
+
+      for (size_t i=0; i<routeNode->paths.size(); i++) {
+        const RouteNode::Path& path=routeNode->paths[i];
+        const ObjectFileRef&   object=routeNode->objects[path.objectIndex].object;
+
+        if ((label.prev.IsValid() &&
+             path.id==label.prev.id) ||
+            (!access &&
+             !path.IsRestricted(vehicle)) ||
+            !CanUse(state,id.database,*routeNode,i) ||
+            IsTurnExcluded(*routeNode,label.object,object)) {
+          nodesIgnoredCount++;
+          continue;
+        }
+
+        DBId            next(id.database,path.id);
+        bool            nextAccess=!path.IsRestricted(vehicle);
+        RouteNodeRef    nextRouteNode;
+        const RNodeRef* entry=forwardLabels[nextAccess].Find(next);
+
+        if (entry!=nullptr &&
+            (*entry)->heapIndex==OpenListNPos) {
+          continue;
+        }
+
+        if (!loadRouteNode(next,nextRouteNode)) {
+          log.Error() << "Cannot load route node with id " << path.id;
+          return false;
+        }
+
+        relax(true,
+              next,
+              nextRouteNode,
+              label.currentCost+GetCosts(state,
+                                         id.database,
+                                         *routeNode,
+                                         inPathValid ? inPathIndex : i,
+                                         i),
+              nextAccess,
+              id,
+              access,
+              object);
+      }
+
+      for (const auto& twin : GetNodeTwins(state,id.database,routeNode->GetId())) {
+        RouteNodeRef twinRouteNode;
+
+        if (!loadRouteNode(twin,twinRouteNode)) {
+          return false;
+        }
+
+        relax(true,twin,twinRouteNode,label.currentCost,access,id,access,ObjectFileRef());
+      }
+
+      return true;
+    };
+
+    // Predecessors of the route node expanded backward, kept to reuse the memory
+    std::vector<std::pair<Id,ObjectFileRef>> predecessors;
+
+    auto expandBackward=[&](const RNode& label) {
+      const DBId&  id=label.id;
+      bool         restrictedOnly=label.access;
+      RouteNodeRef routeNode=label.node;
+
+      predecessors.clear();
+
+      for (const auto& path : routeNode->paths) {
+        predecessors.emplace_back(path.id,routeNode->objects[path.objectIndex].object);
+      }
+
+      if (!GetRouteNodePredecessors(id,predecessors)) {
+        log.Error() << "Cannot load predecessors of route node with id " << id.database << " / " << id.id;
+        return false;
+      }
+
+      for (const auto& [previousId,object] : predecessors) {
+        if ((label.prev.IsValid() &&
+             previousId==label.prev.id) ||
+            (label.object.Valid() &&
+             IsTurnExcluded(*routeNode,object,label.object))) {
+          nodesIgnoredCount++;
+          continue;
+        }
+
+        DBId         previous(id.database,previousId);
+        RouteNodeRef previousRouteNode;
+
+        if (!loadRouteNode(previous,previousRouteNode)) {
+          log.Error() << "Cannot load route node with id " << previousId;
+          return false;
+        }
+
+        size_t pathIndex=FindPathIndex(*previousRouteNode,routeNode->GetId(),object);
+
+        if (pathIndex>=previousRouteNode->paths.size()) {
+          continue;
+        }
+
+        bool restricted=previousRouteNode->paths[pathIndex].IsRestricted(vehicle);
+
+        if ((restricted &&
+             !restrictedOnly) ||
+            !CanUse(state,id.database,*previousRouteNode,pathIndex)) {
+          nodesIgnoredCount++;
+          continue;
+        }
+
+        relax(false,
+              previous,
+              previousRouteNode,
+              label.currentCost+
+              GetCosts(state,id.database,*previousRouteNode,pathIndex,pathIndex)+
+              getJunctionPenalty(id,*routeNode,previous,object,label.prev,label.object),
+              restricted,
+              id,
+              restrictedOnly,
+              object);
+      }
+
+      for (const auto& twin : GetNodeTwins(state,id.database,routeNode->GetId())) {
+        RouteNodeRef twinRouteNode;
+
+        if (!loadRouteNode(twin,twinRouteNode)) {
+          return false;
+        }
+
+        relax(false,twin,twinRouteNode,label.currentCost,restrictedOnly,id,restrictedOnly,ObjectFileRef());
+      }
+
+      return true;
+    };
+
+    StopClock clock;
+
+    while (true) {
+      if (parameter.GetBreaker() &&
+          parameter.GetBreaker()->IsAborted()) {
+        return;
+      }
+
+      if (forwardOpenList.empty() ||
+          backwardOpenList.empty() ||
+          forwardOpenList.Top()->overallCost+backwardOpenList.Top()->overallCost>=bestCost*stretchFactor) {
+        break;
+      }
+
+      bool     forward=forwardOpenList.Top()->overallCost<=backwardOpenList.Top()->overallCost;
+      RNodeRef current=forward ? forwardOpenList.Pop() : backwardOpenList.Pop();
+
+      nodesLoadedCount++;
+
+      if (forward ? !expandForward(*current) : !expandBackward(*current)) {
+        log.Error() << "Failed to walk paths from " << current->id.database << "/" << current->id.id;
+        return;
+      }
+    }
+
+    clock.Stop();
+
+    if (debugPerformance) {
+      std::cout << "From:                " << startCoord.GetDisplayText() << " " << start.GetObjectFileRef().GetName() << std::endl;
+      std::cout << "To:                  " << targetCoord.GetDisplayText() << " " << target.GetObjectFileRef().GetName() << std::endl;
+      std::cout << "Time:                " << clock << std::endl;
+      std::cout << "Air-line distance:   " << std::fixed << std::setprecision(1) << overallDistance.As<Kilometer>() << " km" << std::endl;
+      std::cout << "Minimum cost:        " << GetCostString(state, start.GetDatabaseId(), overallCost) << std::endl;
+      if (bestNode.IsValid()) {
+        std::cout << "Actual cost:         " << GetCostString(state, start.GetDatabaseId(), bestCost) << std::endl;
+      }
+      std::cout << "Cost limit:          " << GetCostString(state, start.GetDatabaseId(), costLimit) << std::endl;
+      std::cout << "Route nodes loaded:  " << nodesLoadedCount << " (bidirectional)" << std::endl;
+      std::cout << "Route nodes ignored: " << nodesIgnoredCount << std::endl;
+      std::cout << "Forward labels:      " << forwardLabels[0].size()+forwardLabels[1].size() << std::endl;
+      std::cout << "Backward labels:     " << backwardLabels[0].size()+backwardLabels[1].size() << std::endl;
+    }
+
+    if (!bestNode.IsValid()) {
+      log.Warn() << "No route found!";
+
+      return;
+    }
+
+    // Collect the nodes of the route through the given route node and the
+    // costs from the start up to each node
+    auto collectNodes=[&](const DBId& via,
+                          const Meeting& meeting,
+                          std::list<VNode>& nodes,
+                          std::vector<double>& costs) {
+      DBId current=via;
+      bool currentState=meeting.forwardState;
+
+      nodes.clear();
+      costs.clear();
+
+      std::vector<double> forwardCosts;
+
+      while (true) {
+        const RNode& label=*forwardLabels[currentState][current];
+
+        nodes.emplace_front(current,
+                            label.object,
+                            label.prev);
+        forwardCosts.push_back(label.currentCost);
+
+        if (!label.prev.IsValid()) {
+          break;
+        }
+
+        current=label.prev;
+        currentState=bidirectionalLabels[label].prevAccess;
+      }
+
+      costs.assign(forwardCosts.rbegin(),forwardCosts.rend());
+
+      current=via;
+      currentState=meeting.backwardState;
+
+      while (true) {
+        const RNode& label=*backwardLabels[currentState][current];
+
+        if (!label.prev.IsValid()) {
+          break;
+        }
+
+        nodes.emplace_back(label.prev,
+                           label.object,
+                           current);
+
+        current=label.prev;
+        currentState=bidirectionalLabels[label].prevAccess;
+
+        costs.push_back(meeting.cost-backwardLabels[currentState][current]->currentCost);
+      }
+    };
+
+    auto addRoute=[&](const std::list<VNode>& nodes,
+                      double cost) {
+      RouteData route;
+
+      if (!ResolveRNodesToRouteData(state,
+                                    nodes,
+                                    start,
+                                    target,
+                                    route)) {
+        return false;
+      }
+
+      ResolveRouteDataJunctions(route);
+
+      routes.AddRoute(std::move(route),cost);
+
+      return true;
+    };
+
+    std::list<VNode>    nodes;
+    std::vector<double> costs;
+
+    collectNodes(bestNode,
+                 Meeting{bestCost,bestForwardState,bestBackwardState},
+                 nodes,
+                 costs);
+
+    if (parameter.GetBreaker() &&
+        parameter.GetBreaker()->IsAborted()) {
+      return;
+    }
+
+    if (!addRoute(nodes,bestCost) ||
+        !withAlternatives) {
+      return;
+    }
+
+    // Paths of the accepted routes
+    std::set<std::pair<DBId,DBId>> usedPaths;
+
+    auto getOverlap=[&usedPaths](const std::list<VNode>& nodes,
+                                 const std::vector<double>& costs) {
+      double overlap=0.0;
+      size_t index=0;
+
+      for (auto node=nodes.begin(); node!=nodes.end(); ++node, ++index) {
+        if (node->previousNode.IsValid() &&
+            usedPaths.find(std::make_pair(node->previousNode,node->currentNode))!=usedPaths.end()) {
+          overlap+=costs[index]-costs[index-1];
+        }
+      }
+
+      return overlap;
+    };
+
+    auto markUsed=[&usedPaths](const std::list<VNode>& nodes) {
+      for (const auto& node : nodes) {
+        if (node.previousNode.IsValid()) {
+          usedPaths.emplace(node.previousNode,node.currentNode);
+        }
+      }
+    };
+
+    markUsed(nodes);
+
+    // A path from the forward predecessor to the route node is part of the
+    // plateau, if the backward search reached the predecessor from this route node
+    auto getPlateauPredecessor=[&](const DBId& id,
+                                   const Meeting& meeting,
+                                   Meeting& predecessorMeeting) {
+      const RNode& forwardLabel=*forwardLabels[meeting.forwardState][id];
+
+      if (!forwardLabel.prev.IsValid()) {
+        return DBId();
+      }
+
+      for (bool backwardState : {true,false}) {
+        const RNodeRef* backwardEntry=backwardLabels[backwardState].Find(forwardLabel.prev);
+
+        if (backwardEntry!=nullptr &&
+            (*backwardEntry)->prev==id &&
+            bidirectionalLabels[**backwardEntry].prevAccess==meeting.backwardState) {
+          predecessorMeeting=Meeting{meeting.cost,bidirectionalLabels[forwardLabel].prevAccess,backwardState};
+
+          return forwardLabel.prev;
+        }
+      }
+
+      return DBId();
+    };
+
+    /**
+     * A plateau, identified by its first route node
+     */
+    struct Plateau
+    {
+      Meeting meeting;      //!< Meeting at the first route node
+      double  startCost;    //!< Costs from the start to the first route node
+      double  endCost;      //!< Costs from the start to the last route node
+    };
+
+    std::unordered_map<DBId,DBId>    plateauStarts;
+    std::unordered_map<DBId,Plateau> plateaus;
+    double                           maxCost=bestCost*stretchFactor;
+
+    for (const auto& [id,meeting] : meetings) {
+      if (meeting.cost>maxCost ||
+          plateauStarts.find(id)!=plateauStarts.end()) {
+        continue;
+      }
+
+      std::vector<DBId> chain;
+      DBId              current=id;
+      Meeting           currentMeeting=meeting;
+      DBId              plateauStart;
+
+      while (true) {
+        auto known=plateauStarts.find(current);
+
+        if (known!=plateauStarts.end()) {
+          plateauStart=known->second;
+          break;
+        }
+
+        chain.push_back(current);
+
+        Meeting predecessorMeeting{};
+        DBId    predecessor=getPlateauPredecessor(current,currentMeeting,predecessorMeeting);
+
+        if (!predecessor.IsValid() ||
+            std::find(chain.begin(),chain.end(),predecessor)!=chain.end()) {
+          plateauStart=current;
+          plateaus[current]=Plateau{currentMeeting,
+                                    forwardLabels[currentMeeting.forwardState][current]->currentCost,
+                                    forwardLabels[currentMeeting.forwardState][current]->currentCost};
+          break;
+        }
+
+        current=predecessor;
+        currentMeeting=predecessorMeeting;
+      }
+
+      Plateau& plateau=plateaus[plateauStart];
+
+      for (const auto& node : chain) {
+        plateauStarts[node]=plateauStart;
+
+        const RNodeRef* forwardEntry=forwardLabels[meetings[node].forwardState].Find(node);
+
+        if (forwardEntry!=nullptr) {
+          plateau.endCost=std::max(plateau.endCost,(*forwardEntry)->currentCost);
+        }
+      }
+    }
+
+    std::vector<std::pair<DBId,Plateau>> candidates(plateaus.begin(),plateaus.end());
+
+    std::sort(candidates.begin(),candidates.end(),[](const std::pair<DBId,Plateau>& a,
+                                                     const std::pair<DBId,Plateau>& b) {
+      double aLength=a.second.endCost-a.second.startCost;
+      double bLength=b.second.endCost-b.second.startCost;
+
+      if (aLength!=bLength) {
+        return aLength>bLength;
+      }
+
+      return a.second.meeting.cost<b.second.meeting.cost;
+    });
+
+    for (const auto& [plateauStart,plateau] : candidates) {
+      if (routes.GetRoutes().size()>alternativeParameter.maxAlternatives) {
+        break;
+      }
+
+      if (parameter.GetBreaker() &&
+          parameter.GetBreaker()->IsAborted()) {
+        return;
+      }
+
+      if (plateau.endCost-plateau.startCost<alternativeParameter.minPlateau*bestCost) {
+        // Candidates are ordered by plateau length
+        break;
+      }
+
+      if (plateau.meeting.cost>maxCost) {
+        continue;
+      }
+
+      collectNodes(plateauStart,
+                   plateau.meeting,
+                   nodes,
+                   costs);
+
+      std::set<DBId> visited;
+      bool           loop=false;
+
+      for (const auto& node : nodes) {
+        if (!visited.insert(node.currentNode).second) {
+          loop=true;
+          break;
+        }
+      }
+
+      if (loop ||
+          getOverlap(nodes,costs)>alternativeParameter.maxOverlap*bestCost) {
+        continue;
+      }
+
+      if (!addRoute(nodes,plateau.meeting.cost)) {
+        continue;
+      }
+
+      markUsed(nodes);
+    }
+  }
+
+  template <class RoutingState>
+  RoutingResult AbstractRoutingService<RoutingState>::CalculateRouteBidirectional(RoutingState& state,
+                                                                                  const RoutePosition& start,
+                                                                                  const RoutePosition& target,
+                                                                                  const RoutingParameter& parameter)
+  {
+    RoutingResult             result;
+    AlternativeRoutingResult  routes;
+    AlternativeRouteParameter alternativeParameter;
+
+    alternativeParameter.maxAlternatives=0;
+
+    CalculateRoutesBidirectional(state,
+                                 start,
+                                 target,
+                                 parameter,
+                                 alternativeParameter,
+                                 result,
+                                 routes);
+
+    if (routes.Success()) {
+      result.GetRoute()=std::move(routes.GetRoutes().front());
+    }
+
+    return result;
+  }
+
+  /**
+   * Calculate the best route and up to the given number of alternative routes.
+   * The alternatives are calculated from the search trees of one bidirectional
+   * search (see CalculateRoutesBidirectional()).
+   *
+   * @param state
+   *    State to use
+   * @param start
+   *    Start of the routes
+   * @param target
+   *    Target of the routes
+   * @param parameter
+   *    Optional breaker and progress
+   * @param alternativeParameter
+   *    Number and quality criteria of the alternatives
+   * @return
+   *    The best route followed by the alternatives, no route if there is no
+   *    route at all
+   */
+  template <class RoutingState>
+  AlternativeRoutingResult AbstractRoutingService<RoutingState>::CalculateAlternativeRoutes(RoutingState& state,
+                                                                                            const RoutePosition& start,
+                                                                                            const RoutePosition& target,
+                                                                                            const RoutingParameter& parameter,
+                                                                                            const AlternativeRouteParameter& alternativeParameter)
+  {
+    RoutingResult            result;
+    AlternativeRoutingResult routes;
+
+    CalculateRoutesBidirectional(state,
+                                 start,
+                                 target,
+                                 parameter,
+                                 alternativeParameter,
+                                 result,
+                                 routes);
+
+    return routes;
+  }
+
+  /**
+   * Collect the route nodes next to the targets of a routing matrix together
+   * with the rest of the way from the route node to the target. Targets without
+   * route node are skipped, their matrix entries stay invalid.
+   */
+  template <class RoutingState>
+  void AbstractRoutingService<RoutingState>::GetMatrixTargetNodes(const RoutingState& state,
+                                                                  const std::vector<RoutePosition>& targets,
+                                                                  std::vector<GeoCoord>& targetCoords,
+                                                                  MatrixTargetNodeMap& targetNodes)
+  {
+    targetCoords.resize(targets.size());
+
+    for (size_t t=0; t<targets.size(); t++) {
+      const RoutePosition& target=targets[t];
+      RouteNodeRef         forwardRouteNode;
+      RouteNodeRef         backwardRouteNode;
+      WayRef               way;
+
+      if (!GetTargetNodes(state,
+                          target,
+                          targetCoords[t],
+                          forwardRouteNode,
+                          backwardRouteNode) ||
+          !GetWayByOffset(DBFileOffset(target.GetDatabaseId(),
+                                       target.GetObjectFileRef().GetFileOffset()),
+                          way)) {
+        log.Warn() << "Cannot resolve target " << t << " of routing matrix";
+        continue;
+      }
+
+      for (const auto& routeNode : {forwardRouteNode,backwardRouteNode}) {
+        if (!routeNode) {
+          continue;
+        }
+
+        Distance distance=GetSphericalDistance(routeNode->GetCoord(),
+                                               targetCoords[t]);
+
+        targetNodes[DBId(target.GetDatabaseId(),routeNode->GetId())].push_back(MatrixTargetNode{t,
+                                                                                                GetCosts(state,target.GetDatabaseId(),way,distance),
+                                                                                                distance,
+                                                                                                GetTime(state,target.GetDatabaseId(),way,distance)});
+      }
+    }
+  }
+
+  /**
+   * Resolve the start of a one-to-many search. The returned start nodes hold
+   * the costs and their labels the distance and time of the way from the start
+   * position to the route node, there is no estimate.
+   *
+   * @return
+   *    false, if the start position cannot be resolved
+   */
+  template <class RoutingState>
+  bool AbstractRoutingService<RoutingState>::GetOneToManyStartNodes(const RoutingState& state,
+                                                                    const RoutePosition& source,
+                                                                    RNodePool& pool,
+                                                                    OneToManyLabels& labels,
+                                                                    GeoCoord& startCoord,
+                                                                    std::vector<RNodeRef>& startNodes)
+  {
+    RouteNodeRef startForwardRouteNode;
+    RouteNodeRef startBackwardRouteNode;
+    RNodeRef     startForwardNode=nullptr;
+    RNodeRef     startBackwardNode=nullptr;
+    WayRef       startWay;
+
+    startNodes.clear();
+
+    if (!GetStartNodes(state,
+                       source,
+                       startCoord,
+                       GeoCoord(),
+                       startForwardRouteNode,
+                       startBackwardRouteNode,
+                       pool,
+                       startForwardNode,
+                       startBackwardNode) ||
+        !GetWayByOffset(DBFileOffset(source.GetDatabaseId(),
+                                     source.GetObjectFileRef().GetFileOffset()),
+                        startWay)) {
+      return false;
+    }
+
+    for (const auto& node : {startForwardNode,startBackwardNode}) {
+      if (node) {
+        node->estimateCost=0.0;
+        node->overallCost=node->currentCost;
+
+        OneToManyLabel& label=labels[*node];
+
+        label.distance=GetSphericalDistance(startCoord,node->node->GetCoord());
+        label.time=GetTime(state,source.GetDatabaseId(),startWay,label.distance);
+
+        startNodes.push_back(node);
+      }
+    }
+
+    return true;
+  }
+
+  /**
+   * One-to-many Dijkstra search from the given start nodes. The search follows
+   * the same rules as CalculateRoute() (access restrictions, turn restrictions,
+   * database twins), but without estimate. Paths with costs above costLimit
+   * are not followed.
+   *
+   * The callback is called once for each route node in the order of increasing
+   * costs, while the route node is still loaded. The search stops, if the
+   * callback returns false. Route nodes are only loaded for the nodes of the
+   * search frontier and released after they have been settled.
+   *
+   * If pathCosts is set, it is used instead of GetCosts() and GetTime() for
+   * the costs and time of the paths.
+   *
+   * @return
+   *    false in case of technical errors or if the search was aborted
+   */
+  template <class RoutingState>
+  bool AbstractRoutingService<RoutingState>::SearchOneToMany(const RoutingState& state,
+                                                             RNodePool& pool,
+                                                             OneToManyLabels& labels,
+                                                             const std::vector<RNodeRef>& startNodes,
+                                                             double costLimit,
+                                                             const RoutingParameter& parameter,
+                                                             const SettledNodeCallback& settled,
+                                                             const PathCostCallback& pathCosts)
+  {
+    Vehicle   vehicle=GetVehicle(state);
+    OpenList  openList;
+    OpenMap   openMap;
+    ClosedSet closedSet;
+    ClosedSet closedRestrictedSet;
+
+    for (const auto& node : startNodes) {
+      openList.Push(node);
+      openMap[node->id]=node;
+    }
+
+    auto setLabel=[&labels](RNodeRef node,
+                            double cost,
+                            const OneToManyLabel& label,
+                            bool access) {
+      node->currentCost=cost;
+      node->estimateCost=0.0;
+      node->overallCost=cost;
+      node->access=access;
+      labels[*node]=label;
+    };
+
+    while (!openList.empty()) {
+      if (parameter.GetBreaker() &&
+          parameter.GetBreaker()->IsAborted()) {
+        return false;
+      }
+
+      RNodeRef     current=openList.Pop();
+      RouteNodeRef routeNode=current->node;
+      DatabaseId   dbId=current->id.database;
+      ClosedSet&   currentClosedSet=current->access ? closedSet : closedRestrictedSet;
+
+      if (!closedSet.Contains(current->id) &&
+          !closedRestrictedSet.Contains(current->id) &&
+          !settled(*current)) {
+        return true;
+      }
+
+      currentClosedSet[current->id]=VNode(current->id,
+                                          current->object,
+                                          current->prev);
+
+      size_t inPathIndex=routeNode->paths.size();
+
+      if (current->prev.IsValid() &&
+          current->prev.database==dbId) {
+        inPathIndex=FindPathIndex(*routeNode,current->prev.id,current->object);
+      }
+
+      // in case of roundabout, node don't contains path back
+      bool inPathValid=inPathIndex<routeNode->paths.size();
+
+      for (size_t i=0; i<routeNode->paths.size(); i++) {
+        const RouteNode::Path& path=routeNode->paths[i];
+        const ObjectFileRef&   object=routeNode->objects[path.objectIndex].object;
+        DBId                   next(dbId,path.id);
+
+        if (path.id==current->prev.id ||
+            (!current->access &&
+             !path.IsRestricted(vehicle)) ||
+            !CanUse(state,dbId,*routeNode,i) ||
+            currentClosedSet.Contains(next) ||
+            IsTurnExcluded(*routeNode,current->object,object)) {
+          continue;
+        }
+
+        Duration pathTime=Duration::zero();
+        double   cost=current->currentCost+(pathCosts ? pathCosts(*current,
+                                                                  *routeNode,
+                                                                  inPathValid ? inPathIndex : i,
+                                                                  i,
+                                                                  pathTime) :
+                                                        GetCosts(state,
+                                                                 dbId,
+                                                                 *routeNode,
+                                                                 inPathValid ? inPathIndex : i,
+                                                                 i));
+
+        if (cost>costLimit) {
+          continue;
+        }
+
+        RNodeRef* openMapEntry=openMap.Find(next);
+        RNodeRef  openEntry=openMapEntry!=nullptr &&
+                            (*openMapEntry)->heapIndex!=OpenListNPos ? *openMapEntry : nullptr;
+
+        if (openEntry!=nullptr &&
+            openEntry->currentCost<=cost) {
+          continue;
+        }
+
+        const OneToManyLabel& currentLabel=labels[*current];
+        OneToManyLabel        label{currentLabel.distance+path.distance,
+                                    currentLabel.time+(pathCosts ? pathTime : GetTime(state,dbId,*routeNode,i))};
+
+        if (openEntry!=nullptr) {
+          openEntry->prev=current->id;
+          openEntry->object=object;
+          setLabel(openEntry,cost,label,!path.IsRestricted(vehicle));
+          openList.Update(openEntry);
+        }
+        else {
+          RouteNodeRef nextRouteNode;
+
+          if (!GetRouteNode(next,nextRouteNode)) {
+            log.Error() << "Cannot load route node with id " << path.id;
+            return false;
+          }
+
+          RNodeRef node=pool.Allocate(next,
+                                      nextRouteNode,
+                                      object,
+                                      current->id);
+
+          setLabel(node,cost,label,!path.IsRestricted(vehicle));
+          openList.Push(node);
+          openMap[next]=node;
+        }
+      }
+
+      for (const auto& twin : GetNodeTwins(state,dbId,routeNode->GetId())) {
+        if (currentClosedSet.Contains(twin)) {
+          continue;
+        }
+
+        RNodeRef* twinEntry=openMap.Find(twin);
+
+        if (twinEntry!=nullptr &&
+            (*twinEntry)->heapIndex!=OpenListNPos) {
+          if ((*twinEntry)->currentCost>current->currentCost) {
+            (*twinEntry)->prev=current->id;
+            setLabel(*twinEntry,current->currentCost,OneToManyLabel(labels[*current]),current->access);
+            openList.Update(*twinEntry);
+          }
+        }
+        else {
+          RouteNodeRef twinRouteNode;
+
+          if (!GetRouteNode(twin,twinRouteNode)) {
+            return false;
+          }
+
+          RNodeRef node=pool.Allocate(twin,
+                                      twinRouteNode,
+                                      ObjectFileRef(),
+                                      current->id);
+
+          setLabel(node,current->currentCost,OneToManyLabel(labels[*current]),current->access);
+          openList.Push(node);
+          openMap[twin]=node;
+        }
+      }
+
+      current->node=nullptr;
+    }
+
+    return true;
+  }
+
+  /**
+   * Calculate one row of a routing matrix using a one-to-many search from the
+   * source, that stops as soon as all route nodes next to the targets are settled.
+   *
+   * @return
+   *    false in case of technical errors or if the calculation was aborted
+   */
+  template <class RoutingState>
+  bool AbstractRoutingService<RoutingState>::CalculateMatrixRow(const RoutingState& state,
+                                                                const RoutePosition& source,
+                                                                const std::vector<GeoCoord>& targetCoords,
+                                                                const MatrixTargetNodeMap& targetNodes,
+                                                                const RoutingParameter& parameter,
+                                                                RoutingMatrixResult& result,
+                                                                size_t row)
+  {
+    GeoCoord              startCoord;
+    RNodePool             pool;
+    OneToManyLabels       labels;
+    std::vector<RNodeRef> startNodes;
+
+    if (targetNodes.empty()) {
+      return true;
+    }
+
+    if (!GetOneToManyStartNodes(state,
+                                source,
+                                pool,
+                                labels,
+                                startCoord,
+                                startNodes)) {
+      log.Warn() << "Cannot resolve source " << row << " of routing matrix";
+      return true;
+    }
+
+    Distance maxDistance;
+
+    for (const auto& targetCoord : targetCoords) {
+      maxDistance=Distance::Max(maxDistance,
+                                GetSphericalDistance(startCoord,targetCoord));
+    }
+
+    size_t remainingTargetNodes=targetNodes.size();
+
+    return SearchOneToMany(state,
+                           pool,
+                           labels,
+                           startNodes,
+                           GetCostLimit(state,source.GetDatabaseId(),maxDistance),
+                           parameter,
+                           [&targetNodes,&result,&labels,&remainingTargetNodes,row](const RNode& node) {
+                             auto targetNode=targetNodes.find(node.id);
+
+                             if (targetNode==targetNodes.end()) {
+                               return true;
+                             }
+
+                             remainingTargetNodes--;
+
+                             for (const auto& target : targetNode->second) {
+                               RoutingMatrixEntry& entry=result.GetEntry(row,target.target);
+                               double              cost=node.currentCost+target.cost;
+
+                               if (!entry.valid ||
+                                   cost<entry.cost) {
+                                 entry.valid=true;
+                                 entry.cost=cost;
+                                 entry.distance=labels[node].distance+target.distance;
+                                 entry.duration=labels[node].time+target.duration;
+                               }
+                             }
+
+                             return remainingTargetNodes>0;
+                           });
+  }
+
+  /**
+   * Calculate costs, distance and duration of the routes from each source to
+   * each target.
+   *
+   * Each row is calculated by a one-to-many Dijkstra search from the source,
+   * the rows are calculated in parallel (see RoutingParameter::SetThreadCount()).
+   *
+   * @param state
+   *    State to use
+   * @param sources
+   *    Start positions of the routes
+   * @param targets
+   *    Target positions of the routes
+   * @param parameter
+   *    Optional breaker and thread count
+   * @return
+   *    The matrix, with an invalid entry for each pair without route
+   */
+  template <class RoutingState>
+  RoutingMatrixResult AbstractRoutingService<RoutingState>::CalculateMatrix(RoutingState& state,
+                                                                            const std::vector<RoutePosition>& sources,
+                                                                            const std::vector<RoutePosition>& targets,
+                                                                            const RoutingParameter& parameter)
+  {
+    RoutingMatrixResult   result(sources.size(),targets.size());
+    std::vector<GeoCoord> targetCoords;
+    MatrixTargetNodeMap   targetNodes;
+    StopClock             clock;
+
+    if (sources.empty() ||
+        targets.empty()) {
+      return result;
+    }
+
+    GetMatrixTargetNodes(state,
+                         targets,
+                         targetCoords,
+                         targetNodes);
+
+    size_t threadCount=parameter.GetThreadCount();
+
+    if (threadCount==0) {
+      threadCount=std::max(1u,std::thread::hardware_concurrency());
+    }
+
+    threadCount=std::min(threadCount,sources.size());
+
+    std::vector<std::function<bool()>> rows;
+
+    rows.reserve(sources.size());
+
+    for (size_t row=0; row<sources.size(); row++) {
+      rows.emplace_back([this,&state,&sources,&targetCoords,&targetNodes,&parameter,&result,row]() {
+        return CalculateMatrixRow(state,
+                                  sources[row],
+                                  targetCoords,
+                                  targetNodes,
+                                  parameter,
+                                  result,
+                                  row);
+      });
+    }
+
+    if (!RunConcurrently(rows,
+                         threadCount)) {
+      result.SetSuccess(false);
+    }
+
+    clock.Stop();
+
+    if (debugPerformance) {
+      std::cout << "Matrix:              " << sources.size() << "x" << targets.size() << std::endl;
+      std::cout << "Time:                " << clock << std::endl;
+      std::cout << "Threads:             " << threadCount << std::endl;
+    }
+
+    return result;
+  }
+
+  /**
+   * Calculate the area reachable from the start within the given cost limits.
+   *
+   * The calculation is a one-to-many search from the start, that ends at the
+   * highest cost limit. Route nodes are only held in memory while they are
+   * part of the search frontier, the reached nodes are returned with coordinate,
+   * costs, distance and duration only.
+   *
+   * @param state
+   *    State to use
+   * @param start
+   *    Start position
+   * @param costLimits
+   *    Cost limit of each band of the result, in the units of the costs of the
+   *    profile (for example hours for FastestPathRoutingProfile)
+   * @param cellSize
+   *    Size of the grid cells used for the outlines of the bands
+   * @param parameter
+   *    Optional breaker
+   * @return
+   *    The reached nodes and the outline of the reachable area of each band
+   */
+  template <class RoutingState>
+  IsochroneResult AbstractRoutingService<RoutingState>::CalculateIsochrone(RoutingState& state,
+                                                                           const RoutePosition& start,
+                                                                           const std::vector<double>& costLimits,
+                                                                           const Distance& cellSize,
+                                                                           const RoutingParameter& parameter)
+  {
+    IsochroneResult       result;
+    GeoCoord              startCoord;
+    RNodePool             pool;
+    OneToManyLabels       labels;
+    std::vector<RNodeRef> startNodes;
+    StopClock             clock;
+
+    if (costLimits.empty()) {
+      result.SetSuccess(true);
+      return result;
+    }
+
+    if (!GetOneToManyStartNodes(state,
+                                start,
+                                pool,
+                                labels,
+                                startCoord,
+                                startNodes)) {
+      log.Error() << "Cannot resolve start of isochrone";
+      return result;
+    }
+
+    double                      costLimit=*std::max_element(costLimits.begin(),costLimits.end());
+    std::vector<IsochroneNode>& nodes=result.GetNodes();
+    DBIdHashMap<size_t>         nodeIndex;
+
+    if (!SearchOneToMany(state,
+                         pool,
+                         labels,
+                         startNodes,
+                         costLimit,
+                         parameter,
+                         [&nodes,&nodeIndex,&labels](const RNode& node) {
+                           IsochroneNode isochroneNode;
+                           const size_t* previous=node.prev.IsValid() ? nodeIndex.Find(node.prev) : nullptr;
+
+                           isochroneNode.id=node.id;
+                           isochroneNode.coord=node.node->GetCoord();
+                           isochroneNode.cost=node.currentCost;
+                           isochroneNode.distance=labels[node].distance;
+                           isochroneNode.duration=labels[node].time;
+                           isochroneNode.previous=previous!=nullptr ? *previous : IsochroneNode::NoPrevious;
+
+                           nodeIndex[node.id]=nodes.size();
+                           nodes.push_back(isochroneNode);
+
+                           return true;
+                         })) {
+      return result;
+    }
+
+    for (const auto& limit : costLimits) {
+      IsochroneBand band;
+
+      band.costLimit=limit;
+
+      CalculateIsochroneRings(startCoord,
+                              cellSize,
+                              nodes,
+                              limit,
+                              band.rings);
+
+      result.GetBands().push_back(std::move(band));
+    }
+
+    result.SetSuccess(true);
+
+    clock.Stop();
+
+    if (debugPerformance) {
+      std::cout << "Isochrone:           " << nodes.size() << " nodes, " << costLimits.size() << " bands" << std::endl;
+      std::cout << "Time:                " << clock << std::endl;
+    }
+
+    return result;
+  }
+
+  /**
+   * Calculate the length of the shortest routes from each source to each
+   * target of a step of map matching, using a one-to-many search from each
+   * source that stops as soon as all route nodes next to the targets are
+   * settled. Routes longer than maxDistance are not followed. Pairs without
+   * route have a distance of Distance::Max().
+   *
+   * Source and target on the same way are also connected directly along
+   * the way, if the way can be used in the required direction.
+   *
+   * @return
+   *    false in case of technical errors or if the calculation was aborted
+   */
+  template <class RoutingState>
+  bool AbstractRoutingService<RoutingState>::GetMapMatchTransitions(const RoutingState& state,
+                                                                    const std::vector<MapMatchCandidate>& sources,
+                                                                    const std::vector<MapMatchCandidate>& targets,
+                                                                    const Distance& maxDistance,
+                                                                    const RoutingParameter& parameter,
+                                                                    std::vector<std::vector<Distance>>& distances)
+  {
+    std::vector<RoutePosition> targetPositions;
+    std::vector<GeoCoord>      targetCoords;
+    MatrixTargetNodeMap        targetNodes;
+
+    distances.assign(sources.size(),
+                     std::vector<Distance>(targets.size(),Distance::Max()));
+
+    targetPositions.reserve(targets.size());
+
+    for (const auto& target : targets) {
+      targetPositions.push_back(target.position);
+    }
+
+    GetMatrixTargetNodes(state,
+                         targetPositions,
+                         targetCoords,
+                         targetNodes);
+
+    for (size_t s=0; s<sources.size(); s++) {
+      const RoutePosition&   source=sources[s].position;
+      std::vector<Distance>& row=distances[s];
+
+      for (size_t t=0; t<targets.size(); t++) {
+        const RoutePosition& target=targets[t].position;
+        WayRef               way;
+
+        if (source.GetDatabaseId()!=target.GetDatabaseId() ||
+            source.GetObjectFileRef()!=target.GetObjectFileRef() ||
+            !GetWayByOffset(DBFileOffset(source.GetDatabaseId(),
+                                         source.GetObjectFileRef().GetFileOffset()),
+                            way)) {
+          continue;
+        }
+
+        size_t from=source.GetNodeIndex();
+        size_t to=target.GetNodeIndex();
+
+        if (std::max(from,to)>=way->nodes.size() ||
+            (to>from && !CanUseForward(state,source.GetDatabaseId(),way)) ||
+            (to<from && !CanUseBackward(state,source.GetDatabaseId(),way))) {
+          continue;
+        }
+
+        Distance distance;
+
+        for (size_t i=std::min(from,to); i<std::max(from,to); i++) {
+          distance+=GetSphericalDistance(way->nodes[i].GetCoord(),
+                                         way->nodes[i+1].GetCoord());
+        }
+
+        row[t]=distance;
+      }
+
+      GeoCoord              startCoord;
+      RNodePool             pool;
+      OneToManyLabels       labels;
+      std::vector<RNodeRef> startNodes;
+
+      if (targetNodes.empty() ||
+          !GetOneToManyStartNodes(state,
+                                  source,
+                                  pool,
+                                  labels,
+                                  startCoord,
+                                  startNodes)) {
+        continue;
+      }
+
+      // The search is ordered by distance (in meter) instead of the costs of the profile
+      for (const auto& node : startNodes) {
+        node->currentCost=labels[*node].distance.AsMeter();
+        node->overallCost=node->currentCost;
+      }
+
+      size_t remainingTargetNodes=targetNodes.size();
+
+      if (!SearchOneToMany(state,
+                           pool,
+                           labels,
+                           startNodes,
+                           maxDistance.AsMeter(),
+                           parameter,
+                           [&targetNodes,&row,&labels,&remainingTargetNodes](const RNode& node) {
+                             auto targetNode=targetNodes.find(node.id);
+
+                             if (targetNode==targetNodes.end()) {
+                               return true;
+                             }
+
+                             remainingTargetNodes--;
+
+                             for (const auto& target : targetNode->second) {
+                               row[target.target]=Distance::Min(row[target.target],
+                                                                labels[node].distance+target.distance);
+                             }
+
+                             return remainingTargetNodes>0;
+                           },
+                           [this,&state](const RNode& current,
+                                         const RouteNode& routeNode,
+                                         size_t /*inPathIndex*/,
+                                         size_t outPathIndex,
+                                         Duration& time) {
+                             time=GetTime(state,current.id.database,routeNode,outPathIndex);
+
+                             return routeNode.paths[outPathIndex].distance.AsMeter();
+                           })) {
+        return false;
+      }
+    }
+
+    return true;
+  }
+
+  /**
+   * Calculate the routes between the matched points of a map matching result.
+   * The route index of the matched points holds the index of their chain of
+   * the hidden Markov model on entry and is replaced by the index of the route.
+   *
+   * A new route is started for each chain and if CalculateRoute() fails for two
+   * consecutive positions of a chain.
+   *
+   * @return
+   *    false if the calculation was aborted
+   */
+  template <class RoutingState>
+  bool AbstractRoutingService<RoutingState>::GetMapMatchRoutes(RoutingState& state,
+                                                               const RoutingParameter& parameter,
+                                                               MapMatchResult& result)
+  {
+    std::vector<RouteData>& routes=result.GetRoutes();
+    const MatchedPoint*     previous=nullptr;
+    size_t                  previousChain=0;
+
+    for (auto& point : result.GetPoints()) {
+      if (!point.matched) {
+        continue;
+      }
+
+      size_t chain=point.route;
+
+      if (previous!=nullptr &&
+          chain==previousChain) {
+        if (point.position.GetDatabaseId()==previous->position.GetDatabaseId() &&
+            point.position.GetObjectFileRef()==previous->position.GetObjectFileRef() &&
+            point.position.GetNodeIndex()==previous->position.GetNodeIndex()) {
+          point.route=previous->route;
+          previous=&point;
+          continue;
+        }
+
+        RoutingResult partialResult=CalculateRoute(state,
+                                                   previous->position,
+                                                   point.position,
+                                                   parameter);
+
+        if (partialResult.Success()) {
+          RouteData& route=routes.back();
+
+          // The end of the previous part is the start of the next part
+          if (!route.IsEmpty()) {
+            route.PopEntry();
+          }
+
+          route.Append(std::move(partialResult.GetRoute()));
+
+          point.route=previous->route;
+          previous=&point;
+          continue;
+        }
+
+        if (parameter.GetBreaker() &&
+            parameter.GetBreaker()->IsAborted()) {
+          return false;
+        }
+
+        log.Warn() << "Cannot connect matched positions, splitting route";
+      }
+
+      routes.emplace_back();
+      point.route=routes.size()-1;
+      previous=&point;
+      previousChain=chain;
+    }
+
+    return true;
+  }
+
+  /**
+   * Match the given points of a trace to the routing graph using a hidden
+   * Markov model and the Viterbi algorithm.
+   *
+   * The emission probability of a candidate depends on its distance to the
+   * measured point, the transition probability on the difference between the
+   * length of the shortest route between two candidates (see
+   * GetMapMatchTransitions()) and the distance of the measured points. All
+   * probabilities are handled as logarithms.
+   *
+   * Points without candidates are skipped. If no candidate of a point can be
+   * reached from a candidate of the previous point, the model is restarted
+   * at the point and a new route is started.
+   *
+   * @param state
+   *    State to use
+   * @param points
+   *    The measured points of the trace
+   * @param candidates
+   *    The candidates of each point
+   * @param matchParameter
+   *    Parameters of the model
+   * @param parameter
+   *    Optional breaker
+   * @return
+   *    The matched position of each point and the routes between them
+   */
+  template <class RoutingState>
+  MapMatchResult AbstractRoutingService<RoutingState>::MatchTrack(RoutingState& state,
+                                                                  const std::vector<GeoCoord>& points,
+                                                                  const std::vector<std::vector<MapMatchCandidate>>& candidates,
+                                                                  const MapMatchParameter& matchParameter,
+                                                                  const RoutingParameter& parameter)
+  {
+    MapMatchResult                   result;
+    std::vector<MatchedPoint>&       matchedPoints=result.GetPoints();
+    std::vector<size_t>              chainPoints;       //!< Points of the current chain
+    std::vector<std::vector<size_t>> chainPredecessors; //!< Best predecessor of each candidate of each point of the chain
+    std::vector<double>              probabilities;     //!< Probability of each candidate of the last point of the chain
+    size_t                           chainCount=0;
+    StopClock                        clock;
+
+    assert(points.size()==candidates.size());
+
+    matchedPoints.resize(points.size());
+
+    auto getEmission=[&matchParameter](const MapMatchCandidate& candidate) {
+      double x=candidate.distance.AsMeter()/matchParameter.gpsSigma.AsMeter();
+
+      return -0.5*x*x;
+    };
+
+    auto finishChain=[&]() {
+      if (chainPoints.empty()) {
+        return;
+      }
+
+      size_t candidate=std::max_element(probabilities.begin(),probabilities.end())-probabilities.begin();
+
+      for (size_t i=chainPoints.size(); i>0; i--) {
+        size_t                   point=chainPoints[i-1];
+        const MapMatchCandidate& matched=candidates[point][candidate];
+
+        matchedPoints[point].matched=true;
+        matchedPoints[point].position=matched.position;
+        matchedPoints[point].distance=matched.distance;
+        matchedPoints[point].route=chainCount;
+
+        candidate=chainPredecessors[i-1][candidate];
+      }
+
+      chainPoints.clear();
+      chainPredecessors.clear();
+      chainCount++;
+    };
+
+    for (size_t p=0; p<points.size(); p++) {
+      if (parameter.GetBreaker() &&
+          parameter.GetBreaker()->IsAborted()) {
+        return result;
+      }
+
+      const std::vector<MapMatchCandidate>& current=candidates[p];
+
+      if (current.empty()) {
+        continue;
+      }
+
+      std::vector<double> currentProbabilities(current.size(),-std::numeric_limits<double>::infinity());
+      std::vector<size_t> predecessors(current.size(),0);
+
+      if (!chainPoints.empty()) {
+        size_t                             previousPoint=chainPoints.back();
+        Distance                           pointDistance=GetSphericalDistance(points[previousPoint],
+                                                                              points[p]);
+        std::vector<std::vector<Distance>> distances;
+        bool                               connected=false;
+
+        if (!GetMapMatchTransitions(state,
+                                    candidates[previousPoint],
+                                    current,
+                                    pointDistance*matchParameter.maxDetourFactor+matchParameter.searchRadius*2.0,
+                                    parameter,
+                                    distances)) {
+          return result;
+        }
+
+        for (size_t c=0; c<current.size(); c++) {
+          for (size_t k=0; k<probabilities.size(); k++) {
+            if (probabilities[k]==-std::numeric_limits<double>::infinity() ||
+                distances[k][c]==Distance::Max()) {
+              continue;
+            }
+
+            double probability=probabilities[k]-
+                               std::abs(distances[k][c].AsMeter()-pointDistance.AsMeter())/matchParameter.transitionBeta.AsMeter();
+
+            if (probability>currentProbabilities[c]) {
+              currentProbabilities[c]=probability;
+              predecessors[c]=k;
+              connected=true;
+            }
+          }
+
+          currentProbabilities[c]+=getEmission(current[c]);
+        }
+
+        if (!connected) {
+          finishChain();
+        }
+      }
+
+      if (chainPoints.empty()) {
+        for (size_t c=0; c<current.size(); c++) {
+          currentProbabilities[c]=getEmission(current[c]);
+        }
+      }
+
+      chainPoints.push_back(p);
+      chainPredecessors.push_back(std::move(predecessors));
+      probabilities=std::move(currentProbabilities);
+    }
+
+    finishChain();
+
+    result.SetSuccess(GetMapMatchRoutes(state,
+                                        parameter,
+                                        result));
+
+    clock.Stop();
+
+    if (debugPerformance) {
+      std::cout << "Map matching:        " << points.size() << " points, " << result.GetRoutes().size() << " routes" << std::endl;
+      std::cout << "Time:                " << clock << std::endl;
+    }
+
+    return result;
+  }
+
+  /**
+   * Return the time for passing the given object, if the routing profile
+   * needs the given time and the object is entered at entryTime
+   */
+  template <class RoutingState>
+  Duration AbstractRoutingService<RoutingState>::GetTimeDependentTime(DatabaseId database,
+                                                                      const ObjectFileRef& object,
+                                                                      const Duration& time,
+                                                                      const Timestamp& entryTime)
+  {
+    const SpeedProfiles* speedProfiles=GetSpeedProfiles(database);
+
+    if (speedProfiles==nullptr ||
+        object.GetType()!=refWay) {
+      return time;
+    }
+
+    return std::chrono::duration_cast<Duration>(time/speedProfiles->GetWaySpeedFactor(object.GetFileOffset(),
+                                                                                      entryTime));
+  }
+
+  /**
+   * Calculate the route with the earliest arrival for the departure time of
+   * the parameter.
+   *
+   * The route is calculated by a time-dependent Dijkstra search and is only
+   * used for profiles with time costs (see RoutingProfile::HasTimeCosts()).
+   * The time for a path is the time of the routing profile divided by the
+   * speed factor of the way (see SpeedProfiles) at the time the path is
+   * entered. The search minimizes this time plus the junction penalties of
+   * the profile, which are not scaled. The earliest arrival is only found,
+   * if leaving later never means arriving earlier on a single way (FIFO
+   * property), which holds for speed profiles without steep changes.
+   *
+   * @param state
+   *    State to use
+   * @param start
+   *    Start of the route
+   * @param target
+   *    Target of the route
+   * @param parameter
+   *    Departure time and optional breaker
+   * @return
+   *    The route, with the arrival time set
+   */
+  template <class RoutingState>
+  RoutingResult AbstractRoutingService<RoutingState>::CalculateRouteTimeDependent(RoutingState& state,
+                                                                                  const RoutePosition& start,
+                                                                                  const RoutePosition& target,
+                                                                                  const RoutingParameter& parameter)
+  {
+    RoutingResult         result;
+    Timestamp             departure=*parameter.GetDepartureTime();
+    GeoCoord              startCoord;
+    std::vector<GeoCoord> targetCoords;
+    MatrixTargetNodeMap   targetNodes;
+    RNodePool             pool;
+    OneToManyLabels       labels;
+    std::vector<RNodeRef> startNodes;
+    StopClock             clock;
+
+    GetMatrixTargetNodes(state,
+                         {target},
+                         targetCoords,
+                         targetNodes);
+
+    if (targetNodes.empty()) {
+      return result;
+    }
+
+    if (!GetOneToManyStartNodes(state,
+                                start,
+                                pool,
+                                labels,
+                                startCoord,
+                                startNodes)) {
+      log.Error() << "Cannot resolve start of route";
+      return result;
+    }
+
+    for (const auto& node : startNodes) {
+      OneToManyLabel& label=labels[*node];
+
+      label.time=GetTimeDependentTime(start.GetDatabaseId(),
+                                      start.GetObjectFileRef(),
+                                      label.time,
+                                      departure);
+      node->currentCost=DurationAsHours(label.time);
+      node->overallCost=node->currentCost;
+    }
+
+    result.SetOverallDistance(GetSphericalDistance(startCoord,
+                                                   targetCoords.front()));
+
+    ClosedSet settledNodes;
+    size_t    remainingTargetNodes=targetNodes.size();
+    DBId      finalNode;
+    double    finalCost=std::numeric_limits<double>::max();
+    Duration  arrival=Duration::max();
+
+    if (!SearchOneToMany(state,
+                         pool,
+                         labels,
+                         startNodes,
+                         std::numeric_limits<double>::max(),
+                         parameter,
+                         [this,&target,&targetNodes,&labels,&settledNodes,&remainingTargetNodes,&finalNode,&finalCost,&arrival,departure](const RNode& node) {
+                           if (node.currentCost>=finalCost) {
+                             return false;
+                           }
+
+                           settledNodes[node.id]=VNode(node.id,
+                                                       node.object,
+                                                       node.prev);
+
+                           auto targetNode=targetNodes.find(node.id);
+
+                           if (targetNode==targetNodes.end()) {
+                             return true;
+                           }
+
+                           remainingTargetNodes--;
+
+                           for (const auto& entry : targetNode->second) {
+                             Duration time=GetTimeDependentTime(target.GetDatabaseId(),
+                                                                target.GetObjectFileRef(),
+                                                                entry.duration,
+                                                                departure+labels[node].time);
+                             double   cost=node.currentCost+DurationAsHours(time);
+
+                             if (cost<finalCost) {
+                               finalCost=cost;
+                               arrival=labels[node].time+time;
+                               finalNode=node.id;
+                             }
+                           }
+
+                           return remainingTargetNodes>0;
+                         },
+                         [this,&state,&labels,departure](const RNode& current,
+                                                 const RouteNode& routeNode,
+                                                 size_t inPathIndex,
+                                                 size_t outPathIndex,
+                                                 Duration& time) {
+                           Duration travelTime=GetTime(state,current.id.database,routeNode,outPathIndex);
+                           // Costs are the travel time plus the junction penalty, see HasTimeCosts()
+                           double   penalty=GetCosts(state,current.id.database,routeNode,inPathIndex,outPathIndex)-
+                                            DurationAsHours(travelTime);
+
+                           time=GetTimeDependentTime(current.id.database,
+                                                     routeNode.objects[routeNode.paths[outPathIndex].objectIndex].object,
+                                                     travelTime,
+                                                     departure+labels[current].time);
+
+                           return DurationAsHours(time)+std::max(penalty,0.0);
+                         })) {
+      return result;
+    }
+
+    clock.Stop();
+
+    if (debugPerformance) {
+      std::cout << "Time-dependent:      " << settledNodes.size() << " nodes settled" << std::endl;
+      std::cout << "Time:                " << clock << std::endl;
+    }
+
+    if (!finalNode.IsValid()) {
+      log.Warn() << "No route found!";
+      return result;
+    }
+
+    std::list<VNode> nodes;
+    ClosedSet        closedRestrictedSet;
+
+    ResolveRNodeChainToList(finalNode,
+                            settledNodes,
+                            closedRestrictedSet,
+                            nodes);
+
+    if (!ResolveRNodesToRouteData(state,
+                                  nodes,
+                                  start,
+                                  target,
+                                  result.GetRoute())) {
+      return result;
+    }
+
+    ResolveRouteDataJunctions(result.GetRoute());
+
+    result.SetArrivalTime(departure+arrival);
+
+    return result;
+  }
+
+  template <class RoutingState>
+  void AbstractRoutingService<RoutingState>::AddNodes(RouteData& route,
+                                                      DatabaseId database,
+                                                      Id startNodeId,
+                                                      size_t startNodeIndex,
+                                                      const ObjectFileRef& object,
+                                                      size_t idCount,
+                                                      bool oneway,
+                                                      size_t targetNodeIndex)
+  {
+    assert(startNodeIndex<idCount);
+    assert(targetNodeIndex<idCount);
+
+    if (std::max(startNodeIndex,targetNodeIndex)-std::min(startNodeIndex,targetNodeIndex)==1) {
+      // From one node to the neighbour node (+1 or -1)
+      route.AddEntry(database,
+                     startNodeId,
+                     startNodeIndex,
+                     object,
+                     targetNodeIndex);
+    }
+    else if (startNodeIndex<targetNodeIndex) {
+      // Following the way
+      route.AddEntry(database,
+                     startNodeId,
+                     startNodeIndex,
+                     object,
+                     startNodeIndex+1);
+
+      for (size_t i=startNodeIndex+1; i<targetNodeIndex-1; i++) {
+        route.AddEntry(database,
+                       0,
+                       i,
+                       object,
+                       i+1);
+      }
+
+      route.AddEntry(database,
+                     0,
+                     targetNodeIndex-1,
+                     object,
+                     targetNodeIndex);
+    }
+    else if (oneway) {
+      // startNodeIndex>tragetNodeIndex, but this is a oneway we assume
+      // that the way is either an area or is a roundabound
+      // TODO: proof this using the right assertions or checks
+      size_t pos=startNodeIndex+1;
+      size_t next;
+
+      if (pos>=idCount) {
+        pos=0;
+      }
+
+      next=pos+1;
+      if (next>=idCount) {
+        next=0;
+      }
+
+      route.AddEntry(database,
+                     startNodeId,
+                     startNodeIndex,
+                     object,
+                     pos);
+
+      while (next!=targetNodeIndex) {
+        route.AddEntry(database,
+                       0,
+                       pos,
+                       object,
+                       next);
+
+        pos++;
+        if (pos>=idCount) {
+          pos=0;
+        }
+
+        next=pos+1;
+        if (next>=idCount) {
+          next=0;
+        }
+      }
+
+      route.AddEntry(database,
+                     0,
+                     pos,
+                     object,
+                     targetNodeIndex);
+    }
+    else {
+      // We follow the way in the opposite direction
+      route.AddEntry(database,
+                     startNodeId,
+                     startNodeIndex,
+                     object,
+                     startNodeIndex-1);
+
+      for (long i=(long)startNodeIndex-1; i>(long)targetNodeIndex+1; i--) {
+        route.AddEntry(database,
+                       0,
+                       (size_t)i,
+                       object,
+                       (size_t)i-1);
+      }
+
+      route.AddEntry(database,
+                     0,
+                     targetNodeIndex+1,
+                     object,
+                     targetNodeIndex);
+    }
+  }
+
+  /**
+   * Return true, if the route does not take a turn, that is excluded by a turn
+   * restriction at one of its route nodes. This is required for routes, that were
+   * not calculated by walking the paths of the route nodes, like routes of
+   * speedup structures, which do not know about turn restrictions.
+   *
+   * @param nodes
+   *    The route nodes of the route, together with the objects used to reach them
+   * @return
+   *    True, if all turns are allowed, false if a turn is excluded or the route nodes
+   *    cannot be loaded
+   */
+  template <class RoutingState>
+  bool AbstractRoutingService<RoutingState>::IsRouteAllowed(const std::list<VNode>& nodes)
+  {
+    std::set<DBId>                        routeNodeIds;
+    std::unordered_map<DBId,RouteNodeRef> routeNodeMap;
+
+    for (const auto& node : nodes) {
+      routeNodeIds.insert(node.currentNode);
+    }
+
+    if (!GetRouteNodes(routeNodeIds,
+                       routeNodeMap)) {
+      log.Error() << "Cannot load route nodes";
+      return false;
+    }
+
+    for (auto node=nodes.begin(), next=std::next(node);
+         next!=nodes.end();
+         node=next, ++next) {
+      auto routeNode=routeNodeMap.find(node->currentNode);
+
+      if (routeNode==routeNodeMap.end() ||
+          !routeNode->second) {
+        return false;
+      }
+
+      if (IsTurnExcluded(*routeNode->second,
+                         node->object,
+                         next->object)) {
+        return false;
+      }
+    }
+
+    return true;
   }
 
   template <class RoutingState>
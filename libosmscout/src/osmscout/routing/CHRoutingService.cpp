@@ -0,0 +1,281 @@
+/*
+  This source is part of the libosmscout library
+  Copyright (C) 2026  Tim Teulings
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307  USA
+*/
+
+#include <osmscout/routing/CHRoutingService.h>
+
+#include <iostream>
+
+#include <osmscout/util/File.h>
+#include <osmscout/util/Geometry.h>
+#include <osmscout/util/Logger.h>
+#include <osmscout/util/StopClock.h>
+
+namespace osmscout {
+
+  CHRoutingService::CHRoutingService(const DatabaseRef& database,
+                                     const RouterParameter& parameter,
+                                     const std::string& filenamebase)
+  : SimpleRoutingService(database,
+                         parameter,
+                         filenamebase),
+    database(database),
+    filenamebase(filenamebase)
+  {
+    // no code
+  }
+
+  CHRoutingService::~CHRoutingService()
+  {
+    // no code
+  }
+
+  /**
+   * Open the routing service and load the contraction hierarchies of
+   * all vehicles, which are available.
+   */
+  bool CHRoutingService::Open()
+  {
+    if (!SimpleRoutingService::Open()) {
+      return false;
+    }
+
+    for (Vehicle vehicle : {vehicleFoot, vehicleBicycle, vehicleCar}) {
+      std::string filename=AppendFileToDir(database->GetPath(),
+                                           GetContractionHierarchyFilename(filenamebase,
+                                                                           vehicle));
+
+      if (!ExistsInFilesystem(filename)) {
+        continue;
+      }
+
+      ContractionHierarchyRef hierarchy=std::make_shared<ContractionHierarchy>();
+
+      if (!hierarchy->Load(filename)) {
+        SimpleRoutingService::Close();
+        return false;
+      }
+
+      hierarchies[vehicle]=hierarchy;
+    }
+
+    return true;
+  }
+
+  void CHRoutingService::Close()
+  {
+    hierarchies.clear();
+
+    SimpleRoutingService::Close();
+  }
+
+  /**
+   * Use the given hierarchy for routing of its vehicle instead of the
+   * one loaded from disk.
+   */
+  void CHRoutingService::SetContractionHierarchy(const ContractionHierarchyRef& hierarchy)
+  {
+    hierarchies[hierarchy->GetVehicle()]=hierarchy;
+  }
+
+  ContractionHierarchyRef CHRoutingService::GetContractionHierarchy(Vehicle vehicle) const
+  {
+    auto entry=hierarchies.find(vehicle);
+
+    if (entry==hierarchies.end()) {
+      return nullptr;
+    }
+
+    return entry->second;
+  }
+
+  /**
+   * Calculate a route using the contraction hierarchy of the vehicle of the profile.
+   *
+   * The hierarchy is only used, if the cost parameters of the given profile match
+   * the parameters of the profile the hierarchy was built with. Since the hierarchy
+   * does not know about turn restrictions, the resulting route is checked against
+   * them. In both cases the A* search of SimpleRoutingService is used instead.
+   *
+   * @param profile
+   *    Profile to use
+   * @param start
+   *    Start of the route
+   * @param target
+   *    Target of the route
+   * @param parameter
+   *    Optional breaker and progress
+   * @return
+   *    The result, holding the route on success
+   */
+  RoutingResult CHRoutingService::CalculateRoute(RoutingProfile& profile,
+                                                 const RoutePosition& start,
+                                                 const RoutePosition& target,
+                                                 const RoutingParameter& parameter)
+  {
+    ContractionHierarchyRef hierarchy=GetContractionHierarchy(profile.GetVehicle());
+
+    if (!hierarchy) {
+      return SimpleRoutingService::CalculateRoute(profile,
+                                                  start,
+                                                  target,
+                                                  parameter);
+    }
+
+    if (hierarchy->GetCostParameters().empty() ||
+        hierarchy->GetCostParameters()!=profile.GetCostParameters()) {
+      log.Debug() << "Profile does not match the contraction hierarchy, using A*";
+
+      return SimpleRoutingService::CalculateRoute(profile,
+                                                  start,
+                                                  target,
+                                                  parameter);
+    }
+
+    RoutingResult result;
+    GeoCoord      startCoord;
+    GeoCoord      targetCoord;
+    RouteNodeRef  startForwardRouteNode;
+    RouteNodeRef  startBackwardRouteNode;
+    RNodePool     pool;
+    RNodeRef      startForwardNode=nullptr;
+    RNodeRef      startBackwardNode=nullptr;
+    RouteNodeRef  targetForwardRouteNode;
+    RouteNodeRef  targetBackwardRouteNode;
+    StopClock     clock;
+
+    if (!GetTargetNodes(profile,
+                        target,
+                        targetCoord,
+                        targetForwardRouteNode,
+                        targetBackwardRouteNode)) {
+      return result;
+    }
+
+    if (!GetStartNodes(profile,
+                       start,
+                       startCoord,
+                       targetCoord,
+                       startForwardRouteNode,
+                       startBackwardRouteNode,
+                       pool,
+                       startForwardNode,
+                       startBackwardNode)) {
+      return result;
+    }
+
+    WayRef targetWay;
+
+    if (!GetWayByOffset(DBFileOffset(target.GetDatabaseId(),
+                                     target.GetObjectFileRef().GetFileOffset()),
+                        targetWay)) {
+      log.Error() << "Cannot get end way!";
+      return result;
+    }
+
+    // Since the cost parameters of the profile match, the costs of the
+    // partial ways at start and target are in the metric of the hierarchy
+    std::vector<ContractionHierarchy::Endpoint> sources;
+    std::vector<ContractionHierarchy::Endpoint> targets;
+
+    for (const auto& node : {startForwardNode, startBackwardNode}) {
+      if (node) {
+        sources.push_back(ContractionHierarchy::Endpoint{node->id.id,node->currentCost});
+      }
+    }
+
+    for (const auto& routeNode : {targetForwardRouteNode, targetBackwardRouteNode}) {
+      if (routeNode) {
+        targets.push_back(ContractionHierarchy::Endpoint{routeNode->GetId(),
+                                                         GetCosts(profile,
+                                                                  target.GetDatabaseId(),
+                                                                  targetWay,
+                                                                  GetSphericalDistance(routeNode->GetCoord(),
+                                                                                       targetCoord))});
+      }
+    }
+
+    ContractionHierarchy::Route chRoute;
+
+    if (!hierarchy->CalculateRoute(sources,
+                                   targets,
+                                   chRoute)) {
+      log.Warn() << "No route found in contraction hierarchy, using A*";
+
+      return SimpleRoutingService::CalculateRoute(profile,
+                                                  start,
+                                                  target,
+                                                  parameter);
+    }
+
+    clock.Stop();
+
+    if (debugPerformance) {
+      std::cout << "Time:                " << clock << std::endl;
+      std::cout << "Actual cost:         " << profile.GetCostString(chRoute.cost) << std::endl;
+      std::cout << "Route nodes settled: " << chRoute.settled << std::endl;
+      std::cout << "Route paths:         " << chRoute.steps.size() << std::endl;
+    }
+
+    if (parameter.GetBreaker() &&
+        parameter.GetBreaker()->IsAborted()) {
+      return result;
+    }
+
+    std::list<VNode> nodes;
+    DBId             previous(start.GetDatabaseId(),chRoute.source);
+
+    nodes.emplace_back(previous,
+                       start.GetObjectFileRef(),
+                       DBId());
+
+    for (const auto& step : chRoute.steps) {
+      DBId current(start.GetDatabaseId(),step.id);
+
+      nodes.emplace_back(current,
+                         step.object,
+                         previous);
+
+      previous=current;
+    }
+
+    if (!IsRouteAllowed(nodes)) {
+      log.Debug() << "Contraction hierarchy route violates turn restrictions, using A*";
+
+      return SimpleRoutingService::CalculateRoute(profile,
+                                                  start,
+                                                  target,
+                                                  parameter);
+    }
+
+    result.SetOverallDistance(GetSphericalDistance(startCoord,
+                                                   targetCoord));
+
+    if (!ResolveRNodesToRouteData(profile,
+                                  nodes,
+                                  start,
+                                  target,
+                                  result.GetRoute())) {
+      return result;
+    }
+
+    ResolveRouteDataJunctions(result.GetRoute());
+
+    return result;
+  }
+}
@@ -0,0 +1,293 @@
+/*
+  This source is part of the libosmscout library
+  Copyright (C) 2026  Tim Teulings
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307  USA
+*/
+
+#include <osmscout/routing/CRPRoutingService.h>
+
+#include <iostream>
+
+#include <osmscout/util/File.h>
+#include <osmscout/util/Geometry.h>
+#include <osmscout/util/Logger.h>
+#include <osmscout/util/StopClock.h>
+
+namespace osmscout {
+
+  CRPRoutingService::CRPRoutingService(const DatabaseRef& database,
+                                       const RouterParameter& parameter,
+                                       const std::string& filenamebase)
+  : SimpleRoutingService(database,
+                         parameter,
+                         filenamebase),
+    database(database),
+    filenamebase(filenamebase)
+  {
+    // no code
+  }
+
+  CRPRoutingService::~CRPRoutingService()
+  {
+    // no code
+  }
+
+  /**
+   * Open the routing service and load the route partition, if available.
+   */
+  bool CRPRoutingService::Open()
+  {
+    if (!SimpleRoutingService::Open()) {
+      return false;
+    }
+
+    std::string filename=AppendFileToDir(database->GetPath(),
+                                         GetPartitionFilename(filenamebase));
+
+    if (!ExistsInFilesystem(filename)) {
+      return true;
+    }
+
+    RoutePartitionRef loadedPartition=std::make_shared<RoutePartition>();
+
+    if (!loadedPartition->Load(*database->GetTypeConfig(),
+                               filename)) {
+      SimpleRoutingService::Close();
+      return false;
+    }
+
+    partition=loadedPartition;
+
+    return true;
+  }
+
+  void CRPRoutingService::Close()
+  {
+    metrics.clear();
+    partition=nullptr;
+
+    SimpleRoutingService::Close();
+  }
+
+  /**
+   * Use the given partition instead of the one loaded from disk. Existing
+   * customizations are dropped.
+   */
+  void CRPRoutingService::SetRoutePartition(const RoutePartitionRef& partition)
+  {
+    this->partition=partition;
+    metrics.clear();
+  }
+
+  /**
+   * Calculate the costs of the partition for the given profile. Following
+   * routes for the vehicle of the profile use these costs.
+   *
+   * @param profile
+   *    Profile to calculate the costs for
+   * @param threadCount
+   *    Number of threads to use
+   * @return
+   *    false, if there is no partition
+   */
+  bool CRPRoutingService::Customize(const RoutingProfile& profile,
+                                    size_t threadCount)
+  {
+    if (!partition) {
+      return false;
+    }
+
+    metrics[profile.GetVehicle()]=partition->Customize(profile,
+                                                       threadCount);
+
+    return true;
+  }
+
+  /**
+   * Calculate a route using the customized partition of the vehicle of the profile.
+   *
+   * The partition is only used, if it was customized with a profile with the same
+   * cost parameters. Since the partition does not know about turn restrictions,
+   * the resulting route is checked against them. In both cases the A* search of
+   * SimpleRoutingService is used instead.
+   *
+   * @param profile
+   *    Profile to use
+   * @param start
+   *    Start of the route
+   * @param target
+   *    Target of the route
+   * @param parameter
+   *    Optional breaker and progress
+   * @return
+   *    The result, holding the route on success
+   */
+  RoutingResult CRPRoutingService::CalculateRoute(RoutingProfile& profile,
+                                                  const RoutePosition& start,
+                                                  const RoutePosition& target,
+                                                  const RoutingParameter& parameter)
+  {
+    auto metric=metrics.find(profile.GetVehicle());
+
+    if (!partition ||
+        metric==metrics.end()) {
+      return SimpleRoutingService::CalculateRoute(profile,
+                                                  start,
+                                                  target,
+                                                  parameter);
+    }
+
+    if (metric->second->costParameters.empty() ||
+        metric->second->costParameters!=profile.GetCostParameters()) {
+      log.Debug() << "Profile does not match the customization of the route partition, using A*";
+
+      return SimpleRoutingService::CalculateRoute(profile,
+                                                  start,
+                                                  target,
+                                                  parameter);
+    }
+
+    RoutingResult result;
+    GeoCoord      startCoord;
+    GeoCoord      targetCoord;
+    RouteNodeRef  startForwardRouteNode;
+    RouteNodeRef  startBackwardRouteNode;
+    RNodePool     pool;
+    RNodeRef      startForwardNode=nullptr;
+    RNodeRef      startBackwardNode=nullptr;
+    RouteNodeRef  targetForwardRouteNode;
+    RouteNodeRef  targetBackwardRouteNode;
+    StopClock     clock;
+
+    if (!GetTargetNodes(profile,
+                        target,
+                        targetCoord,
+                        targetForwardRouteNode,
+                        targetBackwardRouteNode)) {
+      return result;
+    }
+
+    if (!GetStartNodes(profile,
+                       start,
+                       startCoord,
+                       targetCoord,
+                       startForwardRouteNode,
+                       startBackwardRouteNode,
+                       pool,
+                       startForwardNode,
+                       startBackwardNode)) {
+      return result;
+    }
+
+    WayRef targetWay;
+
+    if (!GetWayByOffset(DBFileOffset(target.GetDatabaseId(),
+                                     target.GetObjectFileRef().GetFileOffset()),
+                        targetWay)) {
+      log.Error() << "Cannot get end way!";
+      return result;
+    }
+
+    std::vector<RoutePartition::Endpoint> sources;
+    std::vector<RoutePartition::Endpoint> targets;
+
+    for (const auto& node : {startForwardNode, startBackwardNode}) {
+      if (node) {
+        sources.push_back(RoutePartition::Endpoint{node->id.id,node->currentCost});
+      }
+    }
+
+    for (const auto& routeNode : {targetForwardRouteNode, targetBackwardRouteNode}) {
+      if (routeNode) {
+        targets.push_back(RoutePartition::Endpoint{routeNode->GetId(),
+                                                   GetCosts(profile,
+                                                            target.GetDatabaseId(),
+                                                            targetWay,
+                                                            GetSphericalDistance(routeNode->GetCoord(),
+                                                                                 targetCoord))});
+      }
+    }
+
+    RoutePartition::Route crpRoute;
+
+    if (!partition->CalculateRoute(*metric->second,
+                                   sources,
+                                   targets,
+                                   crpRoute)) {
+      log.Warn() << "No route found in route partition, using A*";
+
+      return SimpleRoutingService::CalculateRoute(profile,
+                                                  start,
+                                                  target,
+                                                  parameter);
+    }
+
+    clock.Stop();
+
+    if (debugPerformance) {
+      std::cout << "Time:                " << clock << std::endl;
+      std::cout << "Actual cost:         " << profile.GetCostString(crpRoute.cost) << std::endl;
+      std::cout << "Route nodes settled: " << crpRoute.settled << std::endl;
+      std::cout << "Route paths:         " << crpRoute.steps.size() << std::endl;
+    }
+
+    if (parameter.GetBreaker() &&
+        parameter.GetBreaker()->IsAborted()) {
+      return result;
+    }
+
+    std::list<VNode> nodes;
+    DBId             previous(start.GetDatabaseId(),crpRoute.source);
+
+    nodes.emplace_back(previous,
+                       start.GetObjectFileRef(),
+                       DBId());
+
+    for (const auto& step : crpRoute.steps) {
+      DBId current(start.GetDatabaseId(),step.id);
+
+      nodes.emplace_back(current,
+                         step.object,
+                         previous);
+
+      previous=current;
+    }
+
+    if (!IsRouteAllowed(nodes)) {
+      log.Debug() << "Route partition route violates turn restrictions, using A*";
+
+      return SimpleRoutingService::CalculateRoute(profile,
+                                                  start,
+                                                  target,
+                                                  parameter);
+    }
+
+    result.SetOverallDistance(GetSphericalDistance(startCoord,
+                                                   targetCoord));
+
+    if (!ResolveRNodesToRouteData(profile,
+                                  nodes,
+                                  start,
+                                  target,
+                                  result.GetRoute())) {
+      return result;
+    }
+
+    ResolveRouteDataJunctions(result.GetRoute());
+
+    return result;
+  }
+}
@@ -0,0 +1,787 @@
+/*
+  This source is part of the libosmscout library
+  Copyright (C) 2026  Tim Teulings
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307  USA
+*/
+
+#include <osmscout/routing/ContractionHierarchy.h>
+
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <queue>
+#include <unordered_map>
+
+#include <osmscout/ObjectVariantDataFile.h>
+
+#include <osmscout/routing/RoutingService.h>
+
+#include <osmscout/util/File.h>
+#include <osmscout/util/FileScanner.h>
+#include <osmscout/util/FileWriter.h>
+#include <osmscout/util/Logger.h>
+#include <osmscout/util/StopClock.h>
+
+namespace osmscout {
+
+  namespace {
+    //! Costs are stored as fixed point numbers
+    constexpr double costScale=1.0e9;
+
+    using QueueEntry = std::pair<double,uint32_t>;
+    using Queue      = std::priority_queue<QueueEntry,std::vector<QueueEntry>,std::greater<>>;
+
+    struct Label
+    {
+      double   cost;   //!< Costs to reach the node
+      uint32_t parent; //!< Previous node or ContractionHierarchy::noNode for endpoints
+      size_t   edge;   //!< Index of the edge used to reach the node
+    };
+
+    using Labels = std::unordered_map<uint32_t,Label>;
+  }
+
+  ContractionHierarchy::ContractionHierarchy()
+  : vehicle(vehicleCar)
+  {
+    // no code
+  }
+
+  /**
+   * Take over the given graph. Node ids must be sorted and edgeOffsets
+   * must contain nodeIds.size()+1 entries.
+   */
+  void ContractionHierarchy::Assign(Vehicle vehicle,
+                                    const std::string& costParameters,
+                                    std::vector<Id>&& nodeIds,
+                                    std::vector<uint32_t>&& edgeOffsets,
+                                    std::vector<Edge>&& edges)
+  {
+    assert(edgeOffsets.size()==nodeIds.size()+1);
+
+    this->vehicle=vehicle;
+    this->costParameters=costParameters;
+    this->nodeIds=std::move(nodeIds);
+    this->edgeOffsets=std::move(edgeOffsets);
+    this->edges=std::move(edges);
+  }
+
+  bool ContractionHierarchy::Load(const std::string& filename)
+  {
+    FileScanner scanner;
+    StopClock   stopClock;
+
+    try {
+      uint8_t  vehicleValue;
+      uint32_t nodeCount;
+      uint32_t edgeCount;
+      Id       previousId=0;
+
+      scanner.Open(filename,
+                   FileScanner::Sequential,
+                   true);
+
+      scanner.Read(vehicleValue);
+      scanner.Read(costParameters);
+      scanner.Read(nodeCount);
+      scanner.Read(edgeCount);
+
+      vehicle=static_cast<Vehicle>(vehicleValue);
+      nodeIds.resize(nodeCount);
+      edgeOffsets.resize(nodeCount+1);
+      edges.resize(edgeCount);
+
+      uint32_t edgeOffset=0;
+
+      for (uint32_t n=0; n<nodeCount; n++) {
+        Id       idDelta;
+        uint32_t nodeEdgeCount;
+
+        scanner.ReadNumber(idDelta);
+        scanner.ReadNumber(nodeEdgeCount);
+
+        nodeIds[n]=previousId+idDelta;
+        previousId=nodeIds[n];
+        edgeOffsets[n]=edgeOffset;
+        edgeOffset+=nodeEdgeCount;
+      }
+
+      edgeOffsets[nodeCount]=edgeOffset;
+
+      if (edgeOffset!=edgeCount) {
+        log.Error() << "Edge count in '" << filename << "' does not match";
+        scanner.Close();
+        return false;
+      }
+
+      for (auto& edge : edges) {
+        uint32_t middle;
+        uint64_t cost;
+
+        scanner.ReadNumber(edge.target);
+        scanner.ReadNumber(middle);
+        scanner.ReadNumber(cost);
+        scanner.Read(edge.flags);
+
+        edge.middle=middle==0 ? noNode : middle-1;
+        edge.cost=double(cost)/costScale;
+
+        if (edge.middle==noNode) {
+          scanner.Read(edge.object);
+        }
+      }
+
+      scanner.Close();
+    }
+    catch (IOException& e) {
+      log.Error() << e.GetDescription();
+      scanner.CloseFailsafe();
+      return false;
+    }
+
+    stopClock.Stop();
+
+    log.Debug() << "Loading contraction hierarchy '" << filename << "' with " << nodeIds.size() << " nodes and "
+                << edges.size() << " edges: " << stopClock.ResultString();
+
+    return true;
+  }
+
+  bool ContractionHierarchy::Store(const std::string& filename) const
+  {
+    FileWriter writer;
+
+    try {
+      Id previousId=0;
+
+      writer.Open(filename);
+
+      writer.Write(static_cast<uint8_t>(vehicle));
+      writer.Write(costParameters);
+      writer.Write(static_cast<uint32_t>(nodeIds.size()));
+      writer.Write(static_cast<uint32_t>(edges.size()));
+
+      for (size_t n=0; n<nodeIds.size(); n++) {
+        writer.WriteNumber(nodeIds[n]-previousId);
+        writer.WriteNumber(edgeOffsets[n+1]-edgeOffsets[n]);
+
+        previousId=nodeIds[n];
+      }
+
+      for (const auto& edge : edges) {
+        writer.WriteNumber(edge.target);
+        writer.WriteNumber(edge.middle==noNode ? 0 : edge.middle+1);
+        writer.WriteNumber(static_cast<uint64_t>(std::llround(edge.cost*costScale)));
+        writer.Write(edge.flags);
+
+        if (edge.middle==noNode) {
+          writer.Write(edge.object);
+        }
+      }
+
+      writer.Close();
+    }
+    catch (IOException& e) {
+      log.Error() << e.GetDescription();
+      writer.CloseFailsafe();
+      return false;
+    }
+
+    return true;
+  }
+
+  /**
+   * Return the index of the route node with the given id or noNode,
+   * if the route node is not part of the hierarchy.
+   */
+  uint32_t ContractionHierarchy::GetNodeIndex(Id id) const
+  {
+    auto entry=std::lower_bound(nodeIds.begin(),
+                                nodeIds.end(),
+                                id);
+
+    if (entry==nodeIds.end() ||
+        *entry!=id) {
+      return noNode;
+    }
+
+    return static_cast<uint32_t>(entry-nodeIds.begin());
+  }
+
+  const ContractionHierarchy::Edge* ContractionHierarchy::FindEdge(uint32_t node,
+                                                                   uint32_t target,
+                                                                   uint8_t direction) const
+  {
+    for (uint32_t e=edgeOffsets[node]; e<edgeOffsets[node+1]; e++) {
+      if (edges[e].target==target &&
+          (edges[e].flags & direction)!=0) {
+        return &edges[e];
+      }
+    }
+
+    return nullptr;
+  }
+
+  /**
+   * Append the paths of the given edge (stored at the node with the index 'owner')
+   * to the list of steps, resolving shortcuts recursively.
+   */
+  bool ContractionHierarchy::Unpack(uint32_t owner,
+                                    const Edge& edge,
+                                    std::vector<Step>& steps) const
+  {
+    bool     forward=(edge.flags & forwardEdge)!=0;
+    uint32_t from=forward ? owner : edge.target;
+    uint32_t to=forward ? edge.target : owner;
+
+    if (edge.middle==noNode) {
+      steps.push_back(Step{nodeIds[to],edge.object});
+
+      return true;
+    }
+
+    // The contracted node has a lower rank than both ends, so both
+    // halves of the shortcut are stored at the contracted node
+    const Edge* first=FindEdge(edge.middle,from,backwardEdge);
+    const Edge* second=FindEdge(edge.middle,to,forwardEdge);
+
+    if (first==nullptr ||
+        second==nullptr) {
+      log.Error() << "Cannot unpack shortcut " << nodeIds[from] << " -> " << nodeIds[to];
+      return false;
+    }
+
+    return Unpack(edge.middle,*first,steps) &&
+           Unpack(edge.middle,*second,steps);
+  }
+
+  /**
+   * Calculate the cheapest route from one of the sources to one of the targets.
+   *
+   * Both searches only follow edges to nodes of higher rank and stop, if their
+   * cheapest open node is more expensive than the best route found so far.
+   *
+   * @param sources
+   *    Route nodes the route may start at, together with the costs to reach them
+   * @param targets
+   *    Route nodes the route may end at, together with the costs from them to the target
+   * @param route
+   *    The resulting route
+   * @return
+   *    True, if a route was found
+   */
+  bool ContractionHierarchy::CalculateRoute(const std::vector<Endpoint>& sources,
+                                            const std::vector<Endpoint>& targets,
+                                            Route& route) const
+  {
+    Labels   forwardLabels;
+    Labels   backwardLabels;
+    Queue    forwardQueue;
+    Queue    backwardQueue;
+    double   bestCost=std::numeric_limits<double>::infinity();
+    uint32_t meetingNode=noNode;
+
+    route=Route();
+
+    auto initialize=[this](const std::vector<Endpoint>& endpoints,
+                           Labels& labels,
+                           Queue& queue) {
+      for (const auto& endpoint : endpoints) {
+        uint32_t node=GetNodeIndex(endpoint.id);
+
+        if (node==noNode) {
+          continue;
+        }
+
+        auto entry=labels.find(node);
+
+        if (entry==labels.end() ||
+            endpoint.cost<entry->second.cost) {
+          labels[node]=Label{endpoint.cost,noNode,0};
+          queue.emplace(endpoint.cost,node);
+        }
+      }
+    };
+
+    auto settle=[this,&bestCost,&meetingNode,&route](Queue& queue,
+                                                     Labels& labels,
+                                                     const Labels& otherLabels,
+                                                     uint8_t direction) {
+      QueueEntry current=queue.top();
+
+      queue.pop();
+
+      if (current.first>labels[current.second].cost) {
+        // Outdated queue entry
+        return;
+      }
+
+      route.settled++;
+
+      auto other=otherLabels.find(current.second);
+
+      if (other!=otherLabels.end() &&
+          current.first+other->second.cost<bestCost) {
+        bestCost=current.first+other->second.cost;
+        meetingNode=current.second;
+      }
+
+      for (uint32_t e=edgeOffsets[current.second]; e<edgeOffsets[current.second+1]; e++) {
+        const Edge& edge=edges[e];
+
+        if ((edge.flags & direction)==0) {
+          continue;
+        }
+
+        double cost=current.first+edge.cost;
+        auto   entry=labels.find(edge.target);
+
+        if (entry==labels.end() ||
+            cost<entry->second.cost) {
+          labels[edge.target]=Label{cost,current.second,e};
+          queue.emplace(cost,edge.target);
+        }
+      }
+    };
+
+    initialize(sources,forwardLabels,forwardQueue);
+    initialize(targets,backwardLabels,backwardQueue);
+
+    while (true) {
+      bool forwardOpen=!forwardQueue.empty() && forwardQueue.top().first<bestCost;
+      bool backwardOpen=!backwardQueue.empty() && backwardQueue.top().first<bestCost;
+
+      if (!forwardOpen && !backwardOpen) {
+        break;
+      }
+
+      if (forwardOpen &&
+          (!backwardOpen || forwardQueue.top().first<=backwardQueue.top().first)) {
+        settle(forwardQueue,forwardLabels,backwardLabels,forwardEdge);
+      }
+      else {
+        settle(backwardQueue,backwardLabels,forwardLabels,backwardEdge);
+      }
+    }
+
+    if (meetingNode==noNode) {
+      return false;
+    }
+
+    // Edges from the source up to the meeting node
+    std::vector<std::pair<uint32_t,size_t>> forwardEdges;
+    uint32_t                                node=meetingNode;
+
+    for (auto label=forwardLabels.find(node);
+         label->second.parent!=noNode;
+         label=forwardLabels.find(node)) {
+      forwardEdges.emplace_back(label->second.parent,label->second.edge);
+      node=label->second.parent;
+    }
+
+    route.source=nodeIds[node];
+
+    for (auto edge=forwardEdges.rbegin(); edge!=forwardEdges.rend(); ++edge) {
+      if (!Unpack(edge->first,edges[edge->second],route.steps)) {
+        return false;
+      }
+    }
+
+    // Edges from the meeting node down to the target
+    node=meetingNode;
+
+    for (auto label=backwardLabels.find(node);
+         label->second.parent!=noNode;
+         label=backwardLabels.find(node)) {
+      if (!Unpack(label->second.parent,edges[label->second.edge],route.steps)) {
+        return false;
+      }
+
+      node=label->second.parent;
+    }
+
+    route.target=nodeIds[node];
+    route.cost=bestCost;
+
+    return true;
+  }
+
+  ContractionHierarchyBuilder::ContractionHierarchyBuilder(const RoutingProfile& profile)
+  : profile(profile),
+    witnessSearchLimit(1000)
+  {
+    // no code
+  }
+
+  /**
+   * Set the maximum number of nodes visited while searching for a path, that
+   * makes a shortcut unnecessary. Smaller values result in faster building but
+   * more shortcuts.
+   */
+  void ContractionHierarchyBuilder::SetWitnessSearchLimit(size_t limit)
+  {
+    witnessSearchLimit=limit;
+  }
+
+  /**
+   * Add the given edge, if there is no cheaper edge to the same node already
+   */
+  void ContractionHierarchyBuilder::AddEdge(std::vector<BuildEdge>& edges,
+                                            const BuildEdge& edge)
+  {
+    for (auto& existing : edges) {
+      if (existing.node==edge.node) {
+        if (edge.cost<existing.cost) {
+          existing=edge;
+        }
+
+        return;
+      }
+    }
+
+    edges.push_back(edge);
+  }
+
+  void ContractionHierarchyBuilder::RemoveEdge(std::vector<BuildEdge>& edges,
+                                               uint32_t node)
+  {
+    edges.erase(std::remove_if(edges.begin(),
+                               edges.end(),
+                               [node](const BuildEdge& edge) {
+                                 return edge.node==node;
+                               }),
+                edges.end());
+  }
+
+  /**
+   * Return the shortcuts required, if the given node gets contracted. A
+   * shortcut is not required, if a local search finds a path that does not
+   * use the node and is not more expensive.
+   */
+  void ContractionHierarchyBuilder::FindShortcuts(const std::vector<BuildNode>& nodes,
+                                                  uint32_t node,
+                                                  std::vector<Shortcut>& shortcuts) const
+  {
+    const BuildNode& current=nodes[node];
+
+    shortcuts.clear();
+
+    for (const auto& in : current.in) {
+      double maxCost=0.0;
+
+      for (const auto& out : current.out) {
+        if (out.node!=in.node) {
+          maxCost=std::max(maxCost,in.cost+out.cost);
+        }
+      }
+
+      if (maxCost==0.0) {
+        continue;
+      }
+
+      // Witness search
+      std::unordered_map<uint32_t,double> costs;
+      Queue                               queue;
+      size_t                              settled=0;
+
+      costs[in.node]=0.0;
+      queue.emplace(0.0,in.node);
+
+      while (!queue.empty() &&
+             settled<witnessSearchLimit) {
+        QueueEntry entry=queue.top();
+
+        queue.pop();
+
+        if (entry.first>costs[entry.second]) {
+          continue;
+        }
+
+        if (entry.first>maxCost) {
+          break;
+        }
+
+        settled++;
+
+        for (const auto& edge : nodes[entry.second].out) {
+          if (edge.node==node) {
+            continue;
+          }
+
+          double cost=entry.first+edge.cost;
+          auto   target=costs.find(edge.node);
+
+          if (target==costs.end() ||
+              cost<target->second) {
+            costs[edge.node]=cost;
+            queue.emplace(cost,edge.node);
+          }
+        }
+      }
+
+      for (const auto& out : current.out) {
+        if (out.node==in.node) {
+          continue;
+        }
+
+        double cost=in.cost+out.cost;
+        auto   witness=costs.find(out.node);
+
+        if (witness==costs.end() ||
+            witness->second>cost) {
+          shortcuts.push_back(Shortcut{in.node,out.node,cost});
+        }
+      }
+    }
+  }
+
+  /**
+   * Nodes with a lower priority get contracted first. Prefers nodes which
+   * require few shortcuts compared to their edges and which have few
+   * contracted neighbours (to contract uniformly across the graph).
+   */
+  int ContractionHierarchyBuilder::GetPriority(const std::vector<BuildNode>& nodes,
+                                               uint32_t node,
+                                               std::vector<Shortcut>& shortcuts) const
+  {
+    FindShortcuts(nodes,node,shortcuts);
+
+    return 2*(static_cast<int>(shortcuts.size())-static_cast<int>(nodes[node].in.size()+nodes[node].out.size()))+
+           static_cast<int>(nodes[node].contractedNeighbours);
+  }
+
+  /**
+   * Build the hierarchy for the routing graph files with the given base name.
+   */
+  bool ContractionHierarchyBuilder::Build(Progress& progress,
+                                          const TypeConfig& typeConfig,
+                                          const std::string& path,
+                                          const std::string& filenamebase,
+                                          ContractionHierarchy& hierarchy) const
+  {
+    struct RawEdge
+    {
+      Id            from;
+      Id            to;
+      double        cost;
+      ObjectFileRef object;
+    };
+
+    ObjectVariantDataFile objectVariantDataFile;
+    FileScanner           scanner;
+    Vehicle               vehicle=profile.GetVehicle();
+    std::vector<Id>       nodeIds;
+    std::vector<RawEdge>  rawEdges;
+
+    progress.SetAction("Loading routing graph");
+
+    if (!objectVariantDataFile.Load(typeConfig,
+                                    AppendFileToDir(path,
+                                                    RoutingService::GetData2Filename(filenamebase)))) {
+      progress.Error("Cannot load object variant data");
+      return false;
+    }
+
+    const std::vector<ObjectVariantData>& objectVariantData=objectVariantDataFile.GetData();
+
+    try {
+      FileOffset indexFileOffset;
+      uint32_t   dataCount;
+      uint32_t   tileMag;
+
+      scanner.Open(AppendFileToDir(path,
+                                   RoutingService::GetDataFilename(filenamebase)),
+                   FileScanner::Sequential,
+                   true);
+
+      scanner.Read(indexFileOffset);
+      scanner.Read(dataCount);
+      scanner.Read(tileMag);
+
+      nodeIds.reserve(dataCount);
+
+      for (uint32_t n=1; n<=dataCount; n++) {
+        RouteNode routeNode;
+
+        progress.SetProgress(n,dataCount);
+
+        routeNode.Read(scanner);
+
+        nodeIds.push_back(routeNode.GetId());
+
+        for (size_t p=0; p<routeNode.paths.size(); p++) {
+          const RouteNode::Path& routePath=routeNode.paths[p];
+
+          if (routePath.id==routeNode.GetId() ||
+              routePath.IsRestricted(vehicle) ||
+              !profile.CanUse(routeNode,objectVariantData,p)) {
+            continue;
+          }
+
+          double cost=profile.GetCosts(routeNode,objectVariantData,p,p);
+
+          if (!std::isfinite(cost)) {
+            continue;
+          }
+
+          rawEdges.push_back(RawEdge{routeNode.GetId(),
+                                     routePath.id,
+                                     cost,
+                                     routeNode.objects[routePath.objectIndex].object});
+        }
+      }
+
+      scanner.Close();
+    }
+    catch (IOException& e) {
+      progress.Error(e.GetDescription());
+      scanner.CloseFailsafe();
+      return false;
+    }
+
+    std::sort(nodeIds.begin(),nodeIds.end());
+    nodeIds.erase(std::unique(nodeIds.begin(),nodeIds.end()),nodeIds.end());
+
+    auto getIndex=[&nodeIds](Id id) {
+      auto entry=std::lower_bound(nodeIds.begin(),nodeIds.end(),id);
+
+      if (entry==nodeIds.end() ||
+          *entry!=id) {
+        return ContractionHierarchy::noNode;
+      }
+
+      return static_cast<uint32_t>(entry-nodeIds.begin());
+    };
+
+    std::vector<BuildNode> nodes(nodeIds.size());
+
+    for (const auto& rawEdge : rawEdges) {
+      uint32_t from=getIndex(rawEdge.from);
+      uint32_t to=getIndex(rawEdge.to);
+
+      if (to==ContractionHierarchy::noNode) {
+        continue;
+      }
+
+      AddEdge(nodes[from].out,BuildEdge{to,ContractionHierarchy::noNode,rawEdge.cost,rawEdge.object});
+      AddEdge(nodes[to].in,BuildEdge{from,ContractionHierarchy::noNode,rawEdge.cost,rawEdge.object});
+    }
+
+    progress.Info(std::to_string(nodeIds.size())+" route node(s), "+
+                  std::to_string(rawEdges.size())+" path(s)");
+
+    rawEdges.clear();
+    rawEdges.shrink_to_fit();
+
+    //
+    // Contract nodes in the order of their priority
+    //
+
+    progress.SetAction("Contracting route nodes");
+
+    using PriorityEntry = std::pair<int,uint32_t>;
+
+    std::priority_queue<PriorityEntry,std::vector<PriorityEntry>,std::greater<>> queue;
+    std::vector<std::vector<ContractionHierarchy::Edge>>                          upEdges(nodes.size());
+    std::vector<Shortcut>                                                         shortcuts;
+    size_t                                                                        contractedCount=0;
+    size_t                                                                        shortcutCount=0;
+
+    for (uint32_t n=0; n<nodes.size(); n++) {
+      queue.emplace(GetPriority(nodes,n,shortcuts),n);
+    }
+
+    while (!queue.empty()) {
+      uint32_t node=queue.top().second;
+
+      queue.pop();
+
+      if (nodes[node].contracted) {
+        continue;
+      }
+
+      // Lazy update, the priority may have changed since the node was queued
+      int priority=GetPriority(nodes,node,shortcuts);
+
+      if (!queue.empty() &&
+          priority>queue.top().first) {
+        queue.emplace(priority,node);
+        continue;
+      }
+
+      BuildNode& current=nodes[node];
+
+      for (const auto& edge : current.out) {
+        upEdges[node].push_back(ContractionHierarchy::Edge{edge.node,edge.middle,edge.cost,edge.object,
+                                                           ContractionHierarchy::forwardEdge});
+        RemoveEdge(nodes[edge.node].in,node);
+        nodes[edge.node].contractedNeighbours++;
+      }
+
+      for (const auto& edge : current.in) {
+        upEdges[node].push_back(ContractionHierarchy::Edge{edge.node,edge.middle,edge.cost,edge.object,
+                                                           ContractionHierarchy::backwardEdge});
+        RemoveEdge(nodes[edge.node].out,node);
+        nodes[edge.node].contractedNeighbours++;
+      }
+
+      for (const auto& shortcut : shortcuts) {
+        AddEdge(nodes[shortcut.from].out,BuildEdge{shortcut.to,node,shortcut.cost,ObjectFileRef()});
+        AddEdge(nodes[shortcut.to].in,BuildEdge{shortcut.from,node,shortcut.cost,ObjectFileRef()});
+      }
+
+      shortcutCount+=shortcuts.size();
+
+      current.contracted=true;
+      current.out.clear();
+      current.out.shrink_to_fit();
+      current.in.clear();
+      current.in.shrink_to_fit();
+
+      contractedCount++;
+      progress.SetProgress(contractedCount,nodes.size());
+    }
+
+    //
+    // Flatten the upward edges
+    //
+
+    std::vector<uint32_t>                   edgeOffsets;
+    std::vector<ContractionHierarchy::Edge> edges;
+
+    edgeOffsets.reserve(nodeIds.size()+1);
+
+    for (auto& nodeEdges : upEdges) {
+      edgeOffsets.push_back(static_cast<uint32_t>(edges.size()));
+      edges.insert(edges.end(),nodeEdges.begin(),nodeEdges.end());
+      nodeEdges.clear();
+      nodeEdges.shrink_to_fit();
+    }
+
+    edgeOffsets.push_back(static_cast<uint32_t>(edges.size()));
+
+    progress.Info(std::to_string(shortcutCount)+" shortcut(s), "+
+                  std::to_string(edges.size())+" edge(s) in hierarchy");
+
+    hierarchy.Assign(vehicle,
+                     profile.GetCostParameters(),
+                     std::move(nodeIds),
+                     std::move(edgeOffsets),
+                     std::move(edges));
+
+    return true;
+  }
+}
@@ -0,0 +1,200 @@
+/*
+  This source is part of the libosmscout library
+  Copyright (C) 2026  Tim Teulings
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307  USA
+*/
+
+#include <osmscout/routing/Isochrone.h>
+
+#include <algorithm>
+#include <cmath>
+#include <map>
+#include <set>
+
+#include <osmscout/util/Geometry.h>
+
+namespace osmscout {
+
+  namespace {
+
+    using GridPoint = std::pair<int32_t,int32_t>;
+
+    struct GridEdge
+    {
+      GridPoint from;
+      GridPoint to;
+      bool      used=false;
+    };
+
+    /**
+     * Cross product of the directions of the edges a->b and b->c, positive
+     * for a left turn
+     */
+    int64_t Turn(const GridPoint& a,
+                 const GridPoint& b,
+                 const GridPoint& c)
+    {
+      return int64_t(b.first-a.first)*(c.second-b.second)-
+             int64_t(b.second-a.second)*(c.first-b.first);
+    }
+  }
+
+  void CalculateIsochroneRings(const GeoCoord& origin,
+                               const Distance& cellSize,
+                               const std::vector<IsochroneNode>& nodes,
+                               double costLimit,
+                               std::vector<std::vector<GeoCoord>>& rings)
+  {
+    rings.clear();
+
+    // Size of a cell in degrees, for longitude at the latitude of the origin
+    double cellLat=cellSize.AsMeter()/111320.0;
+    double cellLon=cellLat/std::max(0.01,std::cos(origin.GetLat()*M_PI/180.0));
+
+    std::set<GridPoint> cells;
+
+    auto getCell=[&](const GeoCoord& coord) {
+      return GridPoint(int32_t(std::floor((coord.GetLon()-origin.GetLon())/cellLon)),
+                       int32_t(std::floor((coord.GetLat()-origin.GetLat())/cellLat)));
+    };
+
+    for (const auto& node : nodes) {
+      if (node.cost>costLimit) {
+        continue;
+      }
+
+      GridPoint cell=getCell(node.coord);
+
+      cells.insert(cell);
+
+      if (node.previous==IsochroneNode::NoPrevious) {
+        continue;
+      }
+
+      // Costs are increasing along the search tree, so the previous node is
+      // part of the band, too
+      const GeoCoord& from=nodes[node.previous].coord;
+      double          steps=std::ceil(2.0*std::max(std::abs(node.coord.GetLat()-from.GetLat())/cellLat,
+                                                   std::abs(node.coord.GetLon()-from.GetLon())/cellLon));
+      GridPoint       lastCell=getCell(from);
+
+      for (double step=1.0; step<=steps; step+=1.0) {
+        GridPoint current=getCell(GeoCoord(from.GetLat()+(node.coord.GetLat()-from.GetLat())*step/steps,
+                                           from.GetLon()+(node.coord.GetLon()-from.GetLon())*step/steps));
+
+        // Keep the cells of a path connected by edges, not only by corners
+        if (current.first!=lastCell.first &&
+            current.second!=lastCell.second) {
+          cells.emplace(current.first,lastCell.second);
+        }
+
+        cells.insert(current);
+        lastCell=current;
+      }
+    }
+
+    // Edges between touched and untouched cells, with the touched cell on the left
+    std::vector<GridEdge>                   edges;
+    std::map<GridPoint,std::vector<size_t>> outgoing;
+
+    auto addEdge=[&](int32_t fromX, int32_t fromY, int32_t toX, int32_t toY) {
+      outgoing[GridPoint(fromX,fromY)].push_back(edges.size());
+      edges.push_back(GridEdge{GridPoint(fromX,fromY),GridPoint(toX,toY)});
+    };
+
+    for (const auto& cell : cells) {
+      int32_t x=cell.first;
+      int32_t y=cell.second;
+
+      if (cells.count(GridPoint(x,y-1))==0) {
+        addEdge(x,y,x+1,y);
+      }
+      if (cells.count(GridPoint(x+1,y))==0) {
+        addEdge(x+1,y,x+1,y+1);
+      }
+      if (cells.count(GridPoint(x,y+1))==0) {
+        addEdge(x+1,y+1,x,y+1);
+      }
+      if (cells.count(GridPoint(x-1,y))==0) {
+        addEdge(x,y+1,x,y);
+      }
+    }
+
+    for (auto& start : edges) {
+      if (start.used) {
+        continue;
+      }
+
+      std::vector<GridPoint> points;
+      GridEdge*              edge=&start;
+
+      points.push_back(start.from);
+
+      while (true) {
+        edge->used=true;
+
+        if (edge->to==start.from) {
+          break;
+        }
+
+        // Two outgoing edges only exist, where two cells touch diagonally.
+        // Turning left keeps the cells in separate rings.
+        GridEdge* next=nullptr;
+
+        for (size_t candidate : outgoing[edge->to]) {
+          GridEdge& candidateEdge=edges[candidate];
+
+          if (candidateEdge.used) {
+            continue;
+          }
+
+          if (next==nullptr ||
+              Turn(edge->from,edge->to,candidateEdge.to)>0) {
+            next=&candidateEdge;
+          }
+        }
+
+        if (next==nullptr) {
+          break;
+        }
+
+        points.push_back(edge->to);
+        edge=next;
+      }
+
+      std::vector<GeoCoord> ring;
+
+      ring.reserve(points.size());
+
+      for (size_t i=0; i<points.size(); i++) {
+        const GridPoint& prev=points[(i+points.size()-1)%points.size()];
+        const GridPoint& next=points[(i+1)%points.size()];
+
+        // Skip points in the middle of straight lines
+        if (Turn(prev,points[i],next)==0) {
+          continue;
+        }
+
+        ring.emplace_back(origin.GetLat()+points[i].second*cellLat,
+                          origin.GetLon()+points[i].first*cellLon);
+      }
+
+      if (ring.size()>=3) {
+        rings.push_back(std::move(ring));
+      }
+    }
+  }
+}
@@ -19,6 +19,7 @@
 */
 
 #include <algorithm>
+#include <functional>
 #include <iomanip>
 #include <iostream>
 #include <iterator>
@@ -33,6 +34,7 @@
 #include <osmscout/util/Geometry.h>
 #include <osmscout/util/Logger.h>
 #include <osmscout/util/StopClock.h>
+#include <osmscout/util/WorkQueue.h>
 
 //#define DEBUG_ROUTING
 
@@ -67,8 +69,13 @@ namespace osmscout {
 
     RouterParameter routerParameter;
     routerParameter.SetDebugPerformance(debugPerformance);
+    routerParameter.SetInMemoryGraph(inMemoryGraph);
 
     isOpen=true;
+
+    // The caller is one of the threads, so one thread per database is available
+    workerPool=std::make_unique<WorkerPool>(handles.size()-1);
+
     for (auto& handle : handles) {
       SimpleRoutingServiceRef router=std::make_shared<osmscout::SimpleRoutingService>(
                                               handle.database,
@@ -83,7 +90,9 @@ namespace osmscout {
       handle.profile=profileBuilder(handle.database);
 
       RoutingDatabaseRef routingDatabase=std::make_shared<RoutingDatabase>();
-      if (!routingDatabase->Open(handle.database)) {
+      if (!routingDatabase->Open(handle.database) ||
+          (inMemoryGraph &&
+           !routingDatabase->LoadGraph())) {
         Close();
         return false;
       }
@@ -92,6 +101,85 @@ namespace osmscout {
 
     }
 
+    if (!LoadBoundaryNodes()) {
+      Close();
+      return false;
+    }
+
+    return true;
+  }
+
+  /**
+   * Build the table of boundary nodes, the route nodes contained in more than one
+   * database, so GetNodeTwins() does not need to look up each route node in all
+   * other databases during the search. Pairs of databases are processed
+   * concurrently, pairs with disjunct bounding boxes are skipped.
+   */
+  bool MultiDBRoutingService::LoadBoundaryNodes()
+  {
+    StopClock                                     timer;
+    std::vector<std::pair<DatabaseId,DatabaseId>> pairs;
+    std::vector<GeoBox>                           boundingBoxes(handles.size());
+
+    for (auto& handle : handles) {
+      handle.boundaryNodes.clear();
+
+      if (!handle.database->GetBoundingBox(boundingBoxes[handle.dbId])) {
+        boundingBoxes[handle.dbId].Invalidate();
+      }
+    }
+
+    for (DatabaseId a=0; a<handles.size(); a++) {
+      for (DatabaseId b=a+1; b<handles.size(); b++) {
+        if (!boundingBoxes[a].IsValid() ||
+            !boundingBoxes[b].IsValid() ||
+            boundingBoxes[a].Intersects(boundingBoxes[b],false)) {
+          pairs.emplace_back(a,b);
+        }
+      }
+    }
+
+    if (pairs.empty()) {
+      return true;
+    }
+
+    std::vector<std::vector<Id>>       sharedIds(pairs.size());
+    std::vector<std::function<bool()>> tasks;
+
+    tasks.reserve(pairs.size());
+
+    for (size_t i=0; i<pairs.size(); i++) {
+      tasks.emplace_back([this,&pairs,&sharedIds,i]() {
+        return handles[pairs[i].first].routingDatabase->GetSharedNodeIds(*handles[pairs[i].second].routingDatabase,
+                                                                        sharedIds[i]);
+      });
+    }
+
+    if (!workerPool->Run(tasks)) {
+      log.Error() << "Error while loading boundary nodes";
+      return false;
+    }
+
+    size_t boundaryNodeCount=0;
+
+    for (size_t i=0; i<pairs.size(); i++) {
+      DatabaseId a=pairs[i].first;
+      DatabaseId b=pairs[i].second;
+
+      for (const auto& id : sharedIds[i]) {
+        handles[a].boundaryNodes[id].emplace_back(b,id);
+        handles[b].boundaryNodes[id].emplace_back(a,id);
+      }
+
+      boundaryNodeCount+=sharedIds[i].size();
+    }
+
+    timer.Stop();
+
+    if (debugPerformance) {
+      log.Info() << "Loaded " << boundaryNodeCount << " boundary nodes in " << timer.ResultString();
+    }
+
     return true;
   }
 
@@ -107,8 +195,11 @@ namespace osmscout {
       handle.router->Close();
       handle.router.reset();
       handle.profile.reset();
+      handle.boundaryNodes.clear();
     }
 
+    workerPool.reset();
+
     isOpen=false;
   }
 
@@ -132,12 +223,48 @@ namespace osmscout {
     return closestPosition;
   }
 
+  /**
+   * Batched version of GetClosestRoutableNode(), returning one result for
+   * each coordinate
+   */
+  std::vector<RoutePositionResult> MultiDBRoutingService::GetClosestRoutableNodes(const std::vector<GeoCoord>& coords,
+                                                                                  const Distance &radius) const
+  {
+    std::vector<RoutePositionResult> closestPositions(coords.size());
+
+    for (auto& handle : handles) {
+      std::vector<RoutePositionResult> positions=handle.router->GetClosestRoutableNodes(coords,
+                                                                                        *handle.profile,
+                                                                                        radius);
+
+      for (size_t i=0; i<positions.size(); i++) {
+        const RoutePositionResult& position=positions[i];
+
+        if (position.IsValid() && position.GetDistance() < closestPositions[i].GetDistance()) {
+          closestPositions[i]=RoutePositionResult(RoutePosition(position.GetRoutePosition().GetObjectFileRef(),
+                                                                position.GetRoutePosition().GetNodeIndex(),
+                                                                /*database*/ handle.dbId),
+                                                  position.GetDistance());
+        }
+      }
+    }
+
+    return closestPositions;
+  }
+
   Vehicle MultiDBRoutingService::GetVehicle(const MultiDBRoutingState& /*state*/)
   {
     assert(!handles.empty());
     return handles.begin()->profile->GetVehicle();
   }
 
+  bool MultiDBRoutingService::HasTimeCosts(const MultiDBRoutingState& /*state*/)
+  {
+    return std::all_of(handles.begin(),handles.end(),[](const DatabaseHandle& handle) {
+      return handle.profile->HasTimeCosts();
+    });
+  }
+
   bool MultiDBRoutingService::CanUseForward(const MultiDBRoutingState& /*state*/,
                                             const DatabaseId& database,
                                             const WayRef& way)
@@ -176,6 +303,32 @@ namespace osmscout {
     return handles[database].profile->GetCosts(*way,wayLength);
   }
 
+  Duration MultiDBRoutingService::GetTime(const MultiDBRoutingState& /*state*/,
+                                          const DatabaseId database,
+                                          const RouteNode& routeNode,
+                                          size_t pathIndex)
+  {
+    assert(handles.size()>database);
+    return handles[database].profile->GetTime(routeNode,
+                                              handles[database].routingDatabase->GetObjectVariantData(),
+                                              pathIndex);
+  }
+
+  Duration MultiDBRoutingService::GetTime(const MultiDBRoutingState& /*state*/,
+                                          const DatabaseId database,
+                                          const WayRef &way,
+                                          const Distance &wayLength)
+  {
+    assert(handles.size()>database);
+    return handles[database].profile->GetTime(*way,wayLength);
+  }
+
+  const SpeedProfiles* MultiDBRoutingService::GetSpeedProfiles(const DatabaseId database)
+  {
+    assert(handles.size()>database);
+    return handles[database].routingDatabase->GetSpeedProfiles();
+  }
+
   double MultiDBRoutingService::GetEstimateCosts(const MultiDBRoutingState& /*state*/,
                                                  const DatabaseId database,
                                                  const Distance &targetDistance)
@@ -214,6 +367,10 @@ namespace osmscout {
                                                pathIndex);
   }
 
+  /**
+   * Load the route nodes, grouped by database. If the ids span several
+   * databases, the databases are accessed concurrently.
+   */
   bool MultiDBRoutingService::GetRouteNodes(const std::set<DBId> &routeNodeIds,
                                             std::unordered_map<DBId,RouteNodeRef> &routeNodeMap)
   {
@@ -221,18 +378,36 @@ namespace osmscout {
     for (const auto &id:routeNodeIds){
       idMap[id.database].insert(id.id);
     }
+
+    std::vector<std::vector<RouteNodeRef>> nodes(idMap.size());
+    std::vector<std::function<bool()>>     tasks;
+    std::vector<DatabaseId>                databases;
+
     for (const auto &entry:idMap){
-      std::vector<RouteNodeRef>  nodes;
-      const std::set<Id>         &ids=entry.second;
+      const std::set<Id>        &ids=entry.second;
+      RoutingDatabase           &routingDatabase=*handles[entry.first].routingDatabase;
+      std::vector<RouteNodeRef> &result=nodes[tasks.size()];
+
+      tasks.emplace_back([&routingDatabase,&ids,&result]() {
+        return routingDatabase.GetRouteNodes(ids.begin(),
+                                             ids.end(),
+                                             ids.size(),
+                                             result);
+      });
+      databases.push_back(entry.first);
+    }
 
-      if (!handles[entry.first].routingDatabase->GetRouteNodes(ids.begin(),
-                                                               ids.end(),
-                                                               ids.size(),
-                                                               nodes)) {
-        return false;
-      }
-      for (const auto &node:nodes) {
-        routeNodeMap[DBId(entry.first,node->GetId())]=node;
+    if (tasks.empty()) {
+      return true;
+    }
+
+    if (!workerPool->Run(tasks)) {
+      return false;
+    }
+
+    for (size_t i=0; i<databases.size(); i++) {
+      for (const auto &node:nodes[i]) {
+        routeNodeMap[DBId(databases[i],node->GetId())]=node;
       }
     }
     return true;
@@ -244,12 +419,22 @@ namespace osmscout {
     return handles[id.database].routingDatabase->GetRouteNode(id.id, node);
   }
 
+  bool MultiDBRoutingService::GetRouteNodePredecessors(const DBId &id,
+                                                       std::vector<std::pair<Id,ObjectFileRef>> &sources)
+  {
+    return handles[id.database].routingDatabase->GetPredecessors(id.id, sources);
+  }
+
   bool MultiDBRoutingService::GetWayByOffset(const DBFileOffset &offset,
                                              WayRef &way)
   {
     return handles[offset.database].database->GetWayByOffset(offset.offset,way);
   }
 
+  /**
+   * Load the ways, grouped by database. If the offsets span several
+   * databases, the databases are accessed concurrently.
+   */
   bool MultiDBRoutingService::GetWaysByOffset(const std::set<DBFileOffset> &wayOffsets,
                                               std::unordered_map<DBFileOffset,WayRef> &wayMap)
   {
@@ -257,13 +442,33 @@ namespace osmscout {
     for (const auto &offset:wayOffsets){
       offsetMap[offset.database].insert(offset.offset);
     }
+
+    std::vector<std::vector<WayRef>>   ways(offsetMap.size());
+    std::vector<std::function<bool()>> tasks;
+    std::vector<DatabaseId>            databases;
+
     for (const auto &entry:offsetMap){
-      std::vector<WayRef> ways;
-      if (!handles[entry.first].database->GetWaysByOffset(entry.second,ways)){
-        return false;
-      }
-      for (const auto &way:ways){
-        wayMap[DBFileOffset(entry.first,way->GetFileOffset())]=way;
+      const std::set<FileOffset> &offsets=entry.second;
+      Database                   &database=*handles[entry.first].database;
+      std::vector<WayRef>        &result=ways[tasks.size()];
+
+      tasks.emplace_back([&database,&offsets,&result]() {
+        return database.GetWaysByOffset(offsets,result);
+      });
+      databases.push_back(entry.first);
+    }
+
+    if (tasks.empty()) {
+      return true;
+    }
+
+    if (!workerPool->Run(tasks)) {
+      return false;
+    }
+
+    for (size_t i=0; i<databases.size(); i++) {
+      for (const auto &way:ways[i]) {
+        wayMap[DBFileOffset(databases[i],way->GetFileOffset())]=way;
       }
     }
     return true;
@@ -275,6 +480,10 @@ namespace osmscout {
     return handles[offset.database].database->GetAreaByOffset(offset.offset,area);
   }
 
+  /**
+   * Load the areas, grouped by database. If the offsets span several
+   * databases, the databases are accessed concurrently.
+   */
   bool MultiDBRoutingService::GetAreasByOffset(const std::set<DBFileOffset> &areaOffsets,
                                                std::unordered_map<DBFileOffset,AreaRef> &areaMap)
   {
@@ -282,13 +491,33 @@ namespace osmscout {
     for (const auto &offset:areaOffsets){
       offsetMap[offset.database].insert(offset.offset);
     }
+
+    std::vector<std::vector<AreaRef>>  areas(offsetMap.size());
+    std::vector<std::function<bool()>> tasks;
+    std::vector<DatabaseId>            databases;
+
     for (const auto &entry:offsetMap){
-      std::vector<AreaRef> areas;
-      if (!handles[entry.first].database->GetAreasByOffset(entry.second,areas)){
-        return false;
-      }
-      for (const auto &area:areas){
-        areaMap[DBFileOffset(entry.first,area->GetFileOffset())]=area;
+      const std::set<FileOffset> &offsets=entry.second;
+      Database                   &database=*handles[entry.first].database;
+      std::vector<AreaRef>       &result=areas[tasks.size()];
+
+      tasks.emplace_back([&database,&offsets,&result]() {
+        return database.GetAreasByOffset(offsets,result);
+      });
+      databases.push_back(entry.first);
+    }
+
+    if (tasks.empty()) {
+      return true;
+    }
+
+    if (!workerPool->Run(tasks)) {
+      return false;
+    }
+
+    for (size_t i=0; i<databases.size(); i++) {
+      for (const auto &area:areas[i]) {
+        areaMap[DBFileOffset(databases[i],area->GetFileOffset())]=area;
       }
     }
     return true;
@@ -339,21 +568,39 @@ namespace osmscout {
   std::vector<DBId> MultiDBRoutingService::GetNodeTwins(const MultiDBRoutingState& /*state*/,
                                                         const DatabaseId database,
                                                         const Id id)
+  {
+    return GetBoundaryNodeTwins(database,
+                                id);
+  }
+
+  /**
+   * Return the number of route nodes of the given database, that are also
+   * contained in other databases
+   */
+  size_t MultiDBRoutingService::GetBoundaryNodeCount(const DatabaseId database) const
   {
     assert(handles.size()>database);
 
-    std::vector<DBId> twins;
+    return handles[database].boundaryNodes.size();
+  }
 
-    twins.reserve(handles.size()-1);
-    for (DatabaseId dbId=0; dbId<handles.size(); dbId++){
-      if (dbId==database){
-        continue;
-      }
-      if (handles[dbId].routingDatabase->ContainsNode(id)) {
-        twins.emplace_back(dbId, id);
-      }
+  /**
+   * Return the twins of the given route node in the other databases, empty if
+   * it is not a boundary node
+   */
+  std::vector<DBId> MultiDBRoutingService::GetBoundaryNodeTwins(const DatabaseId database,
+                                                                const Id id) const
+  {
+    assert(handles.size()>database);
+
+    const auto& boundaryNodes=handles[database].boundaryNodes;
+    auto        entry=boundaryNodes.find(id);
+
+    if (entry==boundaryNodes.end()) {
+      return {};
     }
-    return twins;
+
+    return entry->second;
   }
 
   RoutingResult MultiDBRoutingService::CalculateRoute(const RoutePosition &start,
@@ -398,6 +645,104 @@ namespace osmscout {
                                                                        parameter);
   }
 
+  /**
+   * Calculate the best route and alternative routes between start and target.
+   * If start and target are in the same database, the routes are calculated
+   * by the router of this database.
+   */
+  AlternativeRoutingResult MultiDBRoutingService::CalculateAlternativeRoutes(const RoutePosition& start,
+                                                                             const RoutePosition& target,
+                                                                             const RoutingParameter& parameter,
+                                                                             const AlternativeRouteParameter& alternativeParameter)
+  {
+    for (const auto& position : {start,target}) {
+      if (position.GetDatabaseId()>=handles.size() ||
+          !handles[position.GetDatabaseId()].router) {
+        log.Error() << "Can't find database " << position.GetDatabaseId();
+        return AlternativeRoutingResult();
+      }
+    }
+
+    if (start.GetDatabaseId()==target.GetDatabaseId()) {
+      DatabaseId dbId=start.GetDatabaseId();
+
+      return handles[dbId].router->CalculateAlternativeRoutes(*handles[dbId].profile,
+                                                              start,
+                                                              target,
+                                                              parameter,
+                                                              alternativeParameter);
+    }
+
+    MultiDBRoutingState state;
+    return AbstractRoutingService<MultiDBRoutingState>::CalculateAlternativeRoutes(state,
+                                                                                   start,
+                                                                                   target,
+                                                                                   parameter,
+                                                                                   alternativeParameter);
+  }
+
+  /**
+   * Calculate costs, distance and duration of the routes from each source to
+   * each target. If all positions are in the same database, the matrix is
+   * calculated by the router of this database.
+   */
+  RoutingMatrixResult MultiDBRoutingService::CalculateMatrix(const std::vector<RoutePosition>& sources,
+                                                             const std::vector<RoutePosition>& targets,
+                                                             const RoutingParameter& parameter)
+  {
+    std::set<DatabaseId> databases;
+
+    for (const auto& positions : {&sources,&targets}) {
+      for (const auto& position : *positions) {
+        if (position.GetDatabaseId()>=handles.size() ||
+            !handles[position.GetDatabaseId()].router) {
+          log.Error() << "Can't find database " << position.GetDatabaseId();
+          return RoutingMatrixResult();
+        }
+
+        databases.insert(position.GetDatabaseId());
+      }
+    }
+
+    if (databases.size()==1) {
+      DatabaseId dbId=*databases.begin();
+
+      return handles[dbId].router->CalculateMatrix(*handles[dbId].profile,
+                                                   sources,
+                                                   targets,
+                                                   parameter);
+    }
+
+    MultiDBRoutingState state;
+    return AbstractRoutingService<MultiDBRoutingState>::CalculateMatrix(state,
+                                                                        sources,
+                                                                        targets,
+                                                                        parameter);
+  }
+
+  /**
+   * Calculate the area reachable from the start within the given cost limits.
+   * The search crosses into other databases via shared route nodes.
+   */
+  IsochroneResult MultiDBRoutingService::CalculateIsochrone(const RoutePosition& start,
+                                                            const std::vector<double>& costLimits,
+                                                            const Distance& cellSize,
+                                                            const RoutingParameter& parameter)
+  {
+    if (start.GetDatabaseId()>=handles.size() ||
+        !handles[start.GetDatabaseId()].router) {
+      log.Error() << "Can't find database " << start.GetDatabaseId();
+      return IsochroneResult();
+    }
+
+    MultiDBRoutingState state;
+    return AbstractRoutingService<MultiDBRoutingState>::CalculateIsochrone(state,
+                                                                           start,
+                                                                           costLimits,
+                                                                           cellSize,
+                                                                           parameter);
+  }
+
     /**
      * Calculate a route going through all the via points
      *
@@ -22,6 +22,8 @@
 #include <osmscout/system/Assert.h>
 #include <osmscout/system/Math.h>
 
+#include <algorithm>
+#include <cstring>
 #include <sstream>
 #include <string_view>
 
@@ -66,6 +68,58 @@ namespace osmscout {
   /** Constant for a description of suggested route lanes (SuggestedLaneDescription) */
   const char* const RouteDescription::SUGGESTED_LANES_DESC   = "SuggestedLanes";
 
+  namespace {
+    // In the order of RouteDescription::DescriptionSlot
+    const std::array<const char*,RouteDescription::descriptionSlotCount> descriptionSlotNames{
+      RouteDescription::NODE_START_DESC,
+      RouteDescription::NODE_TARGET_DESC,
+      RouteDescription::WAY_NAME_DESC,
+      RouteDescription::WAY_NAME_CHANGED_DESC,
+      RouteDescription::CROSSING_WAYS_DESC,
+      RouteDescription::DIRECTION_DESC,
+      RouteDescription::TURN_DESC,
+      RouteDescription::ROUNDABOUT_ENTER_DESC,
+      RouteDescription::ROUNDABOUT_LEAVE_DESC,
+      RouteDescription::MOTORWAY_ENTER_DESC,
+      RouteDescription::MOTORWAY_CHANGE_DESC,
+      RouteDescription::MOTORWAY_LEAVE_DESC,
+      RouteDescription::MOTORWAY_JUNCTION_DESC,
+      RouteDescription::CROSSING_DESTINATION_DESC,
+      RouteDescription::WAY_MAXSPEED_DESC,
+      RouteDescription::WAY_TYPE_NAME_DESC,
+      RouteDescription::POI_AT_ROUTE_DESC,
+      RouteDescription::LANES_DESC,
+      RouteDescription::SUGGESTED_LANES_DESC
+    };
+  }
+
+  /**
+   * Return the slot of the description with the given name or an empty value,
+   * if it is not one of the standard descriptions. Names passed as one of the
+   * *_DESC constants are found without comparing strings.
+   */
+  std::optional<RouteDescription::DescriptionSlot> RouteDescription::GetDescriptionSlot(const char* name)
+  {
+    for (size_t slot=0; slot<descriptionSlotCount; slot++) {
+      if (descriptionSlotNames[slot]==name) {
+        return static_cast<DescriptionSlot>(slot);
+      }
+    }
+
+    for (size_t slot=0; slot<descriptionSlotCount; slot++) {
+      if (std::strcmp(descriptionSlotNames[slot],name)==0) {
+        return static_cast<DescriptionSlot>(slot);
+      }
+    }
+
+    return std::nullopt;
+  }
+
+  const char* RouteDescription::GetDescriptionName(DescriptionSlot slot)
+  {
+    return descriptionSlotNames[static_cast<size_t>(slot)];
+  }
+
   RouteDescription::StartDescription::StartDescription(const std::string& description)
   : description(description)
   {
@@ -531,15 +585,16 @@ namespace osmscout {
 
   bool RouteDescription::Node::HasDescription(const char* name) const
   {
-    std::unordered_map<std::string,DescriptionRef>::const_iterator entry;
-
-    entry=descriptionMap.find(name);
-
-    return entry!=descriptionMap.end() && entry->second;
+    return GetDescription(name)!=nullptr;
   }
 
   RouteDescription::DescriptionRef RouteDescription::Node::GetDescription(const char* name) const
   {
+    if (auto slot=GetDescriptionSlot(name);
+        slot) {
+      return slots[static_cast<size_t>(*slot)];
+    }
+
     std::unordered_map<std::string,DescriptionRef>::const_iterator entry;
 
     entry=descriptionMap.find(name);
@@ -567,13 +622,57 @@ namespace osmscout {
     this->time=time;
   }
 
+  void RouteDescription::Node::AddDescription(DescriptionSlot slot,
+                                              const DescriptionRef& description)
+  {
+    descriptions.push_back(description);
+    slots[static_cast<size_t>(slot)]=description;
+  }
+
   void RouteDescription::Node::AddDescription(const char* name,
                                               const DescriptionRef& description)
   {
+    if (auto slot=GetDescriptionSlot(name);
+        slot) {
+      AddDescription(*slot,
+                     description);
+      return;
+    }
+
     descriptions.push_back(description);
     descriptionMap[name]=description;
   }
 
+  /**
+   * Add the descriptions of the other node (a copy of this node), that this
+   * node does not have yet, in the order they were added to the other node
+   */
+  void RouteDescription::Node::MergeDescriptions(const Node& other)
+  {
+    for (const auto& description : other.descriptions) {
+      if (std::find(descriptions.begin(),descriptions.end(),description)==descriptions.end()) {
+        descriptions.push_back(description);
+      }
+    }
+
+    for (size_t slot=0; slot<descriptionSlotCount; slot++) {
+      if (!slots[slot]) {
+        slots[slot]=other.slots[slot];
+      }
+    }
+
+    for (const auto& entry : other.descriptionMap) {
+      descriptionMap.insert(entry);
+    }
+  }
+
+  void RouteDescription::Node::ClearDescriptions()
+  {
+    descriptions.clear();
+    slots.fill(nullptr);
+    descriptionMap.clear();
+  }
+
   void RouteDescription::SetDatabaseMapping(std::map<DatabaseId, std::string> databaseMapping)
   {
     this->databaseMapping = databaseMapping;
@@ -594,6 +693,29 @@ namespace osmscout {
     return nodes.empty();
   }
 
+  /**
+   * Return the last node with a distance from the start less or equal to the
+   * given distance (the node the segment containing the distance starts with)
+   * by a binary search. Return the first node for distances before the start
+   * and end() for an empty description.
+   */
+  RouteDescription::NodeIterator RouteDescription::FindNodeByDistance(const Distance& distance) const
+  {
+    auto node=std::upper_bound(nodes.cbegin(),
+                               nodes.cend(),
+                               distance,
+                               [](const Distance& distance,
+                                  const Node& node) {
+                                 return distance<node.GetDistance();
+                               });
+
+    if (node==nodes.cbegin()) {
+      return node;
+    }
+
+    return std::prev(node);
+  }
+
   void RouteDescription::AddNode(DatabaseId database,
                                  size_t currentNodeIndex,
                                  const std::vector<ObjectFileRef>& objects,
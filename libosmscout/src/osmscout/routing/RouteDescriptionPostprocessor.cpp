@@ -167,88 +167,88 @@ namespace osmscout {
       osmscout::RouteDescription::TypeNameDescriptionRef         typeNameDescription;
       osmscout::RouteDescription::POIAtRouteDescriptionRef       poiAtRouteDescription;
 
-      desc=node->GetDescription(osmscout::RouteDescription::WAY_NAME_DESC);
+      desc=node->GetDescription(osmscout::RouteDescription::DescriptionSlot::WayName);
       if (desc) {
         nameDescription=std::dynamic_pointer_cast<osmscout::RouteDescription::NameDescription>(desc);
       }
 
-      desc=node->GetDescription(osmscout::RouteDescription::DIRECTION_DESC);
+      desc=node->GetDescription(osmscout::RouteDescription::DescriptionSlot::Direction);
       if (desc) {
         directionDescription=std::dynamic_pointer_cast<osmscout::RouteDescription::DirectionDescription>(desc);
       }
 
-      desc=node->GetDescription(osmscout::RouteDescription::WAY_NAME_CHANGED_DESC);
+      desc=node->GetDescription(osmscout::RouteDescription::DescriptionSlot::WayNameChanged);
       if (desc) {
         nameChangedDescription=std::dynamic_pointer_cast<osmscout::RouteDescription::NameChangedDescription>(desc);
       }
 
-      desc=node->GetDescription(osmscout::RouteDescription::CROSSING_WAYS_DESC);
+      desc=node->GetDescription(osmscout::RouteDescription::DescriptionSlot::CrossingWays);
       if (desc) {
         crossingWaysDescription=std::dynamic_pointer_cast<osmscout::RouteDescription::CrossingWaysDescription>(desc);
       }
 
-      desc=node->GetDescription(osmscout::RouteDescription::NODE_START_DESC);
+      desc=node->GetDescription(osmscout::RouteDescription::DescriptionSlot::NodeStart);
       if (desc) {
         startDescription=std::dynamic_pointer_cast<osmscout::RouteDescription::StartDescription>(desc);
       }
 
-      desc=node->GetDescription(osmscout::RouteDescription::NODE_TARGET_DESC);
+      desc=node->GetDescription(osmscout::RouteDescription::DescriptionSlot::NodeTarget);
       if (desc) {
         targetDescription=std::dynamic_pointer_cast<osmscout::RouteDescription::TargetDescription>(desc);
       }
 
 
-      desc=node->GetDescription(osmscout::RouteDescription::TURN_DESC);
+      desc=node->GetDescription(osmscout::RouteDescription::DescriptionSlot::Turn);
       if (desc) {
         turnDescription=std::dynamic_pointer_cast<osmscout::RouteDescription::TurnDescription>(desc);
       }
 
-      desc=node->GetDescription(osmscout::RouteDescription::ROUNDABOUT_ENTER_DESC);
+      desc=node->GetDescription(osmscout::RouteDescription::DescriptionSlot::RoundaboutEnter);
       if (desc) {
         roundaboutEnterDescription=std::dynamic_pointer_cast<osmscout::RouteDescription::RoundaboutEnterDescription>(desc);
       }
 
-      desc=node->GetDescription(osmscout::RouteDescription::ROUNDABOUT_LEAVE_DESC);
+      desc=node->GetDescription(osmscout::RouteDescription::DescriptionSlot::RoundaboutLeave);
       if (desc) {
         roundaboutLeaveDescription=std::dynamic_pointer_cast<osmscout::RouteDescription::RoundaboutLeaveDescription>(desc);
       }
 
-      desc=node->GetDescription(osmscout::RouteDescription::MOTORWAY_ENTER_DESC);
+      desc=node->GetDescription(osmscout::RouteDescription::DescriptionSlot::MotorwayEnter);
       if (desc) {
         motorwayEnterDescription=std::dynamic_pointer_cast<osmscout::RouteDescription::MotorwayEnterDescription>(desc);
       }
 
-      desc=node->GetDescription(osmscout::RouteDescription::MOTORWAY_CHANGE_DESC);
+      desc=node->GetDescription(osmscout::RouteDescription::DescriptionSlot::MotorwayChange);
       if (desc) {
         motorwayChangeDescription=std::dynamic_pointer_cast<osmscout::RouteDescription::MotorwayChangeDescription>(desc);
       }
 
-      desc=node->GetDescription(osmscout::RouteDescription::MOTORWAY_LEAVE_DESC);
+      desc=node->GetDescription(osmscout::RouteDescription::DescriptionSlot::MotorwayLeave);
       if (desc) {
         motorwayLeaveDescription=std::dynamic_pointer_cast<osmscout::RouteDescription::MotorwayLeaveDescription>(desc);
       }
 
-      desc=node->GetDescription(osmscout::RouteDescription::MOTORWAY_JUNCTION_DESC);
+      desc=node->GetDescription(osmscout::RouteDescription::DescriptionSlot::MotorwayJunction);
       if (desc) {
         motorwayJunctionDescription=std::dynamic_pointer_cast<osmscout::RouteDescription::MotorwayJunctionDescription>(desc);
       }
 
-      desc=node->GetDescription(osmscout::RouteDescription::CROSSING_DESTINATION_DESC);
+      desc=node->GetDescription(osmscout::RouteDescription::DescriptionSlot::CrossingDestination);
       if (desc) {
         crossingDestinationDescription=std::dynamic_pointer_cast<osmscout::RouteDescription::DestinationDescription>(desc);
       }
 
-      desc=node->GetDescription(osmscout::RouteDescription::WAY_MAXSPEED_DESC);
+      desc=node->GetDescription(osmscout::RouteDescription::DescriptionSlot::WayMaxSpeed);
       if (desc) {
         maxSpeedDescription=std::dynamic_pointer_cast<osmscout::RouteDescription::MaxSpeedDescription>(desc);
       }
 
-      desc=node->GetDescription(osmscout::RouteDescription::WAY_TYPE_NAME_DESC);
+      desc=node->GetDescription(osmscout::RouteDescription::DescriptionSlot::WayTypeName);
       if (desc) {
         typeNameDescription=std::dynamic_pointer_cast<osmscout::RouteDescription::TypeNameDescription>(desc);
       }
 
-      desc=node->GetDescription(osmscout::RouteDescription::POI_AT_ROUTE_DESC);
+      desc=node->GetDescription(osmscout::RouteDescription::DescriptionSlot::POIAtRoute);
       if (desc) {
         poiAtRouteDescription=std::dynamic_pointer_cast<osmscout::RouteDescription::POIAtRouteDescription>(desc);
       }
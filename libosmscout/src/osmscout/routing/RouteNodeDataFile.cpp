@@ -19,50 +19,104 @@
 
 #include <osmscout/routing/RouteNodeDataFile.h>
 
+#include <algorithm>
+#include <unordered_set>
+
 namespace osmscout {
 
-  RouteNodeRef RouteNodeDataFile::IndexPage::find(FileScanner& scanner,
-                                                  Id id)
-  {
-    if (!nodeMap.empty()) {
-      auto nodeEntry=nodeMap.find(id);
+  namespace {
+    /**
+     * Collects the paths of the given route nodes, for which the target route
+     * node has no path back using the same object. A path is kept until its
+     * path back is found, so mostly paths at the border of the area read so
+     * far are held at the same time.
+     */
+    class PredecessorCollector CLASS_FINAL
+    {
+    private:
+      struct PathKey
+      {
+        Id            source;
+        Id            target;
+        ObjectFileRef object;
+
+        inline bool operator==(const PathKey& other) const
+        {
+          return source==other.source &&
+                 target==other.target &&
+                 object==other.object;
+        }
+      };
 
-      if (nodeEntry!=nodeMap.end()) {
-        return nodeEntry->second;
+      struct PathKeyHasher
+      {
+        inline size_t operator()(const PathKey& key) const
+        {
+          uint64_t hash=(key.source*31+key.target)*31+key.object.GetFileOffset();
+
+          return size_t(hash*0x9E3779B97F4A7C15ull >> 16);
+        }
+      };
+
+      std::unordered_set<PathKey,PathKeyHasher> pending;
+
+    public:
+      void Add(const RouteNode& routeNode)
+      {
+        for (const auto& path : routeNode.paths) {
+          const ObjectFileRef& object=routeNode.objects[path.objectIndex].object;
+          auto                 back=pending.find(PathKey{path.id,routeNode.GetId(),object});
+
+          if (back!=pending.end()) {
+            pending.erase(back);
+          }
+          else {
+            pending.insert(PathKey{routeNode.GetId(),path.id,object});
+          }
+        }
       }
-    }
 
-    if (remaining>0) {
-      scanner.SetPos(fileOffset);
+      void Finish(std::vector<RouteNodeDataFile::Predecessor>& predecessors)
+      {
+        predecessors.clear();
+        predecessors.reserve(pending.size());
 
-      while (remaining>0) {
-        remaining--;
-        RouteNodeRef node=std::make_shared<RouteNode>();
+        for (const auto& key : pending) {
+          predecessors.push_back(RouteNodeDataFile::Predecessor{key.target,key.source,key.object});
+        }
 
-        node->Read(scanner);
-        nodeMap.insert(std::make_pair(node->GetId(),node));
+        pending.clear();
 
-        fileOffset=scanner.GetPos();
+        std::sort(predecessors.begin(),predecessors.end(),[](const RouteNodeDataFile::Predecessor& a,
+                                                               const RouteNodeDataFile::Predecessor& b) {
+          if (a.target!=b.target) {
+            return a.target<b.target;
+          }
 
-        if (node->GetId()==id) {
-          return node;
-        }
+          return a.source<b.source;
+        });
       }
-    }
-
-    return nullptr;
+    };
   }
 
   RouteNodeDataFile::RouteNodeDataFile(const std::string& datafile,
                                        size_t cacheSize)
   : datafile(datafile),
-    cache(cacheSize)
+    cache(cacheSize),
+    graphLoaded(false),
+    predecessorsLoaded(false)
+  {
+  }
+
+  RouteNodeDataFile::~RouteNodeDataFile()
   {
+    DetachMemoryGovernor();
   }
 
   bool RouteNodeDataFile::Open(const TypeConfigRef& typeConfig,
                                const std::string& path,
-                               bool memoryMappedData)
+                               bool memoryMappedData,
+                               uint8_t mmapAdvice)
   {
     this->typeConfig=typeConfig;
 
@@ -76,7 +130,8 @@ namespace osmscout {
 
       scanner.Open(datafilename,
                    FileScanner::LowMemRandom,
-                   memoryMappedData);
+                   memoryMappedData,
+                   mmapAdvice);
 
       scanner.Read(indexFileOffset);
       scanner.Read(dataCount);
@@ -126,6 +181,17 @@ namespace osmscout {
   bool RouteNodeDataFile::Close()
   {
     typeConfig=nullptr;
+    DetachMemoryGovernor();
+    cache.Flush();
+
+    graphLoaded=false;
+    graph.Clear();
+    graphNodes.clear();
+    graphNodes.shrink_to_fit();
+
+    predecessorsLoaded=false;
+    predecessors.clear();
+    predecessors.shrink_to_fit();
 
     try  {
       if (scanner.IsOpen()) {
@@ -141,8 +207,91 @@ namespace osmscout {
     return true;
   }
 
+  /**
+   * Load all route nodes into a RoutingGraph. The route node of each node of
+   * the graph is restored once, afterwards Get() resolves route nodes by the
+   * id hash table of the graph and returns them without page cache, locking
+   * or allocation. The predecessors (see GetPredecessors()) are derived while
+   * loading.
+   *
+   * Method is NOT thread-safe.
+   */
+  bool RouteNodeDataFile::LoadGraph()
+  {
+    assert(IsOpen());
+
+    size_t nodeCount=0;
+
+    for (const auto& entry : index) {
+      nodeCount+=entry.second.count;
+    }
+
+    graph.Clear();
+    graph.Reserve(nodeCount);
+
+    PredecessorCollector collector;
+
+    try {
+      std::lock_guard<std::mutex> lock(accessMutex);
+      RouteNode                   node;
+
+      for (const auto& entry : index) {
+        scanner.SetPos(entry.second.fileOffset);
+
+        for (uint32_t i=0; i<entry.second.count; i++) {
+          node.Read(scanner);
+          graph.AddNode(node);
+          collector.Add(node);
+        }
+      }
+    }
+    catch (IOException& e) {
+      log.Error() << e.GetDescription();
+      graph.Clear();
+      return false;
+    }
+
+    size_t droppedCount=graph.Finish();
+
+    if (droppedCount>0) {
+      log.Warn() << droppedCount << " path(s) of '" << datafilename << "' lead to unknown route nodes and were dropped";
+    }
+
+    log.Debug() << "Routing graph of '" << datafilename << "': " << graph.GetNodeCount() << " nodes, "
+                << graph.GetPathCount() << " paths, " << graph.GetMemoryUsage()/1024 << " KiB";
+
+    graphNodes.clear();
+    graphNodes.reserve(graph.GetNodeCount());
+
+    for (uint32_t n=0; n<graph.GetNodeCount(); n++) {
+      RouteNodeRef routeNode=std::make_shared<RouteNode>();
+
+      graph.GetRouteNode(n,*routeNode);
+      graphNodes.push_back(routeNode);
+    }
+
+    {
+      std::lock_guard<std::mutex> lock(predecessorMutex);
+
+      collector.Finish(predecessors);
+      predecessorsLoaded=true;
+    }
+
+    graphLoaded=true;
+
+    // Pages are not used anymore
+    cache.Flush();
+
+    return true;
+  }
+
+  /**
+   * Load all route nodes of the given tile into a new page and put the page
+   * into the cache. Only reading from the scanner is serialized, concurrent
+   * loads of the same page by different threads are harmless.
+   */
   bool RouteNodeDataFile::LoadIndexPage(const osmscout::Pixel& tile,
-                                        ValueCache::CacheRef& cacheRef) const
+                                        IndexPageRef& page) const
   {
     assert(IsOpen());
 
@@ -152,24 +301,41 @@ namespace osmscout {
       return false;
     }
 
-    ValueCache::CacheEntry cacheEntry(tile.GetId());
+    page=std::make_shared<IndexPage>();
 
-    cacheEntry.value.fileOffset=entry->second.fileOffset;
-    cacheEntry.value.remaining=entry->second.count;
+    page->nodeMap.reserve(entry->second.count);
+
+    try {
+      std::lock_guard<std::mutex> lock(accessMutex);
+
+      scanner.SetPos(entry->second.fileOffset);
+
+      for (uint32_t i=0; i<entry->second.count; i++) {
+        RouteNodeRef node=std::make_shared<RouteNode>();
+
+        node->Read(scanner);
+        page->nodeMap.emplace(node->GetId(),node);
+      }
+    }
+    catch (IOException& e) {
+      log.Error() << e.GetDescription();
+      return false;
+    }
 
-    cacheRef=cache.SetEntry(cacheEntry);
+    cache.SetEntry(tile.GetId(),
+                   page);
 
     return true;
   }
 
   bool RouteNodeDataFile::GetIndexPage(const osmscout::Pixel& tile,
-                                       ValueCache::CacheRef& cacheRef) const
+                                       IndexPageRef& page) const
   {
     if (!cache.GetEntry(tile.GetId(),
-                        cacheRef)) {
+                        page)) {
       //std::cout << "RouteNodeDF::GetIndexPage() Not fond in cache, loading...!" << std::endl;
       if (!LoadIndexPage(tile,
-                         cacheRef)) {
+                         page)) {
         return false;
       }
     }
@@ -177,11 +343,30 @@ namespace osmscout {
     return true;
   }
 
+  /**
+   * Return the route node with the given id. Route nodes of cached pages
+   * and of the loaded graph are shared and returned without locking.
+   *
+   * Method is thread-safe.
+   */
   bool RouteNodeDataFile::Get(Id id,
                               RouteNodeRef& node) const
   {
+    if (graphLoaded) {
+      uint32_t index=graph.GetNodeIndex(id);
+
+      if (index==RoutingGraph::noNode) {
+        node=nullptr;
+        return false;
+      }
+
+      node=graphNodes[index];
+
+      return true;
+    }
+
     //std::cout << "Loading RouteNode " << id << "..." << std::endl;
-    ValueCache::CacheRef cacheRef;
+    IndexPageRef page;
 
     GeoCoord coord=Point::GetCoordFromId(id);
     TileId   tile=TileId::GetTile(magnification,coord);
@@ -189,14 +374,212 @@ namespace osmscout {
     //std::cout << "Tile " << tile.GetDisplayText() << " " << tile.GetId() << "..." << std::endl;
 
     if (!GetIndexPage(tile.AsPixel(),
-                      cacheRef)) {
+                      page)) {
+      return false;
+    }
+
+    auto entry=page->nodeMap.find(id);
+
+    if (entry==page->nodeMap.end()) {
+      node=nullptr;
+      return false;
+    }
+
+    node=entry->second;
+
+    return true;
+  }
+
+  /**
+   * Return true, if the file contains a route node with the given id. With the
+   * graph loaded only the id hash table of the graph is used.
+   */
+  bool RouteNodeDataFile::Contains(Id id) const
+  {
+    if (graphLoaded) {
+      return graph.GetNodeIndex(id)!=RoutingGraph::noNode;
+    }
+
+    IndexPageRef page;
+    TileId       tile=TileId::GetTile(magnification,Point::GetCoordFromId(id));
+
+    return GetIndexPage(tile.AsPixel(),page) &&
+           page->nodeMap.find(id)!=page->nodeMap.end();
+  }
+
+  /**
+   * Return the ids of all route nodes, that are also contained in the other
+   * file, sorted. For adjacent databases these are the nodes at the border,
+   * where routes cross from one database to the other. Since the id of a
+   * route node encodes its coordinate, only the pages of tiles that are also
+   * covered by the other file are loaded.
+   *
+   * Method is thread-safe.
+   */
+  bool RouteNodeDataFile::GetSharedIds(const RouteNodeDataFile& other,
+                                       std::vector<Id>& ids) const
+  {
+    ids.clear();
+
+    if (graphLoaded) {
+      for (const auto& id : graph.GetNodeIds()) {
+        if (other.IsCovered(Point::GetCoordFromId(id)) &&
+            other.Contains(id)) {
+          ids.push_back(id);
+        }
+      }
+
+      std::sort(ids.begin(),ids.end());
+
+      return true;
+    }
+
+    for (const auto& entry : index) {
+      TileId tile(entry.first.x,entry.first.y);
+
+      if (!other.IsCovered(tile.GetBoundingBox(magnification))) {
+        continue;
+      }
+
+      IndexPageRef page;
+
+      if (!GetIndexPage(entry.first,
+                        page)) {
+        return false;
+      }
+
+      for (const auto& node : page->nodeMap) {
+        if (other.IsCovered(Point::GetCoordFromId(node.first)) &&
+            other.Contains(node.first)) {
+          ids.push_back(node.first);
+        }
+      }
+    }
+
+    std::sort(ids.begin(),ids.end());
+
+    return true;
+  }
+
+  /**
+   * Derive the predecessors without path back by reading all route nodes
+   * once. Pages are not loaded into the cache.
+   */
+  bool RouteNodeDataFile::LoadPredecessors() const
+  {
+    assert(IsOpen());
+
+    PredecessorCollector collector;
+
+    try {
+      std::lock_guard<std::mutex> lock(accessMutex);
+      RouteNode                   node;
+
+      for (const auto& entry : index) {
+        scanner.SetPos(entry.second.fileOffset);
+
+        for (uint32_t i=0; i<entry.second.count; i++) {
+          node.Read(scanner);
+          collector.Add(node);
+        }
+      }
+    }
+    catch (IOException& e) {
+      log.Error() << e.GetDescription();
       return false;
     }
 
-    node=cacheRef->value.find(scanner,
-                              id);
+    collector.Finish(predecessors);
+
+    log.Debug() << "Route nodes of '" << datafilename << "': " << predecessors.size() << " predecessor(s) without path back";
+
+    return true;
+  }
+
+  /**
+   * Append the route nodes, that have a path to the route node with the given
+   * id, for which the route node has no path back using the same object
+   * (e.g. the previous route node on a oneway way), together with the object
+   * of the path. Paths of the route node itself and these sources are all
+   * predecessors of the route node.
+   *
+   * The predecessors are derived from all route nodes on first call, if
+   * LoadGraph() has not been called before.
+   *
+   * Method is thread-safe.
+   */
+  bool RouteNodeDataFile::GetPredecessors(Id id,
+                                          std::vector<std::pair<Id,ObjectFileRef>>& sources) const
+  {
+    if (!predecessorsLoaded) {
+      std::lock_guard<std::mutex> lock(predecessorMutex);
+
+      if (!predecessorsLoaded) {
+        if (!LoadPredecessors()) {
+          return false;
+        }
+
+        predecessorsLoaded=true;
+      }
+    }
+
+    auto entry=std::lower_bound(predecessors.begin(),
+                                predecessors.end(),
+                                id,
+                                [](const Predecessor& predecessor,
+                                   Id id) {
+                                  return predecessor.target<id;
+                                });
+
+    while (entry!=predecessors.end() &&
+           entry->target==id) {
+      sources.emplace_back(entry->source,entry->object);
+      ++entry;
+    }
+
+    return true;
+  }
+
+  /**
+   * Limit the page cache by the given memory budget (in bytes) instead of
+   * by the number of pages. The cache is flushed.
+   *
+   * Method is thread-safe.
+   */
+  void RouteNodeDataFile::SetCacheMemory(size_t maxMemory)
+  {
+    cache.SetMaxMemory(maxMemory,
+                       std::make_shared<IndexPageValueSizer>());
+  }
+
+  /**
+   * Let the given governor control the memory budget of the page cache. The
+   * cache is flushed. The weight defines the initial share of the overall
+   * budget (see MemoryGovernor::Register()). The cache is unregistered on
+   * Close().
+   *
+   * Method is NOT thread-safe.
+   */
+  void RouteNodeDataFile::SetMemoryGovernor(const MemoryGovernorRef& governor,
+                                            double weight)
+  {
+    DetachMemoryGovernor();
+
+    cache.SetMaxMemory(0,
+                       std::make_shared<IndexPageValueSizer>());
 
-    return node!=nullptr;
+    memoryGovernor=governor;
+    memoryGovernor->Register(cache,
+                             datafile,
+                             weight);
+  }
+
+  void RouteNodeDataFile::DetachMemoryGovernor()
+  {
+    if (memoryGovernor) {
+      memoryGovernor->Unregister(cache);
+      memoryGovernor=nullptr;
+    }
   }
 
   Pixel RouteNodeDataFile::GetTile(const GeoCoord& coord) const
@@ -215,5 +598,20 @@ namespace osmscout {
   {
     return IsCovered(GetTile(coord));
   }
+
+  /**
+   * Return true, if any of the tiles intersecting the given bounding box
+   * contains route nodes
+   */
+  bool RouteNodeDataFile::IsCovered(const GeoBox& boundingBox) const
+  {
+    for (const auto& tile : TileIdBox(magnification,boundingBox)) {
+      if (IsCovered(tile.AsPixel())) {
+        return true;
+      }
+    }
+
+    return false;
+  }
 }
 
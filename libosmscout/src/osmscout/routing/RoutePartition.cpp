@@ -0,0 +1,945 @@
+/*
+  This source is part of the libosmscout library
+  Copyright (C) 2026  Tim Teulings
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307  USA
+*/
+
+#include <osmscout/routing/RoutePartition.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <functional>
+#include <queue>
+
+#include <osmscout/ObjectVariantDataFile.h>
+
+#include <osmscout/routing/RoutingService.h>
+
+#include <osmscout/util/File.h>
+#include <osmscout/util/FileScanner.h>
+#include <osmscout/util/FileWriter.h>
+#include <osmscout/util/Geometry.h>
+#include <osmscout/util/Logger.h>
+#include <osmscout/util/StopClock.h>
+#include <osmscout/util/WorkQueue.h>
+
+namespace osmscout {
+
+  namespace {
+    const double   infinity=std::numeric_limits<double>::infinity();
+    const uint32_t maxDepth=30;
+
+    using QueueEntry = std::pair<double,uint32_t>;
+    using Queue      = std::priority_queue<QueueEntry,
+                                           std::vector<QueueEntry>,
+                                           std::greater<>>;
+
+    /**
+     * Call the given function for all indexes in [0,count) using up to
+     * threadCount threads (including the calling thread).
+     */
+    void ParallelFor(size_t count,
+                     size_t threadCount,
+                     const std::function<void(size_t)>& function)
+    {
+      std::atomic<size_t> next(0);
+
+      // Each worker takes the next index, so uneven costs do not stall a thread
+      std::vector<std::function<bool()>> workers(std::max<size_t>(1,std::min(threadCount,count)),
+                                                 [&next,&function,count]() {
+        for (size_t i=next++; i<count; i=next++) {
+          function(i);
+        }
+
+        return true;
+      });
+
+      RunConcurrently(workers,
+                      workers.size());
+    }
+  }
+
+  const uint32_t RoutePartition::noNode;
+
+  RoutePartition::RoutePartition()
+  : levelCount(0),
+    bitsPerLevel(0)
+  {
+    // no code
+  }
+
+  /**
+   * Assign each node a cell at the lowest level by recursive bisection
+   * of the node coordinates at the median of the larger extent.
+   */
+  void RoutePartition::Partition(const std::vector<GeoCoord>& coords)
+  {
+    std::vector<uint32_t> order(coords.size());
+    uint32_t              depth=levelCount*bitsPerLevel;
+
+    for (uint32_t n=0; n<order.size(); n++) {
+      order[n]=n;
+    }
+
+    nodeCells.assign(coords.size(),0);
+
+    std::function<void(size_t,size_t,uint32_t,uint32_t)> split=[&](size_t begin,
+                                                                   size_t end,
+                                                                   uint32_t level,
+                                                                   uint32_t cell) {
+      if (level==depth ||
+          end-begin<=1) {
+        // Pad the cell id, so all nodes of a (small) subtree share the same leaf
+        for (size_t n=begin; n<end; n++) {
+          nodeCells[order[n]]=cell << (depth-level);
+        }
+
+        return;
+      }
+
+      double minLat=std::numeric_limits<double>::max();
+      double maxLat=std::numeric_limits<double>::lowest();
+      double minLon=std::numeric_limits<double>::max();
+      double maxLon=std::numeric_limits<double>::lowest();
+
+      for (size_t n=begin; n<end; n++) {
+        const GeoCoord& coord=coords[order[n]];
+
+        minLat=std::min(minLat,coord.GetLat());
+        maxLat=std::max(maxLat,coord.GetLat());
+        minLon=std::min(minLon,coord.GetLon());
+        maxLon=std::max(maxLon,coord.GetLon());
+      }
+
+      bool   byLat=maxLat-minLat>=(maxLon-minLon)*std::cos(DegToRad((minLat+maxLat)/2.0));
+      size_t middle=begin+(end-begin)/2;
+
+      std::nth_element(order.begin()+begin,
+                       order.begin()+middle,
+                       order.begin()+end,
+                       [&coords,byLat](uint32_t a, uint32_t b) {
+                         return byLat ? coords[a].GetLat()<coords[b].GetLat()
+                                      : coords[a].GetLon()<coords[b].GetLon();
+                       });
+
+      split(begin,middle,level+1,cell << 1);
+      split(middle,end,level+1,(cell << 1) | 1);
+    };
+
+    split(0,order.size(),0,0);
+  }
+
+  /**
+   * Calculate the boundary nodes of all cells of all levels.
+   */
+  void RoutePartition::SetupLevels()
+  {
+    uint32_t depth=levelCount*bitsPerLevel;
+
+    levels.clear();
+    levels.resize(levelCount);
+
+    for (size_t l=1; l<=levelCount; l++) {
+      Level&            level=levels[l-1];
+      uint32_t          cellCount=1u << (depth-(l-1)*bitsPerLevel);
+      std::vector<bool> isBoundary(nodeIds.size(),false);
+
+      for (uint32_t n=0; n<nodeIds.size(); n++) {
+        for (uint32_t p=pathOffsets[n]; p<pathOffsets[n+1]; p++) {
+          uint32_t target=pathTargets[p];
+
+          if (target!=noNode &&
+              GetCell(n,l)!=GetCell(target,l)) {
+            isBoundary[n]=true;
+            isBoundary[target]=true;
+          }
+        }
+      }
+
+      level.cellOffsets.assign(cellCount+1,0);
+      level.boundaryIndex.assign(nodeIds.size(),noNode);
+
+      for (uint32_t n=0; n<nodeIds.size(); n++) {
+        if (isBoundary[n]) {
+          level.cellOffsets[GetCell(n,l)+1]++;
+        }
+      }
+
+      for (uint32_t c=0; c<cellCount; c++) {
+        level.cellOffsets[c+1]+=level.cellOffsets[c];
+      }
+
+      std::vector<uint32_t> fill(level.cellOffsets.begin(),level.cellOffsets.end()-1);
+
+      level.boundaryNodes.resize(level.cellOffsets.back());
+
+      for (uint32_t n=0; n<nodeIds.size(); n++) {
+        if (isBoundary[n]) {
+          uint32_t cell=GetCell(n,l);
+
+          level.boundaryIndex[n]=fill[cell]-level.cellOffsets[cell];
+          level.boundaryNodes[fill[cell]++]=n;
+        }
+      }
+
+      level.matrixOffsets.assign(cellCount+1,0);
+
+      for (uint32_t c=0; c<cellCount; c++) {
+        size_t size=level.cellOffsets[c+1]-level.cellOffsets[c];
+
+        level.matrixOffsets[c+1]=level.matrixOffsets[c]+size*size;
+      }
+    }
+  }
+
+  /**
+   * Build the partition for the routing graph files with the given base name.
+   *
+   * @param cellSize
+   *    Maximum number of route nodes in a cell of the lowest level
+   * @param bitsPerLevel
+   *    Number of bisections between two levels
+   */
+  bool RoutePartition::Build(Progress& progress,
+                             const TypeConfig& typeConfig,
+                             const std::string& path,
+                             const std::string& filenamebase,
+                             size_t cellSize,
+                             uint8_t bitsPerLevel)
+  {
+    ObjectVariantDataFile              objectVariantDataFile;
+    FileScanner                        scanner;
+    std::vector<GeoCoord>              readCoords;
+    std::vector<Id>                    readIds;
+    std::vector<uint32_t>              readObjectOffsets;
+    std::vector<RouteNode::ObjectData> readObjects;
+    std::vector<uint32_t>              readPathOffsets;
+    std::vector<RouteNode::Path>       readPaths;
+
+    progress.SetAction("Loading routing graph");
+
+    if (!objectVariantDataFile.Load(typeConfig,
+                                    AppendFileToDir(path,
+                                                    RoutingService::GetData2Filename(filenamebase)))) {
+      progress.Error("Cannot load object variant data");
+      return false;
+    }
+
+    objectVariantData=objectVariantDataFile.GetData();
+
+    try {
+      FileOffset indexFileOffset;
+      uint32_t   dataCount;
+      uint32_t   tileMag;
+
+      scanner.Open(AppendFileToDir(path,
+                                   RoutingService::GetDataFilename(filenamebase)),
+                   FileScanner::Sequential,
+                   true);
+
+      scanner.Read(indexFileOffset);
+      scanner.Read(dataCount);
+      scanner.Read(tileMag);
+
+      readIds.reserve(dataCount);
+      readCoords.reserve(dataCount);
+      readObjectOffsets.reserve(dataCount+1);
+      readPathOffsets.reserve(dataCount+1);
+
+      for (uint32_t n=1; n<=dataCount; n++) {
+        RouteNode routeNode;
+
+        progress.SetProgress(n,dataCount);
+
+        routeNode.Read(scanner);
+
+        readIds.push_back(routeNode.GetId());
+        readCoords.push_back(routeNode.GetCoord());
+        readObjectOffsets.push_back(static_cast<uint32_t>(readObjects.size()));
+        readPathOffsets.push_back(static_cast<uint32_t>(readPaths.size()));
+        readObjects.insert(readObjects.end(),routeNode.objects.begin(),routeNode.objects.end());
+        readPaths.insert(readPaths.end(),routeNode.paths.begin(),routeNode.paths.end());
+      }
+
+      readObjectOffsets.push_back(static_cast<uint32_t>(readObjects.size()));
+      readPathOffsets.push_back(static_cast<uint32_t>(readPaths.size()));
+
+      scanner.Close();
+    }
+    catch (IOException& e) {
+      progress.Error(e.GetDescription());
+      scanner.CloseFailsafe();
+      return false;
+    }
+
+    progress.SetAction("Partitioning routing graph");
+
+    std::vector<uint32_t> order(readIds.size());
+    std::vector<GeoCoord> coords;
+
+    for (uint32_t n=0; n<order.size(); n++) {
+      order[n]=n;
+    }
+
+    std::sort(order.begin(),order.end(),[&readIds](uint32_t a, uint32_t b) {
+      return readIds[a]<readIds[b];
+    });
+
+    nodeIds.clear();
+    objectOffsets.clear();
+    objects.clear();
+    pathOffsets.clear();
+    paths.clear();
+
+    nodeIds.reserve(order.size());
+    coords.reserve(order.size());
+    objectOffsets.reserve(order.size()+1);
+    pathOffsets.reserve(order.size()+1);
+    objects.reserve(readObjects.size());
+    paths.reserve(readPaths.size());
+
+    for (uint32_t n : order) {
+      nodeIds.push_back(readIds[n]);
+      coords.push_back(readCoords[n]);
+      objectOffsets.push_back(static_cast<uint32_t>(objects.size()));
+      pathOffsets.push_back(static_cast<uint32_t>(paths.size()));
+      objects.insert(objects.end(),
+                     readObjects.begin()+readObjectOffsets[n],
+                     readObjects.begin()+readObjectOffsets[n+1]);
+      paths.insert(paths.end(),
+                   readPaths.begin()+readPathOffsets[n],
+                   readPaths.begin()+readPathOffsets[n+1]);
+    }
+
+    objectOffsets.push_back(static_cast<uint32_t>(objects.size()));
+    pathOffsets.push_back(static_cast<uint32_t>(paths.size()));
+
+    pathTargets.resize(paths.size());
+
+    for (size_t p=0; p<paths.size(); p++) {
+      pathTargets[p]=GetNodeIndex(paths[p].id);
+    }
+
+    // Number of bisections needed for the requested cell size, rounded up to full levels
+    uint32_t depth=0;
+
+    while (depth<maxDepth &&
+           (nodeIds.size() >> depth)>std::max<size_t>(1,cellSize)) {
+      depth++;
+    }
+
+    this->bitsPerLevel=std::max<uint8_t>(1,bitsPerLevel);
+    levelCount=static_cast<uint8_t>(std::max<uint32_t>(1,(depth+this->bitsPerLevel-1)/this->bitsPerLevel));
+
+    while (levelCount*this->bitsPerLevel>maxDepth) {
+      levelCount--;
+    }
+
+    Partition(coords);
+    SetupLevels();
+
+    progress.Info("Route nodes: "+std::to_string(nodeIds.size())+
+                  ", levels: "+std::to_string(levelCount));
+
+    for (size_t l=1; l<=levelCount; l++) {
+      progress.Info("Level "+std::to_string(l)+
+                    ": "+std::to_string(GetCellCount(l))+" cells, "+
+                    std::to_string(GetBoundaryNodeCount(l))+" boundary nodes");
+    }
+
+    return true;
+  }
+
+  bool RoutePartition::Load(const TypeConfig& typeConfig,
+                            const std::string& filename)
+  {
+    FileScanner scanner;
+
+    try {
+      uint32_t variantCount;
+      uint32_t nodeCount;
+      uint32_t objectCount;
+      uint32_t pathCount;
+
+      scanner.Open(filename,
+                   FileScanner::Sequential,
+                   true);
+
+      scanner.Read(levelCount);
+      scanner.Read(bitsPerLevel);
+      scanner.Read(variantCount);
+      scanner.Read(nodeCount);
+      scanner.Read(objectCount);
+      scanner.Read(pathCount);
+
+      objectVariantData.resize(variantCount);
+
+      for (auto& data : objectVariantData) {
+        data.Read(typeConfig,scanner);
+      }
+
+      nodeIds.resize(nodeCount);
+      nodeCells.resize(nodeCount);
+      objectOffsets.resize(nodeCount+1);
+      pathOffsets.resize(nodeCount+1);
+      objects.resize(objectCount);
+      paths.resize(pathCount);
+
+      Id       previousId=0;
+      uint32_t objectOffset=0;
+      uint32_t pathOffset=0;
+
+      for (uint32_t n=0; n<nodeCount; n++) {
+        Id      idDelta;
+        uint8_t nodeObjectCount;
+        uint8_t nodePathCount;
+
+        scanner.ReadNumber(idDelta);
+        scanner.ReadNumber(nodeCells[n]);
+        scanner.Read(nodeObjectCount);
+        scanner.Read(nodePathCount);
+
+        nodeIds[n]=previousId+idDelta;
+        previousId=nodeIds[n];
+
+        objectOffsets[n]=objectOffset;
+        pathOffsets[n]=pathOffset;
+        objectOffset+=nodeObjectCount;
+        pathOffset+=nodePathCount;
+      }
+
+      objectOffsets[nodeCount]=objectOffset;
+      pathOffsets[nodeCount]=pathOffset;
+
+      if (objectOffset!=objectCount ||
+          pathOffset!=pathCount) {
+        throw IOException(filename,"Cannot load route partition","Inconsistent object or path count");
+      }
+
+      for (auto& object : objects) {
+        scanner.Read(object.object);
+        scanner.Read(object.objectVariantIndex);
+      }
+
+      for (auto& path : paths) {
+        uint32_t distanceValue;
+
+        scanner.Read(path.id);
+        scanner.Read(path.objectIndex);
+        scanner.Read(path.flags);
+        scanner.ReadNumber(distanceValue);
+
+        path.distance=Distance::Of<Kilometer>(distanceValue/(1000.0*100.0));
+      }
+
+      scanner.Close();
+    }
+    catch (IOException& e) {
+      log.Error() << e.GetDescription();
+      scanner.CloseFailsafe();
+      return false;
+    }
+
+    pathTargets.resize(paths.size());
+
+    for (size_t p=0; p<paths.size(); p++) {
+      pathTargets[p]=GetNodeIndex(paths[p].id);
+    }
+
+    SetupLevels();
+
+    return true;
+  }
+
+  bool RoutePartition::Store(const std::string& filename) const
+  {
+    FileWriter writer;
+
+    try {
+      Id previousId=0;
+
+      writer.Open(filename);
+
+      writer.Write(levelCount);
+      writer.Write(bitsPerLevel);
+      writer.Write(static_cast<uint32_t>(objectVariantData.size()));
+      writer.Write(static_cast<uint32_t>(nodeIds.size()));
+      writer.Write(static_cast<uint32_t>(objects.size()));
+      writer.Write(static_cast<uint32_t>(paths.size()));
+
+      for (const auto& data : objectVariantData) {
+        data.Write(writer);
+      }
+
+      for (uint32_t n=0; n<nodeIds.size(); n++) {
+        writer.WriteNumber(nodeIds[n]-previousId);
+        writer.WriteNumber(nodeCells[n]);
+        writer.Write(static_cast<uint8_t>(objectOffsets[n+1]-objectOffsets[n]));
+        writer.Write(static_cast<uint8_t>(pathOffsets[n+1]-pathOffsets[n]));
+
+        previousId=nodeIds[n];
+      }
+
+      for (const auto& object : objects) {
+        writer.Write(object.object);
+        writer.Write(object.objectVariantIndex);
+      }
+
+      for (const auto& path : paths) {
+        writer.Write(path.id);
+        writer.Write(path.objectIndex);
+        writer.Write(path.flags);
+        writer.WriteNumber(static_cast<uint32_t>(floor(path.distance.As<Kilometer>()*(1000.0*100.0)+0.5)));
+      }
+
+      writer.Close();
+    }
+    catch (IOException& e) {
+      log.Error() << e.GetDescription();
+      writer.CloseFailsafe();
+      return false;
+    }
+
+    return true;
+  }
+
+  size_t RoutePartition::GetCellCount(size_t level) const
+  {
+    return levels[level-1].cellOffsets.size()-1;
+  }
+
+  size_t RoutePartition::GetBoundaryNodeCount(size_t level) const
+  {
+    return levels[level-1].boundaryNodes.size();
+  }
+
+  /**
+   * Return the index of the node with the given id or noNode, if the node
+   * is not part of the partition.
+   */
+  uint32_t RoutePartition::GetNodeIndex(Id id) const
+  {
+    auto entry=std::lower_bound(nodeIds.begin(),nodeIds.end(),id);
+
+    if (entry==nodeIds.end() ||
+        *entry!=id) {
+      return noNode;
+    }
+
+    return static_cast<uint32_t>(entry-nodeIds.begin());
+  }
+
+  /**
+   * Dijkstra from 'from' restricted to the given cell of the given level.
+   *
+   * On level 1 all nodes of the cell are visited using the paths. On higher
+   * levels only the boundary nodes of the subcells are visited, using the
+   * cliques of the subcells and the paths between subcells.
+   *
+   * If 'to' is not noNode, the search stops as soon as 'to' is settled.
+   */
+  void RoutePartition::SearchCell(const Metric& metric,
+                                  size_t level,
+                                  uint32_t cell,
+                                  uint32_t from,
+                                  uint32_t to,
+                                  Labels& labels) const
+  {
+    Queue queue;
+
+    labels.clear();
+    labels[from]=Label{0.0,noNode,noNode,0};
+    queue.emplace(0.0,from);
+
+    auto relax=[&labels,&queue](uint32_t node,
+                                uint32_t target,
+                                double cost,
+                                uint32_t path,
+                                uint8_t cliqueLevel) {
+      auto entry=labels.find(target);
+
+      if (entry==labels.end() ||
+          cost<entry->second.cost) {
+        labels[target]=Label{cost,node,path,cliqueLevel};
+        queue.emplace(cost,target);
+      }
+    };
+
+    while (!queue.empty()) {
+      auto [cost,node]=queue.top();
+
+      queue.pop();
+
+      if (cost>labels[node].cost) {
+        continue;
+      }
+
+      if (node==to) {
+        return;
+      }
+
+      if (level==1) {
+        for (uint32_t p=pathOffsets[node]; p<pathOffsets[node+1]; p++) {
+          uint32_t target=pathTargets[p];
+
+          if (target!=noNode &&
+              std::isfinite(metric.pathCosts[p]) &&
+              GetCell(target,1)==cell) {
+            relax(node,target,cost+metric.pathCosts[p],p,0);
+          }
+        }
+
+        continue;
+      }
+
+      const Level& subLevel=levels[level-2];
+      uint32_t     subCell=GetCell(node,level-1);
+      uint32_t     first=subLevel.cellOffsets[subCell];
+      size_t       size=subLevel.cellOffsets[subCell+1]-first;
+      size_t       row=subLevel.matrixOffsets[subCell]+subLevel.boundaryIndex[node]*size;
+
+      for (size_t b=0; b<size; b++) {
+        double cliqueCost=metric.cliqueCosts[level-2][row+b];
+
+        if (std::isfinite(cliqueCost)) {
+          relax(node,subLevel.boundaryNodes[first+b],cost+cliqueCost,noNode,static_cast<uint8_t>(level-1));
+        }
+      }
+
+      for (uint32_t p=pathOffsets[node]; p<pathOffsets[node+1]; p++) {
+        uint32_t target=pathTargets[p];
+
+        if (target!=noNode &&
+            std::isfinite(metric.pathCosts[p]) &&
+            GetCell(target,level)==cell &&
+            GetCell(target,level-1)!=subCell) {
+          relax(node,target,cost+metric.pathCosts[p],p,0);
+        }
+      }
+    }
+  }
+
+  void RoutePartition::CustomizeCell(Metric& metric,
+                                     size_t level,
+                                     uint32_t cell) const
+  {
+    const Level& currentLevel=levels[level-1];
+    uint32_t     first=currentLevel.cellOffsets[cell];
+    size_t       size=currentLevel.cellOffsets[cell+1]-first;
+    size_t       offset=currentLevel.matrixOffsets[cell];
+    Labels       labels;
+
+    for (size_t i=0; i<size; i++) {
+      SearchCell(metric,
+                 level,
+                 cell,
+                 currentLevel.boundaryNodes[first+i],
+                 noNode,
+                 labels);
+
+      for (size_t j=0; j<size; j++) {
+        auto entry=labels.find(currentLevel.boundaryNodes[first+j]);
+
+        metric.cliqueCosts[level-1][offset+i*size+j]=entry!=labels.end() ? entry->second.cost : infinity;
+      }
+    }
+  }
+
+  /**
+   * Calculate the costs of all paths and all cliques for the given profile.
+   * Paths and the cells of each level are processed by up to threadCount threads.
+   */
+  RoutePartition::MetricRef RoutePartition::Customize(const RoutingProfile& profile,
+                                                      size_t threadCount) const
+  {
+    const size_t chunkSize=1024;
+    MetricRef    metric=std::make_shared<Metric>();
+    Vehicle      vehicle=profile.GetVehicle();
+    StopClock    clock;
+
+    metric->vehicle=vehicle;
+    metric->costParameters=profile.GetCostParameters();
+    metric->pathCosts.assign(paths.size(),infinity);
+    metric->cliqueCosts.resize(levelCount);
+
+    ParallelFor((nodeIds.size()+chunkSize-1)/chunkSize,
+                threadCount,
+                [this,&metric,&profile,vehicle,chunkSize](size_t chunk) {
+      RouteNode routeNode;
+      size_t    end=std::min(nodeIds.size(),(chunk+1)*chunkSize);
+
+      for (size_t n=chunk*chunkSize; n<end; n++) {
+        routeNode.objects.assign(objects.begin()+objectOffsets[n],
+                                 objects.begin()+objectOffsets[n+1]);
+        routeNode.paths.assign(paths.begin()+pathOffsets[n],
+                               paths.begin()+pathOffsets[n+1]);
+
+        for (size_t p=0; p<routeNode.paths.size(); p++) {
+          const RouteNode::Path& routePath=routeNode.paths[p];
+
+          if (routePath.id==nodeIds[n] ||
+              routePath.IsRestricted(vehicle) ||
+              !profile.CanUse(routeNode,objectVariantData,p)) {
+            continue;
+          }
+
+          metric->pathCosts[pathOffsets[n]+p]=profile.GetCosts(routeNode,objectVariantData,p,p);
+        }
+      }
+    });
+
+    for (size_t l=1; l<=levelCount; l++) {
+      metric->cliqueCosts[l-1].assign(levels[l-1].matrixOffsets.back(),infinity);
+
+      ParallelFor(GetCellCount(l),
+                  threadCount,
+                  [this,&metric,l](size_t cell) {
+        CustomizeCell(*metric,l,static_cast<uint32_t>(cell));
+      });
+    }
+
+    clock.Stop();
+
+    log.Debug() << "Customizing route partition took " << clock.ResultString();
+
+    return metric;
+  }
+
+  /**
+   * Append the paths of the clique between the boundary nodes 'from' and 'to'
+   * of the cell of the given level to steps.
+   */
+  bool RoutePartition::UnpackClique(const Metric& metric,
+                                    size_t level,
+                                    uint32_t from,
+                                    uint32_t to,
+                                    std::vector<Step>& steps) const
+  {
+    Labels labels;
+
+    SearchCell(metric,
+               level,
+               GetCell(from,level),
+               from,
+               to,
+               labels);
+
+    if (labels.find(to)==labels.end()) {
+      return false;
+    }
+
+    std::vector<std::pair<uint32_t,Label>> hops;
+
+    for (uint32_t node=to; node!=from; node=labels[node].parent) {
+      hops.emplace_back(node,labels[node]);
+    }
+
+    for (auto hop=hops.rbegin(); hop!=hops.rend(); ++hop) {
+      const Label& label=hop->second;
+
+      if (label.path!=noNode) {
+        steps.push_back(Step{nodeIds[hop->first],
+                             objects[objectOffsets[label.parent]+paths[label.path].objectIndex].object});
+      }
+      else if (!UnpackClique(metric,label.level,label.parent,hop->first,steps)) {
+        return false;
+      }
+    }
+
+    return true;
+  }
+
+  /**
+   * Calculate the cheapest route from one of the sources to one of the
+   * targets using the given metric.
+   */
+  bool RoutePartition::CalculateRoute(const Metric& metric,
+                                      const std::vector<Endpoint>& sources,
+                                      const std::vector<Endpoint>& targets,
+                                      Route& route) const
+  {
+    std::vector<std::vector<uint32_t>> endpointCells(levelCount+1);
+    std::unordered_map<uint32_t,double> targetCosts;
+    Labels                              labels;
+    Queue                               queue;
+
+    route=Route();
+
+    auto addEndpointCells=[this,&endpointCells](uint32_t node) {
+      for (size_t l=1; l<=levelCount; l++) {
+        endpointCells[l].push_back(GetCell(node,l));
+      }
+    };
+
+    for (const auto& source : sources) {
+      uint32_t node=GetNodeIndex(source.id);
+
+      if (node==noNode) {
+        continue;
+      }
+
+      auto entry=labels.find(node);
+
+      if (entry==labels.end() ||
+          source.cost<entry->second.cost) {
+        labels[node]=Label{source.cost,noNode,noNode,0};
+        queue.emplace(source.cost,node);
+      }
+
+      addEndpointCells(node);
+    }
+
+    for (const auto& target : targets) {
+      uint32_t node=GetNodeIndex(target.id);
+
+      if (node==noNode) {
+        continue;
+      }
+
+      auto entry=targetCosts.find(node);
+
+      if (entry==targetCosts.end() ||
+          target.cost<entry->second) {
+        targetCosts[node]=target.cost;
+      }
+
+      addEndpointCells(node);
+    }
+
+    // Highest level, whose cell of the node contains neither a source nor a target
+    auto getQueryLevel=[this,&endpointCells](uint32_t node) {
+      for (size_t l=1; l<=levelCount; l++) {
+        uint32_t cell=GetCell(node,l);
+
+        if (std::find(endpointCells[l].begin(),endpointCells[l].end(),cell)!=endpointCells[l].end()) {
+          return l-1;
+        }
+      }
+
+      return static_cast<size_t>(levelCount);
+    };
+
+    auto relax=[&labels,&queue](uint32_t node,
+                                uint32_t target,
+                                double cost,
+                                uint32_t path,
+                                uint8_t cliqueLevel) {
+      auto entry=labels.find(target);
+
+      if (entry==labels.end() ||
+          cost<entry->second.cost) {
+        labels[target]=Label{cost,node,path,cliqueLevel};
+        queue.emplace(cost,target);
+      }
+    };
+
+    double   bestCost=infinity;
+    uint32_t bestTarget=noNode;
+
+    while (!queue.empty() &&
+           queue.top().first<bestCost) {
+      auto [cost,node]=queue.top();
+
+      queue.pop();
+
+      if (cost>labels[node].cost) {
+        continue;
+      }
+
+      route.settled++;
+
+      auto target=targetCosts.find(node);
+
+      if (target!=targetCosts.end() &&
+          cost+target->second<bestCost) {
+        bestCost=cost+target->second;
+        bestTarget=node;
+      }
+
+      size_t level=getQueryLevel(node);
+
+      if (level==0) {
+        for (uint32_t p=pathOffsets[node]; p<pathOffsets[node+1]; p++) {
+          if (pathTargets[p]!=noNode &&
+              std::isfinite(metric.pathCosts[p])) {
+            relax(node,pathTargets[p],cost+metric.pathCosts[p],p,0);
+          }
+        }
+
+        continue;
+      }
+
+      const Level& currentLevel=levels[level-1];
+      uint32_t     cell=GetCell(node,level);
+      uint32_t     first=currentLevel.cellOffsets[cell];
+      size_t       size=currentLevel.cellOffsets[cell+1]-first;
+
+      // Nodes are entered via paths crossing cell borders, so they are boundary nodes
+      if (currentLevel.boundaryIndex[node]!=noNode) {
+        size_t row=currentLevel.matrixOffsets[cell]+currentLevel.boundaryIndex[node]*size;
+
+        for (size_t b=0; b<size; b++) {
+          double cliqueCost=metric.cliqueCosts[level-1][row+b];
+
+          if (std::isfinite(cliqueCost)) {
+            relax(node,currentLevel.boundaryNodes[first+b],cost+cliqueCost,noNode,static_cast<uint8_t>(level));
+          }
+        }
+      }
+
+      for (uint32_t p=pathOffsets[node]; p<pathOffsets[node+1]; p++) {
+        uint32_t pathTarget=pathTargets[p];
+
+        if (pathTarget!=noNode &&
+            std::isfinite(metric.pathCosts[p]) &&
+            GetCell(pathTarget,level)!=cell) {
+          relax(node,pathTarget,cost+metric.pathCosts[p],p,0);
+        }
+      }
+    }
+
+    if (bestTarget==noNode) {
+      return false;
+    }
+
+    std::vector<std::pair<uint32_t,Label>> hops;
+    uint32_t                               node=bestTarget;
+
+    while (labels[node].parent!=noNode) {
+      hops.emplace_back(node,labels[node]);
+      node=labels[node].parent;
+    }
+
+    route.cost=bestCost;
+    route.source=nodeIds[node];
+    route.target=nodeIds[bestTarget];
+
+    for (auto hop=hops.rbegin(); hop!=hops.rend(); ++hop) {
+      const Label& label=hop->second;
+
+      if (label.path!=noNode) {
+        route.steps.push_back(Step{nodeIds[hop->first],
+                                   objects[objectOffsets[label.parent]+paths[label.path].objectIndex].object});
+      }
+      else if (!UnpackClique(metric,label.level,label.parent,hop->first,route.steps)) {
+        return false;
+      }
+    }
+
+    return true;
+  }
+}
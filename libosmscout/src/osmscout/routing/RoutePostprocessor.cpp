@@ -23,30 +23,85 @@
 
 #include <osmscout/util/Geometry.h>
 #include <osmscout/util/Logger.h>
+#include <osmscout/util/WorkQueue.h>
 
 #include <osmscout/LocationDescriptionService.h>
 
+#include <algorithm>
 #include <iostream>
 #include <string_view>
 
 namespace osmscout {
 
+  namespace {
+    const double junctionDelta=1E-7;
+
+    GeoBox GetJunctionBox(const GeoCoord& coord)
+    {
+      return GeoBox(GeoCoord(coord.GetLat()-junctionDelta,coord.GetLon()-junctionDelta),
+                    GeoCoord(coord.GetLat()+junctionDelta,coord.GetLon()+junctionDelta));
+    }
+
+    NodeRef FindJunction(const std::vector<NodeRef>& nodes,
+                         const GeoCoord& coord)
+    {
+      for (const auto& node : nodes) {
+        if (fabs(node->GetCoords().GetLat() - coord.GetLat()) < junctionDelta &&
+            fabs(node->GetCoords().GetLon() - coord.GetLon()) < junctionDelta) {
+          return node;
+        }
+      }
+
+      return nullptr;
+    }
+  }
+
   RoutePostprocessor::Postprocessor::~Postprocessor()
   {
     // no code
   }
 
+  bool RoutePostprocessor::Postprocessor::CanRunConcurrently() const
+  {
+    return false;
+  }
+
+  std::set<std::string> RoutePostprocessor::Postprocessor::GetRequiredDescriptions() const
+  {
+    return {};
+  }
+
+  std::set<std::string> RoutePostprocessor::Postprocessor::GetProvidedDescriptions() const
+  {
+    return {};
+  }
+
+  bool RoutePostprocessor::Postprocessor::NeedsJunctions() const
+  {
+    return false;
+  }
+
   RoutePostprocessor::StartPostprocessor::StartPostprocessor(const std::string& startDescription)
   : startDescription(startDescription)
   {
     // no code
   }
 
+  bool RoutePostprocessor::StartPostprocessor::CanRunConcurrently() const
+  {
+    return true;
+  }
+
+  std::set<std::string> RoutePostprocessor::StartPostprocessor::GetProvidedDescriptions() const
+  {
+    return {RouteDescription::NODE_START_DESC};
+  }
+
   bool RoutePostprocessor::StartPostprocessor::Process(const RoutePostprocessor& /*postprocessor*/,
                                                        RouteDescription& description)
   {
     if (!description.Nodes().empty()) {
-      description.Nodes().front().AddDescription(RouteDescription::NODE_START_DESC,
+      description.Nodes().front().AddDescription(RouteDescription::DescriptionSlot::NodeStart,
                                                  std::make_shared<RouteDescription::StartDescription>(startDescription));
     }
 
@@ -59,11 +114,21 @@ namespace osmscout {
     // no code
   }
 
+  bool RoutePostprocessor::TargetPostprocessor::CanRunConcurrently() const
+  {
+    return true;
+  }
+
+  std::set<std::string> RoutePostprocessor::TargetPostprocessor::GetProvidedDescriptions() const
+  {
+    return {RouteDescription::NODE_TARGET_DESC};
+  }
+
   bool RoutePostprocessor::TargetPostprocessor::Process(const RoutePostprocessor& /*postprocessor*/,
                                                         RouteDescription& description)
   {
     if (!description.Nodes().empty()) {
-      description.Nodes().back().AddDescription(RouteDescription::NODE_TARGET_DESC,
+      description.Nodes().back().AddDescription(RouteDescription::DescriptionSlot::NodeTarget,
                                                 std::make_shared<RouteDescription::TargetDescription>(targetDescription));
     }
 
@@ -152,6 +217,16 @@ namespace osmscout {
     return true;
   }
 
+  bool RoutePostprocessor::WayNamePostprocessor::CanRunConcurrently() const
+  {
+    return true;
+  }
+
+  std::set<std::string> RoutePostprocessor::WayNamePostprocessor::GetProvidedDescriptions() const
+  {
+    return {RouteDescription::WAY_NAME_DESC};
+  }
+
   bool RoutePostprocessor::WayNamePostprocessor::Process(const RoutePostprocessor& postprocessor,
                                                          RouteDescription& description)
   {
@@ -170,7 +245,7 @@ namespace osmscout {
       if (node->GetPathObject().GetType()==refArea) {
         RouteDescription::NameDescriptionRef nameDesc=postprocessor.GetNameDescription(*node);
 
-        node->AddDescription(RouteDescription::WAY_NAME_DESC,
+        node->AddDescription(RouteDescription::DescriptionSlot::WayName,
                              nameDesc);
       }
       else if (node->GetPathObject().GetType()==refWay) {
@@ -183,7 +258,7 @@ namespace osmscout {
 
           lastNode--;
 
-          RouteDescription::DescriptionRef lastDescription=lastNode->GetDescription(RouteDescription::WAY_NAME_DESC);
+          RouteDescription::DescriptionRef lastDescription=lastNode->GetDescription(RouteDescription::DescriptionSlot::WayName);
           RouteDescription::NameDescriptionRef lastDesc=std::dynamic_pointer_cast<RouteDescription::NameDescription>(lastDescription);
 
 
@@ -194,7 +269,7 @@ namespace osmscout {
           }
         }
 
-        node->AddDescription(RouteDescription::WAY_NAME_DESC,
+        node->AddDescription(RouteDescription::DescriptionSlot::WayName,
                              nameDesc);
       }
     }
@@ -202,6 +277,16 @@ namespace osmscout {
     return true;
   }
 
+  bool RoutePostprocessor::WayTypePostprocessor::CanRunConcurrently() const
+  {
+    return true;
+  }
+
+  std::set<std::string> RoutePostprocessor::WayTypePostprocessor::GetProvidedDescriptions() const
+  {
+    return {RouteDescription::WAY_TYPE_NAME_DESC};
+  }
+
   bool RoutePostprocessor::WayTypePostprocessor::Process(const RoutePostprocessor& postprocessor,
                                                          RouteDescription& description)
   {
@@ -219,14 +304,14 @@ namespace osmscout {
         AreaRef                                  area=postprocessor.GetArea(node.GetDBFileOffset());
         RouteDescription::TypeNameDescriptionRef typeNameDesc=std::make_shared<RouteDescription::TypeNameDescription>(area->GetType()->GetName());
 
-        node.AddDescription(RouteDescription::WAY_TYPE_NAME_DESC,
+        node.AddDescription(RouteDescription::DescriptionSlot::WayTypeName,
                              typeNameDesc);
       }
       else if (node.GetPathObject().GetType()==refWay) {
         WayRef                                   way=postprocessor.GetWay(node.GetDBFileOffset());
         RouteDescription::TypeNameDescriptionRef typeNameDesc=std::make_shared<RouteDescription::TypeNameDescription>(way->GetType()->GetName());
 
-        node.AddDescription(RouteDescription::WAY_TYPE_NAME_DESC,
+        node.AddDescription(RouteDescription::DescriptionSlot::WayTypeName,
                              typeNameDesc);
       }
     }
@@ -269,6 +354,16 @@ namespace osmscout {
     }
   }
 
+  bool RoutePostprocessor::CrossingWaysPostprocessor::CanRunConcurrently() const
+  {
+    return true;
+  }
+
+  std::set<std::string> RoutePostprocessor::CrossingWaysPostprocessor::GetProvidedDescriptions() const
+  {
+    return {RouteDescription::CROSSING_WAYS_DESC};
+  }
+
   bool RoutePostprocessor::CrossingWaysPostprocessor::Process(const RoutePostprocessor& postprocessor,
                                                               RouteDescription& description)
   {
@@ -348,7 +443,7 @@ namespace osmscout {
                                   lastNode->GetPathObject(),
                                   node->GetPathObject());
 
-      node->AddDescription(RouteDescription::CROSSING_WAYS_DESC,
+      node->AddDescription(RouteDescription::DescriptionSlot::CrossingWays,
                            desc);
 
       lastNode=node;
@@ -366,10 +461,20 @@ namespace osmscout {
   const Distance RoutePostprocessor::DirectionPostprocessor::curveMaxDistance=Distance::Of<Kilometer>(0.300);
   const double RoutePostprocessor::DirectionPostprocessor::curveMinAngle=5.0;
 
+  bool RoutePostprocessor::DirectionPostprocessor::CanRunConcurrently() const
+  {
+    return true;
+  }
+
+  std::set<std::string> RoutePostprocessor::DirectionPostprocessor::GetProvidedDescriptions() const
+  {
+    return {RouteDescription::DIRECTION_DESC};
+  }
+
   bool RoutePostprocessor::DirectionPostprocessor::Process(const RoutePostprocessor& postprocessor,
                                                            RouteDescription& description)
   {
-    std::list<RouteDescription::Node>::const_iterator prevNode=description.Nodes().end();
+    std::vector<RouteDescription::Node>::const_iterator prevNode=description.Nodes().end();
     for (auto node=description.Nodes().begin();
          node!=description.Nodes().end();
          prevNode=node++) {
@@ -452,7 +557,7 @@ namespace osmscout {
           }
         }
 
-        node->AddDescription(RouteDescription::DIRECTION_DESC,
+        node->AddDescription(RouteDescription::DescriptionSlot::Direction,
                              std::make_shared<RouteDescription::DirectionDescription>(turnAngle,curveAngle));
       }
     }
@@ -460,6 +565,21 @@ namespace osmscout {
     return true;
   }
 
+  bool RoutePostprocessor::MotorwayJunctionPostprocessor::CanRunConcurrently() const
+  {
+    return true;
+  }
+
+  std::set<std::string> RoutePostprocessor::MotorwayJunctionPostprocessor::GetProvidedDescriptions() const
+  {
+    return {RouteDescription::MOTORWAY_JUNCTION_DESC};
+  }
+
+  bool RoutePostprocessor::MotorwayJunctionPostprocessor::NeedsJunctions() const
+  {
+    return true;
+  }
+
   bool RoutePostprocessor::MotorwayJunctionPostprocessor::Process(const RoutePostprocessor& postprocessor,
                                                                   RouteDescription& description)
   {
@@ -517,7 +637,7 @@ namespace osmscout {
        if (!junctionName.empty() || !junctionRef.empty()) {
          RouteDescription::NameDescriptionRef nameDescription=std::make_shared<RouteDescription::NameDescription>(junctionName,
                                                                                                                   junctionRef);
-         node.AddDescription(RouteDescription::MOTORWAY_JUNCTION_DESC,
+         node.AddDescription(RouteDescription::DescriptionSlot::MotorwayJunction,
                              std::make_shared<RouteDescription::MotorwayJunctionDescription>(nameDescription));
        }
 
@@ -528,6 +648,16 @@ namespace osmscout {
      return true;
   }
 
+  bool RoutePostprocessor::DestinationPostprocessor::CanRunConcurrently() const
+  {
+    return true;
+  }
+
+  std::set<std::string> RoutePostprocessor::DestinationPostprocessor::GetProvidedDescriptions() const
+  {
+    return {RouteDescription::CROSSING_DESTINATION_DESC};
+  }
+
   bool RoutePostprocessor::DestinationPostprocessor::Process(const RoutePostprocessor& postprocessor,
                                                              RouteDescription& description)
   {
@@ -555,7 +685,7 @@ namespace osmscout {
         if (lastJunction!=description.Nodes().end()){
           RouteDescription::DestinationDescriptionRef dest=postprocessor.GetDestination(*node);
           if (dest){
-            lastJunction->AddDescription(RouteDescription::CROSSING_DESTINATION_DESC,
+            lastJunction->AddDescription(RouteDescription::DescriptionSlot::CrossingDestination,
                                          dest);
           }
         }
@@ -568,6 +698,16 @@ namespace osmscout {
     return true;
   }
 
+  bool RoutePostprocessor::MaxSpeedPostprocessor::CanRunConcurrently() const
+  {
+    return true;
+  }
+
+  std::set<std::string> RoutePostprocessor::MaxSpeedPostprocessor::GetProvidedDescriptions() const
+  {
+    return {RouteDescription::WAY_MAXSPEED_DESC};
+  }
+
   bool RoutePostprocessor::MaxSpeedPostprocessor::Process(const RoutePostprocessor& postprocessor,
                                                           RouteDescription& description)
   {
@@ -590,7 +730,7 @@ namespace osmscout {
         }
 
         if (speed!=0) {
-          node.AddDescription(RouteDescription::WAY_MAXSPEED_DESC,
+          node.AddDescription(RouteDescription::DescriptionSlot::WayMaxSpeed,
                               std::make_shared<RouteDescription::MaxSpeedDescription>(speed));
         }
 
@@ -640,14 +780,14 @@ namespace osmscout {
 
     RouteDescription::RoundaboutEnterDescriptionRef desc=std::make_shared<RouteDescription::RoundaboutEnterDescription>(roundaboutClockwise);
 
-    node.AddDescription(RouteDescription::ROUNDABOUT_ENTER_DESC,
+    node.AddDescription(RouteDescription::DescriptionSlot::RoundaboutEnter,
                         desc);
   }
 
   void RoutePostprocessor::InstructionPostprocessor::HandleRoundaboutNode(RouteDescription::Node& node)
   {
-    if (node.HasDescription(RouteDescription::CROSSING_WAYS_DESC)) {
-      RouteDescription::CrossingWaysDescriptionRef crossing=std::dynamic_pointer_cast<RouteDescription::CrossingWaysDescription>(node.GetDescription(RouteDescription::CROSSING_WAYS_DESC));
+    if (node.HasDescription(RouteDescription::DescriptionSlot::CrossingWays)) {
+      RouteDescription::CrossingWaysDescriptionRef crossing=node.GetDescription<RouteDescription::CrossingWaysDescription>(RouteDescription::DescriptionSlot::CrossingWays);
 
       if (crossing->GetExitCount()>1) {
         roundaboutCrossingCounter+=crossing->GetExitCount()-1;
@@ -659,7 +799,7 @@ namespace osmscout {
   {
     RouteDescription::RoundaboutLeaveDescriptionRef desc=std::make_shared<RouteDescription::RoundaboutLeaveDescription>(roundaboutCrossingCounter, roundaboutClockwise);
 
-    node.AddDescription(RouteDescription::ROUNDABOUT_LEAVE_DESC,
+    node.AddDescription(RouteDescription::DescriptionSlot::RoundaboutLeave,
                         desc);
   }
 
@@ -668,7 +808,7 @@ namespace osmscout {
   {
     RouteDescription::MotorwayEnterDescriptionRef desc=std::make_shared<RouteDescription::MotorwayEnterDescription>(toName);
 
-    node.AddDescription(RouteDescription::MOTORWAY_ENTER_DESC,
+    node.AddDescription(RouteDescription::DescriptionSlot::MotorwayEnter,
                         desc);
   }
 
@@ -677,13 +817,13 @@ namespace osmscout {
   {
     RouteDescription::MotorwayLeaveDescriptionRef desc=std::make_shared<RouteDescription::MotorwayLeaveDescription>(fromName);
 
-    node.AddDescription(RouteDescription::MOTORWAY_LEAVE_DESC,
+    node.AddDescription(RouteDescription::DescriptionSlot::MotorwayLeave,
                         desc);
   }
 
-  bool RoutePostprocessor::InstructionPostprocessor::HandleNameChange(const std::list<RouteDescription::Node>& path,
-                                                                      std::list<RouteDescription::Node>::const_iterator& lastNode,
-                                                                      std::list<RouteDescription::Node>::iterator& node)
+  bool RoutePostprocessor::InstructionPostprocessor::HandleNameChange(const std::vector<RouteDescription::Node>& path,
+                                                                      std::vector<RouteDescription::Node>::const_iterator& lastNode,
+                                                                      std::vector<RouteDescription::Node>::iterator& node)
   {
     RouteDescription::NameDescriptionRef nextName;
     RouteDescription::NameDescriptionRef lastName;
@@ -692,8 +832,8 @@ namespace osmscout {
       return false;
     }
 
-    lastName=std::dynamic_pointer_cast<RouteDescription::NameDescription>(lastNode->GetDescription(RouteDescription::WAY_NAME_DESC));
-    nextName=std::dynamic_pointer_cast<RouteDescription::NameDescription>(node->GetDescription(RouteDescription::WAY_NAME_DESC));
+    lastName=lastNode->GetDescription<RouteDescription::NameDescription>(RouteDescription::DescriptionSlot::WayName);
+    nextName=node->GetDescription<RouteDescription::NameDescription>(RouteDescription::DescriptionSlot::WayName);
 
     // Nothing changed
     if (lastName->GetName()==nextName->GetName() &&
@@ -721,21 +861,21 @@ namespace osmscout {
       return false;
     }
 
-    node->AddDescription(RouteDescription::WAY_NAME_CHANGED_DESC,
+    node->AddDescription(RouteDescription::DescriptionSlot::WayNameChanged,
                          std::make_shared<RouteDescription::NameChangedDescription>(lastName,
                                                                                     nextName));
 
     return true;
   }
 
-  bool RoutePostprocessor::InstructionPostprocessor::HandleDirectionChange(const std::list<RouteDescription::Node>& path,
-                                                                           std::list<RouteDescription::Node>::iterator& node)
+  bool RoutePostprocessor::InstructionPostprocessor::HandleDirectionChange(const std::vector<RouteDescription::Node>& path,
+                                                                           std::vector<RouteDescription::Node>::iterator& node)
   {
     if (node->GetObjects().size()<=1){
       return false;
     }
 
-    std::list<RouteDescription::Node>::const_iterator lastNode=node;
+    std::vector<RouteDescription::Node>::const_iterator lastNode=node;
     RouteDescription::NameDescriptionRef              nextName;
     RouteDescription::NameDescriptionRef              lastName;
 
@@ -745,10 +885,10 @@ namespace osmscout {
       return false;
     }
 
-    lastName=std::dynamic_pointer_cast<RouteDescription::NameDescription>(lastNode->GetDescription(RouteDescription::WAY_NAME_DESC));
-    nextName=std::dynamic_pointer_cast<RouteDescription::NameDescription>(node->GetDescription(RouteDescription::WAY_NAME_DESC));
+    lastName=lastNode->GetDescription<RouteDescription::NameDescription>(RouteDescription::DescriptionSlot::WayName);
+    nextName=node->GetDescription<RouteDescription::NameDescription>(RouteDescription::DescriptionSlot::WayName);
 
-    RouteDescription::DescriptionRef          desc=node->GetDescription(RouteDescription::DIRECTION_DESC);
+    RouteDescription::DescriptionRef          desc=node->GetDescription(RouteDescription::DescriptionSlot::Direction);
     RouteDescription::DirectionDescriptionRef directionDesc=std::dynamic_pointer_cast<RouteDescription::DirectionDescription>(desc);
 
     if (lastName &&
@@ -760,7 +900,7 @@ namespace osmscout {
           directionDesc->GetCurve()!=RouteDescription::DirectionDescription::straightOn &&
           directionDesc->GetCurve()!=RouteDescription::DirectionDescription::slightlyRight) {
 
-          node->AddDescription(RouteDescription::TURN_DESC,
+          node->AddDescription(RouteDescription::DescriptionSlot::Turn,
                                std::make_shared<RouteDescription::TurnDescription>());
 
           return true;
@@ -769,7 +909,7 @@ namespace osmscout {
     else if (directionDesc &&
         directionDesc->GetCurve()!=RouteDescription::DirectionDescription::straightOn) {
 
-      node->AddDescription(RouteDescription::TURN_DESC,
+      node->AddDescription(RouteDescription::DescriptionSlot::Turn,
                            std::make_shared<RouteDescription::TurnDescription>());
 
       return true;
@@ -778,6 +918,29 @@ namespace osmscout {
     return false;
   }
 
+  bool RoutePostprocessor::InstructionPostprocessor::CanRunConcurrently() const
+  {
+    return true;
+  }
+
+  std::set<std::string> RoutePostprocessor::InstructionPostprocessor::GetRequiredDescriptions() const
+  {
+    return {RouteDescription::WAY_NAME_DESC,
+            RouteDescription::DIRECTION_DESC,
+            RouteDescription::CROSSING_WAYS_DESC};
+  }
+
+  std::set<std::string> RoutePostprocessor::InstructionPostprocessor::GetProvidedDescriptions() const
+  {
+    return {RouteDescription::WAY_NAME_CHANGED_DESC,
+            RouteDescription::TURN_DESC,
+            RouteDescription::ROUNDABOUT_ENTER_DESC,
+            RouteDescription::ROUNDABOUT_LEAVE_DESC,
+            RouteDescription::MOTORWAY_ENTER_DESC,
+            RouteDescription::MOTORWAY_CHANGE_DESC,
+            RouteDescription::MOTORWAY_LEAVE_DESC};
+  }
+
   bool RoutePostprocessor::InstructionPostprocessor::Process(const RoutePostprocessor& postprocessor,
                                                              RouteDescription& description)
   {
@@ -799,8 +962,8 @@ namespace osmscout {
     // Analyze crossing
     //
 
-    std::list<RouteDescription::Node>::iterator       node=description.Nodes().begin();
-    std::list<RouteDescription::Node>::const_iterator lastNode=description.Nodes().end();
+    std::vector<RouteDescription::Node>::iterator       node=description.Nodes().begin();
+    std::vector<RouteDescription::Node>::const_iterator lastNode=description.Nodes().end();
     while (node!=description.Nodes().end()) {
       RouteDescription::NameDescriptionRef originName;
       RouteDescription::NameDescriptionRef targetName;
@@ -813,10 +976,10 @@ namespace osmscout {
         continue;
       }
 
-      originName=std::dynamic_pointer_cast<RouteDescription::NameDescription>(lastNode->GetDescription(RouteDescription::WAY_NAME_DESC));
+      originName=lastNode->GetDescription<RouteDescription::NameDescription>(RouteDescription::DescriptionSlot::WayName);
 
       if (node->HasPathObject()) {
-        targetName=std::dynamic_pointer_cast<RouteDescription::NameDescription>(node->GetDescription(RouteDescription::WAY_NAME_DESC));
+        targetName=node->GetDescription<RouteDescription::NameDescription>(RouteDescription::DescriptionSlot::WayName);
       }
 
       if (!postprocessor.IsRoundabout(*lastNode) &&
@@ -879,7 +1042,7 @@ namespace osmscout {
         while (next!=description.Nodes().end() &&
                next->HasPathObject()) {
 
-          nextName=std::dynamic_pointer_cast<RouteDescription::NameDescription>(next->GetDescription(RouteDescription::WAY_NAME_DESC));
+          nextName=next->GetDescription<RouteDescription::NameDescription>(RouteDescription::DescriptionSlot::WayName);
 
           if (!postprocessor.IsMotorwayLink(*next)) {
             break;
@@ -896,7 +1059,7 @@ namespace osmscout {
           RouteDescription::MotorwayChangeDescriptionRef desc=std::make_shared<RouteDescription::MotorwayChangeDescription>(originName,
                                                                                                                             nextName);
 
-          node->AddDescription(RouteDescription::MOTORWAY_CHANGE_DESC,
+          node->AddDescription(RouteDescription::DescriptionSlot::MotorwayChange,
                                desc);
 
           node=next;
@@ -909,7 +1072,7 @@ namespace osmscout {
         if (originIsMotorway && !targetIsMotorway) {
           RouteDescription::MotorwayLeaveDescriptionRef desc=std::make_shared<RouteDescription::MotorwayLeaveDescription>(originName);
 
-          node->AddDescription(RouteDescription::MOTORWAY_LEAVE_DESC,
+          node->AddDescription(RouteDescription::DescriptionSlot::MotorwayLeave,
                                desc);
 
           HandleDirectionChange(description.Nodes(),
@@ -924,7 +1087,7 @@ namespace osmscout {
         if (!originIsMotorway && targetIsMotorway) {
           RouteDescription::MotorwayEnterDescriptionRef desc=std::make_shared<RouteDescription::MotorwayEnterDescription>(nextName);
 
-          node->AddDescription(RouteDescription::MOTORWAY_ENTER_DESC,
+          node->AddDescription(RouteDescription::DescriptionSlot::MotorwayEnter,
                                desc);
 
           node=next;
@@ -1111,7 +1274,7 @@ namespace osmscout {
     }
   };
 
-  std::set<ObjectFileRef> RoutePostprocessor::POIsPostprocessor::CollectPaths(const std::list<RouteDescription::Node>& nodes) const
+  std::set<ObjectFileRef> RoutePostprocessor::POIsPostprocessor::CollectPaths(const std::vector<RouteDescription::Node>& nodes) const
   {
     ObjectFileRef           prevObject;
     ObjectFileRef           curObject;
@@ -1133,7 +1296,7 @@ namespace osmscout {
   }
 
   std::list<WayRef> RoutePostprocessor::POIsPostprocessor::CollectWays(const RoutePostprocessor& postprocessor,
-                                                                       const std::list<RouteDescription::Node>& nodes) const
+                                                                       const std::vector<RouteDescription::Node>& nodes) const
   {
     ObjectFileRef     prevObject;
     ObjectFileRef     curObject;
@@ -1157,7 +1320,7 @@ namespace osmscout {
   }
 
   std::list<AreaRef> RoutePostprocessor::POIsPostprocessor::CollectAreas(const RoutePostprocessor& postprocessor,
-                                                                         const std::list<RouteDescription::Node>& nodes) const
+                                                                         const std::vector<RouteDescription::Node>& nodes) const
   {
     ObjectFileRef      prevObject;
     ObjectFileRef      curObject;
@@ -1236,7 +1399,7 @@ namespace osmscout {
   std::map<ObjectFileRef,RoutePostprocessor::POIsPostprocessor::POIAtRoute>
     RoutePostprocessor::POIsPostprocessor::AnalysePOICandidates(const RoutePostprocessor& postprocessor,
                                                                 const DatabaseId& databaseId,
-                                                                std::list<RouteDescription::Node>& nodes,
+                                                                std::vector<RouteDescription::Node>& nodes,
                                                                 const TypeInfoSet& nodeTypes,
                                                                 const TypeInfoSet& areaTypes,
                                                                 const std::unordered_map<FileOffset,NodeRef>& nodeMap,
@@ -1350,11 +1513,21 @@ namespace osmscout {
                                                                                                                 poiAtRoute.second.object,
                                                                                                                 poiAtRoute.second.name,
                                                                                                                 poiAtRoute.second.distance);
-      poiAtRoute.second.node->AddDescription(RouteDescription::POI_AT_ROUTE_DESC,
+      poiAtRoute.second.node->AddDescription(RouteDescription::DescriptionSlot::POIAtRoute,
                                              desc);
     }
   }
 
+  bool RoutePostprocessor::POIsPostprocessor::CanRunConcurrently() const
+  {
+    return true;
+  }
+
+  std::set<std::string> RoutePostprocessor::POIsPostprocessor::GetProvidedDescriptions() const
+  {
+    return {RouteDescription::POI_AT_ROUTE_DESC};
+  }
+
   bool RoutePostprocessor::POIsPostprocessor::Process(const RoutePostprocessor& postprocessor,
                                                       RouteDescription& description)
   {
@@ -1447,6 +1620,16 @@ namespace osmscout {
     return true;
   }
 
+  bool RoutePostprocessor::LanesPostprocessor::CanRunConcurrently() const
+  {
+    return true;
+  }
+
+  std::set<std::string> RoutePostprocessor::LanesPostprocessor::GetProvidedDescriptions() const
+  {
+    return {RouteDescription::LANES_DESC};
+  }
+
   bool RoutePostprocessor::LanesPostprocessor::Process(const RoutePostprocessor& postprocessor,
                                                        RouteDescription& description)
   {
@@ -1468,7 +1651,7 @@ namespace osmscout {
           lanes=postprocessor.GetLanes(node);
         }
         if (lanes) {
-          node.AddDescription(RouteDescription::LANES_DESC, lanes);
+          node.AddDescription(RouteDescription::DescriptionSlot::Lanes, lanes);
         }
 
         prevObject=curObject;
@@ -1479,13 +1662,29 @@ namespace osmscout {
     return true;
   }
 
+  bool RoutePostprocessor::SuggestedLanesPostprocessor::CanRunConcurrently() const
+  {
+    return true;
+  }
+
+  std::set<std::string> RoutePostprocessor::SuggestedLanesPostprocessor::GetRequiredDescriptions() const
+  {
+    return {RouteDescription::DIRECTION_DESC,
+            RouteDescription::LANES_DESC};
+  }
+
+  std::set<std::string> RoutePostprocessor::SuggestedLanesPostprocessor::GetProvidedDescriptions() const
+  {
+    return {RouteDescription::SUGGESTED_LANES_DESC};
+  }
+
   bool RoutePostprocessor::SuggestedLanesPostprocessor::Process(const RoutePostprocessor& /*postprocessor*/,
                                                                 RouteDescription& description)
   {
     using namespace std::string_view_literals;
 
     auto GetLaneDescription = [](const RouteDescription::Node &node) -> RouteDescription::LaneDescriptionRef {
-        return std::dynamic_pointer_cast<RouteDescription::LaneDescription>(node.GetDescription(RouteDescription::LANES_DESC));
+        return node.GetDescription<RouteDescription::LaneDescription>(RouteDescription::DescriptionSlot::Lanes);
     };
 
     // buffer of traveled nodes, recent node at back
@@ -1507,7 +1706,7 @@ namespace osmscout {
         auto prevLanes = GetLaneDescription(*backBuffer.back());
         assert(prevLanes);
         if (prevLanes->GetLaneCount() > lanes->GetLaneCount()) { // lane count was decreased
-          RouteDescription::DirectionDescriptionRef direction = std::dynamic_pointer_cast<RouteDescription::DirectionDescription>(node.GetDescription(RouteDescription::DIRECTION_DESC));
+          RouteDescription::DirectionDescriptionRef direction = node.GetDescription<RouteDescription::DirectionDescription>(RouteDescription::DescriptionSlot::Direction);
 
           using Move = RouteDescription::DirectionDescription::Move;
           Move directionMove = direction ? direction->GetTurn() : Move::straightOn;
@@ -1600,7 +1799,7 @@ namespace osmscout {
               if (*prevLanes != *nodeLanes){
                 break;
               }
-              nodePtr->AddDescription(RouteDescription::SUGGESTED_LANES_DESC, suggested);
+              nodePtr->AddDescription(RouteDescription::DescriptionSlot::SuggestedLanes, suggested);
             }
           }
 
@@ -1687,11 +1886,89 @@ namespace osmscout {
     return true;
   }
 
+  /**
+   * Load the junction nodes at the start of each path object of the route (see
+   * MotorwayJunctionPostprocessor) with one batched read of the node data file
+   */
+  bool RoutePostprocessor::ResolveAllJunctions(const RouteDescription& description,
+                                               DatabaseId dbId,
+                                               Database& database)
+  {
+    std::map<GeoCoord,NodeRef>& junctions=junctionMap[dbId];
+    auto                        types=junctionTypes.find(dbId);
+
+    if (types==junctionTypes.end() ||
+        types->second.Empty()) {
+      return true;
+    }
+
+    AreaNodeIndexRef areaNodeIndex=database.GetAreaNodeIndex();
+
+    if (!areaNodeIndex) {
+      return false;
+    }
+
+    std::set<FileOffset> nodeOffsets;
+    ObjectFileRef        prevObject;
+    DatabaseId           prevDatabase=0;
+
+    for (const auto& node : description.Nodes()) {
+      if (!node.HasPathObject() ||
+          (node.GetPathObject()==prevObject && node.GetDatabaseId()==prevDatabase)) {
+        continue;
+      }
+
+      prevObject=node.GetPathObject();
+      prevDatabase=node.GetDatabaseId();
+
+      if (node.GetDatabaseId()!=dbId ||
+          node.GetPathObject().GetType()!=refWay) {
+        continue;
+      }
+
+      GeoCoord                coord=GetWay(node.GetDBFileOffset())->GetCoord(node.GetCurrentNodeIndex());
+      std::vector<FileOffset> offsets;
+      TypeInfoSet             loadedTypes;
+
+      if (!areaNodeIndex->GetOffsets(GetJunctionBox(coord),
+                                     types->second,
+                                     offsets,
+                                     loadedTypes)) {
+        log.Error() << "Error getting nodes from area node index!";
+        return false;
+      }
+
+      junctions[coord]=nullptr;
+      nodeOffsets.insert(offsets.begin(),offsets.end());
+    }
+
+    if (nodeOffsets.empty()) {
+      return true;
+    }
+
+    std::vector<NodeRef> nodes;
+
+    if (!database.GetNodesByOffset(nodeOffsets,
+                                   nodes)) {
+      log.Error() << "Error reading nodes in area!";
+      return false;
+    }
+
+    for (auto& junction : junctions) {
+      junction.second=FindJunction(nodes,junction.first);
+    }
+
+    return true;
+  }
+
   void RoutePostprocessor::Cleanup()
   {
     areaMap.clear();
     wayMap.clear();
 
+    junctionMap.clear();
+    junctionsResolved=false;
+
     motorwayTypes.clear();
     motorwayLinkTypes.clear();
 
@@ -1845,13 +2122,11 @@ namespace osmscout {
   }
 
   bool RoutePostprocessor::LoadJunction(DatabaseId dbId,
-                                        GeoCoord coord,
-                                        std::string junctionRef,
-                                        std::string junctionName) const
+                                        const GeoCoord& coord,
+                                        std::string& junctionRef,
+                                        std::string& junctionName) const
   {
-    double                  delta=1E-7;
-    std::vector<FileOffset> nodeOffsets;
-    std::vector<NodeRef>    nodes;
+    NodeRef junction;
 
     auto nameReaderIt=nameReaders.find(dbId);
     assert(nameReaderIt!=nameReaders.end());
@@ -1861,61 +2136,70 @@ namespace osmscout {
     assert(refReaderIt!=refReaders.end());
     RefFeatureValueReader* refReader=refReaderIt->second;
 
-    assert(dbId<databases.size() && databases[dbId]);
-    DatabaseRef database=databases[dbId];
+    if (junctionsResolved) {
+      auto dbJunctions=junctionMap.find(dbId);
 
-    AreaNodeIndexRef areaNodeIndex=database->GetAreaNodeIndex();
+      if (dbJunctions!=junctionMap.end()) {
+        auto entry=dbJunctions->second.find(coord);
 
-    if (!areaNodeIndex) {
-      return false;
+        if (entry!=dbJunctions->second.end()) {
+          junction=entry->second;
+        }
+      }
     }
+    else {
+      std::vector<FileOffset> nodeOffsets;
+      std::vector<NodeRef>    nodes;
 
-    auto it=junctionTypes.find(dbId);
-    assert(it!=junctionTypes.end());
-    TypeInfoSet nodeTypes=it->second;
+      assert(dbId<databases.size() && databases[dbId]);
+      DatabaseRef database=databases[dbId];
 
-    TypeInfoSet loadedTypes;
-    GeoBox boundingBox(GeoCoord(coord.GetLat()-delta,coord.GetLon()-delta),
-                       GeoCoord(coord.GetLat()+delta,coord.GetLon()+delta));
+      AreaNodeIndexRef areaNodeIndex=database->GetAreaNodeIndex();
 
-    nodeOffsets.clear();
-    if (!areaNodeIndex->GetOffsets(boundingBox,
-                                   nodeTypes,
-                                   nodeOffsets,
-                                   loadedTypes)) {
-      log.Error() << "Error getting nodes from area node index!";
-      return false;
-    }
+      if (!areaNodeIndex) {
+        return false;
+      }
 
-    if (nodeOffsets.empty()) {
-      return true;
-    }
+      auto it=junctionTypes.find(dbId);
+      assert(it!=junctionTypes.end());
+      TypeInfoSet nodeTypes=it->second;
 
-    nodes.clear();
-    std::sort(nodeOffsets.begin(),nodeOffsets.end());
+      TypeInfoSet loadedTypes;
 
-    if (!database->GetNodesByOffset(nodeOffsets,
-                                   nodes)) {
-      log.Error() << "Error reading nodes in area!";
-      return false;
-    }
+      if (!areaNodeIndex->GetOffsets(GetJunctionBox(coord),
+                                     nodeTypes,
+                                     nodeOffsets,
+                                     loadedTypes)) {
+        log.Error() << "Error getting nodes from area node index!";
+        return false;
+      }
 
-    for (const auto& node : nodes) {
-      if (fabs(node->GetCoords().GetLat() - coord.GetLat()) < delta &&
-          fabs(node->GetCoords().GetLon() - coord.GetLon()) < delta) {
-        RefFeatureValue *refFeatureValue=refReader->GetValue(node->GetFeatureValueBuffer());
+      if (nodeOffsets.empty()) {
+        return true;
+      }
 
-        if (refFeatureValue!=nullptr) {
-          junctionRef=refFeatureValue->GetRef();
-        }
+      std::sort(nodeOffsets.begin(),nodeOffsets.end());
+
+      if (!database->GetNodesByOffset(nodeOffsets,
+                                      nodes)) {
+        log.Error() << "Error reading nodes in area!";
+        return false;
+      }
 
-        NameFeatureValue *nameFeatureValue=nameReader->GetValue(node->GetFeatureValueBuffer());
+      junction=FindJunction(nodes,coord);
+    }
 
-        if (nameFeatureValue!=nullptr) {
-          junctionName = nameFeatureValue->GetName();
-        }
+    if (junction) {
+      RefFeatureValue *refFeatureValue=refReader->GetValue(junction->GetFeatureValueBuffer());
 
-        break;
+      if (refFeatureValue!=nullptr) {
+        junctionRef=refFeatureValue->GetRef();
+      }
+
+      NameFeatureValue *nameFeatureValue=nameReader->GetValue(junction->GetFeatureValueBuffer());
+
+      if (nameFeatureValue!=nullptr) {
+        junctionName = nameFeatureValue->GetName();
       }
     }
 
@@ -2270,19 +2554,40 @@ namespace osmscout {
     return GeoCoord();
   }
 
-  bool RoutePostprocessor::PostprocessRouteDescription(RouteDescription& description,
-                                                       const std::vector<RoutingProfileRef>& profiles,
-                                                       const std::vector<DatabaseRef>& databases,
-                                                       const std::list<PostprocessorRef>& processors,
-                                                       const std::set<std::string>& motorwayTypeNames,
-                                                       const std::set<std::string>& motorwayLinkTypeNames,
-                                                       const std::set<std::string>& junctionTypeNames)
+  /**
+   * Number of threads used for executing the postprocessors, 0 means one
+   * thread for each core. Only with a value other than 1, postprocessors
+   * run concurrently (see ExecuteProcessorsConcurrently()). Default is 1.
+   */
+  void RoutePostprocessor::SetThreadCount(size_t threadCount)
   {
-    Cleanup(); // We do not trust ourself ;-)
+    this->threadCount=threadCount;
+  }
+
+  /**
+   * Distance before the first changed node, that is processed again by
+   * PostprocessRouteDescriptionSuffix(). Default is 1km.
+   */
+  void RoutePostprocessor::SetContextDistance(const Distance& contextDistance)
+  {
+    this->contextDistance=contextDistance;
+  }
 
+  bool RoutePostprocessor::Initialize(const RouteDescription& description,
+                                      const std::vector<RoutingProfileRef>& profiles,
+                                      const std::vector<DatabaseRef>& databases,
+                                      const std::list<PostprocessorRef>& processors,
+                                      const std::set<std::string>& motorwayTypeNames,
+                                      const std::set<std::string>& motorwayLinkTypeNames,
+                                      const std::set<std::string>& junctionTypeNames)
+  {
     this->databases=databases;
     this->profiles=profiles;
 
+    bool needsJunctions=std::any_of(processors.begin(),processors.end(),[](const PostprocessorRef& processor) {
+      return processor->NeedsJunctions();
+    });
+
     for (DatabaseId dbIdx=0; dbIdx<databases.size(); dbIdx++){
       // init feature readers
       DatabaseId dbId=dbIdx;
@@ -2321,16 +2626,34 @@ namespace osmscout {
       if (!ResolveAllAreasAndWays(description,
                                   dbId,
                                   *database)) {
-        Cleanup();
+        return false;
+      }
+
+      if (needsJunctions &&
+          !ResolveAllJunctions(description,
+                               dbId,
+                               *database)) {
         return false;
       }
     }
 
+    junctionsResolved=needsJunctions;
+
+    return true;
+  }
+
+  bool RoutePostprocessor::ExecuteProcessors(RouteDescription& description,
+                                             const std::list<PostprocessorRef>& processors) const
+  {
+    if (threadCount!=1) {
+      return ExecuteProcessorsConcurrently(description,
+                                           processors);
+    }
+
     size_t pos=1;
     for (const auto& processor : processors) {
       if (!processor->Process(*this,description)) {
         log.Error() << "Error during execution of postprocessor " << pos;
-        Cleanup();
 
         return false;
       }
@@ -2338,8 +2661,206 @@ namespace osmscout {
       pos++;
     }
 
+    return true;
+  }
+
+  /**
+   * Execute the postprocessors in stages. A postprocessor runs in a later stage
+   * than each postprocessor before it in the list, that it depends on: a
+   * postprocessor that cannot run concurrently, that provides a description it
+   * requires or that requires or provides a description it provides.
+   *
+   * The postprocessors of a stage run concurrently, each but the first on its own
+   * copy of the description. The descriptions added to the copies are merged into
+   * the description after the stage, in the order of the list.
+   */
+  bool RoutePostprocessor::ExecuteProcessorsConcurrently(RouteDescription& description,
+                                                         const std::list<PostprocessorRef>& processors) const
+  {
+    std::vector<PostprocessorRef>      processorList(processors.begin(),processors.end());
+    std::vector<bool>                  concurrent;
+    std::vector<std::set<std::string>> required;
+    std::vector<std::set<std::string>> provided;
+    std::vector<size_t>                stages(processorList.size(),0);
+    size_t                             stageCount=0;
+
+    auto intersects=[](const std::set<std::string>& a,
+                       const std::set<std::string>& b) {
+      return std::any_of(a.begin(),a.end(),[&b](const std::string& name) {
+        return b.find(name)!=b.end();
+      });
+    };
+
+    for (size_t i=0; i<processorList.size(); i++) {
+      concurrent.push_back(processorList[i]->CanRunConcurrently());
+      required.push_back(processorList[i]->GetRequiredDescriptions());
+      provided.push_back(processorList[i]->GetProvidedDescriptions());
+
+      for (size_t j=0; j<i; j++) {
+        if (!concurrent[i] ||
+            !concurrent[j] ||
+            intersects(required[i],provided[j]) ||
+            intersects(provided[i],required[j]) ||
+            intersects(provided[i],provided[j])) {
+          stages[i]=std::max(stages[i],stages[j]+1);
+        }
+      }
+
+      stageCount=std::max(stageCount,stages[i]+1);
+    }
+
+    for (size_t stage=0; stage<stageCount; stage++) {
+      std::vector<size_t> members;
+
+      for (size_t i=0; i<processorList.size(); i++) {
+        if (stages[i]==stage) {
+          members.push_back(i);
+        }
+      }
+
+      std::vector<RouteDescription>      copies(members.size()-1,description);
+      std::vector<std::function<bool()>> tasks;
+
+      for (size_t m=0; m<members.size(); m++) {
+        RouteDescription& target=m==0 ? description : copies[m-1];
+
+        tasks.emplace_back([this,&processorList,&target,index=members[m]]() {
+          if (!processorList[index]->Process(*this,target)) {
+            log.Error() << "Error during execution of postprocessor " << index+1;
+            return false;
+          }
+
+          return true;
+        });
+      }
+
+      if (!RunConcurrently(tasks,
+                           threadCount)) {
+        return false;
+      }
+
+      for (const auto& copy : copies) {
+        auto node=description.Nodes().begin();
+
+        for (const auto& copyNode : copy.Nodes()) {
+          node->MergeDescriptions(copyNode);
+          ++node;
+        }
+      }
+    }
+
+    return true;
+  }
+
+  bool RoutePostprocessor::PostprocessRouteDescription(RouteDescription& description,
+                                                       const std::vector<RoutingProfileRef>& profiles,
+                                                       const std::vector<DatabaseRef>& databases,
+                                                       const std::list<PostprocessorRef>& processors,
+                                                       const std::set<std::string>& motorwayTypeNames,
+                                                       const std::set<std::string>& motorwayLinkTypeNames,
+                                                       const std::set<std::string>& junctionTypeNames)
+  {
+    Cleanup(); // We do not trust ourself ;-)
+
+    bool success=Initialize(description,
+                            profiles,
+                            databases,
+                            processors,
+                            motorwayTypeNames,
+                            motorwayLinkTypeNames,
+                            junctionTypeNames) &&
+                 ExecuteProcessors(description,
+                                   processors);
+
     Cleanup();
 
+    return success;
+  }
+
+  /**
+   * Postprocess the nodes of the description starting at firstNode, if the nodes
+   * before are unchanged and were processed already, for example after rerouting.
+   *
+   * The postprocessors run on a copy of the nodes, that starts contextDistance (see
+   * SetContextDistance()) before firstNode, so that postprocessors looking at the
+   * previous nodes see the same nodes as for the complete route. Only the nodes
+   * starting at firstNode are replaced by the result, the descriptions of the
+   * nodes before are kept. Distances and times are continued from the nodes before.
+   */
+  bool RoutePostprocessor::PostprocessRouteDescriptionSuffix(RouteDescription& description,
+                                                             size_t firstNode,
+                                                             const std::vector<RoutingProfileRef>& profiles,
+                                                             const std::vector<DatabaseRef>& databases,
+                                                             const std::list<PostprocessorRef>& processors,
+                                                             const std::set<std::string>& motorwayTypeNames,
+                                                             const std::set<std::string>& motorwayLinkTypeNames,
+                                                             const std::set<std::string>& junctionTypeNames)
+  {
+    if (firstNode==0) {
+      return PostprocessRouteDescription(description,
+                                         profiles,
+                                         databases,
+                                         processors,
+                                         motorwayTypeNames,
+                                         motorwayLinkTypeNames,
+                                         junctionTypeNames);
+    }
+
+    if (firstNode>=description.Nodes().size()) {
+      return true;
+    }
+
+    auto     first=std::next(description.Nodes().begin(),firstNode);
+    Distance lastDistance=std::prev(first)->GetDistance();
+    auto     contextStart=std::next(description.Nodes().begin(),
+                                    std::distance(description.Nodes().cbegin(),
+                                                  description.FindNodeByDistance(lastDistance-contextDistance)));
+
+    if (contextStart>=first) {
+      contextStart=std::prev(first);
+    }
+
+    RouteDescription suffix;
+
+    suffix.SetDatabaseMapping(description.GetDatabaseMapping());
+
+    for (auto node=contextStart; node!=description.Nodes().end(); ++node) {
+      suffix.Nodes().push_back(*node);
+      suffix.Nodes().back().ClearDescriptions();
+    }
+
+    Cleanup();
+
+    bool success=Initialize(suffix,
+                            profiles,
+                            databases,
+                            processors,
+                            motorwayTypeNames,
+                            motorwayLinkTypeNames,
+                            junctionTypeNames) &&
+                 ExecuteProcessors(suffix,
+                                   processors);
+
+    Cleanup();
+
+    if (!success) {
+      return false;
+    }
+
+    Distance distanceOffset=contextStart->GetDistance();
+    Duration timeOffset=contextStart->GetTime();
+    auto     processed=std::next(suffix.Nodes().begin(),std::distance(contextStart,first));
+
+    for (auto node=processed; node!=suffix.Nodes().end(); ++node) {
+      node->SetDistance(distanceOffset+node->GetDistance());
+      node->SetTime(timeOffset+node->GetTime());
+    }
+
+    description.Nodes().erase(first,description.Nodes().end());
+    description.Nodes().insert(description.Nodes().end(),
+                               std::make_move_iterator(processed),
+                               std::make_move_iterator(suffix.Nodes().end()));
+
     return true;
   }
 }
@@ -0,0 +1,642 @@
+/*
+  This source is part of the libosmscout library
+  Copyright (C) 2026  Tim Teulings
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307  USA
+*/
+
+#include <osmscout/routing/RouteSnapIndex.h>
+
+#include <algorithm>
+#include <cmath>
+#include <queue>
+#include <set>
+
+#include <osmscout/Area.h>
+#include <osmscout/AreaDataFile.h>
+#include <osmscout/Way.h>
+#include <osmscout/WayDataFile.h>
+
+#include <osmscout/FeatureReader.h>
+
+#include <osmscout/util/File.h>
+#include <osmscout/util/FileWriter.h>
+#include <osmscout/util/Geometry.h>
+#include <osmscout/util/Logger.h>
+#include <osmscout/util/Number.h>
+
+namespace osmscout {
+
+  namespace {
+    const size_t boxByteSize=2*coordByteSize;
+
+    double GetCenterLon(const RouteSnapIndex::Segment& segment)
+    {
+      return segment.from.GetLon()+segment.to.GetLon();
+    }
+
+    double GetCenterLat(const RouteSnapIndex::Segment& segment)
+    {
+      return segment.from.GetLat()+segment.to.GetLat();
+    }
+
+    /**
+     * Distance of the coordinate to the box on the plane of longitude
+     * and latitude, 0.0 if the coordinate is within the box
+     */
+    double GetBoxDistance(const GeoCoord& coord,
+                          const GeoBox& box)
+    {
+      double dx=std::max({box.GetMinLon()-coord.GetLon(),0.0,coord.GetLon()-box.GetMaxLon()});
+      double dy=std::max({box.GetMinLat()-coord.GetLat(),0.0,coord.GetLat()-box.GetMaxLat()});
+
+      return std::sqrt(dx*dx+dy*dy);
+    }
+  }
+
+  RouteSnapIndex::~RouteSnapIndex()
+  {
+    Close();
+  }
+
+  size_t RouteSnapIndex::GetSegmentRecordSize() const
+  {
+    return fileOffsetBytes+  // offset
+           1+                // RefType
+           1+                // VehicleMask
+           4+                // nodeIndex
+           2*coordByteSize;  // from, to
+  }
+
+  size_t RouteSnapIndex::GetLevelStart(size_t level) const
+  {
+    return level==0 ? 0 : levelEnds[level-1];
+  }
+
+  void RouteSnapIndex::ReadSegment(FileScanner& scanner,
+                                   Segment& segment) const
+  {
+    FileOffset offset;
+    uint8_t    type;
+
+    scanner.ReadFileOffset(offset,
+                           fileOffsetBytes);
+    scanner.Read(type);
+    scanner.Read(segment.vehicles);
+    scanner.Read(segment.nodeIndex);
+    scanner.ReadCoord(segment.from);
+    scanner.ReadCoord(segment.to);
+
+    segment.object.Set(offset,
+                       static_cast<RefType>(type));
+  }
+
+  /**
+   * Collect the segments of all ways and areas in the given directory that
+   * are routable by at least one of the given vehicles and write the index
+   * to the given file.
+   */
+  bool RouteSnapIndex::Build(Progress& progress,
+                             const TypeConfig& typeConfig,
+                             const std::string& path,
+                             VehicleMask vehicles,
+                             const std::string& filename)
+  {
+    AccessFeatureValueReader accessReader(typeConfig);
+    std::vector<Segment>     segments;
+    FileOffset               maxOffset=0;
+
+    auto getVehicles=[&accessReader,vehicles](const TypeInfoRef& type,
+                                              const FeatureValueBuffer& buffer) {
+      VehicleMask         mask=0;
+      AccessFeatureValue* accessValue=accessReader.GetValue(buffer);
+
+      if (type->GetIgnore() ||
+          !type->CanRoute()) {
+        return mask;
+      }
+
+      if (accessValue!=nullptr ? accessValue->CanRouteFoot() : type->CanRouteFoot()) {
+        mask|=vehicleFoot;
+      }
+
+      if (accessValue!=nullptr ? accessValue->CanRouteBicycle() : type->CanRouteBicycle()) {
+        mask|=vehicleBicycle;
+      }
+
+      if (accessValue!=nullptr ? accessValue->CanRouteCar() : type->CanRouteCar()) {
+        mask|=vehicleCar;
+      }
+
+      return static_cast<VehicleMask>(mask & vehicles);
+    };
+
+    auto addSegments=[&segments,&maxOffset](const ObjectFileRef& object,
+                                            VehicleMask mask,
+                                            const std::vector<Point>& nodes,
+                                            bool closed) {
+      size_t count=closed ? nodes.size() : nodes.size()-1;
+
+      for (size_t i=0; i<count; i++) {
+        Segment segment;
+
+        segment.object=object;
+        segment.nodeIndex=static_cast<uint32_t>(i);
+        segment.vehicles=mask;
+        segment.from=nodes[i].GetCoord();
+        segment.to=nodes[(i+1)%nodes.size()].GetCoord();
+
+        segments.push_back(segment);
+      }
+
+      maxOffset=std::max(maxOffset,object.GetFileOffset());
+    };
+
+    try {
+      FileScanner scanner;
+      uint32_t    dataCount;
+
+      progress.SetAction("Scanning ways");
+
+      scanner.Open(AppendFileToDir(path,
+                                   WayDataFile::WAYS_DAT),
+                   FileScanner::Sequential,
+                   true);
+
+      scanner.Read(dataCount);
+
+      for (uint32_t i=1; i<=dataCount; i++) {
+        Way way;
+
+        progress.SetProgress(i,dataCount);
+
+        way.Read(typeConfig,
+                 scanner);
+
+        VehicleMask mask=getVehicles(way.GetType(),
+                                     way.GetFeatureValueBuffer());
+
+        if (mask==0 ||
+            way.nodes.size()<2) {
+          continue;
+        }
+
+        addSegments(way.GetObjectFileRef(),
+                    mask,
+                    way.nodes,
+                    false);
+      }
+
+      scanner.Close();
+
+      progress.SetAction("Scanning areas");
+
+      scanner.Open(AppendFileToDir(path,
+                                   AreaDataFile::AREAS_DAT),
+                   FileScanner::Sequential,
+                   true);
+
+      scanner.Read(dataCount);
+
+      for (uint32_t i=1; i<=dataCount; i++) {
+        Area area;
+
+        progress.SetProgress(i,dataCount);
+
+        area.Read(typeConfig,
+                  scanner);
+
+        // The router only supports simple areas
+        if (area.rings.size()!=1) {
+          continue;
+        }
+
+        VehicleMask mask=getVehicles(area.rings[0].GetType(),
+                                     area.rings[0].GetFeatureValueBuffer());
+
+        if (mask==0 ||
+            area.rings[0].nodes.size()<2) {
+          continue;
+        }
+
+        addSegments(area.GetObjectFileRef(),
+                    mask,
+                    area.rings[0].nodes,
+                    true);
+      }
+
+      scanner.Close();
+    }
+    catch (IOException& e) {
+      progress.Error(e.GetDescription());
+      return false;
+    }
+
+    progress.Info(std::to_string(segments.size())+" routable segments");
+
+    progress.SetAction("Sorting segments");
+
+    // Sort-tile-recursive: vertical slices by longitude, each slice sorted by latitude
+    size_t leafNodes=(segments.size()+nodeSize-1)/nodeSize;
+    size_t sliceCount=std::max(size_t(1),size_t(std::ceil(std::sqrt(double(leafNodes)))));
+    size_t sliceSize=nodeSize*((leafNodes+sliceCount-1)/sliceCount);
+
+    std::sort(segments.begin(),segments.end(),[](const Segment& a, const Segment& b) {
+      return GetCenterLon(a)<GetCenterLon(b);
+    });
+
+    for (size_t start=0; start<segments.size(); start+=sliceSize) {
+      std::sort(segments.begin()+start,
+                segments.begin()+std::min(start+sliceSize,segments.size()),
+                [](const Segment& a, const Segment& b) {
+                  return GetCenterLat(a)<GetCenterLat(b);
+                });
+    }
+
+    progress.SetAction("Building tree");
+
+    std::vector<uint32_t> ends;
+    std::vector<GeoBox>   boxes;
+    std::vector<GeoBox>   level;
+
+    level.reserve(segments.size());
+
+    for (const auto& segment : segments) {
+      level.emplace_back(segment.from,segment.to);
+    }
+
+    if (!level.empty()) {
+      ends.push_back(static_cast<uint32_t>(level.size()));
+    }
+
+    while (level.size()>1) {
+      std::vector<GeoBox> parents;
+
+      parents.reserve((level.size()+nodeSize-1)/nodeSize);
+
+      for (size_t i=0; i<level.size(); i+=nodeSize) {
+        GeoBox box=level[i];
+
+        for (size_t j=i+1; j<std::min(i+nodeSize,level.size()); j++) {
+          box.Include(level[j]);
+        }
+
+        parents.push_back(box);
+      }
+
+      boxes.insert(boxes.end(),parents.begin(),parents.end());
+      ends.push_back(ends.back()+static_cast<uint32_t>(parents.size()));
+      level.swap(parents);
+    }
+
+    progress.SetAction("Writing '"+filename+"'");
+
+    FileWriter writer;
+
+    try {
+      uint8_t offsetBytes=BytesNeededToEncodeNumber(maxOffset);
+
+      writer.Open(filename);
+
+      writer.Write(static_cast<uint32_t>(segments.size()));
+      writer.Write(offsetBytes);
+      writer.Write(static_cast<uint32_t>(ends.size()));
+
+      for (auto end : ends) {
+        writer.Write(end);
+      }
+
+      for (const auto& box : boxes) {
+        writer.WriteBox(box);
+      }
+
+      for (const auto& segment : segments) {
+        writer.WriteFileOffset(segment.object.GetFileOffset(),
+                               offsetBytes);
+        writer.Write(static_cast<uint8_t>(segment.object.GetType()));
+        writer.Write(segment.vehicles);
+        writer.Write(segment.nodeIndex);
+        writer.WriteCoord(segment.from);
+        writer.WriteCoord(segment.to);
+      }
+
+      writer.Close();
+    }
+    catch (IOException& e) {
+      progress.Error(e.GetDescription());
+      writer.CloseFailsafe();
+      return false;
+    }
+
+    return true;
+  }
+
+  bool RouteSnapIndex::Open(const std::string& filename,
+                            bool memoryMapped)
+  {
+    try {
+      scannerPool.Open(filename,FileScanner::FastRandom,memoryMapped);
+
+      FileScannerPool::Lease scanner=scannerPool.Acquire();
+      uint32_t               levelCount;
+
+      scanner->Read(segmentCount);
+      scanner->Read(fileOffsetBytes);
+      scanner->Read(levelCount);
+
+      levelEnds.resize(levelCount);
+
+      for (auto& end : levelEnds) {
+        scanner->Read(end);
+      }
+
+      if ((segmentCount==0)!=levelEnds.empty() ||
+          (!levelEnds.empty() && levelEnds.front()!=segmentCount)) {
+        throw IOException(filename,"Cannot open snap index","Invalid tree levels");
+      }
+
+      boxesOffset=scanner->GetPos();
+      segmentsOffset=boxesOffset+(levelEnds.empty() ? 0 : levelEnds.back()-segmentCount)*boxByteSize;
+
+      return !scanner->HasError();
+    }
+    catch (IOException& e) {
+      log.Error() << e.GetDescription();
+      scannerPool.CloseFailsafe();
+      levelEnds.clear();
+      segmentCount=0;
+
+      return false;
+    }
+  }
+
+  bool RouteSnapIndex::IsOpen() const
+  {
+    return scannerPool.IsOpen();
+  }
+
+  void RouteSnapIndex::Close()
+  {
+    levelEnds.clear();
+    segmentCount=0;
+
+    try {
+      if (scannerPool.IsOpen()) {
+        scannerPool.Close();
+      }
+    }
+    catch (IOException& e) {
+      log.Error() << e.GetDescription();
+      scannerPool.CloseFailsafe();
+    }
+  }
+
+  /**
+   * Collect up to maxCount segments of different objects in the order of
+   * increasing distance, only the closest segment of each object is returned
+   */
+  void RouteSnapIndex::Search(FileScanner& scanner,
+                              const GeoCoord& coord,
+                              VehicleMask vehicles,
+                              const Distance& maxDistance,
+                              const SegmentFilter& filter,
+                              size_t maxCount,
+                              std::vector<Match>& matches) const
+  {
+    matches.clear();
+
+    if (segmentCount==0 ||
+        maxCount==0) {
+      return;
+    }
+
+    // Distances are in degrees, the radius is converted using the (smaller)
+    // length of one degree of longitude
+    double                          maxDegrees=maxDistance.AsMeter()/(111320.0*std::max(0.01,std::cos(coord.GetLat()*M_PI/180.0)));
+    std::priority_queue<QueueEntry> queue;
+    std::vector<Candidate>          candidates;
+    std::set<ObjectFileRef>         objects;
+
+    auto pushNodes=[&](size_t level,
+                       size_t first,
+                       size_t last) {
+      if (level==0) {
+        scanner.SetPos(segmentsOffset+first*GetSegmentRecordSize());
+
+        for (size_t node=first; node<last; node++) {
+          Candidate candidate;
+          double    lon;
+          double    lat;
+
+          ReadSegment(scanner,candidate.segment);
+
+          if ((candidate.segment.vehicles & vehicles)==0) {
+            continue;
+          }
+
+          double distance=DistanceToSegment(coord.GetLon(),coord.GetLat(),
+                                            candidate.segment.from.GetLon(),candidate.segment.from.GetLat(),
+                                            candidate.segment.to.GetLon(),candidate.segment.to.GetLat(),
+                                            candidate.fraction,lon,lat);
+
+          if (distance<=maxDegrees) {
+            candidate.point.Set(lat,lon);
+            queue.push(QueueEntry{distance,0,candidates.size()});
+            candidates.push_back(candidate);
+          }
+        }
+      }
+      else {
+        scanner.SetPos(boxesOffset+(first-segmentCount)*boxByteSize);
+
+        for (size_t node=first; node<last; node++) {
+          GeoBox box;
+
+          scanner.ReadBox(box);
+
+          double distance=GetBoxDistance(coord,box);
+
+          if (distance<=maxDegrees) {
+            queue.push(QueueEntry{distance,level,node});
+          }
+        }
+      }
+    };
+
+    size_t topLevel=levelEnds.size()-1;
+
+    pushNodes(topLevel,
+              GetLevelStart(topLevel),
+              levelEnds[topLevel]);
+
+    while (!queue.empty()) {
+      QueueEntry entry=queue.top();
+
+      queue.pop();
+
+      if (entry.level==0) {
+        const Candidate& candidate=candidates[entry.index];
+
+        if (objects.find(candidate.segment.object)!=objects.end() ||
+            (filter && !filter(candidate.segment))) {
+          continue;
+        }
+
+        Match match;
+
+        match.segment=candidate.segment;
+        match.fraction=candidate.fraction;
+        match.point=candidate.point;
+        match.distance=GetEllipsoidalDistance(coord,candidate.point);
+
+        matches.push_back(match);
+
+        if (matches.size()>=maxCount) {
+          return;
+        }
+
+        objects.insert(candidate.segment.object);
+
+        continue;
+      }
+
+      size_t childLevel=entry.level-1;
+      size_t first=GetLevelStart(childLevel)+(entry.index-GetLevelStart(entry.level))*nodeSize;
+
+      pushNodes(childLevel,
+                first,
+                std::min(first+nodeSize,size_t(levelEnds[childLevel])));
+    }
+  }
+
+  /**
+   * Return the closest segment to the given coordinate usable by one of the given
+   * vehicles and accepted by the filter (if set).
+   *
+   * @return
+   *    true, if a segment within maxDistance was found
+   */
+  bool RouteSnapIndex::GetClosest(const GeoCoord& coord,
+                                  VehicleMask vehicles,
+                                  const Distance& maxDistance,
+                                  const SegmentFilter& filter,
+                                  Match& match) const
+  {
+    try {
+      FileScannerPool::Lease scanner=scannerPool.Acquire();
+      std::vector<Match>     matches;
+
+      Search(*scanner,
+             coord,
+             vehicles,
+             maxDistance,
+             filter,
+             1,
+             matches);
+
+      if (matches.empty()) {
+        return false;
+      }
+
+      match=matches.front();
+
+      return true;
+    }
+    catch (IOException& e) {
+      log.Error() << e.GetDescription();
+      return false;
+    }
+  }
+
+  /**
+   * Batched version of GetClosest(), returning one entry for each coordinate,
+   * empty if no segment was found.
+   *
+   * @return
+   *    false on error
+   */
+  bool RouteSnapIndex::GetClosest(const std::vector<GeoCoord>& coords,
+                                  VehicleMask vehicles,
+                                  const Distance& maxDistance,
+                                  const SegmentFilter& filter,
+                                  std::vector<std::optional<Match>>& matches) const
+  {
+    matches.clear();
+    matches.reserve(coords.size());
+
+    try {
+      FileScannerPool::Lease scanner=scannerPool.Acquire();
+      std::vector<Match>     closest;
+
+      for (const auto& coord : coords) {
+        Search(*scanner,
+               coord,
+               vehicles,
+               maxDistance,
+               filter,
+               1,
+               closest);
+
+        if (!closest.empty()) {
+          matches.emplace_back(closest.front());
+        }
+        else {
+          matches.emplace_back();
+        }
+      }
+    }
+    catch (IOException& e) {
+      log.Error() << e.GetDescription();
+      return false;
+    }
+
+    return true;
+  }
+
+  /**
+   * Return up to maxCount candidates for snapping the given coordinate in the
+   * order of increasing distance, with at most one segment (the closest) of
+   * each way or area.
+   *
+   * @return
+   *    false on error
+   */
+  bool RouteSnapIndex::GetCandidates(const GeoCoord& coord,
+                                     VehicleMask vehicles,
+                                     const Distance& maxDistance,
+                                     const SegmentFilter& filter,
+                                     size_t maxCount,
+                                     std::vector<Match>& matches) const
+  {
+    try {
+      FileScannerPool::Lease scanner=scannerPool.Acquire();
+
+      Search(*scanner,
+             coord,
+             vehicles,
+             maxDistance,
+             filter,
+             maxCount,
+             matches);
+    }
+    catch (IOException& e) {
+      log.Error() << e.GetDescription();
+      matches.clear();
+      return false;
+    }
+
+    return true;
+  }
+}
@@ -21,6 +21,9 @@
 
 #include <osmscout/routing/RoutingService.h>
 
+#include <osmscout/util/File.h>
+#include <osmscout/util/StopClock.h>
+
 namespace osmscout {
 
   RoutingDatabase::RoutingDatabase()
@@ -40,32 +43,92 @@ namespace osmscout {
     typeConfig=database->GetTypeConfig();
     path=database->GetPath();
 
+    StopClock timer;
+
     if (!routeNodeDataFile.Open(database->GetTypeConfig(),
                           database->GetPath(),
-                          database->GetParameter().GetRouterDataMMap())) {
+                          database->GetParameter().GetRouterDataMMap(),
+                          database->GetParameter().GetHotFileMMapAdvice())) {
       log.Error() << "Cannot open route node data file'" << database->GetPath() << "'!";
       return false;
     }
 
-    return objectVariantDataFile.Load(*(database->GetTypeConfig()),
-                                      AppendFileToDir(database->GetPath(),
-                                                      RoutingService::GetData2Filename(osmscout::RoutingService::DEFAULT_FILENAME_BASE)));
+    timer.Stop();
+
+    log.Debug() << "Opening RouteNodeDataFile: " << timer.ResultString();
+
+    if (database->GetMemoryGovernor()) {
+      routeNodeDataFile.SetMemoryGovernor(database->GetMemoryGovernor(),
+                                          /*weight, the cache size*/
+                                          1000);
+    }
+
+    if (!objectVariantDataFile.Load(*(database->GetTypeConfig()),
+                                    AppendFileToDir(database->GetPath(),
+                                                    RoutingService::GetData2Filename(osmscout::RoutingService::DEFAULT_FILENAME_BASE)))) {
+      return false;
+    }
+
+    // Speed profiles are optional
+    std::string speedProfileFilename=AppendFileToDir(database->GetPath(),
+                                                     RoutingService::GetSpeedProfileFilename(osmscout::RoutingService::DEFAULT_FILENAME_BASE));
+
+    if (ExistsInFilesystem(speedProfileFilename)) {
+      speedProfiles=std::make_shared<SpeedProfiles>();
+
+      if (!speedProfiles->Load(speedProfileFilename)) {
+        log.Error() << "Cannot load speed profiles '" << speedProfileFilename << "'!";
+        speedProfiles.reset();
+        return false;
+      }
+    }
+
+    return true;
+  }
+
+  /**
+   * Load the complete routing graph into memory, see RouteNodeDataFile::LoadGraph()
+   */
+  bool RoutingDatabase::LoadGraph()
+  {
+    StopClock timer;
+
+    if (!routeNodeDataFile.LoadGraph()) {
+      log.Error() << "Cannot load routing graph of '" << path << "'!";
+      return false;
+    }
+
+    timer.Stop();
+
+    log.Debug() << "Loading routing graph: " << timer.ResultString();
+
+    return true;
   }
 
   void RoutingDatabase::Close()
   {
     routeNodeDataFile.Close();
     junctionDataFile.Close();
+    speedProfiles.reset();
 
     typeConfig.reset();
     path.clear();
   }
 
+  /**
+   * Return the junctions with the given ids. The junction file is opened on
+   * first use and stays open until Close().
+   *
+   * Method is thread-safe.
+   */
   bool RoutingDatabase::GetJunctions(const std::set<Id>& ids,
                                      std::vector<JunctionRef>& junctions)
   {
-    if (!junctionDataFile.IsOpen()) {
-      if (!junctionDataFile.Open(typeConfig,
+    {
+      std::lock_guard<std::mutex> lock(junctionMutex);
+
+      if (!junctionDataFile.IsOpen() &&
+          !junctionDataFile.Open(typeConfig,
                                  path,
                                  false,
                                  false)) {
@@ -73,13 +136,7 @@ namespace osmscout {
       }
     }
 
-    bool result=junctionDataFile.Get(ids,
-                                     junctions);
-
-    if (!junctionDataFile.Close()) {
-      result=false;
-    }
-
-    return result;
+    return junctionDataFile.Get(ids,
+                                junctions);
   }
 }
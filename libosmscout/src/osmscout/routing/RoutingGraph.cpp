@@ -0,0 +1,235 @@
+/*
+  This source is part of the libosmscout library
+  Copyright (C) 2026  Tim Teulings
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307  USA
+*/
+
+#include <osmscout/routing/RoutingGraph.h>
+
+#include <osmscout/system/Assert.h>
+
+namespace osmscout {
+
+  const uint32_t RoutingGraph::noNode;
+
+  RoutingGraph::RoutingGraph()
+  : idMask(0)
+  {
+    // no code
+  }
+
+  void RoutingGraph::Clear()
+  {
+    nodeIds.clear();
+    nodeIds.shrink_to_fit();
+    nodeCoords.clear();
+    nodeCoords.shrink_to_fit();
+    nodeFileOffsets.clear();
+    nodeFileOffsets.shrink_to_fit();
+    objectOffsets.clear();
+    objectOffsets.shrink_to_fit();
+    objects.clear();
+    objects.shrink_to_fit();
+    pathOffsets.clear();
+    pathOffsets.shrink_to_fit();
+    pathTargets.clear();
+    pathTargets.shrink_to_fit();
+    pathDistances.clear();
+    pathDistances.shrink_to_fit();
+    pathObjects.clear();
+    pathObjects.shrink_to_fit();
+    pathFlags.clear();
+    pathFlags.shrink_to_fit();
+    excludeOffsets.clear();
+    excludeOffsets.shrink_to_fit();
+    excludes.clear();
+    excludes.shrink_to_fit();
+    idTable.clear();
+    idTable.shrink_to_fit();
+    pathTargetIds.clear();
+    pathTargetIds.shrink_to_fit();
+    idMask=0;
+  }
+
+  void RoutingGraph::Reserve(size_t nodeCount)
+  {
+    nodeIds.reserve(nodeCount);
+    nodeCoords.reserve(nodeCount);
+    nodeFileOffsets.reserve(nodeCount);
+    objectOffsets.reserve(nodeCount+1);
+    pathOffsets.reserve(nodeCount+1);
+    excludeOffsets.reserve(nodeCount+1);
+  }
+
+  /**
+   * Append the given route node. Paths reference their targets by id
+   * until Finish() is called.
+   */
+  void RoutingGraph::AddNode(const RouteNode& routeNode)
+  {
+    nodeIds.push_back(routeNode.GetId());
+    nodeCoords.push_back(routeNode.GetCoord());
+    nodeFileOffsets.push_back(routeNode.GetFileOffset());
+
+    objectOffsets.push_back(static_cast<uint32_t>(objects.size()));
+    objects.insert(objects.end(),
+                   routeNode.objects.begin(),
+                   routeNode.objects.end());
+
+    pathOffsets.push_back(static_cast<uint32_t>(pathTargetIds.size()));
+
+    for (const auto& path : routeNode.paths) {
+      pathTargetIds.push_back(path.id);
+      pathDistances.push_back(path.distance);
+      pathObjects.push_back(path.objectIndex);
+      pathFlags.push_back(path.flags);
+    }
+
+    excludeOffsets.push_back(static_cast<uint32_t>(excludes.size()));
+    excludes.insert(excludes.end(),
+                    routeNode.excludes.begin(),
+                    routeNode.excludes.end());
+  }
+
+  /**
+   * Build the id hash table and resolve the targets of all paths to node
+   * indices. Paths to nodes, that are not part of the graph, are dropped,
+   * since they cannot be followed anyway.
+   *
+   * @return
+   *    Number of dropped paths
+   */
+  size_t RoutingGraph::Finish()
+  {
+    size_t tableSize=1;
+
+    while (tableSize<nodeIds.size()+nodeIds.size()/2+1) {
+      tableSize*=2;
+    }
+
+    idTable.assign(tableSize,noNode);
+    idMask=tableSize-1;
+
+    for (uint32_t node=0; node<nodeIds.size(); node++) {
+      size_t slot=Hash(nodeIds[node]) & idMask;
+
+      while (idTable[slot]!=noNode) {
+        slot=(slot+1) & idMask;
+      }
+
+      idTable[slot]=node;
+    }
+
+    objectOffsets.push_back(static_cast<uint32_t>(objects.size()));
+    pathOffsets.push_back(static_cast<uint32_t>(pathTargetIds.size()));
+    excludeOffsets.push_back(static_cast<uint32_t>(excludes.size()));
+
+    // Resolve and compact the paths in place
+    size_t   droppedCount=0;
+    uint32_t pathCount=0;
+
+    pathTargets.reserve(pathTargetIds.size());
+
+    for (uint32_t node=0; node<nodeIds.size(); node++) {
+      uint32_t begin=pathOffsets[node];
+      uint32_t end=pathOffsets[node+1];
+
+      pathOffsets[node]=pathCount;
+
+      for (uint32_t path=begin; path<end; path++) {
+        uint32_t target=GetNodeIndex(pathTargetIds[path]);
+
+        if (target==noNode) {
+          droppedCount++;
+          continue;
+        }
+
+        pathTargets.push_back(target);
+        pathDistances[pathCount]=pathDistances[path];
+        pathObjects[pathCount]=pathObjects[path];
+        pathFlags[pathCount]=pathFlags[path];
+        pathCount++;
+      }
+    }
+
+    pathOffsets[nodeIds.size()]=pathCount;
+
+    pathDistances.resize(pathCount);
+    pathDistances.shrink_to_fit();
+    pathObjects.resize(pathCount);
+    pathObjects.shrink_to_fit();
+    pathFlags.resize(pathCount);
+    pathFlags.shrink_to_fit();
+    pathTargets.shrink_to_fit();
+
+    pathTargetIds.clear();
+    pathTargetIds.shrink_to_fit();
+
+    return droppedCount;
+  }
+
+  /**
+   * Fill the given route node with the data of the node with the given index.
+   * The vectors of the route node are reused, so filling the same route node
+   * again does not allocate memory.
+   */
+  void RoutingGraph::GetRouteNode(uint32_t node,
+                                  RouteNode& routeNode) const
+  {
+    assert(node<nodeIds.size());
+
+    routeNode.Initialize(nodeFileOffsets[node],
+                         Point(static_cast<uint8_t>(nodeIds[node] & 0xffu),
+                               nodeCoords[node]));
+
+    routeNode.objects.assign(objects.begin()+objectOffsets[node],
+                             objects.begin()+objectOffsets[node+1]);
+
+    routeNode.paths.resize(pathOffsets[node+1]-pathOffsets[node]);
+
+    for (uint32_t p=pathOffsets[node]; p<pathOffsets[node+1]; p++) {
+      RouteNode::Path& path=routeNode.paths[p-pathOffsets[node]];
+
+      path.id=nodeIds[pathTargets[p]];
+      path.distance=pathDistances[p];
+      path.objectIndex=pathObjects[p];
+      path.flags=pathFlags[p];
+    }
+
+    routeNode.excludes.assign(excludes.begin()+excludeOffsets[node],
+                              excludes.begin()+excludeOffsets[node+1]);
+  }
+
+  /**
+   * Return the memory used by the arrays of the graph in bytes
+   */
+  size_t RoutingGraph::GetMemoryUsage() const
+  {
+    return nodeIds.capacity()*sizeof(Id)+
+           nodeCoords.capacity()*sizeof(GeoCoord)+
+           nodeFileOffsets.capacity()*sizeof(FileOffset)+
+           objectOffsets.capacity()*sizeof(uint32_t)+
+           objects.capacity()*sizeof(RouteNode::ObjectData)+
+           pathOffsets.capacity()*sizeof(uint32_t)+
+           pathTargets.capacity()*sizeof(uint32_t)+
+           pathDistances.capacity()*sizeof(Distance)+
+           pathObjects.capacity()*sizeof(uint8_t)+
+           pathFlags.capacity()*sizeof(uint8_t)+
+           excludeOffsets.capacity()*sizeof(uint32_t)+
+           excludes.capacity()*sizeof(RouteNode::Exclude)+
+           idTable.capacity()*sizeof(uint32_t);
+  }
+}
@@ -20,6 +20,7 @@
 #include <osmscout/routing/RoutingProfile.h>
 
 #include <limits>
+#include <sstream>
 
 #include <osmscout/util/Logger.h>
 
@@ -32,6 +33,16 @@ namespace osmscout {
     // no code
   }
 
+  bool RoutingProfile::HasTimeCosts() const
+  {
+    return false;
+  }
+
+  std::string RoutingProfile::GetCostParameters() const
+  {
+    return "";
+  }
+
   AbstractRoutingProfile::AbstractRoutingProfile(const TypeConfigRef& typeConfig)
    : typeConfig(typeConfig),
      accessReader(*typeConfig),
@@ -190,6 +201,28 @@ namespace osmscout {
     speeds[type->GetIndex()]=speed;
   }
 
+  /**
+   * Return vehicle, maximum speed of the vehicle and the speeds of all usable types
+   * as a textual description for GetCostParameters()
+   */
+  std::string AbstractRoutingProfile::GetCommonCostParameters() const
+  {
+    std::ostringstream stream;
+
+    stream.imbue(std::locale::classic());
+    stream << "vehicle=" << static_cast<int>(vehicle);
+    stream << ";vehicleMaxSpeed=" << vehicleMaxSpeed;
+
+    for (const auto& type : typeConfig->GetTypes()) {
+      if (type->GetIndex()<speeds.size() &&
+          speeds[type->GetIndex()]>0.0) {
+        stream << ";" << type->GetName() << "=" << speeds[type->GetIndex()];
+      }
+    }
+
+    return stream.str();
+  }
+
   bool AbstractRoutingProfile::CanUse(const RouteNode& currentNode,
                                       const std::vector<ObjectVariantData>& objectVariantData,
                                       size_t pathIndex) const
@@ -218,15 +251,16 @@ namespace osmscout {
     return index<speeds.size() && speeds[index]>0.0;
   }
 
-  bool AbstractRoutingProfile::CanUse(const Way& way) const
+  bool AbstractRoutingProfile::CanUse(const TypeInfoRef& type,
+                                      const FeatureValueBuffer& featureValueBuffer) const
   {
-    size_t index=way.GetType()->GetIndex();
+    size_t index=type->GetIndex();
 
     if (index>=speeds.size() || speeds[index]<=0.0) {
       return false;
     }
 
-    AccessFeatureValue *accessValue=accessReader.GetValue(way.GetFeatureValueBuffer());
+    AccessFeatureValue *accessValue=accessReader.GetValue(featureValueBuffer);
 
     if (accessValue!=nullptr) {
       switch (vehicle) {
@@ -244,13 +278,13 @@ namespace osmscout {
     else {
       switch (vehicle) {
       case vehicleFoot:
-        return way.GetType()->CanRouteFoot();
+        return type->CanRouteFoot();
         break;
       case vehicleBicycle:
-        return way.GetType()->CanRouteBicycle();
+        return type->CanRouteBicycle();
         break;
       case vehicleCar:
-        return way.GetType()->CanRouteCar();
+        return type->CanRouteCar();
         break;
       }
     }
@@ -258,6 +292,18 @@ namespace osmscout {
     return false;
   }
 
+  bool AbstractRoutingProfile::CanUse(const Way& way) const
+  {
+    return CanUse(way.GetType(),
+                  way.GetFeatureValueBuffer());
+  }
+
+  bool AbstractRoutingProfile::CanUse(const WayView& way) const
+  {
+    return CanUse(way.GetType(),
+                  way.GetFeatureValueBuffer());
+  }
+
   bool AbstractRoutingProfile::CanUseForward(const Way& way) const
   {
     size_t index=way.GetType()->GetIndex();
@@ -344,9 +390,44 @@ namespace osmscout {
     // no code
   }
 
+  std::string ShortestPathRoutingProfile::GetCostParameters() const
+  {
+    return "shortest;"+GetCommonCostParameters();
+  }
+
   FastestPathRoutingProfile::FastestPathRoutingProfile(const TypeConfigRef& typeConfig)
   : AbstractRoutingProfile(typeConfig)
   {
     // no code
   }
+
+  /**
+   * Enable or disable the penalty for changing the way at a junction. The
+   * ParametrizeFor...() methods set it for the vehicle.
+   */
+  void FastestPathRoutingProfile::SetJunctionPenalty(bool applyJunctionPenalty)
+  {
+    this->applyJunctionPenalty=applyJunctionPenalty;
+  }
+
+  /**
+   * The junction penalty is part of the parameters, precalculated routing
+   * data without it must not be used for a profile applying it
+   */
+  std::string FastestPathRoutingProfile::GetCostParameters() const
+  {
+    std::ostringstream stream;
+
+    stream.imbue(std::locale::classic());
+    stream << "fastest;" << GetCommonCostParameters();
+    stream << ";junctionPenalty=" << (applyJunctionPenalty ? 1 : 0);
+
+    if (applyJunctionPenalty) {
+      stream << ";penaltySameType=" << penaltySameType.AsMeter();
+      stream << ";penaltyDifferentType=" << penaltyDifferentType.AsMeter();
+      stream << ";maxPenalty=" << maxPenalty.count();
+    }
+
+    return stream.str();
+  }
 }
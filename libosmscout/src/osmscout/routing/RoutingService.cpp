@@ -51,7 +51,8 @@ namespace osmscout {
   }
 
   RouterParameter::RouterParameter()
-  : debugPerformance(false)
+  : debugPerformance(false),
+    inMemoryGraph(false)
   {
     // no code
   }
@@ -61,11 +62,21 @@ namespace osmscout {
     debugPerformance=debug;
   }
 
+  void RouterParameter::SetInMemoryGraph(bool inMemoryGraph)
+  {
+    this->inMemoryGraph=inMemoryGraph;
+  }
+
   bool RouterParameter::IsDebugPerformance() const
   {
     return debugPerformance;
   }
 
+  bool RouterParameter::IsInMemoryGraph() const
+  {
+    return inMemoryGraph;
+  }
+
   RoutingProgress::~RoutingProgress()
   {
     // no code
@@ -81,6 +92,21 @@ namespace osmscout {
     this->progress=progress;
   }
 
+  void RoutingParameter::SetBidirectional(bool bidirectional)
+  {
+    this->bidirectional=bidirectional;
+  }
+
+  void RoutingParameter::SetThreadCount(size_t threadCount)
+  {
+    this->threadCount=threadCount;
+  }
+
+  void RoutingParameter::SetDepartureTime(const std::optional<Timestamp>& departureTime)
+  {
+    this->departureTime=departureTime;
+  }
+
   std::string RoutingService::GetDataFilename(const std::string& filenamebase)
   {
     return filenamebase+".dat";
@@ -96,6 +122,36 @@ namespace osmscout {
     return filenamebase+".idx";
   }
 
+  std::string RoutingService::GetContractionHierarchyFilename(const std::string& filenamebase,
+                                                              Vehicle vehicle)
+  {
+    switch (vehicle) {
+    case vehicleFoot:
+      return filenamebase+"_ch_foot.dat";
+    case vehicleBicycle:
+      return filenamebase+"_ch_bicycle.dat";
+    case vehicleCar:
+      return filenamebase+"_ch_car.dat";
+    }
+
+    return filenamebase+"_ch.dat";
+  }
+
+  std::string RoutingService::GetPartitionFilename(const std::string& filenamebase)
+  {
+    return filenamebase+"_partition.dat";
+  }
+
+  std::string RoutingService::GetSpeedProfileFilename(const std::string& filenamebase)
+  {
+    return filenamebase+"_speed.dat";
+  }
+
+  std::string RoutingService::GetSnapIndexFilename(const std::string& filenamebase)
+  {
+    return filenamebase+"_snap.dat";
+  }
+
   const char* const RoutingService::FILENAME_INTERSECTIONS_DAT   = "intersections.dat";
   const char* const RoutingService::FILENAME_INTERSECTIONS_IDX   = "intersections.idx";
 
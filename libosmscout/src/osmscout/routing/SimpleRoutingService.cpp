@@ -23,9 +23,11 @@
 
 #include <osmscout/system/Assert.h>
 
+#include <osmscout/util/File.h>
 #include <osmscout/util/Geometry.h>
 #include <osmscout/util/Logger.h>
 #include <osmscout/util/StopClock.h>
+#include <osmscout/util/WorkQueue.h>
 
 #include <osmscout/routing/RoutingService.h>
 #include <osmscout/routing/SimpleRoutingService.h>
@@ -75,11 +77,97 @@ namespace osmscout {
     return false;
   }
 
+  /**
+   * Filter for the snap index, accepting segments of ways usable by the given
+   * profile. Ways are loaded at most once, the result is cached in usableWays.
+   */
+  RouteSnapIndex::SegmentFilter SimpleRoutingService::GetSnapFilter(const RoutingProfile& profile,
+                                                                     std::unordered_map<FileOffset,bool>& usableWays) const
+  {
+    WayDataFileRef wayDataFile=database->GetWayDataFile();
+
+    return [this,&profile,&usableWays,wayDataFile](const RouteSnapIndex::Segment& segment) {
+      // Router cannot handle areas as start or target node
+      if (segment.object.GetType()!=refWay ||
+          !wayDataFile) {
+        return false;
+      }
+
+      auto entry=usableWays.find(segment.object.GetFileOffset());
+
+      if (entry!=usableWays.end()) {
+        return entry->second;
+      }
+
+      WayRef way;
+      bool   usable=wayDataFile->GetByOffset(segment.object.GetFileOffset(),way) &&
+                    profile.CanUse(*way) &&
+                    HasNodeWithId(way->nodes);
+
+      usableWays[segment.object.GetFileOffset()]=usable;
+
+      return usable;
+    };
+  }
+
+  /**
+   * Collect the candidates of each point for map matching: the closest node
+   * of each usable way within the search radius. Without snap index only the
+   * closest routable node is used.
+   */
+  void SimpleRoutingService::GetMapMatchCandidates(const RoutingProfile& profile,
+                                                   const std::vector<GeoCoord>& points,
+                                                   const MapMatchParameter& matchParameter,
+                                                   std::vector<std::vector<MapMatchCandidate>>& candidates) const
+  {
+    candidates.assign(points.size(),std::vector<MapMatchCandidate>());
+
+    if (!snapIndex) {
+      std::vector<RoutePositionResult> positions=GetClosestRoutableNodes(points,
+                                                                         profile,
+                                                                         matchParameter.searchRadius);
+
+      for (size_t p=0; p<points.size(); p++) {
+        if (positions[p].IsValid()) {
+          candidates[p].push_back(MapMatchCandidate{positions[p].GetRoutePosition(),
+                                                    positions[p].GetDistance()});
+        }
+      }
+
+      return;
+    }
+
+    std::unordered_map<FileOffset,bool> usableWays;
+    RouteSnapIndex::SegmentFilter       filter=GetSnapFilter(profile,usableWays);
+    std::vector<RouteSnapIndex::Match>  matches;
+
+    for (size_t p=0; p<points.size(); p++) {
+      if (!snapIndex->GetCandidates(points[p],
+                                    static_cast<VehicleMask>(profile.GetVehicle()),
+                                    matchParameter.searchRadius,
+                                    filter,
+                                    matchParameter.maxCandidates,
+                                    matches)) {
+        continue;
+      }
+
+      for (const auto& match : matches) {
+        candidates[p].push_back(MapMatchCandidate{RoutePosition(match.segment.object,match.GetNodeIndex(),/*database*/0),
+                                                  match.distance});
+      }
+    }
+  }
+
   Vehicle SimpleRoutingService::GetVehicle(const RoutingProfile& profile)
   {
     return profile.GetVehicle();
   }
 
+  bool SimpleRoutingService::HasTimeCosts(const RoutingProfile& profile)
+  {
+    return profile.HasTimeCosts();
+  }
+
   bool SimpleRoutingService::CanUse(const RoutingProfile& profile,
                                     const DatabaseId /*database*/,
                                     const RouteNode& routeNode,
@@ -119,6 +207,27 @@ namespace osmscout {
     return profile.GetCosts(*way,wayLength);
   }
 
+  Duration SimpleRoutingService::GetTime(const RoutingProfile& profile,
+                                         const DatabaseId /*database*/,
+                                         const RouteNode& routeNode,
+                                         size_t pathIndex)
+  {
+    return profile.GetTime(routeNode,routingDatabase.GetObjectVariantData(),pathIndex);
+  }
+
+  Duration SimpleRoutingService::GetTime(const RoutingProfile& profile,
+                                         const DatabaseId /*database*/,
+                                         const WayRef &way,
+                                         const Distance &wayLength)
+  {
+    return profile.GetTime(*way,wayLength);
+  }
+
+  const SpeedProfiles* SimpleRoutingService::GetSpeedProfiles(const DatabaseId /*database*/)
+  {
+    return routingDatabase.GetSpeedProfiles();
+  }
+
   double SimpleRoutingService::GetEstimateCosts(const RoutingProfile& profile,
                                                 const DatabaseId /*database*/,
                                                 const Distance &targetDistance)
@@ -179,6 +288,13 @@ namespace osmscout {
                                         node);
   }
 
+  bool SimpleRoutingService::GetRouteNodePredecessors(const DBId &id,
+                                                      std::vector<std::pair<Id,ObjectFileRef>> &sources)
+  {
+    return routingDatabase.GetPredecessors(id.id,
+                                           sources);
+  }
+
   bool SimpleRoutingService::GetWayByOffset(const DBFileOffset &offset,
                                             WayRef &way)
   {
@@ -317,7 +433,8 @@ namespace osmscout {
   }
 
   /**
-   * Opens the routing service. This loads the routing graph for the given vehicle
+   * Opens the routing service. This loads the routing graph for the given vehicle.
+   * If requested by the RouterParameter, the complete graph is loaded into memory.
    *
    * @return
    *    false on error, else true
@@ -332,6 +449,26 @@ namespace osmscout {
       return false;
     }
 
+    if (inMemoryGraph &&
+        !routingDatabase.LoadGraph()) {
+      routingDatabase.Close();
+      return false;
+    }
+
+    // The snap index is optional, without it the area indexes are used
+    std::string snapIndexFilename=AppendFileToDir(path,
+                                                  RoutingService::GetSnapIndexFilename(filenamebase));
+
+    if (ExistsInFilesystem(snapIndexFilename)) {
+      snapIndex=std::make_shared<RouteSnapIndex>();
+
+      if (!snapIndex->Open(snapIndexFilename,
+                           database->GetParameter().GetRouterDataMMap())) {
+        log.Warn() << "Cannot open snap index '" << snapIndexFilename << "'";
+        snapIndex.reset();
+      }
+    }
+
     isOpen=true;
 
     return true;
@@ -354,6 +491,7 @@ namespace osmscout {
   void SimpleRoutingService::Close()
   {
     routingDatabase.Close();
+    snapIndex.reset();
 
     isOpen=false;
   }
@@ -369,6 +507,27 @@ namespace osmscout {
     return database->GetTypeConfig();
   }
 
+  /**
+   * Replace the speed profiles loaded from the database directory on Open()
+   * (see RoutingService::GetSpeedProfileFilename()). Must be called after
+   * Open() and not while routing.
+   */
+  void SimpleRoutingService::SetSpeedProfiles(const SpeedProfilesRef& speedProfiles)
+  {
+    routingDatabase.SetSpeedProfiles(speedProfiles);
+  }
+
+  /**
+   * Replace the snap index opened from the database directory on Open()
+   * (see RoutingService::GetSnapIndexFilename()). Passing an empty reference
+   * falls back to searching the area indexes. Must be called after Open()
+   * and not while routing.
+   */
+  void SimpleRoutingService::SetSnapIndex(const RouteSnapIndexRef& snapIndex)
+  {
+    this->snapIndex=snapIndex;
+  }
+
   /**
    * Calculate a route going through all the via points
    *
@@ -440,6 +599,78 @@ namespace osmscout {
     return result;
   }
 
+  /**
+   * Match the points of a trace (for example a GPS track) to the routing
+   * graph, see AbstractRoutingService::MatchTrack(). The candidates of each
+   * point are taken from the snap index.
+   *
+   * @param profile
+   *    Profile to use
+   * @param points
+   *    The measured points of the trace
+   * @param matchParameter
+   *    Parameters of the hidden Markov model
+   * @param parameter
+   *    Optional breaker
+   * @return
+   *    The matched position of each point and the routes between them
+   */
+  MapMatchResult SimpleRoutingService::MatchTrack(RoutingProfile& profile,
+                                                  const std::vector<GeoCoord>& points,
+                                                  const MapMatchParameter& matchParameter,
+                                                  const RoutingParameter& parameter)
+  {
+    std::vector<std::vector<MapMatchCandidate>> candidates;
+
+    GetMapMatchCandidates(profile,
+                          points,
+                          matchParameter,
+                          candidates);
+
+    return AbstractRoutingService<RoutingProfile>::MatchTrack(profile,
+                                                              points,
+                                                              candidates,
+                                                              matchParameter,
+                                                              parameter);
+  }
+
+  /**
+   * Match multiple traces, returning one result for each trace. The traces
+   * are matched in parallel (see RoutingParameter::SetThreadCount()).
+   */
+  std::vector<MapMatchResult> SimpleRoutingService::MatchTracks(RoutingProfile& profile,
+                                                                const std::vector<std::vector<GeoCoord>>& tracks,
+                                                                const MapMatchParameter& matchParameter,
+                                                                const RoutingParameter& parameter)
+  {
+    std::vector<MapMatchResult> results(tracks.size());
+
+    if (tracks.empty()) {
+      return results;
+    }
+
+    std::vector<std::function<bool()>> tasks;
+
+    tasks.reserve(tracks.size());
+
+    for (size_t t=0; t<tracks.size(); t++) {
+      tasks.emplace_back([this,&profile,&tracks,&matchParameter,&parameter,&results,t]() {
+        results[t]=MatchTrack(profile,
+                              tracks[t],
+                              matchParameter,
+                              parameter);
+
+        return results[t].Success();
+      });
+    }
+
+    // Failed matches are reported by their result
+    RunConcurrently(tasks,
+                    parameter.GetThreadCount());
+
+    return results;
+  }
+
   std::map<DatabaseId, std::string> SimpleRoutingService::GetDatabaseMapping() const
   {
     std::map<DatabaseId, std::string> mapping;
@@ -467,6 +698,9 @@ namespace osmscout {
    * @note The actual object may not be within the given radius
    * due to internal search index resolution.
    *
+   * @note If a RouteSnapIndex is available, it is used instead of the
+   * area indexes.
+   *
    * @param coord
    *    coordinate of the search center
    * @param profile
@@ -481,6 +715,22 @@ namespace osmscout {
                                                                    const RoutingProfile& profile,
                                                                    const Distance &radius) const
   {
+    if (snapIndex) {
+      std::unordered_map<FileOffset,bool> usableWays;
+      RouteSnapIndex::Match               match;
+
+      if (!snapIndex->GetClosest(coord,
+                                 static_cast<VehicleMask>(profile.GetVehicle()),
+                                 radius,
+                                 GetSnapFilter(profile,usableWays),
+                                 match)) {
+        return RoutePositionResult();
+      }
+
+      return RoutePositionResult(RoutePosition(match.segment.object,match.GetNodeIndex(),/*database*/0),
+                                 match.distance);
+    }
+
     TypeConfigRef       typeConfig=database->GetTypeConfig();
     AreaAreaIndexRef    areaAreaIndex=database->GetAreaAreaIndex();
     AreaWayIndexRef     areaWayIndex=database->GetAreaWayIndex();
@@ -521,6 +771,7 @@ namespace osmscout {
     std::vector<DataBlockSpan>     wayAreaSpans;
     std::vector<osmscout::AreaRef> areas;
     std::vector<osmscout::WayRef>  ways;
+    std::vector<osmscout::WayView> wayViews;
 
     if (!areaWayIndex->GetOffsets(boundingBox,
                                   wayRoutableTypes,
@@ -541,10 +792,23 @@ namespace osmscout {
     std::sort(wayWayOffsets.begin(),
               wayWayOffsets.end());
 
-    if (!wayDataFile->GetByOffset(wayWayOffsets.begin(),
-                                  wayWayOffsets.end(),
-                                  wayWayOffsets.size(),
-                                  ways)) {
+    // If the data file is memory mapped, we avoid copying the way nodes
+    // and just iterate over the encoded coordinates
+    bool useWayViews=wayDataFile->IsMemoryMapped();
+
+    if (useWayViews) {
+      if (!wayDataFile->GetViewsByOffset(wayWayOffsets.begin(),
+                                         wayWayOffsets.end(),
+                                         wayWayOffsets.size(),
+                                         wayViews)) {
+        log.Error() << "Error reading ways in area!";
+        return position;
+      }
+    }
+    else if (!wayDataFile->GetByOffset(wayWayOffsets.begin(),
+                                       wayWayOffsets.end(),
+                                       wayWayOffsets.size(),
+                                       ways)) {
       log.Error() << "Error reading ways in area!";
       return position;
     }
@@ -580,6 +844,25 @@ namespace osmscout {
       }
     }
 
+    auto matchSegment=[&](const ObjectFileRef& object,
+                          size_t index,
+                          const GeoCoord& from,
+                          const GeoCoord& to) {
+      double r, intersectLon, intersectLat;
+      double distance=DistanceToSegment(coord.GetLon(),coord.GetLat(),from.GetLon(),from.GetLat(),
+                                        to.GetLon(),to.GetLat(), r, intersectLon, intersectLat);
+      if (distance<minDistance) {
+        minDistance=distance;
+        if(r<0.5){
+          position=RoutePositionResult(RoutePosition(object,index,/*database*/0),
+                                       GetEllipsoidalDistance(coord, GeoCoord(intersectLat, intersectLon)));
+        } else {
+          position=RoutePositionResult(RoutePosition(object,index+1,/*database*/0),
+                                       GetEllipsoidalDistance(coord, GeoCoord(intersectLat, intersectLon)));
+        }
+      }
+    };
+
     for (const auto& way : ways) {
       if (!profile.CanUse(*way)) {
         continue;
@@ -589,27 +872,86 @@ namespace osmscout {
         continue;
       }
 
-
       for (size_t i=0;  i<way->nodes.size()-1; i++) {
-        double r, intersectLon, intersectLat;
-        double distance=DistanceToSegment(coord.GetLon(),coord.GetLat(),way->nodes[i].GetLon(),way->nodes[i].GetLat(),
-                                          way->nodes[i+1].GetLon(),way->nodes[i+1].GetLat(), r, intersectLon, intersectLat);
-        if (distance<minDistance) {
-          minDistance=distance;
-          if(r<0.5){
-            position=RoutePositionResult(RoutePosition(way->GetObjectFileRef(),i,/*database*/0),
-                                         GetEllipsoidalDistance(coord, GeoCoord(intersectLat, intersectLon)));
-          } else {
-            position=RoutePositionResult(RoutePosition(way->GetObjectFileRef(),i+1,/*database*/0),
-                                         GetEllipsoidalDistance(coord, GeoCoord(intersectLat, intersectLon)));
-          }
-        }
+        matchSegment(way->GetObjectFileRef(),
+                     i,
+                     way->nodes[i].GetCoord(),
+                     way->nodes[i+1].GetCoord());
+      }
+    }
+
+    for (const auto& way : wayViews) {
+      if (!profile.CanUse(way)) {
+        continue;
+      }
+
+      if (!way.GetNodes().HasNodeWithId()) {
+        continue;
+      }
+
+      auto     node=way.GetNodes().begin();
+      GeoCoord from=*node;
+
+      for (++node; node!=way.GetNodes().end(); ++node) {
+        matchSegment(way.GetObjectFileRef(),
+                     node.GetIndex()-1,
+                     from,
+                     *node);
+
+        from=*node;
       }
     }
 
     return position;
   }
 
+  /**
+   * Batched version of GetClosestRoutableNode(), returning one result for
+   * each coordinate. With a snap index all coordinates are resolved using
+   * the same file scanner and ways are loaded only once.
+   */
+  std::vector<RoutePositionResult> SimpleRoutingService::GetClosestRoutableNodes(const std::vector<GeoCoord>& coords,
+                                                                                 const RoutingProfile& profile,
+                                                                                 const Distance &radius) const
+  {
+    std::vector<RoutePositionResult> positions;
+
+    positions.reserve(coords.size());
+
+    if (!snapIndex) {
+      for (const auto& coord : coords) {
+        positions.push_back(GetClosestRoutableNode(coord,profile,radius));
+      }
+
+      return positions;
+    }
+
+    std::unordered_map<FileOffset,bool>               usableWays;
+    std::vector<std::optional<RouteSnapIndex::Match>> matches;
+
+    if (!snapIndex->GetClosest(coords,
+                               static_cast<VehicleMask>(profile.GetVehicle()),
+                               radius,
+                               GetSnapFilter(profile,usableWays),
+                               matches)) {
+      positions.resize(coords.size());
+
+      return positions;
+    }
+
+    for (const auto& match : matches) {
+      if (match) {
+        positions.emplace_back(RoutePosition(match->segment.object,match->GetNodeIndex(),/*database*/0),
+                               match->distance);
+      }
+      else {
+        positions.emplace_back();
+      }
+    }
+
+    return positions;
+  }
+
   /**
    * Returns the closest routeable object (area or way) relative
    * to the given coordinate.
@@ -623,6 +965,9 @@ namespace osmscout {
    * @note The actual object may not be within the given radius
    * due to internal search index resolution.
    *
+   * @note If a RouteSnapIndex is available, it is used instead of the
+   * area indexes.
+   *
    * @note This is a simple solution that does not track any spast state.
    * A better implementation should hold on recently travels coordinates and
    * ways or areas and do some tolerance error handling in case of GPS
@@ -663,7 +1008,24 @@ namespace osmscout {
     WayRef   closestWay;
     AreaRef  closestArea;
 
-    if (!routeableWayTypes.Empty()) {
+    if (snapIndex) {
+      RouteSnapIndex::Match match;
+
+      if (snapIndex->GetClosest(location,
+                                static_cast<VehicleMask>(vehicle),
+                                maxRadius,
+                                nullptr,
+                                match)) {
+        DBFileOffset offset(/*database*/0,match.segment.object.GetFileOffset());
+
+        if (match.segment.object.GetType()==refWay ?
+            GetWayByOffset(offset,closestWay) :
+            GetAreaByOffset(offset,closestArea)) {
+          closestDistance=match.distance;
+        }
+      }
+    }
+    else if (!routeableWayTypes.Empty()) {
       WayRegionSearchResult waySearchResult=database->LoadWaysInRadius(location,
                                                                        routeableWayTypes,
                                                                        maxRadius);
@@ -677,7 +1039,8 @@ namespace osmscout {
       }
     }
 
-    if (!routeableAreaTypes.Empty()) {
+    if (!snapIndex &&
+        !routeableAreaTypes.Empty()) {
       AreaRegionSearchResult areaSearchResult=database->LoadAreasInRadius(location,
                                                                           routeableAreaTypes,
                                                                           maxRadius);
@@ -0,0 +1,259 @@
+/*
+  This source is part of the libosmscout library
+  Copyright (C) 2026  Tim Teulings
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307  USA
+*/
+
+#include <osmscout/routing/SpeedProfiles.h>
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+
+#include <osmscout/util/FileScanner.h>
+#include <osmscout/util/FileWriter.h>
+#include <osmscout/util/Logger.h>
+
+namespace osmscout {
+
+  namespace {
+    const double secondsPerWeek=7*24*60*60.0;
+    const double mondayOffset=3*24*60*60.0; //!< The epoch starts on a thursday
+  }
+
+  SpeedProfiles::SpeedProfiles(uint16_t slotsPerDay,
+                               const std::chrono::minutes& utcOffset)
+  : slotsPerDay(std::max(slotsPerDay,uint16_t(1))),
+    utcOffset(utcOffset)
+  {
+    Rehash(16);
+  }
+
+  size_t SpeedProfiles::FindSlot(FileOffset wayOffset) const
+  {
+    uint64_t hash=wayOffset*0x9E3779B97F4A7C15ull;
+    size_t   slot=size_t(hash ^ (hash >> 32)) & mask;
+
+    while (wayOffsets[slot]!=emptyKey &&
+           wayOffsets[slot]!=wayOffset) {
+      slot=(slot+1) & mask;
+    }
+
+    return slot;
+  }
+
+  void SpeedProfiles::Rehash(size_t capacity)
+  {
+    std::vector<FileOffset> oldWayOffsets(capacity,emptyKey);
+    std::vector<uint32_t>   oldWayProfiles(capacity,noProfile);
+
+    wayOffsets.swap(oldWayOffsets);
+    wayProfiles.swap(oldWayProfiles);
+    mask=capacity-1;
+
+    for (size_t i=0; i<oldWayOffsets.size(); i++) {
+      if (oldWayOffsets[i]!=emptyKey) {
+        size_t slot=FindSlot(oldWayOffsets[i]);
+
+        wayOffsets[slot]=oldWayOffsets[i];
+        wayProfiles[slot]=oldWayProfiles[i];
+      }
+    }
+  }
+
+  /**
+   * Add a profile with one speed factor (in percent) for each slot of the week
+   * and return its index. Missing slots are filled with 100%, a factor of 0 is
+   * treated as 1%.
+   */
+  uint32_t SpeedProfiles::AddProfile(const std::vector<uint8_t>& slotFactors)
+  {
+    size_t profile=GetProfileCount();
+
+    factors.resize(factors.size()+GetSlotsPerWeek(),100);
+
+    for (size_t slot=0; slot<std::min(slotFactors.size(),GetSlotsPerWeek()); slot++) {
+      factors[profile*GetSlotsPerWeek()+slot]=std::max(slotFactors[slot],uint8_t(1));
+    }
+
+    return uint32_t(profile);
+  }
+
+  /**
+   * Assign the given profile to the way at the given file offset
+   */
+  void SpeedProfiles::AssignProfile(FileOffset wayOffset,
+                                    uint32_t profile)
+  {
+    assert(profile<GetProfileCount());
+
+    size_t slot=FindSlot(wayOffset);
+
+    if (wayOffsets[slot]==emptyKey) {
+      if ((wayCount+1)*2>wayOffsets.size()) {
+        Rehash(wayOffsets.size()*2);
+        slot=FindSlot(wayOffset);
+      }
+
+      wayOffsets[slot]=wayOffset;
+      wayCount++;
+    }
+
+    wayProfiles[slot]=profile;
+  }
+
+  /**
+   * Return the profile of the way at the given file offset or noProfile
+   */
+  uint32_t SpeedProfiles::GetProfile(FileOffset wayOffset) const
+  {
+    return wayProfiles[FindSlot(wayOffset)];
+  }
+
+  /**
+   * Return the speed factor (1.0 is the speed of the routing profile) of the
+   * given profile at the given time
+   */
+  double SpeedProfiles::GetSpeedFactor(uint32_t profile,
+                                       const Timestamp& time) const
+  {
+    assert(profile<GetProfileCount());
+
+    double seconds=std::fmod(std::chrono::duration_cast<std::chrono::duration<double>>(time.time_since_epoch()+utcOffset).count()+mondayOffset,
+                             secondsPerWeek);
+
+    if (seconds<0.0) {
+      seconds+=secondsPerWeek;
+    }
+
+    size_t         slotsPerWeek=GetSlotsPerWeek();
+    double         position=seconds*slotsPerWeek/secondsPerWeek;
+    size_t         slot=std::min(size_t(position),slotsPerWeek-1);
+    double         fraction=position-slot;
+    const uint8_t* profileFactors=&factors[profile*slotsPerWeek];
+
+    return (profileFactors[slot]*(1.0-fraction)+
+            profileFactors[(slot+1)%slotsPerWeek]*fraction)/100.0;
+  }
+
+  /**
+   * Return the speed factor of the way at the given file offset at the given
+   * time, 1.0 if the way has no profile
+   */
+  double SpeedProfiles::GetWaySpeedFactor(FileOffset wayOffset,
+                                          const Timestamp& time) const
+  {
+    uint32_t profile=GetProfile(wayOffset);
+
+    if (profile==noProfile) {
+      return 1.0;
+    }
+
+    return GetSpeedFactor(profile,time);
+  }
+
+  bool SpeedProfiles::Load(const std::string& filename)
+  {
+    FileScanner scanner;
+
+    try {
+      int32_t  offsetMinutes;
+      uint32_t profileCount;
+      uint32_t count;
+
+      scanner.Open(filename,
+                   FileScanner::Sequential,
+                   true);
+
+      scanner.Read(slotsPerDay);
+      scanner.Read(offsetMinutes);
+      scanner.Read(profileCount);
+
+      if (slotsPerDay==0) {
+        throw IOException(filename,"Cannot load speed profiles","Invalid slot count");
+      }
+
+      utcOffset=std::chrono::minutes(offsetMinutes);
+      factors.resize(profileCount*GetSlotsPerWeek());
+
+      scanner.Read(reinterpret_cast<char*>(factors.data()),
+                   factors.size());
+
+      // Like AddProfile(), a factor of 0 is treated as 1%
+      std::replace(factors.begin(),factors.end(),uint8_t(0),uint8_t(1));
+
+      scanner.Read(count);
+
+      wayCount=0;
+      Rehash(16);
+
+      for (uint32_t i=0; i<count; i++) {
+        FileOffset wayOffset;
+        uint32_t   profile;
+
+        scanner.ReadFileOffset(wayOffset);
+        scanner.ReadNumber(profile);
+
+        if (profile>=profileCount) {
+          throw IOException(filename,"Cannot load speed profiles","Invalid profile index");
+        }
+
+        AssignProfile(wayOffset,profile);
+      }
+
+      scanner.Close();
+    }
+    catch (IOException& e) {
+      log.Error() << e.GetDescription();
+      scanner.CloseFailsafe();
+      return false;
+    }
+
+    return true;
+  }
+
+  bool SpeedProfiles::Store(const std::string& filename) const
+  {
+    FileWriter writer;
+
+    try {
+      writer.Open(filename);
+
+      writer.Write(slotsPerDay);
+      writer.Write(static_cast<int32_t>(utcOffset.count()));
+      writer.Write(static_cast<uint32_t>(GetProfileCount()));
+      writer.Write(reinterpret_cast<const char*>(factors.data()),
+                   factors.size());
+      writer.Write(static_cast<uint32_t>(wayCount));
+
+      for (size_t slot=0; slot<wayOffsets.size(); slot++) {
+        if (wayOffsets[slot]!=emptyKey) {
+          writer.WriteFileOffset(wayOffsets[slot]);
+          writer.WriteNumber(wayProfiles[slot]);
+        }
+      }
+
+      writer.Close();
+    }
+    catch (IOException& e) {
+      log.Error() << e.GetDescription();
+      writer.CloseFailsafe();
+      return false;
+    }
+
+    return true;
+  }
+}
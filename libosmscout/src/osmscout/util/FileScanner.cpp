@@ -19,12 +19,15 @@
 
 #include <osmscout/private/Config.h>
 
+#include <osmscout/CoreFeatures.h>
+
 #include <osmscout/util/FileScanner.h>
 
 #include <errno.h>
 #include <stdio.h>
 #include <string.h>
 
+#include <algorithm>
 #include <limits>
 
 #if defined(HAVE_MMAP)
@@ -32,6 +35,16 @@
   #include <sys/mman.h>
 #endif
 
+#if defined(HAVE_PREAD)
+  #include <unistd.h>
+#endif
+
+#if defined(HAVE_LINUX_MEMPOLICY_H)
+  #include <linux/mempolicy.h>
+  #include <sys/syscall.h>
+  #include <unistd.h>
+#endif
+
 #if defined(HAVE_FCNTL_H)
   #include <fcntl.h>
 #endif
@@ -44,11 +57,16 @@
   #endif
 #endif
 
+#if defined(OSMSCOUT_HAVE_SSE2)
+  #include <emmintrin.h>
+#endif
+
 #include <osmscout/system/Assert.h>
 
 #include <osmscout/util/Exception.h>
 #include <osmscout/util/Logger.h>
 #include <osmscout/util/Number.h>
+#include <osmscout/util/StopClock.h>
 #include <osmscout/util/String.h>
 
 namespace osmscout {
@@ -57,8 +75,12 @@ namespace osmscout {
    : file(nullptr),
      hasError(true),
      buffer(nullptr),
+     ownsBuffer(true),
      size(0),
      offset(0),
+     bufferStart(0),
+     bufferEnd(0),
+     prefetched(false),
      byteBuffer(nullptr),
      byteBufferSize(0)
 #if defined(_WIN32)
@@ -92,6 +114,19 @@ namespace osmscout {
 
   void FileScanner::FreeBuffer()
   {
+    if (prefetched) {
+      buffer=nullptr;
+      prefetched=false;
+      prefetchBuffer.clear();
+      prefetchBuffer.shrink_to_fit();
+    }
+
+    // The mapping of another scanner is left to its owner
+    if (!ownsBuffer) {
+      buffer=nullptr;
+      ownsBuffer=true;
+    }
+
 #if defined(HAVE_MMAP)
     if (buffer!=nullptr) {
       if (munmap(buffer,size)!=0) {
@@ -112,9 +147,109 @@ namespace osmscout {
 #endif
   }
 
+  /**
+   * Touch each page of the memory mapped file, so that later accesses
+   * do not cause page faults (as long as the kernel does not evict them).
+   */
+  void FileScanner::PrefaultBuffer()
+  {
+    StopClock stopClock;
+
+#if defined(HAVE_MMAP) && defined(MADV_POPULATE_READ)
+    // Older kernels do not know MADV_POPULATE_READ, we touch the pages ourself then
+    bool populated=madvise(buffer,(size_t)size,MADV_POPULATE_READ)==0;
+#else
+    bool populated=false;
+#endif
+
+    if (!populated) {
+      const volatile char *data=buffer;
+      FileOffset          pageSize=4096;
+      char                value=0;
+
+#if defined(HAVE_MMAP)
+      long systemPageSize=sysconf(_SC_PAGESIZE);
+
+      if (systemPageSize>0) {
+        pageSize=(FileOffset)systemPageSize;
+      }
+#endif
+
+      for (FileOffset pos=0; pos<size; pos+=pageSize) {
+        value^=data[pos];
+      }
+
+      (void)value;
+    }
+
+    stopClock.Stop();
+
+    log.Debug() << "Prefaulting '" << filename << "' (" << ByteSizeToString(size) << "): " << stopClock.ResultString();
+  }
+
+  /**
+   * Apply the given FileScanner::MMapAdvice flags to the memory mapped file.
+   * Failures are logged, but are not fatal.
+   */
+  void FileScanner::ApplyMMapAdvice(uint8_t mmapAdvice)
+  {
+#if defined(HAVE_MMAP) && defined(MADV_HUGEPAGE)
+    if ((mmapAdvice & HugePages)!=0) {
+      // File backed hugepages require kernel support (CONFIG_READ_ONLY_THP_FOR_FS)
+      if (madvise(buffer,(size_t)size,MADV_HUGEPAGE)!=0) {
+        log.Warn() << "Cannot advise hugepages for mmaped file '" << filename << "' (" << strerror(errno) << ")";
+      }
+    }
+#endif
+
+    if ((mmapAdvice & Interleave)!=0) {
+#if defined(HAVE_LINUX_MEMPOLICY_H) && defined(SYS_get_mempolicy) && defined(SYS_set_mempolicy)
+      // Pages of the page cache are allocated following the memory policy of the
+      // thread faulting them in, so we interleave while prefaulting. Pages already
+      // in the page cache stay where they are.
+      constexpr unsigned long maxNode=sizeof(unsigned long)*8;
+      int                     oldMode=MPOL_DEFAULT;
+      unsigned long           oldNodes=0;
+      unsigned long           allowedNodes=0;
+
+      if (syscall(SYS_get_mempolicy,&oldMode,&oldNodes,maxNode,nullptr,0)!=0 ||
+          syscall(SYS_get_mempolicy,nullptr,&allowedNodes,maxNode,nullptr,MPOL_F_MEMS_ALLOWED)!=0) {
+        log.Warn() << "Cannot get NUMA memory policy for file '" << filename << "' (" << strerror(errno) << ")";
+        PrefaultBuffer();
+      }
+      else if (syscall(SYS_set_mempolicy,MPOL_INTERLEAVE,&allowedNodes,maxNode)!=0) {
+        log.Warn() << "Cannot set interleaving NUMA memory policy for file '" << filename << "' (" << strerror(errno) << ")";
+        PrefaultBuffer();
+      }
+      else {
+        PrefaultBuffer();
+
+        if (syscall(SYS_set_mempolicy,oldMode,oldMode==MPOL_DEFAULT ? nullptr : &oldNodes,maxNode)!=0) {
+          log.Error() << "Cannot restore NUMA memory policy after prefaulting file '" << filename << "' (" << strerror(errno) << ")";
+        }
+      }
+#else
+      PrefaultBuffer();
+#endif
+    }
+    else if ((mmapAdvice & Prefault)!=0) {
+      PrefaultBuffer();
+    }
+  }
+
+  /**
+   * Open the given file.
+   *
+   * If useMmap is true, the file is memory mapped if possible, the given
+   * mmapAdvice flags (see FileScanner::MMapAdvice) are then applied to
+   * the mapping.
+   *
+   * throws IOException on error
+   */
   void FileScanner::Open(const std::string& filename,
                          [[maybe_unused]] Mode mode,
-                         bool useMmap)
+                         bool useMmap,
+                         uint8_t mmapAdvice)
   {
     if (file!=nullptr) {
       throw IOException(filename,"Error opening file for reading","File already opened");
@@ -213,6 +348,8 @@ namespace osmscout {
       buffer=(char*)mmap(nullptr,(size_t)size,PROT_READ,MAP_PRIVATE,fileno(file),0);
       if (buffer!=MAP_FAILED) {
         offset=0;
+        bufferStart=0;
+        bufferEnd=this->size;
 #if defined(HAVE_POSIX_MADVISE)
         if (mode==FastRandom) {
           if (posix_madvise(buffer,(size_t)size,POSIX_MADV_WILLNEED)!=0) {
@@ -230,6 +367,8 @@ namespace osmscout {
           }
         }
 #endif
+
+        ApplyMMapAdvice(mmapAdvice);
       }
       else {
         log.Error() << "Cannot mmap file '" << filename << "' of size " << size << " (" << strerror(errno) << ")";
@@ -255,6 +394,10 @@ namespace osmscout {
 
         if (buffer!=nullptr) {
           offset=0;
+          bufferStart=0;
+          bufferEnd=this->size;
+
+          ApplyMMapAdvice(mmapAdvice);
         }
         else {
           log.Error() << "Cannot map view for file '" << filename << "' of size " << size << " (" << GetLastError() << ")";
@@ -269,6 +412,33 @@ namespace osmscout {
     hasError=false;
   }
 
+  /**
+   * Open the file of the given scanner and read from its memory mapping,
+   * using an own read cursor. This way concurrent readers of the same file
+   * share one mapping instead of mapping the file once per reader.
+   *
+   * The given scanner must stay open as long as this scanner is open. If
+   * it is not memory mapped, the file is opened without memory mapping.
+   *
+   * throws IOException on error
+   */
+  void FileScanner::Open(const FileScanner& mappedScanner,
+                         Mode mode)
+  {
+    Open(mappedScanner.filename,
+         mode,
+         false);
+
+    if (mappedScanner.IsMemoryMapped()) {
+      buffer=mappedScanner.buffer;
+      ownsBuffer=false;
+      size=mappedScanner.size;
+      offset=0;
+      bufferStart=0;
+      bufferEnd=size;
+    }
+  }
+
   /**
    * Closes the file.
    *
@@ -358,6 +528,11 @@ namespace osmscout {
     }
 
 #if defined(HAVE_MMAP) || defined(_WIN32)
+    if (prefetched &&
+        (pos<bufferStart || pos>=bufferEnd)) {
+      ClearPrefetch();
+    }
+
     if (buffer!=nullptr) {
       if (pos>=size) {
         hasError=true;
@@ -385,6 +560,129 @@ namespace osmscout {
     }
   }
 
+  /**
+   * Read the given range of the file with one request into an internal buffer.
+   * Until the position is set outside of the range (or ClearPrefetch() is called),
+   * all reads are served from this buffer, like for a memory mapped file. The
+   * position is set to the start of the range.
+   *
+   * Reading beyond the end of the range is an error, so the caller must either
+   * know the size of the data read or retry with a larger range.
+   *
+   * Prefetching is not done (and 0 is returned) if the file is memory mapped,
+   * or if the platform does not support it.
+   *
+   * @return
+   *    The number of bytes prefetched, which is less than requested if the range
+   *    exceeds the end of the file
+   *
+   * throws IOException on error
+   */
+  size_t FileScanner::Prefetch(FileOffset start,
+                             size_t bytes)
+  {
+    if (file==nullptr) {
+      throw IOException(filename,"Cannot prefetch","File not opened");
+    }
+
+    if (IsMemoryMapped()) {
+      return 0;
+    }
+
+#if defined(HAVE_MMAP) || defined(_WIN32)
+    if (prefetched) {
+      // Reading beyond the end of the previous range is not an error of the stream
+      buffer=nullptr;
+      prefetched=false;
+      hasError=false;
+    }
+
+    if (start>=size) {
+      hasError=true;
+      throw IOException(filename,"Cannot prefetch from "+std::to_string(start),"Position beyond file end");
+    }
+
+    bytes=(size_t)std::min((FileOffset)bytes,size-start);
+
+    prefetchBuffer.resize(bytes);
+
+#if defined(HAVE_PREAD)
+    size_t read=0;
+
+    while (read<bytes) {
+      ssize_t result=pread(fileno(file),
+                           prefetchBuffer.data()+read,
+                           bytes-read,
+                           (off_t)(start+read));
+
+      if (result<=0) {
+        if (result<0 && errno==EINTR) {
+          continue;
+        }
+
+        hasError=true;
+        throw IOException(filename,"Cannot prefetch "+std::to_string(bytes)+" bytes from "+std::to_string(start));
+      }
+
+      read+=(size_t)result;
+    }
+#else
+    SetPos(start);
+
+    if (fread(prefetchBuffer.data(),1,bytes,file)!=bytes) {
+      hasError=true;
+      throw IOException(filename,"Cannot prefetch "+std::to_string(bytes)+" bytes from "+std::to_string(start));
+    }
+#endif
+
+    buffer=prefetchBuffer.data();
+    bufferStart=start;
+    bufferEnd=start+bytes;
+    offset=start;
+    prefetched=true;
+    // A prefetch replaces any error state caused by reading beyond the previous range
+    hasError=false;
+
+    return bytes;
+#else
+    return 0;
+#endif
+  }
+
+  /**
+   * Stop serving reads from the prefetched range. The stream continues at the current position.
+   *
+   * throws IOException on error
+   */
+  void FileScanner::ClearPrefetch()
+  {
+    if (!prefetched) {
+      return;
+    }
+
+    FileOffset pos=offset;
+
+    buffer=nullptr;
+    prefetched=false;
+
+    if (!HasError()) {
+      SetPos(pos);
+    }
+  }
+
+  /**
+   * Fault in all pages of the memory mapped file (see FileScanner::MMapAdvice).
+   * Does nothing if the file is not memory mapped.
+   */
+  void FileScanner::PrefaultPages()
+  {
+    if (!IsMemoryMapped()) {
+      return;
+    }
+
+    PrefaultBuffer();
+  }
+
   /**
    * Returns the current position of the reading cursor in relation to the begining of the file
    *
@@ -440,12 +738,12 @@ namespace osmscout {
 
 #if defined(HAVE_MMAP) || defined(_WIN32)
     if (this->buffer!=nullptr) {
-      if (offset+(FileOffset)bytes-1>=size) {
+      if (offset+(FileOffset)bytes-1>=bufferEnd) {
         hasError=true;
         throw IOException(filename,"Cannot read byte array","Cannot read beyond end of file");
       }
 
-      char *res = &this->buffer[offset];
+      char *res = &this->buffer[offset-bufferStart];
 
       offset+=bytes;
 
@@ -470,12 +768,12 @@ namespace osmscout {
 
 #if defined(HAVE_MMAP) || defined(_WIN32)
     if (this->buffer!=nullptr) {
-      if (offset+(FileOffset)bytes-1>=size) {
+      if (offset+(FileOffset)bytes-1>=bufferEnd) {
         hasError=true;
         throw IOException(filename,"Cannot read byte array","Cannot read beyond end of file");
       }
 
-      memcpy(buffer,&this->buffer[offset],bytes);
+      memcpy(buffer,&this->buffer[offset-bufferStart],bytes);
 
       offset+=bytes;
 
@@ -500,21 +798,21 @@ namespace osmscout {
 
 #if defined(HAVE_MMAP) || defined(_WIN32)
     if (buffer!=nullptr) {
-      if (offset>=size) {
+      if (offset>=bufferEnd) {
         hasError=true;
         throw IOException(filename,"Cannot read string","Cannot read beyond end of file");
       }
 
       FileOffset start=offset;
 
-      while (offset<size &&
-             buffer[offset]!='\0') {
+      while (offset<bufferEnd &&
+             buffer[offset-bufferStart]!='\0') {
         offset++;
       }
 
-      value.assign(&buffer[start],offset-start);
+      value.assign(&buffer[start-bufferStart],offset-start);
 
-      if (offset>=size) {
+      if (offset>=bufferEnd) {
         hasError=true;
         throw IOException(filename,"Cannot read string","String has no terminating '\\0' before end of file");
       }
@@ -554,12 +852,12 @@ namespace osmscout {
 
 #if defined(HAVE_MMAP) || defined(_WIN32)
     if (buffer!=nullptr) {
-      if (offset>=size) {
+      if (offset>=bufferEnd) {
         hasError=true;
         throw IOException(filename,"Cannot read bool","Cannot read beyond end of file");
       }
 
-      value=buffer[offset];
+      value=buffer[offset-bufferStart];
       boolean=ConvertBool(value);
 
       offset++;
@@ -587,12 +885,12 @@ namespace osmscout {
 
 #if defined(HAVE_MMAP) || defined(_WIN32)
     if (buffer!=nullptr) {
-      if (offset>=size) {
+      if (offset>=bufferEnd) {
         hasError=true;
         throw IOException(filename,"Cannot read int8_t","Cannot read beyond end of file");
       }
 
-      number=(int8_t)buffer[offset];
+      number=(int8_t)buffer[offset-bufferStart];
 
       offset++;
 
@@ -617,12 +915,12 @@ namespace osmscout {
 
 #if defined(HAVE_MMAP) || defined(_WIN32)
     if (buffer!=nullptr) {
-      if (offset+2-1>=size) {
+      if (offset+2-1>=bufferEnd) {
         hasError=true;
         throw IOException(filename,"Cannot read int16_t","Cannot read beyond end of file");
       }
 
-      char    *dataPtr=&buffer[offset];
+      char    *dataPtr=&buffer[offset-bufferStart];
       int16_t add;
 
       add=(unsigned char)(*dataPtr);
@@ -671,12 +969,12 @@ namespace osmscout {
 
 #if defined(HAVE_MMAP) || defined(_WIN32)
     if (buffer!=nullptr) {
-      if (offset+4-1>=size) {
+      if (offset+4-1>=bufferEnd) {
         hasError=true;
         throw IOException(filename,"Cannot read int32_t","Cannot read beyond end of file");
       }
 
-      char    *dataPtr=&buffer[offset];
+      char    *dataPtr=&buffer[offset-bufferStart];
       int32_t add;
 
       add=(unsigned char)(*dataPtr);
@@ -745,12 +1043,12 @@ namespace osmscout {
 
 #if defined(HAVE_MMAP) || defined(_WIN32)
     if (buffer!=nullptr) {
-      if (offset+8-1>=size) {
+      if (offset+8-1>=bufferEnd) {
         hasError=true;
         throw IOException(filename,"Cannot read int64_t","Cannot read beyond end of file");
       }
 
-      char    *dataPtr=&buffer[offset];
+      char    *dataPtr=&buffer[offset-bufferStart];
       int64_t add;
 
       add=(unsigned char)(*dataPtr);
@@ -859,12 +1157,12 @@ namespace osmscout {
 
 #if defined(HAVE_MMAP) || defined(_WIN32)
     if (buffer!=nullptr) {
-      if (offset>=size) {
+      if (offset>=bufferEnd) {
         hasError=true;
         throw IOException(filename,"Cannot read uint8_t","Cannot read beyond end of file");
       }
 
-      number=(uint8_t)buffer[offset];
+      number=(uint8_t)buffer[offset-bufferStart];
 
       offset++;
 
@@ -889,12 +1187,12 @@ namespace osmscout {
 
 #if defined(HAVE_MMAP) || defined(_WIN32)
     if (buffer!=nullptr) {
-      if (offset+2-1>=size) {
+      if (offset+2-1>=bufferEnd) {
         hasError=true;
         throw IOException(filename,"Cannot read uint16_t","Cannot read beyond end of file");
       }
 
-      char     *dataPtr=&buffer[offset];
+      char     *dataPtr=&buffer[offset-bufferStart];
       uint16_t add;
 
       add=(unsigned char)(*dataPtr);
@@ -943,12 +1241,12 @@ namespace osmscout {
 
 #if defined(HAVE_MMAP) || defined(_WIN32)
     if (buffer!=nullptr) {
-      if (offset+4-1>=size) {
+      if (offset+4-1>=bufferEnd) {
         hasError=true;
         throw IOException(filename,"Cannot read uint32_t","Cannot read beyond end of file");
       }
 
-      char     *dataPtr=&buffer[offset];
+      char     *dataPtr=&buffer[offset-bufferStart];
       uint32_t add;
 
       add=(unsigned char)(*dataPtr);
@@ -1017,12 +1315,12 @@ namespace osmscout {
 
 #if defined(HAVE_MMAP) || defined(_WIN32)
     if (buffer!=nullptr) {
-      if (offset+8-1>=size) {
+      if (offset+8-1>=bufferEnd) {
         hasError=true;
         throw IOException(filename,"Cannot read uint64_t","Cannot read beyond end of file");
       }
 
-      char     *dataPtr=&buffer[offset];
+      char     *dataPtr=&buffer[offset-bufferStart];
       uint64_t add;
 
       add=(unsigned char)(*dataPtr);
@@ -1132,12 +1430,12 @@ namespace osmscout {
 
 #if defined(HAVE_MMAP) || defined(_WIN32)
     if (buffer!=nullptr) {
-      if (offset+bytes-1>=size) {
+      if (offset+bytes-1>=bufferEnd) {
         hasError=true;
         throw IOException(filename,"Cannot read size limited uint16_t","Cannot read beyond end of file");
       }
 
-      char     *dataPtr=&buffer[offset];
+      char     *dataPtr=&buffer[offset-bufferStart];
       uint16_t add;
 
       add=(unsigned char)(*dataPtr);
@@ -1191,12 +1489,12 @@ namespace osmscout {
 
 #if defined(HAVE_MMAP) || defined(_WIN32)
     if (buffer!=nullptr) {
-      if (offset+bytes-1>=size) {
+      if (offset+bytes-1>=bufferEnd) {
         hasError=true;
         throw IOException(filename,"Cannot read size limited uint32_t","Cannot read beyond end of file");
       }
 
-      char     *dataPtr=&buffer[offset];
+      char     *dataPtr=&buffer[offset-bufferStart];
       uint32_t add;
 
       add=(unsigned char)(*dataPtr);
@@ -1278,12 +1576,12 @@ namespace osmscout {
 
 #if defined(HAVE_MMAP) || defined(_WIN32)
     if (buffer!=nullptr) {
-      if (offset+bytes-1>=size) {
+      if (offset+bytes-1>=bufferEnd) {
         hasError=true;
         throw IOException(filename,"Cannot read size limited uint64_t","Cannot read beyond end of file");
       }
 
-      char     *dataPtr=&buffer[offset];
+      char     *dataPtr=&buffer[offset-bufferStart];
       uint64_t add;
 
       add=(unsigned char)(*dataPtr);
@@ -1429,7 +1727,7 @@ namespace osmscout {
 
 #if defined(HAVE_MMAP) || defined(_WIN32)
     if (buffer!=nullptr) {
-      if (offset+4-1>=size) {
+      if (offset+4-1>=bufferEnd) {
         hasError=true;
         throw IOException(filename,
                           "Cannot read color",
@@ -1475,12 +1773,12 @@ namespace osmscout {
 
 #if defined(HAVE_MMAP) || defined(_WIN32)
     if (buffer!=nullptr) {
-      if (offset+8-1>=size) {
+      if (offset+8-1>=bufferEnd) {
         hasError=true;
         throw IOException(filename,"Cannot read file offset","Cannot read beyond end of file");
       }
 
-      char       *dataPtr=&buffer[offset];
+      char       *dataPtr=&buffer[offset-bufferStart];
       FileOffset add;
 
       add=(unsigned char)(*dataPtr);
@@ -1592,12 +1890,12 @@ namespace osmscout {
 
 #if defined(HAVE_MMAP) || defined(_WIN32)
     if (buffer!=nullptr) {
-      if (offset+bytes-1>=size) {
+      if (offset+bytes-1>=bufferEnd) {
         hasError=true;
         throw IOException(filename,"Cannot read file offset","Cannot read beyond end of file");
       }
 
-      char       *dataPtr=&buffer[offset];
+      char       *dataPtr=&buffer[offset-bufferStart];
       FileOffset add;
 
       add=(unsigned char)(*dataPtr);
@@ -1724,6 +2022,28 @@ namespace osmscout {
     }
   }
 
+  /**
+   * Decode a signed number from the buffer. The terminating byte is searched
+   * within the buffer first, so a number crossing the end of the buffer (or of
+   * a prefetched range) is never decoded and an exception is thrown instead.
+   */
+  template<typename N>
+  void FileScanner::ReadBufferedNumberSigned(N& number,
+                                             const char* action)
+  {
+    for (FileOffset end=offset; end<bufferEnd; end++) {
+      if ((buffer[end-bufferStart] & 0x80)==0) {
+        DecodeNumberSigned(&buffer[offset-bufferStart],number);
+        offset=end+1;
+
+        return;
+      }
+    }
+
+    hasError=true;
+    throw IOException(filename,action,"Cannot read beyond end of file");
+  }
+
   void FileScanner::ReadNumber(int16_t& number)
   {
     if (HasError()) {
@@ -1734,14 +2054,8 @@ namespace osmscout {
 
 #if defined(HAVE_MMAP) || defined(_WIN32)
     if (buffer!=nullptr) {
-      if (offset>=size) {
-        hasError=true;
-        throw IOException(filename,"Cannot read int16_t number","Cannot read beyond end of file");
-      }
-
-      unsigned int bytes=DecodeNumber(&buffer[offset],number);
-
-      offset+=bytes;
+      ReadBufferedNumberSigned(number,
+                               "Cannot read int16_t number");
 
       return;
     }
@@ -1814,14 +2128,8 @@ namespace osmscout {
 
 #if defined(HAVE_MMAP) || defined(_WIN32)
     if (buffer!=nullptr) {
-      if (offset>=size) {
-        hasError=true;
-        throw IOException(filename,"Cannot read int32_t number","Cannot read beyond end of file");
-      }
-
-      unsigned int bytes=DecodeNumber(&buffer[offset],number);
-
-      offset+=bytes;
+      ReadBufferedNumberSigned(number,
+                               "Cannot read int32_t number");
 
       return;
     }
@@ -1895,14 +2203,8 @@ namespace osmscout {
 
 #if defined(HAVE_MMAP) || defined(_WIN32)
     if (buffer!=nullptr) {
-      if (offset>=size) {
-        hasError=true;
-        throw IOException(filename,"Cannot read int64_t number","Cannot read beyond end of file");
-      }
-
-      unsigned int bytes=DecodeNumber(&buffer[offset],number);
-
-      offset+=bytes;
+      ReadBufferedNumberSigned(number,
+                               "Cannot read int64_t number");
 
       return;
     }
@@ -1977,10 +2279,10 @@ namespace osmscout {
     if (buffer!=nullptr) {
       unsigned int shift=0;
 
-      for (; offset<size; offset++) {
-        number|=static_cast<uint16_t>(buffer[offset] & 0x7f) << shift;
+      for (; offset<bufferEnd; offset++) {
+        number|=static_cast<uint16_t>(buffer[offset-bufferStart] & 0x7f) << shift;
 
-        if ((buffer[offset] & 0x80)==0) {
+        if ((buffer[offset-bufferStart] & 0x80)==0) {
           offset++;
           return;
         }
@@ -2030,10 +2332,10 @@ namespace osmscout {
     if (buffer!=nullptr) {
       unsigned int shift=0;
 
-      for (; offset<size; offset++) {
-        number|=static_cast<uint32_t>(buffer[offset] & 0x7f) << shift;
+      for (; offset<bufferEnd; offset++) {
+        number|=static_cast<uint32_t>(buffer[offset-bufferStart] & 0x7f) << shift;
 
-        if ((buffer[offset] & 0x80)==0) {
+        if ((buffer[offset-bufferStart] & 0x80)==0) {
           offset++;
           return;
         }
@@ -2083,10 +2385,10 @@ namespace osmscout {
     if (buffer!=nullptr) {
       unsigned int shift=0;
 
-      for (; offset<size; offset++) {
-        number|=static_cast<uint64_t>(buffer[offset] & 0x7f) << shift;
+      for (; offset<bufferEnd; offset++) {
+        number|=static_cast<uint64_t>(buffer[offset-bufferStart] & 0x7f) << shift;
 
-        if ((buffer[offset] & 0x80)==0) {
+        if ((buffer[offset-bufferStart] & 0x80)==0) {
           offset++;
           return;
         }
@@ -2135,13 +2437,13 @@ namespace osmscout {
 
 #if defined(HAVE_MMAP) || defined(_WIN32)
     if (buffer!=nullptr) {
-      if (offset+coordByteSize-1>=size) {
+      if (offset+coordByteSize-1>=bufferEnd) {
         hasError=true;
 
         throw IOException(filename,"Cannot read coordinate","Cannot read beyonf end of file");
       }
 
-      char *dataPtr=&buffer[offset];
+      char *dataPtr=&buffer[offset-bufferStart];
 
       latDat=  ((unsigned char) dataPtr[0] <<  0)
              | ((unsigned char) dataPtr[1] <<  8)
@@ -2193,13 +2495,13 @@ namespace osmscout {
 
 #if defined(HAVE_MMAP) || defined(_WIN32)
     if (buffer!=nullptr) {
-      if (offset+coordByteSize-1>=size) {
+      if (offset+coordByteSize-1>=bufferEnd) {
         hasError=true;
 
         throw IOException(filename,"Cannot read coordinate","Cannot read beyond end of file");
       }
 
-      char *dataPtr=&buffer[offset];
+      char *dataPtr=&buffer[offset-bufferStart];
 
       latDat=  ((unsigned char) dataPtr[0] <<  0)
              | ((unsigned char) dataPtr[1] <<  8)
@@ -2254,24 +2556,247 @@ namespace osmscout {
     }
   }
 
-  void FileScanner::Read(std::vector<Point>& nodes,
-                         std::vector<SegmentGeoBox> &segments,
-                         GeoBox &bbox,
-                         bool readIds)
+  namespace {
+
+    constexpr size_t coordDecodeBlockSize=256;  //!< Number of coordinates decoded in one block
+    constexpr size_t coordSegmentSize=1024;     //!< Number of nodes covered by one SegmentGeoBox
+
+    static_assert(coordSegmentSize % coordDecodeBlockSize==0,
+                  "Segments must consist of complete decode blocks");
+
+    /**
+     * Decodes count coordinates from the given delta buffer into the given buffer
+     * of raw (interleaved latitude and longitude) values. lat and lon hold
+     * the previous raw coordinate and are updated to the last decoded coordinate.
+     *
+     * @return Position in the delta buffer after the decoded coordinates
+     */
+    const uint8_t* DecodeCoordDeltas(const uint8_t* data,
+                                     size_t coordBitSize,
+                                     size_t count,
+                                     uint32_t& lat,
+                                     uint32_t& lon,
+                                     uint32_t* raw)
+    {
+      size_t i=0;
+
+      if (coordBitSize==16) {
+#if defined(OSMSCOUT_HAVE_SSE2)
+        // 4 coordinates per step, the prefix sum of the deltas is calculated
+        // in the register, lanes are (lat, lon, lat, lon)
+        __m128i carry=_mm_set_epi32((int32_t)lon,(int32_t)lat,(int32_t)lon,(int32_t)lat);
+
+        for (; i+4<=count; i+=4) {
+          __m128i bytes=_mm_loadl_epi64(reinterpret_cast<const __m128i*>(data));
+          __m128i words=_mm_unpacklo_epi8(bytes,bytes);
+          __m128i lo=_mm_srai_epi32(_mm_unpacklo_epi16(words,words),24);
+          __m128i hi=_mm_srai_epi32(_mm_unpackhi_epi16(words,words),24);
+
+          lo=_mm_add_epi32(_mm_add_epi32(lo,_mm_slli_si128(lo,8)),carry);
+          carry=_mm_shuffle_epi32(lo,_MM_SHUFFLE(3,2,3,2));
+          hi=_mm_add_epi32(_mm_add_epi32(hi,_mm_slli_si128(hi,8)),carry);
+          carry=_mm_shuffle_epi32(hi,_MM_SHUFFLE(3,2,3,2));
+
+          _mm_storeu_si128(reinterpret_cast<__m128i*>(raw+2*i),lo);
+          _mm_storeu_si128(reinterpret_cast<__m128i*>(raw+2*i+4),hi);
+
+          data+=8;
+        }
+
+        lat=(uint32_t)_mm_cvtsi128_si32(carry);
+        lon=(uint32_t)_mm_cvtsi128_si32(_mm_shuffle_epi32(carry,_MM_SHUFFLE(1,1,1,1)));
+#endif
+
+        for (; i<count; i++) {
+          lat+=(int32_t)(int8_t)data[0];
+          lon+=(int32_t)(int8_t)data[1];
+
+          raw[2*i]=lat;
+          raw[2*i+1]=lon;
+
+          data+=2;
+        }
+      }
+      else if (coordBitSize==32) {
+#if defined(OSMSCOUT_HAVE_SSE2)
+        __m128i carry=_mm_set_epi32((int32_t)lon,(int32_t)lat,(int32_t)lon,(int32_t)lat);
+
+        for (; i+4<=count; i+=4) {
+          __m128i words=_mm_loadu_si128(reinterpret_cast<const __m128i*>(data));
+          __m128i lo=_mm_srai_epi32(_mm_unpacklo_epi16(words,words),16);
+          __m128i hi=_mm_srai_epi32(_mm_unpackhi_epi16(words,words),16);
+
+          lo=_mm_add_epi32(_mm_add_epi32(lo,_mm_slli_si128(lo,8)),carry);
+          carry=_mm_shuffle_epi32(lo,_MM_SHUFFLE(3,2,3,2));
+          hi=_mm_add_epi32(_mm_add_epi32(hi,_mm_slli_si128(hi,8)),carry);
+          carry=_mm_shuffle_epi32(hi,_MM_SHUFFLE(3,2,3,2));
+
+          _mm_storeu_si128(reinterpret_cast<__m128i*>(raw+2*i),lo);
+          _mm_storeu_si128(reinterpret_cast<__m128i*>(raw+2*i+4),hi);
+
+          data+=16;
+        }
+
+        lat=(uint32_t)_mm_cvtsi128_si32(carry);
+        lon=(uint32_t)_mm_cvtsi128_si32(_mm_shuffle_epi32(carry,_MM_SHUFFLE(1,1,1,1)));
+#endif
+
+        for (; i<count; i++) {
+          lat+=(int32_t)(int16_t)(uint16_t)(data[0] | (data[1] << 8));
+          lon+=(int32_t)(int16_t)(uint16_t)(data[2] | (data[3] << 8));
+
+          raw[2*i]=lat;
+          raw[2*i+1]=lon;
+
+          data+=4;
+        }
+      }
+      else {
+        // 24 bit deltas cannot be unpacked efficiently without byte shuffles
+        for (; i<count; i++) {
+          uint32_t latUDelta=data[0] | (data[1] << 8) | (data[2] << 16);
+          uint32_t lonUDelta=data[3] | (data[4] << 8) | (data[5] << 16);
+
+          lat+=(int32_t)((latUDelta & 0x800000) ? (latUDelta | 0xff000000) : latUDelta);
+          lon+=(int32_t)((lonUDelta & 0x800000) ? (lonUDelta | 0xff000000) : lonUDelta);
+
+          raw[2*i]=lat;
+          raw[2*i+1]=lon;
+
+          data+=6;
+        }
+      }
+
+      return data;
+    }
+
+    /**
+     * Bounding box of a number of decoded coordinates
+     */
+    class CoordBounds
+    {
+    private:
+#if defined(OSMSCOUT_HAVE_SSE2)
+      __m128d minCoord; //!< Minimum latitude and longitude
+      __m128d maxCoord; //!< Maximum latitude and longitude
+#else
+      double  minLat;
+      double  minLon;
+      double  maxLat;
+      double  maxLon;
+#endif
+
+    public:
+      CoordBounds()
+      {
+        Reset();
+      }
+
+      void Reset()
+      {
+#if defined(OSMSCOUT_HAVE_SSE2)
+        minCoord=_mm_set1_pd(std::numeric_limits<double>::max());
+        maxCoord=_mm_set1_pd(std::numeric_limits<double>::lowest());
+#else
+        minLat=std::numeric_limits<double>::max();
+        minLon=std::numeric_limits<double>::max();
+        maxLat=std::numeric_limits<double>::lowest();
+        maxLon=std::numeric_limits<double>::lowest();
+#endif
+      }
+
+      void Include(const CoordBounds& other)
+      {
+#if defined(OSMSCOUT_HAVE_SSE2)
+        minCoord=_mm_min_pd(minCoord,other.minCoord);
+        maxCoord=_mm_max_pd(maxCoord,other.maxCoord);
+#else
+        minLat=std::min(minLat,other.minLat);
+        minLon=std::min(minLon,other.minLon);
+        maxLat=std::max(maxLat,other.maxLat);
+        maxLon=std::max(maxLon,other.maxLon);
+#endif
+      }
+
+      /**
+       * Converts the given raw coordinates, stores them in the given points and
+       * extends the bounding box by them
+       */
+      void Convert(const uint32_t* raw,
+                   size_t count,
+                   Point* points)
+      {
+#if defined(OSMSCOUT_HAVE_SSE2)
+        const __m128d factor=_mm_set_pd(lonConversionFactor,latConversionFactor);
+        const __m128d offset=_mm_set_pd(180.0,90.0);
+        double        value[2];
+
+        // Raw values have 27 bits, so they can be converted as signed values
+        for (size_t i=0; i<count; i++) {
+          __m128d coord=_mm_cvtepi32_pd(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(raw+2*i)));
+
+          coord=_mm_sub_pd(_mm_div_pd(coord,factor),offset);
+
+          minCoord=_mm_min_pd(minCoord,coord);
+          maxCoord=_mm_max_pd(maxCoord,coord);
+
+          _mm_storeu_pd(value,coord);
+
+          points[i].SetCoord(GeoCoord(value[0],value[1]));
+        }
+#else
+        for (size_t i=0; i<count; i++) {
+          double lat=raw[2*i]/latConversionFactor-90.0;
+          double lon=raw[2*i+1]/lonConversionFactor-180.0;
+
+          minLat=std::min(minLat,lat);
+          minLon=std::min(minLon,lon);
+          maxLat=std::max(maxLat,lat);
+          maxLon=std::max(maxLon,lon);
+
+          points[i].SetCoord(GeoCoord(lat,lon));
+        }
+#endif
+      }
+
+      GeoBox GetBox() const
+      {
+#if defined(OSMSCOUT_HAVE_SSE2)
+        double minValue[2];
+        double maxValue[2];
+
+        _mm_storeu_pd(minValue,minCoord);
+        _mm_storeu_pd(maxValue,maxCoord);
+
+        return GeoBox(GeoCoord(minValue[0],minValue[1]),
+                      GeoCoord(maxValue[0],maxValue[1]));
+#else
+        return GeoBox(GeoCoord(minLat,minLon),
+                      GeoCoord(maxLat,maxLon));
+#endif
+      }
+    };
+  }
+
+  /**
+   * Reads the header of an encoded vector of points
+   *
+   * @return false, if the vector is empty
+   */
+  bool FileScanner::ReadPointsHeader(bool readIds,
+                                     size_t& nodeCount,
+                                     size_t& coordBitSize,
+                                     bool& hasNodes)
   {
-    size_t  coordBitSize;
     uint8_t sizeByte;
 
     Read(sizeByte);
 
     // Fast exit for empty arrays
     if (sizeByte==0) {
-      return;
+      return false;
     }
 
-    bool   hasNodes;
-    size_t nodeCount;
-
     if (readIds) {
       hasNodes=(sizeByte & 0x04)!=0;
 
@@ -2339,6 +2864,25 @@ namespace osmscout {
       }
     }
 
+    return true;
+  }
+
+  void FileScanner::Read(std::vector<Point>& nodes,
+                         std::vector<SegmentGeoBox> &segments,
+                         GeoBox &bbox,
+                         bool readIds)
+  {
+    size_t coordBitSize;
+    bool   hasNodes;
+    size_t nodeCount;
+
+    if (!ReadPointsHeader(readIds,
+                          nodeCount,
+                          coordBitSize,
+                          hasNodes)) {
+      return;
+    }
+
     nodes.resize(nodeCount);
 
     size_t byteBufferSize=(nodeCount-1)*coordBitSize/8;
@@ -2350,130 +2894,164 @@ namespace osmscout {
     uint32_t latValue=(uint32_t)round((firstCoord.GetLat()+90.0)*latConversionFactor);
     uint32_t lonValue=(uint32_t)round((firstCoord.GetLon()+180.0)*lonConversionFactor);
 
-    nodes[0].SetCoord(firstCoord);
-
-    uint8_t *tmpBuffer = (uint8_t*)ReadInternal(byteBufferSize);
+    const uint8_t *deltaData=(const uint8_t*)ReadInternal(byteBufferSize);
 
-    if (coordBitSize==16) {
-      size_t currentCoordPos=1;
+    // Coordinates are decoded in blocks, first the deltas are summed up to raw
+    // values, then the raw values are converted and the bounding boxes of
+    // the segments and the complete vector are collected in the same pass
+    uint32_t    raw[2*coordDecodeBlockSize];
+    CoordBounds segmentBounds;
+    CoordBounds bounds;
+    bool        calculateSegments=nodeCount>coordSegmentSize;
 
-      for (size_t i=0; i<byteBufferSize; i+=2) {
-        int32_t latDelta=(int8_t)tmpBuffer[i];
-        int32_t lonDelta=(int8_t)tmpBuffer[i+1];
+    if (calculateSegments) {
+      segments.reserve(segments.size()+(nodeCount-1)/coordSegmentSize+1);
+    }
 
-        latValue+=latDelta;
-        lonValue+=lonDelta;
+    for (size_t pos=0; pos<nodeCount; pos+=coordDecodeBlockSize) {
+      size_t count=std::min(coordDecodeBlockSize,nodeCount-pos);
 
-        SetCoord(latValue,lonValue,nodes[currentCoordPos]);
+      if (pos==0) {
+        raw[0]=latValue;
+        raw[1]=lonValue;
 
-        currentCoordPos++;
+        deltaData=DecodeCoordDeltas(deltaData,
+                                    coordBitSize,
+                                    count-1,
+                                    latValue,
+                                    lonValue,
+                                    raw+2);
+      }
+      else {
+        deltaData=DecodeCoordDeltas(deltaData,
+                                    coordBitSize,
+                                    count,
+                                    latValue,
+                                    lonValue,
+                                    raw);
       }
-    }
-    else if (coordBitSize==32) {
-      size_t currentCoordPos=1;
 
-      for (size_t i=0; i<byteBufferSize; i+=4) {
-        uint32_t latUDelta=tmpBuffer[i+0] | (tmpBuffer[i+1]<<8);
-        uint32_t lonUDelta=tmpBuffer[i+2] | (tmpBuffer[i+3]<<8);
-        int32_t  latDelta;
-        int32_t  lonDelta;
+      segmentBounds.Convert(raw,
+                            count,
+                            nodes.data()+pos);
 
-        if (latUDelta & 0x8000) {
-          latDelta=(int32_t)(latUDelta | 0xffff0000);
-        }
-        else {
-          latDelta=(int32_t)latUDelta;
-        }
+      if ((pos+count) % coordSegmentSize==0 ||
+          pos+count==nodeCount) {
+        if (calculateSegments) {
+          SegmentGeoBox segment;
 
-        latValue+=latDelta;
+          segment.from=(pos/coordSegmentSize)*coordSegmentSize;
+          segment.to=pos+count; // exclusive
+          segment.bbox=segmentBounds.GetBox();
 
-        if (lonUDelta & 0x8000) {
-          lonDelta=(int32_t)(lonUDelta | 0xffff0000);
+          segments.push_back(segment);
         }
-        else {
-          lonDelta=(int32_t)lonUDelta;
-        }
-
-        lonValue+=lonDelta;
 
-        SetCoord(latValue,lonValue,nodes[currentCoordPos]);
-
-        currentCoordPos++;
+        bounds.Include(segmentBounds);
+        segmentBounds.Reset();
       }
     }
-    else {
-      size_t currentCoordPos=1;
 
-      for (size_t i=0; i<byteBufferSize; i+=6) {
-        uint32_t latUDelta=(tmpBuffer[i+0]) | (tmpBuffer[i+1]<<8) | (tmpBuffer[i+2]<<16);
-        uint32_t lonUDelta=(tmpBuffer[i+3]) | (tmpBuffer[i+4]<<8) | (tmpBuffer[i+5]<<16);
-        int32_t  latDelta;
-        int32_t  lonDelta;
+    bbox=bounds.GetBox();
 
-        if (latUDelta & 0x800000) {
-          latDelta=(int32_t)(latUDelta | 0xff000000);
-        }
-        else {
-          latDelta=(int32_t)latUDelta;
-        }
+    if (hasNodes) {
+      size_t idCurrent=0;
 
-        latValue+=latDelta;
+      while (idCurrent<nodeCount) {
+        uint8_t bitset;
+        size_t bitmask=1;
 
-        if (lonUDelta & 0x800000) {
-          lonDelta=(int32_t)(lonUDelta | 0xff000000);
-        }
-        else {
-          lonDelta=(int32_t)lonUDelta;
-        }
+        Read(bitset);
 
-        lonValue+=lonDelta;
+        for (size_t i=0; i<8 && idCurrent<nodeCount; i++) {
+          if (bitset & bitmask) {
+            uint8_t serial;
+
+            Read(serial);
 
-        SetCoord(latValue,lonValue,nodes[currentCoordPos]);
+            nodes[idCurrent].SetSerial(serial);
+          }
 
-        currentCoordPos++;
+          bitmask*=2;
+          idCurrent++;
+        }
       }
     }
+  }
+
+  /**
+   * Reads an encoded vector of points as view into the memory mapped file,
+   * without decoding the coordinates. The view stays valid until the scanner
+   * is closed.
+   *
+   * @throws IOException if the file is not memory mapped
+   */
+  void FileScanner::Read(PointSequenceView& nodes,
+                         bool readIds)
+  {
+    if (!IsMemoryMapped()) {
+      throw IOException(filename,"Cannot read point sequence view","File is not memory mapped");
+    }
 
-    GetBoundingBox(nodes, bbox);
+    size_t coordBitSize;
+    bool   hasNodes;
+    size_t nodeCount;
 
-    // we will prepare segment bounding boxes just for long point vectors
-    if (nodeCount > 1024) {
-      // initialise segments
-      size_t segmentCount = (((uint64_t) nodeCount - 1) / 1024) + 1;
-      segments.reserve(segmentCount);
-      Point *pd = nodes.data();
-      for (size_t i = 0; i < segmentCount; i++) {
-        SegmentGeoBox s;
-        s.from = i * 1024;
-        s.to = std::min(nodeCount, s.from + 1024); // exclusive
-        GetBoundingBox(pd+s.from, pd+s.to, s.bbox);
-        segments.emplace_back(std::move(s));
-      }
+    if (!ReadPointsHeader(readIds,
+                          nodeCount,
+                          coordBitSize,
+                          hasNodes)) {
+      nodes=PointSequenceView();
+      return;
     }
 
+    size_t   byteBufferSize=(nodeCount-1)*coordBitSize/8;
+    GeoCoord firstCoord;
+
+    ReadCoord(firstCoord);
+
+    uint32_t latValue=(uint32_t)round((firstCoord.GetLat()+90.0)*latConversionFactor);
+    uint32_t lonValue=(uint32_t)round((firstCoord.GetLon()+180.0)*lonConversionFactor);
+
+    const uint8_t *deltaData=(const uint8_t*)ReadInternal(byteBufferSize);
+    bool          hasNodeWithId=false;
+
     if (hasNodes) {
+      // Skip the serials, we only remember if there is any
       size_t idCurrent=0;
 
       while (idCurrent<nodeCount) {
         uint8_t bitset;
-        size_t bitmask=1;
+        size_t  serialCount=0;
 
         Read(bitset);
 
         for (size_t i=0; i<8 && idCurrent<nodeCount; i++) {
-          if (bitset & bitmask) {
-            uint8_t serial;
-
-            Read(serial);
-
-            nodes[idCurrent].SetSerial(serial);
+          if ((bitset & (1 << i))!=0) {
+            serialCount++;
           }
 
-          bitmask*=2;
           idCurrent++;
         }
+
+        if (serialCount>0) {
+          const uint8_t *serials=(const uint8_t*)ReadInternal(serialCount);
+
+          for (size_t i=0; i<serialCount; i++) {
+            if (serials[i]!=0) {
+              hasNodeWithId=true;
+            }
+          }
+        }
       }
     }
+
+    nodes=PointSequenceView(deltaData,
+                            nodeCount,
+                            uint8_t(coordBitSize/8),
+                            latValue,
+                            lonValue,
+                            hasNodeWithId);
   }
 
   void FileScanner::ReadBox(GeoBox& box)
@@ -0,0 +1,302 @@
+/*
+  This source is part of the libosmscout library
+  Copyright (C) 2026  Tim Teulings
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307  USA
+*/
+
+#include <osmscout/util/FileScannerPool.h>
+
+#include <osmscout/util/Logger.h>
+
+namespace osmscout {
+
+  FileScannerPool::Lease::Lease(const FileScannerPool* pool,
+                                const std::shared_ptr<const FileScanner>& mapping,
+                                std::unique_ptr<FileScanner>&& scanner,
+                                size_t generation)
+  : pool(pool),
+    mapping(mapping),
+    scanner(std::move(scanner)),
+    generation(generation)
+  {
+    // no code
+  }
+
+  FileScannerPool::Lease::~Lease()
+  {
+    // The scanner is returned before the lease releases the mapping it reads from
+    if (scanner) {
+      pool->Release(std::move(scanner),
+                    generation);
+    }
+  }
+
+  FileScannerPool::FileScannerPool()
+  : mode(FileScanner::Normal),
+    isOpen(false),
+    generation(0)
+  {
+    // no code
+  }
+
+  FileScannerPool::~FileScannerPool()
+  {
+    if (IsOpen()) {
+      CloseFailsafe();
+    }
+  }
+
+  /**
+   * Open a scanner for the given file, reading from the given mapping if
+   * there is one.
+   *
+   * throws IOException on error
+   */
+  std::unique_ptr<FileScanner> FileScannerPool::OpenScanner(const std::string& filename,
+                                                            FileScanner::Mode mode,
+                                                            const FileScanner* mapping)
+  {
+    auto scanner=std::make_unique<FileScanner>();
+
+    if (mapping!=nullptr) {
+      scanner->Open(*mapping,
+                    mode);
+    }
+    else {
+      scanner->Open(filename,
+                    mode,
+                    false);
+    }
+
+    return scanner;
+  }
+
+  void FileScannerPool::Release(std::unique_ptr<FileScanner>&& scanner,
+                                size_t generation) const
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+
+    // Scanners belonging to an already closed pool and scanners in error state are dropped
+    if (!isOpen ||
+        generation!=this->generation ||
+        scanner->HasError()) {
+      scanner->CloseFailsafe();
+      return;
+    }
+
+    idle.push_back(std::move(scanner));
+  }
+
+  /**
+   * Open the pool for the given file. If the file should be memory mapped,
+   * it is mapped once here and the given mmapAdvice flags are applied to
+   * the mapping. The first scanner is opened immediately, so that errors
+   * are reported at this point.
+   *
+   * throws IOException on error
+   */
+  void FileScannerPool::Open(const std::string& filename,
+                             FileScanner::Mode mode,
+                             bool useMmap,
+                             uint8_t mmapAdvice)
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+
+    if (isOpen) {
+      throw IOException(filename,"Error opening file for reading","File already opened");
+    }
+
+    this->filename=filename;
+    this->mode=mode;
+
+    if (useMmap) {
+      // Outstanding leases of a closed pool keep the mapping alive, the last one closes it
+      std::shared_ptr<FileScanner> mappedScanner(new FileScanner(),
+                                                 [](FileScanner* scanner) {
+                                                   scanner->CloseFailsafe();
+                                                   delete scanner;
+                                                 });
+
+      mappedScanner->Open(filename,
+                          mode,
+                          true,
+                          mmapAdvice);
+
+      // FileScanner falls back to normal reads, if the file cannot be mapped
+      if (mappedScanner->IsMemoryMapped()) {
+        mapping=mappedScanner;
+      }
+      else {
+        mappedScanner->Close();
+      }
+    }
+
+    idle.push_back(OpenScanner(filename,
+                               mode,
+                               mapping.get()));
+
+    isOpen=true;
+  }
+
+  /**
+   * Close all idle scanners. Scanners still in use are closed when their
+   * lease is released, the mapping together with the last lease.
+   *
+   * throws IOException on error
+   */
+  void FileScannerPool::Close()
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+
+    if (!isOpen) {
+      throw IOException(filename,"Cannot close file","File already closed");
+    }
+
+    isOpen=false;
+    generation++;
+
+    std::vector<std::unique_ptr<FileScanner>> scanners;
+
+    scanners.swap(idle);
+
+    mapping.reset();
+
+    for (auto& scanner : scanners) {
+      try {
+        scanner->Close();
+      }
+      catch (IOException& e) {
+        for (auto& s : scanners) {
+          s->CloseFailsafe();
+        }
+
+        throw;
+      }
+    }
+  }
+
+  void FileScannerPool::CloseFailsafe()
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+
+    isOpen=false;
+    generation++;
+
+    for (auto& scanner : idle) {
+      scanner->CloseFailsafe();
+    }
+
+    idle.clear();
+
+    mapping.reset();
+  }
+
+  bool FileScannerPool::IsOpen() const
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+
+    return isOpen;
+  }
+
+  /**
+   * Return true, if the scanners of the pool read from a memory mapping of
+   * the file. If mapping fails, FileScanner silently falls back to normal
+   * reads.
+   */
+  bool FileScannerPool::IsMemoryMapped() const
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+
+    return mapping!=nullptr;
+  }
+
+  /**
+   * Fault in all pages of the file, if it is memory mapped.
+   */
+  void FileScannerPool::Prefault() const
+  {
+    std::shared_ptr<FileScanner> mappedScanner;
+
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+
+      mappedScanner=mapping;
+    }
+
+    if (mappedScanner) {
+      mappedScanner->PrefaultPages();
+    }
+  }
+
+  std::string FileScannerPool::GetFilename() const
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+
+    return filename;
+  }
+
+  /**
+   * Return exclusive access to a scanner of the pool, opening a new one
+   * if there is currently no idle scanner.
+   *
+   * throws IOException on error
+   */
+  FileScannerPool::Lease FileScannerPool::Acquire() const
+  {
+    std::string                  currentFilename;
+    FileScanner::Mode            currentMode;
+    std::shared_ptr<FileScanner> currentMapping;
+    size_t                       currentGeneration;
+
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+
+      if (!isOpen) {
+        throw IOException(filename,"Cannot read file","File not opened");
+      }
+
+      currentGeneration=generation;
+      currentMapping=mapping;
+
+      if (!idle.empty()) {
+        std::unique_ptr<FileScanner> scanner=std::move(idle.back());
+
+        idle.pop_back();
+
+        return Lease(this,
+                     currentMapping,
+                     std::move(scanner),
+                     currentGeneration);
+      }
+
+      // Open() and Close() may change these, as soon as the lock is released
+      currentFilename=filename;
+      currentMode=mode;
+    }
+
+    // Opening a new scanner is comparably expensive and thus done without holding the lock
+    log.Debug() << "Opening additional scanner for file '" << currentFilename << "'";
+
+    std::unique_ptr<FileScanner> scanner=OpenScanner(currentFilename,
+                                                     currentMode,
+                                                     currentMapping.get());
+
+    return Lease(this,
+                 currentMapping,
+                 std::move(scanner),
+                 currentGeneration);
+  }
+}
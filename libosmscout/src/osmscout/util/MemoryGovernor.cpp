@@ -0,0 +1,309 @@
+/*
+  This source is part of the libosmscout library
+  Copyright (C) 2026  Tim Teulings
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307  USA
+*/
+
+#include <osmscout/util/MemoryGovernor.h>
+
+#include <algorithm>
+
+#include <osmscout/util/Logger.h>
+
+namespace osmscout {
+
+  MemoryGovernor::MemoryGovernor(size_t budget)
+  : budget(budget),
+    rebalanceInterval(1000),
+    nextRebalance(0)
+  {
+    // no code
+  }
+
+  /**
+   * Make the shares of all caches sum up to 1.0
+   */
+  void MemoryGovernor::NormalizeShares()
+  {
+    double sum=0.0;
+
+    for (const auto& entry : entries) {
+      sum+=entry.share;
+    }
+
+    for (auto& entry : entries) {
+      if (sum>0.0) {
+        entry.share/=sum;
+      }
+      else {
+        entry.share=1.0/double(entries.size());
+      }
+    }
+  }
+
+  void MemoryGovernor::ApplyBudgets()
+  {
+    for (auto& entry : entries) {
+      entry.cache->SetMemoryBudget(size_t(entry.share*double(budget)));
+    }
+  }
+
+  /**
+   * Change the overall budget, the budget of each cache is changed relative
+   * to its current share.
+   */
+  void MemoryGovernor::SetBudget(size_t budget)
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+
+    this->budget=budget;
+
+    ApplyBudgets();
+  }
+
+  size_t MemoryGovernor::GetBudget() const
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+
+    return budget;
+  }
+
+  /**
+   * Set the minimum time between two calls of Rebalance() by
+   * RebalanceIfDue(). Default is one second.
+   */
+  void MemoryGovernor::SetRebalanceInterval(const std::chrono::milliseconds& interval)
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+
+    rebalanceInterval=interval;
+  }
+
+  /**
+   * Add the given cache. The cache initially gets a share of the budget
+   * relative to its weight compared to the weights of all registered caches
+   * (for example the configured cache sizes). The shares of the other caches
+   * are reduced accordingly.
+   */
+  void MemoryGovernor::Register(GovernedCache& cache,
+                                const std::string& name,
+                                double weight)
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+
+    double weightSum=weight;
+
+    for (const auto& entry : entries) {
+      weightSum+=entry.weight;
+    }
+
+    double share=weightSum>0.0 ? weight/weightSum : 1.0/double(entries.size()+1);
+
+    for (auto& entry : entries) {
+      entry.share*=1.0-share;
+    }
+
+    entries.push_back(Entry{&cache,name,weight,share,cache.GetHits(),cache.GetMisses()});
+
+    NormalizeShares();
+    ApplyBudgets();
+  }
+
+  /**
+   * Remove the given cache, its share of the budget is given to the
+   * remaining caches.
+   */
+  void MemoryGovernor::Unregister(GovernedCache& cache)
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+
+    entries.erase(std::remove_if(entries.begin(),
+                                 entries.end(),
+                                 [&cache](const Entry& entry) {
+                                   return entry.cache==&cache;
+                                 }),
+                  entries.end());
+
+    NormalizeShares();
+    ApplyBudgets();
+  }
+
+  size_t MemoryGovernor::GetCacheCount() const
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+
+    return entries.size();
+  }
+
+  /**
+   * Returns the current budget of the given cache, or 0 if the cache
+   * is not registered.
+   */
+  size_t MemoryGovernor::GetCacheBudget(const GovernedCache& cache) const
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+
+    for (const auto& entry : entries) {
+      if (entry.cache==&cache) {
+        return size_t(entry.share*double(budget));
+      }
+    }
+
+    return 0;
+  }
+
+  /**
+   * Returns the memory currently held by all registered caches in bytes.
+   */
+  size_t MemoryGovernor::GetUsedMemory() const
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    size_t                      memory=0;
+
+    for (const auto& entry : entries) {
+      memory+=entry.cache->GetMemory();
+    }
+
+    return memory;
+  }
+
+  void MemoryGovernor::RebalanceInternal()
+  {
+    if (entries.size()<2 ||
+        budget==0) {
+      return;
+    }
+
+    std::vector<double> demands(entries.size(),0.0);
+    std::vector<double> targets(entries.size(),0.0);
+    std::vector<bool>   full(entries.size(),false);
+    double              minShare=MinimumShare/double(entries.size());
+    double              fullDemand=0.0;
+    double              fullShare=0.0;
+    double              freeShare=1.0;
+    size_t              fullCount=0;
+    size_t              accesses=0;
+
+    for (size_t i=0; i<entries.size(); i++) {
+      Entry& entry=entries[i];
+      size_t hits=entry.cache->GetHits();
+      size_t misses=entry.cache->GetMisses();
+      size_t hitsDelta=hits-entry.lastHits;
+      size_t missesDelta=misses-entry.lastMisses;
+      size_t memory=entry.cache->GetMemory();
+      double memoryShare=double(memory)/double(budget);
+
+      entry.lastHits=hits;
+      entry.lastMisses=misses;
+      accesses+=hitsDelta+missesDelta;
+
+      // Hits show that the memory is used, misses that more memory may help
+      demands[i]=double(hitsDelta)+2.0*double(missesDelta);
+
+      if (memoryShare<0.9*entry.share) {
+        // The cache does not use its budget (yet), it does not need more,
+        // some headroom above the current use is left.
+        targets[i]=std::min(entry.share,std::max(minShare,1.25*memoryShare));
+        freeShare-=targets[i];
+      }
+      else {
+        full[i]=true;
+        fullCount++;
+        fullDemand+=demands[i];
+        fullShare+=entry.share;
+      }
+    }
+
+    if (accesses==0) {
+      return;
+    }
+
+    // Split the remaining budget between the caches that use their budget
+    double distributableShare=freeShare-double(fullCount)*minShare;
+
+    for (size_t i=0; i<entries.size(); i++) {
+      if (!full[i]) {
+        continue;
+      }
+
+      if (distributableShare<=0.0) {
+        targets[i]=entries[i].share;
+      }
+      else if (fullDemand>0.0) {
+        targets[i]=minShare+distributableShare*demands[i]/fullDemand;
+      }
+      else {
+        targets[i]=minShare+distributableShare*entries[i].share/fullShare;
+      }
+    }
+
+    // Only move half the way to the target to avoid oscillation
+    for (size_t i=0; i<entries.size(); i++) {
+      entries[i].share=(entries[i].share+targets[i])/2.0;
+    }
+
+    NormalizeShares();
+    ApplyBudgets();
+  }
+
+  /**
+   * Redistribute the budget between the registered caches based on the
+   * hits and misses of each cache since the last call.
+   */
+  void MemoryGovernor::Rebalance()
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+
+    RebalanceInternal();
+
+    nextRebalance=(std::chrono::steady_clock::now()+rebalanceInterval).time_since_epoch().count();
+  }
+
+  /**
+   * Call Rebalance() if the rebalance interval has passed since the last
+   * rebalancing. Cheap if it has not, so it can be called on each access.
+   */
+  void MemoryGovernor::RebalanceIfDue()
+  {
+    if (std::chrono::steady_clock::now().time_since_epoch().count()<nextRebalance) {
+      return;
+    }
+
+    std::unique_lock<std::mutex> lock(mutex,std::try_to_lock);
+
+    // Some other thread is rebalancing already
+    if (!lock.owns_lock()) {
+      return;
+    }
+
+    RebalanceInternal();
+
+    nextRebalance=(std::chrono::steady_clock::now()+rebalanceInterval).time_since_epoch().count();
+  }
+
+  /**
+    Dump the budget and memory usage of all caches to the debug log.
+    */
+  void MemoryGovernor::DumpStatistics() const
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+
+    for (const auto& entry : entries) {
+      log.Debug() << entry.name << " budget: " << size_t(entry.share*double(budget)) << ", memory: " << entry.cache->GetMemory()
+                  << ", hits " << entry.cache->GetHits() << ", misses " << entry.cache->GetMisses();
+    }
+  }
+}